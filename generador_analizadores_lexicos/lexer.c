@@ -7,6 +7,8 @@ void lexer_init(LexerContext *ctx, DFA *dfa, const char *input) {
     ctx->pos   = 0;
     ctx->line  = 1;
     ctx->col   = 1;
+    ctx->quiet = 0;
+    ctx->quiet_until = 0;
 
     if (dfa->next_state == NULL) {
         dfa_build_table(dfa);
@@ -112,8 +114,9 @@ Token lexer_next_token(LexerContext *ctx) {
 
         if (last_accept_state == -1) {
             // Error léxico: emitir TOKEN_ERROR y avanzar 1 carácter
-            LOG_ERROR_MSG("lexer", "[%d:%d] cerca de '%c'",
-                          ctx->line, ctx->col, ctx->input[ctx->pos]);
+            if (!ctx->quiet && ctx->pos >= ctx->quiet_until)
+                LOG_ERROR_MSG("lexer", "[%d:%d] cerca de '%c'",
+                              ctx->line, ctx->col, ctx->input[ctx->pos]);
             Token err;
             err.type   = TOKEN_ERROR;
             err.length = 1;
@@ -149,7 +152,8 @@ Token lexer_next_token(LexerContext *ctx) {
 
             if (!validate_string_literal(lexeme, len, start_line, start_col,
                                          &err_line, &err_col, &msg)) {
-                LOG_ERROR_MSG("lexer", "[%d:%d] %s", err_line, err_col, msg);
+                if (!ctx->quiet && start >= ctx->quiet_until)
+                    LOG_ERROR_MSG("lexer", "[%d:%d] %s", err_line, err_col, msg);
                 Token err;
                 err.type = TOKEN_ERROR;
                 err.lexeme = lexeme;
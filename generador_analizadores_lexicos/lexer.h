@@ -11,6 +11,8 @@ typedef struct {
     int         pos;
     int         line;
     int         col;
+    int         quiet;  // 1: no reportar errores léxicos (los re-escanea el consumidor)
+    int         quiet_until;  // offset hasta el que los errores ya se reportaron
 } LexerContext;
 
 // Inicializar el lexer con contexto
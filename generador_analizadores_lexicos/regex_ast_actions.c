@@ -16,13 +16,14 @@
 #include <stdlib.h>
 #include <string.h>
 
-void exec_action(int act, ASTNode** sem, int* sem_top,
+void exec_action(int act, RegexSemStack* sem,
                         char saved_char, char range_start_char,
                         ASTContext *ctx) {
+    ASTNode** top = (sem->top > 0) ? &rsem_data(sem)[sem->top - 1] : NULL;
+
     switch (act) {
     case ACT_LEAF:
-        if (*sem_top < SEM_STACK_MAX)
-            sem[(*sem_top)++] = ast_create_leaf(ctx, saved_char, get_next_position(ctx));
+        rsem_push(sem, ast_create_leaf(ctx, saved_char, get_next_position(ctx)));
         break;
 
     case ACT_DOT: {
@@ -31,52 +32,46 @@ void exec_action(int act, ASTNode** sem, int* sem_top,
             ASTNode* leaf = ast_create_leaf(ctx, (char)c, get_next_position(ctx));
             result = result ? ast_create_or(ctx, result, leaf) : leaf;
         }
-        if (*sem_top < SEM_STACK_MAX) sem[(*sem_top)++] = result;
+        rsem_push(sem, result);
         break;
     }
 
     case ACT_STAR:
-        if (*sem_top > 0)
-            sem[*sem_top - 1] = ast_create_star(ctx, sem[*sem_top - 1]);
+        if (top) *top = ast_create_star(ctx, *top);
         break;
 
     case ACT_PLUS_OP:
-        if (*sem_top > 0)
-            sem[*sem_top - 1] = ast_create_plus(ctx, sem[*sem_top - 1]);
+        if (top) *top = ast_create_plus(ctx, *top);
         break;
 
     case ACT_QUESTION_OP:
-        if (*sem_top > 0)
-            sem[*sem_top - 1] = ast_create_question(ctx, sem[*sem_top - 1]);
+        if (top) *top = ast_create_question(ctx, *top);
         break;
 
     case ACT_OR: {
-        ASTNode* right = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        ASTNode* left  = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        if (*sem_top < SEM_STACK_MAX)
-            sem[(*sem_top)++] = ast_create_or(ctx, left, right);
+        ASTNode* right = rsem_pop(sem);
+        ASTNode* left  = rsem_pop(sem);
+        rsem_push(sem, ast_create_or(ctx, left, right));
         break;
     }
 
     case ACT_CONCAT: {
-        ASTNode* rest = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        ASTNode* item = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        if (*sem_top < SEM_STACK_MAX)
-            sem[(*sem_top)++] = (rest == NULL) ? item
-                                               : ast_create_concat(ctx, item, rest);
+        ASTNode* rest = rsem_pop(sem);
+        ASTNode* item = rsem_pop(sem);
+        rsem_push(sem, (rest == NULL) ? item
+                                      : ast_create_concat(ctx, item, rest));
         break;
     }
 
     case ACT_PUSH_NULL:
-        if (*sem_top < SEM_STACK_MAX) sem[(*sem_top)++] = NULL;
+        rsem_push(sem, NULL);
         break;
 
     case ACT_OR_OPT: {
-        ASTNode* rest = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        ASTNode* item = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
-        if (*sem_top < SEM_STACK_MAX)
-            sem[(*sem_top)++] = (rest == NULL) ? item
-                                               : ast_create_or(ctx, item, rest);
+        ASTNode* rest = rsem_pop(sem);
+        ASTNode* item = rsem_pop(sem);
+        rsem_push(sem, (rest == NULL) ? item
+                                      : ast_create_or(ctx, item, rest));
         break;
     }
 
@@ -85,8 +80,7 @@ void exec_action(int act, ASTNode** sem, int* sem_top,
         break;
 
     case ACT_LEAF_RANGE_START:
-        if (*sem_top < SEM_STACK_MAX)
-            sem[(*sem_top)++] = ast_create_leaf(ctx, range_start_char, get_next_position(ctx));
+        rsem_push(sem, ast_create_leaf(ctx, range_start_char, get_next_position(ctx)));
         break;
 
     case ACT_RANGE: {
@@ -95,7 +89,7 @@ void exec_action(int act, ASTNode** sem, int* sem_top,
             ASTNode* leaf = ast_create_leaf(ctx, c, get_next_position(ctx));
             result = result ? ast_create_or(ctx, result, leaf) : leaf;
         }
-        if (*sem_top < SEM_STACK_MAX) sem[(*sem_top)++] = result;
+        rsem_push(sem, result);
         break;
     }
 
@@ -104,23 +98,25 @@ void exec_action(int act, ASTNode** sem, int* sem_top,
          * los caracteres del conjunto. Coleccionamos esos caracteres y
          * construimos un OR de todos los imprimibles ASCII (más \t\n\r)
          * que NO están en el conjunto. */
-        ASTNode *set_ast = (*sem_top > 0) ? sem[--(*sem_top)] : NULL;
+        ASTNode *set_ast = rsem_pop(sem);
 
         unsigned char in_set[256] = {0};
-        /* Recorrido iterativo del árbol OR/leaf para marcar caracteres. */
-        ASTNode *stack[512];
-        int sp = 0;
-        if (set_ast) stack[sp++] = set_ast;
-        while (sp > 0) {
-            ASTNode *n = stack[--sp];
+        /* Recorrido iterativo del árbol OR/leaf para marcar caracteres
+         * (misma pila creciente que la semántica: sin tope fijo). */
+        RegexSemStack walk;
+        rsem_init(&walk);
+        if (set_ast) rsem_push(&walk, set_ast);
+        while (walk.top > 0) {
+            ASTNode *n = rsem_pop(&walk);
             if (!n) continue;
             if (n->type == NODE_LEAF) {
                 in_set[(unsigned char)n->symbol] = 1;
             } else {
-                if (n->left  && sp < 512) stack[sp++] = n->left;
-                if (n->right && sp < 512) stack[sp++] = n->right;
+                if (n->left)  rsem_push(&walk, n->left);
+                if (n->right) rsem_push(&walk, n->right);
             }
         }
+        rsem_release(&walk);
 
         ASTNode *result = NULL;
         /* Imprimibles 0x20..0x7E + whitespace común. */
@@ -137,7 +133,7 @@ void exec_action(int act, ASTNode** sem, int* sem_top,
                                             get_next_position(ctx));
             result = result ? ast_create_or(ctx, result, leaf) : leaf;
         }
-        if (*sem_top < SEM_STACK_MAX) sem[(*sem_top)++] = result;
+        rsem_push(sem, result);
         break;
     }
     }
@@ -0,0 +1,29 @@
+/* Local stand-in for the flex-generated lexer (flex unavailable). NOT COMMITTED. */
+#include "regex_tokens.h"
+#include <string.h>
+char regex_char_value;
+static const char *rl_p;
+void regex_lexer_set_string(const char* str) { rl_p = str; }
+void regex_lexer_cleanup(void) { rl_p = NULL; }
+int regex_lex(void) {
+    if (!rl_p || !*rl_p) return REGEX_T_EOF;
+    char c = *rl_p++;
+    switch (c) {
+    case '*': return REGEX_T_STAR; case '+': return REGEX_T_PLUS;
+    case '?': return REGEX_T_QUESTION; case '|': return REGEX_T_OR;
+    case '(': return REGEX_T_LPAREN; case ')': return REGEX_T_RPAREN;
+    case '[': return REGEX_T_LBRACKET; case ']': return REGEX_T_RBRACKET;
+    case '.': return REGEX_T_DOT; case '^': return REGEX_T_CARET;
+    case '-': return REGEX_T_DASH;
+    case '\\':
+        if (*rl_p == '\n' || !*rl_p) { regex_char_value = c; return REGEX_T_CHAR; }
+        c = *rl_p++;
+        if (c == 'n') regex_char_value = '\n';
+        else if (c == 't') regex_char_value = '\t';
+        else if (c == 'r') regex_char_value = '\r';
+        else regex_char_value = c;
+        return REGEX_T_ESCAPE;
+    case '\n': regex_char_value = c; return REGEX_T_CHAR;
+    default: regex_char_value = c; return REGEX_T_CHAR;
+    }
+}
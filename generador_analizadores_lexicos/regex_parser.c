@@ -140,128 +140,146 @@ static int ll1_lookup(RegexParserContext *rctx, int nt_id, int terminal_id) {
 // INVERSO (para que se procesen de izquierda a derecha), intercalando
 // marcadores de acción semántica donde corresponda.
 
-static void rpush(GrammarSymbol* stack, int* top, SymbolType type, int id) {
-    if (*top < RSTACK_MAX)
-        stack[(*top)++] = (GrammarSymbol){type, id};
+// Pila del parser: buffer inline + crecimiento en heap (sin tope fijo).
+typedef struct {
+    GrammarSymbol  inline_buf[RSTACK_INLINE];
+    GrammarSymbol* heap;
+    int top;
+    int cap;
+    int oom;
+} RegexParseStack;
+
+static GrammarSymbol* rstack_data(RegexParseStack* s) {
+    return s->heap ? s->heap : s->inline_buf;
 }
 
-static void push_production(int prod_id, GrammarSymbol* stack, int* top) {
+static void rpush(RegexParseStack* stack, SymbolType type, int id) {
+    if (stack->top >= stack->cap &&
+        !stack_util_grow((void**)&stack->heap, stack->inline_buf, &stack->cap,
+                         stack->top, sizeof(GrammarSymbol))) {
+        stack->oom = 1;
+        return;
+    }
+    rstack_data(stack)[stack->top++] = (GrammarSymbol){type, id};
+}
+
+static void push_production(int prod_id, RegexParseStack* stack) {
     switch (prod_id) {
     // [0] Regex -> Concat ConcatTail
     case 0:
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_ConcatTail);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Concat);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_ConcatTail);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Concat);
         break;
     // [1] ConcatTail -> OR Concat ConcatTail
     case 1:
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_ConcatTail);
-        rpush(stack, top, SYMBOL_ACTION, ACT_OR);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Concat);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_OR);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_ConcatTail);
+        rpush(stack, SYMBOL_ACTION, ACT_OR);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Concat);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_OR);
         break;
     // [2] ConcatTail -> ε
     case 2:
         break;
     // [3] Concat -> Repeat Concat
     case 3:
-        rpush(stack, top, SYMBOL_ACTION, ACT_CONCAT);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Concat);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Repeat);
+        rpush(stack, SYMBOL_ACTION, ACT_CONCAT);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Concat);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Repeat);
         break;
     // [4] Concat -> ε
     case 4:
-        rpush(stack, top, SYMBOL_ACTION, ACT_PUSH_NULL);
+        rpush(stack, SYMBOL_ACTION, ACT_PUSH_NULL);
         break;
     // [5] Repeat -> Atom Postfix
     case 5:
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Postfix);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Atom);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Postfix);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Atom);
         break;
     // [6] Postfix -> STAR
     case 6:
-        rpush(stack, top, SYMBOL_ACTION, ACT_STAR);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_STAR);
+        rpush(stack, SYMBOL_ACTION, ACT_STAR);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_STAR);
         break;
     // [7] Postfix -> PLUS
     case 7:
-        rpush(stack, top, SYMBOL_ACTION, ACT_PLUS_OP);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_PLUS);
+        rpush(stack, SYMBOL_ACTION, ACT_PLUS_OP);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_PLUS);
         break;
     // [8] Postfix -> QUESTION
     case 8:
-        rpush(stack, top, SYMBOL_ACTION, ACT_QUESTION_OP);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_QUESTION);
+        rpush(stack, SYMBOL_ACTION, ACT_QUESTION_OP);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_QUESTION);
         break;
     // [9] Postfix -> ε
     case 9:
         break;
     // [10] Atom -> CHAR
     case 10:
-        rpush(stack, top, SYMBOL_ACTION, ACT_LEAF);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_CHAR);
+        rpush(stack, SYMBOL_ACTION, ACT_LEAF);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_CHAR);
         break;
     // [11] Atom -> ESCAPE
     case 11:
-        rpush(stack, top, SYMBOL_ACTION, ACT_LEAF);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_ESCAPE);
+        rpush(stack, SYMBOL_ACTION, ACT_LEAF);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_ESCAPE);
         break;
     // [12] Atom -> LPAREN Regex RPAREN
     case 12:
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_RPAREN);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_Regex);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_LPAREN);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_RPAREN);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_Regex);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_LPAREN);
         break;
     // [13] Atom -> LBRACKET CharClass RBRACKET
     case 13:
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_RBRACKET);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_CharClass);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_LBRACKET);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_RBRACKET);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_CharClass);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_LBRACKET);
         break;
     // [14] Atom -> DOT
     case 14:
-        rpush(stack, top, SYMBOL_ACTION, ACT_DOT);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_DOT);
+        rpush(stack, SYMBOL_ACTION, ACT_DOT);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_DOT);
         break;
     // [15] CharClass -> CARET CCItems
     case 15:
-        rpush(stack, top, SYMBOL_ACTION, ACT_NEGATE);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_CCItems);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_CARET);
+        rpush(stack, SYMBOL_ACTION, ACT_NEGATE);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_CCItems);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_CARET);
         break;
     // [16] CharClass -> CCItems
     case 16:
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_CCItems);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_CCItems);
         break;
     // [17] CCItems -> CCItem CCItems
     case 17:
-        rpush(stack, top, SYMBOL_ACTION, ACT_OR_OPT);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_CCItems);
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_CCItem);
+        rpush(stack, SYMBOL_ACTION, ACT_OR_OPT);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_CCItems);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_CCItem);
         break;
     // [18] CCItems -> ε
     case 18:
-        rpush(stack, top, SYMBOL_ACTION, ACT_PUSH_NULL);
+        rpush(stack, SYMBOL_ACTION, ACT_PUSH_NULL);
         break;
     // [19] CCItem -> CHAR RangeOpt
     case 19:
-        rpush(stack, top, SYMBOL_NON_TERMINAL, RNT_RangeOpt);
-        rpush(stack, top, SYMBOL_ACTION, ACT_SAVE_RANGE_START);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_CHAR);
+        rpush(stack, SYMBOL_NON_TERMINAL, RNT_RangeOpt);
+        rpush(stack, SYMBOL_ACTION, ACT_SAVE_RANGE_START);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_CHAR);
         break;
     // [20] CCItem -> ESCAPE
     case 20:
-        rpush(stack, top, SYMBOL_ACTION, ACT_LEAF);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_ESCAPE);
+        rpush(stack, SYMBOL_ACTION, ACT_LEAF);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_ESCAPE);
         break;
     // [21] RangeOpt -> DASH CHAR
     case 21:
-        rpush(stack, top, SYMBOL_ACTION, ACT_RANGE);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_CHAR);
-        rpush(stack, top, SYMBOL_TERMINAL, REGEX_T_DASH);
+        rpush(stack, SYMBOL_ACTION, ACT_RANGE);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_CHAR);
+        rpush(stack, SYMBOL_TERMINAL, REGEX_T_DASH);
         break;
     // [22] RangeOpt -> ε (solo carácter individual)
     case 22:
-        rpush(stack, top, SYMBOL_ACTION, ACT_LEAF_RANGE_START);
+        rpush(stack, SYMBOL_ACTION, ACT_LEAF_RANGE_START);
         break;
     default:
         LOG_ERROR_MSG("regex", "producción desconocida %d", prod_id);
@@ -284,12 +302,11 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
     regex_parser_ensure_init(rctx);
 
     // Pila del parser
-    GrammarSymbol pstack[RSTACK_MAX];
-    int ptop = 0;
+    RegexParseStack pstack = { .heap = NULL, .top = 0, .cap = RSTACK_INLINE, .oom = 0 };
 
     // Pila semántica
-    ASTNode* sem[SEM_STACK_MAX];
-    int sem_top = 0;
+    RegexSemStack sem;
+    rsem_init(&sem);
 
     // Valores auxiliares para terminales
     char saved_char = 0;
@@ -300,8 +317,8 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
     char current_char_value;
 
     // Inicializar pila: $ y símbolo inicial (Regex)
-    pstack[ptop++] = (GrammarSymbol){SYMBOL_END, 0};
-    pstack[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, RNT_Regex};
+    rpush(&pstack, SYMBOL_END, 0);
+    rpush(&pstack, SYMBOL_NON_TERMINAL, RNT_Regex);
 
     // Iniciar lexer flex y obtener primer token
     regex_lexer_set_string(regex_str);
@@ -309,8 +326,8 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
 
     int error = 0;
 
-    while (ptop > 0 && !error) {
-        GrammarSymbol top = pstack[--ptop];
+    while (pstack.top > 0 && !error) {
+        GrammarSymbol top = rstack_data(&pstack)[--pstack.top];
 
         switch (top.type) {
         case SYMBOL_EPSILON:
@@ -340,7 +357,11 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
                               top.id, current_token_type);
                 error = 1;
             } else {
-                push_production(prod, pstack, &ptop);
+                push_production(prod, &pstack);
+                if (pstack.oom) {
+                    LOG_ERROR_MSG("regex", "sin memoria para la pila del parser");
+                    error = 1;
+                }
             }
             break;
         }
@@ -350,7 +371,11 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
                 // Caso especial: actualizar variable local, no la pila semántica
                 range_start_char = saved_char;
             } else {
-                exec_action(top.id, sem, &sem_top, saved_char, range_start_char, ctx);
+                exec_action(top.id, &sem, saved_char, range_start_char, ctx);
+                if (sem.oom) {
+                    LOG_ERROR_MSG("regex", "sin memoria para la pila semántica");
+                    error = 1;
+                }
             }
             break;
         }
@@ -358,13 +383,16 @@ ASTNode* regex_parse(const char* regex_str, ASTContext *ctx,
 
 done:
     regex_lexer_cleanup();
+    free(pstack.heap);
 
+    ASTNode* result = NULL;
     if (error) {
-        for (int i = 0; i < sem_top; i++)
-            if (sem[i]) ast_free(sem[i]);
-        return NULL;
+        for (int i = 0; i < sem.top; i++)
+            if (rsem_data(&sem)[i]) ast_free(rsem_data(&sem)[i]);
+    } else {
+        result = rsem_pop(&sem);
     }
-
-    return (sem_top > 0) ? sem[--sem_top] : NULL;
+    rsem_release(&sem);
+    return result;
 }
 
@@ -6,6 +6,7 @@
  *   - SemanticAction: los marcadores ACT_* que se apilan y disparan
  *     construcción de nodos del AST.
  *   - RNT_*: IDs de no-terminales (deben coincidir con grammar_init_regex).
+ *   - RegexSemStack: pila semántica de ASTNode* (buffer inline + heap).
  *   - exec_action: ejecuta una acción semántica sobre la pila semántica.
  *
  * Header PRIVADO del subsistema lexer; no lo incluye código externo.
@@ -15,9 +16,51 @@
 #define REGEX_PARSER_INTERNAL_H
 
 #include "ast.h"
+#include "../generador_parser_ll1/stack_util.h"
 
-#define RSTACK_MAX 2048
-#define SEM_STACK_MAX 512
+/* Capacidades iniciales (inline) de las pilas; crecen en heap si hace falta. */
+#define RSTACK_INLINE 128
+#define SEM_STACK_INLINE 64
+
+/* Pila semántica: los nodos viven en inline_buf hasta que la regex es
+ * más profunda; entonces migran a heap (ver stack_util.h). */
+typedef struct {
+    ASTNode  *inline_buf[SEM_STACK_INLINE];
+    ASTNode **heap;      /* NULL mientras todo quepa en inline_buf */
+    int top;
+    int cap;
+    int oom;             /* 1 si un push falló por falta de memoria */
+} RegexSemStack;
+
+static inline void rsem_init(RegexSemStack *s) {
+    s->heap = NULL;
+    s->top = 0;
+    s->cap = SEM_STACK_INLINE;
+    s->oom = 0;
+}
+
+static inline ASTNode **rsem_data(RegexSemStack *s) {
+    return s->heap ? s->heap : s->inline_buf;
+}
+
+static inline void rsem_push(RegexSemStack *s, ASTNode *n) {
+    if (s->top >= s->cap &&
+        !stack_util_grow((void **)&s->heap, s->inline_buf, &s->cap,
+                         s->top, sizeof(ASTNode *))) {
+        s->oom = 1;
+        return;
+    }
+    rsem_data(s)[s->top++] = n;
+}
+
+static inline ASTNode *rsem_pop(RegexSemStack *s) {
+    return (s->top > 0) ? rsem_data(s)[--s->top] : NULL;
+}
+
+static inline void rsem_release(RegexSemStack *s) {
+    free(s->heap);
+    rsem_init(s);
+}
 
 /* Acciones semánticas: marcadores que, al extraerse de la pila del
  * parser, construyen nodos del AST de la regex sobre la pila semántica. */
@@ -45,7 +88,7 @@ enum {
 };
 
 /* Ejecuta la acción semántica `act` sobre la pila semántica `sem`. */
-void exec_action(int act, ASTNode **sem, int *sem_top,
+void exec_action(int act, RegexSemStack *sem,
                  char saved_char, char range_start_char,
                  ASTContext *ctx);
 
@@ -0,0 +1,177 @@
+#include "token_stream.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+#define RING_MASK  ((unsigned long)TOKEN_RING_CAP - 1)
+#define CACHE_LINE 64
+
+#define LOAD_ACQ(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+// Token publicado más el estado del lexer tras él (para retomar en línea
+// o re-escanear desde ese punto).
+typedef struct {
+    Token tok;
+    int   end_pos, end_line, end_col;
+} RingSlot;
+
+// `head` lo escribe solo el productor y `tail`/`stop` solo el consumidor;
+// van en líneas de caché distintas para no rebotar entre núcleos.
+struct TokenRing {
+    RingSlot     *slots;
+    LexerContext  lx;       // estado del productor (silencioso)
+    pthread_t     thread;
+    unsigned long head;     // slots publicados
+    char          pad0[CACHE_LINE - sizeof(unsigned long)];
+    unsigned long tail;     // slots consumidos
+    int           stop;
+    char          pad1[CACHE_LINE - sizeof(unsigned long) - sizeof(int)];
+    int           done;     // el productor no publicará más
+    int           spin;     // esperas activas antes de ceder (0 con 1 CPU)
+};
+
+// Espera activa corta y luego cede la CPU: con un solo núcleo el otro
+// extremo no avanza si no se le cede, así que ahí se cede de inmediato.
+static void ring_backoff(const TokenRing *r, int *spins) {
+    if (++*spins > r->spin) sched_yield();
+}
+
+static void* ring_producer(void *arg) {
+    TokenRing *r = arg;
+    unsigned long head = 0, tail_seen = 0;
+    for (;;) {
+        Token t = lexer_next_token(&r->lx);
+        if (t.type == TOKEN_ERROR) {
+            // El consumidor re-lexea este token en línea y lo reporta
+            free(t.lexeme);
+            break;
+        }
+        int spins = 0;
+        while (head - tail_seen >= TOKEN_RING_CAP) {
+            if (LOAD_ACQ(&r->stop)) { free(t.lexeme); goto out; }
+            tail_seen = LOAD_ACQ(&r->tail);
+            if (head - tail_seen >= TOKEN_RING_CAP) ring_backoff(r, &spins);
+        }
+        RingSlot *s = &r->slots[head & RING_MASK];
+        s->tok      = t;
+        s->end_pos  = r->lx.pos;
+        s->end_line = r->lx.line;
+        s->end_col  = r->lx.col;
+        STORE_REL(&r->head, ++head);
+        if (t.type == TOKEN_EOF || LOAD_ACQ(&r->stop)) break;
+    }
+out:
+    STORE_REL(&r->done, 1);
+    return NULL;
+}
+
+// Espera a que el slot `k` esté publicado. Retorna 0 si el productor
+// terminó sin llegar a él.
+static int ring_wait(TokenRing *r, unsigned long k) {
+    int spins = 0;
+    for (;;) {
+        if (LOAD_ACQ(&r->head) > k) return 1;
+        if (LOAD_ACQ(&r->done)) return LOAD_ACQ(&r->head) > k;
+        ring_backoff(r, &spins);
+    }
+}
+
+static void slot_position(const RingSlot *s, LexerContext *lx) {
+    lx->pos  = s->end_pos;
+    lx->line = s->end_line;
+    lx->col  = s->end_col;
+}
+
+int token_stream_open(TokenStream *ts, DFA *dfa, const char *input,
+                      TokenStreamMode mode) {
+    return token_stream_open_at(ts, dfa, input, mode, 1, 1);
+}
+
+int token_stream_open_at(TokenStream *ts, DFA *dfa, const char *input,
+                         TokenStreamMode mode, int line, int col) {
+    lexer_init(&ts->lx, dfa, input);
+    ts->lx.line = line;
+    ts->lx.col = col;
+    ts->ring = NULL;
+    ts->drained = 0;
+    ts->peeked = 0;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (mode == TOKEN_STREAM_AUTO)
+        mode = (strlen(input) >= TOKEN_STREAM_THREAD_MIN && cpus > 1)
+               ? TOKEN_STREAM_THREADED : TOKEN_STREAM_INLINE;
+    if (mode != TOKEN_STREAM_THREADED) return 0;
+
+    TokenRing *r = calloc(1, sizeof(TokenRing));
+    if (!r) return 0;
+    r->slots = malloc(TOKEN_RING_CAP * sizeof(RingSlot));
+    if (!r->slots) { free(r); return 0; }
+    r->lx = ts->lx;
+    r->lx.quiet = 1;
+    r->spin = cpus > 1 ? 64 : 0;
+    if (pthread_create(&r->thread, NULL, ring_producer, r) != 0) {
+        free(r->slots);
+        free(r);
+        return 0;
+    }
+    ts->ring = r;
+    return 1;
+}
+
+Token token_stream_next(TokenStream *ts) {
+    TokenRing *r = ts->ring;
+    if (!r || ts->drained) return lexer_next_token(&ts->lx);
+
+    unsigned long k = r->tail;
+    if (!ring_wait(r, k)) {
+        // Fin del anillo (EOF ya entregado o token erróneo): seguir en línea
+        ts->drained = 1;
+        return lexer_next_token(&ts->lx);
+    }
+    RingSlot *s = &r->slots[k & RING_MASK];
+    Token t = s->tok;
+    slot_position(s, &ts->lx);
+    STORE_REL(&r->tail, k + 1);
+    return t;
+}
+
+void token_stream_close(TokenStream *ts) {
+    TokenRing *r = ts->ring;
+    if (!r) return;
+    STORE_REL(&r->stop, 1);
+    pthread_join(r->thread, NULL);
+    for (unsigned long k = r->tail; k < r->head; k++)
+        free(r->slots[k & RING_MASK].tok.lexeme);
+    free(r->slots);
+    free(r);
+    ts->ring = NULL;
+}
+
+void token_cursor_init(TokenCursor *c, TokenStream *ts) {
+    c->ts = ts;
+    c->lx = ts->lx;
+    c->lx.quiet = 1;  // los errores los reporta el flujo al consumirlos
+    c->rescanning = !ts->ring || ts->drained;
+    c->k = ts->ring ? ts->ring->tail : 0;
+}
+
+int token_cursor_next(TokenCursor *c) {
+    c->ts->peeked++;
+    if (!c->rescanning) {
+        TokenRing *r = c->ts->ring;
+        // Dentro de la ventana el slot no puede ser reciclado: tail no
+        // avanza mientras el consumidor está mirando hacia adelante.
+        if (c->k - r->tail < TOKEN_RING_CAP && ring_wait(r, c->k)) {
+            const RingSlot *s = &r->slots[c->k & RING_MASK];
+            c->k++;
+            slot_position(s, &c->lx);
+            return s->tok.type;
+        }
+        c->rescanning = 1;
+    }
+    Token t = lexer_next_token(&c->lx);
+    free(t.lexeme);
+    return t.type;
+}
@@ -0,0 +1,85 @@
+/*
+ * token_stream.h — Flujo de tokens del lexer para el parser
+ *
+ * Dos modos con la misma interfaz:
+ *   - en línea: el parser llama a lexer_next_token token a token;
+ *   - con hilo: un hilo productor lexea por delante y publica los tokens
+ *     en un anillo SPSC (un productor, un consumidor, sin locks) que el
+ *     parser consume; en entradas grandes el tiempo total tiende a
+ *     max(lexer, parser) en vez de su suma.
+ *
+ * El lookahead acotado (TokenCursor) lee los tokens ya publicados sin
+ * consumirlos; si se sale de la ventana del anillo re-escanea con una
+ * copia del lexer, igual que en el modo en línea.
+ *
+ * Diagnósticos idénticos en ambos modos: el productor lexea en silencio
+ * y se detiene ANTES del primer token erróneo; desde ahí el consumidor
+ * sigue en línea y el error se reporta en el mismo punto que sin hilo.
+ *
+ * Responsabilidad única (SRP): solo transporta tokens; no conoce la
+ * gramática ni el AST.
+ */
+
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include "lexer.h"
+
+typedef enum {
+    TOKEN_STREAM_INLINE,    // sin hilo
+    TOKEN_STREAM_THREADED,  // hilo productor + anillo
+    TOKEN_STREAM_AUTO       // THREADED si la entrada es grande y hay >1 CPU
+} TokenStreamMode;
+
+// Tamaño mínimo de entrada (bytes) para que AUTO lance el hilo: por debajo
+// el costo de crear el hilo supera al de lexear.
+#define TOKEN_STREAM_THREAD_MIN (256 * 1024)
+
+// Capacidad del anillo (potencia de 2); es también la ventana máxima del
+// lookahead que se sirve sin re-escanear.
+#define TOKEN_RING_CAP 4096
+
+typedef struct TokenRing TokenRing;
+
+typedef struct {
+    LexerContext lx;        // estado tras el último token consumido
+    TokenRing   *ring;      // NULL en modo en línea
+    int          drained;   // el productor terminó: seguir en línea
+    long         peeked;    // tokens leídos por cursores de lookahead
+} TokenStream;
+
+// Abre el flujo sobre `input`. Si no puede crear el hilo, cae al modo en
+// línea. Retorna 1 si quedó en modo con hilo.
+int   token_stream_open(TokenStream *ts, DFA *dfa, const char *input,
+                        TokenStreamMode mode);
+
+// Igual, para una entrada que es un fragmento de un archivo mayor: las
+// posiciones de los tokens arrancan en (line, col).
+int   token_stream_open_at(TokenStream *ts, DFA *dfa, const char *input,
+                           TokenStreamMode mode, int line, int col);
+
+// Siguiente token; el lexema pasa a ser del caller (free).
+Token token_stream_next(TokenStream *ts);
+
+// Detiene el productor y libera los tokens no consumidos.
+void  token_stream_close(TokenStream *ts);
+
+// Cursor de lookahead: recorre los tokens que siguen al último consumido
+// sin alterar el flujo ni reportar errores léxicos (salen una vez, al
+// consumir el token). Es un valor: copiarlo bifurca la lectura.
+typedef struct {
+    TokenStream  *ts;
+    unsigned long k;          // índice absoluto del próximo slot a leer
+    LexerContext  lx;         // posición del cursor; re-escaneo fuera de ventana
+    int           rescanning;
+} TokenCursor;
+
+void token_cursor_init(TokenCursor *c, TokenStream *ts);
+
+// Tipo del siguiente token (avanza el cursor).
+int  token_cursor_next(TokenCursor *c);
+
+// Offset en la entrada tras el último token leído por el cursor.
+static inline int token_cursor_pos(const TokenCursor *c) { return c->lx.pos; }
+
+#endif /* TOKEN_STREAM_H */
@@ -26,7 +26,7 @@ void parser_set_lexer(ParserContext* ctx, Token (*get_token)(void*), void* lexer
 
 void parser_reset(ParserContext* ctx)
 {
-    stack_init(&ctx->stack);
+    stack_release(&ctx->stack);
     ctx->error_count = 0;
 }
 
@@ -50,6 +50,8 @@ static const char* get_terminal_name(Grammar* g, int token_type) {
     return "?";
 }
 
+static int parser_run(ParserContext* ctx);
+
 int parser_parse(ParserContext* ctx)
 {
     if (!ctx->grammar || !ctx->table || !ctx->get_next_token) {
@@ -57,12 +59,20 @@ int parser_parse(ParserContext* ctx)
         return 0;
     }
     
+    stack_init(&ctx->stack);
+    int ok = parser_run(ctx);
+    stack_release(&ctx->stack);
+    return ok;
+}
+
+static int parser_run(ParserContext* ctx)
+{
+    
     Grammar* g = ctx->grammar;
     LL1_Table* ll1 = ctx->table;
     ParserStack* stack = &ctx->stack;
     
     // Inicializar stack: push $ y símbolo inicial
-    stack_init(stack);
     stack_push(stack, (GrammarSymbol){SYMBOL_END, END_MARKER});
     stack_push(stack, (GrammarSymbol){SYMBOL_NON_TERMINAL, g->start_symbol});
     
@@ -188,12 +198,6 @@ int parser_parse(ParserContext* ctx)
             
             Production* prod = &g->productions[prod_index];
             
-            // Verificar desbordamiento de pila
-            if (stack->top + prod->right_count >= STACK_MAX) {
-                LOG_FATAL_MSG("parser", "desbordamiento de pila del parser (STACK_MAX=%d)", STACK_MAX);
-                return 0;
-            }
-            
             // Push RHS en orden inverso (si no es ε)
             for (int i = prod->right_count - 1; i >= 0; i--) {
                 GrammarSymbol s = prod->right[i];
@@ -205,6 +209,11 @@ int parser_parse(ParserContext* ctx)
                 }
                 // SYMBOL_EPSILON no se hace push
             }
+            
+            if (stack->oom) {
+                LOG_FATAL_MSG("parser", "sin memoria para la pila del parser (%d símbolos)", stack->top);
+                return 0;
+            }
         }
     }
 }
@@ -4,16 +4,22 @@
 #include "first_follow.h"
 #include "grammar.h"
 #include "ll1_table.h"
+#include "stack_util.h"
 #include <stdio.h>
 
 // ============== STACK DEL PARSER ==============
+// Buffer inline para el caso común; si la derivación es más profunda la
+// pila migra a heap y crece al doble (ver stack_util.h). No hay límite fijo.
 
-#define STACK_MAX 2048
+#define STACK_INLINE 256
 
 typedef struct
 {
-    GrammarSymbol data[STACK_MAX];
+    GrammarSymbol inline_buf[STACK_INLINE];
+    GrammarSymbol* heap;   // NULL mientras todo quepa en inline_buf
     int top;
+    int cap;
+    int oom;               // 1 si un push falló por falta de memoria
 } ParserStack;
 
 // ============== ESTRATEGIA DE RECUPERACIÓN DE ERRORES ==============
@@ -55,7 +61,8 @@ void parser_init(ParserContext* ctx, Grammar* g, LL1_Table* table, Follow_Table*
 void parser_set_lexer(ParserContext* ctx, Token (*get_token)(void*), void* lexer_ctx);
 
 // Ejecuta el análisis sintáctico
-// Retorna 1 si tiene éxito, 0 si hay errores
+// Retorna 1 si tiene éxito, 0 si hay errores.
+// La pila se libera al terminar: no hace falta destruir el contexto.
 int parser_parse(ParserContext* ctx);
 
 // Resetea el parser para una nueva entrada
@@ -64,7 +71,20 @@ void parser_reset(ParserContext* ctx);
 // ============== FUNCIONES DE STACK ==============
 
 static inline void stack_init(ParserStack* s) {
+    s->heap = NULL;
     s->top = 0;
+    s->cap = STACK_INLINE;
+    s->oom = 0;
+}
+
+// Libera el buffer en heap (si lo hubo) y deja la pila vacía
+static inline void stack_release(ParserStack* s) {
+    free(s->heap);
+    stack_init(s);
+}
+
+static inline GrammarSymbol* stack_data(ParserStack* s) {
+    return s->heap ? s->heap : s->inline_buf;
 }
 
 static inline int stack_empty(ParserStack* s) {
@@ -72,19 +92,24 @@ static inline int stack_empty(ParserStack* s) {
 }
 
 static inline void stack_push(ParserStack* s, GrammarSymbol sym) {
-    if (s->top < STACK_MAX)
-        s->data[s->top++] = sym;
+    if (s->top >= s->cap &&
+        !stack_util_grow((void**)&s->heap, s->inline_buf, &s->cap,
+                         s->top, sizeof(GrammarSymbol))) {
+        s->oom = 1;
+        return;
+    }
+    stack_data(s)[s->top++] = sym;
 }
 
 static inline GrammarSymbol stack_pop(ParserStack* s) {
     if (s->top > 0)
-        return s->data[--s->top];
+        return stack_data(s)[--s->top];
     return (GrammarSymbol){SYMBOL_END, END_MARKER};
 }
 
 static inline GrammarSymbol stack_peek(ParserStack* s) {
     if (s->top > 0)
-        return s->data[s->top - 1];
+        return stack_data(s)[s->top - 1];
     return (GrammarSymbol){SYMBOL_END, END_MARKER};
 }
 
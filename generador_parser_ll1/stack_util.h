@@ -0,0 +1,39 @@
+/*
+ * stack_util.h — Crecimiento de pilas con buffer inline
+ *
+ * Las pilas de los parsers (LL(1) genérico, regex y builder HULK) arrancan
+ * sobre un buffer inline de tamaño fijo: sin malloc en el caso común y con
+ * la cima siempre en caché. Si la entrada es más profunda, la pila migra a
+ * un buffer en heap que crece al doble (coste amortizado O(1) por push).
+ *
+ * Responsabilidad única (SRP): solo gestiona la migración/crecimiento;
+ * cada pila decide su tipo de elemento y su política ante OOM.
+ */
+
+#ifndef STACK_UTIL_H
+#define STACK_UTIL_H
+
+#include <stdlib.h>
+#include <string.h>
+
+// Duplica la capacidad de una pila cuyos `used` elementos viven en
+// `*heap` (si ya migró) o en `inline_buf` (si no). Actualiza *heap y *cap.
+// Retorna 1 si tuvo éxito, 0 si no hubo memoria (la pila queda intacta).
+static inline int stack_util_grow(void **heap, const void *inline_buf,
+                                  int *cap, int used, size_t elem_size)
+{
+    int new_cap = *cap > 0 ? *cap * 2 : 16;
+    void *buf;
+    if (*heap) {
+        buf = realloc(*heap, (size_t)new_cap * elem_size);
+    } else {
+        buf = malloc((size_t)new_cap * elem_size);
+        if (buf && used > 0) memcpy(buf, inline_buf, (size_t)used * elem_size);
+    }
+    if (!buf) return 0;
+    *heap = buf;
+    *cap = new_cap;
+    return 1;
+}
+
+#endif
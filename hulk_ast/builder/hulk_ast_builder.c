@@ -1,14 +1,22 @@
 /*
  * hulk_ast_builder.c — API pública del AST builder
  *
- * El parser principal de HULK es el builder LL(1) dirigido por tabla.
- * Se conserva hulk_build_ast como fachada estable para el CLI, el compiler
- * y los tests.
+ * El parser principal de HULK es el descendente recursivo generado desde
+ * la gramática del builder LL(1) (mismo AST que el motor de tabla, sin
+ * pila explícita). Se conserva hulk_build_ast como fachada estable para el
+ * CLI, el compiler y los tests. En entradas grandes los ítems de nivel
+ * superior se reparten entre hilos (hulk_parallel_builder) o, si no hay
+ * fronteras, el lexer corre en un hilo productor (TOKEN_STREAM_AUTO); el
+ * resultado no cambia.
  */
 
 #include "hulk_ast_builder.h"
 #include "hulk_ll1_builder.h"
+#include "hulk_parallel_builder.h"
+#include <string.h>
 
 HulkNode* hulk_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
-    return hulk_ll1_build_ast(ctx, dfa, input);
+    if (input && strlen(input) >= HULK_PARALLEL_MIN_BYTES)
+        return hulk_parallel_build_ast(ctx, dfa, input, 0);
+    return hulk_rd_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_AUTO);
 }
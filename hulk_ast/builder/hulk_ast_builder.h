@@ -2,7 +2,8 @@
  * hulk_ast_builder.h — API pública para construir el AST
  *
  * Expone la fachada estable hulk_build_ast. La implementación vigente es
- * el parser LL(1) dirigido por tabla de hulk_ll1_builder.
+ * el parser descendente recursivo generado desde la gramática LL(1) de
+ * hulk_ll1_builder (hulk_rd_build_ast).
  *
  * Principios SOLID:
  *   SRP — Solo construye el AST; no valida semántica ni genera código.
@@ -12,80 +12,22 @@
  * resultados; las acciones construyen los nodos del AST. Las listas de
  * longitud variable (args, bindings, …) usan el patrón centinela.
  *
- * Estado: CAPA 3 — parser LL(1) funcional con definiciones, decoradores,
- * lambdas, tipos/protocolos, arrays/iteradores y `define`.
+ * Estado: CAPA 4 — parser LL(1) funcional con definiciones, decoradores,
+ * lambdas, tipos/protocolos, arrays/iteradores, `define` y genéricos.
  */
 
 #include "hulk_ll1_builder.h"
+#include "hulk_ll1_internal.h"
 #include "hulk_ast_builder.h"
-#include "../../generador_analizadores_lexicos/lexer.h"
+#include "../../generador_analizadores_lexicos/token_stream.h"
 #include "../../generador_parser_ll1/grammar.h"
 #include "../../generador_parser_ll1/first_follow.h"
 #include "../../generador_parser_ll1/ll1_table.h"
+#include "../../generador_parser_ll1/stack_util.h"
 #include "../../error_handler.h"
 #include <stdlib.h>
 #include <string.h>
 
-/* ============================================================
- *  No-terminales
- * ============================================================ */
-enum {
-    NT_Program, NT_TopList, NT_TopItem, NT_OptSemi, NT_StmtList, NT_TermStmt, NT_Stmt,
-    NT_Expr, NT_Or, NT_OrP, NT_And, NT_AndP, NT_Cmp, NT_CmpP,
-    NT_Concat, NT_ConcatP, NT_Add, NT_AddP, NT_Term, NT_TermP,
-    NT_Factor, NT_FactorP, NT_Unary, NT_Postfix,
-    NT_Primary, NT_Call, NT_Args, NT_ArgsT,
-    NT_Let, NT_Bindings, NT_BindingsT, NT_Binding, NT_TypeAnn,
-    NT_If, NT_ElifL, NT_Body,
-    NT_While, NT_For, NT_Block,
-    NT_VecItems, NT_VecItemsT,
-    /* Capa 2: definiciones */
-    NT_FunctionDef, NT_Params, NT_ParamsT, NT_Param, NT_FuncBody, NT_FuncExprBody,
-    NT_TypeDef, NT_TypeParams, NT_TypeInherit, NT_TypeBaseArgs,
-    NT_TypeBody, NT_TypeMember, NT_TypeMemberTail, NT_AttrTail, NT_MethodBody,
-    NT_ProtocolDef, NT_ProtoExt, NT_ProtoSigs, NT_ProtoSig,
-    NT_DecorBlock, NT_DecorMore, NT_DecorTarget,
-    NT_DecorItems, NT_DecorItemsT, NT_DecorItem, NT_DecorArgs,
-    NT_DecorPrefix,
-    NT_TypeRef, NT_TypeSuffix, NT_TypeList, NT_TypeListT,
-    NT_NewTail, NT_ArrayTypeSuffix, NT_ArrayInit,
-    NT_Lambda,
-    NT_COUNT
-};
-
-/* ============================================================
- *  Acciones semánticas (offset alto para distinguir de NT/T)
- * ============================================================ */
-enum {
-    A_NUM = 9000, A_STR, A_TRUE, A_FALSE, A_IDENT, A_SELF,
-    A_OR, A_AND, A_LT, A_GT, A_LE, A_GE, A_EQ, A_NEQ,
-    A_CONCAT, A_CONCATWS, A_ADD, A_SUB, A_MUL, A_DIV, A_MOD, A_POW,
-    A_NEG, A_NOT, A_AS, A_IS,
-    A_SENT, A_CALL, A_MEMBER, A_INDEX, A_ASSIGN, A_DESTRUCT,
-    A_NEW, A_BASE,
-    A_LET, A_BIND, A_TYPE_NAME, A_TYPE_NONE,
-    A_IF, A_ELIF, A_WHILE, A_FOR, A_BLOCK_BEGIN, A_BLOCK,
-    A_VEC,
-    /* Capa 2 */
-    A_PARAM, A_FUNCDEF, A_FUNCEXPR,
-    A_TD_BEGIN, A_TD_PARAMS, A_TD_PARENT, A_TD_PARGS,
-    A_METHOD, A_ATTR, A_ATTR_NOINIT,
-    A_PROTO_BEGIN, A_PROTO_METHOD,
-    A_DECOR_ITEM, A_DECOR_BLOCK, A_TYPE_FUNC,
-    /* Capa 3 */
-    A_TYPE_ARRAY, A_TYPE_ITER, A_ARRAY_NEW, A_ARRAY_INIT,
-};
-
-/* Codificación de símbolos en el RHS de los datos:
- *   NT:  0 .. NT_COUNT-1
- *   T:   TBASE + TOKEN_*
- *   ACT: (ya >= 9000) */
-#define TBASE 1000
-#define T(tok) (TBASE + (tok))
-#define IS_T(x)   ((x) >= TBASE && (x) < 9000)
-#define IS_ACT(x) ((x) >= 9000)
-#define IS_NT(x)  ((x) >= 0 && (x) < TBASE)
-
 typedef struct { int lhs; int rhs[16]; int n; } Prod;
 
 /* ============================================================
@@ -196,7 +138,7 @@ static const Prod HULK_PRODS[] = {
                 | IDENT @ident | SELF @self
                 | LPAREN Expr RPAREN
                 | IF ... | LET ...
-                | NEW IDENT NewTail
+                | NEW IDENT TypeArgs NewTail
                 | BASE LPAREN @sent Args RPAREN @base
                 | LBRACKET @sent VecItems RBRACKET @vec
                 | LBRACE @sent VecItems RBRACE @vec */
@@ -209,7 +151,7 @@ static const Prod HULK_PRODS[] = {
     { NT_Primary, { NT_If }, 1 },
     { NT_Primary, { NT_Let }, 1 },
     { NT_Primary, { T(TOKEN_LPAREN), NT_Expr, T(TOKEN_RPAREN) }, 3 },
-    { NT_Primary, { T(TOKEN_NEW), T(TOKEN_IDENT), NT_NewTail }, 3 },
+    { NT_Primary, { T(TOKEN_NEW), T(TOKEN_IDENT), NT_TypeArgs, NT_NewTail }, 4 },
     { NT_Primary, { T(TOKEN_BASE), T(TOKEN_LPAREN), A_SENT, NT_Args, T(TOKEN_RPAREN), A_BASE }, 6 },
     { NT_Primary, { T(TOKEN_LBRACKET), A_SENT, NT_VecItems, T(TOKEN_RBRACKET), A_VEC }, 5 },
     { NT_Primary, { T(TOKEN_LBRACE), A_SENT, NT_VecItems, T(TOKEN_RBRACE), A_VEC }, 5 },
@@ -239,8 +181,8 @@ static const Prod HULK_PRODS[] = {
     /* TypeAnn -> COLON TypeRef @typename | ε @typenone */
     { NT_TypeAnn, { T(TOKEN_COLON), NT_TypeRef, A_TYPE_NAME }, 3 },
     { NT_TypeAnn, { A_TYPE_NONE }, 1 },
-    /* TypeRef -> (IDENT|function type) TypeSuffix */
-    { NT_TypeRef, { T(TOKEN_IDENT), NT_TypeSuffix }, 2 },
+    /* TypeRef -> (IDENT TypeArgs|function type) TypeSuffix */
+    { NT_TypeRef, { T(TOKEN_IDENT), NT_TypeArgs, NT_TypeSuffix }, 3 },
     { NT_TypeRef, { T(TOKEN_LPAREN), A_SENT, NT_TypeList, T(TOKEN_RPAREN),
                     T(TOKEN_ARROW), NT_TypeRef, A_TYPE_FUNC, NT_TypeSuffix }, 8 },
     { NT_TypeSuffix, { T(TOKEN_LBRACKET), T(TOKEN_RBRACKET), A_TYPE_ARRAY, NT_TypeSuffix }, 4 },
@@ -251,6 +193,23 @@ static const Prod HULK_PRODS[] = {
     { NT_TypeList, { 0 }, 0 },
     { NT_TypeListT, { T(TOKEN_COMMA), NT_TypeRef, NT_TypeListT }, 3 },
     { NT_TypeListT, { 0 }, 0 },
+    /* TypeArgs -> LT @sent TypeRef TypeListT GT @type_args | ε
+       (`Box<Number>`: el lexema del nombre pasa a ser la instancia) */
+    { NT_TypeArgs, { T(TOKEN_LT), A_SENT, NT_TypeRef, NT_TypeListT, T(TOKEN_GT),
+                     A_TYPE_ARGS }, 6 },
+    { NT_TypeArgs, { 0 }, 0 },
+    /* CallTypeArgs -> LT @sent TypeRef TypeListT GT @call_type_args
+       (`max<Number>(…)`: solo por lookahead local, ver NT_Call) */
+    { NT_CallTypeArgs, { T(TOKEN_LT), A_SENT, NT_TypeRef, NT_TypeListT, T(TOKEN_GT),
+                         A_CALL_TYPE_ARGS }, 6 },
+    /* GenParams -> LT @sent IDENT GenParamsT GT @type_args | ε
+       GenParamsT -> COMMA IDENT GenParamsT | ε
+       (`function max<T>`: el nombre de la plantilla es `max<T>`) */
+    { NT_GenParams, { T(TOKEN_LT), A_SENT, T(TOKEN_IDENT), NT_GenParamsT, T(TOKEN_GT),
+                      A_TYPE_ARGS }, 6 },
+    { NT_GenParams, { 0 }, 0 },
+    { NT_GenParamsT, { T(TOKEN_COMMA), T(TOKEN_IDENT), NT_GenParamsT }, 3 },
+    { NT_GenParamsT, { 0 }, 0 },
 
     /* If -> IF LPAREN Expr RPAREN Body ElifL ELSE Body @if */
     { NT_If, { T(TOKEN_IF), T(TOKEN_LPAREN), NT_Expr, T(TOKEN_RPAREN), NT_Body, A_SENT, NT_ElifL, T(TOKEN_ELSE), NT_Body, A_IF }, 10 },
@@ -272,9 +231,9 @@ static const Prod HULK_PRODS[] = {
     { NT_Block, { T(TOKEN_LBRACE), A_BLOCK_BEGIN, NT_StmtList, T(TOKEN_RBRACE), A_BLOCK }, 5 },
 
     /* ---- Capa 2: definiciones ---- */
-    /* FunctionDef -> FUNCTION IDENT LPAREN @sent Params RPAREN TypeAnn FuncBody @funcdef */
-    { NT_FunctionDef, { T(TOKEN_FUNCTION), T(TOKEN_IDENT), T(TOKEN_LPAREN), A_SENT,
-                        NT_Params, T(TOKEN_RPAREN), NT_TypeAnn, NT_FuncBody, A_FUNCDEF }, 9 },
+    /* FunctionDef -> FUNCTION IDENT GenParams LPAREN @sent Params RPAREN TypeAnn FuncBody @funcdef */
+    { NT_FunctionDef, { T(TOKEN_FUNCTION), T(TOKEN_IDENT), NT_GenParams, T(TOKEN_LPAREN), A_SENT,
+                        NT_Params, T(TOKEN_RPAREN), NT_TypeAnn, NT_FuncBody, A_FUNCDEF }, 10 },
     /* Params -> Param ParamsT | ε ; ParamsT -> COMMA Param ParamsT | ε */
     { NT_Params, { NT_Param, NT_ParamsT }, 2 },
     { NT_Params, { 0 }, 0 },
@@ -298,14 +257,15 @@ static const Prod HULK_PRODS[] = {
     { NT_Lambda, { T(TOKEN_LPAREN), A_SENT, NT_Params, T(TOKEN_RPAREN),
                    NT_TypeAnn, NT_FuncExprBody, A_FUNCEXPR }, 7 },
 
-    /* TypeDef -> TYPE IDENT @td_begin TypeParams TypeInherit LBRACE TypeBody RBRACE */
-    { NT_TypeDef, { T(TOKEN_TYPE), T(TOKEN_IDENT), A_TD_BEGIN, NT_TypeParams,
-                    NT_TypeInherit, T(TOKEN_LBRACE), NT_TypeBody, T(TOKEN_RBRACE) }, 8 },
+    /* TypeDef -> TYPE IDENT GenParams @td_begin TypeParams TypeInherit LBRACE TypeBody RBRACE */
+    { NT_TypeDef, { T(TOKEN_TYPE), T(TOKEN_IDENT), NT_GenParams, A_TD_BEGIN, NT_TypeParams,
+                    NT_TypeInherit, T(TOKEN_LBRACE), NT_TypeBody, T(TOKEN_RBRACE) }, 9 },
     /* TypeParams -> LPAREN @sent Params RPAREN @td_params | ε */
     { NT_TypeParams, { T(TOKEN_LPAREN), A_SENT, NT_Params, T(TOKEN_RPAREN), A_TD_PARAMS }, 5 },
     { NT_TypeParams, { 0 }, 0 },
-    /* TypeInherit -> INHERITS IDENT @td_parent TypeBaseArgs | ε */
-    { NT_TypeInherit, { T(TOKEN_INHERITS), T(TOKEN_IDENT), A_TD_PARENT, NT_TypeBaseArgs }, 4 },
+    /* TypeInherit -> INHERITS IDENT TypeArgs @td_parent TypeBaseArgs | ε */
+    { NT_TypeInherit, { T(TOKEN_INHERITS), T(TOKEN_IDENT), NT_TypeArgs, A_TD_PARENT,
+                        NT_TypeBaseArgs }, 5 },
     { NT_TypeInherit, { 0 }, 0 },
     /* TypeBaseArgs -> LPAREN @sent Args RPAREN @td_pargs | ε */
     { NT_TypeBaseArgs, { T(TOKEN_LPAREN), A_SENT, NT_Args, T(TOKEN_RPAREN), A_TD_PARGS }, 5 },
@@ -331,11 +291,11 @@ static const Prod HULK_PRODS[] = {
     { NT_MethodBody, { T(TOKEN_ARROW), NT_Expr, T(TOKEN_SEMICOLON) }, 3 },
     { NT_MethodBody, { NT_Block }, 1 },
 
-    /* ProtocolDef -> PROTOCOL IDENT @proto_begin ProtoExt LBRACE ProtoSigs RBRACE */
-    { NT_ProtocolDef, { T(TOKEN_PROTOCOL), T(TOKEN_IDENT), A_PROTO_BEGIN, NT_ProtoExt,
-                        T(TOKEN_LBRACE), NT_ProtoSigs, T(TOKEN_RBRACE) }, 7 },
-    /* ProtoExt -> EXTENDS IDENT @td_parent | ε */
-    { NT_ProtoExt, { T(TOKEN_EXTENDS), T(TOKEN_IDENT), A_TD_PARENT }, 3 },
+    /* ProtocolDef -> PROTOCOL IDENT GenParams @proto_begin ProtoExt LBRACE ProtoSigs RBRACE */
+    { NT_ProtocolDef, { T(TOKEN_PROTOCOL), T(TOKEN_IDENT), NT_GenParams, A_PROTO_BEGIN,
+                        NT_ProtoExt, T(TOKEN_LBRACE), NT_ProtoSigs, T(TOKEN_RBRACE) }, 8 },
+    /* ProtoExt -> EXTENDS IDENT TypeArgs @td_parent | ε */
+    { NT_ProtoExt, { T(TOKEN_EXTENDS), T(TOKEN_IDENT), NT_TypeArgs, A_TD_PARENT }, 4 },
     { NT_ProtoExt, { 0 }, 0 },
     /* ProtoSigs -> ProtoSig ProtoSigs | ε */
     { NT_ProtoSigs, { NT_ProtoSig, NT_ProtoSigs }, 2 },
@@ -377,42 +337,62 @@ static const char *NT_NAMES[NT_COUNT] = {
     "ProtoSig","DecorBlock","DecorMore","DecorTarget","DecorItems","DecorItemsT",
     "DecorItem","DecorArgs","DecorPrefix","TypeRef","TypeSuffix","TypeList","TypeListT",
     "NewTail","ArrayTypeSuffix","ArrayInit",
-    "Lambda"
+    "Lambda","TypeArgs","CallTypeArgs","GenParams","GenParamsT"
 };
 
 /* ============================================================
  *  Pila semántica tipada
  * ============================================================ */
 typedef enum { V_NODE, V_LEX, V_SENT } VKind;
-typedef struct { VKind k; HulkNode *node; char *lex; } SemVal;
+typedef struct { VKind k; HulkNode *node; const char *lex; } SemVal;
 
-typedef struct {
+/* `s` apunta al buffer activo: el inline del llamador o, si la entrada
+ * anida más, `heap` (crece al doble; ver stack_util.h). Sin tope fijo. */
+typedef struct SemStack {
     HulkASTContext *ctx;
     SemVal *s;
+    SemVal *heap;  /* NULL mientras todo quepa en el buffer inline */
     int sp, cap;
     int had_error;
+    long ops;      /* push/pop realizados (estadística) */
 } SemStack;
 
+static int sv_reserve(SemStack *S) {
+    if (S->sp < S->cap) return 1;
+    if (!stack_util_grow((void**)&S->heap, S->s, &S->cap, S->sp, sizeof(SemVal))) {
+        LOG_FATAL_MSG("ast_builder", "sin memoria para la pila semántica (%d valores)", S->sp);
+        S->had_error = 1;
+        return 0;
+    }
+    S->s = S->heap;
+    return 1;
+}
+
 static void sv_push_node(SemStack *S, HulkNode *n) {
-    if (S->sp >= S->cap) return;
+    if (!sv_reserve(S)) return;
+    S->ops++;
     S->s[S->sp].k = V_NODE; S->s[S->sp].node = n; S->s[S->sp].lex = NULL; S->sp++;
 }
-static void sv_push_lex(SemStack *S, char *lex) {
-    if (S->sp >= S->cap) return;
+static void sv_push_lex(SemStack *S, const char *lex) {
+    if (!sv_reserve(S)) return;
+    S->ops++;
     S->s[S->sp].k = V_LEX; S->s[S->sp].node = NULL; S->s[S->sp].lex = lex; S->sp++;
 }
 static void sv_push_sent(SemStack *S) {
-    if (S->sp >= S->cap) return;
+    if (!sv_reserve(S)) return;
+    S->ops++;
     S->s[S->sp].k = V_SENT; S->s[S->sp].node = NULL; S->s[S->sp].lex = NULL; S->sp++;
 }
 static HulkNode* sv_pop_node(SemStack *S) {
     if (S->sp <= 0) { S->had_error = 1; return NULL; }
+    S->ops++;
     SemVal v = S->s[--S->sp];
     if (v.k != V_NODE) { S->had_error = 1; return NULL; }
     return v.node;
 }
-static char* sv_pop_lex(SemStack *S) {
+static const char* sv_pop_lex(SemStack *S) {
     if (S->sp <= 0) { S->had_error = 1; return NULL; }
+    S->ops++;
     SemVal v = S->s[--S->sp];
     if (v.k != V_LEX) { S->had_error = 1; return NULL; }
     return v.lex;
@@ -435,6 +415,10 @@ static void sv_collect_to_sentinel(SemStack *S, HulkNodeList *out) {
     int start = S->sp;
     while (start > 0 && S->s[start-1].k != V_SENT) start--;
     int first = start; /* índice del primer elemento tras el centinela */
+    int n = 0;
+    for (int i = first; i < S->sp; i++)
+        if (S->s[i].k == V_NODE) n++;
+    hulk_node_list_reserve(out, out->count + n);
     for (int i = first; i < S->sp; i++)
         if (S->s[i].k == V_NODE)
             hulk_node_list_push(out, S->s[i].node);
@@ -442,6 +426,16 @@ static void sv_collect_to_sentinel(SemStack *S, HulkNodeList *out) {
     S->sp = (first > 0) ? first - 1 : 0;
 }
 
+/* Lexema de un terminal con valor para la pila semántica: los nombres
+ * (IDENT, `base`) se internan acá mismo; los literales se copian a la
+ * arena. */
+static const char* shift_lexeme(HulkASTContext *ctx, const Token *t) {
+    const char *lex = t->lexeme ? t->lexeme : "";
+    if (t->type == TOKEN_IDENT || t->type == TOKEN_BASE)
+        return hulk_intern(lex);
+    return hulk_ast_strdup(ctx, lex);
+}
+
 static char* ll1_join3(HulkASTContext *ctx, const char *a,
                        const char *mid, const char *c) {
     const char *sa = a ? a : "";
@@ -482,11 +476,11 @@ static char* sv_collect_lex_to_sentinel(SemStack *S) {
 static void exec_hulk_action(int act, SemStack *S, int line, int col) {
     HulkASTContext *c = S->ctx;
     switch (act) {
-        case A_NUM: { char *l = sv_pop_lex(S);
+        case A_NUM: { const char *l = sv_pop_lex(S);
             sv_push_node(S, (HulkNode*)hulk_ast_number_lit(c, l ? l : "0", line, col)); break; }
-        case A_STR: { char *l = sv_pop_lex(S);
+        case A_STR: { const char *l = sv_pop_lex(S);
             /* el lexema viene con comillas; strip */
-            char *content = l ? l : "";
+            const char *content = l ? l : "";
             int len = (int)strlen(content);
             char *body = hulk_ast_alloc(c, len > 1 ? len - 1 : 1);
             if (len >= 2) { memcpy(body, content+1, len-2); body[len-2]='\0'; }
@@ -494,7 +488,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             sv_push_node(S, (HulkNode*)hulk_ast_string_lit(c, body, line, col)); break; }
         case A_TRUE:  sv_push_node(S, (HulkNode*)hulk_ast_bool_lit(c, 1, line, col)); break;
         case A_FALSE: sv_push_node(S, (HulkNode*)hulk_ast_bool_lit(c, 0, line, col)); break;
-        case A_IDENT: { char *l = sv_pop_lex(S);
+        case A_IDENT: { const char *l = sv_pop_lex(S);
             sv_push_node(S, (HulkNode*)hulk_ast_ident(c, l ? l : "?", line, col)); break; }
         case A_SELF:  sv_push_node(S, (HulkNode*)hulk_ast_self(c, line, col)); break;
 
@@ -522,9 +516,9 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
         case A_NOT: { HulkNode *o = sv_pop_node(S);
             UnaryOpNode *u = hulk_ast_unary_op(c, o, line, col); u->is_not = 1;
             sv_push_node(S, (HulkNode*)u); break; }
-        case A_AS: { char *tn = sv_pop_lex(S); HulkNode *e = sv_pop_node(S);
+        case A_AS: { const char *tn = sv_pop_lex(S); HulkNode *e = sv_pop_node(S);
             sv_push_node(S, (HulkNode*)hulk_ast_as_expr(c, e, tn ? tn : "Object", line, col)); break; }
-        case A_IS: { char *tn = sv_pop_lex(S); HulkNode *e = sv_pop_node(S);
+        case A_IS: { const char *tn = sv_pop_lex(S); HulkNode *e = sv_pop_node(S);
             sv_push_node(S, (HulkNode*)hulk_ast_is_expr(c, e, tn ? tn : "Object", line, col)); break; }
 
         case A_SENT: sv_push_sent(S); break;
@@ -536,7 +530,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             sv_push_node(S, (HulkNode*)call); break; }
         case A_INDEX: { HulkNode *idx = sv_pop_node(S), *obj = sv_pop_node(S);
             sv_push_node(S, (HulkNode*)hulk_ast_index_expr(c, obj, idx, line, col)); break; }
-        case A_MEMBER: { char *m = sv_pop_lex(S); HulkNode *obj = sv_pop_node(S);
+        case A_MEMBER: { const char *m = sv_pop_lex(S); HulkNode *obj = sv_pop_node(S);
             sv_push_node(S, (HulkNode*)hulk_ast_member_access(c, obj, m ? m : "?", line, col)); break; }
         case A_ASSIGN: { HulkNode *val = sv_pop_node(S), *tgt = sv_pop_node(S);
             sv_push_node(S, (HulkNode*)hulk_ast_assign(c, tgt, val, line, col)); break; }
@@ -545,8 +539,8 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
         case A_NEW: { /* args sobre centinela; debajo el lexema del typename */
             NewExprNode *ne = hulk_ast_new_expr(c, "?", line, col);
             sv_collect_to_sentinel(S, &ne->args);
-            char *tn = sv_pop_lex(S);
-            ne->type_name = tn ? hulk_ast_strdup(c, tn) : ne->type_name;
+            const char *tn = sv_pop_lex(S);
+            ne->type_name = tn ? hulk_intern(tn) : ne->type_name;
             sv_push_node(S, (HulkNode*)ne); break; }
         case A_BASE: { BaseCallNode *bc = hulk_ast_base_call(c, line, col);
             sv_collect_to_sentinel(S, &bc->args);
@@ -557,7 +551,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             sv_push_node(S, (HulkNode*)v); break; }
         case A_ARRAY_NEW: {
             HulkNode *size = sv_pop_node(S);
-            char *tn = sv_pop_lex(S);
+            const char *tn = sv_pop_lex(S);
             (void)tn;
             CallExprNode *call = hulk_ast_call_expr(
                 c, (HulkNode*)hulk_ast_ident(c, "__array_new", line, col),
@@ -567,7 +561,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             break; }
         case A_ARRAY_INIT: {
             HulkNode *body = sv_pop_node(S);
-            char *idx_name = sv_pop_lex(S);
+            const char *idx_name = sv_pop_lex(S);
             HulkNode *node = sv_pop_node(S);
             if (!node || node->type != NODE_CALL_EXPR) {
                 S->had_error = 1;
@@ -575,7 +569,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             }
             CallExprNode *call = (CallExprNode*)node;
             if (call->callee && call->callee->type == NODE_IDENT)
-                ((IdentNode*)call->callee)->name = hulk_ast_strdup(c, "__array_init");
+                ((IdentNode*)call->callee)->name = hulk_intern("__array_init");
             FunctionExprNode *fn = hulk_ast_function_expr(c, "Number", line, col);
             VarBindingNode *p = hulk_ast_var_binding(c, idx_name ? idx_name : "i",
                                                      "Number", line, col);
@@ -588,23 +582,43 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
         case A_TYPE_NAME: break;  /* el lexema del tipo queda en la pila como V_LEX */
         case A_TYPE_NONE: sv_push_lex(S, NULL); break;  /* slot de tipo vacío */
         case A_TYPE_FUNC: {
-            char *ret = sv_pop_lex(S);
+            const char *ret = sv_pop_lex(S);
             char *params = sv_collect_lex_to_sentinel(S);
             char *head = ll1_join3(c, "(", params, ")->");
             sv_push_lex(S, ll1_join3(c, head, "", ret));
             break; }
         case A_TYPE_ARRAY: {
-            char *base = sv_pop_lex(S);
+            const char *base = sv_pop_lex(S);
             sv_push_lex(S, ll1_join3(c, base, "", "[]"));
             break; }
         case A_TYPE_ITER: {
-            char *base = sv_pop_lex(S);
+            const char *base = sv_pop_lex(S);
             sv_push_lex(S, ll1_join3(c, base, "", "*"));
             break; }
+        case A_TYPE_ARGS: { /* nombre SENT arg* → "nombre<a,b>" */
+            char *args = sv_collect_lex_to_sentinel(S);
+            const char *base = sv_pop_lex(S);
+            char *head = ll1_join3(c, base, "<", args);
+            sv_push_lex(S, hulk_intern(ll1_join3(c, head, "", ">")));
+            break; }
+        case A_CALL_TYPE_ARGS: { /* callee SENT arg* */
+            char *args = sv_collect_lex_to_sentinel(S);
+            HulkNode *callee = sv_pop_node(S);
+            if (!callee || callee->type != NODE_IDENT) {
+                LOG_ERROR_MSG("ast_builder", "[%d:%d] argumentos de tipo fuera de "
+                              "una llamada a función por nombre", line, col);
+                S->had_error = 1;
+                break;
+            }
+            IdentNode *id = (IdentNode*)callee;
+            char *head = ll1_join3(c, id->name, "<", args);
+            id->name = hulk_intern(ll1_join3(c, head, "", ">"));
+            sv_push_node(S, callee);
+            break; }
         case A_BIND: { /* … IDENT TypeAnn ASSIGN Expr : pila = [name, type, init] */
             HulkNode *init = sv_pop_node(S);
-            char *type = sv_pop_lex(S);
-            char *name = sv_pop_lex(S);
+            const char *type = sv_pop_lex(S);
+            const char *name = sv_pop_lex(S);
             VarBindingNode *vb = hulk_ast_var_binding(c, name ? name : "?", type, line, col);
             vb->init_expr = init;
             sv_push_node(S, (HulkNode*)vb); break; }
@@ -624,7 +638,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             HulkNode *else_b = sv_pop_node(S);
             IfExprNode *iff = hulk_ast_if_expr(c, line, col);
             /* recolectar elifs hasta el centinela */
-            HulkNodeList elifs; hulk_node_list_init(&elifs);
+            HulkNodeList elifs; hulk_node_list_init_in(&elifs, c);
             sv_collect_to_sentinel(S, &elifs);
             HulkNode *then_b = sv_pop_node(S);
             HulkNode *cond = sv_pop_node(S);
@@ -636,7 +650,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             w->condition = cond; w->body = body;
             sv_push_node(S, (HulkNode*)w); break; }
         case A_FOR: { HulkNode *body = sv_pop_node(S), *iter = sv_pop_node(S);
-            char *var = sv_pop_lex(S);
+            const char *var = sv_pop_lex(S);
             ForStmtNode *f = hulk_ast_for_stmt(c, var ? var : "?", line, col);
             f->iterable = iter; f->body = body;
             sv_push_node(S, (HulkNode*)f); break; }
@@ -646,49 +660,49 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             sv_push_node(S, (HulkNode*)b); break; }
 
         /* ---- Capa 2: definiciones ---- */
-        case A_PARAM: { char *type = sv_pop_lex(S); char *name = sv_pop_lex(S);
+        case A_PARAM: { const char *type = sv_pop_lex(S); const char *name = sv_pop_lex(S);
             sv_push_node(S, (HulkNode*)hulk_ast_var_binding(c, name?name:"?", type, line, col));
             break; }
-        case A_FUNCDEF: { HulkNode *body = sv_pop_node(S); char *ret = sv_pop_lex(S);
-            HulkNodeList params; hulk_node_list_init(&params);
+        case A_FUNCDEF: { HulkNode *body = sv_pop_node(S); const char *ret = sv_pop_lex(S);
+            HulkNodeList params; hulk_node_list_init_in(&params, c);
             sv_collect_to_sentinel(S, &params);
-            char *name = sv_pop_lex(S);
+            const char *name = sv_pop_lex(S);
             FunctionDefNode *fn = hulk_ast_function_def(c, name?name:"?", ret, line, col);
             fn->params = params; fn->body = body;
             sv_push_node(S, (HulkNode*)fn); break; }
-        case A_FUNCEXPR: { HulkNode *body = sv_pop_node(S); char *ret = sv_pop_lex(S);
-            HulkNodeList params; hulk_node_list_init(&params);
+        case A_FUNCEXPR: { HulkNode *body = sv_pop_node(S); const char *ret = sv_pop_lex(S);
+            HulkNodeList params; hulk_node_list_init_in(&params, c);
             sv_collect_to_sentinel(S, &params);
             FunctionExprNode *fn = hulk_ast_function_expr(c, ret, line, col);
             fn->params = params; fn->body = body;
             sv_push_node(S, (HulkNode*)fn); break; }
 
-        case A_TD_BEGIN: { char *name = sv_pop_lex(S);
+        case A_TD_BEGIN: { const char *name = sv_pop_lex(S);
             sv_push_node(S, (HulkNode*)hulk_ast_type_def(c, name?name:"?", NULL, line, col));
             break; }
-        case A_PROTO_BEGIN: { char *name = sv_pop_lex(S);
+        case A_PROTO_BEGIN: { const char *name = sv_pop_lex(S);
             TypeDefNode *td = hulk_ast_type_def(c, name?name:"?", NULL, line, col);
             td->is_protocol = 1;
             sv_push_node(S, (HulkNode*)td); break; }
-        case A_TD_PARAMS: { HulkNodeList params; hulk_node_list_init(&params);
+        case A_TD_PARAMS: { HulkNodeList params; hulk_node_list_init_in(&params, c);
             sv_collect_to_sentinel(S, &params);
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
             if (td) td->params = params;
             break; }
-        case A_TD_PARENT: { char *p = sv_pop_lex(S);
+        case A_TD_PARENT: { const char *p = sv_pop_lex(S);
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
-            if (td && p) td->parent = hulk_ast_strdup(c, p);
+            if (td && p) td->parent = hulk_intern(p);
             break; }
-        case A_TD_PARGS: { HulkNodeList args; hulk_node_list_init(&args);
+        case A_TD_PARGS: { HulkNodeList args; hulk_node_list_init_in(&args, c);
             sv_collect_to_sentinel(S, &args);
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
             if (td) td->parent_args = args;
             break; }
-        case A_METHOD: { HulkNode *body = sv_pop_node(S); char *ret = sv_pop_lex(S);
-            HulkNodeList params; hulk_node_list_init(&params);
+        case A_METHOD: { HulkNode *body = sv_pop_node(S); const char *ret = sv_pop_lex(S);
+            HulkNodeList params; hulk_node_list_init_in(&params, c);
             sv_collect_to_sentinel(S, &params);
-            char *name = sv_pop_lex(S);
-            HulkNodeList decorators; hulk_node_list_init(&decorators);
+            const char *name = sv_pop_lex(S);
+            HulkNodeList decorators; hulk_node_list_init_in(&decorators, c);
             sv_collect_to_sentinel(S, &decorators);
             MethodDefNode *m = hulk_ast_method_def(c, name?name:"?", ret, line, col);
             m->params = params; m->body = body;
@@ -696,8 +710,8 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
             if (td) hulk_node_list_push(&td->members, (HulkNode*)m);
             break; }
-        case A_ATTR: { HulkNode *init = sv_pop_node(S); char *type = sv_pop_lex(S);
-            char *name = sv_pop_lex(S);
+        case A_ATTR: { HulkNode *init = sv_pop_node(S); const char *type = sv_pop_lex(S);
+            const char *name = sv_pop_lex(S);
             HulkNodeList decorators; hulk_node_list_init(&decorators);
             sv_collect_to_sentinel(S, &decorators);
             hulk_node_list_free(&decorators);
@@ -706,7 +720,7 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
             if (td) hulk_node_list_push(&td->members, (HulkNode*)a);
             break; }
-        case A_ATTR_NOINIT: { char *type = sv_pop_lex(S); char *name = sv_pop_lex(S);
+        case A_ATTR_NOINIT: { const char *type = sv_pop_lex(S); const char *name = sv_pop_lex(S);
             HulkNodeList decorators; hulk_node_list_init(&decorators);
             sv_collect_to_sentinel(S, &decorators);
             hulk_node_list_free(&decorators);
@@ -714,10 +728,10 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
             TypeDefNode *td = (TypeDefNode*)sv_peek_node(S);
             if (td) hulk_node_list_push(&td->members, (HulkNode*)a);
             break; }
-        case A_PROTO_METHOD: { char *ret = sv_pop_lex(S);
-            HulkNodeList params; hulk_node_list_init(&params);
+        case A_PROTO_METHOD: { const char *ret = sv_pop_lex(S);
+            HulkNodeList params; hulk_node_list_init_in(&params, c);
             sv_collect_to_sentinel(S, &params);
-            char *name = sv_pop_lex(S);
+            const char *name = sv_pop_lex(S);
             MethodDefNode *m = hulk_ast_method_def(c, name?name:"?", ret, line, col);
             m->params = params;
             m->body = (HulkNode*)hulk_ast_number_lit(c, "0", line, col); /* dummy */
@@ -727,8 +741,8 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
         case A_DECOR_ITEM: {
             DecorItemNode *di = hulk_ast_decor_item(c, "?", line, col);
             sv_collect_to_sentinel(S, &di->args);
-            char *name = sv_pop_lex(S);
-            di->name = name ? hulk_ast_strdup(c, name) : di->name;
+            const char *name = sv_pop_lex(S);
+            di->name = name ? hulk_intern(name) : di->name;
             sv_push_node(S, (HulkNode*)di);
             break; }
         case A_DECOR_BLOCK: {
@@ -745,16 +759,73 @@ static void exec_hulk_action(int act, SemStack *S, int line, int col) {
 /* ============================================================
  *  Construcción de la gramática pura (para FIRST/FOLLOW/tabla)
  * ============================================================ */
+/* Entrada de la tabla de binding powers (indexada por TokenType). */
+typedef struct {
+    int lbp;          /* 0 = el token no es operador de expresión */
+    int action;       /* A_* que construye el nodo (el mismo de la escalera) */
+    int right_assoc;  /* X' -> op X @act   (sin cola recursiva) */
+    int postfix;      /* X' -> op IDENT @act X'  (p.ej. `is T`) */
+} BindPower;
+
 typedef struct {
     Grammar g;
     First_Table first;
     Follow_Table follow;
     LL1_Table ll1;
     int prod_index[HULK_PROD_COUNT]; /* prod data idx -> grammar prod id (==idx) */
+    /* Sub-parser de precedencia: derivado de la escalera Or…Factor */
+    BindPower bp[256];
+    int pratt_entry;    /* NT que abre la escalera (Or) */
+    int pratt_operand;  /* NT de los operandos (Unary) */
+    int pratt_max_bp;
     int initialized;
 } HulkLL1;
 
 static HulkLL1 G;  /* singleton; construido una vez */
+static HulkLL1Stats last_stats;
+
+/* Deriva la tabla de binding powers de la escalera de precedencia de
+ * HULK_PRODS. Cada nivel tiene la forma
+ *     X  -> Y X'
+ *     X' -> op Y @act X'   (izquierda)  |  op X @act  (derecha)
+ *         | op IDENT @act X'  (postfijo) |  ε
+ * y el nivel siguiente es Y. La escalera termina en el primer NT que no
+ * tiene esa forma (Unary), que pasa a ser el operando del sub-parser.
+ * Así la precedencia sigue declarada una sola vez: en la gramática. */
+static void derive_binding_powers(int entry) {
+    memset(G.bp, 0, sizeof(G.bp));
+    G.pratt_entry = entry;
+    int cur = entry, level = 0;
+    for (;;) {
+        int next = -1, tail = -1;
+        for (int p = 0; p < HULK_PROD_COUNT; p++) {
+            const Prod *pr = &HULK_PRODS[p];
+            if (pr->lhs == cur && pr->n == 2 &&
+                IS_NT(pr->rhs[0]) && IS_NT(pr->rhs[1])) {
+                next = pr->rhs[0]; tail = pr->rhs[1]; break;
+            }
+        }
+        if (next < 0) break;
+        int found_op = 0;
+        level++;
+        for (int p = 0; p < HULK_PROD_COUNT; p++) {
+            const Prod *pr = &HULK_PRODS[p];
+            if (pr->lhs != tail || pr->n < 3 || !IS_T(pr->rhs[0])) continue;
+            int tok = pr->rhs[0] - TBASE;
+            if (tok < 0 || tok >= 256 || !IS_ACT(pr->rhs[2])) continue;
+            BindPower *b = &G.bp[tok];
+            b->lbp = level;
+            b->action = pr->rhs[2];
+            b->postfix = IS_T(pr->rhs[1]);
+            b->right_assoc = (pr->rhs[1] == cur);
+            found_op = 1;
+        }
+        if (!found_op) { level--; break; }
+        cur = next;
+    }
+    G.pratt_operand = cur;
+    G.pratt_max_bp = level;
+}
 
 static void build_grammar(void) {
     grammar_init(&G.g, "hulk");
@@ -794,70 +865,199 @@ static void build_grammar(void) {
     compute_follow_sets(&G.g, &G.first, &G.follow);
     if (!build_ll1_table(&G.g, &G.first, &G.follow, &G.ll1))
         LOG_WARN_MSG("ll1", "gramática HULK con conflictos LL(1) (resueltos por prioridad)");
+    derive_binding_powers(NT_Or);
     G.initialized = 1;
 }
 
+/* ============================================================
+ *  Vista de la gramática para el generador (hulk_rd_gen.c)
+ * ============================================================ */
+static const char *ACTION_NAMES[] = {
+    "NUM", "STR", "TRUE", "FALSE", "IDENT", "SELF",
+    "OR", "AND", "LT", "GT", "LE", "GE", "EQ", "NEQ",
+    "CONCAT", "CONCATWS", "ADD", "SUB", "MUL", "DIV", "MOD", "POW",
+    "NEG", "NOT", "AS", "IS",
+    "SENT", "CALL", "MEMBER", "INDEX", "ASSIGN", "DESTRUCT",
+    "NEW", "BASE",
+    "LET", "BIND", "TYPE_NAME", "TYPE_NONE",
+    "IF", "ELIF", "WHILE", "FOR", "BLOCK_BEGIN", "BLOCK",
+    "VEC",
+    "PARAM", "FUNCDEF", "FUNCEXPR",
+    "TD_BEGIN", "TD_PARAMS", "TD_PARENT", "TD_PARGS",
+    "METHOD", "ATTR", "ATTR_NOINIT",
+    "PROTO_BEGIN", "PROTO_METHOD",
+    "DECOR_ITEM", "DECOR_BLOCK", "TYPE_FUNC",
+    "TYPE_ARRAY", "TYPE_ITER", "ARRAY_NEW", "ARRAY_INIT",
+    "TYPE_ARGS", "CALL_TYPE_ARGS",
+};
+
+int hulk_ll1_prod_count(void) { return HULK_PROD_COUNT; }
+
+const int* hulk_ll1_prod_rhs(int prod, int *lhs, int *n) {
+    if (prod < 0 || prod >= HULK_PROD_COUNT) return NULL;
+    if (lhs) *lhs = HULK_PRODS[prod].lhs;
+    if (n)   *n = HULK_PRODS[prod].n;
+    return HULK_PRODS[prod].rhs;
+}
+
+int hulk_ll1_predict(int nt, int token) {
+    if (!G.initialized) build_grammar();
+    if (nt < 0 || nt >= NT_COUNT) return -1;
+    int la = (token == TOKEN_EOF) ? END_MARKER : token;
+    int colm = ll1_table_get_column(&G.ll1, &G.g, la);
+    int prod = (colm >= 0) ? G.ll1.table[nt][colm] : -1;
+    return prod >= 0 ? prod : -1;
+}
+
+const char* hulk_ll1_nt_name(int nt) {
+    return (nt >= 0 && nt < NT_COUNT) ? NT_NAMES[nt] : "?";
+}
+
+const char* hulk_ll1_action_name(int act) {
+    int i = act - A_NUM;
+    if (i >= 0 && i < (int)(sizeof(ACTION_NAMES) / sizeof(ACTION_NAMES[0])))
+        return ACTION_NAMES[i];
+    return "?";
+}
+
+int hulk_ll1_pratt_entry(void) {
+    if (!G.initialized) build_grammar();
+    return G.pratt_entry;
+}
+
+int hulk_ll1_pratt_operand(void) {
+    if (!G.initialized) build_grammar();
+    return G.pratt_operand;
+}
+
+/* ============================================================
+ *  Pila del autómata
+ * ============================================================
+ * Igual que la semántica: arranca en un buffer inline del llamador y
+ * migra a heap (creciendo al doble) si la entrada anida más. La
+ * profundidad de anidamiento del programa deja de estar acotada. */
+typedef struct {
+    GrammarSymbol *s;     /* buffer activo (inline o heap) */
+    GrammarSymbol *heap;  /* NULL mientras todo quepa en el inline */
+    int top, cap;
+    int oom;
+} PStack;
+
+static inline void ps_push(PStack *P, GrammarSymbol g) {
+    if (P->top >= P->cap) {
+        if (!stack_util_grow((void**)&P->heap, P->s, &P->cap, P->top,
+                             sizeof(GrammarSymbol))) {
+            P->oom = 1;
+            return;
+        }
+        P->s = P->heap;
+    }
+    P->s[P->top++] = g;
+}
+
+#define PS_NT(P, x)  ps_push((P), (GrammarSymbol){SYMBOL_NON_TERMINAL, (x)})
+#define PS_T(P, x)   ps_push((P), (GrammarSymbol){SYMBOL_TERMINAL, (x)})
+#define PS_ACT(P, x) ps_push((P), (GrammarSymbol){SYMBOL_ACTION, (x)})
+
 /* push del RHS COMPLETO (con acciones) en orden inverso a la pila */
-static void push_production_actions(int prod_data_idx, GrammarSymbol *stk, int *top) {
+static void push_production_actions(int prod_data_idx, PStack *P) {
     const Prod *pr = &HULK_PRODS[prod_data_idx];
     for (int k = pr->n - 1; k >= 0; k--) {
         int x = pr->rhs[k];
-        if (IS_ACT(x))      stk[(*top)++] = (GrammarSymbol){SYMBOL_ACTION, x};
-        else if (IS_T(x))   stk[(*top)++] = (GrammarSymbol){SYMBOL_TERMINAL, x - TBASE};
-        else                stk[(*top)++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, x};
+        if (IS_ACT(x))      PS_ACT(P, x);
+        else if (IS_T(x))   PS_T(P, x - TBASE);
+        else                PS_NT(P, x);
+    }
+}
+
+/* ============================================================
+ *  Sub-parser de precedencia (Pratt) sobre la misma pila
+ * ============================================================
+ * En vez de expandir Or→And→Cmp→…→Factor (y sus colas ε) por cada
+ * operando, el NT de entrada se reemplaza por [Operand, LOOP(0)]. LOOP
+ * mira el token actual: si es un operador aceptable empuja
+ *     op Operand LOOP(rbp) @act LOOP(min_bp)
+ * y el autómata consume el operador, parsea el operando derecho (que
+ * absorbe los operadores más fuertes) y ejecuta la MISMA acción A_* que
+ * la escalera, con la misma posición — el AST resultante es idéntico. */
+static inline GrammarSymbol pratt_loop_sym(int min_bp, int cap) {
+    return (GrammarSymbol){SYMBOL_ACTION,
+                           A_PRATT_BASE + min_bp * PRATT_BP_SPAN + cap};
+}
+
+static void pratt_continue(int id, int cur_type, PStack *P) {
+    int min_bp = (id - A_PRATT_BASE) / PRATT_BP_SPAN;
+    int cap    = (id - A_PRATT_BASE) % PRATT_BP_SPAN;
+    if (cur_type < 0 || cur_type >= 256) return;
+    const BindPower *b = &G.bp[cur_type];
+    if (b->lbp == 0 || b->lbp <= min_bp || b->lbp > cap) return;
+
+    if (b->postfix) {
+        /* op IDENT @act LOOP(min_bp, nivel) */
+        ps_push(P, pratt_loop_sym(min_bp, b->lbp));
+        PS_ACT(P, b->action);
+        PS_T(P, TOKEN_IDENT);
+        PS_T(P, cur_type);
+        return;
     }
+    int rbp = b->right_assoc ? b->lbp - 1 : b->lbp;
+    ps_push(P, pratt_loop_sym(min_bp, G.pratt_max_bp));
+    PS_ACT(P, b->action);
+    ps_push(P, pratt_loop_sym(rbp, G.pratt_max_bp));
+    PS_NT(P, G.pratt_operand);
+    PS_T(P, cur_type);
 }
 
 /* ============================================================
  *  Lookahead local (resuelve los puntos no-LL(1) de HULK)
  * ============================================================ */
 
-/* Tipo del token que sigue a `cur` sin alterar el lexer real. */
-static int peek_next_type(LexerContext lx_copy) {
-    Token t = lexer_next_token(&lx_copy);
-    int ty = t.type;
-    if (t.lexeme) free(t.lexeme);
-    return ty;
+/* Tipo del token que sigue al cursor sin consumirlo del flujo real. */
+static int peek_next_type(TokenCursor la) {
+    return token_cursor_next(&la);
 }
 
-static int next_type_inplace(LexerContext *lx_copy) {
-    Token t = lexer_next_token(lx_copy);
-    int ty = t.type;
-    if (t.lexeme) free(t.lexeme);
-    return ty;
+static int next_type_inplace(TokenCursor *la) {
+    return token_cursor_next(la);
 }
 
-static int lookahead_skip_type_ref(LexerContext *lx_copy) {
-    int ty = next_type_inplace(lx_copy);
+static int lookahead_skip_type_args(TokenCursor *la);
+
+static int lookahead_skip_type_ref(TokenCursor *la) {
+    int ty = next_type_inplace(la);
     if (ty == TOKEN_IDENT || ty == TOKEN_BASE) {
-        /* nombre simple */
+        /* nombre simple, o instancia de un genérico */
+        if (peek_next_type(*la) == TOKEN_LT) {
+            (void)next_type_inplace(la);
+            if (!lookahead_skip_type_args(la)) return 0;
+        }
     } else if (ty == TOKEN_LPAREN) {
-        ty = peek_next_type(*lx_copy);
+        ty = peek_next_type(*la);
         if (ty != TOKEN_RPAREN) {
             for (;;) {
-                if (!lookahead_skip_type_ref(lx_copy)) return 0;
-                ty = peek_next_type(*lx_copy);
+                if (!lookahead_skip_type_ref(la)) return 0;
+                ty = peek_next_type(*la);
                 if (ty != TOKEN_COMMA) break;
-                (void)next_type_inplace(lx_copy);
+                (void)next_type_inplace(la);
             }
         }
 
-        if (next_type_inplace(lx_copy) != TOKEN_RPAREN) return 0;
-        if (next_type_inplace(lx_copy) != TOKEN_ARROW) return 0;
-        if (!lookahead_skip_type_ref(lx_copy)) return 0;
+        if (next_type_inplace(la) != TOKEN_RPAREN) return 0;
+        if (next_type_inplace(la) != TOKEN_ARROW) return 0;
+        if (!lookahead_skip_type_ref(la)) return 0;
     } else {
         return 0;
     }
 
     for (;;) {
-        ty = peek_next_type(*lx_copy);
+        ty = peek_next_type(*la);
         if (ty == TOKEN_MULT) {
-            (void)next_type_inplace(lx_copy);
+            (void)next_type_inplace(la);
             continue;
         }
         if (ty == TOKEN_LBRACKET) {
-            (void)next_type_inplace(lx_copy);
-            if (next_type_inplace(lx_copy) != TOKEN_RBRACKET) return 0;
+            (void)next_type_inplace(la);
+            if (next_type_inplace(la) != TOKEN_RBRACKET) return 0;
             continue;
         }
         break;
@@ -866,60 +1066,362 @@ static int lookahead_skip_type_ref(LexerContext *lx_copy) {
     return 1;
 }
 
-/* Con `cur`==LPAREN y `lx` posicionado justo tras ese LPAREN, decide si
+/* Tras un LT: `TypeRef (, TypeRef)* >`. */
+static int lookahead_skip_type_args(TokenCursor *la) {
+    for (;;) {
+        if (!lookahead_skip_type_ref(la)) return 0;
+        int ty = next_type_inplace(la);
+        if (ty == TOKEN_GT) return 1;
+        if (ty != TOKEN_COMMA) return 0;
+    }
+}
+
+/* Memo de lookahead_is_lambda, indexado por el offset en la entrada tras
+ * el LPAREN (0 = desconocido, 1 = no es lambda, 2 = lambda). La decisión
+ * se consulta en cada NT con `(` al tope; sin memo, `((((…))))` con n
+ * niveles re-escanearía O(n) tokens por nivel — O(n²) en total. Un
+ * escaneo desde un `(` externo resuelve de paso los internos que cierra
+ * sin ARROW/COLON detrás, así que cada `(` se escanea a lo sumo una vez
+ * salvo en lambdas anidadas. */
+typedef struct LambdaMemo {
+    unsigned char *state;  /* lazy: calloc(strlen(input)+1) al primer uso */
+    size_t len;
+    int *open;             /* posiciones de los `(` internos abiertos */
+    int *open_heap;
+    int open_cap;
+    int open_top;
+} LambdaMemo;
+
+static void lambda_memo_free(LambdaMemo *m) {
+    free(m->state);
+    free(m->open_heap);
+}
+
+/* Con `cur`==LPAREN y `la` posicionado justo tras ese LPAREN, decide si
  * lo que sigue es una lambda `(params) ->` escaneando hasta el RPAREN
- * que balancea y mirando si viene ARROW. No altera el lexer real. */
-static int lookahead_is_lambda(LexerContext lx_copy) {
-    int depth = 1;
+ * que balancea y mirando si viene ARROW. No consume del flujo real. */
+static int lookahead_is_lambda(LambdaMemo *m, TokenCursor la) {
+    if (!m->state) {
+        m->len = strlen(la.lx.input) + 1;
+        m->state = calloc(m->len, 1);
+    }
+    size_t key = (size_t)token_cursor_pos(&la);
+    int cache = m->state && key < m->len;
+    if (cache && m->state[key]) return m->state[key] == 2;
+
+    int open_inline[64];
+    m->open = m->open_heap ? m->open_heap : open_inline;
+    if (!m->open_heap) m->open_cap = 64;
+    m->open_top = 0;
+    int track = m->state != NULL;  /* registrar los `(` internos */
+
+    int depth = 1, result = 0;
     for (;;) {
-        Token t = lexer_next_token(&lx_copy);
-        int ty = t.type;
-        if (t.lexeme) free(t.lexeme);
-        if (ty == TOKEN_EOF) return 0;
-        if (ty == TOKEN_LPAREN) depth++;
-        else if (ty == TOKEN_RPAREN) {
+        int ty = token_cursor_next(&la);
+        if (ty == TOKEN_EOF) break;
+        if (ty == TOKEN_LPAREN) {
+            depth++;
+            if (track && m->open_top >= m->open_cap) {
+                if (stack_util_grow((void**)&m->open_heap, m->open, &m->open_cap,
+                                    m->open_top, sizeof(int)))
+                    m->open = m->open_heap;
+                else
+                    track = 0;  /* sin memoria: sólo se pierde el atajo */
+            }
+            if (track) m->open[m->open_top++] = token_cursor_pos(&la);
+        } else if (ty == TOKEN_RPAREN) {
             if (--depth == 0) {
-                int next = next_type_inplace(&lx_copy);
-                if (next == TOKEN_ARROW) return 1;
-                if (next != TOKEN_COLON) return 0;
-                return lookahead_skip_type_ref(&lx_copy) &&
-                       next_type_inplace(&lx_copy) == TOKEN_ARROW;
+                int next = next_type_inplace(&la);
+                if (next == TOKEN_ARROW) result = 1;
+                else if (next != TOKEN_COLON) result = 0;
+                else result = lookahead_skip_type_ref(&la) &&
+                              next_type_inplace(&la) == TOKEN_ARROW;
+                break;
+            }
+            /* `(` interno cerrado: si no le sigue ARROW/COLON no es lambda */
+            if (track && m->open_top > 0) {
+                size_t inner = (size_t)m->open[--m->open_top];
+                int next = peek_next_type(la);
+                if (inner < m->len && next != TOKEN_ARROW && next != TOKEN_COLON)
+                    m->state[inner] = 1;
+            }
+        }
+    }
+    m->open = NULL;
+    if (cache) m->state[key] = result ? 2 : 1;
+    return result;
+}
+
+/* ---- Genéricos declarados ----
+ * Basta `function NOMBRE <` o `type NOMBRE <` en cualquier parte del
+ * texto: la declaración puede estar después del uso o en otro tramo del
+ * parseo paralelo. Los tipos entran para que `Box<Number>(1)` siga
+ * llegando al chequeo semántico con su diagnóstico propio. */
+static int gn_ident_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int gn_ident_char(char c) {
+    return gn_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+static const char* gn_skip_ws(const char *p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+static int generic_name_known(const HulkGenericNames *g, const char *name) {
+    for (int i = 0; g && i < g->count; i++)
+        if (g->names[i] == name) return 1;
+    return 0;
+}
+
+static void generic_names_collect(HulkGenericNames *g, const char *input,
+                                  const char *kw) {
+    size_t kwlen = strlen(kw);
+    for (const char *p = strstr(input, kw); p; p = strstr(p + kwlen, kw)) {
+        if (p > input && gn_ident_char(p[-1])) continue;
+        const char *q = gn_skip_ws(p + kwlen);
+        if (q == p + kwlen || !gn_ident_start(*q)) continue;
+        const char *start = q;
+        while (gn_ident_char(*q)) q++;
+        if (*gn_skip_ws(q) != '<') continue;
+        const char *name = hulk_intern_n(start, (size_t)(q - start));
+        if (generic_name_known(g, name)) continue;
+        if (g->count == g->cap) {
+            int cap = g->cap ? g->cap * 2 : 8;
+            const char **names = realloc(g->names, sizeof(*names) * (size_t)cap);
+            if (!names) return;  /* sin memoria: el resto se lee como `<` */
+            g->names = names;
+            g->cap = cap;
+        }
+        g->names[g->count++] = name;
+    }
+}
+
+void hulk_generic_names_scan(HulkGenericNames *g, const char *input) {
+    memset(g, 0, sizeof(*g));
+    generic_names_collect(g, input, "function");
+    generic_names_collect(g, input, "type");
+}
+
+void hulk_generic_names_free(HulkGenericNames *g) {
+    free(g->names);
+    memset(g, 0, sizeof(*g));
+}
+
+/* El callee del Call en curso (tope de la pila semántica) es un
+ * identificador con el nombre de un genérico declarado. */
+static int callee_is_generic(const SemStack *S, const HulkGenericNames *g) {
+    if (!g || S->sp == 0 || S->s[S->sp - 1].k != V_NODE) return 0;
+    const HulkNode *callee = S->s[S->sp - 1].node;
+    return callee && callee->type == NODE_IDENT &&
+           generic_name_known(g, ((const IdentNode*)callee)->name);
+}
+
+/* ---- Lookahead local: puntos no-LL(1) de HULK ----
+ * (a) TopItem con FUNCTION: def `function f(` vs expr `function(`.
+ * (b) Primary con LPAREN: lambda `(x)->` vs paréntesis `(expr)`.
+ * (c) Primary con FUNCTION: siempre lambda (FunctionExpr).
+ * (d) Call con LT: `f<T>(` es una llamada a una instancia de un genérico
+ *     si `f` es un genérico declarado y lo que sigue al `<` son tipos,
+ *     `>` y `(`; si no, es el operador (`both(a < b, c > (d))` son dos
+ *     comparaciones).
+ * Escribe en `out` (en orden de lectura) la secuencia que reemplaza al NT
+ * y retorna su longitud (0 = ε), o LA_TABLE si decide la tabla. Lo usan
+ * los dos motores, así que ambos resuelven igual cada punto. */
+#define LA_TABLE      (-1)
+#define LOCAL_LA_MAX  4
+
+static const int LOCAL_LA_NTS[] = {
+    NT_Expr, NT_Unary, NT_Postfix, NT_Stmt, NT_Body, NT_TermStmt, NT_StmtList,
+    NT_Args, NT_VecItems, NT_TopItem, NT_ArrayTypeSuffix, NT_Call, NT_Primary,
+};
+
+/* NTs que local_lookahead puede emitir: el generador los considera
+ * alcanzables aunque la tabla no los prediga (p.ej. Lambda). */
+static const int LOCAL_LA_TARGETS[] = {
+    NT_Or, NT_Postfix, NT_Primary, NT_Call, NT_Expr, NT_Stmt, NT_TermStmt,
+    NT_StmtList, NT_ArgsT, NT_VecItemsT, NT_FunctionDef, NT_Block, NT_OptSemi,
+    NT_Lambda, NT_CallTypeArgs,
+};
+
+int hulk_ll1_local_lookahead_targets(const int **out) {
+    if (out) *out = LOCAL_LA_TARGETS;
+    return (int)(sizeof(LOCAL_LA_TARGETS) / sizeof(LOCAL_LA_TARGETS[0]));
+}
+
+int hulk_ll1_has_local_lookahead(int nt) {
+    for (size_t i = 0; i < sizeof(LOCAL_LA_NTS) / sizeof(LOCAL_LA_NTS[0]); i++)
+        if (LOCAL_LA_NTS[i] == nt) return 1;
+    return 0;
+}
+
+#define LA_NT(x)  ((GrammarSymbol){SYMBOL_NON_TERMINAL, (x)})
+#define LA_T(x)   ((GrammarSymbol){SYMBOL_TERMINAL, (x)})
+#define LA_ACT(x) ((GrammarSymbol){SYMBOL_ACTION, (x)})
+
+static int local_lookahead(int nt, int cur, TokenStream *ts,
+                           LambdaMemo *memo, const SemStack *S,
+                           const HulkGenericNames *generics,
+                           GrammarSymbol out[LOCAL_LA_MAX]) {
+    TokenCursor la;
+    token_cursor_init(&la, ts);
+    switch (nt) {
+    case NT_Expr: case NT_Unary: case NT_Postfix: case NT_Stmt: case NT_Body:
+    case NT_TermStmt: case NT_StmtList: case NT_Args: case NT_VecItems: {
+        int lambda_start =
+            (cur == TOKEN_FUNCTION) ||
+            (cur == TOKEN_LPAREN && lookahead_is_lambda(memo, la));
+        if (lambda_start) {
+            switch (nt) {
+            case NT_Expr:     out[0] = LA_NT(NT_Or); return 1;
+            case NT_Unary:    out[0] = LA_NT(NT_Postfix); return 1;
+            case NT_Postfix:  out[0] = LA_NT(NT_Primary); out[1] = LA_NT(NT_Call); return 2;
+            case NT_Stmt:
+            case NT_Body:     out[0] = LA_NT(NT_Expr); return 1;
+            case NT_TermStmt: out[0] = LA_NT(NT_Stmt); out[1] = LA_T(TOKEN_SEMICOLON); return 2;
+            case NT_StmtList: out[0] = LA_NT(NT_TermStmt); out[1] = LA_NT(NT_StmtList); return 2;
+            case NT_Args:     out[0] = LA_NT(NT_Expr); out[1] = LA_NT(NT_ArgsT); return 2;
+            case NT_VecItems: out[0] = LA_NT(NT_Expr); out[1] = LA_NT(NT_VecItemsT); return 2;
             }
         }
+        if ((nt == NT_Stmt || nt == NT_Body) && cur == TOKEN_LBRACE) {
+            out[0] = LA_NT(NT_Block);
+            return 1;
+        }
+        return LA_TABLE;
     }
+    case NT_TopItem:
+        if (cur == TOKEN_FUNCTION) {
+            out[0] = LA_NT(peek_next_type(la) == TOKEN_IDENT ? NT_FunctionDef
+                                                              : NT_TermStmt);
+            return 1;
+        }
+        if (cur == TOKEN_LBRACE) {
+            out[0] = LA_NT(NT_Block); out[1] = LA_NT(NT_OptSemi);
+            return 2;
+        }
+        return LA_TABLE;
+    case NT_ArrayTypeSuffix:
+        if (cur == TOKEN_LBRACKET && peek_next_type(la) != TOKEN_RBRACKET)
+            return 0; /* ε: este `[` pertenece al tamaño de new T[expr] */
+        return LA_TABLE;
+    case NT_Call:
+        if (cur == TOKEN_DOT && peek_next_type(la) == TOKEN_BASE) {
+            out[0] = LA_T(TOKEN_DOT); out[1] = LA_T(TOKEN_BASE);
+            out[2] = LA_ACT(A_MEMBER); out[3] = LA_NT(NT_Call);
+            return 4;
+        }
+        if (cur == TOKEN_EOF)
+            return 0; /* ε: expresión final sin `;` explícito (las colas
+                       * Or'…Factor' ya no se apilan: ver Pratt) */
+        if (cur == TOKEN_LT) {
+            if (!callee_is_generic(S, generics) ||
+                !lookahead_skip_type_args(&la) ||
+                next_type_inplace(&la) != TOKEN_LPAREN)
+                return 0; /* ε: es el operador `<` */
+            out[0] = LA_NT(NT_CallTypeArgs); out[1] = LA_NT(NT_Call);
+            return 2;
+        }
+        return LA_TABLE;
+    case NT_Primary:
+        if (cur == TOKEN_FUNCTION ||
+            (cur == TOKEN_LPAREN && lookahead_is_lambda(memo, la))) {
+            out[0] = LA_NT(NT_Lambda);
+            return 1;
+        }
+        if (cur == TOKEN_BASE && peek_next_type(la) != TOKEN_LPAREN) {
+            out[0] = LA_T(TOKEN_BASE); out[1] = LA_ACT(A_IDENT);
+            return 2;
+        }
+        return LA_TABLE;
+    }
+    return LA_TABLE;
 }
 
 /* ============================================================
  *  Parser principal
  * ============================================================ */
-#define PSTACK_MAX 4096
-#define SEMSTACK_MAX 4096
+/* Capacidad inline de las pilas; más allá crecen en heap. */
+#define PSTACK_INLINE 512
+#define SEMSTACK_INLINE 256
+
+/* Arma el ProgramNode con los nodos que quedaron en la pila semántica. */
+static HulkNode* collect_program(SemStack *S) {
+    ProgramNode *prog = hulk_ast_program(S->ctx, 1, 1);
+    hulk_node_list_reserve(&prog->declarations, S->sp);
+    for (int i = 0; i < S->sp; i++)
+        if (S->s[i].k == V_NODE)
+            hulk_node_list_push(&prog->declarations, S->s[i].node);
+    return (HulkNode*)prog;
+}
+
+void hulk_ll1_last_stats(HulkLL1Stats *out) {
+    if (out) *out = last_stats;
+}
+
+void hulk_ll1_set_last_stats(const HulkLL1Stats *stats) {
+    last_stats = *stats;
+}
+
+void hulk_ll1_ensure_grammar(void) {
+    if (!G.initialized) build_grammar();
+}
 
 HulkNode* hulk_ll1_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
+    return hulk_ll1_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_INLINE);
+}
+
+HulkNode* hulk_ll1_build_ast_mode(HulkASTContext *ctx, DFA *dfa,
+                                  const char *input, TokenStreamMode mode) {
     if (!ctx || !dfa || !input) return NULL;
-    if (!G.initialized) build_grammar();
+    hulk_ll1_ensure_grammar();
+    HulkGenericNames generics;
+    hulk_generic_names_scan(&generics, input);
+    HulkNode *prog = hulk_ll1_parse_at(ctx, dfa, input, mode, 1, 1, 0,
+                                       &generics, &last_stats);
+    hulk_generic_names_free(&generics);
+    return prog;
+}
 
-    LexerContext lx; lexer_init(&lx, dfa, input);
-    Token cur = lexer_next_token(&lx);
+HulkNode* hulk_ll1_parse_at(HulkASTContext *ctx, DFA *dfa, const char *input,
+                            TokenStreamMode mode, int line, int col,
+                            int quiet_until, const HulkGenericNames *generics,
+                            HulkLL1Stats *stats) {
+    TokenStream ts;
+    token_stream_open_at(&ts, dfa, input, mode, line, col);
+    ts.lx.quiet_until = quiet_until;
+    Token cur = token_stream_next(&ts);
     int last_line = cur.line;
     int last_col = cur.col;
 
-    GrammarSymbol pstk[PSTACK_MAX]; int ptop = 0;
-    SemVal semarr[SEMSTACK_MAX];
-    SemStack S = { ctx, semarr, 0, SEMSTACK_MAX, 0 };
+    GrammarSymbol pstk_inline[PSTACK_INLINE];
+    PStack P = { pstk_inline, NULL, 0, PSTACK_INLINE, 0 };
+    SemVal sem_inline[SEMSTACK_INLINE];
+    SemStack S = { ctx, sem_inline, NULL, 0, SEMSTACK_INLINE, 0, 0 };
+    LambdaMemo memo = { NULL, 0, NULL, NULL, 0, 0 };
 
-    pstk[ptop++] = (GrammarSymbol){SYMBOL_END, 0};
-    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Program};
+    ps_push(&P, (GrammarSymbol){SYMBOL_END, 0});
+    PS_NT(&P, NT_Program);
 
     char *pending_lex = NULL;  /* lexema del último terminal con valor */
     int had_error = 0;
 
-    while (ptop > 0 && !had_error) {
-        GrammarSymbol top = pstk[--ptop];
+    long symbols = 0, tokens = 0;
+
+    while (P.top > 0 && !had_error) {
+        GrammarSymbol top = P.s[--P.top];
+        symbols++;
 
         if (top.type == SYMBOL_END) break;
         if (top.type == SYMBOL_EPSILON) continue;
 
+        if (top.type == SYMBOL_ACTION && IS_PRATT(top.id)) {
+            pratt_continue(top.id, (int)cur.type, &P);
+            continue;
+        }
+
         if (top.type == SYMBOL_ACTION) {
             /* Antes de ejecutar la acción, si hay un lexema pendiente de un
              * terminal con valor (IDENT/NUMBER/STRING), empujarlo a la pila
@@ -936,14 +1438,13 @@ HulkNode* hulk_ll1_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
             if (cur.type == (TokenType)top.id) {
                 /* terminales con valor: empujar su lexema a la pila semántica */
                 if (top.id == TOKEN_IDENT || top.id == TOKEN_BASE ||
-                    top.id == TOKEN_NUMBER || top.id == TOKEN_STRING) {
-                    char *dup = hulk_ast_strdup(ctx, cur.lexeme ? cur.lexeme : "");
-                    sv_push_lex(&S, dup);
-                }
+                    top.id == TOKEN_NUMBER || top.id == TOKEN_STRING)
+                    sv_push_lex(&S, shift_lexeme(ctx, &cur));
                 last_line = cur.line;
                 last_col = cur.col;
+                tokens++;
                 if (cur.lexeme) free(cur.lexeme);
-                cur = lexer_next_token(&lx);
+                cur = token_stream_next(&ts);
             } else {
                 LOG_ERROR_MSG("ast_builder", "[%d:%d] se esperaba token %d, se encontró %d",
                               cur.line, cur.col, top.id, cur.type);
@@ -952,136 +1453,17 @@ HulkNode* hulk_ll1_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
             continue;
         }
 
-        /* ---- Lookahead local: puntos no-LL(1) de HULK ----
-         * (a) TopItem con FUNCTION: def `function f(` vs expr `function(`.
-         * (b) Primary con LPAREN: lambda `(x)->` vs paréntesis `(expr)`.
-         * (c) Primary con FUNCTION: siempre lambda (FunctionExpr). */
         if (top.type == SYMBOL_NON_TERMINAL) {
-            int lambda_start =
-                (cur.type == TOKEN_FUNCTION) ||
-                (cur.type == TOKEN_LPAREN && lookahead_is_lambda(lx));
-            if (lambda_start) {
-                if (top.id == NT_Expr) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Or};
-                    continue;
-                }
-                if (top.id == NT_Or) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_OrP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_And};
-                    continue;
-                }
-                if (top.id == NT_And) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_AndP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Cmp};
-                    continue;
-                }
-                if (top.id == NT_Cmp) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_CmpP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Concat};
-                    continue;
-                }
-                if (top.id == NT_Concat) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_ConcatP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Add};
-                    continue;
-                }
-                if (top.id == NT_Add) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_AddP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Term};
-                    continue;
-                }
-                if (top.id == NT_Term) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_TermP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Factor};
-                    continue;
-                }
-                if (top.id == NT_Factor) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_FactorP};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Unary};
-                    continue;
-                }
-                if (top.id == NT_Unary) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Postfix};
-                    continue;
-                }
-                if (top.id == NT_Postfix) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Call};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Primary};
-                    continue;
-                }
-                if (top.id == NT_Stmt || top.id == NT_Body) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Expr};
-                    continue;
-                }
-                if (top.id == NT_TermStmt) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_TERMINAL, TOKEN_SEMICOLON};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Stmt};
-                    continue;
-                }
-                if (top.id == NT_StmtList) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_StmtList};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_TermStmt};
-                    continue;
-                }
-                if (top.id == NT_Args) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_ArgsT};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Expr};
-                    continue;
-                }
-                if (top.id == NT_VecItems) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_VecItemsT};
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Expr};
-                    continue;
-                }
-            }
-            if (top.id == NT_TopItem && cur.type == TOKEN_FUNCTION) {
-                if (peek_next_type(lx) == TOKEN_IDENT) {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_FunctionDef};
-                } else {
-                    pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_TermStmt};
-                }
+            if (top.id == G.pratt_entry) {
+                ps_push(&P, pratt_loop_sym(0, G.pratt_max_bp));
+                PS_NT(&P, G.pratt_operand);
                 continue;
             }
-            if (top.id == NT_TopItem && cur.type == TOKEN_LBRACE) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_OptSemi};
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Block};
-                continue;
-            }
-            if ((top.id == NT_Stmt || top.id == NT_Body) && cur.type == TOKEN_LBRACE) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Block};
-                continue;
-            }
-            if (top.id == NT_ArrayTypeSuffix && cur.type == TOKEN_LBRACKET &&
-                peek_next_type(lx) != TOKEN_RBRACKET) {
-                continue; /* ε: este `[` pertenece al tamaño de new T[expr] */
-            }
-            if (top.id == NT_Call && cur.type == TOKEN_DOT &&
-                peek_next_type(lx) == TOKEN_BASE) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Call};
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_ACTION, A_MEMBER};
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_TERMINAL, TOKEN_BASE};
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_TERMINAL, TOKEN_DOT};
-                continue;
-            }
-            if (cur.type == TOKEN_EOF &&
-                (top.id == NT_OrP || top.id == NT_AndP || top.id == NT_CmpP ||
-                 top.id == NT_ConcatP || top.id == NT_AddP || top.id == NT_TermP ||
-                 top.id == NT_FactorP || top.id == NT_Call)) {
-                continue; /* ε: expresión final sin `;` explícito */
-            }
-            if (top.id == NT_Primary && cur.type == TOKEN_FUNCTION) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Lambda};
-                continue;
-            }
-            if (top.id == NT_Primary && cur.type == TOKEN_LPAREN &&
-                lookahead_is_lambda(lx)) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_NON_TERMINAL, NT_Lambda};
-                continue;
-            }
-            if (top.id == NT_Primary && cur.type == TOKEN_BASE &&
-                peek_next_type(lx) != TOKEN_LPAREN) {
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_ACTION, A_IDENT};
-                pstk[ptop++] = (GrammarSymbol){SYMBOL_TERMINAL, TOKEN_BASE};
+            GrammarSymbol seq[LOCAL_LA_MAX];
+            int n = local_lookahead(top.id, (int)cur.type, &ts, &memo, &S,
+                                    generics, seq);
+            if (n != LA_TABLE) {
+                while (n > 0) ps_push(&P, seq[--n]);
                 continue;
             }
         }
@@ -1098,19 +1480,175 @@ HulkNode* hulk_ll1_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
             break;
         }
         /* prod es el grammar production id; coincide con el índice de datos */
-        push_production_actions(prod, pstk, &ptop);
+        push_production_actions(prod, &P);
+        if (P.oom) {
+            LOG_FATAL_MSG("ast_builder", "sin memoria para la pila del parser (%d símbolos)", P.top);
+            had_error = 1;
+        }
     }
     (void)pending_lex;
 
     if (cur.lexeme) free(cur.lexeme);
+    token_stream_close(&ts);
+    free(P.heap);
+    lambda_memo_free(&memo);
+
+    stats->tokens = tokens;
+    stats->symbols = symbols;
+    stats->sem_ops = S.ops;
+    stats->lookahead_tokens = ts.peeked;
 
-    if (had_error || S.had_error) return NULL;
+    if (had_error || S.had_error) { free(S.heap); return NULL; }
     /* El resultado: el Program se construye implícitamente. Como no hay una
      * acción que arme ProgramNode (StmtList deja los stmts sueltos), los
      * recolectamos: el AST de cada TermStmt quedó en la pila en orden. */
-    ProgramNode *prog = hulk_ast_program(ctx, 1, 1);
-    for (int i = 0; i < S.sp; i++)
-        if (S.s[i].k == V_NODE)
-            hulk_node_list_push(&prog->declarations, S.s[i].node);
-    return (HulkNode*)prog;
+    HulkNode *prog = collect_program(&S);
+    free(S.heap);
+    return prog;
+}
+
+/* ============================================================
+ *  Parser descendente recursivo (generado) — runtime
+ * ============================================================
+ * hulk_rd_parser.c (emitido por hulk_rd_gen.c desde HULK_PRODS y la
+ * tabla LL(1)) decide cada producción con un switch sobre el token; estas
+ * funciones hacen lo mismo que el bucle de la tabla para un terminal, una
+ * acción, el bucle Pratt y el lookahead local. Misma secuencia de acciones
+ * y mismas posiciones: el AST es idéntico al del motor de tabla. */
+
+void hulk_rd_match(HulkRD *R, int token) {
+    if (R->had_error) return;
+    R->symbols++;
+    if (token == TOKEN_SEMICOLON && R->cur.type == TOKEN_EOF)
+        return; /* el `;` final es opcional al EOF */
+    if ((int)R->cur.type != token) {
+        LOG_ERROR_MSG("ast_builder", "[%d:%d] se esperaba token %d, se encontró %d",
+                      R->cur.line, R->cur.col, token, R->cur.type);
+        R->had_error = 1;
+        return;
+    }
+    if (token == TOKEN_IDENT || token == TOKEN_BASE ||
+        token == TOKEN_NUMBER || token == TOKEN_STRING)
+        sv_push_lex(R->S, shift_lexeme(R->ctx, &R->cur));
+    R->last_line = R->cur.line;
+    R->last_col = R->cur.col;
+    R->tokens++;
+    if (R->cur.lexeme) free(R->cur.lexeme);
+    R->cur = token_stream_next(&R->ts);
+}
+
+void hulk_rd_action(HulkRD *R, int act) {
+    if (R->had_error) return;
+    R->symbols++;
+    exec_hulk_action(act, R->S, R->last_line, R->last_col);
+    if (R->S->had_error) R->had_error = 1;
+}
+
+int hulk_rd_local_lookahead(HulkRD *R, int nt) {
+    GrammarSymbol seq[LOCAL_LA_MAX];
+    int n = local_lookahead(nt, (int)R->cur.type, &R->ts, R->memo, R->S,
+                            R->generics, seq);
+    if (n == LA_TABLE) return 0;
+    for (int i = 0; i < n && !R->had_error; i++) {
+        if (seq[i].type == SYMBOL_NON_TERMINAL)  hulk_rd_parse_nt(R, seq[i].id);
+        else if (seq[i].type == SYMBOL_TERMINAL) hulk_rd_match(R, seq[i].id);
+        else                                     hulk_rd_action(R, seq[i].id);
+    }
+    return 1;
+}
+
+/* Mismo contrato que LOOP(min_bp, cap) en la pila: operando y luego
+ * operadores con min_bp < lbp <= cap, con el operando derecho parseado
+ * recursivamente con su rbp. */
+void hulk_rd_pratt(HulkRD *R, int min_bp) {
+    if (!hulk_rd_enter(R)) return;
+    hulk_rd_parse_nt(R, G.pratt_operand);
+    int cap = G.pratt_max_bp;
+    while (!R->had_error) {
+        int tok = (int)R->cur.type;
+        if (tok < 0 || tok >= 256) break;
+        const BindPower *b = &G.bp[tok];
+        if (b->lbp == 0 || b->lbp <= min_bp || b->lbp > cap) break;
+        hulk_rd_match(R, tok);
+        if (b->postfix) {
+            hulk_rd_match(R, TOKEN_IDENT);
+            hulk_rd_action(R, b->action);
+            cap = b->lbp;
+            continue;
+        }
+        hulk_rd_pratt(R, b->right_assoc ? b->lbp - 1 : b->lbp);
+        hulk_rd_action(R, b->action);
+        cap = G.pratt_max_bp;
+    }
+    hulk_rd_leave(R);
+}
+
+void hulk_rd_no_production(HulkRD *R, int nt) {
+    if (R->had_error) return;
+    int la = (R->cur.type == TOKEN_EOF) ? END_MARKER : (int)R->cur.type;
+    LOG_ERROR_MSG("ast_builder", "[%d:%d] no hay producción para [%s, token %d]",
+                  R->cur.line, R->cur.col, hulk_ll1_nt_name(nt), la);
+    R->had_error = 1;
+}
+
+HulkNode* hulk_rd_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input) {
+    return hulk_rd_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_INLINE);
+}
+
+HulkNode* hulk_rd_build_ast_mode(HulkASTContext *ctx, DFA *dfa,
+                                 const char *input, TokenStreamMode mode) {
+    if (!ctx || !dfa || !input) return NULL;
+    hulk_ll1_ensure_grammar();
+    HulkGenericNames generics;
+    hulk_generic_names_scan(&generics, input);
+    HulkNode *prog = hulk_rd_parse_at(ctx, dfa, input, mode, 1, 1,
+                                      &generics, &last_stats);
+    hulk_generic_names_free(&generics);
+    return prog;
+}
+
+HulkNode* hulk_rd_parse_at(HulkASTContext *ctx, DFA *dfa, const char *input,
+                           TokenStreamMode mode, int line, int col,
+                           const HulkGenericNames *generics,
+                           HulkLL1Stats *stats) {
+
+    SemVal sem_inline[SEMSTACK_INLINE];
+    SemStack S = { ctx, sem_inline, NULL, 0, SEMSTACK_INLINE, 0, 0 };
+    LambdaMemo memo = { NULL, 0, NULL, NULL, 0, 0 };
+
+    HulkRD R;
+    memset(&R, 0, sizeof(R));
+    R.ctx = ctx;
+    token_stream_open_at(&R.ts, dfa, input, mode, line, col);
+    R.cur = token_stream_next(&R.ts);
+    R.last_line = R.cur.line;
+    R.last_col = R.cur.col;
+    R.S = &S;
+    R.memo = &memo;
+    R.generics = generics;
+
+    hulk_rd_parse_nt(&R, NT_Program);
+
+    int lexed = R.ts.lx.pos;  /* hasta aquí los errores léxicos ya salieron */
+    if (R.cur.lexeme) free(R.cur.lexeme);
+    token_stream_close(&R.ts);
+    lambda_memo_free(&memo);
+
+    if (R.too_deep) {
+        /* anidamiento patológico: el motor de tabla no usa la pila de C;
+         * re-lexea desde el inicio sin repetir los diagnósticos ya dados */
+        free(S.heap);
+        return hulk_ll1_parse_at(ctx, dfa, input, mode, line, col, lexed,
+                                 generics, stats);
+    }
+
+    stats->tokens = R.tokens;
+    stats->symbols = R.symbols;
+    stats->sem_ops = S.ops;
+    stats->lookahead_tokens = R.ts.peeked;
+
+    if (R.had_error || S.had_error) { free(S.heap); return NULL; }
+    HulkNode *prog = collect_program(&S);
+    free(S.heap);
+    return prog;
 }
@@ -6,17 +6,53 @@
  * AST mediante acciones semánticas sobre una pila semántica.
  *
  * El único punto no-LL(1) de HULK (lambda `(x)->…` vs. `(expr)`) se
- * resuelve con un lookahead local documentado.
+ * resuelve con un lookahead local documentado. Las expresiones binarias
+ * se delegan a un sub-parser de precedencia (Pratt) cuya tabla de
+ * binding powers se deriva de la misma gramática.
  */
 
 #ifndef HULK_LL1_BUILDER_H
 #define HULK_LL1_BUILDER_H
 
 #include "../core/hulk_ast.h"
-#include "../../generador_analizadores_lexicos/afd.h"
+#include "../../generador_analizadores_lexicos/token_stream.h"
+#include <stdio.h>
 
 /* Construye el AST de un programa HULK con el parser LL(1) dirigido por
  * tabla. Retorna NULL si hubo error de parsing. */
 HulkNode* hulk_ll1_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input);
 
+/* Misma gramática y mismas acciones, pero con el parser descendente
+ * recursivo generado desde HULK_PRODS (hulk_rd_parser.c): sin pila
+ * explícita ni consulta de tabla por símbolo. Produce el mismo AST que
+ * hulk_ll1_build_ast; si el anidamiento excede HULK_RD_MAX_DEPTH vuelve
+ * al motor de tabla. */
+HulkNode* hulk_rd_build_ast(HulkASTContext *ctx, DFA *dfa, const char *input);
+
+/* Variantes que eligen cómo llegan los tokens (token_stream.h): en línea
+ * o con el lexer en un hilo productor. El AST y los diagnósticos son los
+ * mismos en ambos modos; las versiones sin _mode usan el modo en línea. */
+HulkNode* hulk_ll1_build_ast_mode(HulkASTContext *ctx, DFA *dfa,
+                                  const char *input, TokenStreamMode mode);
+HulkNode* hulk_rd_build_ast_mode(HulkASTContext *ctx, DFA *dfa,
+                                 const char *input, TokenStreamMode mode);
+
+/* Emite a `out` el código C de hulk_rd_parser.c (ver hulk_rd_gen.c).
+ * Retorna 1 si tuvo éxito. */
+int hulk_rd_emit(FILE *out);
+
+/* Contadores de la última llamada a hulk_ll1_build_ast o
+ * hulk_rd_build_ast: tokens consumidos, símbolos procesados (desapilados
+ * del autómata, o visitados por el descendente recursivo), operaciones
+ * sobre la pila semántica y tokens re-escaneados por el lookahead local.
+ * Sirven para medir el costo por token del parser. */
+typedef struct {
+    long tokens;
+    long symbols;
+    long sem_ops;
+    long lookahead_tokens;
+} HulkLL1Stats;
+
+void hulk_ll1_last_stats(HulkLL1Stats *out);
+
 #endif /* HULK_LL1_BUILDER_H */
@@ -0,0 +1,214 @@
+/*
+ * hulk_ll1_internal.h — Piezas compartidas del builder LL(1) de HULK
+ *
+ * Header PRIVADO de hulk_ast/builder/. Lo comparten:
+ *   - hulk_ll1_builder.c: gramática como datos (HULK_PRODS), acciones
+ *     semánticas, lookahead local y los dos motores de parsing;
+ *   - hulk_rd_gen.c: generador que emite el parser descendente recursivo
+ *     a partir de HULK_PRODS y de la tabla LL(1) (FIRST/FOLLOW);
+ *   - hulk_rd_parser.c: el parser descendente recursivo generado.
+ */
+
+#ifndef HULK_LL1_INTERNAL_H
+#define HULK_LL1_INTERNAL_H
+
+#include "../core/hulk_ast.h"
+#include "hulk_ll1_builder.h"
+#include "../../generador_analizadores_lexicos/token_stream.h"
+
+/* ============================================================
+ *  No-terminales
+ * ============================================================ */
+enum {
+    NT_Program, NT_TopList, NT_TopItem, NT_OptSemi, NT_StmtList, NT_TermStmt, NT_Stmt,
+    NT_Expr, NT_Or, NT_OrP, NT_And, NT_AndP, NT_Cmp, NT_CmpP,
+    NT_Concat, NT_ConcatP, NT_Add, NT_AddP, NT_Term, NT_TermP,
+    NT_Factor, NT_FactorP, NT_Unary, NT_Postfix,
+    NT_Primary, NT_Call, NT_Args, NT_ArgsT,
+    NT_Let, NT_Bindings, NT_BindingsT, NT_Binding, NT_TypeAnn,
+    NT_If, NT_ElifL, NT_Body,
+    NT_While, NT_For, NT_Block,
+    NT_VecItems, NT_VecItemsT,
+    /* Capa 2: definiciones */
+    NT_FunctionDef, NT_Params, NT_ParamsT, NT_Param, NT_FuncBody, NT_FuncExprBody,
+    NT_TypeDef, NT_TypeParams, NT_TypeInherit, NT_TypeBaseArgs,
+    NT_TypeBody, NT_TypeMember, NT_TypeMemberTail, NT_AttrTail, NT_MethodBody,
+    NT_ProtocolDef, NT_ProtoExt, NT_ProtoSigs, NT_ProtoSig,
+    NT_DecorBlock, NT_DecorMore, NT_DecorTarget,
+    NT_DecorItems, NT_DecorItemsT, NT_DecorItem, NT_DecorArgs,
+    NT_DecorPrefix,
+    NT_TypeRef, NT_TypeSuffix, NT_TypeList, NT_TypeListT,
+    NT_NewTail, NT_ArrayTypeSuffix, NT_ArrayInit,
+    NT_Lambda,
+    /* Capa 4: genéricos */
+    NT_TypeArgs, NT_CallTypeArgs, NT_GenParams, NT_GenParamsT,
+    NT_COUNT
+};
+
+/* ============================================================
+ *  Acciones semánticas (offset alto para distinguir de NT/T)
+ * ============================================================ */
+enum {
+    A_NUM = 9000, A_STR, A_TRUE, A_FALSE, A_IDENT, A_SELF,
+    A_OR, A_AND, A_LT, A_GT, A_LE, A_GE, A_EQ, A_NEQ,
+    A_CONCAT, A_CONCATWS, A_ADD, A_SUB, A_MUL, A_DIV, A_MOD, A_POW,
+    A_NEG, A_NOT, A_AS, A_IS,
+    A_SENT, A_CALL, A_MEMBER, A_INDEX, A_ASSIGN, A_DESTRUCT,
+    A_NEW, A_BASE,
+    A_LET, A_BIND, A_TYPE_NAME, A_TYPE_NONE,
+    A_IF, A_ELIF, A_WHILE, A_FOR, A_BLOCK_BEGIN, A_BLOCK,
+    A_VEC,
+    /* Capa 2 */
+    A_PARAM, A_FUNCDEF, A_FUNCEXPR,
+    A_TD_BEGIN, A_TD_PARAMS, A_TD_PARENT, A_TD_PARGS,
+    A_METHOD, A_ATTR, A_ATTR_NOINIT,
+    A_PROTO_BEGIN, A_PROTO_METHOD,
+    A_DECOR_ITEM, A_DECOR_BLOCK, A_TYPE_FUNC,
+    /* Capa 3 */
+    A_TYPE_ARRAY, A_TYPE_ITER, A_ARRAY_NEW, A_ARRAY_INIT,
+    /* Capa 4 */
+    A_TYPE_ARGS, A_CALL_TYPE_ARGS,
+};
+
+/* Codificación de símbolos en el RHS de los datos:
+ *   NT:  0 .. NT_COUNT-1
+ *   T:   TBASE + TOKEN_*
+ *   ACT: (ya >= 9000) */
+#define TBASE 1000
+#define T(tok) (TBASE + (tok))
+#define IS_T(x)   ((x) >= TBASE && (x) < 9000)
+#define IS_ACT(x) ((x) >= 9000)
+#define IS_NT(x)  ((x) >= 0 && (x) < TBASE)
+
+/* Marcador del bucle de precedencia (Pratt) en la pila del autómata:
+ *   id = A_PRATT_BASE + min_bp * PRATT_BP_SPAN + cap
+ * min_bp: un operador solo se acepta si su lbp > min_bp.
+ * cap:    lbp máximo aceptable (tras un postfijo `is T` solo siguen
+ *         operadores de su nivel o inferiores, como en la escalera LL(1)). */
+#define A_PRATT_BASE  9800
+#define PRATT_BP_SPAN 16
+#define IS_PRATT(x)   ((x) >= A_PRATT_BASE)
+
+/* ============================================================
+ *  Vista de la gramática (para el generador)
+ * ============================================================ */
+
+/* Cantidad de producciones de HULK_PRODS. */
+int hulk_ll1_prod_count(void);
+
+/* RHS completo (con acciones) de la producción `prod`; *lhs y *n reciben
+ * el no-terminal izquierdo y la longitud (0 = ε). */
+const int* hulk_ll1_prod_rhs(int prod, int *lhs, int *n);
+
+/* Producción que predice la tabla LL(1) para (nt, token); TOKEN_EOF
+ * representa `$`. Retorna -1 si la celda está vacía. */
+int hulk_ll1_predict(int nt, int token);
+
+const char* hulk_ll1_nt_name(int nt);
+const char* hulk_ll1_action_name(int act);
+
+/* NT que abre la escalera de precedencia (delegado al sub-parser Pratt)
+ * y NT de sus operandos. */
+int hulk_ll1_pratt_entry(void);
+int hulk_ll1_pratt_operand(void);
+
+/* 1 si el NT tiene un punto no-LL(1) resuelto por lookahead local;
+ * los NTs que ese lookahead puede derivar quedan en *out. */
+int hulk_ll1_has_local_lookahead(int nt);
+int hulk_ll1_local_lookahead_targets(const int **out);
+
+/* ============================================================
+ *  Runtime del parser descendente recursivo
+ * ============================================================
+ * El código generado solo decide la producción (switch sobre el token
+ * actual) y recorre su RHS; consumir terminales, ejecutar acciones y
+ * resolver los puntos no-LL(1) lo hace este runtime, compartido con el
+ * motor de tabla. */
+
+/* Profundidad máxima de recursión; más allá se vuelve al motor de tabla
+ * (pila en heap) para no desbordar la pila de C. */
+#define HULK_RD_MAX_DEPTH 20000
+
+struct SemStack;
+struct LambdaMemo;
+
+/* Genéricos declarados en la entrada (`function f<`, `type T<`), como
+ * nombres internados: solo tras uno de ellos un `<` puede abrir
+ * argumentos de tipo; tras cualquier otro callee es el operador. */
+typedef struct {
+    const char **names;
+    int          count, cap;
+} HulkGenericNames;
+
+/* Pre-escaneo por caracteres de `input` (sin lexer). Un falso positivo
+ * (p.ej. dentro de un string) solo habilita el lookahead de tipos para
+ * ese nombre. */
+void hulk_generic_names_scan(HulkGenericNames *g, const char *input);
+void hulk_generic_names_free(HulkGenericNames *g);
+
+typedef struct HulkRD {
+    HulkASTContext    *ctx;
+    TokenStream        ts;
+    Token              cur;
+    int                last_line, last_col;
+    struct SemStack   *S;
+    struct LambdaMemo *memo;
+    const HulkGenericNames *generics;
+    int                depth;
+    int                had_error;
+    int                too_deep;
+    long               tokens, symbols;
+} HulkRD;
+
+/* Entrada a un no-terminal: 0 si hay error previo o se excede la
+ * profundidad (en ese caso no debe llamarse a hulk_rd_leave). */
+static inline int hulk_rd_enter(HulkRD *R) {
+    if (R->had_error) return 0;
+    if (R->depth >= HULK_RD_MAX_DEPTH) {
+        R->too_deep = 1;
+        R->had_error = 1;
+        return 0;
+    }
+    R->depth++;
+    R->symbols++;
+    return 1;
+}
+
+static inline void hulk_rd_leave(HulkRD *R) { R->depth--; }
+
+static inline int hulk_rd_token(const HulkRD *R) { return (int)R->cur.type; }
+
+void hulk_rd_match(HulkRD *R, int token);
+void hulk_rd_action(HulkRD *R, int act);
+int  hulk_rd_local_lookahead(HulkRD *R, int nt);  /* 1 si resolvió el NT */
+void hulk_rd_pratt(HulkRD *R, int min_bp);
+void hulk_rd_no_production(HulkRD *R, int nt);
+
+/* Construye la gramática y la tabla si aún no existen. Debe llamarse
+ * antes de parsear desde varios hilos: después todo es de solo lectura. */
+void hulk_ll1_ensure_grammar(void);
+
+/* Núcleo reentrante de hulk_*_build_ast_mode: parsea `input` (un archivo o
+ * un fragmento que arranca en line:col) y deja los contadores en *stats
+ * en vez de en los de hulk_ll1_last_stats. Requiere la gramática lista.
+ * `quiet_until`: los errores léxicos antes de ese offset no se reportan
+ * (ya los reportó un intento anterior sobre la misma entrada).
+ * `generics`: las funciones genéricas del archivo completo (un fragmento
+ * puede llamar a las de otro); NULL si no hay. */
+HulkNode* hulk_ll1_parse_at(HulkASTContext *ctx, DFA *dfa, const char *input,
+                            TokenStreamMode mode, int line, int col,
+                            int quiet_until, const HulkGenericNames *generics,
+                            HulkLL1Stats *stats);
+HulkNode* hulk_rd_parse_at(HulkASTContext *ctx, DFA *dfa, const char *input,
+                           TokenStreamMode mode, int line, int col,
+                           const HulkGenericNames *generics,
+                           HulkLL1Stats *stats);
+
+/* Publica en hulk_ll1_last_stats los contadores agregados de un parseo
+ * hecho por tramos (hulk_parallel_builder.c). */
+void hulk_ll1_set_last_stats(const HulkLL1Stats *stats);
+
+/* Generado (hulk_rd_parser.c): despacha al parser del no-terminal `nt`. */
+void hulk_rd_parse_nt(HulkRD *R, int nt);
+
+#endif /* HULK_LL1_INTERNAL_H */
@@ -0,0 +1,273 @@
+/*
+ * hulk_parallel_builder.c — Reparto de ítems de nivel superior entre hilos
+ *
+ * El pre-escaneo replica del lexer solo lo necesario para no confundirse:
+ * strings ("…" sin escapes, como la regex de TOKEN_STRING), comentarios
+ * `//` y el anidamiento de (), [] y {}. El conteo de columnas es por byte,
+ * igual que advance_position del lexer, así las posiciones de los nodos
+ * de cada tramo coinciden con las del parseo secuencial.
+ */
+
+#include "hulk_parallel_builder.h"
+#include "hulk_ll1_builder.h"
+#include "hulk_ll1_internal.h"
+#include "../../generador_analizadores_lexicos/lexer.h"
+#include "../../error_handler.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ============== PRE-ESCANEO ==============
+
+static int is_ident_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int is_ident_char(char c) {
+    return is_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+static int word_is(const char *w, int len, const char *kw) {
+    return (int)strlen(kw) == len && memcmp(w, kw, (size_t)len) == 0;
+}
+
+// `function` solo abre una declaración si le sigue un nombre (si no, es
+// una lambda `function (…) -> …`, como decide el lookahead del parser).
+static int is_decl_keyword(const char *w, int len) {
+    if (word_is(w, len, "function")) {
+        const char *p = w + len;
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        return is_ident_start(*p);
+    }
+    return word_is(w, len, "type") || word_is(w, len, "protocol") ||
+           word_is(w, len, "define") || word_is(w, len, "decor");
+}
+
+// Estado del ítem de nivel superior en curso.
+enum { ITEM_NONE, ITEM_DECL, ITEM_OTHER };
+
+int hulk_top_level_boundaries(const char *in, HulkTopBoundary **out) {
+    int cap = 64, n = 0;
+    HulkTopBoundary *b = malloc(sizeof(HulkTopBoundary) * cap);
+    *out = b;
+    if (!b) return 0;
+
+    int depth = 0, line = 1, col = 1;
+    int item = ITEM_NONE;   // ITEM_NONE: el próximo token abre un ítem
+    int arrow_body = 0;     // declaración con `=>`/`->`: su `}` no la cierra
+    int seen_item = 0;
+    int i = 0;
+
+    while (in[i]) {
+        char c = in[i];
+        if (c == '\n') { line++; col = 1; i++; continue; }
+        if (c == ' ' || c == '\t' || c == '\r') { col++; i++; continue; }
+        if (c == '/' && in[i + 1] == '/') {
+            while (in[i] && in[i] != '\n') { i++; col++; }
+            continue;
+        }
+
+        int opens = (item == ITEM_NONE);
+        if (opens) item = ITEM_OTHER;
+
+        if (c == '"') {
+            i++; col++;
+            while (in[i] && in[i] != '"') {
+                if (in[i] == '\n') { line++; col = 1; } else col++;
+                i++;
+            }
+            if (!in[i]) break;  // sin cierre: error léxico, no cortar más
+            i++; col++;
+            continue;
+        }
+
+        if (is_ident_start(c)) {
+            int start = i, start_line = line, start_col = col;
+            while (is_ident_char(in[i])) { i++; col++; }
+            if (opens && depth == 0 && is_decl_keyword(in + start, i - start)) {
+                item = ITEM_DECL;
+                arrow_body = 0;
+                if (seen_item) {
+                    if (n >= cap) {
+                        HulkTopBoundary *nb = realloc(b, sizeof(HulkTopBoundary) * cap * 2);
+                        if (!nb) break;  // sin memoria: menos fronteras
+                        b = nb;
+                        cap *= 2;
+                        *out = b;
+                    }
+                    b[n].pos = start;
+                    b[n].line = start_line;
+                    b[n].col = start_col;
+                    n++;
+                }
+            }
+            seen_item = 1;
+            continue;
+        }
+        seen_item = 1;
+
+        if (c == '(' || c == '[' || c == '{') {
+            depth++;
+        } else if (c == ')' || c == ']' || c == '}') {
+            if (--depth < 0) break;  // desbalanceado: el parser dará el error
+            if (depth == 0 && c == '}' && item == ITEM_DECL && !arrow_body)
+                item = ITEM_NONE;
+        } else if (depth == 0 && c == ';') {
+            item = ITEM_NONE;
+        } else if (depth == 0 && (c == '=' || c == '-') && in[i + 1] == '>') {
+            arrow_body = 1;
+            i++; col++;
+        }
+        i++; col++;
+    }
+    return n;
+}
+
+// ============== PARSEO POR TRAMOS ==============
+
+typedef struct {
+    DFA           *dfa;
+    const char    *input;   // archivo completo
+    int            start, end;
+    int            line, col;
+    const HulkGenericNames *generics;  // del archivo completo
+    HulkASTContext ctx;
+    HulkNode      *prog;
+    HulkLL1Stats   stats;
+    pthread_t      thread;
+    int            spawned;
+} ParseChunk;
+
+static void* parse_chunk(void *arg) {
+    ParseChunk *c = arg;
+    int len = c->end - c->start;
+    char *text = malloc((size_t)len + 1);
+    if (!text) return NULL;
+    memcpy(text, c->input + c->start, (size_t)len);
+    text[len] = '\0';
+    c->prog = hulk_rd_parse_at(&c->ctx, c->dfa, text, TOKEN_STREAM_INLINE,
+                               c->line, c->col, c->generics, &c->stats);
+    free(text);
+    return NULL;
+}
+
+// Los tramos se parsean en silencio: si alguno falla se re-parsea en
+// serie y ese parseo reporta los errores.
+static void mute_log(LogLevel level, const char *module,
+                     const char *fmt, va_list args) {
+    (void)level; (void)module; (void)fmt; (void)args;
+}
+
+// Elige cortes en las fronteras más cercanas a partes iguales en bytes.
+// Retorna la cantidad de tramos (>= 1).
+static int plan_chunks(const char *input, int len, int workers,
+                       const HulkTopBoundary *b, int nb, ParseChunk *chunks) {
+    int count = 0, next = 0;
+    chunks[0].start = 0;
+    chunks[0].line = 1;
+    chunks[0].col = 1;
+    for (int k = 1; k < workers; k++) {
+        long target = (long)len * k / workers;
+        while (next < nb && b[next].pos < target) next++;
+        if (next >= nb) break;
+        chunks[count].end = b[next].pos;
+        count++;
+        chunks[count].start = b[next].pos;
+        chunks[count].line = b[next].line;
+        chunks[count].col = b[next].col;
+        next++;
+    }
+    chunks[count].end = len;
+    count++;
+    for (int k = 0; k < count; k++) chunks[k].input = input;
+    return count;
+}
+
+HulkNode* hulk_parallel_build_ast(HulkASTContext *ctx, DFA *dfa,
+                                  const char *input, int workers) {
+    if (!ctx || !dfa || !input) return NULL;
+    if (workers <= 0) workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers > HULK_PARALLEL_MAX_WORKERS) workers = HULK_PARALLEL_MAX_WORKERS;
+    if (workers < 2)
+        return hulk_rd_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_AUTO);
+
+    HulkTopBoundary *bounds;
+    int nb = hulk_top_level_boundaries(input, &bounds);
+    ParseChunk chunks[HULK_PARALLEL_MAX_WORKERS];
+    memset(chunks, 0, sizeof(chunks));
+    int count = plan_chunks(input, (int)strlen(input), workers, bounds, nb, chunks);
+    free(bounds);
+    if (count < 2)
+        return hulk_rd_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_AUTO);
+
+    // Todo lo compartido queda construido antes de lanzar hilos: la
+    // gramática/tabla LL(1) y la tabla de transiciones del DFA.
+    hulk_ll1_ensure_grammar();
+    LexerContext warm;
+    lexer_init(&warm, dfa, input);
+
+    HulkGenericNames generics;
+    hulk_generic_names_scan(&generics, input);
+
+    ErrorHandlerFn saved = error_handler_get();
+    error_handler_set(mute_log);
+    for (int k = 0; k < count; k++) {
+        chunks[k].dfa = dfa;
+        chunks[k].generics = &generics;
+        hulk_ast_context_init(&chunks[k].ctx);
+    }
+    for (int k = 1; k < count; k++)
+        chunks[k].spawned =
+            pthread_create(&chunks[k].thread, NULL, parse_chunk, &chunks[k]) == 0;
+    parse_chunk(&chunks[0]);
+    for (int k = 1; k < count; k++) {
+        if (chunks[k].spawned) pthread_join(chunks[k].thread, NULL);
+        else parse_chunk(&chunks[k]);  // sin hilo: en este mismo
+    }
+    error_handler_set(saved);
+    hulk_generic_names_free(&generics);
+
+    int ok = 1;
+    for (int k = 0; k < count; k++)
+        if (!chunks[k].prog) ok = 0;
+
+    HulkNode *result = NULL;
+    if (ok) {
+        // Cada tramo numeró sus nodos desde 0: se corren detrás de los
+        // ids ya usados en ctx (el primer tramo de un ctx vacío no se
+        // toca) y recién después se crea el Program.
+        HulkLL1Stats total = {0, 0, 0, 0};
+        int ndecls = 0;
+        for (int k = 0; k < count && ok; k++) {
+            HulkNodeList *decls = &((ProgramNode*)chunks[k].prog)->declarations;
+            ndecls += decls->count;
+            if (ctx->node_count)
+                for (int i = 0; i < decls->count; i++)
+                    hulk_ast_shift_ids(decls->items[i], ctx->node_count);
+            total.tokens += chunks[k].stats.tokens;
+            total.symbols += chunks[k].stats.symbols;
+            total.sem_ops += chunks[k].stats.sem_ops;
+            total.lookahead_tokens += chunks[k].stats.lookahead_tokens;
+            // Las listas del tramo pasan a crecer en ctx: chunks[] muere
+            // al volver y las fases siguientes agregan (p.ej. capturas).
+            ok = hulk_ast_context_adopt(ctx, &chunks[k].ctx, chunks[k].prog);
+        }
+        ProgramNode *prog = hulk_ast_program(ctx, 1, 1);
+        hulk_node_list_reserve(&prog->declarations, ndecls);
+        for (int k = 0; k < count; k++) {
+            HulkNodeList *decls = &((ProgramNode*)chunks[k].prog)->declarations;
+            for (int i = 0; i < decls->count; i++)
+                hulk_node_list_push(&prog->declarations, decls->items[i]);
+            hulk_node_list_free(decls);
+        }
+        hulk_ll1_set_last_stats(&total);
+        result = (HulkNode*)prog;
+    }
+    for (int k = 0; k < count; k++)
+        hulk_ast_context_free(&chunks[k].ctx);
+    if (ok) return result;
+
+    // Algún tramo no parseó: el parseo en serie decide y reporta
+    return hulk_rd_build_ast_mode(ctx, dfa, input, TOKEN_STREAM_AUTO);
+}
@@ -0,0 +1,51 @@
+/*
+ * hulk_parallel_builder.h — Parseo paralelo de los ítems de nivel superior
+ *
+ * Un programa HULK es una secuencia de declaraciones (function, type,
+ * protocol, define, decor) y expresiones globales; cada ítem de nivel
+ * superior se parsea sin contexto de los anteriores. Un pre-escaneo por
+ * caracteres (sin lexer ni DFA) ubica fronteras seguras entre ítems, la
+ * entrada se reparte en tramos contiguos de ítems completos y cada hilo
+ * parsea su tramo con el descendente recursivo en su propio
+ * HulkASTContext. Los nodos se empalman en ProgramNode.declarations en
+ * orden de fuente y las arenas de los hilos pasan al contexto del caller.
+ *
+ * Si algún tramo falla, el archivo entero se vuelve a parsear en serie:
+ * el AST y los diagnósticos son siempre los del parser secuencial.
+ *
+ * Responsabilidad única (SRP): solo reparte y empalma; la gramática y las
+ * acciones son las de hulk_ll1_builder.
+ */
+
+#ifndef HULK_PARALLEL_BUILDER_H
+#define HULK_PARALLEL_BUILDER_H
+
+#include "../core/hulk_ast.h"
+#include "../../generador_analizadores_lexicos/afd.h"
+
+// Por debajo de este tamaño la fachada no reparte: crear hilos cuesta más
+// que parsear.
+#define HULK_PARALLEL_MIN_BYTES (256 * 1024)
+#define HULK_PARALLEL_MAX_WORKERS 16
+
+// Inicio de un ítem de nivel superior (offset y posición en la fuente).
+typedef struct {
+    int pos;
+    int line;
+    int col;
+} HulkTopBoundary;
+
+// Pre-escaneo: fronteras seguras de `input`, sin contar la del inicio.
+// Una frontera es una palabra clave de declaración a profundidad 0
+// (`function NOMBRE`, `type`, `protocol`, `define`, `decor`) justo tras un
+// ítem que seguro terminó: un `;` a profundidad 0, o la `}` que cierra el
+// cuerpo de una declaración sin `=>`. Ante la duda no corta. Retorna la
+// cantidad; *out (malloc, el caller lo libera) queda en orden de fuente.
+int hulk_top_level_boundaries(const char *input, HulkTopBoundary **out);
+
+// Construye el AST repartiendo los ítems entre `workers` hilos (<= 0: uno
+// por CPU). Mismo resultado que hulk_rd_build_ast.
+HulkNode* hulk_parallel_build_ast(HulkASTContext *ctx, DFA *dfa,
+                                  const char *input, int workers);
+
+#endif /* HULK_PARALLEL_BUILDER_H */
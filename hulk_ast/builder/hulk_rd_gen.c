@@ -0,0 +1,206 @@
+/*
+ * hulk_rd_gen.c — Generador del parser descendente recursivo de HULK
+ *
+ * Traduce la gramática como datos (HULK_PRODS) y la tabla LL(1) derivada
+ * de FIRST/FOLLOW a C directo: una función por no-terminal con un switch
+ * sobre el token actual, cuyos casos son las celdas de la tabla y cuyo
+ * cuerpo recorre el RHS (match de terminales, llamadas a no-terminales y
+ * las mismas acciones A_* que ejecuta el motor de tabla).
+ *
+ * Responsabilidad única (SRP): solo emite código. Consumir tokens,
+ * ejecutar acciones, el sub-parser Pratt y el lookahead local viven en
+ * el runtime de hulk_ll1_builder.c, compartido con el motor de tabla.
+ *
+ * Salida: hulk_rd_parser.c (versionado). Regenerar con `make regen-rd`
+ * tras tocar HULK_PRODS; tests/test_ll1_builder verifica que esté al día.
+ */
+
+#include "hulk_ll1_builder.h"
+#include "hulk_ll1_internal.h"
+#include "../../hulk_tokens.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Nombre C de la función de un NT: `Or'` → `rd_OrP`. */
+static void emit_fn_name(FILE *out, int nt) {
+    fputs("rd_", out);
+    for (const char *c = hulk_ll1_nt_name(nt); *c; c++)
+        fputc(*c == '\'' ? 'P' : *c, out);
+}
+
+/* Forma legible de una producción para los comentarios. */
+static void emit_prod_comment(FILE *out, int prod) {
+    int lhs, n;
+    const int *rhs = hulk_ll1_prod_rhs(prod, &lhs, &n);
+    fprintf(out, "/* %s ->", hulk_ll1_nt_name(lhs));
+    if (n == 0) fputs(" ε", out);
+    for (int k = 0; k < n; k++) {
+        int x = rhs[k];
+        if (IS_ACT(x))    fprintf(out, " @%s", hulk_ll1_action_name(x));
+        else if (IS_T(x)) fprintf(out, " %s", get_token_name(x - TBASE));
+        else              fprintf(out, " %s", hulk_ll1_nt_name(x));
+    }
+    fputs(" */", out);
+}
+
+/* La producción termina en una llamada a su propio LHS (cola recursiva
+ * por la derecha): se emite como `continue` de un bucle. */
+static int is_tail_recursive(int prod) {
+    int lhs, n;
+    const int *rhs = hulk_ll1_prod_rhs(prod, &lhs, &n);
+    return n > 0 && rhs[n - 1] == lhs;
+}
+
+/* NTs alcanzables desde Program (y desde los NTs que deriva el
+ * lookahead local). La entrada de la escalera de precedencia se sustituye
+ * por el sub-parser Pratt, que solo llama a su operando; los demás
+ * niveles de la escalera no se emiten. */
+static void mark_reachable(int nt, unsigned char *reach) {
+    if (nt < 0 || nt >= NT_COUNT || reach[nt]) return;
+    reach[nt] = 1;
+    if (nt == hulk_ll1_pratt_entry()) {
+        mark_reachable(hulk_ll1_pratt_operand(), reach);
+        return;
+    }
+    for (int p = 0; p < hulk_ll1_prod_count(); p++) {
+        int lhs, n;
+        const int *rhs = hulk_ll1_prod_rhs(p, &lhs, &n);
+        if (lhs != nt) continue;
+        for (int k = 0; k < n; k++)
+            if (IS_NT(rhs[k])) mark_reachable(rhs[k], reach);
+    }
+}
+
+static void emit_rhs(FILE *out, int prod, const char *indent, int as_loop) {
+    int lhs, n;
+    const int *rhs = hulk_ll1_prod_rhs(prod, &lhs, &n);
+    int tail = as_loop && is_tail_recursive(prod);
+    for (int k = 0; k < n - (tail ? 1 : 0); k++) {
+        int x = rhs[k];
+        fputs(indent, out);
+        if (IS_ACT(x)) {
+            fprintf(out, "hulk_rd_action(R, %d); /* @%s */\n",
+                    x, hulk_ll1_action_name(x));
+        } else if (IS_T(x)) {
+            fprintf(out, "hulk_rd_match(R, TOKEN_%s);\n", get_token_name(x - TBASE));
+        } else {
+            emit_fn_name(out, x);
+            fputs("(R);\n", out);
+        }
+    }
+    fprintf(out, "%s%s\n", indent, tail ? "continue;" : "break;");
+}
+
+static void emit_nt(FILE *out, int nt) {
+    int pratt = (nt == hulk_ll1_pratt_entry());
+
+    fputs("\n", out);
+    if (pratt)
+        fprintf(out, "/* %s: escalera de precedencia → sub-parser Pratt */\n",
+                hulk_ll1_nt_name(nt));
+    fputs("static void ", out);
+    emit_fn_name(out, nt);
+    fputs("(HulkRD *R)\n{\n", out);
+    if (pratt) {
+        fputs("    hulk_rd_pratt(R, 0);\n}\n", out);
+        return;
+    }
+
+    /* ¿alguna producción es recursiva por la derecha sobre nt? */
+    int as_loop = 0;
+    for (int p = 0; p < hulk_ll1_prod_count(); p++) {
+        int lhs;
+        hulk_ll1_prod_rhs(p, &lhs, NULL);
+        if (lhs == nt && is_tail_recursive(p)) as_loop = 1;
+    }
+    const char *ind = as_loop ? "        " : "    ";
+    const char *body = as_loop ? "            " : "        ";
+
+    fputs("    if (!hulk_rd_enter(R)) return;\n", out);
+    if (as_loop) fputs("    while (!R->had_error) {\n", out);
+    if (hulk_ll1_has_local_lookahead(nt)) {
+        if (as_loop)
+            fprintf(out, "%sif (hulk_rd_local_lookahead(R, %d)) break;\n", ind, nt);
+        else
+            fprintf(out, "%sif (hulk_rd_local_lookahead(R, %d)) { hulk_rd_leave(R); return; }\n",
+                    ind, nt);
+    }
+    fprintf(out, "%sswitch (hulk_rd_token(R)) {\n", ind);
+
+    /* Un caso por producción, con las etiquetas de sus celdas en la tabla */
+    for (int p = 0; p < hulk_ll1_prod_count(); p++) {
+        int lhs;
+        hulk_ll1_prod_rhs(p, &lhs, NULL);
+        if (lhs != nt) continue;
+        int labels = 0;
+        for (int tok = TOKEN_EOF; tok < TOKEN_ERROR; tok++) {
+            if (hulk_ll1_predict(nt, tok) != p) continue;
+            fprintf(out, "%scase TOKEN_%s:\n", ind, get_token_name(tok));
+            labels++;
+        }
+        if (!labels) continue;  /* producción sin celda (solo lookahead local) */
+        fputs(body, out);
+        emit_prod_comment(out, p);
+        fputs("\n", out);
+        emit_rhs(out, p, body, as_loop);
+    }
+    fprintf(out, "%sdefault:\n%shulk_rd_no_production(R, %d);\n%sbreak;\n",
+            ind, body, nt, body);
+    fprintf(out, "%s}\n", ind);
+    if (as_loop) fputs("        break;\n    }\n", out);
+    fputs("    hulk_rd_leave(R);\n}\n", out);
+}
+
+int hulk_rd_emit(FILE *out) {
+    if (!out) return 0;
+    unsigned char reach[NT_COUNT];
+    memset(reach, 0, sizeof(reach));
+    mark_reachable(NT_Program, reach);
+    const int *targets;
+    int ntargets = hulk_ll1_local_lookahead_targets(&targets);
+    for (int i = 0; i < ntargets; i++) mark_reachable(targets[i], reach);
+
+    fputs("/*\n"
+          " * hulk_rd_parser.c — Parser descendente recursivo de HULK (GENERADO)\n"
+          " *\n"
+          " * NO EDITAR: lo emite hulk_rd_gen.c a partir de HULK_PRODS y de la\n"
+          " * tabla LL(1) de hulk_ll1_builder.c. Regenerar con `make regen-rd`.\n"
+          " *\n"
+          " * Un no-terminal = una función con un switch sobre el token actual;\n"
+          " * las colas recursivas por la derecha (X -> … X) se emiten como bucle.\n"
+          " */\n\n"
+          "#include \"hulk_ll1_internal.h\"\n\n", out);
+
+    for (int nt = 0; nt < NT_COUNT; nt++) {
+        if (!reach[nt]) continue;
+        fputs("static void ", out);
+        emit_fn_name(out, nt);
+        fputs("(HulkRD *R);\n", out);
+    }
+    for (int nt = 0; nt < NT_COUNT; nt++)
+        if (reach[nt]) emit_nt(out, nt);
+
+    fputs("\nvoid hulk_rd_parse_nt(HulkRD *R, int nt)\n{\n    switch (nt) {\n", out);
+    for (int nt = 0; nt < NT_COUNT; nt++) {
+        if (!reach[nt]) continue;
+        fprintf(out, "    case %d: ", nt);
+        emit_fn_name(out, nt);
+        fputs("(R); break;\n", out);
+    }
+    fputs("    default: hulk_rd_no_production(R, nt); break;\n    }\n}\n", out);
+    return !ferror(out);
+}
+
+#ifdef HULK_RD_GEN_MAIN
+int main(int argc, char **argv) {
+    FILE *out = (argc > 1) ? fopen(argv[1], "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "hulk_rd_gen: no se pudo abrir %s\n", argv[1]);
+        return 1;
+    }
+    int ok = hulk_rd_emit(out);
+    if (out != stdout) fclose(out);
+    return ok ? 0 : 1;
+}
+#endif
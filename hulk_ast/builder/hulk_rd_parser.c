@@ -0,0 +1,2060 @@
+/*
+ * hulk_rd_parser.c — Parser descendente recursivo de HULK (GENERADO)
+ *
+ * NO EDITAR: lo emite hulk_rd_gen.c a partir de HULK_PRODS y de la
+ * tabla LL(1) de hulk_ll1_builder.c. Regenerar con `make regen-rd`.
+ *
+ * Un no-terminal = una función con un switch sobre el token actual;
+ * las colas recursivas por la derecha (X -> … X) se emiten como bucle.
+ */
+
+#include "hulk_ll1_internal.h"
+
+static void rd_Program(HulkRD *R);
+static void rd_TopList(HulkRD *R);
+static void rd_TopItem(HulkRD *R);
+static void rd_OptSemi(HulkRD *R);
+static void rd_StmtList(HulkRD *R);
+static void rd_TermStmt(HulkRD *R);
+static void rd_Stmt(HulkRD *R);
+static void rd_Expr(HulkRD *R);
+static void rd_Or(HulkRD *R);
+static void rd_Unary(HulkRD *R);
+static void rd_Postfix(HulkRD *R);
+static void rd_Primary(HulkRD *R);
+static void rd_Call(HulkRD *R);
+static void rd_Args(HulkRD *R);
+static void rd_ArgsP(HulkRD *R);
+static void rd_Let(HulkRD *R);
+static void rd_Bindings(HulkRD *R);
+static void rd_BindingsP(HulkRD *R);
+static void rd_Binding(HulkRD *R);
+static void rd_TypeAnn(HulkRD *R);
+static void rd_If(HulkRD *R);
+static void rd_ElifL(HulkRD *R);
+static void rd_Body(HulkRD *R);
+static void rd_While(HulkRD *R);
+static void rd_For(HulkRD *R);
+static void rd_Block(HulkRD *R);
+static void rd_VecItems(HulkRD *R);
+static void rd_VecItemsP(HulkRD *R);
+static void rd_FunctionDef(HulkRD *R);
+static void rd_Params(HulkRD *R);
+static void rd_ParamsT(HulkRD *R);
+static void rd_Param(HulkRD *R);
+static void rd_FuncBody(HulkRD *R);
+static void rd_FuncExprBody(HulkRD *R);
+static void rd_TypeDef(HulkRD *R);
+static void rd_TypeParams(HulkRD *R);
+static void rd_TypeInherit(HulkRD *R);
+static void rd_TypeBaseArgs(HulkRD *R);
+static void rd_TypeBody(HulkRD *R);
+static void rd_TypeMember(HulkRD *R);
+static void rd_TypeMemberTail(HulkRD *R);
+static void rd_AttrTail(HulkRD *R);
+static void rd_MethodBody(HulkRD *R);
+static void rd_ProtocolDef(HulkRD *R);
+static void rd_ProtoExt(HulkRD *R);
+static void rd_ProtoSigs(HulkRD *R);
+static void rd_ProtoSig(HulkRD *R);
+static void rd_DecorBlock(HulkRD *R);
+static void rd_DecorMore(HulkRD *R);
+static void rd_DecorTarget(HulkRD *R);
+static void rd_DecorItems(HulkRD *R);
+static void rd_DecorItemsT(HulkRD *R);
+static void rd_DecorItem(HulkRD *R);
+static void rd_DecorArgs(HulkRD *R);
+static void rd_DecorPrefix(HulkRD *R);
+static void rd_TypeRef(HulkRD *R);
+static void rd_TypeSuffix(HulkRD *R);
+static void rd_TypeList(HulkRD *R);
+static void rd_TypeListT(HulkRD *R);
+static void rd_NewTail(HulkRD *R);
+static void rd_ArrayTypeSuffix(HulkRD *R);
+static void rd_ArrayInit(HulkRD *R);
+static void rd_Lambda(HulkRD *R);
+static void rd_TypeArgs(HulkRD *R);
+static void rd_CallTypeArgs(HulkRD *R);
+static void rd_GenParams(HulkRD *R);
+static void rd_GenParamsT(HulkRD *R);
+
+static void rd_Program(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_EOF:
+    case TOKEN_FUNCTION:
+    case TOKEN_TYPE:
+    case TOKEN_WHILE:
+    case TOKEN_FOR:
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_DECOR:
+    case TOKEN_PROTOCOL:
+    case TOKEN_DEFINE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Program -> TopList */
+        rd_TopList(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 0);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TopList(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_FUNCTION:
+        case TOKEN_TYPE:
+        case TOKEN_WHILE:
+        case TOKEN_FOR:
+        case TOKEN_IF:
+        case TOKEN_LET:
+        case TOKEN_TRUE:
+        case TOKEN_FALSE:
+        case TOKEN_NEW:
+        case TOKEN_SELF:
+        case TOKEN_BASE:
+        case TOKEN_DECOR:
+        case TOKEN_PROTOCOL:
+        case TOKEN_DEFINE:
+        case TOKEN_LPAREN:
+        case TOKEN_LBRACE:
+        case TOKEN_LBRACKET:
+        case TOKEN_MINUS:
+        case TOKEN_NOT:
+        case TOKEN_IDENT:
+        case TOKEN_NUMBER:
+        case TOKEN_STRING:
+            /* TopList -> TopItem TopList */
+            rd_TopItem(R);
+            continue;
+        case TOKEN_EOF:
+            /* TopList -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 1);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TopItem(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 2)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_FUNCTION:
+        /* TopItem -> FunctionDef */
+        rd_FunctionDef(R);
+        break;
+    case TOKEN_DEFINE:
+        /* TopItem -> DEFINE IDENT LPAREN @SENT Params RPAREN TypeAnn FuncBody @FUNCDEF */
+        hulk_rd_match(R, TOKEN_DEFINE);
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        rd_FuncBody(R);
+        hulk_rd_action(R, 9046); /* @FUNCDEF */
+        break;
+    case TOKEN_TYPE:
+        /* TopItem -> TypeDef */
+        rd_TypeDef(R);
+        break;
+    case TOKEN_PROTOCOL:
+        /* TopItem -> ProtocolDef */
+        rd_ProtocolDef(R);
+        break;
+    case TOKEN_DECOR:
+        /* TopItem -> DecorBlock */
+        rd_DecorBlock(R);
+        break;
+    case TOKEN_LBRACE:
+        /* TopItem -> Block OptSemi */
+        rd_Block(R);
+        rd_OptSemi(R);
+        break;
+    case TOKEN_WHILE:
+    case TOKEN_FOR:
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* TopItem -> TermStmt */
+        rd_TermStmt(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 2);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_OptSemi(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_SEMICOLON:
+        /* OptSemi -> SEMICOLON */
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        break;
+    case TOKEN_EOF:
+    case TOKEN_FUNCTION:
+    case TOKEN_TYPE:
+    case TOKEN_WHILE:
+    case TOKEN_FOR:
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_DECOR:
+    case TOKEN_PROTOCOL:
+    case TOKEN_DEFINE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* OptSemi -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 3);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_StmtList(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        if (hulk_rd_local_lookahead(R, 4)) break;
+        switch (hulk_rd_token(R)) {
+        case TOKEN_WHILE:
+        case TOKEN_FOR:
+        case TOKEN_IF:
+        case TOKEN_LET:
+        case TOKEN_TRUE:
+        case TOKEN_FALSE:
+        case TOKEN_NEW:
+        case TOKEN_SELF:
+        case TOKEN_BASE:
+        case TOKEN_LPAREN:
+        case TOKEN_LBRACE:
+        case TOKEN_LBRACKET:
+        case TOKEN_MINUS:
+        case TOKEN_NOT:
+        case TOKEN_IDENT:
+        case TOKEN_NUMBER:
+        case TOKEN_STRING:
+            /* StmtList -> TermStmt StmtList */
+            rd_TermStmt(R);
+            continue;
+        case TOKEN_RBRACE:
+            /* StmtList -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 4);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TermStmt(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 5)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_WHILE:
+    case TOKEN_FOR:
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* TermStmt -> Stmt SEMICOLON */
+        rd_Stmt(R);
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        break;
+    default:
+        hulk_rd_no_production(R, 5);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Stmt(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 6)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LBRACE:
+        /* Stmt -> Block */
+        rd_Block(R);
+        break;
+    case TOKEN_WHILE:
+        /* Stmt -> While */
+        rd_While(R);
+        break;
+    case TOKEN_FOR:
+        /* Stmt -> For */
+        rd_For(R);
+        break;
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Stmt -> Expr */
+        rd_Expr(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 6);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Expr(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 7)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Expr -> Or */
+        rd_Or(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 7);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+/* Or: escalera de precedencia → sub-parser Pratt */
+static void rd_Or(HulkRD *R)
+{
+    hulk_rd_pratt(R, 0);
+}
+
+static void rd_Unary(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 22)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_MINUS:
+        /* Unary -> MINUS Unary @NEG */
+        hulk_rd_match(R, TOKEN_MINUS);
+        rd_Unary(R);
+        hulk_rd_action(R, 9022); /* @NEG */
+        break;
+    case TOKEN_NOT:
+        /* Unary -> NOT Unary @NOT */
+        hulk_rd_match(R, TOKEN_NOT);
+        rd_Unary(R);
+        hulk_rd_action(R, 9023); /* @NOT */
+        break;
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Unary -> Postfix */
+        rd_Postfix(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 22);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Postfix(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 23)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Postfix -> Primary Call */
+        rd_Primary(R);
+        rd_Call(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 23);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Primary(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 24)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_NUMBER:
+        /* Primary -> NUMBER @NUM */
+        hulk_rd_match(R, TOKEN_NUMBER);
+        hulk_rd_action(R, 9000); /* @NUM */
+        break;
+    case TOKEN_STRING:
+        /* Primary -> STRING @STR */
+        hulk_rd_match(R, TOKEN_STRING);
+        hulk_rd_action(R, 9001); /* @STR */
+        break;
+    case TOKEN_TRUE:
+        /* Primary -> TRUE @TRUE */
+        hulk_rd_match(R, TOKEN_TRUE);
+        hulk_rd_action(R, 9002); /* @TRUE */
+        break;
+    case TOKEN_FALSE:
+        /* Primary -> FALSE @FALSE */
+        hulk_rd_match(R, TOKEN_FALSE);
+        hulk_rd_action(R, 9003); /* @FALSE */
+        break;
+    case TOKEN_IDENT:
+        /* Primary -> IDENT @IDENT */
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_action(R, 9004); /* @IDENT */
+        break;
+    case TOKEN_SELF:
+        /* Primary -> SELF @SELF */
+        hulk_rd_match(R, TOKEN_SELF);
+        hulk_rd_action(R, 9005); /* @SELF */
+        break;
+    case TOKEN_IF:
+        /* Primary -> If */
+        rd_If(R);
+        break;
+    case TOKEN_LET:
+        /* Primary -> Let */
+        rd_Let(R);
+        break;
+    case TOKEN_LPAREN:
+        /* Primary -> LPAREN Expr RPAREN */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        break;
+    case TOKEN_NEW:
+        /* Primary -> NEW IDENT TypeArgs NewTail */
+        hulk_rd_match(R, TOKEN_NEW);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeArgs(R);
+        rd_NewTail(R);
+        break;
+    case TOKEN_BASE:
+        /* Primary -> BASE LPAREN @SENT Args RPAREN @BASE */
+        hulk_rd_match(R, TOKEN_BASE);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Args(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        hulk_rd_action(R, 9033); /* @BASE */
+        break;
+    case TOKEN_LBRACKET:
+        /* Primary -> LBRACKET @SENT VecItems RBRACKET @VEC */
+        hulk_rd_match(R, TOKEN_LBRACKET);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_VecItems(R);
+        hulk_rd_match(R, TOKEN_RBRACKET);
+        hulk_rd_action(R, 9044); /* @VEC */
+        break;
+    case TOKEN_LBRACE:
+        /* Primary -> LBRACE @SENT VecItems RBRACE @VEC */
+        hulk_rd_match(R, TOKEN_LBRACE);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_VecItems(R);
+        hulk_rd_match(R, TOKEN_RBRACE);
+        hulk_rd_action(R, 9044); /* @VEC */
+        break;
+    default:
+        hulk_rd_no_production(R, 24);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Call(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        if (hulk_rd_local_lookahead(R, 25)) break;
+        switch (hulk_rd_token(R)) {
+        case TOKEN_LPAREN:
+            /* Call -> LPAREN @SENT Args RPAREN @CALL Call */
+            hulk_rd_match(R, TOKEN_LPAREN);
+            hulk_rd_action(R, 9026); /* @SENT */
+            rd_Args(R);
+            hulk_rd_match(R, TOKEN_RPAREN);
+            hulk_rd_action(R, 9027); /* @CALL */
+            continue;
+        case TOKEN_LBRACKET:
+            /* Call -> LBRACKET Expr RBRACKET @INDEX Call */
+            hulk_rd_match(R, TOKEN_LBRACKET);
+            rd_Expr(R);
+            hulk_rd_match(R, TOKEN_RBRACKET);
+            hulk_rd_action(R, 9029); /* @INDEX */
+            continue;
+        case TOKEN_DOT:
+            /* Call -> DOT IDENT @MEMBER Call */
+            hulk_rd_match(R, TOKEN_DOT);
+            hulk_rd_match(R, TOKEN_IDENT);
+            hulk_rd_action(R, 9028); /* @MEMBER */
+            continue;
+        case TOKEN_AS:
+            /* Call -> AS IDENT @AS Call */
+            hulk_rd_match(R, TOKEN_AS);
+            hulk_rd_match(R, TOKEN_IDENT);
+            hulk_rd_action(R, 9024); /* @AS */
+            continue;
+        case TOKEN_ASSIGN_DESTRUCT:
+            /* Call -> ASSIGN_DESTRUCT Expr @DESTRUCT */
+            hulk_rd_match(R, TOKEN_ASSIGN_DESTRUCT);
+            rd_Expr(R);
+            hulk_rd_action(R, 9031); /* @DESTRUCT */
+            break;
+        case TOKEN_ASSIGN:
+            /* Call -> ASSIGN Expr @ASSIGN */
+            hulk_rd_match(R, TOKEN_ASSIGN);
+            rd_Expr(R);
+            hulk_rd_action(R, 9030); /* @ASSIGN */
+            break;
+        case TOKEN_WHILE:
+        case TOKEN_FOR:
+        case TOKEN_IN:
+        case TOKEN_IF:
+        case TOKEN_ELIF:
+        case TOKEN_ELSE:
+        case TOKEN_LET:
+        case TOKEN_TRUE:
+        case TOKEN_FALSE:
+        case TOKEN_NEW:
+        case TOKEN_SELF:
+        case TOKEN_BASE:
+        case TOKEN_IS:
+        case TOKEN_SEMICOLON:
+        case TOKEN_RPAREN:
+        case TOKEN_LBRACE:
+        case TOKEN_RBRACE:
+        case TOKEN_RBRACKET:
+        case TOKEN_COMMA:
+        case TOKEN_PLUS:
+        case TOKEN_MINUS:
+        case TOKEN_MULT:
+        case TOKEN_DIV:
+        case TOKEN_MOD:
+        case TOKEN_POW:
+        case TOKEN_LT:
+        case TOKEN_GT:
+        case TOKEN_LE:
+        case TOKEN_GE:
+        case TOKEN_EQ:
+        case TOKEN_NEQ:
+        case TOKEN_OR:
+        case TOKEN_AND:
+        case TOKEN_NOT:
+        case TOKEN_CONCAT:
+        case TOKEN_CONCAT_WS:
+        case TOKEN_IDENT:
+        case TOKEN_NUMBER:
+        case TOKEN_STRING:
+            /* Call -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 25);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Args(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 26)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Args -> Expr Args' */
+        rd_Expr(R);
+        rd_ArgsP(R);
+        break;
+    case TOKEN_RPAREN:
+        /* Args -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 26);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ArgsP(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* Args' -> COMMA Expr Args' */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_Expr(R);
+            continue;
+        case TOKEN_RPAREN:
+            /* Args' -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 27);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Let(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LET:
+        /* Let -> LET @SENT Bindings IN Body @LET */
+        hulk_rd_match(R, TOKEN_LET);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Bindings(R);
+        hulk_rd_match(R, TOKEN_IN);
+        rd_Body(R);
+        hulk_rd_action(R, 9034); /* @LET */
+        break;
+    default:
+        hulk_rd_no_production(R, 28);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Bindings(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_BASE:
+    case TOKEN_IDENT:
+        /* Bindings -> Binding Bindings' */
+        rd_Binding(R);
+        rd_BindingsP(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 29);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_BindingsP(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* Bindings' -> COMMA Binding Bindings' */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_Binding(R);
+            continue;
+        case TOKEN_IN:
+            /* Bindings' -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 30);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Binding(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* Binding -> IDENT TypeAnn ASSIGN Expr @BIND */
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeAnn(R);
+        hulk_rd_match(R, TOKEN_ASSIGN);
+        rd_Expr(R);
+        hulk_rd_action(R, 9035); /* @BIND */
+        break;
+    case TOKEN_BASE:
+        /* Binding -> BASE TypeAnn ASSIGN Expr @BIND */
+        hulk_rd_match(R, TOKEN_BASE);
+        rd_TypeAnn(R);
+        hulk_rd_match(R, TOKEN_ASSIGN);
+        rd_Expr(R);
+        hulk_rd_action(R, 9035); /* @BIND */
+        break;
+    default:
+        hulk_rd_no_production(R, 31);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeAnn(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_COLON:
+        /* TypeAnn -> COLON TypeRef @TYPE_NAME */
+        hulk_rd_match(R, TOKEN_COLON);
+        rd_TypeRef(R);
+        hulk_rd_action(R, 9036); /* @TYPE_NAME */
+        break;
+    case TOKEN_SEMICOLON:
+    case TOKEN_RPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_COMMA:
+    case TOKEN_ASSIGN:
+    case TOKEN_ARROW:
+        /* TypeAnn -> @TYPE_NONE */
+        hulk_rd_action(R, 9037); /* @TYPE_NONE */
+        break;
+    default:
+        hulk_rd_no_production(R, 32);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_If(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IF:
+        /* If -> IF LPAREN Expr RPAREN Body @SENT ElifL ELSE Body @IF */
+        hulk_rd_match(R, TOKEN_IF);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_Body(R);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_ElifL(R);
+        hulk_rd_match(R, TOKEN_ELSE);
+        rd_Body(R);
+        hulk_rd_action(R, 9038); /* @IF */
+        break;
+    default:
+        hulk_rd_no_production(R, 33);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ElifL(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_ELIF:
+            /* ElifL -> ELIF LPAREN Expr RPAREN Body @ELIF ElifL */
+            hulk_rd_match(R, TOKEN_ELIF);
+            hulk_rd_match(R, TOKEN_LPAREN);
+            rd_Expr(R);
+            hulk_rd_match(R, TOKEN_RPAREN);
+            rd_Body(R);
+            hulk_rd_action(R, 9039); /* @ELIF */
+            continue;
+        case TOKEN_ELSE:
+            /* ElifL -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 34);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Body(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 35)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LBRACE:
+        /* Body -> Block */
+        rd_Block(R);
+        break;
+    case TOKEN_WHILE:
+        /* Body -> While */
+        rd_While(R);
+        break;
+    case TOKEN_FOR:
+        /* Body -> For */
+        rd_For(R);
+        break;
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* Body -> Expr */
+        rd_Expr(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 35);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_While(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_WHILE:
+        /* While -> WHILE Expr Body @WHILE */
+        hulk_rd_match(R, TOKEN_WHILE);
+        rd_Expr(R);
+        rd_Body(R);
+        hulk_rd_action(R, 9040); /* @WHILE */
+        break;
+    default:
+        hulk_rd_no_production(R, 36);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_For(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_FOR:
+        /* For -> FOR LPAREN IDENT IN Expr RPAREN Body @FOR */
+        hulk_rd_match(R, TOKEN_FOR);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_match(R, TOKEN_IN);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_Body(R);
+        hulk_rd_action(R, 9041); /* @FOR */
+        break;
+    default:
+        hulk_rd_no_production(R, 37);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Block(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LBRACE:
+        /* Block -> LBRACE @BLOCK_BEGIN StmtList RBRACE @BLOCK */
+        hulk_rd_match(R, TOKEN_LBRACE);
+        hulk_rd_action(R, 9042); /* @BLOCK_BEGIN */
+        rd_StmtList(R);
+        hulk_rd_match(R, TOKEN_RBRACE);
+        hulk_rd_action(R, 9043); /* @BLOCK */
+        break;
+    default:
+        hulk_rd_no_production(R, 38);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_VecItems(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    if (hulk_rd_local_lookahead(R, 39)) { hulk_rd_leave(R); return; }
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IF:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_MINUS:
+    case TOKEN_NOT:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* VecItems -> Expr VecItems' */
+        rd_Expr(R);
+        rd_VecItemsP(R);
+        break;
+    case TOKEN_RBRACE:
+    case TOKEN_RBRACKET:
+        /* VecItems -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 39);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_VecItemsP(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* VecItems' -> COMMA Expr VecItems' */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_Expr(R);
+            continue;
+        case TOKEN_RBRACE:
+        case TOKEN_RBRACKET:
+            /* VecItems' -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 40);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_FunctionDef(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_FUNCTION:
+        /* FunctionDef -> FUNCTION IDENT GenParams LPAREN @SENT Params RPAREN TypeAnn FuncBody @FUNCDEF */
+        hulk_rd_match(R, TOKEN_FUNCTION);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_GenParams(R);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        rd_FuncBody(R);
+        hulk_rd_action(R, 9046); /* @FUNCDEF */
+        break;
+    default:
+        hulk_rd_no_production(R, 41);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Params(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_BASE:
+    case TOKEN_IDENT:
+        /* Params -> Param ParamsT */
+        rd_Param(R);
+        rd_ParamsT(R);
+        break;
+    case TOKEN_RPAREN:
+        /* Params -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 42);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ParamsT(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* ParamsT -> COMMA Param ParamsT */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_Param(R);
+            continue;
+        case TOKEN_RPAREN:
+            /* ParamsT -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 43);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Param(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* Param -> IDENT TypeAnn @PARAM */
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeAnn(R);
+        hulk_rd_action(R, 9045); /* @PARAM */
+        break;
+    case TOKEN_BASE:
+        /* Param -> BASE TypeAnn @PARAM */
+        hulk_rd_match(R, TOKEN_BASE);
+        rd_TypeAnn(R);
+        hulk_rd_action(R, 9045); /* @PARAM */
+        break;
+    default:
+        hulk_rd_no_production(R, 44);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_FuncBody(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_ARROW:
+        /* FuncBody -> ARROW Expr SEMICOLON */
+        hulk_rd_match(R, TOKEN_ARROW);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        break;
+    case TOKEN_LBRACE:
+        /* FuncBody -> Block */
+        rd_Block(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 45);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_FuncExprBody(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_ARROW:
+        /* FuncExprBody -> ARROW Expr */
+        hulk_rd_match(R, TOKEN_ARROW);
+        rd_Expr(R);
+        break;
+    case TOKEN_LBRACE:
+        /* FuncExprBody -> Block */
+        rd_Block(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 46);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeDef(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_TYPE:
+        /* TypeDef -> TYPE IDENT GenParams @TD_BEGIN TypeParams TypeInherit LBRACE TypeBody RBRACE */
+        hulk_rd_match(R, TOKEN_TYPE);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_GenParams(R);
+        hulk_rd_action(R, 9048); /* @TD_BEGIN */
+        rd_TypeParams(R);
+        rd_TypeInherit(R);
+        hulk_rd_match(R, TOKEN_LBRACE);
+        rd_TypeBody(R);
+        hulk_rd_match(R, TOKEN_RBRACE);
+        break;
+    default:
+        hulk_rd_no_production(R, 47);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeParams(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+        /* TypeParams -> LPAREN @SENT Params RPAREN @TD_PARAMS */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        hulk_rd_action(R, 9049); /* @TD_PARAMS */
+        break;
+    case TOKEN_INHERITS:
+    case TOKEN_LBRACE:
+        /* TypeParams -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 48);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeInherit(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_INHERITS:
+        /* TypeInherit -> INHERITS IDENT TypeArgs @TD_PARENT TypeBaseArgs */
+        hulk_rd_match(R, TOKEN_INHERITS);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeArgs(R);
+        hulk_rd_action(R, 9050); /* @TD_PARENT */
+        rd_TypeBaseArgs(R);
+        break;
+    case TOKEN_LBRACE:
+        /* TypeInherit -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 49);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeBaseArgs(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+        /* TypeBaseArgs -> LPAREN @SENT Args RPAREN @TD_PARGS */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Args(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        hulk_rd_action(R, 9051); /* @TD_PARGS */
+        break;
+    case TOKEN_LBRACE:
+        /* TypeBaseArgs -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 50);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeBody(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_BASE:
+        case TOKEN_DECOR:
+        case TOKEN_IDENT:
+            /* TypeBody -> TypeMember TypeBody */
+            rd_TypeMember(R);
+            continue;
+        case TOKEN_RBRACE:
+            /* TypeBody -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 51);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeMember(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_DECOR:
+    case TOKEN_IDENT:
+        /* TypeMember -> @SENT DecorPrefix IDENT TypeMemberTail */
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_DecorPrefix(R);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeMemberTail(R);
+        break;
+    case TOKEN_BASE:
+        /* TypeMember -> @SENT DecorPrefix BASE TypeMemberTail */
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_DecorPrefix(R);
+        hulk_rd_match(R, TOKEN_BASE);
+        rd_TypeMemberTail(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 52);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeMemberTail(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+        /* TypeMemberTail -> LPAREN @SENT Params RPAREN TypeAnn MethodBody @METHOD */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        rd_MethodBody(R);
+        hulk_rd_action(R, 9052); /* @METHOD */
+        break;
+    case TOKEN_SEMICOLON:
+    case TOKEN_COLON:
+    case TOKEN_ASSIGN:
+        /* TypeMemberTail -> TypeAnn AttrTail */
+        rd_TypeAnn(R);
+        rd_AttrTail(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 53);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_AttrTail(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_ASSIGN:
+        /* AttrTail -> ASSIGN Expr SEMICOLON @ATTR */
+        hulk_rd_match(R, TOKEN_ASSIGN);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        hulk_rd_action(R, 9053); /* @ATTR */
+        break;
+    case TOKEN_SEMICOLON:
+        /* AttrTail -> SEMICOLON @ATTR_NOINIT */
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        hulk_rd_action(R, 9054); /* @ATTR_NOINIT */
+        break;
+    default:
+        hulk_rd_no_production(R, 54);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_MethodBody(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_ARROW:
+        /* MethodBody -> ARROW Expr SEMICOLON */
+        hulk_rd_match(R, TOKEN_ARROW);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        break;
+    case TOKEN_LBRACE:
+        /* MethodBody -> Block */
+        rd_Block(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 55);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ProtocolDef(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_PROTOCOL:
+        /* ProtocolDef -> PROTOCOL IDENT GenParams @PROTO_BEGIN ProtoExt LBRACE ProtoSigs RBRACE */
+        hulk_rd_match(R, TOKEN_PROTOCOL);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_GenParams(R);
+        hulk_rd_action(R, 9055); /* @PROTO_BEGIN */
+        rd_ProtoExt(R);
+        hulk_rd_match(R, TOKEN_LBRACE);
+        rd_ProtoSigs(R);
+        hulk_rd_match(R, TOKEN_RBRACE);
+        break;
+    default:
+        hulk_rd_no_production(R, 56);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ProtoExt(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_EXTENDS:
+        /* ProtoExt -> EXTENDS IDENT TypeArgs @TD_PARENT */
+        hulk_rd_match(R, TOKEN_EXTENDS);
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeArgs(R);
+        hulk_rd_action(R, 9050); /* @TD_PARENT */
+        break;
+    case TOKEN_LBRACE:
+        /* ProtoExt -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 57);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ProtoSigs(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_IDENT:
+            /* ProtoSigs -> ProtoSig ProtoSigs */
+            rd_ProtoSig(R);
+            continue;
+        case TOKEN_RBRACE:
+            /* ProtoSigs -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 58);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ProtoSig(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* ProtoSig -> IDENT LPAREN @SENT Params RPAREN TypeAnn SEMICOLON @PROTO_METHOD */
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        hulk_rd_match(R, TOKEN_SEMICOLON);
+        hulk_rd_action(R, 9056); /* @PROTO_METHOD */
+        break;
+    default:
+        hulk_rd_no_production(R, 59);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorBlock(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_DECOR:
+        /* DecorBlock -> DECOR @SENT DecorItems DecorMore DecorTarget @DECOR_BLOCK */
+        hulk_rd_match(R, TOKEN_DECOR);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_DecorItems(R);
+        rd_DecorMore(R);
+        rd_DecorTarget(R);
+        hulk_rd_action(R, 9058); /* @DECOR_BLOCK */
+        break;
+    default:
+        hulk_rd_no_production(R, 60);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorMore(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_DECOR:
+            /* DecorMore -> DECOR DecorItems DecorMore */
+            hulk_rd_match(R, TOKEN_DECOR);
+            rd_DecorItems(R);
+            continue;
+        case TOKEN_FUNCTION:
+        case TOKEN_TYPE:
+            /* DecorMore -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 61);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorTarget(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_FUNCTION:
+        /* DecorTarget -> FunctionDef */
+        rd_FunctionDef(R);
+        break;
+    case TOKEN_TYPE:
+        /* DecorTarget -> TypeDef */
+        rd_TypeDef(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 62);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorItems(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* DecorItems -> DecorItem DecorItemsT */
+        rd_DecorItem(R);
+        rd_DecorItemsT(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 63);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorItemsT(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* DecorItemsT -> COMMA DecorItem DecorItemsT */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_DecorItem(R);
+            continue;
+        case TOKEN_FUNCTION:
+        case TOKEN_TYPE:
+        case TOKEN_BASE:
+        case TOKEN_DECOR:
+        case TOKEN_IDENT:
+            /* DecorItemsT -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 64);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorItem(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* DecorItem -> IDENT @SENT DecorArgs @DECOR_ITEM */
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_DecorArgs(R);
+        hulk_rd_action(R, 9057); /* @DECOR_ITEM */
+        break;
+    default:
+        hulk_rd_no_production(R, 65);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorArgs(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+        /* DecorArgs -> LPAREN Args RPAREN */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        rd_Args(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        break;
+    case TOKEN_FUNCTION:
+    case TOKEN_TYPE:
+    case TOKEN_BASE:
+    case TOKEN_DECOR:
+    case TOKEN_COMMA:
+    case TOKEN_IDENT:
+        /* DecorArgs -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 66);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_DecorPrefix(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_DECOR:
+            /* DecorPrefix -> DECOR DecorItems DecorPrefix */
+            hulk_rd_match(R, TOKEN_DECOR);
+            rd_DecorItems(R);
+            continue;
+        case TOKEN_BASE:
+        case TOKEN_IDENT:
+            /* DecorPrefix -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 67);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeRef(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_IDENT:
+        /* TypeRef -> IDENT TypeArgs TypeSuffix */
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_TypeArgs(R);
+        rd_TypeSuffix(R);
+        break;
+    case TOKEN_LPAREN:
+        /* TypeRef -> LPAREN @SENT TypeList RPAREN ARROW TypeRef @TYPE_FUNC TypeSuffix */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_TypeList(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        hulk_rd_match(R, TOKEN_ARROW);
+        rd_TypeRef(R);
+        hulk_rd_action(R, 9059); /* @TYPE_FUNC */
+        rd_TypeSuffix(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 68);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeSuffix(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_LBRACKET:
+            /* TypeSuffix -> LBRACKET RBRACKET @TYPE_ARRAY TypeSuffix */
+            hulk_rd_match(R, TOKEN_LBRACKET);
+            hulk_rd_match(R, TOKEN_RBRACKET);
+            hulk_rd_action(R, 9060); /* @TYPE_ARRAY */
+            continue;
+        case TOKEN_MULT:
+            /* TypeSuffix -> MULT @TYPE_ITER TypeSuffix */
+            hulk_rd_match(R, TOKEN_MULT);
+            hulk_rd_action(R, 9061); /* @TYPE_ITER */
+            continue;
+        case TOKEN_SEMICOLON:
+        case TOKEN_RPAREN:
+        case TOKEN_LBRACE:
+        case TOKEN_COMMA:
+        case TOKEN_ASSIGN:
+        case TOKEN_GT:
+        case TOKEN_ARROW:
+            /* TypeSuffix -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 69);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeList(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+    case TOKEN_IDENT:
+        /* TypeList -> TypeRef TypeListT */
+        rd_TypeRef(R);
+        rd_TypeListT(R);
+        break;
+    case TOKEN_RPAREN:
+        /* TypeList -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 70);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeListT(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* TypeListT -> COMMA TypeRef TypeListT */
+            hulk_rd_match(R, TOKEN_COMMA);
+            rd_TypeRef(R);
+            continue;
+        case TOKEN_RPAREN:
+        case TOKEN_GT:
+            /* TypeListT -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 71);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_NewTail(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LPAREN:
+        /* NewTail -> LPAREN @SENT Args RPAREN @NEW */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Args(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        hulk_rd_action(R, 9032); /* @NEW */
+        break;
+    case TOKEN_LBRACKET:
+        /* NewTail -> ArrayTypeSuffix LBRACKET Expr RBRACKET @ARRAY_NEW ArrayInit */
+        rd_ArrayTypeSuffix(R);
+        hulk_rd_match(R, TOKEN_LBRACKET);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_RBRACKET);
+        hulk_rd_action(R, 9062); /* @ARRAY_NEW */
+        rd_ArrayInit(R);
+        break;
+    default:
+        hulk_rd_no_production(R, 72);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ArrayTypeSuffix(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        if (hulk_rd_local_lookahead(R, 73)) break;
+        switch (hulk_rd_token(R)) {
+        case TOKEN_LBRACKET:
+            /* ArrayTypeSuffix -> LBRACKET RBRACKET ArrayTypeSuffix */
+            hulk_rd_match(R, TOKEN_LBRACKET);
+            hulk_rd_match(R, TOKEN_RBRACKET);
+            continue;
+        default:
+            hulk_rd_no_production(R, 73);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_ArrayInit(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LBRACE:
+        /* ArrayInit -> LBRACE IDENT ARROW Expr RBRACE @ARRAY_INIT */
+        hulk_rd_match(R, TOKEN_LBRACE);
+        hulk_rd_match(R, TOKEN_IDENT);
+        hulk_rd_match(R, TOKEN_ARROW);
+        rd_Expr(R);
+        hulk_rd_match(R, TOKEN_RBRACE);
+        hulk_rd_action(R, 9063); /* @ARRAY_INIT */
+        break;
+    case TOKEN_WHILE:
+    case TOKEN_FOR:
+    case TOKEN_IN:
+    case TOKEN_IF:
+    case TOKEN_ELIF:
+    case TOKEN_ELSE:
+    case TOKEN_LET:
+    case TOKEN_TRUE:
+    case TOKEN_FALSE:
+    case TOKEN_NEW:
+    case TOKEN_SELF:
+    case TOKEN_BASE:
+    case TOKEN_AS:
+    case TOKEN_IS:
+    case TOKEN_SEMICOLON:
+    case TOKEN_LPAREN:
+    case TOKEN_RPAREN:
+    case TOKEN_RBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_RBRACKET:
+    case TOKEN_COMMA:
+    case TOKEN_DOT:
+    case TOKEN_ASSIGN:
+    case TOKEN_ASSIGN_DESTRUCT:
+    case TOKEN_PLUS:
+    case TOKEN_MINUS:
+    case TOKEN_MULT:
+    case TOKEN_DIV:
+    case TOKEN_MOD:
+    case TOKEN_POW:
+    case TOKEN_LT:
+    case TOKEN_GT:
+    case TOKEN_LE:
+    case TOKEN_GE:
+    case TOKEN_EQ:
+    case TOKEN_NEQ:
+    case TOKEN_OR:
+    case TOKEN_AND:
+    case TOKEN_NOT:
+    case TOKEN_CONCAT:
+    case TOKEN_CONCAT_WS:
+    case TOKEN_IDENT:
+    case TOKEN_NUMBER:
+    case TOKEN_STRING:
+        /* ArrayInit -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 74);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_Lambda(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_FUNCTION:
+        /* Lambda -> FUNCTION LPAREN @SENT Params RPAREN TypeAnn FuncExprBody @FUNCEXPR */
+        hulk_rd_match(R, TOKEN_FUNCTION);
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        rd_FuncExprBody(R);
+        hulk_rd_action(R, 9047); /* @FUNCEXPR */
+        break;
+    case TOKEN_LPAREN:
+        /* Lambda -> LPAREN @SENT Params RPAREN TypeAnn FuncExprBody @FUNCEXPR */
+        hulk_rd_match(R, TOKEN_LPAREN);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_Params(R);
+        hulk_rd_match(R, TOKEN_RPAREN);
+        rd_TypeAnn(R);
+        rd_FuncExprBody(R);
+        hulk_rd_action(R, 9047); /* @FUNCEXPR */
+        break;
+    default:
+        hulk_rd_no_production(R, 75);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_TypeArgs(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LT:
+        /* TypeArgs -> LT @SENT TypeRef TypeListT GT @TYPE_ARGS */
+        hulk_rd_match(R, TOKEN_LT);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_TypeRef(R);
+        rd_TypeListT(R);
+        hulk_rd_match(R, TOKEN_GT);
+        hulk_rd_action(R, 9064); /* @TYPE_ARGS */
+        break;
+    case TOKEN_SEMICOLON:
+    case TOKEN_LPAREN:
+    case TOKEN_RPAREN:
+    case TOKEN_LBRACE:
+    case TOKEN_LBRACKET:
+    case TOKEN_COMMA:
+    case TOKEN_ASSIGN:
+    case TOKEN_MULT:
+    case TOKEN_GT:
+    case TOKEN_ARROW:
+        /* TypeArgs -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 76);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_CallTypeArgs(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LT:
+        /* CallTypeArgs -> LT @SENT TypeRef TypeListT GT @CALL_TYPE_ARGS */
+        hulk_rd_match(R, TOKEN_LT);
+        hulk_rd_action(R, 9026); /* @SENT */
+        rd_TypeRef(R);
+        rd_TypeListT(R);
+        hulk_rd_match(R, TOKEN_GT);
+        hulk_rd_action(R, 9065); /* @CALL_TYPE_ARGS */
+        break;
+    default:
+        hulk_rd_no_production(R, 77);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_GenParams(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    switch (hulk_rd_token(R)) {
+    case TOKEN_LT:
+        /* GenParams -> LT @SENT IDENT GenParamsT GT @TYPE_ARGS */
+        hulk_rd_match(R, TOKEN_LT);
+        hulk_rd_action(R, 9026); /* @SENT */
+        hulk_rd_match(R, TOKEN_IDENT);
+        rd_GenParamsT(R);
+        hulk_rd_match(R, TOKEN_GT);
+        hulk_rd_action(R, 9064); /* @TYPE_ARGS */
+        break;
+    case TOKEN_INHERITS:
+    case TOKEN_EXTENDS:
+    case TOKEN_LPAREN:
+    case TOKEN_LBRACE:
+        /* GenParams -> ε */
+        break;
+    default:
+        hulk_rd_no_production(R, 78);
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+static void rd_GenParamsT(HulkRD *R)
+{
+    if (!hulk_rd_enter(R)) return;
+    while (!R->had_error) {
+        switch (hulk_rd_token(R)) {
+        case TOKEN_COMMA:
+            /* GenParamsT -> COMMA IDENT GenParamsT */
+            hulk_rd_match(R, TOKEN_COMMA);
+            hulk_rd_match(R, TOKEN_IDENT);
+            continue;
+        case TOKEN_GT:
+            /* GenParamsT -> ε */
+            break;
+        default:
+            hulk_rd_no_production(R, 79);
+            break;
+        }
+        break;
+    }
+    hulk_rd_leave(R);
+}
+
+void hulk_rd_parse_nt(HulkRD *R, int nt)
+{
+    switch (nt) {
+    case 0: rd_Program(R); break;
+    case 1: rd_TopList(R); break;
+    case 2: rd_TopItem(R); break;
+    case 3: rd_OptSemi(R); break;
+    case 4: rd_StmtList(R); break;
+    case 5: rd_TermStmt(R); break;
+    case 6: rd_Stmt(R); break;
+    case 7: rd_Expr(R); break;
+    case 8: rd_Or(R); break;
+    case 22: rd_Unary(R); break;
+    case 23: rd_Postfix(R); break;
+    case 24: rd_Primary(R); break;
+    case 25: rd_Call(R); break;
+    case 26: rd_Args(R); break;
+    case 27: rd_ArgsP(R); break;
+    case 28: rd_Let(R); break;
+    case 29: rd_Bindings(R); break;
+    case 30: rd_BindingsP(R); break;
+    case 31: rd_Binding(R); break;
+    case 32: rd_TypeAnn(R); break;
+    case 33: rd_If(R); break;
+    case 34: rd_ElifL(R); break;
+    case 35: rd_Body(R); break;
+    case 36: rd_While(R); break;
+    case 37: rd_For(R); break;
+    case 38: rd_Block(R); break;
+    case 39: rd_VecItems(R); break;
+    case 40: rd_VecItemsP(R); break;
+    case 41: rd_FunctionDef(R); break;
+    case 42: rd_Params(R); break;
+    case 43: rd_ParamsT(R); break;
+    case 44: rd_Param(R); break;
+    case 45: rd_FuncBody(R); break;
+    case 46: rd_FuncExprBody(R); break;
+    case 47: rd_TypeDef(R); break;
+    case 48: rd_TypeParams(R); break;
+    case 49: rd_TypeInherit(R); break;
+    case 50: rd_TypeBaseArgs(R); break;
+    case 51: rd_TypeBody(R); break;
+    case 52: rd_TypeMember(R); break;
+    case 53: rd_TypeMemberTail(R); break;
+    case 54: rd_AttrTail(R); break;
+    case 55: rd_MethodBody(R); break;
+    case 56: rd_ProtocolDef(R); break;
+    case 57: rd_ProtoExt(R); break;
+    case 58: rd_ProtoSigs(R); break;
+    case 59: rd_ProtoSig(R); break;
+    case 60: rd_DecorBlock(R); break;
+    case 61: rd_DecorMore(R); break;
+    case 62: rd_DecorTarget(R); break;
+    case 63: rd_DecorItems(R); break;
+    case 64: rd_DecorItemsT(R); break;
+    case 65: rd_DecorItem(R); break;
+    case 66: rd_DecorArgs(R); break;
+    case 67: rd_DecorPrefix(R); break;
+    case 68: rd_TypeRef(R); break;
+    case 69: rd_TypeSuffix(R); break;
+    case 70: rd_TypeList(R); break;
+    case 71: rd_TypeListT(R); break;
+    case 72: rd_NewTail(R); break;
+    case 73: rd_ArrayTypeSuffix(R); break;
+    case 74: rd_ArrayInit(R); break;
+    case 75: rd_Lambda(R); break;
+    case 76: rd_TypeArgs(R); break;
+    case 77: rd_CallTypeArgs(R); break;
+    case 78: rd_GenParams(R); break;
+    case 79: rd_GenParamsT(R); break;
+    default: hulk_rd_no_production(R, nt); break;
+    }
+}
@@ -7,7 +7,8 @@
  *   3. Define helpers del runtime HULK (print, concat, conversiones)
  *   4. Llama a cg_emit_program() para emitir el programa completo
  *   5. Verifica el módulo con LLVMVerifyModule
- *   6. Escribe el IR a archivo .ll (o compila a ejecutable)
+ *   6. Optimiza según el nivel pedido (hulk_codegen_target.c)
+ *   7. Escribe el IR a archivo .ll (o compila a ejecutable)
  *
  * SRP: Solo orquestación de la pipeline de codegen.
  */
@@ -22,9 +23,18 @@
  *  hulk_codegen — API pública: generar archivo .ll
  * ============================================================ */
 
+static const HulkCodegenOptions NO_OPTS = { HULK_OPT_DEFAULT, 0, 0 };
+
 int hulk_codegen(HulkNode *program, const char *out_file) {
+    return hulk_codegen_opts(program, out_file, NULL);
+}
+
+int hulk_codegen_opts(HulkNode *program, const char *out_file,
+                      const HulkCodegenOptions *opts) {
+    if (!opts) opts = &NO_OPTS;
     CodegenContext c;
     memset(&c, 0, sizeof(c));
+    hulk_ast_context_init(&c.arena);
 
     /* Crear contexto LLVM */
     c.llvm_ctx = LLVMContextCreate();
@@ -33,8 +43,12 @@ int hulk_codegen(HulkNode *program, const char *out_file) {
 
     /* Inicializar tipos básicos, scopes */
     cg_types_init(&c);
+    hulk_side_init(&c.static_types, sizeof(CGTypeInfo*));
+    hulk_side_init(&c.bindings, sizeof(CGSymbol*));
+    hulk_side_init(&c.live, sizeof(char));
     c.global  = cg_scope_create(&c, NULL);
     c.current = c.global;
+    c.no_attrs = opts->no_attrs;
 
     /* Declarar runtime */
     cg_declare_runtime(&c);
@@ -64,6 +78,17 @@ int hulk_codegen(HulkNode *program, const char *out_file) {
     }
     if (error_msg) LLVMDisposeMessage(error_msg);
 
+    /* Optimizar: hace falta la máquina destino (triple, data layout) */
+    if (opts->level > HULK_OPT_O0) {
+        LLVMTargetMachineRef tm = cg_target_machine(&c, opts);
+        int failed = !tm || cg_optimize(&c, tm, opts);
+        if (tm) LLVMDisposeTargetMachine(tm);
+        if (failed) {
+            cg_context_free(&c);
+            return 1;
+        }
+    }
+
     /* Escribir IR */
     if (out_file) {
         char *ir = LLVMPrintModuleToString(c.module);
@@ -92,16 +117,27 @@ int hulk_codegen(HulkNode *program, const char *out_file) {
  * ============================================================ */
 
 int hulk_codegen_to_executable(HulkNode *program, const char *out_file) {
+    return hulk_codegen_to_executable_opts(program, out_file, NULL);
+}
+
+int hulk_codegen_to_executable_opts(HulkNode *program, const char *out_file,
+                                    const HulkCodegenOptions *opts) {
+    if (!opts) opts = &NO_OPTS;
     CodegenContext c;
     memset(&c, 0, sizeof(c));
+    hulk_ast_context_init(&c.arena);
 
     c.llvm_ctx = LLVMContextCreate();
     c.module   = LLVMModuleCreateWithNameInContext("hulk_module", c.llvm_ctx);
     c.builder  = LLVMCreateBuilderInContext(c.llvm_ctx);
 
     cg_types_init(&c);
+    hulk_side_init(&c.static_types, sizeof(CGTypeInfo*));
+    hulk_side_init(&c.bindings, sizeof(CGSymbol*));
+    hulk_side_init(&c.live, sizeof(char));
     c.global  = cg_scope_create(&c, NULL);
     c.current = c.global;
+    c.no_attrs = opts->no_attrs;
 
     cg_declare_runtime(&c);
     cg_define_runtime_helpers(&c);
@@ -118,38 +154,19 @@ int hulk_codegen_to_executable(HulkNode *program, const char *out_file) {
     }
     if (error_msg) LLVMDisposeMessage(error_msg);
 
-    /* Inicializar targets */
-    LLVMInitializeNativeTarget();
-    LLVMInitializeNativeAsmPrinter();
-    LLVMInitializeNativeAsmParser();
-
-    /* Obtener target triple */
-    char *triple = LLVMGetDefaultTargetTriple();
-    LLVMSetTarget(c.module, triple);
-
-    LLVMTargetRef target;
-    char *err = NULL;
-    if (LLVMGetTargetFromTriple(triple, &target, &err)) {
-        fprintf(stderr, "[CODEGEN ERROR] Target not found: %s\n", err);
-        LLVMDisposeMessage(err);
-        LLVMDisposeMessage(triple);
+    /* Máquina destino y optimización */
+    LLVMTargetMachineRef tm = cg_target_machine(&c, opts);
+    if (!tm || cg_optimize(&c, tm, opts)) {
+        if (tm) LLVMDisposeTargetMachine(tm);
         cg_context_free(&c);
         return 1;
     }
-    if (err) LLVMDisposeMessage(err);
-
-    LLVMTargetMachineRef tm = LLVMCreateTargetMachine(
-        target, triple, "generic", "",
-        LLVMCodeGenLevelDefault,
-        LLVMRelocPIC,           /* PIC para que el .o linkee con cc PIE */
-        LLVMCodeModelDefault);
-    LLVMDisposeMessage(triple);
 
     /* Emitir .o temporal */
     char obj_path[512];
     snprintf(obj_path, sizeof(obj_path), "%s.o", out_file);
 
-    err = NULL;
+    char *err = NULL;
     if (LLVMTargetMachineEmitToFile(tm, c.module, obj_path,
                                      LLVMObjectFile, &err)) {
         fprintf(stderr, "[CODEGEN ERROR] Emit object failed: %s\n", err);
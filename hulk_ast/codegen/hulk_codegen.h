@@ -19,6 +19,25 @@
 
 #include "../core/hulk_ast.h"
 
+/* Nivel de optimización: el pipeline estándar de LLVM de ese nivel
+ * (default<O1>...) sobre el IR, y el nivel equivalente del backend. */
+typedef enum {
+    HULK_OPT_DEFAULT,  // sin flag: IR sin optimizar, backend en su nivel Default
+    HULK_OPT_O0,       // IR tal como sale del codegen, backend sin optimizar
+    HULK_OPT_O1,
+    HULK_OPT_O2,
+    HULK_OPT_O3,
+    HULK_OPT_OS,   // O2 cuidando el tamaño
+} HulkOptLevel;
+
+// Cero-inicializado: sin nivel pedido, para un CPU genérico del triple
+// del host (lo mismo que ./hulk sin flags).
+typedef struct {
+    HulkOptLevel level;
+    int          native;   // -march=native: CPU y extensiones del host
+    int          no_attrs; // sin atributos de efectos (para medir su aporte)
+} HulkCodegenOptions;
+
 /*
  * Genera LLVM IR a partir del AST y lo escribe al archivo indicado.
  *
@@ -39,4 +58,20 @@ int hulk_codegen(HulkNode *program, const char *out_file);
  */
 int hulk_codegen_to_executable(HulkNode *program, const char *out_file);
 
+/*
+ * Igual que las anteriores con nivel de optimización y CPU destino;
+ * opts NULL equivale a las opciones en cero. Desde -O1 el .ll también
+ * lleva el triple y el data layout del destino, que el optimizador usa.
+ */
+int hulk_codegen_opts(HulkNode *program, const char *out_file,
+                      const HulkCodegenOptions *opts);
+int hulk_codegen_to_executable_opts(HulkNode *program, const char *out_file,
+                                    const HulkCodegenOptions *opts);
+
+/*
+ * Reconoce "-O0".."-O3", "-Os" y "-march=native" (o "-march=generic")
+ * y actualiza opts. Retorna 1 si `arg` era una de esas opciones.
+ */
+int hulk_codegen_parse_option(HulkCodegenOptions *opts, const char *arg);
+
 #endif /* HULK_CODEGEN_H */
@@ -0,0 +1,145 @@
+/*
+ * hulk_codegen_attrs.c — Atributos de LLVM según los efectos
+ *
+ * Traduce la clasificación de hulk_effects a atributos de función, de
+ * retorno y de sitio de llamada, para que el optimizador pueda reusar,
+ * sacar de bucles o borrar llamadas:
+ *
+ *   NONE        memory(none)   (readnone antes de LLVM 16)
+ *   READ        memory(read)   (readonly)
+ *   ALLOC, ANY  (sin atributo de memoria)
+ *   terminates  willreturn
+ *   fresh       noalias en el retorno (si es un puntero)
+ *
+ * Todo lo que emite el codegen es nounwind: HULK no tiene excepciones y
+ * el runtime de C no desenrolla la pila.
+ *
+ * Las llamadas a funciones globales pasan por la celda del closure (una
+ * llamada indirecta), así que los atributos se repiten en el sitio de
+ * la llamada cuando se sabe a qué función llega.
+ *
+ * El runtime lleva los suyos: las de libm y hulk_log no tocan memoria
+ * (HULK no lee errno); hulk_concat, hulk_concat_ws y hulk_num_to_str
+ * solo leen sus argumentos y escriben el buffer que reservan, como
+ * strdup en las bibliotecas de LLVM.
+ *
+ * SRP: solo agrega atributos; qué efectos tiene cada cosa lo decide el
+ * análisis.
+ */
+
+#include "hulk_codegen_internal.h"
+
+static LLVMAttributeRef attr(CodegenContext *c, const char *name) {
+    unsigned kind = LLVMGetEnumAttributeKindForName(name, strlen(name));
+    return kind ? LLVMCreateEnumAttribute(c->llvm_ctx, kind, 0) : NULL;
+}
+
+/* Efecto sobre la memoria. Desde LLVM 16 es memory(...): un entero con
+ * dos bits (lee, escribe) por lugar (argumentos, memoria inaccesible,
+ * el resto); antes, un atributo por combinación (`legacy`). */
+#define MEM_REF             1u
+#define MEM_MODREF          3u
+#define MEM_ARG(x)          (x)
+#define MEM_INACCESSIBLE(x) ((x) << 2)
+#define MEM_OTHER(x)        ((x) << 4)
+
+static LLVMAttributeRef memory_attr(CodegenContext *c, unsigned bits,
+                                    const char *legacy) {
+    unsigned kind = LLVMGetEnumAttributeKindForName("memory", 6);
+    return kind ? LLVMCreateEnumAttribute(c->llvm_ctx, kind, bits)
+                : attr(c, legacy);
+}
+
+static void add(LLVMValueRef fn, LLVMAttributeIndex idx, LLVMAttributeRef a) {
+    if (a) LLVMAddAttributeAtIndex(fn, idx, a);
+}
+
+/* Atributos de función (`fn_attrs`) y de retorno (`ret_attrs`) para
+ * `e`, terminados en NULL. */
+static void attrs_for(CodegenContext *c, const HulkEffectInfo *e,
+                      int ret_is_ptr, LLVMAttributeRef fn_attrs[4],
+                      LLVMAttributeRef ret_attrs[2]) {
+    LLVMAttributeRef want[3] = { attr(c, "nounwind"), NULL, NULL };
+    if (e->effect == HULK_EFFECT_NONE)
+        want[1] = memory_attr(c, 0, "readnone");
+    else if (e->effect == HULK_EFFECT_READ)
+        want[1] = memory_attr(c, MEM_ARG(MEM_REF) | MEM_INACCESSIBLE(MEM_REF) |
+                                 MEM_OTHER(MEM_REF), "readonly");
+    if (e->terminates) want[2] = attr(c, "willreturn");
+    int n = 0;
+    for (int i = 0; i < 3; i++)
+        if (want[i]) fn_attrs[n++] = want[i];
+    fn_attrs[n] = NULL;
+    ret_attrs[0] = e->fresh && ret_is_ptr ? attr(c, "noalias") : NULL;
+    ret_attrs[1] = NULL;
+}
+
+static int returns_pointer(LLVMTypeRef fn_type) {
+    return LLVMGetTypeKind(LLVMGetReturnType(fn_type)) == LLVMPointerTypeKind;
+}
+
+void cg_attrs_function(CodegenContext *c, LLVMValueRef fn, HulkNode *decl) {
+    const HulkEffectInfo *e = fn ? hulk_effects_of(&c->effects, decl) : NULL;
+    if (!e) return;
+    LLVMAttributeRef fn_attrs[4], ret_attrs[2];
+    attrs_for(c, e, returns_pointer(LLVMGlobalGetValueType(fn)), fn_attrs, ret_attrs);
+    for (int i = 0; fn_attrs[i]; i++)
+        LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, fn_attrs[i]);
+    for (int i = 0; ret_attrs[i]; i++)
+        LLVMAddAttributeAtIndex(fn, LLVMAttributeReturnIndex, ret_attrs[i]);
+}
+
+void cg_attrs_call(CodegenContext *c, LLVMValueRef call, HulkNode *decl) {
+    const HulkEffectInfo *e = call ? hulk_effects_of_call(&c->effects, decl) : NULL;
+    if (!e) return;
+    LLVMAttributeRef fn_attrs[4], ret_attrs[2];
+    attrs_for(c, e, LLVMGetTypeKind(LLVMTypeOf(call)) == LLVMPointerTypeKind,
+              fn_attrs, ret_attrs);
+    for (int i = 0; fn_attrs[i]; i++)
+        LLVMAddCallSiteAttribute(call, LLVMAttributeFunctionIndex, fn_attrs[i]);
+    for (int i = 0; ret_attrs[i]; i++)
+        LLVMAddCallSiteAttribute(call, LLVMAttributeReturnIndex, ret_attrs[i]);
+}
+
+void cg_attrs_runtime(CodegenContext *c) {
+    if (c->no_attrs) return;
+    LLVMValueRef pure[] = {
+        c->fn_sqrt, c->fn_sin, c->fn_cos, c->fn_exp, c->fn_log,
+        c->fn_pow, c->fn_fmod, LLVMGetNamedFunction(c->module, "hulk_log"),
+        c->fn_hulk_bool_to_str,
+    };
+    for (size_t i = 0; i < sizeof(pure) / sizeof(pure[0]); i++) {
+        if (!pure[i]) continue;
+        add(pure[i], LLVMAttributeFunctionIndex, attr(c, "nounwind"));
+        add(pure[i], LLVMAttributeFunctionIndex, memory_attr(c, 0, "readnone"));
+        add(pure[i], LLVMAttributeFunctionIndex, attr(c, "willreturn"));
+    }
+    /* "true" o "false": constantes */
+    add(c->fn_hulk_bool_to_str, LLVMAttributeReturnIndex, attr(c, "nonnull"));
+
+    LLVMValueRef alloc[] = {
+        c->fn_hulk_concat, c->fn_hulk_concat_ws, c->fn_hulk_num_to_str,
+    };
+    for (size_t i = 0; i < sizeof(alloc) / sizeof(alloc[0]); i++) {
+        LLVMValueRef fn = alloc[i];
+        if (!fn) continue;
+        add(fn, LLVMAttributeFunctionIndex, attr(c, "nounwind"));
+        add(fn, LLVMAttributeFunctionIndex, attr(c, "willreturn"));
+        add(fn, LLVMAttributeFunctionIndex,
+            memory_attr(c, MEM_ARG(MEM_REF) | MEM_INACCESSIBLE(MEM_MODREF),
+                        "inaccessiblemem_or_argmemonly"));
+        add(fn, LLVMAttributeReturnIndex, attr(c, "noalias"));
+        for (unsigned p = 0; p < LLVMCountParams(fn); p++) {
+            if (LLVMGetTypeKind(LLVMTypeOf(LLVMGetParam(fn, p))) != LLVMPointerTypeKind)
+                continue;
+            add(fn, p + 1, attr(c, "nocapture"));
+            add(fn, p + 1, attr(c, "readonly"));
+        }
+    }
+
+    LLVMValueRef print[] = {
+        c->fn_hulk_print, c->fn_hulk_print_str, c->fn_hulk_print_bool,
+    };
+    for (size_t i = 0; i < sizeof(print) / sizeof(print[0]); i++)
+        if (print[i]) add(print[i], LLVMAttributeFunctionIndex, attr(c, "nounwind"));
+}
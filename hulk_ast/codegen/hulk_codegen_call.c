@@ -280,7 +280,7 @@ LLVMValueRef cg_emit_call(CodegenContext *c, CallExprNode *n) {
             return emit_array_init(c, size, fn);
         }
 
-        CGSymbol *sym = cg_lookup(c->current, id->name);
+        CGSymbol *sym = cg_resolve_ident(c, id);
         if (!sym) {
             cg_error(c, (HulkNode*)n, "función '%s' no definida", id->name);
             return LLVMConstReal(c->t_double, 0.0);
@@ -304,6 +304,7 @@ LLVMValueRef cg_emit_call(CodegenContext *c, CallExprNode *n) {
                 : cg_llvm_type_for_name(c, n->base.static_type);
             LLVMValueRef result = cg_emit_call_closure_raw(
                 c, closure, argv, argt, argc, ret_t, "fn.call");
+            cg_attrs_call(c, result, sym->decl);
             free(argv);
             free(argt);
             return result;
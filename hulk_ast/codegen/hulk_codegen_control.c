@@ -68,6 +68,7 @@ LLVMValueRef cg_emit_let(CodegenContext *c, LetExprNode *n) {
             LLVMTypeRef fn_type = LLVMGlobalGetValueType(init_val);
             CGSymbol *vsym = cg_define(c, vb->name, init_val, fn_type, 1);
             if (vsym) vsym->hulk_type = binding_ti;
+            cg_bind_decl(c, vsym, (HulkNode*)vb);
             continue;
         }
 
@@ -76,6 +77,7 @@ LLVMValueRef cg_emit_let(CodegenContext *c, LetExprNode *n) {
         LLVMBuildStore(c->builder, init_val, alloca);
         CGSymbol *vsym = cg_define(c, vb->name, alloca, val_type, 0);
         if (vsym) vsym->hulk_type = binding_ti;
+        cg_bind_decl(c, vsym, (HulkNode*)vb);
     }
 
     LLVMValueRef result = cg_emit_expr(c, n->body);
@@ -266,7 +268,8 @@ LLVMValueRef cg_emit_for(CodegenContext *c, ForStmtNode *n) {
                                                            n->var_name);
             LLVMBuildStore(c->builder, LLVMConstReal(c->t_double, 0.0),
                            loop_var);
-            cg_define(c, n->var_name, loop_var, c->t_double, 0);
+            cg_bind_decl(c, cg_define(c, n->var_name, loop_var,
+                                      c->t_double, 0), (HulkNode*)n);
 
             LLVMValueRef fn = c->current_fn;
             LLVMBasicBlockRef cond_bb = LLVMAppendBasicBlockInContext(
@@ -309,7 +312,8 @@ LLVMValueRef cg_emit_for(CodegenContext *c, ForStmtNode *n) {
 
     LLVMValueRef counter = cg_create_entry_alloca(c, c->t_double, n->var_name);
     LLVMBuildStore(c->builder, start_val, counter);
-    cg_define(c, n->var_name, counter, c->t_double, 0);
+    cg_bind_decl(c, cg_define(c, n->var_name, counter, c->t_double, 0),
+                 (HulkNode*)n);
 
     LLVMValueRef fn = c->current_fn;
     LLVMBasicBlockRef cond_bb = LLVMAppendBasicBlockInContext(
@@ -54,136 +54,6 @@ static void name_list_add(NameList *l, const char *name) {
     l->names[l->count++] = name;
 }
 
-static void collect_lambda_captures(CodegenContext *c, HulkNode *node,
-                                    NameList *params, NameList *out) {
-    if (!node) return;
-    switch (node->type) {
-        case NODE_IDENT: {
-            const char *name = ((IdentNode*)node)->name;
-            if (!name_list_contains(params, name) && cg_lookup(c->current, name))
-                name_list_add(out, name);
-            return;
-        }
-        case NODE_FUNCTION_EXPR: {
-            /* Una lambda anidada captura por su cuenta, pero la lambda
-             * exterior debe conservar cualquier variable externa que esa
-             * lambda interior vaya a necesitar cuando se construya. */
-            FunctionExprNode *fn = (FunctionExprNode*)node;
-            NameList nested = *params;
-            nested.names = NULL; nested.count = 0; nested.cap = 0;
-            for (int i = 0; i < params->count; i++)
-                name_list_add(&nested, params->names[i]);
-            for (int i = 0; i < fn->params.count; i++) {
-                VarBindingNode *p = (VarBindingNode*)fn->params.items[i];
-                name_list_add(&nested, p->name);
-            }
-            collect_lambda_captures(c, fn->body, &nested, out);
-            free(nested.names);
-            return;
-        }
-        case NODE_BINARY_OP: {
-            BinaryOpNode *b = (BinaryOpNode*)node;
-            collect_lambda_captures(c, b->left, params, out);
-            collect_lambda_captures(c, b->right, params, out);
-            return;
-        }
-        case NODE_CONCAT_EXPR: {
-            ConcatExprNode *ce = (ConcatExprNode*)node;
-            collect_lambda_captures(c, ce->left, params, out);
-            collect_lambda_captures(c, ce->right, params, out);
-            return;
-        }
-        case NODE_UNARY_OP:
-            collect_lambda_captures(c, ((UnaryOpNode*)node)->operand, params, out);
-            return;
-        case NODE_CALL_EXPR: {
-            CallExprNode *ce = (CallExprNode*)node;
-            collect_lambda_captures(c, ce->callee, params, out);
-            for (int i = 0; i < ce->args.count; i++)
-                collect_lambda_captures(c, ce->args.items[i], params, out);
-            return;
-        }
-        case NODE_MEMBER_ACCESS:
-            collect_lambda_captures(c, ((MemberAccessNode*)node)->object, params, out);
-            return;
-        case NODE_INDEX_EXPR: {
-            IndexExprNode *ix = (IndexExprNode*)node;
-            collect_lambda_captures(c, ix->object, params, out);
-            collect_lambda_captures(c, ix->index, params, out);
-            return;
-        }
-        case NODE_ASSIGN: {
-            AssignNode *a = (AssignNode*)node;
-            collect_lambda_captures(c, a->target, params, out);
-            collect_lambda_captures(c, a->value, params, out);
-            return;
-        }
-        case NODE_DESTRUCT_ASSIGN: {
-            DestructAssignNode *d = (DestructAssignNode*)node;
-            collect_lambda_captures(c, d->target, params, out);
-            collect_lambda_captures(c, d->value, params, out);
-            return;
-        }
-        case NODE_LET_EXPR: {
-            LetExprNode *l = (LetExprNode*)node;
-            NameList nested = *params;
-            nested.names = NULL; nested.count = 0; nested.cap = 0;
-            for (int i = 0; i < params->count; i++) name_list_add(&nested, params->names[i]);
-            for (int i = 0; i < l->bindings.count; i++) {
-                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
-                collect_lambda_captures(c, vb->init_expr, &nested, out);
-                name_list_add(&nested, vb->name);
-            }
-            collect_lambda_captures(c, l->body, &nested, out);
-            free(nested.names);
-            return;
-        }
-        case NODE_IF_EXPR: {
-            IfExprNode *iff = (IfExprNode*)node;
-            collect_lambda_captures(c, iff->condition, params, out);
-            collect_lambda_captures(c, iff->then_body, params, out);
-            for (int i = 0; i < iff->elifs.count; i++) {
-                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                collect_lambda_captures(c, e->condition, params, out);
-                collect_lambda_captures(c, e->body, params, out);
-            }
-            collect_lambda_captures(c, iff->else_body, params, out);
-            return;
-        }
-        case NODE_BLOCK_STMT: {
-            BlockStmtNode *b = (BlockStmtNode*)node;
-            for (int i = 0; i < b->statements.count; i++)
-                collect_lambda_captures(c, b->statements.items[i], params, out);
-            return;
-        }
-        case NODE_WHILE_STMT: {
-            WhileStmtNode *w = (WhileStmtNode*)node;
-            collect_lambda_captures(c, w->condition, params, out);
-            collect_lambda_captures(c, w->body, params, out);
-            return;
-        }
-        case NODE_FOR_STMT: {
-            ForStmtNode *f = (ForStmtNode*)node;
-            collect_lambda_captures(c, f->iterable, params, out);
-            NameList nested = *params;
-            nested.names = NULL; nested.count = 0; nested.cap = 0;
-            for (int i = 0; i < params->count; i++) name_list_add(&nested, params->names[i]);
-            name_list_add(&nested, f->var_name);
-            collect_lambda_captures(c, f->body, &nested, out);
-            free(nested.names);
-            return;
-        }
-        case NODE_VECTOR_LIT: {
-            VectorLitNode *v = (VectorLitNode*)node;
-            for (int i = 0; i < v->items.count; i++)
-                collect_lambda_captures(c, v->items.items[i], params, out);
-            return;
-        }
-        default:
-            return;
-    }
-}
-
 LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
     if (!node) return LLVMConstReal(c->t_double, 0.0);
 
@@ -229,16 +99,20 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
                 LLVMValueRef global;
                 LLVMTypeRef type;
             } CaptureBinding;
-            NameList params = {0}, cap_names = {0};
-            for (int i = 0; i < argc; i++) {
-                VarBindingNode *p = (VarBindingNode*)fn_n->params.items[i];
-                name_list_add(&params, p->name);
-            }
+            NameList cap_names = {0};
             for (int i = 0; i < fn_n->captures.count; i++) {
                 IdentNode *cap = (IdentNode*)fn_n->captures.items[i];
                 if (cap) name_list_add(&cap_names, cap->name);
             }
-            collect_lambda_captures(c, fn_n->body, &params, &cap_names);
+            /* Variables libres del cuerpo (incluye las que necesiten
+             * lambdas anidadas al construirse) que existen en el scope
+             * actual. */
+            int free_count = 0;
+            const char *const *free_vars =
+                hulk_facts_free_vars(&c->facts, fn_n, &free_count);
+            for (int i = 0; i < free_count; i++)
+                if (cg_lookup(c->current, free_vars[i]))
+                    name_list_add(&cap_names, free_vars[i]);
 
             CaptureBinding *caps = NULL;
             int cap_count = cap_names.count;
@@ -284,8 +158,13 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
             LLVMPositionBuilderAtEnd(c->builder, entry);
 
             CGScope *saved_scope_for_lambda = c->current;
+            CGSymbol **saved_captures = c->captures;
+            int saved_capture_count = c->capture_count;
             c->current = c->global;
             cg_push_scope(c);
+            c->captures = cap_count > 0 ? calloc(cap_count, sizeof(CGSymbol*))
+                                        : NULL;
+            c->capture_count = c->captures ? cap_count : 0;
             LLVMValueRef env = LLVMGetParam(fn, 0);
             for (int i = 0; i < argc; i++) {
                 VarBindingNode *p = (VarBindingNode*)fn_n->params.items[i];
@@ -293,7 +172,8 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
                 LLVMTypeRef pt = LLVMTypeOf(pv);
                 LLVMValueRef alloca = cg_create_entry_alloca(c, pt, p->name);
                 LLVMBuildStore(c->builder, pv, alloca);
-                cg_define(c, p->name, alloca, pt, 0);
+                cg_bind_decl(c, cg_define(c, p->name, alloca, pt, 0),
+                             (HulkNode*)p);
             }
             for (int i = 0; i < cap_count; i++) {
                 if (caps && caps[i].name) {
@@ -306,7 +186,9 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
                     LLVMValueRef alloca = cg_create_entry_alloca(c, caps[i].type,
                                                                   caps[i].name);
                     LLVMBuildStore(c->builder, cap_loaded, alloca);
-                    cg_define(c, caps[i].name, alloca, caps[i].type, 0);
+                    CGSymbol *csym = cg_define(c, caps[i].name, alloca,
+                                               caps[i].type, 0);
+                    if (c->captures) c->captures[i] = csym;
                 }
             }
 
@@ -318,11 +200,13 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
             }
             cg_pop_scope(c);
             c->current = saved_scope_for_lambda;
+            free(c->captures);
+            c->captures = saved_captures;
+            c->capture_count = saved_capture_count;
 
             c->current_fn = saved_fn;
             if (saved_bb) LLVMPositionBuilderAtEnd(c->builder, saved_bb);
             free(caps);
-            free(params.names);
             free(cap_names.names);
             free(ptypes);
             return closure;
@@ -542,7 +426,7 @@ LLVMValueRef cg_emit_expr(CodegenContext *c, HulkNode *node) {
 }
 
 static LLVMValueRef emit_ident(CodegenContext *c, IdentNode *n) {
-    CGSymbol *sym = cg_lookup(c->current, n->name);
+    CGSymbol *sym = cg_resolve_ident(c, n);
     if (!sym) {
         cg_error(c, (HulkNode*)n, "variable '%s' no definida", n->name);
         return LLVMConstReal(c->t_double, 0.0);
@@ -107,68 +107,6 @@ LLVMTypeRef cg_infer_param_type(CodegenContext *c, const char *ann) {
     return c->t_i8ptr;
 }
 
-static int self_member_used_as_string(HulkNode *n, const char *member) {
-    if (!n) return 0;
-    switch (n->type) {
-        case NODE_CONCAT_EXPR: {
-            ConcatExprNode *ce = (ConcatExprNode*)n;
-            if (ce->left && ce->left->type == NODE_MEMBER_ACCESS) {
-                MemberAccessNode *ma = (MemberAccessNode*)ce->left;
-                if (ma->object && ma->object->type == NODE_SELF &&
-                    ma->member && strcmp(ma->member, member) == 0)
-                    return 1;
-            }
-            if (ce->right && ce->right->type == NODE_MEMBER_ACCESS) {
-                MemberAccessNode *ma = (MemberAccessNode*)ce->right;
-                if (ma->object && ma->object->type == NODE_SELF &&
-                    ma->member && strcmp(ma->member, member) == 0)
-                    return 1;
-            }
-            return self_member_used_as_string(ce->left, member) ||
-                   self_member_used_as_string(ce->right, member);
-        }
-        case NODE_BINARY_OP: {
-            BinaryOpNode *b = (BinaryOpNode*)n;
-            return self_member_used_as_string(b->left, member) ||
-                   self_member_used_as_string(b->right, member);
-        }
-        case NODE_IF_EXPR: {
-            IfExprNode *iff = (IfExprNode*)n;
-            if (self_member_used_as_string(iff->condition, member)) return 1;
-            if (self_member_used_as_string(iff->then_body, member)) return 1;
-            for (int i = 0; i < iff->elifs.count; i++) {
-                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                if (self_member_used_as_string(e->condition, member)) return 1;
-                if (self_member_used_as_string(e->body, member)) return 1;
-            }
-            return self_member_used_as_string(iff->else_body, member);
-        }
-        case NODE_BLOCK_STMT: {
-            BlockStmtNode *b = (BlockStmtNode*)n;
-            for (int i = 0; i < b->statements.count; i++)
-                if (self_member_used_as_string(b->statements.items[i], member))
-                    return 1;
-            return 0;
-        }
-        case NODE_LET_EXPR: {
-            LetExprNode *l = (LetExprNode*)n;
-            for (int i = 0; i < l->bindings.count; i++) {
-                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
-                if (self_member_used_as_string(vb->init_expr, member)) return 1;
-            }
-            return self_member_used_as_string(l->body, member);
-        }
-        case NODE_CALL_EXPR: {
-            CallExprNode *ce = (CallExprNode*)n;
-            for (int i = 0; i < ce->args.count; i++)
-                if (self_member_used_as_string(ce->args.items[i], member))
-                    return 1;
-            return 0;
-        }
-        default: return 0;
-    }
-}
-
 /* Recolector: registra en c->str_hints cada (tipo, idx) tal que algún
  * `new T(...)` del programa pasa un StringLit como argumento idx-ésimo.
  * Recorrido único del AST — esto es lo que hace la inferencia O(n). */
@@ -309,11 +247,14 @@ static int hint_has_string(CodegenContext *c, const char *type_name, int idx) {
 LLVMTypeRef cg_infer_ctor_param_type(CodegenContext *c,
                                           TypeDefNode *td,
                                           const char *param_name) {
-    /* Heurística 1: si self.param se usa en concat → String. */
+    /* Heurística 1: si self.param se usa en concat → String. Los hechos
+     * de cada método se juntan una vez (c->facts), no por parámetro. */
     for (int i = 0; i < td->members.count; i++) {
         HulkNode *m = td->members.items[i];
         if (m->type != NODE_METHOD_DEF) continue;
-        if (self_member_used_as_string(((MethodDefNode*)m)->body, param_name))
+        const HulkNameFacts *f = hulk_facts_name(
+            &c->facts, ((MethodDefNode*)m)->body, param_name);
+        if (f && f->self_concat)
             return c->t_i8ptr;
     }
     /* Heurística 2: si el param se pasa como parent_arg i-ésimo a un
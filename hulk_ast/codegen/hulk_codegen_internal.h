@@ -12,6 +12,10 @@
 #define HULK_CODEGEN_INTERNAL_H
 
 #include "../core/hulk_ast.h"
+#include "../core/hulk_ast_facts.h"
+#include "../core/hulk_ast_side.h"
+#include "../core/hulk_effects.h"
+#include "../core/hulk_name_index.h"
 #include "hulk_codegen.h"
 #include "../../error_handler.h"
 
@@ -43,15 +47,18 @@ typedef struct CGSymbol_s {
     LLVMValueRef   adapter_fn;    /* closure adapter: (env, args...) -> ret */
     LLVMTypeRef    adapter_type;
     int            adapter_emitted;
+    HulkNode      *decl;      /* declaración ligada (cg_bind_decl) o NULL */
 } CGSymbol;
 
 typedef struct CGScope_s CGScope;
 
 struct CGScope_s {
-    CGScope    *parent;
+    CGScope    *parent;   /* en la lista de libres: el siguiente libre */
     CGSymbol  **symbols;
     int         sym_count;
     int         sym_cap;
+    HulkNameIndex index;  /* nombre → posición en symbols (scopes grandes) */
+    CGScope    *next;     /* siguiente creado por el contexto */
 };
 
 /* ============================================================
@@ -66,6 +73,7 @@ struct CGTypeInfo_s {
     int           field_count;        /* total: 1 (tag) + heredados + propios */
     int           field_offset_self;  /* índice donde empiezan los propios */
     const char  **field_names;        /* tamaño = field_count */
+    HulkNameIndex field_index;        /* nombre → índice de campo */
     LLVMTypeRef  *field_types_arr;    /* tamaño = field_count */
     int           type_tag;       /* tag numérico único para RTTI */
     /* Métodos definidos por este tipo (no incluye heredados):
@@ -73,8 +81,12 @@ struct CGTypeInfo_s {
     CGSymbol    **methods;
     int           method_count;
     int           method_cap;
+    HulkNameIndex method_index;   /* nombre → posición en methods */
     /* Herencia: tipo padre (NULL si no tiene) */
     CGTypeInfo   *parent;
+    /* Intervalo DFS en la jerarquía (cg_type_index_hierarchy); 0 si el
+     * tipo no estaba registrado al indexar */
+    int           pre, post;
     /* Vtable global: arreglo de punteros a método, indexado por slot
      * global (compartido entre tipos). Si NULL todavía no se emitió. */
     LLVMValueRef  vtable_global;
@@ -105,15 +117,19 @@ typedef struct {
     CGScope          *current;
     CGScope          *global;
 
-    /* Registro de scopes para cleanup */
-    CGScope         **all_scopes;
-    int               scope_count;
-    int               scope_cap;
+    /* Arena de la fase: scopes, símbolos y type infos (con sus
+     * arreglos) se liberan juntos en cg_context_free. Los scopes de
+     * bloque cerrados vuelven a `free_scopes` y se reusan. */
+    HulkASTContext    arena;
+    CGScope          *scopes;       /* creados (sus índices van aparte) */
+    CGScope          *free_scopes;
+    int               scope_count;  /* creados, sin contar los reusados */
 
     /* Registro de tipos de usuario */
     CGTypeInfo      **type_infos;
     int               type_info_count;
     int               type_info_cap;
+    HulkNameIndex     type_info_index;
 
     /* Slots globales de método: cada nombre único en todo el programa
      * tiene un slot fijo. La vtable de cada tipo es un array
@@ -121,6 +137,7 @@ typedef struct {
     const char      **method_slot_names;
     int               method_slot_count;
     int               method_slot_cap;
+    HulkNameIndex     method_slot_index;
 
     /* Globales emitidos para RTTI dinámico:
      *  - vtables_table: array [num_tipos x ptr] indexado por type_tag,
@@ -147,6 +164,32 @@ typedef struct {
     int               str_hints_cap;
     int               str_hints_built;     /* 0 hasta la primera consulta */
 
+    /* Hechos sintácticos por cuerpo (self.x en @, variables libres de
+     * lambdas), juntados en una pasada por cuerpo a pedido */
+    HulkFacts         facts;
+
+    /* CGTypeInfo* de cada expresión ya resuelta por cg_static_type_of
+     * (tabla lateral por id de nodo) */
+    HulkSideTable     static_types;
+
+    /* Resolución de nombres sin buscar: cada declaración (VarBinding,
+     * For, FunctionDef, TypeDef) → CGSymbol* vivo de su activación
+     * actual, y las capturas de la lambda que se está emitiendo en el
+     * orden de FunctionExprNode.captures. Ver cg_resolve_ident. */
+    HulkSideTable     bindings;
+    CGSymbol        **captures;
+    int               capture_count;
+
+    /* Declaraciones vivas (funciones, tipos, métodos) según
+     * cg_reach_program; `shaken` en 0 si no se analizó: todo vive */
+    HulkSideTable     live;
+    int               shaken;
+
+    /* Efectos de funciones, métodos y constructores (hulk_effects), de
+     * donde salen sus atributos de LLVM; vacío si no se analizó */
+    HulkEffects       effects;
+    int               no_attrs;            /* HulkCodegenOptions.no_attrs */
+
     /* Built-in runtime functions */
     LLVMValueRef      fn_printf;
     LLVMValueRef      fn_snprintf;
@@ -181,6 +224,11 @@ typedef struct {
  *  Scope  (hulk_codegen_types.c)
  * ============================================================ */
 
+/* Bloque en cero de la arena de la fase; vive hasta cg_context_free. */
+static inline void* cg_alloc(CodegenContext *c, size_t size) {
+    return hulk_ast_alloc(&c->arena, size);
+}
+
 CGScope*   cg_scope_create(CodegenContext *c, CGScope *parent);
 void       cg_push_scope(CodegenContext *c);
 void       cg_pop_scope(CodegenContext *c);
@@ -190,6 +238,12 @@ CGSymbol*  cg_define_in(CodegenContext *c, CGScope *scope, const char *name,
                         LLVMValueRef val, LLVMTypeRef type, int is_func);
 CGSymbol*  cg_lookup(CGScope *scope, const char *name);
 CGSymbol*  cg_lookup_local(CGScope *scope, const char *name);
+/* Liga `sym` a la declaración del AST que lo introdujo, hasta que se
+ * cierre su scope. */
+void       cg_bind_decl(CodegenContext *c, CGSymbol *sym, HulkNode *decl);
+/* Símbolo de un uso de nombre: por la resolución que anotó el semántico
+ * (IdentNode.binding) si la declaración está viva; si no, por nombre. */
+CGSymbol*  cg_resolve_ident(CodegenContext *c, IdentNode *n);
 
 /* ============================================================
  *  Type info  (hulk_codegen_types.c)
@@ -198,8 +252,9 @@ CGSymbol*  cg_lookup_local(CGScope *scope, const char *name);
 CGTypeInfo* cg_type_info_create(CodegenContext *c, const char *name);
 CGTypeInfo* cg_type_info_find(CodegenContext *c, const char *name);
 CGTypeInfo* cg_type_info_find_by_tag(CodegenContext *c, int tag);
-void        cg_type_add_method(CGTypeInfo *ti, const char *name,
-                               LLVMValueRef fn);
+void        cg_type_index_hierarchy(CodegenContext *c);
+void        cg_type_add_method(CodegenContext *c, CGTypeInfo *ti,
+                               const char *name, LLVMValueRef fn);
 /* Devuelve la implementación del método 'name' caminando la cadena
  * de herencia (propio primero, luego ancestros). NULL si ninguno define. */
 LLVMValueRef cg_type_resolve_method(CGTypeInfo *ti, const char *name);
@@ -219,6 +274,18 @@ int          cg_method_slot(CodegenContext *c, const char *name);
 void cg_types_init(CodegenContext *c);
 void cg_context_free(CodegenContext *c);
 
+/* ============================================================
+ *  Destino y optimización  (hulk_codegen_target.c)
+ * ============================================================ */
+
+/* Máquina destino de `opts`; fija el triple y el data layout del
+ * módulo. NULL (con el error ya escrito) si el destino no existe. */
+LLVMTargetMachineRef cg_target_machine(CodegenContext *c,
+                                       const HulkCodegenOptions *opts);
+/* Corre el pipeline del nivel de `opts` sobre el módulo. 0 si anduvo. */
+int  cg_optimize(CodegenContext *c, LLVMTargetMachineRef tm,
+                 const HulkCodegenOptions *opts);
+
 /* ============================================================
  *  Runtime  (hulk_codegen.c)
  * ============================================================ */
@@ -269,6 +336,18 @@ LLVMValueRef cg_emit_block(CodegenContext *c, BlockStmtNode *n);
 
 void cg_emit_program(CodegenContext *c, HulkNode *program);
 
+/* Tree shaking  (hulk_codegen_reach.c): marca lo alcanzable desde las
+ * expresiones globales; lo demás no se emite. */
+void cg_reach_program(CodegenContext *c, ProgramNode *prog);
+int  cg_is_live(CodegenContext *c, HulkNode *decl);
+
+/* Atributos de LLVM según los efectos  (hulk_codegen_attrs.c) */
+void cg_attrs_runtime(CodegenContext *c);
+/* `fn` ejecuta `decl` (FunctionDef, MethodDef, o TypeDef para T_new). */
+void cg_attrs_function(CodegenContext *c, LLVMValueRef fn, HulkNode *decl);
+/* `call` llama por nombre a la función global `decl`. */
+void cg_attrs_call(CodegenContext *c, LLVMValueRef call, HulkNode *decl);
+
 /* Tipos de usuario: layout, constructor, métodos, vtables/RTTI
  * (hulk_codegen_typedecl.c) */
 void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n);
@@ -8,11 +8,21 @@
  * del dispatch de métodos y del acceso a campos.
  */
 #include "hulk_codegen_internal.h"
+#include "../core/hulk_hierarchy.h"
+
+#define TI_CONTAINS(a, b) \
+    HULK_HIERARCHY_CONTAINS((a)->pre, (a)->post, (b)->pre, (b)->post)
 
 static CGTypeInfo* cg_type_lca(CGTypeInfo *a, CGTypeInfo *b) {
     if (!a) return b;
     if (!b) return a;
     if (a == b) return a;
+    if (a->pre && b->pre) {
+        /* Indexados: el primer ancestro de a (inclusive) que contiene a b */
+        for (CGTypeInfo *t = a; t; t = t->parent)
+            if (TI_CONTAINS(t, b)) return t;
+        return NULL;
+    }
     /* Si a desciende de b */
     for (CGTypeInfo *t = a; t; t = t->parent)
         if (t == b) return b;
@@ -27,9 +37,15 @@ static CGTypeInfo* cg_type_lca(CGTypeInfo *a, CGTypeInfo *b) {
     return NULL;
 }
 
-CGTypeInfo* cg_static_type_of(CodegenContext *c, HulkNode *expr) {
-    if (!expr) return NULL;
+/* Deriva el tipo de `expr` (los hijos pasan por type_of, así que
+ * también quedan memoizados). Pone *stable en 0 si la respuesta depende
+ * del scope o del tipo que se está emitiendo (Ident/Self por la vía
+ * sintáctica): esa no se guarda. El registro de tipos ya está completo
+ * (pasada 1 de cg_emit_program) antes de la primera consulta. */
+static CGTypeInfo* type_of(CodegenContext *c, HulkNode *expr, int *stable);
 
+static CGTypeInfo* derive_type(CodegenContext *c, HulkNode *expr,
+                               int *stable) {
     /* Camino canónico: el análisis semántico ya anotó el nodo con el
      * nombre de su tipo estático. Si nombra un tipo de usuario conocido,
      * esa es la respuesta autoritativa (el semántico ya resolvió join de
@@ -43,10 +59,11 @@ CGTypeInfo* cg_static_type_of(CodegenContext *c, HulkNode *expr) {
      * anotado es primitivo/función (sin CGTypeInfo asociado). */
     switch (expr->type) {
         case NODE_SELF:
+            *stable = 0;
             return c->enclosing_type;
         case NODE_IDENT: {
-            IdentNode *id = (IdentNode*)expr;
-            CGSymbol *sym = cg_lookup(c->current, id->name);
+            CGSymbol *sym = cg_resolve_ident(c, (IdentNode*)expr);
+            *stable = 0;
             return sym ? sym->hulk_type : NULL;
         }
         case NODE_NEW_EXPR: {
@@ -59,27 +76,49 @@ CGTypeInfo* cg_static_type_of(CodegenContext *c, HulkNode *expr) {
         }
         case NODE_IF_EXPR: {
             IfExprNode *iff = (IfExprNode*)expr;
-            CGTypeInfo *agg = cg_static_type_of(c, iff->then_body);
+            CGTypeInfo *agg = type_of(c, iff->then_body, stable);
             for (int i = 0; i < iff->elifs.count; i++) {
                 ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                agg = cg_type_lca(agg, cg_static_type_of(c, e->body));
+                agg = cg_type_lca(agg, type_of(c, e->body, stable));
             }
             if (iff->else_body)
-                agg = cg_type_lca(agg, cg_static_type_of(c, iff->else_body));
+                agg = cg_type_lca(agg, type_of(c, iff->else_body, stable));
             return agg;
         }
         case NODE_BLOCK_STMT: {
             BlockStmtNode *b = (BlockStmtNode*)expr;
             if (b->statements.count == 0) return NULL;
-            return cg_static_type_of(c,
-                b->statements.items[b->statements.count - 1]);
+            return type_of(c, b->statements.items[b->statements.count - 1],
+                           stable);
         }
         case NODE_LET_EXPR:
-            return cg_static_type_of(c, ((LetExprNode*)expr)->body);
+            return type_of(c, ((LetExprNode*)expr)->body, stable);
         default: return NULL;
     }
 }
 
+/* Consulta memoizada en c->static_types (tabla lateral por id de nodo):
+ * cada nodo se deriva una vez aunque lo pidan varios ancestros. */
+static CGTypeInfo* type_of(CodegenContext *c, HulkNode *expr, int *stable) {
+    if (!expr) return NULL;
+    CGTypeInfo **memo = hulk_side_get(&c->static_types, expr);
+    if (memo) return *memo;
+    int mine = 1;
+    CGTypeInfo *ti = derive_type(c, expr, &mine);
+    if (mine) {
+        memo = hulk_side_put(&c->static_types, expr);
+        if (memo) *memo = ti;
+    } else {
+        *stable = 0;
+    }
+    return ti;
+}
+
+CGTypeInfo* cg_static_type_of(CodegenContext *c, HulkNode *expr) {
+    int stable = 1;
+    return type_of(c, expr, &stable);
+}
+
 LLVMValueRef cg_emit_member_access(CodegenContext *c, MemberAccessNode *n) {
     LLVMValueRef obj = cg_emit_expr(c, n->object);
 
@@ -92,18 +131,17 @@ LLVMValueRef cg_emit_member_access(CodegenContext *c, MemberAccessNode *n) {
      * fields del padre al inicio, ti->field_names tiene todos. */
     if (ti) {
         for (CGTypeInfo *cur = ti; cur; cur = cur->parent) {
-            for (int f = 0; f < cur->field_count; f++) {
-                if (strcmp(cur->field_names[f], n->member) == 0) {
-                    LLVMValueRef target_obj = obj;
-                    if (cur != ti)
-                        target_obj = LLVMBuildBitCast(c->builder, obj,
-                                                      cur->ptr_type, "upcast");
-                    LLVMValueRef gep = LLVMBuildStructGEP2(
-                        c->builder, cur->struct_type, target_obj, f, n->member);
-                    LLVMTypeRef field_t = LLVMStructGetTypeAtIndex(
-                        cur->struct_type, f);
-                    return LLVMBuildLoad2(c->builder, field_t, gep, "field");
-                }
+            int f = cg_type_field_index(cur, n->member);
+            if (f >= 0) {
+                LLVMValueRef target_obj = obj;
+                if (cur != ti)
+                    target_obj = LLVMBuildBitCast(c->builder, obj,
+                                                  cur->ptr_type, "upcast");
+                LLVMValueRef gep = LLVMBuildStructGEP2(
+                    c->builder, cur->struct_type, target_obj, f, n->member);
+                LLVMTypeRef field_t = LLVMStructGetTypeAtIndex(
+                    cur->struct_type, f);
+                return LLVMBuildLoad2(c->builder, field_t, gep, "field");
             }
         }
     }
@@ -160,7 +198,7 @@ LLVMValueRef cg_emit_assign(CodegenContext *c, AssignNode *n) {
     LLVMValueRef val = cg_emit_expr(c, n->value);
     if (n->target->type == NODE_IDENT) {
         IdentNode *id = (IdentNode*)n->target;
-        CGSymbol *sym = cg_lookup(c->current, id->name);
+        CGSymbol *sym = cg_resolve_ident(c, id);
         if (sym && !sym->is_func)
             LLVMBuildStore(c->builder, val, sym->value);
         else
@@ -173,7 +211,7 @@ LLVMValueRef cg_emit_destruct(CodegenContext *c, DestructAssignNode *n) {
     LLVMValueRef val = cg_emit_expr(c, n->value);
     if (n->target->type == NODE_IDENT) {
         IdentNode *id = (IdentNode*)n->target;
-        CGSymbol *sym = cg_lookup(c->current, id->name);
+        CGSymbol *sym = cg_resolve_ident(c, id);
         if (sym) {
             if (sym->callable_cell) {
                 LLVMBuildStore(c->builder, val, sym->callable_cell);
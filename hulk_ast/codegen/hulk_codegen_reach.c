@@ -0,0 +1,324 @@
+/*
+ * hulk_codegen_reach.c — Entidades vivas del programa (tree shaking)
+ *
+ * Antes de emitir se marca qué funciones globales, tipos y métodos puede
+ * alcanzar el programa partiendo de sus expresiones globales; el resto
+ * no se emite (ni su función, ni T_new/T_init, ni el adaptador y la
+ * celda de closure, ni la vtable). El análisis es por nombres, como la
+ * resolución del codegen, y conservador:
+ *
+ *   - Una función vive si código vivo nombra su identificador (llamada,
+ *     valor de closure o decorador).
+ *   - Un tipo vive si código vivo lo instancia, lo nombra (anotación,
+ *     is/as, tipo estático que anotó el semántico) o hereda de él un
+ *     tipo vivo. Con el tipo viven sus parámetros, los argumentos al
+ *     padre y los inicializadores de atributos.
+ *   - Un método vive si su tipo vive y código vivo accede a algún
+ *     miembro con su nombre (un for usa next y current): el dispatch
+ *     por vtable puede llegar a cualquier implementación del slot.
+ *
+ * El análisis corre sobre el AST plano (hulk_ast_flat.h), que se arma al
+ * entrar y se descarta al salir: las marcas son un byte por id y cada
+ * entidad se recorre con un HulkFlatVisitor. Al final se publican en
+ * c->live las de las declaraciones y miembros, que es lo que consultan
+ * los emisores.
+ *
+ * Cada entidad se recorre una sola vez (pila de trabajo explícita); un
+ * método cuyo nombre todavía no se usó queda en espera y se libera
+ * cuando aparece el primer acceso con ese nombre.
+ *
+ * SRP: solo el análisis; cada emisor consulta cg_is_live.
+ */
+
+#include "hulk_codegen_internal.h"
+#include "../core/hulk_ast_flat.h"
+#include "../core/hulk_intern.h"
+
+typedef struct {
+    HulkFlatId method;
+    int        next;      // siguiente en espera del mismo nombre, o -1
+} ReachWait;
+
+typedef struct {
+    const HulkFlatAST *f;
+    uint8_t        *live;     // por id
+    HulkFlatVisitor refs;     // referencias de cada nodo, luego sus hijos
+    HulkNameIndex   fns;      // nombre → id de la declaración (función global)
+    HulkNameIndex   types;    // nombre → id de la declaración (tipo)
+    HulkNameIndex   used;     // nombres de miembro accedidos
+    HulkNameIndex   waiting;  // nombre → primer método en espera
+    ReachWait      *wait;
+    int             wait_count, wait_cap;
+    HulkFlatId     *stack;
+    int             top, cap;
+    int             ok;
+} Reach;
+
+/* Listas de un TypeDef (orden de hulk_ast_slots). */
+enum { TD_PARAMS, TD_PARENT_ARGS, TD_MEMBERS };
+
+/* Marca `id` como vivo; 1 si no lo estaba. */
+static int mark(Reach *r, HulkFlatId id) {
+    if (id == HULK_FLAT_NONE || r->live[id]) return 0;
+    r->live[id] = 1;
+    return 1;
+}
+
+static void push(Reach *r, HulkFlatId id) {
+    if (id == HULK_FLAT_NONE) return;
+    if (r->top >= r->cap) {
+        int nc = r->cap ? r->cap * 2 : 256;
+        HulkFlatId *ns = realloc(r->stack, sizeof(HulkFlatId) * (size_t)nc);
+        if (!ns) { r->ok = 0; return; }
+        r->stack = ns;
+        r->cap = nc;
+    }
+    r->stack[r->top++] = id;
+}
+
+static void push_list(Reach *r, HulkFlatId id, int which) {
+    const HulkFlatId *items;
+    int len = hulk_flat_list(r->f, id, which, &items);
+    for (int i = 0; i < len; i++) push(r, items[i]);
+}
+
+static void wait_for(Reach *r, HulkFlatId method, const char *name) {
+    if (r->wait_count >= r->wait_cap) {
+        int nc = r->wait_cap ? r->wait_cap * 2 : 64;
+        ReachWait *nw = realloc(r->wait, sizeof(ReachWait) * (size_t)nc);
+        if (!nw) { r->ok = 0; return; }
+        r->wait = nw;
+        r->wait_cap = nc;
+    }
+    int k = r->wait_count++;
+    r->wait[k].method = method;
+    int head = hulk_name_index_find(&r->waiting, name);
+    if (head < 0) {
+        r->wait[k].next = -1;
+        hulk_name_index_add(&r->waiting, name, k);
+    } else {
+        r->wait[k].next = r->wait[head].next;
+        r->wait[head].next = k;
+    }
+}
+
+static void use_function(Reach *r, const char *name) {
+    int i = name ? hulk_name_index_find(&r->fns, name) : -1;
+    if (i < 0) return;
+    if (mark(r, (HulkFlatId)i)) push(r, (HulkFlatId)i);
+}
+
+static void use_type(Reach *r, const char *name) {
+    int i = name ? hulk_name_index_find(&r->types, name) : -1;
+    if (i < 0) return;
+    HulkFlatId td = (HulkFlatId)i;
+    if (!mark(r, td)) return;
+
+    push_list(r, td, TD_PARAMS);
+    push_list(r, td, TD_PARENT_ARGS);
+    use_type(r, r->f->type_ref[td]);            /* el padre */
+    const HulkFlatId *members;
+    int count = hulk_flat_list(r->f, td, TD_MEMBERS, &members);
+    for (int m = 0; m < count; m++) {
+        HulkFlatId member = members[m];
+        if (r->f->kind[member] == NODE_ATTRIBUTE_DEF) {
+            push(r, member);
+            continue;
+        }
+        const char *mname = r->f->name[member];
+        if (hulk_name_index_find(&r->used, mname) >= 0) {
+            if (mark(r, member)) push(r, member);
+        } else {
+            wait_for(r, member, mname);
+        }
+    }
+}
+
+/* Tipos nombrados en una anotación: un nombre, o uno compuesto
+ * ("T[]", "(A, B) -> C") del que se toma cada identificador; una
+ * instancia de genérico ("Box<A>") cuenta entera y también sus
+ * argumentos. */
+static void use_type_ref(Reach *r, const char *ann) {
+    if (!ann) return;
+    if (hulk_name_index_find(&r->types, ann) >= 0) {
+        use_type(r, ann);
+        return;
+    }
+    char word[256];
+    for (const char *p = ann; *p; ) {
+        if (!(*p == '_' || (*p >= 'A' && *p <= 'Z') ||
+              (*p >= 'a' && *p <= 'z'))) { p++; continue; }
+        size_t n = 0;
+        while (p[n] == '_' || (p[n] >= 'A' && p[n] <= 'Z') ||
+               (p[n] >= 'a' && p[n] <= 'z') || (p[n] >= '0' && p[n] <= '9'))
+            n++;
+        size_t len = n;
+        if (p[n] == '<') {
+            int depth = 0;
+            for (size_t i = n; p[i]; i++) {
+                if (p[i] == '<' || p[i] == '(') depth++;
+                else if ((p[i] == '>' && p[i - 1] != '-') || p[i] == ')') depth--;
+                if (depth == 0) { len = i + 1; break; }
+            }
+        }
+        if (len < sizeof(word)) {
+            memcpy(word, p, len);
+            word[len] = '\0';
+            use_type(r, hulk_intern_find(word));
+        }
+        p += n;
+    }
+}
+
+static void use_member(Reach *r, const char *name) {
+    if (!name || hulk_name_index_find(&r->used, name) >= 0) return;
+    hulk_name_index_add(&r->used, name, 1);
+    int k = hulk_name_index_find(&r->waiting, name);
+    for (; k >= 0; k = r->wait[k].next)
+        if (mark(r, r->wait[k].method)) push(r, r->wait[k].method);
+}
+
+// ============== VISITOR ==============
+// Cada callback anota lo que nombra el nodo mismo y baja a sus hijos.
+
+static void visit_node(const HulkFlatAST *f, HulkFlatId id,
+                       HulkFlatVisitor *v, void *data) {
+    Reach *r = data;
+    use_type_ref(r, f->type_ref[id]);
+    if (f->static_type) use_type_ref(r, f->static_type[id]);
+    hulk_flat_accept_children(f, id, v, data);
+}
+
+static void visit_name(const HulkFlatAST *f, HulkFlatId id,
+                       HulkFlatVisitor *v, void *data) {
+    use_function(data, f->name[id]);
+    use_type(data, f->name[id]);                /* el constructor como valor */
+    visit_node(f, id, v, data);
+}
+
+static void visit_type_use(const HulkFlatAST *f, HulkFlatId id,
+                           HulkFlatVisitor *v, void *data) {
+    use_type(data, f->name[id]);
+    visit_node(f, id, v, data);
+}
+
+static void visit_member(const HulkFlatAST *f, HulkFlatId id,
+                         HulkFlatVisitor *v, void *data) {
+    use_member(data, f->name[id]);
+    visit_node(f, id, v, data);
+}
+
+static void visit_for(const HulkFlatAST *f, HulkFlatId id,
+                      HulkFlatVisitor *v, void *data) {
+    use_member(data, hulk_intern("next"));      /* protocolo de iterable */
+    use_member(data, hulk_intern("current"));
+    visit_node(f, id, v, data);
+}
+
+static void refs_visitor_init(HulkFlatVisitor *v) {
+    for (int k = 0; k < NODE_HULK_COUNT; k++) v->visit[k] = visit_node;
+    v->visit[NODE_IDENT]         = visit_name;
+    v->visit[NODE_DECOR_ITEM]    = visit_name;
+    v->visit[NODE_NEW_EXPR]      = visit_type_use;
+    v->visit[NODE_AS_EXPR]       = visit_type_use;
+    v->visit[NODE_IS_EXPR]       = visit_type_use;
+    v->visit[NODE_MEMBER_ACCESS] = visit_member;
+    v->visit[NODE_FOR_STMT]      = visit_for;
+}
+
+static void drain(Reach *r) {
+    while (r->top > 0 && r->ok)
+        hulk_flat_accept(r->f, r->stack[--r->top], &r->refs, r);
+}
+
+/* Copia a c->live la marca de `decl` (y de sus miembros o su destino),
+ * recorriendo a la par el nodo y su id. */
+static void publish(CodegenContext *c, const Reach *r, HulkNode *decl,
+                    HulkFlatId id) {
+    if (!decl || id == HULK_FLAT_NONE) return;
+    if (r->live[id]) {
+        char *flag = hulk_side_put(&c->live, decl);
+        if (flag) *flag = 1;
+        else c->shaken = 0;
+    }
+    if (decl->type == NODE_TYPE_DEF) {
+        TypeDefNode *td = (TypeDefNode*)decl;
+        const HulkFlatId *members;
+        hulk_flat_list(r->f, id, TD_MEMBERS, &members);
+        for (int m = 0; m < td->members.count; m++)
+            publish(c, r, td->members.items[m], members[m]);
+    } else if (decl->type == NODE_DECOR_BLOCK) {
+        publish(c, r, ((DecorBlockNode*)decl)->target,
+                hulk_flat_child(r->f, id, 0));
+    }
+}
+
+void cg_reach_program(CodegenContext *c, ProgramNode *prog) {
+    c->shaken = 0;
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    if (hulk_flat_build(&f, (HulkNode*)prog) == HULK_FLAT_NONE) {
+        hulk_flat_free(&f);
+        return;
+    }
+
+    Reach r;
+    memset(&r, 0, sizeof(r));
+    r.f = &f;
+    r.live = calloc((size_t)f.count, 1);
+    r.ok = r.live != NULL;
+    refs_visitor_init(&r.refs);
+
+    const HulkFlatId *decls;
+    int ndecls = hulk_flat_list(&f, 0, 0, &decls);
+    for (int i = 0; i < ndecls; i++) {
+        HulkFlatId d = decls[i];
+        if (d == HULK_FLAT_NONE) continue;
+        if (f.kind[d] == NODE_FUNCTION_DEF)
+            hulk_name_index_add(&r.fns, f.name[d], (int)d);
+        else if (f.kind[d] == NODE_TYPE_DEF && !f.flags[d])
+            hulk_name_index_add(&r.types, f.name[d], (int)d);
+    }
+
+    /* Raíces: las expresiones globales. Un DecorBlock sin desugarizar
+     * (codegen sin semántico) deja vivo su destino y sus decoradores. */
+    for (int i = 0; i < ndecls && r.ok; i++) {
+        HulkFlatId d = decls[i];
+        if (d == HULK_FLAT_NONE) continue;
+        int kind = f.kind[d];
+        if (kind == NODE_FUNCTION_DEF || kind == NODE_TYPE_DEF) continue;
+        if (kind != NODE_DECOR_BLOCK) { push(&r, d); continue; }
+        push_list(&r, d, 0);
+        HulkFlatId target = hulk_flat_child(&f, d, 0);
+        if (!mark(&r, target)) continue;
+        if (f.kind[target] == NODE_FUNCTION_DEF) push(&r, target);
+        else if (f.kind[target] == NODE_TYPE_DEF) {
+            const HulkFlatId *members;
+            int count = hulk_flat_list(&f, target, TD_MEMBERS, &members);
+            for (int m = 0; m < count; m++)
+                if (mark(&r, members[m])) push(&r, members[m]);
+            push_list(&r, target, TD_PARAMS);
+            push_list(&r, target, TD_PARENT_ARGS);
+            use_type(&r, f.type_ref[target]);
+        }
+    }
+    drain(&r);
+
+    if (r.ok) {
+        c->shaken = 1;
+        for (int i = 0; i < prog->declarations.count; i++)
+            publish(c, &r, prog->declarations.items[i], decls[i]);
+    }
+    hulk_name_index_free(&r.fns);
+    hulk_name_index_free(&r.types);
+    hulk_name_index_free(&r.used);
+    hulk_name_index_free(&r.waiting);
+    free(r.wait);
+    free(r.stack);
+    free(r.live);
+    hulk_flat_free(&f);
+}
+
+int cg_is_live(CodegenContext *c, HulkNode *decl) {
+    return !c->shaken || hulk_side_get(&c->live, decl) != NULL;
+}
@@ -396,4 +396,6 @@ void cg_define_runtime_helpers(CodegenContext *c) {
 
         LLVMBuildRet(c->builder, buf);
     }
+
+    cg_attrs_runtime(c);
 }
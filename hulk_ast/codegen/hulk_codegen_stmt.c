@@ -29,10 +29,17 @@ void cg_emit_program(CodegenContext *c, HulkNode *program) {
     ProgramNode *prog = (ProgramNode*)program;
     c->current_program = program;
 
+    /* ---- Pasada 0: qué alcanzan las expresiones globales ---- */
+    cg_reach_program(c, prog);
+    if (!c->no_attrs) hulk_effects_analyze(&c->effects, program);
+
     /* ---- Pasada 1: Forward declarations ---- */
     for (int i = 0; i < prog->declarations.count; i++) {
         HulkNode *decl = prog->declarations.items[i];
         if (!decl) continue;
+        if ((decl->type == NODE_FUNCTION_DEF || decl->type == NODE_TYPE_DEF) &&
+            !cg_is_live(c, decl))
+            continue;
 
         switch (decl->type) {
             case NODE_FUNCTION_DEF:
@@ -55,13 +62,18 @@ void cg_emit_program(CodegenContext *c, HulkNode *program) {
 
     /* ---- Pasada 1.5: Construir vtables y tablas RTTI ----
      * Todas las funciones método ya están forward-declared y todos los
-     * slots globales ya están asignados; podemos llenar las vtables. */
+     * slots globales ya están asignados; podemos llenar las vtables.
+     * La jerarquía ya es definitiva: se indexa para cg_type_lca. */
+    cg_type_index_hierarchy(c);
     cg_emit_rtti_globals(c);
 
     /* ---- Pasada 2: Emitir cuerpos de funciones y tipos ---- */
     for (int i = 0; i < prog->declarations.count; i++) {
         HulkNode *decl = prog->declarations.items[i];
         if (!decl) continue;
+        if ((decl->type == NODE_FUNCTION_DEF || decl->type == NODE_TYPE_DEF) &&
+            !cg_is_live(c, decl))
+            continue;
 
         switch (decl->type) {
             case NODE_FUNCTION_DEF:
@@ -187,9 +199,11 @@ static void forward_declare_function(CodegenContext *c, FunctionDefNode *n) {
     }
     LLVMTypeRef fn_type = LLVMFunctionType(ret_t, param_types, argc, 0);
     LLVMValueRef fn = LLVMAddFunction(c->module, n->name, fn_type);
+    cg_attrs_function(c, fn, (HulkNode*)n);
 
     /* Registrar en scope global */
     CGSymbol *sym = cg_define_in(c, c->global, n->name, fn, fn_type, 1);
+    cg_bind_decl(c, sym, (HulkNode*)n);
     if (sym) {
         char adapter_name[256];
         snprintf(adapter_name, sizeof(adapter_name), "%s__closure_adapter",
@@ -203,6 +217,7 @@ static void forward_declare_function(CodegenContext *c, FunctionDefNode *n) {
                                                     argc + 1, 0);
         LLVMValueRef adapter_fn = LLVMAddFunction(c->module, adapter_name,
                                                   adapter_type);
+        cg_attrs_function(c, adapter_fn, (HulkNode*)n);
 
         char cell_name[256];
         snprintf(cell_name, sizeof(cell_name), "%s__closure_cell", n->name);
@@ -240,6 +255,7 @@ static void emit_function_def(CodegenContext *c, FunctionDefNode *n) {
         LLVMValueRef alloca = cg_create_entry_alloca(c, param_t, p->name);
         LLVMBuildStore(c->builder, param_val, alloca);
         CGSymbol *psym = cg_define(c, p->name, alloca, param_t, 0);
+        cg_bind_decl(c, psym, (HulkNode*)p);
         if (psym && p->type_annotation) {
             CGTypeInfo *pti = cg_type_info_find(c, p->type_annotation);
             if (pti) psym->hulk_type = pti;
@@ -0,0 +1,109 @@
+/*
+ * hulk_codegen_target.c — Máquina destino y pipeline de optimización
+ *
+ * El codegen emite IR directo: cada local en un alloca y cada llamada a
+ * una función global a través de su celda. Desde -O1 el módulo pasa por
+ * el pipeline estándar del pass manager nuevo de LLVM (LLVMRunPasses con
+ * "default<On>"): mem2reg/SROA, inlining, simplificación de bucles y,
+ * desde -O2, vectorización, como clang en el mismo nivel. El backend
+ * genera código con el nivel equivalente; -O0 explícito lo deja sin
+ * optimizar, como clang, y sin flag queda en su nivel Default, como
+ * antes de que existieran los niveles.
+ *
+ * La máquina destino es la del triple del host con CPU "generic", o con
+ * el CPU y las extensiones del host (-march=native); el binario con
+ * native puede no correr en otra máquina.
+ *
+ * SRP: solo configura el destino y optimiza; emitir y enlazar es de
+ * hulk_codegen.c.
+ */
+
+#include "hulk_codegen_internal.h"
+#include <llvm-c/Transforms/PassBuilder.h>
+
+static const char *PIPELINES[] = {
+    [HULK_OPT_O0] = "default<O0>",
+    [HULK_OPT_O1] = "default<O1>",
+    [HULK_OPT_O2] = "default<O2>",
+    [HULK_OPT_O3] = "default<O3>",
+    [HULK_OPT_OS] = "default<Os>",
+};
+
+static const LLVMCodeGenOptLevel BACKEND_LEVELS[] = {
+    [HULK_OPT_DEFAULT] = LLVMCodeGenLevelDefault,
+    [HULK_OPT_O0] = LLVMCodeGenLevelNone,
+    [HULK_OPT_O1] = LLVMCodeGenLevelLess,
+    [HULK_OPT_O2] = LLVMCodeGenLevelDefault,
+    [HULK_OPT_O3] = LLVMCodeGenLevelAggressive,
+    [HULK_OPT_OS] = LLVMCodeGenLevelDefault,
+};
+
+int hulk_codegen_parse_option(HulkCodegenOptions *opts, const char *arg) {
+    static const char *levels[] = {
+        [HULK_OPT_O0] = "-O0", [HULK_OPT_O1] = "-O1", [HULK_OPT_O2] = "-O2",
+        [HULK_OPT_O3] = "-O3", [HULK_OPT_OS] = "-Os",
+    };
+    for (int i = HULK_OPT_O0; i <= HULK_OPT_OS; i++)
+        if (strcmp(arg, levels[i]) == 0) {
+            opts->level = (HulkOptLevel)i;
+            return 1;
+        }
+    if (strcmp(arg, "-march=native") == 0)  { opts->native = 1; return 1; }
+    if (strcmp(arg, "-march=generic") == 0) { opts->native = 0; return 1; }
+    return 0;
+}
+
+LLVMTargetMachineRef cg_target_machine(CodegenContext *c,
+                                       const HulkCodegenOptions *opts) {
+    LLVMInitializeNativeTarget();
+    LLVMInitializeNativeAsmPrinter();
+    LLVMInitializeNativeAsmParser();
+
+    char *triple = LLVMGetDefaultTargetTriple();
+    LLVMTargetRef target;
+    char *err = NULL;
+    if (LLVMGetTargetFromTriple(triple, &target, &err)) {
+        fprintf(stderr, "[CODEGEN ERROR] Target not found: %s\n", err);
+        LLVMDisposeMessage(err);
+        LLVMDisposeMessage(triple);
+        return NULL;
+    }
+    if (err) LLVMDisposeMessage(err);
+
+    char *cpu = opts->native ? LLVMGetHostCPUName() : NULL;
+    char *features = opts->native ? LLVMGetHostCPUFeatures() : NULL;
+    LLVMTargetMachineRef tm = LLVMCreateTargetMachine(
+        target, triple, cpu ? cpu : "generic", features ? features : "",
+        BACKEND_LEVELS[opts->level],
+        LLVMRelocPIC,           /* PIC para que el .o linkee con cc PIE */
+        LLVMCodeModelDefault);
+    if (cpu) LLVMDisposeMessage(cpu);
+    if (features) LLVMDisposeMessage(features);
+
+    /* El optimizador decide tamaños y alineaciones con el data layout */
+    LLVMSetTarget(c->module, triple);
+    LLVMTargetDataRef layout = LLVMCreateTargetDataLayout(tm);
+    LLVMSetModuleDataLayout(c->module, layout);
+    LLVMDisposeTargetData(layout);
+    LLVMDisposeMessage(triple);
+    return tm;
+}
+
+int cg_optimize(CodegenContext *c, LLVMTargetMachineRef tm,
+                const HulkCodegenOptions *opts) {
+    if (opts->level <= HULK_OPT_O0) return 0;
+
+    LLVMPassBuilderOptionsRef pbo = LLVMCreatePassBuilderOptions();
+    int vectorize = opts->level != HULK_OPT_O1;
+    LLVMPassBuilderOptionsSetLoopVectorization(pbo, vectorize);
+    LLVMPassBuilderOptionsSetSLPVectorization(pbo, vectorize);
+    LLVMPassBuilderOptionsSetLoopInterleaving(pbo, vectorize);
+    LLVMErrorRef e = LLVMRunPasses(c->module, PIPELINES[opts->level], tm, pbo);
+    LLVMDisposePassBuilderOptions(pbo);
+    if (!e) return 0;
+
+    char *msg = LLVMGetErrorMessage(e);
+    fprintf(stderr, "[CODEGEN ERROR] LLVM passes failed: %s\n", msg);
+    LLVMDisposeErrorMessage(msg);
+    return 1;
+}
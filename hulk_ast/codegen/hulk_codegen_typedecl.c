@@ -83,8 +83,8 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
     ti->field_count = total_fields;
 
     LLVMTypeRef *field_types = calloc(total_fields, sizeof(LLVMTypeRef));
-    ti->field_names = calloc(total_fields, sizeof(const char*));
-    ti->field_types_arr = calloc(total_fields, sizeof(LLVMTypeRef));
+    ti->field_names = cg_alloc(c, total_fields * sizeof(const char*));
+    ti->field_types_arr = cg_alloc(c, total_fields * sizeof(LLVMTypeRef));
 
     if (ti->parent) {
         /* Copiar layout completo del padre */
@@ -95,7 +95,7 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
     } else {
         /* Solo el tag */
         field_types[0] = c->t_i32;
-        ti->field_names[0] = "__tag__";
+        ti->field_names[0] = hulk_intern("__tag__");
     }
 
     int idx = parent_field_count;
@@ -120,6 +120,9 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
 
     memcpy(ti->field_types_arr, field_types,
            total_fields * sizeof(LLVMTypeRef));
+    if (total_fields > HULK_NAME_INDEX_MIN)
+        for (int i = 0; i < total_fields; i++)
+            hulk_name_index_add(&ti->field_index, ti->field_names[i], i);
     LLVMStructSetBody(st, field_types, total_fields, 0);
     free(field_types);
 
@@ -153,17 +156,21 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
     LLVMTypeRef ctor_ft = LLVMFunctionType(ti->ptr_type, ctor_params,
                                             param_argc, 0);
     LLVMValueRef ctor_fn = LLVMAddFunction(c->module, ctor_name, ctor_ft);
+    cg_attrs_function(c, ctor_fn, (HulkNode*)n);
     ti->fn_new = ctor_fn;
 
-    cg_define_in(c, c->global, n->name, ctor_fn, ctor_ft, 1);
-    cg_define_in(c, c->global, strdup(ctor_name), ctor_fn, ctor_ft, 1);
+    cg_bind_decl(c, cg_define_in(c, c->global, n->name, ctor_fn, ctor_ft, 1),
+                 (HulkNode*)n);
+    cg_define_in(c, c->global, ctor_name, ctor_fn, ctor_ft, 1);
 
     free(init_params);
     free(ctor_params);
 
-    /* Forward-declare métodos y registrar slots globales */
+    /* Forward-declare métodos y registrar slots globales (los métodos
+     * que nadie puede invocar no tienen función ni entrada en vtable) */
     for (int i = 0; i < n->members.count; i++) {
-        if (n->members.items[i]->type == NODE_METHOD_DEF) {
+        if (n->members.items[i]->type == NODE_METHOD_DEF &&
+            cg_is_live(c, n->members.items[i])) {
             MethodDefNode *m = (MethodDefNode*)n->members.items[i];
 
             int m_argc = m->params.count + 1;  /* +1 para self */
@@ -186,13 +193,14 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
             method_adapter_name(adapter_name, sizeof(adapter_name), n, m);
             LLVMTypeRef m_ft = LLVMFunctionType(m_ret, m_params, m_argc, 0);
             LLVMValueRef impl_fn = LLVMAddFunction(c->module, impl_name, m_ft);
+            cg_attrs_function(c, impl_fn, (HulkNode*)m);
 
-            cg_define_in(c, c->global, strdup(impl_name), impl_fn, m_ft, 1);
+            cg_define_in(c, c->global, impl_name, impl_fn, m_ft, 1);
 
             LLVMValueRef public_fn = impl_fn;
             if (method_has_decorators(m)) {
                 public_fn = LLVMAddFunction(c->module, public_name, m_ft);
-                cg_define_in(c, c->global, strdup(public_name), public_fn,
+                cg_define_in(c, c->global, public_name, public_fn,
                              m_ft, 1);
 
                 LLVMTypeRef *adapter_params = calloc(m_argc, sizeof(LLVMTypeRef));
@@ -203,12 +211,12 @@ void cg_forward_declare_type(CodegenContext *c, TypeDefNode *n) {
                     adapter_params, m_argc, 0);
                 LLVMValueRef adapter_fn = LLVMAddFunction(
                     c->module, adapter_name, adapter_ft);
-                cg_define_in(c, c->global, strdup(adapter_name), adapter_fn,
+                cg_define_in(c, c->global, adapter_name, adapter_fn,
                              adapter_ft, 1);
                 free(adapter_params);
             }
 
-            cg_type_add_method(ti, m->name, public_fn);
+            cg_type_add_method(c, ti, m->name, public_fn);
             cg_method_slot(c, m->name);  /* asigna slot global si no existe */
 
             free(m_params);
@@ -255,6 +263,7 @@ void cg_emit_type_def(CodegenContext *c, TypeDefNode *n) {
             LLVMValueRef alloca = cg_create_entry_alloca(c, pt, p->name);
             LLVMBuildStore(c->builder, param_val, alloca);
             CGSymbol *psym = cg_define(c, p->name, alloca, pt, 0);
+            cg_bind_decl(c, psym, (HulkNode*)p);
             if (psym && p->type_annotation) {
                 CGTypeInfo *pti = cg_type_info_find(c, p->type_annotation);
                 if (pti) psym->hulk_type = pti;
@@ -349,7 +358,8 @@ void cg_emit_type_def(CodegenContext *c, TypeDefNode *n) {
 
     /* ---- Emitir métodos ---- */
     for (int i = 0; i < n->members.count; i++) {
-        if (n->members.items[i]->type == NODE_METHOD_DEF) {
+        if (n->members.items[i]->type == NODE_METHOD_DEF &&
+            cg_is_live(c, n->members.items[i])) {
             MethodDefNode *m = (MethodDefNode*)n->members.items[i];
 
             char mname[256];
@@ -386,6 +396,7 @@ void cg_emit_type_def(CodegenContext *c, TypeDefNode *n) {
                 LLVMValueRef alloca = cg_create_entry_alloca(c, pt, p->name);
                 LLVMBuildStore(c->builder, param_val, alloca);
                 CGSymbol *psym = cg_define(c, p->name, alloca, pt, 0);
+                cg_bind_decl(c, psym, (HulkNode*)p);
                 if (psym && p->type_annotation) {
                     CGTypeInfo *pti = cg_type_info_find(c, p->type_annotation);
                     if (pti) psym->hulk_type = pti;
@@ -502,6 +513,7 @@ static void emit_method_decorator_wrapper(CodegenContext *c, CGTypeInfo *ti,
         LLVMValueRef alloca = cg_create_entry_alloca(c, pt, p->name);
         LLVMBuildStore(c->builder, param_val, alloca);
         CGSymbol *psym = cg_define(c, p->name, alloca, pt, 0);
+        cg_bind_decl(c, psym, (HulkNode*)p);
         if (psym && p->type_annotation) {
             CGTypeInfo *pti = cg_type_info_find(c, p->type_annotation);
             if (pti) psym->hulk_type = pti;
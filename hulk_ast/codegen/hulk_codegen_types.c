@@ -6,24 +6,26 @@
  */
 
 #include "hulk_codegen_internal.h"
+#include "../core/hulk_hierarchy.h"
 
 /* ============================================================
  *  Scope management
  * ============================================================ */
 
 CGScope* cg_scope_create(CodegenContext *c, CGScope *parent) {
-    CGScope *s = calloc(1, sizeof(CGScope));
-    if (!s) return NULL;
-    s->parent = parent;
-
-    if (c->scope_count >= c->scope_cap) {
-        int nc = c->scope_cap == 0 ? 16 : c->scope_cap * 2;
-        CGScope **tmp = realloc(c->all_scopes, sizeof(CGScope*) * nc);
-        if (!tmp) { free(s); return NULL; }
-        c->all_scopes = tmp;
-        c->scope_cap = nc;
+    CGScope *s = c->free_scopes;
+    if (s) {
+        /* Reusado: conserva su arreglo de símbolos (y su capacidad) */
+        c->free_scopes = s->parent;
+        s->sym_count = 0;
+    } else {
+        s = cg_alloc(c, sizeof(CGScope));
+        if (!s) return NULL;
+        s->next = c->scopes;
+        c->scopes = s;
+        c->scope_count++;
     }
-    c->all_scopes[c->scope_count++] = s;
+    s->parent = parent;
     return s;
 }
 
@@ -31,17 +33,52 @@ void cg_push_scope(CodegenContext *c) {
     c->current = cg_scope_create(c, c->current);
 }
 
+/* Al cerrar un scope sus declaraciones dejan de estar vivas: los usos
+ * que las nombren (p.ej. el mismo cuerpo emitido en otra función) vuelven
+ * a buscarse por nombre. */
 void cg_pop_scope(CodegenContext *c) {
-    if (c->current && c->current->parent)
-        c->current = c->current->parent;
+    CGScope *s = c->current;
+    if (!s || !s->parent) return;
+    for (int i = 0; i < s->sym_count; i++) {
+        if (!s->symbols[i]->decl) continue;
+        CGSymbol **live = hulk_side_get(&c->bindings, s->symbols[i]->decl);
+        if (live && *live == s->symbols[i]) *live = NULL;
+    }
+    c->current = s->parent;
+    /* Sin bindings vivos nadie más apunta al scope: a la lista de libres */
+    hulk_name_index_free(&s->index);
+    s->parent = c->free_scopes;
+    c->free_scopes = s;
+}
+
+/* Los nombres guardados en scopes y registros de tipos están internados:
+ * las búsquedas comparan punteros y solo si fallan reintentan con la
+ * forma internada de la clave (nombres armados con snprintf, como los
+ * de constructores `T_new`). Cada arreglo con más de
+ * HULK_NAME_INDEX_MIN entradas se busca por su índice hash; los chicos,
+ * recorriéndolos. */
+static const char* retry_key(const char *name) {
+    const char *key = hulk_intern_find(name);
+    return key != name ? key : NULL;
+}
+
+static CGSymbol* find_local(CGScope *scope, const char *key) {
+    if (scope->index.cap) {
+        int i = hulk_name_index_find(&scope->index, key);
+        return i >= 0 ? scope->symbols[i] : NULL;
+    }
+    for (int i = 0; i < scope->sym_count; i++)
+        if (scope->symbols[i]->name == key)
+            return scope->symbols[i];
+    return NULL;
 }
 
 CGSymbol* cg_define_in(CodegenContext *c, CGScope *scope, const char *name,
                        LLVMValueRef val, LLVMTypeRef type, int is_func) {
-    (void)c;
     if (!scope || !name) return NULL;
+    name = hulk_intern(name);
     /* Permitir redefinición en mismo scope (shadowing) para codegen */
-    CGSymbol *existing = cg_lookup_local(scope, name);
+    CGSymbol *existing = find_local(scope, name);
     if (existing) {
         existing->value   = val;
         existing->type    = type;
@@ -49,7 +86,7 @@ CGSymbol* cg_define_in(CodegenContext *c, CGScope *scope, const char *name,
         return existing;
     }
 
-    CGSymbol *sym = calloc(1, sizeof(CGSymbol));
+    CGSymbol *sym = cg_alloc(c, sizeof(CGSymbol));
     if (!sym) return NULL;
     sym->name    = name;
     sym->value   = val;
@@ -57,13 +94,24 @@ CGSymbol* cg_define_in(CodegenContext *c, CGScope *scope, const char *name,
     sym->is_func = is_func;
 
     if (scope->sym_count >= scope->sym_cap) {
+        /* El arreglo viejo queda en la arena (crecer al doble acota el
+         * desperdicio) */
         int nc = scope->sym_cap == 0 ? 8 : scope->sym_cap * 2;
-        CGSymbol **tmp = realloc(scope->symbols, sizeof(CGSymbol*) * nc);
-        if (!tmp) { free(sym); return NULL; }
+        CGSymbol **tmp = cg_alloc(c, sizeof(CGSymbol*) * nc);
+        if (!tmp) return NULL;
+        if (scope->sym_count > 0)
+            memcpy(tmp, scope->symbols, sizeof(CGSymbol*) * scope->sym_count);
         scope->symbols = tmp;
         scope->sym_cap = nc;
     }
     scope->symbols[scope->sym_count++] = sym;
+
+    /* Al pasar el umbral se indexa todo lo anterior; después, cada nuevo */
+    if (scope->sym_count > HULK_NAME_INDEX_MIN) {
+        int from = scope->index.cap ? scope->sym_count - 1 : 0;
+        for (int i = from; i < scope->sym_count; i++)
+            hulk_name_index_add(&scope->index, scope->symbols[i]->name, i);
+    }
     return sym;
 }
 
@@ -74,110 +122,225 @@ CGSymbol* cg_define(CodegenContext *c, const char *name,
 
 CGSymbol* cg_lookup_local(CGScope *scope, const char *name) {
     if (!scope || !name) return NULL;
-    for (int i = 0; i < scope->sym_count; i++) {
-        if (scope->symbols[i]->name &&
-            strcmp(scope->symbols[i]->name, name) == 0)
-            return scope->symbols[i];
-    }
-    return NULL;
+    CGSymbol *sym = find_local(scope, name);
+    if (sym) return sym;
+    const char *key = retry_key(name);
+    return key ? find_local(scope, key) : NULL;
 }
 
-CGSymbol* cg_lookup(CGScope *scope, const char *name) {
+static CGSymbol* find_chain(CGScope *scope, const char *key) {
     for (CGScope *s = scope; s; s = s->parent) {
-        CGSymbol *sym = cg_lookup_local(s, name);
+        CGSymbol *sym = find_local(s, key);
         if (sym) return sym;
     }
     return NULL;
 }
 
+CGSymbol* cg_lookup(CGScope *scope, const char *name) {
+    if (!name) return NULL;
+    CGSymbol *sym = find_chain(scope, name);
+    if (sym) return sym;
+    const char *key = retry_key(name);
+    return key ? find_chain(scope, key) : NULL;
+}
+
+void cg_bind_decl(CodegenContext *c, CGSymbol *sym, HulkNode *decl) {
+    if (!sym || !decl) return;
+    CGSymbol **live = hulk_side_put(&c->bindings, decl);
+    if (!live) return;
+    *live = sym;
+    sym->decl = decl;
+}
+
+CGSymbol* cg_resolve_ident(CodegenContext *c, IdentNode *n) {
+    const HulkBinding *b = &n->binding;
+    CGSymbol *sym = NULL;
+    switch (b->kind) {
+        case HULK_BIND_CAPTURE:
+            if (b->slot < c->capture_count) sym = c->captures[b->slot];
+            break;
+        case HULK_BIND_LOCAL:
+        case HULK_BIND_GLOBAL:
+            if (b->decl) {
+                CGSymbol **live = hulk_side_get(&c->bindings, b->decl);
+                sym = live ? *live : NULL;
+            } else {
+                sym = cg_lookup_local(c->global, n->name);  /* built-in */
+            }
+            break;
+        case HULK_BIND_NONE:
+            break;
+    }
+    return sym ? sym : cg_lookup(c->current, n->name);
+}
+
 /* ============================================================
  *  Type info registry
  * ============================================================ */
 
 CGTypeInfo* cg_type_info_create(CodegenContext *c, const char *name) {
-    CGTypeInfo *ti = calloc(1, sizeof(CGTypeInfo));
+    CGTypeInfo *ti = cg_alloc(c, sizeof(CGTypeInfo));
     if (!ti) return NULL;
-    ti->name = name;
+    ti->name = hulk_intern(name);
     ti->type_tag = c->type_info_count;  /* tag numérico único */
 
     if (c->type_info_count >= c->type_info_cap) {
         int nc = c->type_info_cap == 0 ? 8 : c->type_info_cap * 2;
         CGTypeInfo **tmp = realloc(c->type_infos, sizeof(CGTypeInfo*) * nc);
-        if (!tmp) { free(ti); return NULL; }
+        if (!tmp) return NULL;
         c->type_infos = tmp;
         c->type_info_cap = nc;
     }
     c->type_infos[c->type_info_count++] = ti;
+
+    if (c->type_info_count > HULK_NAME_INDEX_MIN) {
+        int from = c->type_info_index.cap ? c->type_info_count - 1 : 0;
+        for (int i = from; i < c->type_info_count; i++)
+            hulk_name_index_add(&c->type_info_index, c->type_infos[i]->name, i);
+    }
     return ti;
 }
 
-CGTypeInfo* cg_type_info_find(CodegenContext *c, const char *name) {
-    if (!name) return NULL;
-    for (int i = 0; i < c->type_info_count; i++) {
-        if (c->type_infos[i]->name &&
-            strcmp(c->type_infos[i]->name, name) == 0)
-            return c->type_infos[i];
+static CGTypeInfo* find_type_info(CodegenContext *c, const char *key) {
+    if (c->type_info_index.cap) {
+        int i = hulk_name_index_find(&c->type_info_index, key);
+        return i >= 0 ? c->type_infos[i] : NULL;
     }
+    for (int i = 0; i < c->type_info_count; i++)
+        if (c->type_infos[i]->name == key)
+            return c->type_infos[i];
     return NULL;
 }
 
+CGTypeInfo* cg_type_info_find(CodegenContext *c, const char *name) {
+    if (!name) return NULL;
+    CGTypeInfo *ti = find_type_info(c, name);
+    if (ti) return ti;
+    const char *key = retry_key(name);
+    return key ? find_type_info(c, key) : NULL;
+}
+
 CGTypeInfo* cg_type_info_find_by_tag(CodegenContext *c, int tag) {
     if (tag >= 0 && tag < c->type_info_count)
         return c->type_infos[tag];
     return NULL;
 }
 
-void cg_type_add_method(CGTypeInfo *ti, const char *name, LLVMValueRef fn) {
+/* Con todos los tipos declarados (fin de la pasada 1) numera la
+ * jerarquía: el type_tag es la posición en type_infos. */
+void cg_type_index_hierarchy(CodegenContext *c) {
+    int n = c->type_info_count;
+    if (n == 0) return;
+    int *parent = malloc(sizeof(int) * (size_t)n);
+    int *pre    = malloc(sizeof(int) * (size_t)n);
+    int *post   = malloc(sizeof(int) * (size_t)n);
+    if (parent && pre && post) {
+        for (int i = 0; i < n; i++) {
+            CGTypeInfo *p = c->type_infos[i]->parent;
+            parent[i] = p ? p->type_tag : -1;
+        }
+        if (hulk_hierarchy_number(n, parent, pre, post)) {
+            for (int i = 0; i < n; i++) {
+                c->type_infos[i]->pre  = pre[i];
+                c->type_infos[i]->post = post[i];
+            }
+        }
+    }
+    free(parent); free(pre); free(post);
+}
+
+static int find_own_method(CGTypeInfo *ti, const char *key) {
+    if (ti->method_index.cap)
+        return hulk_name_index_find(&ti->method_index, key);
+    for (int i = 0; i < ti->method_count; i++)
+        if (ti->methods[i]->name == key)
+            return i;
+    return -1;
+}
+
+void cg_type_add_method(CodegenContext *c, CGTypeInfo *ti, const char *name,
+                        LLVMValueRef fn) {
     if (!ti) return;
+    name = hulk_intern(name);
     /* Check if exists — update */
-    for (int i = 0; i < ti->method_count; i++) {
-        if (ti->methods[i]->name && strcmp(ti->methods[i]->name, name) == 0) {
-            ti->methods[i]->value = fn;
-            return;
-        }
+    int at = find_own_method(ti, name);
+    if (at >= 0) {
+        ti->methods[at]->value = fn;
+        return;
     }
-    CGSymbol *sym = calloc(1, sizeof(CGSymbol));
+    CGSymbol *sym = cg_alloc(c, sizeof(CGSymbol));
+    if (!sym) return;
     sym->name    = name;
     sym->value   = fn;
     sym->is_func = 1;
 
     if (ti->method_count >= ti->method_cap) {
         int nc = ti->method_cap == 0 ? 4 : ti->method_cap * 2;
-        CGSymbol **tmp = realloc(ti->methods, sizeof(CGSymbol*) * nc);
-        if (!tmp) { free(sym); return; }
+        CGSymbol **tmp = cg_alloc(c, sizeof(CGSymbol*) * nc);
+        if (!tmp) return;
+        if (ti->method_count > 0)
+            memcpy(tmp, ti->methods, sizeof(CGSymbol*) * ti->method_count);
         ti->methods = tmp;
         ti->method_cap = nc;
     }
     ti->methods[ti->method_count++] = sym;
+
+    if (ti->method_count > HULK_NAME_INDEX_MIN) {
+        int from = ti->method_index.cap ? ti->method_count - 1 : 0;
+        for (int i = from; i < ti->method_count; i++)
+            hulk_name_index_add(&ti->method_index, ti->methods[i]->name, i);
+    }
 }
 
-LLVMValueRef cg_type_resolve_method(CGTypeInfo *ti, const char *name) {
+static LLVMValueRef find_method(CGTypeInfo *ti, const char *key) {
     for (CGTypeInfo *cur = ti; cur; cur = cur->parent) {
-        for (int i = 0; i < cur->method_count; i++) {
-            if (cur->methods[i]->name &&
-                strcmp(cur->methods[i]->name, name) == 0)
-                return cur->methods[i]->value;
-        }
+        int i = find_own_method(cur, key);
+        if (i >= 0) return cur->methods[i]->value;
     }
     return NULL;
 }
 
+LLVMValueRef cg_type_resolve_method(CGTypeInfo *ti, const char *name) {
+    if (!name) return NULL;
+    LLVMValueRef fn = find_method(ti, name);
+    if (fn) return fn;
+    const char *key = retry_key(name);
+    return key ? find_method(ti, key) : NULL;
+}
+
+static int find_field(CGTypeInfo *ti, const char *key) {
+    if (ti->field_index.cap)
+        return hulk_name_index_find(&ti->field_index, key);
+    for (int i = 0; i < ti->field_count; i++)
+        if (ti->field_names[i] == key)
+            return i;
+    return -1;
+}
+
 int cg_type_field_index(CGTypeInfo *ti, const char *name) {
     if (!ti || !name) return -1;
-    for (int i = 0; i < ti->field_count; i++) {
-        if (ti->field_names[i] && strcmp(ti->field_names[i], name) == 0)
+    int idx = find_field(ti, name);
+    if (idx >= 0) return idx;
+    const char *key = retry_key(name);
+    return key ? find_field(ti, key) : -1;
+}
+
+static int find_slot(CodegenContext *c, const char *key) {
+    if (c->method_slot_index.cap)
+        return hulk_name_index_find(&c->method_slot_index, key);
+    for (int i = 0; i < c->method_slot_count; i++)
+        if (c->method_slot_names[i] == key)
             return i;
-    }
     return -1;
 }
 
 int cg_method_slot(CodegenContext *c, const char *name) {
     if (!c || !name) return -1;
-    for (int i = 0; i < c->method_slot_count; i++) {
-        if (c->method_slot_names[i] &&
-            strcmp(c->method_slot_names[i], name) == 0)
-            return i;
-    }
+    int slot = find_slot(c, name);
+    if (slot >= 0) return slot;
+    const char *key = hulk_intern(name);
+    if (key != name && (slot = find_slot(c, key)) >= 0) return slot;
+    name = key;
     if (c->method_slot_count >= c->method_slot_cap) {
         int nc = c->method_slot_cap == 0 ? 16 : c->method_slot_cap * 2;
         const char **tmp = realloc(c->method_slot_names, sizeof(char*) * nc);
@@ -185,8 +348,15 @@ int cg_method_slot(CodegenContext *c, const char *name) {
         c->method_slot_names = tmp;
         c->method_slot_cap = nc;
     }
-    c->method_slot_names[c->method_slot_count] = name;
-    return c->method_slot_count++;
+    c->method_slot_names[c->method_slot_count++] = name;
+
+    if (c->method_slot_count > HULK_NAME_INDEX_MIN) {
+        int from = c->method_slot_index.cap ? c->method_slot_count - 1 : 0;
+        for (int i = from; i < c->method_slot_count; i++)
+            hulk_name_index_add(&c->method_slot_index,
+                                c->method_slot_names[i], i);
+    }
+    return c->method_slot_count - 1;
 }
 
 /* ============================================================
@@ -243,29 +413,25 @@ LLVMValueRef cg_create_entry_alloca(CodegenContext *c,
  * ============================================================ */
 
 void cg_context_free(CodegenContext *c) {
-    /* Scopes y sus símbolos */
-    for (int i = 0; i < c->scope_count; i++) {
-        CGScope *s = c->all_scopes[i];
-        for (int j = 0; j < s->sym_count; j++)
-            free(s->symbols[j]);
-        free(s->symbols);
-        free(s);
-    }
-    free(c->all_scopes);
-
-    /* Type infos */
+    /* Scopes, símbolos y type infos son de la arena: solo sus índices
+     * van aparte */
+    for (CGScope *s = c->scopes; s; s = s->next)
+        hulk_name_index_free(&s->index);
     for (int i = 0; i < c->type_info_count; i++) {
-        CGTypeInfo *ti = c->type_infos[i];
-        for (int j = 0; j < ti->method_count; j++)
-            free(ti->methods[j]);
-        free(ti->methods);
-        free(ti->field_names);
-        free(ti->field_types_arr);
-        free(ti);
+        hulk_name_index_free(&c->type_infos[i]->method_index);
+        hulk_name_index_free(&c->type_infos[i]->field_index);
     }
     free(c->type_infos);
+    hulk_name_index_free(&c->type_info_index);
     free(c->method_slot_names);
+    hulk_name_index_free(&c->method_slot_index);
     free(c->str_hints);
+    hulk_facts_free(&c->facts);
+    hulk_side_free(&c->static_types);
+    hulk_side_free(&c->bindings);
+    hulk_side_free(&c->live);
+    hulk_effects_free(&c->effects);
+    hulk_ast_context_free(&c->arena);
 
     /* LLVM resources */
     if (c->builder) LLVMDisposeBuilder(c->builder);
@@ -14,12 +14,19 @@
  * Uso del Object Pool:
  *   Todos los nodos se asignan desde un HulkASTContext (arena).
  *   Se liberan todos juntos con hulk_ast_context_free().
+ *
+ * Nombres internados:
+ *   Los campos de nombre (`const char *`: name, member, type_name,
+ *   anotaciones de tipo...) apuntan a strings de hulk_intern: se comparan
+ *   por puntero y no pertenecen a la arena. Los literales (raw, value)
+ *   siguen siendo copias en la arena.
  */
 
 #ifndef HULK_AST_H
 #define HULK_AST_H
 
 #include "../../generador_analizadores_lexicos/token_types.h"
+#include "hulk_intern.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -75,16 +82,27 @@ typedef enum {
 // ============== LISTA DINÁMICA DE NODOS ==============
 // Usada para listas de hijos (parámetros, argumentos, statements, etc.)
 
-struct HulkNode_s;  // forward
+// Las listas de los nodos toman su almacenamiento de la arena del
+// contexto (hulk_node_list_init_in); al crecer se copian a un bloque
+// nuevo y el viejo queda en la arena hasta hulk_ast_context_free. Las
+// listas sueltas (arena NULL) usan malloc/realloc y se liberan a mano.
+
+struct HulkNode_s;           // forward
+struct HulkASTContext_s;     // forward
 
 typedef struct {
     struct HulkNode_s **items;
     int count;
     int capacity;
+    struct HulkASTContext_s *arena;  // NULL: almacenamiento en el heap
 } HulkNodeList;
 
 void hulk_node_list_init(HulkNodeList *list);
+void hulk_node_list_init_in(HulkNodeList *list, struct HulkASTContext_s *arena);
 void hulk_node_list_push(HulkNodeList *list, struct HulkNode_s *node);
+// Asegura capacidad para `n` elementos en total (una sola asignación).
+void hulk_node_list_reserve(HulkNodeList *list, int n);
+// Con arena solo vacía la lista; sin arena libera el almacenamiento.
 void hulk_node_list_free(HulkNodeList *list);
 
 // ============== NODO BASE ==============
@@ -95,6 +113,10 @@ typedef struct HulkNode_s {
     HulkNodeType type;
     int line;   // posición en el fuente (1-based)
     int col;
+    // Id denso dentro de su HulkASTContext (0, 1, 2… en orden de
+    // creación). Índice de las tablas laterales (hulk_ast_side.h) donde
+    // cada fase guarda sus resultados por nodo.
+    unsigned id;
     // Tipo estático inferido por el análisis semántico (nombre canónico:
     // "Number" | "String" | "Boolean" | "Object" | "<UserType>"). NULL
     // antes del análisis. Esto materializa el "árbol semántico anotado":
@@ -115,9 +137,9 @@ typedef struct {
 // function name(params): ReturnType -> body | { body }
 typedef struct {
     HulkNode base;
-    char *name;
+    const char *name;
     HulkNodeList params;       // VarBindingNode (name + type)
-    char *return_type;         // NULL si no tiene anotación
+    const char *return_type;   // NULL si no tiene anotación
     HulkNode *body;            // Expr o BlockStmt
 } FunctionDefNode;
 
@@ -125,7 +147,7 @@ typedef struct {
 typedef struct {
     HulkNode base;
     HulkNodeList params;       // VarBindingNode
-    char *return_type;         // NULL si no tiene anotación
+    const char *return_type;   // NULL si no tiene anotación
     HulkNode *body;            // Expr o BlockStmt
     HulkNodeList captures;     // IdentNode con variables capturadas
 } FunctionExprNode;
@@ -134,9 +156,9 @@ typedef struct {
 // O protocol Name [extends Parent] { method_sigs } cuando is_protocol=1
 typedef struct {
     HulkNode base;
-    char *name;
+    const char *name;
     HulkNodeList params;       // ArgId (name + type)
-    char *parent;              // NULL si no hereda / extends
+    const char *parent;        // NULL si no hereda / extends
     HulkNodeList parent_args;  // args del padre (puede estar vacía)
     HulkNodeList members;      // MethodDef | AttributeDef (o sigs si is_protocol)
     int is_protocol;           // 1 si proviene de `protocol`
@@ -145,9 +167,9 @@ typedef struct {
 // Método dentro de type: name(params): Type -> body
 typedef struct {
     HulkNode base;
-    char *name;
+    const char *name;
     HulkNodeList params;
-    char *return_type;
+    const char *return_type;
     HulkNode *body;
     HulkNodeList decorators;   // DecorItemNode
 } MethodDefNode;
@@ -155,8 +177,8 @@ typedef struct {
 // Atributo dentro de type: name: Type = expr;
 typedef struct {
     HulkNode base;
-    char *name;
-    char *type_annotation;     // NULL si no tiene
+    const char *name;
+    const char *type_annotation;     // NULL si no tiene
     HulkNode *init_expr;
 } AttributeDefNode;
 
@@ -170,8 +192,8 @@ typedef struct {
 // name: Type = expr  (usado en let y en parámetros)
 typedef struct {
     HulkNode base;
-    char *name;
-    char *type_annotation;     // NULL si no tiene
+    const char *name;
+    const char *type_annotation;     // NULL si no tiene
     HulkNode *init_expr;       // NULL para parámetros sin default
 } VarBindingNode;
 
@@ -201,7 +223,7 @@ typedef struct {
 // for (name in iterable) body
 typedef struct {
     HulkNode base;
-    char *var_name;
+    const char *var_name;
     HulkNode *iterable;
     HulkNode *body;
 } ForStmtNode;
@@ -246,10 +268,27 @@ typedef struct {
     int value;    // 1 = true, 0 = false
 } BoolLitNode;
 
+// A qué resolvió el semántico un uso de nombre. Codegen lo usa para ir
+// directo a su tabla (alloca de la declaración, captura de la lambda,
+// función global) sin buscar por nombre en la cadena de scopes.
+typedef enum {
+    HULK_BIND_NONE = 0,  // sin resolver (antes del semántico, o con error)
+    HULK_BIND_LOCAL,     // variable o parámetro declarado por `decl`
+    HULK_BIND_CAPTURE,   // variable externa: `slot` en captures de la lambda
+    HULK_BIND_GLOBAL,    // función o tipo global; `decl` NULL si es built-in
+} HulkBindKind;
+
+typedef struct {
+    HulkBindKind kind;
+    int          slot;   // índice de captura (HULK_BIND_CAPTURE)
+    HulkNode    *decl;   // VarBinding, For o FunctionDef que lo declaró
+} HulkBinding;
+
 // identificador (variable, referencia a tipo, etc.)
 typedef struct {
     HulkNode base;
-    char *name;
+    const char *name;
+    HulkBinding binding;       // lo completa el semántico
 } IdentNode;
 
 // callee(args)
@@ -263,13 +302,13 @@ typedef struct {
 typedef struct {
     HulkNode base;
     HulkNode *object;
-    char *member;
+    const char *member;
 } MemberAccessNode;
 
 // new TypeName(args)
 typedef struct {
     HulkNode base;
-    char *type_name;
+    const char *type_name;
     HulkNodeList args;
 } NewExprNode;
 
@@ -291,14 +330,14 @@ typedef struct {
 typedef struct {
     HulkNode base;
     HulkNode *expr;
-    char *type_name;
+    const char *type_name;
 } AsExprNode;
 
 // expr is TypeName  (comparación de tipos)
 typedef struct {
     HulkNode base;
     HulkNode *expr;
-    char *type_name;
+    const char *type_name;
 } IsExprNode;
 
 // self
@@ -322,7 +361,7 @@ typedef struct {
 // Un decorador individual: name(args) o solo name
 typedef struct {
     HulkNode base;
-    char *name;
+    const char *name;
     HulkNodeList args;         // vacía si no tiene paréntesis
 } DecorItemNode;
 
@@ -350,13 +389,27 @@ typedef struct {
 // ============== OBJECT POOL / ARENA ==============
 // Todos los nodos se asignan desde esta arena.
 // Se liberan todos juntos con hulk_ast_context_free().
-
-#define HULK_AST_POOL_INIT_CAP 256
-
-typedef struct {
-    void **blocks;       // punteros a bloques asignados
-    int block_count;
-    int block_capacity;
+//
+// Arena por regiones: pide chunks grandes con calloc y reparte memoria
+// avanzando un puntero (alineado a HULK_AST_ALIGN). Nunca se reutiliza
+// memoria dentro de un chunk, así que todo bloque sale en cero sin
+// memset. Los pedidos mayores que HULK_AST_LARGE_ALLOC van a un chunk
+// propio para no desperdiciar el resto del chunk actual. Liberar cuesta
+// O(chunks), no O(nodos).
+
+#define HULK_AST_CHUNK_SIZE  (64 * 1024)
+#define HULK_AST_LARGE_ALLOC (HULK_AST_CHUNK_SIZE / 4)
+#define HULK_AST_ALIGN \
+    sizeof(union { void *p; double d; long long ll; size_t z; })
+
+typedef struct HulkASTChunk HulkASTChunk;
+
+typedef struct HulkASTContext_s {
+    HulkASTChunk *chunks;     // chunk actual primero; el resto detrás
+    int    chunk_count;
+    long   alloc_count;       // pedidos servidos (nodos, strings, listas)
+    size_t alloc_bytes;       // bytes pedidos, sin relleno de alineación
+    unsigned node_count;      // ids asignados: el próximo nodo recibe este
 } HulkASTContext;
 
 void  hulk_ast_context_init(HulkASTContext *ctx);
@@ -364,6 +417,16 @@ void  hulk_ast_context_free(HulkASTContext *ctx);
 void* hulk_ast_alloc(HulkASTContext *ctx, size_t size);
 char* hulk_ast_strdup(HulkASTContext *ctx, const char *s);
 
+// Transfiere todos los chunks de `src` a `dst` (los nodos de src pasan a
+// vivir y morir con dst) sin copiar nodos ni asignar: solo enlaza la
+// lista de chunks. `src` queda vacío. Retorna 1. Las listas del árbol
+// `root` (puede ser NULL) que crecían en src pasan a crecer en dst, así
+// src puede dejar de existir. Los ids de src se solapan con los de dst:
+// el caller que los mezcla los corre antes con
+// hulk_ast_shift_ids(raíz, dst->node_count); adopt suma el conteo.
+int   hulk_ast_context_adopt(HulkASTContext *dst, HulkASTContext *src,
+                             HulkNode *root);
+
 // ============== FUNCIONES DE CREACIÓN DE NODOS ==============
 // Cada función asigna desde el pool y retorna el nodo inicializado.
 // El caller agrega hijos usando hulk_node_list_push().
@@ -426,6 +489,52 @@ void hulk_ast_accept(HulkNode *node, HulkASTVisitor *visitor, void *data);
 // Recorre un HulkNodeList aceptando cada elemento
 void hulk_ast_accept_list(HulkNodeList *list, HulkASTVisitor *visitor, void *data);
 
+// ============== HIJOS GENÉRICOS ==============
+// Hijos de un nodo en orden canónico: primero los hijos fijos (pueden
+// ser NULL, p.ej. un else ausente) y luego las listas, cada una en el
+// orden de los campos del struct. Permite recorridos que no dependen del
+// tipo concreto (aplanado, conteos, búsquedas). Los hijos fijos se dan
+// por dirección del campo, así también sirven para asignarlos.
+
+#define HULK_MAX_FIXED_CHILDREN 3
+#define HULK_MAX_CHILD_LISTS    3
+
+typedef struct {
+    HulkNode    **fixed[HULK_MAX_FIXED_CHILDREN];
+    int           nfixed;
+    HulkNodeList *lists[HULK_MAX_CHILD_LISTS];
+    int           nlists;
+} HulkNodeSlots;
+
+void hulk_ast_slots(HulkNode *node, HulkNodeSlots *out);
+
+// Datos propios de un nodo (los que no son hijos): nombre internado
+// (name, var_name, member, type_name) o texto de un literal (en la
+// arena, `literal` = 1), anotación internada (return_type,
+// type_annotation, parent) y flags (BinaryOp, is_not, valor de Bool o
+// is_protocol). Lo que el nodo no tiene queda en NULL / 0.
+typedef struct {
+    const char *name;
+    const char *type_ref;
+    int         flags;
+    int         literal;
+} HulkNodePayload;
+
+void hulk_ast_payload(HulkNode *node, HulkNodePayload *out);
+
+// Suma `offset` al id de cada nodo del subárbol (para juntar árboles
+// construidos en contextos distintos sin repetir ids).
+void hulk_ast_shift_ids(HulkNode *root, unsigned offset);
+
+// Las listas del subárbol que toman almacenamiento de `from` pasan a
+// tomarlo de `to` (los bloques ya asignados no se mueven).
+void hulk_ast_rehome_lists(HulkNode *root, HulkASTContext *from,
+                           HulkASTContext *to);
+
+// Copia profunda del subárbol en `ctx`, con ids nuevos y sin anotar
+// (static_type y bindings en cero). Nombres y literales se comparten.
+HulkNode* hulk_ast_clone(HulkASTContext *ctx, HulkNode *node);
+
 // ============== NOMBRES PARA DEBUGGING ==============
 
 const char* hulk_node_type_name(HulkNodeType type);
@@ -0,0 +1,353 @@
+/*
+ * hulk_ast_cache.c — Serialización del AST plano a disco y carga por mmap
+ *
+ * Formato (enteros en el orden de bytes de la máquina; cada sección
+ * alineada a 8 bytes y en este orden):
+ *
+ *   CacheHeader
+ *   kind u8[count]   flags u8[count]   line i32[count]   col i32[count]
+ *   first u32[count] nchildren u32[count]
+ *   name u32[count]  type_ref u32[count]     índices a la tabla de strings
+ *   children u32[child_len]
+ *   str_off u32[nstrings + 1]                 inicio de cada string
+ *   str_bytes u8[str_bytes]                   strings terminados en '\0'
+ *   source u8[source_len]                     el fuente, byte a byte
+ *
+ * Las posiciones se derivan de los contadores de la cabecera
+ * (cache_layout), así que no hay offsets que validar aparte del tamaño
+ * total del archivo. El hash del fuente solo nombra el archivo: una
+ * entrada vale si el fuente guardado es idéntico, así que una colisión
+ * del hash es un fallo de caché y no el AST de otro programa.
+ */
+
+#include "hulk_ast_cache.h"
+#include "hulk_ast_flat.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CACHE_MAGIC "HULKAST"   // 8 bytes con el '\0'
+#define CACHE_NONE  0xFFFFFFFFu
+
+typedef struct {
+    char     magic[8];
+    uint32_t format;
+    uint32_t node_kinds;        // NODE_HULK_COUNT al escribir
+    uint64_t compiler;          // sello del ejecutable
+    uint64_t source_hash;
+    uint64_t source_len;
+    uint32_t count, child_len, nstrings, str_bytes;
+} CacheHeader;
+
+enum {
+    SEC_KIND, SEC_FLAGS, SEC_LINE, SEC_COL, SEC_FIRST, SEC_NCHILDREN,
+    SEC_NAME, SEC_TYPE_REF, SEC_CHILDREN, SEC_STR_OFF, SEC_STR_BYTES,
+    SEC_SOURCE, SEC_COUNT
+};
+
+// Posición de cada sección y tamaño total del archivo.
+static uint64_t cache_layout(const CacheHeader *h, uint64_t off[SEC_COUNT]) {
+    uint64_t n = h->count;
+    uint64_t size[SEC_COUNT] = {
+        [SEC_KIND] = n,          [SEC_FLAGS] = n,
+        [SEC_LINE] = n * 4,      [SEC_COL] = n * 4,
+        [SEC_FIRST] = n * 4,     [SEC_NCHILDREN] = n * 4,
+        [SEC_NAME] = n * 4,      [SEC_TYPE_REF] = n * 4,
+        [SEC_CHILDREN] = (uint64_t)h->child_len * 4,
+        [SEC_STR_OFF] = ((uint64_t)h->nstrings + 1) * 4,
+        [SEC_STR_BYTES] = h->str_bytes,
+        [SEC_SOURCE] = h->source_len,
+    };
+    uint64_t at = sizeof(CacheHeader);
+    for (int s = 0; s < SEC_COUNT; s++) {
+        at = (at + 7) & ~(uint64_t)7;
+        off[s] = at;
+        at += size[s];
+    }
+    return at;
+}
+
+// ============== CLAVES ==============
+
+static uint64_t fnv1a64(const void *data, size_t len, uint64_t h) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+#define FNV64_BASIS 14695981039346656037ull
+
+// Sello del compilador: cambia cada vez que se recompila el ejecutable.
+// 0 si no se puede obtener (la caché queda deshabilitada).
+static uint64_t compiler_stamp(void) {
+    struct stat st;
+    if (stat("/proc/self/exe", &st) != 0) return 0;
+    uint64_t parts[5] = {
+        HULK_AST_CACHE_FORMAT, (uint64_t)st.st_size, (uint64_t)st.st_ino,
+        (uint64_t)st.st_mtim.tv_sec, (uint64_t)st.st_mtim.tv_nsec,
+    };
+    return fnv1a64(parts, sizeof(parts), FNV64_BASIS);
+}
+
+int hulk_ast_cache_path(char *out, size_t cap, const char *dir,
+                        const char *source) {
+    uint64_t h = fnv1a64(source, strlen(source), FNV64_BASIS);
+    int n = snprintf(out, cap, "%s/%016llx.hulkast", dir, (unsigned long long)h);
+    return n > 0 && (size_t)n < cap;
+}
+
+// ============== TABLA DE STRINGS ==============
+// Los payloads del árbol plano están internados: se deduplican por
+// puntero con una tabla hash abierta sobre hulk_intern_hash.
+
+typedef struct {
+    const char **slots;         // string internado o NULL
+    uint32_t    *index;         // índice en la tabla del archivo
+    uint32_t     cap;
+    const char **strings;       // en orden de índice
+    uint32_t     count, bytes;
+} StringTable;
+
+static int strtab_init(StringTable *t, int nodes) {
+    t->cap = 64;
+    while (t->cap < (uint32_t)nodes * 4) t->cap *= 2;
+    t->slots = calloc(t->cap, sizeof(char*));
+    t->index = malloc(t->cap * sizeof(uint32_t));
+    t->strings = malloc(t->cap / 2 * sizeof(char*));
+    t->count = t->bytes = 0;
+    return t->slots && t->index && t->strings;
+}
+
+static void strtab_free(StringTable *t) {
+    free(t->slots);
+    free(t->index);
+    free(t->strings);
+}
+
+// La tabla tiene capacidad para 4 * nodos: nunca pasa de 1/2 de carga
+// porque cada nodo aporta a lo sumo dos strings.
+static uint32_t strtab_index(StringTable *t, const char *s) {
+    if (!s) return CACHE_NONE;
+    uint32_t mask = t->cap - 1;
+    uint32_t i = hulk_intern_hash(s) & mask;
+    while (t->slots[i] && t->slots[i] != s) i = (i + 1) & mask;
+    if (!t->slots[i]) {
+        t->slots[i] = s;
+        t->index[i] = t->count;
+        t->strings[t->count++] = s;
+        t->bytes += (uint32_t)hulk_intern_len(s) + 1;
+    }
+    return t->index[i];
+}
+
+// ============== ESCRITURA ==============
+
+static const uint8_t ZEROS[8];
+
+// Escribe `n` bytes en la posición `at` (>= *pos), rellenando con ceros.
+static int put(FILE *out, uint64_t *pos, uint64_t at, const void *p, size_t n) {
+    if (fwrite(ZEROS, 1, (size_t)(at - *pos), out) != at - *pos) return 0;
+    if (n && fwrite(p, 1, n, out) != n) return 0;
+    *pos = at + n;
+    return 1;
+}
+
+static int write_cache(FILE *out, const CacheHeader *h, const HulkFlatAST *f,
+                       const uint32_t *name, const uint32_t *type_ref,
+                       const StringTable *t, const char *source) {
+    uint64_t off[SEC_COUNT], pos = 0;
+    uint64_t total = cache_layout(h, off);
+    uint32_t *str_off = malloc(((size_t)t->count + 1) * sizeof(uint32_t));
+    if (!str_off) return 0;
+    uint32_t at = 0;
+    for (uint32_t i = 0; i < t->count; i++) {
+        str_off[i] = at;
+        at += (uint32_t)hulk_intern_len(t->strings[i]) + 1;
+    }
+    str_off[t->count] = at;
+
+    size_t n = (size_t)f->count;
+    int ok = put(out, &pos, 0, h, sizeof(*h)) &&
+             put(out, &pos, off[SEC_KIND], f->kind, n) &&
+             put(out, &pos, off[SEC_FLAGS], f->flags, n) &&
+             put(out, &pos, off[SEC_LINE], f->line, n * 4) &&
+             put(out, &pos, off[SEC_COL], f->col, n * 4) &&
+             put(out, &pos, off[SEC_FIRST], f->first, n * 4) &&
+             put(out, &pos, off[SEC_NCHILDREN], f->nchildren, n * 4) &&
+             put(out, &pos, off[SEC_NAME], name, n * 4) &&
+             put(out, &pos, off[SEC_TYPE_REF], type_ref, n * 4) &&
+             put(out, &pos, off[SEC_CHILDREN], f->children, (size_t)f->child_len * 4) &&
+             put(out, &pos, off[SEC_STR_OFF], str_off, ((size_t)t->count + 1) * 4);
+    for (uint32_t i = 0; ok && i < t->count; i++) {
+        const char *s = t->strings[i];
+        ok = put(out, &pos, i ? pos : off[SEC_STR_BYTES], s, hulk_intern_len(s) + 1);
+    }
+    if (ok) ok = put(out, &pos, off[SEC_SOURCE], source, (size_t)h->source_len);
+    if (ok) ok = put(out, &pos, total, NULL, 0);
+    free(str_off);
+    return ok;
+}
+
+int hulk_ast_cache_store(const char *dir, const char *source, HulkNode *ast) {
+    if (!dir || !source || !ast) return 0;
+    uint64_t stamp = compiler_stamp();
+    char path[4096], tmp[4200];
+    if (!stamp || !hulk_ast_cache_path(path, sizeof(path), dir, source))
+        return 0;
+
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    StringTable t = {0};
+    uint32_t *name = NULL, *type_ref = NULL;
+    int ok = hulk_flat_build(&f, ast) == 0 && strtab_init(&t, f.count);
+    if (ok) {
+        name = malloc((size_t)f.count * sizeof(uint32_t));
+        type_ref = malloc((size_t)f.count * sizeof(uint32_t));
+        ok = name && type_ref;
+    }
+    for (int i = 0; ok && i < f.count; i++) {
+        name[i] = strtab_index(&t, f.name[i]);
+        type_ref[i] = strtab_index(&t, f.type_ref[i]);
+    }
+
+    if (ok) {
+        CacheHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, CACHE_MAGIC, sizeof(h.magic));
+        h.format = HULK_AST_CACHE_FORMAT;
+        h.node_kinds = NODE_HULK_COUNT;
+        h.compiler = stamp;
+        h.source_len = strlen(source);
+        h.source_hash = fnv1a64(source, h.source_len, FNV64_BASIS);
+        h.count = (uint32_t)f.count;
+        h.child_len = f.child_len;
+        h.nstrings = t.count;
+        h.str_bytes = t.bytes;
+
+        snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+        FILE *out = fopen(tmp, "wb");
+        ok = out && write_cache(out, &h, &f, name, type_ref, &t, source);
+        if (out && fclose(out) != 0) ok = 0;
+        if (ok) ok = rename(tmp, path) == 0;
+        if (!ok && out) remove(tmp);
+    }
+
+    free(name);
+    free(type_ref);
+    strtab_free(&t);
+    hulk_flat_free(&f);
+    return ok;
+}
+
+// ============== LECTURA ==============
+
+static int header_matches(const CacheHeader *h, const char *source) {
+    uint64_t len = strlen(source);
+    return memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) == 0 &&
+           h->format == HULK_AST_CACHE_FORMAT &&
+           h->node_kinds == NODE_HULK_COUNT &&
+           h->compiler == compiler_stamp() &&
+           h->source_len == len &&
+           h->source_hash == fnv1a64(source, len, FNV64_BASIS);
+}
+
+// Interna la tabla de strings del archivo. NULL si está mal formada.
+static const char** load_strings(const CacheHeader *h, const char *base,
+                                 const uint64_t off[SEC_COUNT]) {
+    const uint32_t *str_off = (const uint32_t*)(base + off[SEC_STR_OFF]);
+    const char *bytes = base + off[SEC_STR_BYTES];
+    const char **out = malloc(((size_t)h->nstrings + 1) * sizeof(char*));
+    if (!out || str_off[0] != 0 || str_off[h->nstrings] != h->str_bytes) {
+        free(out);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < h->nstrings; i++) {
+        uint32_t a = str_off[i], b = str_off[i + 1];
+        if (b <= a || b > h->str_bytes || bytes[b - 1] != '\0') {
+            free(out);
+            return NULL;
+        }
+        out[i] = hulk_intern_n(bytes + a, b - a - 1);
+    }
+    return out;
+}
+
+// Traduce índices de string a punteros internados.
+static int fix_names(const char **dst, const uint32_t *idx, uint32_t n,
+                     const char **strings, uint32_t nstrings) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (idx[i] == CACHE_NONE) dst[i] = NULL;
+        else if (idx[i] < nstrings) dst[i] = strings[idx[i]];
+        else return 0;
+    }
+    return 1;
+}
+
+static HulkNode* load_mapped(HulkASTContext *ctx, const char *base,
+                             size_t size, const char *source) {
+    const CacheHeader *h = (const CacheHeader*)base;
+    uint64_t off[SEC_COUNT];
+    if (size < sizeof(*h) || !header_matches(h, source) ||
+        cache_layout(h, off) != size ||
+        memcmp(base + off[SEC_SOURCE], source, (size_t)h->source_len) != 0)
+        return NULL;
+
+    const char **strings = load_strings(h, base, off);
+    if (!strings) return NULL;
+
+    // Vista del árbol plano sobre el mapeo: solo los payloads se copian
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    f.count = f.cap = (int)h->count;
+    f.kind      = (uint8_t*)(base + off[SEC_KIND]);
+    f.flags     = (uint8_t*)(base + off[SEC_FLAGS]);
+    f.line      = (int32_t*)(base + off[SEC_LINE]);
+    f.col       = (int32_t*)(base + off[SEC_COL]);
+    f.first     = (uint32_t*)(base + off[SEC_FIRST]);
+    f.nchildren = (uint32_t*)(base + off[SEC_NCHILDREN]);
+    f.children  = (HulkFlatId*)(base + off[SEC_CHILDREN]);
+    f.child_len = f.child_cap = h->child_len;
+    f.name      = malloc(((size_t)h->count + 1) * sizeof(char*));
+    f.type_ref  = malloc(((size_t)h->count + 1) * sizeof(char*));
+
+    HulkNode *root = NULL;
+    if (f.name && f.type_ref &&
+        fix_names(f.name, (const uint32_t*)(base + off[SEC_NAME]), h->count,
+                  strings, h->nstrings) &&
+        fix_names(f.type_ref, (const uint32_t*)(base + off[SEC_TYPE_REF]), h->count,
+                  strings, h->nstrings) &&
+        hulk_flat_validate(&f) && f.kind[0] == NODE_PROGRAM)
+        root = hulk_flat_to_ast(ctx, &f, 0);
+
+    free(f.name);
+    free(f.type_ref);
+    free(strings);
+    return root;
+}
+
+HulkNode* hulk_ast_cache_load(HulkASTContext *ctx, const char *dir,
+                              const char *source) {
+    if (!ctx || !dir || !source) return NULL;
+    char path[4096];
+    if (!hulk_ast_cache_path(path, sizeof(path), dir, source)) return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(CacheHeader))
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    HulkNode *root = load_mapped(ctx, map, (size_t)st.st_size, source);
+    munmap(map, (size_t)st.st_size);
+    return root;
+}
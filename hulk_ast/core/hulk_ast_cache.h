@@ -0,0 +1,49 @@
+/*
+ * hulk_ast_cache.h — Caché persistente del AST en disco
+ *
+ * Guarda el AST recién parseado en `<dir>/<hash del fuente>.hulkast` y
+ * en corridas siguientes sobre el mismo fuente lo recupera sin construir
+ * el DFA ni lexear ni parsear. El archivo es la forma plana del AST
+ * (hulk_ast_flat) con los nombres en una tabla de strings: no contiene
+ * punteros, solo índices y offsets, así que se mapea con mmap y se
+ * reconstruye el AST de punteros en la arena (internando cada string
+ * una vez y enlazando hijos por id).
+ *
+ * La entrada guarda el fuente completo y solo vale para un fuente
+ * idéntico byte a byte (el hash de 64 bits nombra el archivo y descarta
+ * rápido). La cabecera identifica además el compilador (versión del
+ * formato y sello del ejecutable: tamaño y mtime de /proc/self/exe), así
+ * que recompilar hulk invalida todo lo guardado. Un archivo ausente, de
+ * otra versión, truncado o corrupto es simplemente un fallo de caché:
+ * nunca un error.
+ *
+ * Solo deben guardarse ASTs de programas sin errores léxicos ni
+ * sintácticos; esa decisión es del caller.
+ *
+ * Responsabilidad única (SRP): solo serializa y recupera; no parsea.
+ */
+
+#ifndef HULK_AST_CACHE_H
+#define HULK_AST_CACHE_H
+
+#include "hulk_ast.h"
+#include <stdint.h>
+
+#define HULK_AST_CACHE_FORMAT 1
+
+// Busca en `dir` el AST de `source` y lo reconstruye en `ctx`. Retorna
+// el ProgramNode o NULL si no hay entrada válida.
+HulkNode* hulk_ast_cache_load(HulkASTContext *ctx, const char *dir,
+                              const char *source);
+
+// Guarda `ast` (el AST de `source`) en `dir`, que debe existir. La
+// escritura es atómica (archivo temporal + rename). Retorna 1 si lo
+// guardó.
+int hulk_ast_cache_store(const char *dir, const char *source, HulkNode *ast);
+
+// Ruta de la entrada de `source` en `dir` (para tests y diagnósticos).
+// Retorna 0 si no entra en `cap` bytes.
+int hulk_ast_cache_path(char *out, size_t cap, const char *dir,
+                        const char *source);
+
+#endif /* HULK_AST_CACHE_H */
@@ -2,9 +2,10 @@
  * hulk_ast_context.c — Arena (Object Pool) y HulkNodeList
  *
  * Gestión de memoria del AST:
- *   - HulkNodeList: lista dinámica de punteros a nodos
- *   - HulkASTContext: arena que registra todos los bloques asignados
- *     y los libera en batch con hulk_ast_context_free()
+ *   - HulkNodeList: lista dinámica de punteros a nodos; si pertenece a un
+ *     nodo, su almacenamiento sale de la misma arena
+ *   - HulkASTContext: arena por chunks con asignación por puntero que
+ *     avanza, liberada en batch con hulk_ast_context_free()
  *
  * SRP: Solo gestión de memoria y estructuras de datos auxiliares.
  */
@@ -21,69 +22,145 @@ void hulk_node_list_init(HulkNodeList *list) {
     list->items    = NULL;
     list->count    = 0;
     list->capacity = 0;
+    list->arena    = NULL;
+}
+
+void hulk_node_list_init_in(HulkNodeList *list, HulkASTContext *arena) {
+    hulk_node_list_init(list);
+    list->arena = arena;
+}
+
+void hulk_node_list_reserve(HulkNodeList *list, int n) {
+    if (n <= list->capacity) return;
+    HulkNode **items;
+    if (list->arena) {
+        // El bloque viejo queda en la arena: crecer al doble acota el
+        // desperdicio al tamaño final de la lista.
+        items = hulk_ast_alloc(list->arena, sizeof(HulkNode*) * n);
+        if (items && list->count > 0)
+            memcpy(items, list->items, sizeof(HulkNode*) * list->count);
+    } else {
+        items = realloc(list->items, sizeof(HulkNode*) * n);
+    }
+    if (!items) {
+        LOG_FATAL_MSG("hulk_ast", "sin memoria para HulkNodeList");
+        return;
+    }
+    list->items    = items;
+    list->capacity = n;
 }
 
 void hulk_node_list_push(HulkNodeList *list, HulkNode *node) {
     if (list->count >= list->capacity) {
-        int new_cap = list->capacity == 0 ? 4 : list->capacity * 2;
-        list->items = realloc(list->items, sizeof(HulkNode*) * new_cap);
-        if (!list->items) {
-            LOG_FATAL_MSG("hulk_ast", "sin memoria para HulkNodeList");
-            return;
-        }
-        list->capacity = new_cap;
+        hulk_node_list_reserve(list, list->capacity == 0 ? 4 : list->capacity * 2);
+        if (list->count >= list->capacity) return;
     }
     list->items[list->count++] = node;
 }
 
 void hulk_node_list_free(HulkNodeList *list) {
-    if (list->items) {
+    if (list->items && !list->arena)
         free(list->items);
-        list->items = NULL;
-    }
-    list->count = 0;
+    list->items    = NULL;
+    list->count    = 0;
     list->capacity = 0;
 }
 
 // ============== OBJECT POOL (ARENA) ==============
 
+struct HulkASTChunk {
+    HulkASTChunk *next;
+    size_t        size;   // bytes utilizables en data
+    size_t        used;
+    union { void *p; double d; long long ll; size_t z; } data[];
+};
+
+static size_t align_up(size_t n) {
+    return (n + HULK_AST_ALIGN - 1) & ~(HULK_AST_ALIGN - 1);
+}
+
+static HulkASTChunk* chunk_new(size_t size) {
+    HulkASTChunk *c = calloc(1, sizeof(HulkASTChunk) + size);
+    if (!c) return NULL;
+    c->size = size;
+    return c;
+}
+
 void hulk_ast_context_init(HulkASTContext *ctx) {
-    ctx->blocks         = NULL;
-    ctx->block_count    = 0;
-    ctx->block_capacity = 0;
+    ctx->chunks      = NULL;
+    ctx->chunk_count = 0;
+    ctx->alloc_count = 0;
+    ctx->alloc_bytes = 0;
+    ctx->node_count  = 0;
 }
 
 void hulk_ast_context_free(HulkASTContext *ctx) {
-    for (int i = 0; i < ctx->block_count; i++) {
-        free(ctx->blocks[i]);
+    HulkASTChunk *c = ctx->chunks;
+    while (c) {
+        HulkASTChunk *next = c->next;
+        free(c);
+        c = next;
     }
-    free(ctx->blocks);
-    ctx->blocks         = NULL;
-    ctx->block_count    = 0;
-    ctx->block_capacity = 0;
+    hulk_ast_context_init(ctx);
 }
 
 void* hulk_ast_alloc(HulkASTContext *ctx, size_t size) {
-    void *block = calloc(1, size);
-    if (!block) {
-        LOG_FATAL_MSG("hulk_ast", "sin memoria (%zu bytes)", size);
-        return NULL;
-    }
-    // Registrar en el pool para liberación posterior
-    if (ctx->block_count >= ctx->block_capacity) {
-        int new_cap = ctx->block_capacity == 0
-                      ? HULK_AST_POOL_INIT_CAP
-                      : ctx->block_capacity * 2;
-        ctx->blocks = realloc(ctx->blocks, sizeof(void*) * new_cap);
-        if (!ctx->blocks) {
-            LOG_FATAL_MSG("hulk_ast", "sin memoria para pool");
-            free(block);
-            return NULL;
-        }
-        ctx->block_capacity = new_cap;
+    size_t need = align_up(size ? size : 1);
+    HulkASTChunk *cur = ctx->chunks;
+    void *block;
+
+    if (cur && cur->size - cur->used >= need) {
+        block = (char*)cur->data + cur->used;
+        cur->used += need;
+    } else if (need > HULK_AST_LARGE_ALLOC) {
+        // Chunk propio detrás del actual: el actual sigue repartiendo
+        HulkASTChunk *big = chunk_new(need);
+        if (!big) goto oom;
+        big->used = need;
+        if (cur) { big->next = cur->next; cur->next = big; }
+        else ctx->chunks = big;
+        ctx->chunk_count++;
+        block = big->data;
+    } else {
+        HulkASTChunk *fresh = chunk_new(HULK_AST_CHUNK_SIZE);
+        if (!fresh) goto oom;
+        fresh->next = cur;
+        fresh->used = need;
+        ctx->chunks = fresh;
+        ctx->chunk_count++;
+        block = fresh->data;
     }
-    ctx->blocks[ctx->block_count++] = block;
+    ctx->alloc_count++;
+    ctx->alloc_bytes += size;
     return block;
+
+oom:
+    LOG_FATAL_MSG("hulk_ast", "sin memoria (%zu bytes)", size);
+    return NULL;
+}
+
+int hulk_ast_context_adopt(HulkASTContext *dst, HulkASTContext *src,
+                           HulkNode *root) {
+    // Sin esto la próxima lista que crezca asignaría desde src, que el
+    // caller suele liberar (o tener en la pila) tras adoptar.
+    hulk_ast_rehome_lists(root, src, dst);
+    if (!src->chunks) return 1;
+    // Los chunks de src van detrás del actual de dst: dst sigue
+    // repartiendo desde el suyo.
+    HulkASTChunk *tail = src->chunks;
+    while (tail->next) tail = tail->next;
+    if (dst->chunks) {
+        tail->next = dst->chunks->next;
+        dst->chunks->next = src->chunks;
+    } else {
+        dst->chunks = src->chunks;
+    }
+    dst->chunk_count += src->chunk_count;
+    dst->alloc_count += src->alloc_count;
+    dst->alloc_bytes += src->alloc_bytes;
+    dst->node_count += src->node_count;
+    hulk_ast_context_init(src);
+    return 1;
 }
 
 char* hulk_ast_strdup(HulkASTContext *ctx, const char *s) {
@@ -0,0 +1,493 @@
+/*
+ * hulk_ast_facts.c — Recolección fusionada de hechos por cuerpo
+ *
+ * Un único recorrido por raíz. Cada arista lleva una máscara con las
+ * heurísticas que la cruzan (las originales no descendían todas por los
+ * mismos hijos: p.ej. la de self.x no entra en `for`), así cada hecho
+ * ve exactamente los nodos que veía su walker. Las variables libres de
+ * lambdas usan una pila de ligaduras y una pila de lambdas abiertas: un
+ * identificador es libre en cada lambda abierta después de su ligadura
+ * más interna.
+ */
+
+#include "hulk_ast_facts.h"
+#include "../../error_handler.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Heurísticas que cruzan una arista
+#define REACH_OPERAND  1u   // uso de x como operando / argumento
+#define REACH_SELF     2u   // uso de self.x como operando
+#define REACH_CALLS    4u   // x(...) como llamada
+#define REACH_CONCAT   8u   // self.x en @
+#define REACH_ALL      15u
+#define REACH_EXPR     (REACH_OPERAND | REACH_SELF | REACH_CALLS)
+
+struct HulkNodeFacts_s {
+    HulkNode      *node;
+
+    int            has_body;     // node fue raíz de una pasada
+    HulkNameFacts *names;        // hash abierto por puntero del nombre
+    int            name_cap, name_count;
+    HulkArgUse    *args;
+    int            arg_count, arg_cap;
+    HulkAlias     *aliases;
+    int            alias_count, alias_cap;
+
+    int            has_free;     // node es una lambda ya anotada
+    const char   **free_names;
+    int            free_count, free_cap;
+};
+
+HulkUseTag hulk_use_join(HulkUseTag a, HulkUseTag b) {
+    if (a == b) return a;
+    if (a == HULK_USE_NONE) return b;
+    if (b == HULK_USE_NONE) return a;
+    return HULK_USE_NUMBER;  // Number gana en conflicto
+}
+
+static unsigned ptr_hash(const void *p) {
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (unsigned)x;
+}
+
+static void* grow(void *p, int *cap, size_t elem, int min) {
+    int nc = *cap ? *cap * 2 : min;
+    void *np = realloc(p, (size_t)nc * elem);
+    if (!np) {
+        LOG_FATAL_MSG("hulk_ast_facts", "sin memoria para la tabla de hechos");
+        return NULL;
+    }
+    *cap = nc;
+    return np;
+}
+
+// ============== TABLA NODO → HECHOS ==============
+
+void hulk_facts_init(HulkFacts *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+void hulk_facts_free(HulkFacts *t) {
+    for (int i = 0; i < t->cap; i++) {
+        HulkNodeFacts *e = t->slots[i];
+        if (!e) continue;
+        free(e->names);
+        free(e->args);
+        free(e->aliases);
+        free(e->free_names);
+        free(e);
+    }
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+static HulkNodeFacts** node_slot(HulkFacts *t, HulkNode *n) {
+    unsigned mask = (unsigned)t->cap - 1;
+    unsigned i = ptr_hash(n) & mask;
+    while (t->slots[i] && t->slots[i]->node != n) i = (i + 1) & mask;
+    return &t->slots[i];
+}
+
+static HulkNodeFacts* node_find(HulkFacts *t, HulkNode *n) {
+    return t->cap ? *node_slot(t, n) : NULL;
+}
+
+static HulkNodeFacts* node_get(HulkFacts *t, HulkNode *n) {
+    HulkNodeFacts *e = node_find(t, n);
+    if (e) return e;
+    if ((t->count + 1) * 2 > t->cap) {
+        int ocap = t->cap;
+        HulkNodeFacts **old = t->slots;
+        int ncap = ocap ? ocap * 2 : 64;
+        HulkNodeFacts **ns = calloc((size_t)ncap, sizeof(*ns));
+        if (!ns) return NULL;
+        t->slots = ns;
+        t->cap = ncap;
+        for (int i = 0; i < ocap; i++)
+            if (old[i]) *node_slot(t, old[i]->node) = old[i];
+        free(old);
+    }
+    e = calloc(1, sizeof(*e));
+    if (!e) return NULL;
+    e->node = n;
+    *node_slot(t, n) = e;
+    t->count++;
+    return e;
+}
+
+// ============== HECHOS POR NOMBRE ==============
+
+static HulkNameFacts* name_slot(HulkNameFacts *names, int cap,
+                                const char *name) {
+    unsigned mask = (unsigned)cap - 1;
+    unsigned i = ptr_hash(name) & mask;
+    while (names[i].name && names[i].name != name) i = (i + 1) & mask;
+    return &names[i];
+}
+
+static HulkNameFacts* name_get(HulkNodeFacts *e, const char *name) {
+    if (e->name_cap) {
+        HulkNameFacts *f = name_slot(e->names, e->name_cap, name);
+        if (f->name) return f;
+    }
+    if ((e->name_count + 1) * 2 > e->name_cap) {
+        int ocap = e->name_cap;
+        int ncap = ocap ? ocap * 2 : 16;
+        HulkNameFacts *nn = calloc((size_t)ncap, sizeof(*nn));
+        if (!nn) return NULL;
+        for (int i = 0; i < ocap; i++)
+            if (e->names[i].name)
+                *name_slot(nn, ncap, e->names[i].name) = e->names[i];
+        free(e->names);
+        e->names = nn;
+        e->name_cap = ncap;
+    }
+    HulkNameFacts *f = name_slot(e->names, e->name_cap, name);
+    f->name = name;
+    f->first_arg = -1;
+    e->name_count++;
+    return f;
+}
+
+// ============== RECORRIDO ==============
+
+typedef struct {
+    HulkNodeFacts *facts;    // lambda que se está anotando (NULL: ya estaba)
+    int            bound_base;
+} OpenLambda;
+
+typedef struct {
+    HulkFacts     *table;
+    HulkNodeFacts *body;     // raíz de la pasada (NULL si solo lambdas)
+
+    const char   **bound;    // ligaduras visibles, la más interna al final
+    int            nbound, bound_cap;
+    OpenLambda    *open;
+    int            nopen, open_cap;
+} FactWalk;
+
+static HulkNode* self_member_of(HulkNode *n) {
+    if (!n || n->type != NODE_MEMBER_ACCESS) return NULL;
+    MemberAccessNode *ma = (MemberAccessNode*)n;
+    if (!ma->object || ma->object->type != NODE_SELF || !ma->member)
+        return NULL;
+    return n;
+}
+
+static void note_operand(FactWalk *w, HulkNode *n, unsigned reach,
+                         HulkUseTag tag) {
+    if (!n) return;
+    if ((reach & REACH_OPERAND) && n->type == NODE_IDENT &&
+        ((IdentNode*)n)->name) {
+        HulkNameFacts *f = name_get(w->body, ((IdentNode*)n)->name);
+        if (f) f->operand = hulk_use_join(f->operand, tag);
+    }
+    if ((reach & REACH_SELF) && self_member_of(n)) {
+        HulkNameFacts *f = name_get(w->body, ((MemberAccessNode*)n)->member);
+        if (f) f->self_operand = hulk_use_join(f->self_operand, tag);
+    }
+}
+
+static void note_call(FactWalk *w, CallExprNode *ce, unsigned reach) {
+    if (!ce->callee || ce->callee->type != NODE_IDENT) return;
+    const char *callee = ((IdentNode*)ce->callee)->name;
+    if (!callee) return;
+    if (reach & REACH_CALLS) {
+        HulkNameFacts *f = name_get(w->body, callee);
+        if (f) f->called = 1;
+    }
+    if (!(reach & REACH_OPERAND)) return;
+    for (int i = 0; i < ce->args.count; i++) {
+        HulkNode *a = ce->args.items[i];
+        if (!a || a->type != NODE_IDENT || !((IdentNode*)a)->name) continue;
+        HulkNodeFacts *e = w->body;
+        if (e->arg_count >= e->arg_cap) {
+            HulkArgUse *na = grow(e->args, &e->arg_cap, sizeof(*na), 16);
+            if (!na) return;
+            e->args = na;
+        }
+        HulkNameFacts *f = name_get(e, ((IdentNode*)a)->name);
+        if (!f) return;
+        e->args[e->arg_count] = (HulkArgUse){ callee, i, f->first_arg };
+        f->first_arg = e->arg_count++;
+    }
+}
+
+static void note_alias(FactWalk *w, VarBindingNode *vb) {
+    HulkNode *init = vb->init_expr;
+    if (vb->type_annotation || !vb->name || !init ||
+        init->type != NODE_IDENT || !((IdentNode*)init)->name)
+        return;
+    HulkNodeFacts *e = w->body;
+    if (e->alias_count >= e->alias_cap) {
+        HulkAlias *na = grow(e->aliases, &e->alias_cap, sizeof(*na), 8);
+        if (!na) return;
+        e->aliases = na;
+    }
+    e->aliases[e->alias_count++] =
+        (HulkAlias){ vb->name, ((IdentNode*)init)->name };
+}
+
+static void bind(FactWalk *w, const char *name) {
+    if (w->nbound >= w->bound_cap) {
+        const char **nb = grow(w->bound, &w->bound_cap, sizeof(*nb), 32);
+        if (!nb) return;
+        w->bound = nb;
+    }
+    w->bound[w->nbound++] = name;
+}
+
+static void free_add(HulkNodeFacts *e, const char *name) {
+    for (int i = 0; i < e->free_count; i++)
+        if (e->free_names[i] == name) return;
+    if (e->free_count >= e->free_cap) {
+        const char **nf = grow(e->free_names, &e->free_cap, sizeof(*nf), 8);
+        if (!nf) return;
+        e->free_names = nf;
+    }
+    e->free_names[e->free_count++] = name;
+}
+
+// `name` usado con las lambdas [open_lo, nopen) alcanzándolo: es libre
+// en las que se abrieron después de su ligadura más interna.
+static void note_ident(FactWalk *w, const char *name, int open_lo) {
+    if (!name || open_lo >= w->nopen) return;
+    int floor = w->open[open_lo].bound_base;
+    int b = w->nbound - 1;
+    while (b >= floor && w->bound[b] != name) b--;
+    for (int k = w->nopen - 1; k >= open_lo && w->open[k].bound_base > b; k--)
+        if (w->open[k].facts) free_add(w->open[k].facts, name);
+}
+
+// `reach`: heurísticas que llegan a n. `open_lo`: primera lambda abierta
+// cuyo recolector de capturas llega a n (== nopen si ninguna).
+static void walk(FactWalk *w, HulkNode *n, unsigned reach, int open_lo) {
+    if (!n) return;
+    switch (n->type) {
+        case NODE_IDENT:
+            note_ident(w, ((IdentNode*)n)->name, open_lo);
+            return;
+        case NODE_FUNCTION_EXPR: {
+            FunctionExprNode *fn = (FunctionExprNode*)n;
+            HulkNodeFacts *e = node_get(w->table, n);
+            if (w->nopen >= w->open_cap) {
+                OpenLambda *no = grow(w->open, &w->open_cap, sizeof(*no), 8);
+                if (!no) return;
+                w->open = no;
+            }
+            int saved = w->nbound;
+            w->open[w->nopen++] = (OpenLambda){
+                (e && !e->has_free) ? e : NULL, saved };
+            for (int i = 0; i < fn->params.count; i++)
+                bind(w, ((VarBindingNode*)fn->params.items[i])->name);
+            walk(w, fn->body, 0, open_lo);
+            w->nbound = saved;
+            w->nopen--;
+            if (e) e->has_free = 1;
+            return;
+        }
+        case NODE_BINARY_OP: {
+            BinaryOpNode *b = (BinaryOpNode*)n;
+            HulkUseTag tag = HULK_USE_NONE;
+            switch (b->op) {
+                case OP_ADD: case OP_SUB: case OP_MUL:
+                case OP_DIV: case OP_MOD: case OP_POW:
+                case OP_LT: case OP_GT: case OP_LE: case OP_GE:
+                    tag = HULK_USE_NUMBER; break;
+                case OP_AND: case OP_OR:
+                    tag = HULK_USE_BOOLEAN; break;
+                default: break;
+            }
+            if (tag != HULK_USE_NONE) {
+                note_operand(w, b->left, reach, tag);
+                note_operand(w, b->right, reach, tag);
+            }
+            walk(w, b->left, reach, open_lo);
+            walk(w, b->right, reach, open_lo);
+            return;
+        }
+        case NODE_CONCAT_EXPR: {
+            ConcatExprNode *ce = (ConcatExprNode*)n;
+            HulkNode *side[2] = { ce->left, ce->right };
+            for (int i = 0; i < 2; i++) {
+                if (!self_member_of(side[i])) continue;
+                const char *m = ((MemberAccessNode*)side[i])->member;
+                if (reach & REACH_SELF) {
+                    HulkNameFacts *f = name_get(w->body, m);
+                    if (f) f->self_operand =
+                        hulk_use_join(f->self_operand, HULK_USE_STRING);
+                }
+                if (reach & REACH_CONCAT) {
+                    HulkNameFacts *f = name_get(w->body, m);
+                    if (f) f->self_concat = 1;
+                }
+            }
+            walk(w, ce->left, reach, open_lo);
+            walk(w, ce->right, reach, open_lo);
+            return;
+        }
+        case NODE_UNARY_OP: {
+            UnaryOpNode *u = (UnaryOpNode*)n;
+            note_operand(w, u->operand, reach & REACH_EXPR, HULK_USE_NUMBER);
+            walk(w, u->operand, reach & REACH_EXPR, open_lo);
+            return;
+        }
+        case NODE_CALL_EXPR: {
+            CallExprNode *ce = (CallExprNode*)n;
+            note_call(w, ce, reach);
+            walk(w, ce->callee, reach & REACH_CALLS, open_lo);
+            for (int i = 0; i < ce->args.count; i++)
+                walk(w, ce->args.items[i], reach, open_lo);
+            return;
+        }
+        case NODE_MEMBER_ACCESS:
+            walk(w, ((MemberAccessNode*)n)->object, 0, open_lo);
+            return;
+        case NODE_INDEX_EXPR: {
+            IndexExprNode *ix = (IndexExprNode*)n;
+            walk(w, ix->object, 0, open_lo);
+            walk(w, ix->index, 0, open_lo);
+            return;
+        }
+        case NODE_ASSIGN: {
+            AssignNode *a = (AssignNode*)n;
+            walk(w, a->target, 0, open_lo);
+            walk(w, a->value, reach & REACH_EXPR, open_lo);
+            return;
+        }
+        case NODE_DESTRUCT_ASSIGN: {
+            DestructAssignNode *d = (DestructAssignNode*)n;
+            walk(w, d->target, 0, open_lo);
+            walk(w, d->value, reach & REACH_EXPR, open_lo);
+            return;
+        }
+        case NODE_LET_EXPR: {
+            LetExprNode *l = (LetExprNode*)n;
+            int saved = w->nbound;
+            for (int i = 0; i < l->bindings.count; i++) {
+                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
+                if (reach & REACH_OPERAND) note_alias(w, vb);
+                walk(w, vb->init_expr, reach, open_lo);
+                bind(w, vb->name);
+            }
+            walk(w, l->body, reach, open_lo);
+            w->nbound = saved;
+            return;
+        }
+        case NODE_IF_EXPR: {
+            IfExprNode *iff = (IfExprNode*)n;
+            walk(w, iff->condition, reach, open_lo);
+            walk(w, iff->then_body, reach, open_lo);
+            for (int i = 0; i < iff->elifs.count; i++) {
+                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
+                walk(w, e->condition, reach, open_lo);
+                walk(w, e->body, reach, open_lo);
+            }
+            walk(w, iff->else_body, reach, open_lo);
+            return;
+        }
+        case NODE_BLOCK_STMT: {
+            BlockStmtNode *b = (BlockStmtNode*)n;
+            for (int i = 0; i < b->statements.count; i++)
+                walk(w, b->statements.items[i], reach, open_lo);
+            return;
+        }
+        case NODE_WHILE_STMT: {
+            WhileStmtNode *wh = (WhileStmtNode*)n;
+            walk(w, wh->condition, reach & REACH_EXPR, open_lo);
+            walk(w, wh->body, reach & REACH_EXPR, open_lo);
+            return;
+        }
+        case NODE_FOR_STMT: {
+            ForStmtNode *f = (ForStmtNode*)n;
+            unsigned r = reach & (REACH_OPERAND | REACH_CALLS);
+            walk(w, f->iterable, r, open_lo);
+            int saved = w->nbound;
+            bind(w, f->var_name);
+            walk(w, f->body, r, open_lo);
+            w->nbound = saved;
+            return;
+        }
+        case NODE_VECTOR_LIT: {
+            VectorLitNode *v = (VectorLitNode*)n;
+            for (int i = 0; i < v->items.count; i++)
+                walk(w, v->items.items[i], 0, open_lo);
+            return;
+        }
+        default: {
+            // Ninguna heurística ni recolector de capturas entra aquí;
+            // solo se baja para encontrar lambdas anidadas.
+            HulkNodeSlots s;
+            hulk_ast_slots(n, &s);
+            for (int i = 0; i < s.nfixed; i++)
+                walk(w, *s.fixed[i], 0, w->nopen);
+            for (int l = 0; l < s.nlists; l++)
+                for (int i = 0; i < s.lists[l]->count; i++)
+                    walk(w, s.lists[l]->items[i], 0, w->nopen);
+            return;
+        }
+    }
+}
+
+static void run_walk(HulkFacts *t, HulkNode *root, HulkNodeFacts *body) {
+    FactWalk w;
+    memset(&w, 0, sizeof(w));
+    w.table = t;
+    w.body = body;
+    walk(&w, root, body ? REACH_ALL : 0, 0);
+    free(w.bound);
+    free(w.open);
+    t->walks++;
+}
+
+static HulkNodeFacts* body_facts(HulkFacts *t, HulkNode *body) {
+    if (!t || !body) return NULL;
+    HulkNodeFacts *e = node_get(t, body);
+    if (!e) return NULL;
+    if (!e->has_body) {
+        e->has_body = 1;
+        run_walk(t, body, e);
+    }
+    return e;
+}
+
+// ============== CONSULTAS ==============
+
+const HulkNameFacts* hulk_facts_name(HulkFacts *t, HulkNode *body,
+                                     const char *name) {
+    HulkNodeFacts *e = body_facts(t, body);
+    if (!e || !name || !e->name_cap) return NULL;
+    HulkNameFacts *f = name_slot(e->names, e->name_cap, name);
+    return f->name ? f : NULL;
+}
+
+const HulkArgUse* hulk_facts_args(HulkFacts *t, HulkNode *body) {
+    HulkNodeFacts *e = body_facts(t, body);
+    return e ? e->args : NULL;
+}
+
+const HulkAlias* hulk_facts_aliases(HulkFacts *t, HulkNode *body,
+                                    int *count) {
+    HulkNodeFacts *e = body_facts(t, body);
+    *count = e ? e->alias_count : 0;
+    return e ? e->aliases : NULL;
+}
+
+const char* const* hulk_facts_free_vars(HulkFacts *t, FunctionExprNode *fn,
+                                        int *count) {
+    *count = 0;
+    if (!t || !fn) return NULL;
+    HulkNodeFacts *e = node_find(t, (HulkNode*)fn);
+    if (!e || !e->has_free) {
+        run_walk(t, (HulkNode*)fn, NULL);
+        e = node_find(t, (HulkNode*)fn);
+        if (!e) return NULL;
+    }
+    *count = e->free_count;
+    return e->free_names;
+}
@@ -0,0 +1,100 @@
+/*
+ * hulk_ast_facts.h — Hechos sintácticos de cada cuerpo, en una sola pasada
+ *
+ * Semántico y codegen necesitan varias preguntas sobre el mismo cuerpo
+ * ("¿cómo se usa el parámetro x?", "¿self.y aparece en un @?", "¿la
+ * función se llama a sí misma?", "¿qué variables externas usa esta
+ * lambda?"). En vez de un recorrido por pregunta (y por nombre), el
+ * primer pedido sobre un cuerpo lo recorre UNA vez y anota todas las
+ * respuestas, por nombre, en una tabla lateral; las consultas siguientes
+ * son búsquedas en esa tabla.
+ *
+ * Hechos por nombre (HulkNameFacts), cada uno con el mismo alcance que
+ * la heurística que reemplaza:
+ *   operand      — x como operando de + - * / ^ % < > <= >= (Number),
+ *                  & | (Boolean) o unario (Number);
+ *   self_operand — self.x en esos contextos, o en @ / @@ (String);
+ *   called       — x(...) aparece como llamada;
+ *   self_concat  — self.x es operando directo de @ / @@;
+ *   args         — x pasado como argumento i-ésimo de f(...), para que
+ *                  el caller resuelva la firma de f en su propio scope.
+ * Además, por cuerpo, los alias `let y = x` (sin anotación): y tiene el
+ * tipo de x, así que sus usos también hablan de x.
+ *
+ * Variables libres de cada lambda: los identificadores de su cuerpo que
+ * no liga ella misma (parámetros, let, for, lambdas anidadas), sin
+ * repetir y en orden de primera aparición. Una lambda anidada se anota
+ * durante la misma pasada que la contiene.
+ *
+ * Las claves son nombres internados (se comparan por puntero) y nodos
+ * del AST, que no debe modificarse después de la primera consulta.
+ *
+ * Responsabilidad única (SRP): solo recolecta y consulta hechos; qué
+ * tipo inferir con ellos es decisión de cada fase.
+ */
+
+#ifndef HULK_AST_FACTS_H
+#define HULK_AST_FACTS_H
+
+#include "hulk_ast.h"
+
+typedef enum {
+    HULK_USE_NONE = 0,
+    HULK_USE_NUMBER,
+    HULK_USE_BOOLEAN,
+    HULK_USE_STRING,
+} HulkUseTag;
+
+// Combina dos usos: iguales o uno vacío → ese; distintos → Number.
+HulkUseTag hulk_use_join(HulkUseTag a, HulkUseTag b);
+
+typedef struct {
+    const char *callee;    // nombre de la función llamada
+    int         index;     // posición del argumento
+    int         next;      // siguiente uso del mismo nombre, o -1
+} HulkArgUse;
+
+// `let name = of` sin anotación: name es un alias de of.
+typedef struct {
+    const char *name;
+    const char *of;
+} HulkAlias;
+
+typedef struct {
+    const char   *name;
+    unsigned char operand;       // HulkUseTag
+    unsigned char self_operand;  // HulkUseTag
+    unsigned char called;
+    unsigned char self_concat;
+    int           first_arg;     // índice en hulk_facts_args, o -1
+} HulkNameFacts;
+
+typedef struct HulkNodeFacts_s HulkNodeFacts;
+
+// Tabla nodo → hechos. Cero-inicializada es una tabla vacía válida.
+typedef struct {
+    HulkNodeFacts **slots;
+    int             cap;
+    int             count;
+    long            walks;       // recorridos hechos (para tests y bench)
+} HulkFacts;
+
+void hulk_facts_init(HulkFacts *t);
+void hulk_facts_free(HulkFacts *t);
+
+// Hechos de `name` dentro de `body`, o NULL si no aparece en ningún
+// contexto relevante.
+const HulkNameFacts* hulk_facts_name(HulkFacts *t, HulkNode *body,
+                                     const char *name);
+
+// Usos como argumento de `body`, encadenados desde first_arg.
+const HulkArgUse* hulk_facts_args(HulkFacts *t, HulkNode *body);
+
+// Alias `let y = x` de `body`; deja su cantidad en *count.
+const HulkAlias* hulk_facts_aliases(HulkFacts *t, HulkNode *body, int *count);
+
+// Variables libres de la lambda `fn`; deja su cantidad en *count.
+const char* const* hulk_facts_free_vars(HulkFacts *t, FunctionExprNode *fn,
+                                        int *count);
+
+#endif /* HULK_AST_FACTS_H */
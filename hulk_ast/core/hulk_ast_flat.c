@@ -0,0 +1,326 @@
+/*
+ * hulk_ast_flat.c — Construcción y navegación del AST plano
+ *
+ * hulk_flat_build recorre el AST de punteros en preorden con
+ * hulk_ast_slots: reserva el rango de hijos del nodo antes de bajar, así
+ * los rangos quedan contiguos aunque los descendientes se agreguen
+ * después. Los arreglos se referencian por índice (no por puntero)
+ * porque crecen con realloc durante la recursión. hulk_flat_to_ast hace
+ * el camino inverso con los mismos slots.
+ */
+
+#include "hulk_ast_flat.h"
+#include "../../error_handler.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Forma de cada tipo de nodo: hijos fijos y listas (igual que
+// hulk_ast_slots; hulk_flat_build verifica que coincidan).
+static const uint8_t FIXED[NODE_HULK_COUNT] = {
+    [NODE_FUNCTION_DEF] = 1, [NODE_FUNCTION_EXPR] = 1, [NODE_METHOD_DEF] = 1,
+    [NODE_ATTRIBUTE_DEF] = 1, [NODE_LET_EXPR] = 1, [NODE_VAR_BINDING] = 1,
+    [NODE_IF_EXPR] = 3, [NODE_ELIF_BRANCH] = 2, [NODE_WHILE_STMT] = 2,
+    [NODE_FOR_STMT] = 2, [NODE_BINARY_OP] = 2, [NODE_UNARY_OP] = 1,
+    [NODE_CALL_EXPR] = 1, [NODE_MEMBER_ACCESS] = 1, [NODE_ASSIGN] = 2,
+    [NODE_DESTRUCT_ASSIGN] = 2, [NODE_AS_EXPR] = 1, [NODE_IS_EXPR] = 1,
+    [NODE_DECOR_BLOCK] = 1, [NODE_CONCAT_EXPR] = 2, [NODE_INDEX_EXPR] = 2,
+};
+
+static const uint8_t LISTS[NODE_HULK_COUNT] = {
+    [NODE_PROGRAM] = 1, [NODE_FUNCTION_DEF] = 1, [NODE_FUNCTION_EXPR] = 2,
+    [NODE_TYPE_DEF] = 3, [NODE_METHOD_DEF] = 2, [NODE_LET_EXPR] = 1,
+    [NODE_IF_EXPR] = 1, [NODE_BLOCK_STMT] = 1, [NODE_CALL_EXPR] = 1,
+    [NODE_NEW_EXPR] = 1, [NODE_BASE_CALL] = 1, [NODE_DECOR_BLOCK] = 1,
+    [NODE_DECOR_ITEM] = 1, [NODE_VECTOR_LIT] = 1,
+};
+
+static int header_len(int kind) {
+    return LISTS[kind] > 1 ? LISTS[kind] - 1 : 0;
+}
+
+// ============== ALMACENAMIENTO ==============
+
+void hulk_flat_init(HulkFlatAST *f) {
+    memset(f, 0, sizeof(*f));
+}
+
+void hulk_flat_free(HulkFlatAST *f) {
+    free(f->kind);
+    free(f->flags);
+    free(f->line);
+    free(f->col);
+    free(f->first);
+    free(f->nchildren);
+    free(f->name);
+    free(f->type_ref);
+    free(f->static_type);
+    free(f->children);
+    hulk_flat_init(f);
+}
+
+size_t hulk_flat_bytes(const HulkFlatAST *f) {
+    size_t per_node = sizeof(uint8_t) * 2 + sizeof(int32_t) * 2 +
+                      sizeof(uint32_t) * 2 + sizeof(char*) * 2;
+    if (f->static_type) per_node += sizeof(char*);
+    return (size_t)f->count * per_node + f->child_len * sizeof(HulkFlatId);
+}
+
+#define GROW(arr, n) do {                                          \
+        void *p_ = realloc((arr), sizeof(*(arr)) * (size_t)(n));   \
+        if (!p_) return 0;                                         \
+        (arr) = p_;                                                \
+    } while (0)
+
+static int grow_nodes(HulkFlatAST *f) {
+    int nc = f->cap ? f->cap * 2 : 256;
+    GROW(f->kind, nc);
+    GROW(f->flags, nc);
+    GROW(f->line, nc);
+    GROW(f->col, nc);
+    GROW(f->first, nc);
+    GROW(f->nchildren, nc);
+    GROW(f->name, nc);
+    GROW(f->type_ref, nc);
+    if (f->static_type) {
+        GROW(f->static_type, nc);
+        memset(f->static_type + f->cap, 0, sizeof(char*) * (size_t)(nc - f->cap));
+    }
+    f->cap = nc;
+    return 1;
+}
+
+static int grow_children(HulkFlatAST *f, uint32_t need) {
+    uint32_t nc = f->child_cap ? f->child_cap : 256;
+    while (nc < need) nc *= 2;
+    GROW(f->children, nc);
+    f->child_cap = nc;
+    return 1;
+}
+
+#undef GROW
+
+// ============== CONSTRUCCIÓN ==============
+
+static int set_payload(HulkFlatAST *f, HulkFlatId id, HulkNode *n) {
+    HulkNodePayload p;
+    hulk_ast_payload(n, &p);
+    f->name[id] = p.literal ? hulk_intern(p.name) : p.name;
+    f->type_ref[id] = p.type_ref;
+    f->flags[id] = (uint8_t)p.flags;
+    if (n->static_type && !f->static_type) {
+        f->static_type = calloc((size_t)f->cap, sizeof(char*));
+        if (!f->static_type) return 0;
+    }
+    if (f->static_type) f->static_type[id] = n->static_type;
+    return 1;
+}
+
+static HulkFlatId flatten(HulkFlatAST *f, HulkNode *n, int *ok) {
+    if (!n || !*ok) return HULK_FLAT_NONE;
+    if (f->count >= f->cap && !grow_nodes(f)) { *ok = 0; return HULK_FLAT_NONE; }
+
+    HulkFlatId id = (HulkFlatId)f->count++;
+    f->kind[id] = (uint8_t)n->type;
+    f->line[id] = n->line;
+    f->col[id] = n->col;
+    if (!set_payload(f, id, n)) { *ok = 0; return HULK_FLAT_NONE; }
+
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    if (s.nfixed != FIXED[n->type] || s.nlists != LISTS[n->type]) {
+        LOG_FATAL_MSG("hulk_ast_flat", "forma de %s desincronizada",
+                      hulk_node_type_name(n->type));
+        *ok = 0;
+        return HULK_FLAT_NONE;
+    }
+
+    int header = header_len(n->type);
+    uint32_t total = (uint32_t)(header + s.nfixed);
+    for (int l = 0; l < s.nlists; l++) total += (uint32_t)s.lists[l]->count;
+
+    uint32_t at = f->child_len;
+    if (at + total > f->child_cap && !grow_children(f, at + total)) {
+        *ok = 0;
+        return HULK_FLAT_NONE;
+    }
+    f->child_len += total;
+    f->first[id] = at;
+    f->nchildren[id] = total;
+
+    for (int l = 0; l < header; l++)
+        f->children[at++] = (HulkFlatId)s.lists[l]->count;
+    for (int i = 0; i < s.nfixed; i++) {
+        HulkFlatId c = flatten(f, *s.fixed[i], ok);
+        f->children[at++] = c;
+    }
+    for (int l = 0; l < s.nlists; l++) {
+        for (int i = 0; i < s.lists[l]->count; i++) {
+            HulkFlatId c = flatten(f, s.lists[l]->items[i], ok);
+            f->children[at++] = c;
+        }
+    }
+    return id;
+}
+
+HulkFlatId hulk_flat_build(HulkFlatAST *f, HulkNode *root) {
+    int ok = 1;
+    HulkFlatId id = flatten(f, root, &ok);
+    return ok ? id : HULK_FLAT_NONE;
+}
+
+// ============== RECONSTRUCCIÓN ==============
+
+static HulkNode* new_node(HulkASTContext *ctx, const HulkFlatAST *f,
+                          HulkFlatId id) {
+    const char *name = f->name[id], *type_ref = f->type_ref[id];
+    int flags = f->flags[id], line = f->line[id], col = f->col[id];
+    switch ((HulkNodeType)f->kind[id]) {
+        case NODE_PROGRAM:        return (HulkNode*)hulk_ast_program(ctx, line, col);
+        case NODE_FUNCTION_DEF:   return (HulkNode*)hulk_ast_function_def(ctx, name, type_ref, line, col);
+        case NODE_FUNCTION_EXPR:  return (HulkNode*)hulk_ast_function_expr(ctx, type_ref, line, col);
+        case NODE_TYPE_DEF: {
+            TypeDefNode *n = hulk_ast_type_def(ctx, name, type_ref, line, col);
+            n->is_protocol = flags;
+            return (HulkNode*)n;
+        }
+        case NODE_METHOD_DEF:     return (HulkNode*)hulk_ast_method_def(ctx, name, type_ref, line, col);
+        case NODE_ATTRIBUTE_DEF:  return (HulkNode*)hulk_ast_attribute_def(ctx, name, type_ref, line, col);
+        case NODE_LET_EXPR:       return (HulkNode*)hulk_ast_let_expr(ctx, line, col);
+        case NODE_VAR_BINDING:    return (HulkNode*)hulk_ast_var_binding(ctx, name, type_ref, line, col);
+        case NODE_IF_EXPR:        return (HulkNode*)hulk_ast_if_expr(ctx, line, col);
+        case NODE_ELIF_BRANCH:    return (HulkNode*)hulk_ast_elif_branch(ctx, line, col);
+        case NODE_WHILE_STMT:     return (HulkNode*)hulk_ast_while_stmt(ctx, line, col);
+        case NODE_FOR_STMT:       return (HulkNode*)hulk_ast_for_stmt(ctx, name, line, col);
+        case NODE_BLOCK_STMT:     return (HulkNode*)hulk_ast_block_stmt(ctx, line, col);
+        case NODE_BINARY_OP:      return (HulkNode*)hulk_ast_binary_op(ctx, (BinaryOp)flags, NULL, NULL, line, col);
+        case NODE_UNARY_OP: {
+            UnaryOpNode *n = hulk_ast_unary_op(ctx, NULL, line, col);
+            n->is_not = flags;
+            return (HulkNode*)n;
+        }
+        case NODE_NUMBER_LIT:     return (HulkNode*)hulk_ast_number_lit(ctx, name, line, col);
+        case NODE_STRING_LIT:     return (HulkNode*)hulk_ast_string_lit(ctx, name, line, col);
+        case NODE_BOOL_LIT:       return (HulkNode*)hulk_ast_bool_lit(ctx, flags, line, col);
+        case NODE_IDENT:          return (HulkNode*)hulk_ast_ident(ctx, name, line, col);
+        case NODE_CALL_EXPR:      return (HulkNode*)hulk_ast_call_expr(ctx, NULL, line, col);
+        case NODE_MEMBER_ACCESS:  return (HulkNode*)hulk_ast_member_access(ctx, NULL, name, line, col);
+        case NODE_NEW_EXPR:       return (HulkNode*)hulk_ast_new_expr(ctx, name, line, col);
+        case NODE_ASSIGN:         return (HulkNode*)hulk_ast_assign(ctx, NULL, NULL, line, col);
+        case NODE_DESTRUCT_ASSIGN: return (HulkNode*)hulk_ast_destruct_assign(ctx, NULL, NULL, line, col);
+        case NODE_AS_EXPR:        return (HulkNode*)hulk_ast_as_expr(ctx, NULL, name, line, col);
+        case NODE_IS_EXPR:        return (HulkNode*)hulk_ast_is_expr(ctx, NULL, name, line, col);
+        case NODE_SELF:           return (HulkNode*)hulk_ast_self(ctx, line, col);
+        case NODE_BASE_CALL:      return (HulkNode*)hulk_ast_base_call(ctx, line, col);
+        case NODE_DECOR_BLOCK:    return (HulkNode*)hulk_ast_decor_block(ctx, line, col);
+        case NODE_DECOR_ITEM:     return (HulkNode*)hulk_ast_decor_item(ctx, name, line, col);
+        case NODE_CONCAT_EXPR:    return (HulkNode*)hulk_ast_concat_expr(ctx, (BinaryOp)flags, NULL, NULL, line, col);
+        case NODE_VECTOR_LIT:     return (HulkNode*)hulk_ast_vector_lit(ctx, line, col);
+        case NODE_INDEX_EXPR:     return (HulkNode*)hulk_ast_index_expr(ctx, NULL, NULL, line, col);
+        default:                  return NULL;
+    }
+}
+
+HulkNode* hulk_flat_to_ast(HulkASTContext *ctx, const HulkFlatAST *f,
+                           HulkFlatId id) {
+    if (id == HULK_FLAT_NONE) return NULL;
+    HulkNode *n = new_node(ctx, f, id);
+    if (!n) return NULL;
+    if (f->static_type) n->static_type = f->static_type[id];
+
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        *s.fixed[i] = hulk_flat_to_ast(ctx, f, hulk_flat_child(f, id, i));
+    for (int l = 0; l < s.nlists; l++) {
+        const HulkFlatId *items;
+        int len = hulk_flat_list(f, id, l, &items);
+        hulk_node_list_reserve(s.lists[l], len);
+        for (int i = 0; i < len; i++)
+            hulk_node_list_push(s.lists[l], hulk_flat_to_ast(ctx, f, items[i]));
+    }
+    return n;
+}
+
+// ============== VALIDACIÓN ==============
+
+int hulk_flat_validate(const HulkFlatAST *f) {
+    if (f->count <= 0) return 0;
+    uint8_t *has_parent = calloc((size_t)f->count, 1);
+    if (!has_parent) return 0;
+
+    int ok = 1;
+    for (int id = 0; ok && id < f->count; id++) {
+        int kind = f->kind[id];
+        if (kind >= NODE_HULK_COUNT ||
+            f->first[id] > f->child_len ||
+            f->nchildren[id] > f->child_len - f->first[id]) { ok = 0; break; }
+
+        const HulkFlatId *range = f->children + f->first[id];
+        uint32_t header = (uint32_t)header_len(kind);
+        uint32_t fixed_end = header + FIXED[kind];
+        if (f->nchildren[id] < fixed_end) { ok = 0; break; }
+        uint64_t listed = 0;
+        for (uint32_t l = 0; l < header; l++) listed += range[l];
+        if (listed > f->nchildren[id] - fixed_end ||
+            (LISTS[kind] == 0 && f->nchildren[id] != fixed_end)) { ok = 0; break; }
+
+        for (uint32_t at = header; at < f->nchildren[id]; at++) {
+            HulkFlatId c = range[at];
+            if (c == HULK_FLAT_NONE && at < fixed_end) continue;  // fijo ausente
+            if (c == HULK_FLAT_NONE || c <= (HulkFlatId)id ||
+                c >= (HulkFlatId)f->count || has_parent[c]) { ok = 0; break; }
+            has_parent[c] = 1;
+        }
+    }
+    free(has_parent);
+    return ok;
+}
+
+// ============== NAVEGACIÓN ==============
+
+HulkFlatId hulk_flat_child(const HulkFlatAST *f, HulkFlatId id, int slot) {
+    int kind = f->kind[id];
+    if (slot < 0 || slot >= FIXED[kind]) return HULK_FLAT_NONE;
+    return f->children[f->first[id] + header_len(kind) + slot];
+}
+
+int hulk_flat_list(const HulkFlatAST *f, HulkFlatId id, int which,
+                   const HulkFlatId **items) {
+    int kind = f->kind[id];
+    int nlists = LISTS[kind];
+    *items = NULL;
+    if (which < 0 || which >= nlists) return 0;
+
+    const HulkFlatId *range = f->children + f->first[id];
+    int header = header_len(kind);
+    uint32_t start = (uint32_t)(header + FIXED[kind]);
+    for (int l = 0; l < which; l++) start += range[l];
+    uint32_t len = which < header
+        ? range[which]
+        : f->nchildren[id] - start;  // la última lista llega hasta el final
+    *items = range + start;
+    return (int)len;
+}
+
+// ============== VISITOR ==============
+
+void hulk_flat_visitor_init(HulkFlatVisitor *v) {
+    for (int i = 0; i < NODE_HULK_COUNT; i++)
+        v->visit[i] = NULL;
+}
+
+void hulk_flat_accept(const HulkFlatAST *f, HulkFlatId id,
+                      HulkFlatVisitor *visitor, void *data) {
+    if (id == HULK_FLAT_NONE || !visitor) return;
+    HulkFlatVisitFn fn = visitor->visit[f->kind[id]];
+    if (fn) fn(f, id, visitor, data);
+}
+
+void hulk_flat_accept_children(const HulkFlatAST *f, HulkFlatId id,
+                               HulkFlatVisitor *visitor, void *data) {
+    if (id == HULK_FLAT_NONE) return;
+    uint32_t at = f->first[id] + (uint32_t)header_len(f->kind[id]);
+    uint32_t end = f->first[id] + f->nchildren[id];
+    for (; at < end; at++)
+        hulk_flat_accept(f, f->children[at], visitor, data);
+}
@@ -0,0 +1,110 @@
+/*
+ * hulk_ast_flat.h — Representación compacta del AST (struct-of-arrays)
+ *
+ * Alternativa al grafo de punteros: cada nodo es un índice de 32 bits y
+ * sus datos viven en arreglos paralelos (kind, flags, posición, rango de
+ * hijos y payloads). Los hijos de todos los nodos comparten un único
+ * arreglo de índices; los de un nodo ocupan un rango contiguo. Los ids
+ * se asignan en preorden, así que recorrer 0..count-1 es un recorrido en
+ * profundidad del programa sin seguir punteros.
+ *
+ * Rango de hijos de un nodo (orden de hulk_ast_slots):
+ *
+ *   [largo lista 0 .. largo lista L-2] [fijos 0..F-1] [lista 0][lista 1]…
+ *
+ * Los largos solo aparecen si el nodo tiene más de una lista (TypeDef,
+ * MethodDef, FunctionExpr); un hijo fijo ausente es HULK_FLAT_NONE.
+ *
+ * Payloads:
+ *   name     — nombre internado (name, var_name, member, type_name) o el
+ *              texto internado de un literal (raw de Number, String sin
+ *              comillas);
+ *   type_ref — anotación internada (return_type, type_annotation, parent);
+ *   flags    — BinaryOp, is_not, valor de Bool o is_protocol;
+ *   static_type — tipo que anotó el semántico; el arreglo solo existe
+ *              (no NULL) si algún nodo lo tiene, así que un árbol recién
+ *              parseado no lo paga.
+ *
+ * El árbol plano no referencia al AST de punteros ni a su arena: puede
+ * sobrevivirle.
+ *
+ * Responsabilidad única (SRP): solo almacenamiento y navegación; se
+ * construye desde el AST de punteros con hulk_flat_build y se vuelve a
+ * él con hulk_flat_to_ast. Lo usan la caché en disco y el tree shaking
+ * del codegen (hulk_codegen_reach.c).
+ */
+
+#ifndef HULK_AST_FLAT_H
+#define HULK_AST_FLAT_H
+
+#include "hulk_ast.h"
+#include <stdint.h>
+
+typedef uint32_t HulkFlatId;
+#define HULK_FLAT_NONE ((HulkFlatId)0xFFFFFFFFu)
+
+typedef struct {
+    int          count, cap;       // nodos
+    uint8_t     *kind;             // HulkNodeType
+    uint8_t     *flags;
+    int32_t     *line, *col;
+    uint32_t    *first;            // inicio del rango en children
+    uint32_t    *nchildren;        // largo del rango (incluye cabecera)
+    const char **name;
+    const char **type_ref;
+    const char **static_type;      // NULL si ningún nodo tiene
+
+    HulkFlatId  *children;         // compartido por todos los nodos
+    uint32_t     child_len, child_cap;
+} HulkFlatAST;
+
+void hulk_flat_init(HulkFlatAST *f);
+void hulk_flat_free(HulkFlatAST *f);
+
+// Aplana `root` (típicamente un ProgramNode) en `f`, que debe estar
+// recién inicializado. Retorna el id de la raíz (0) o HULK_FLAT_NONE si
+// no hubo memoria o root es NULL.
+HulkFlatId hulk_flat_build(HulkFlatAST *f, HulkNode *root);
+
+// Operación inversa: reconstruye en `ctx` el AST de punteros del
+// subárbol `id`. Los nombres ya están internados y los literales se
+// copian a la arena. `f` debe ser válido (ver hulk_flat_validate).
+HulkNode* hulk_flat_to_ast(HulkASTContext *ctx, const HulkFlatAST *f,
+                           HulkFlatId id);
+
+// Verifica que `f` sea un árbol bien formado con raíz 0: kinds válidos,
+// rangos dentro de children, forma de cada nodo según su kind, hijos
+// con id mayor que el padre y cada nodo con a lo sumo un padre. Para
+// árboles que vienen de afuera (caché en disco). Retorna 1 si es válido.
+int hulk_flat_validate(const HulkFlatAST *f);
+
+// Bytes ocupados por los arreglos (lo usado, no la capacidad reservada).
+size_t hulk_flat_bytes(const HulkFlatAST *f);
+
+// Hijo fijo `slot` (ver orden en hulk_ast_slots) o HULK_FLAT_NONE.
+HulkFlatId hulk_flat_child(const HulkFlatAST *f, HulkFlatId id, int slot);
+
+// Lista `which` del nodo: retorna su largo y deja en *items su inicio.
+int hulk_flat_list(const HulkFlatAST *f, HulkFlatId id, int which,
+                   const HulkFlatId **items);
+
+// ============== VISITOR ==============
+// Igual que HulkASTVisitor, pero sobre ids. Los callbacks NULL se
+// ignoran; hulk_flat_accept_children recorre todos los hijos en orden.
+
+typedef struct HulkFlatVisitor_s HulkFlatVisitor;
+
+typedef void (*HulkFlatVisitFn)(const HulkFlatAST *f, HulkFlatId id,
+                                HulkFlatVisitor *visitor, void *data);
+
+struct HulkFlatVisitor_s {
+    HulkFlatVisitFn visit[NODE_HULK_COUNT];
+};
+
+void hulk_flat_visitor_init(HulkFlatVisitor *v);
+void hulk_flat_accept(const HulkFlatAST *f, HulkFlatId id,
+                      HulkFlatVisitor *visitor, void *data);
+void hulk_flat_accept_children(const HulkFlatAST *f, HulkFlatId id,
+                               HulkFlatVisitor *visitor, void *data);
+
+#endif /* HULK_AST_FLAT_H */
@@ -5,7 +5,8 @@
  * inicializa sus campos y retorna el puntero.
  *
  * El macro ALLOC_NODE encapsula: asignación + inicialización de la
- * cabecera HulkNode (type, line, col).
+ * cabecera HulkNode (type, line, col y el id denso del contexto). Los nombres se internan
+ * (hulk_intern); los literales se copian a la arena.
  *
  * SRP: Solo creación e inicialización de nodos del AST.
  */
@@ -23,70 +24,71 @@
     if (!node) return NULL;                                      \
     node->base.type = (node_type);                               \
     node->base.line = (ln);                                      \
-    node->base.col  = (cl);
+    node->base.col  = (cl);                                      \
+    node->base.id   = (ctx)->node_count++;
 
 // ============== FUNCIONES DE CREACIÓN ==============
 
 ProgramNode* hulk_ast_program(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, ProgramNode, NODE_PROGRAM, line, col);
-    hulk_node_list_init(&node->declarations);
+    hulk_node_list_init_in(&node->declarations, ctx);
     return node;
 }
 
 FunctionDefNode* hulk_ast_function_def(HulkASTContext *ctx, const char *name,
                                         const char *ret_type, int line, int col) {
     ALLOC_NODE(ctx, FunctionDefNode, NODE_FUNCTION_DEF, line, col);
-    node->name        = hulk_ast_strdup(ctx, name);
-    node->return_type = hulk_ast_strdup(ctx, ret_type);
+    node->name        = hulk_intern(name);
+    node->return_type = hulk_intern(ret_type);
     node->body        = NULL;
-    hulk_node_list_init(&node->params);
+    hulk_node_list_init_in(&node->params, ctx);
     return node;
 }
 
 FunctionExprNode* hulk_ast_function_expr(HulkASTContext *ctx, const char *ret_type,
                                           int line, int col) {
     ALLOC_NODE(ctx, FunctionExprNode, NODE_FUNCTION_EXPR, line, col);
-    node->return_type = hulk_ast_strdup(ctx, ret_type);
+    node->return_type = hulk_intern(ret_type);
     node->body        = NULL;
-    hulk_node_list_init(&node->params);
-    hulk_node_list_init(&node->captures);
+    hulk_node_list_init_in(&node->params, ctx);
+    hulk_node_list_init_in(&node->captures, ctx);
     return node;
 }
 
 TypeDefNode* hulk_ast_type_def(HulkASTContext *ctx, const char *name,
                                 const char *parent, int line, int col) {
     ALLOC_NODE(ctx, TypeDefNode, NODE_TYPE_DEF, line, col);
-    node->name   = hulk_ast_strdup(ctx, name);
-    node->parent = hulk_ast_strdup(ctx, parent);
-    hulk_node_list_init(&node->params);
-    hulk_node_list_init(&node->parent_args);
-    hulk_node_list_init(&node->members);
+    node->name   = hulk_intern(name);
+    node->parent = hulk_intern(parent);
+    hulk_node_list_init_in(&node->params, ctx);
+    hulk_node_list_init_in(&node->parent_args, ctx);
+    hulk_node_list_init_in(&node->members, ctx);
     return node;
 }
 
 MethodDefNode* hulk_ast_method_def(HulkASTContext *ctx, const char *name,
                                     const char *ret_type, int line, int col) {
     ALLOC_NODE(ctx, MethodDefNode, NODE_METHOD_DEF, line, col);
-    node->name        = hulk_ast_strdup(ctx, name);
-    node->return_type = hulk_ast_strdup(ctx, ret_type);
+    node->name        = hulk_intern(name);
+    node->return_type = hulk_intern(ret_type);
     node->body        = NULL;
-    hulk_node_list_init(&node->params);
-    hulk_node_list_init(&node->decorators);
+    hulk_node_list_init_in(&node->params, ctx);
+    hulk_node_list_init_in(&node->decorators, ctx);
     return node;
 }
 
 AttributeDefNode* hulk_ast_attribute_def(HulkASTContext *ctx, const char *name,
                                           const char *type_ann, int line, int col) {
     ALLOC_NODE(ctx, AttributeDefNode, NODE_ATTRIBUTE_DEF, line, col);
-    node->name            = hulk_ast_strdup(ctx, name);
-    node->type_annotation = hulk_ast_strdup(ctx, type_ann);
+    node->name            = hulk_intern(name);
+    node->type_annotation = hulk_intern(type_ann);
     node->init_expr       = NULL;
     return node;
 }
 
 LetExprNode* hulk_ast_let_expr(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, LetExprNode, NODE_LET_EXPR, line, col);
-    hulk_node_list_init(&node->bindings);
+    hulk_node_list_init_in(&node->bindings, ctx);
     node->body = NULL;
     return node;
 }
@@ -94,8 +96,8 @@ LetExprNode* hulk_ast_let_expr(HulkASTContext *ctx, int line, int col) {
 VarBindingNode* hulk_ast_var_binding(HulkASTContext *ctx, const char *name,
                                       const char *type_ann, int line, int col) {
     ALLOC_NODE(ctx, VarBindingNode, NODE_VAR_BINDING, line, col);
-    node->name            = hulk_ast_strdup(ctx, name);
-    node->type_annotation = hulk_ast_strdup(ctx, type_ann);
+    node->name            = hulk_intern(name);
+    node->type_annotation = hulk_intern(type_ann);
     node->init_expr       = NULL;
     return node;
 }
@@ -105,7 +107,7 @@ IfExprNode* hulk_ast_if_expr(HulkASTContext *ctx, int line, int col) {
     node->condition = NULL;
     node->then_body = NULL;
     node->else_body = NULL;
-    hulk_node_list_init(&node->elifs);
+    hulk_node_list_init_in(&node->elifs, ctx);
     return node;
 }
 
@@ -126,7 +128,7 @@ WhileStmtNode* hulk_ast_while_stmt(HulkASTContext *ctx, int line, int col) {
 ForStmtNode* hulk_ast_for_stmt(HulkASTContext *ctx, const char *var_name,
                                 int line, int col) {
     ALLOC_NODE(ctx, ForStmtNode, NODE_FOR_STMT, line, col);
-    node->var_name = hulk_ast_strdup(ctx, var_name);
+    node->var_name = hulk_intern(var_name);
     node->iterable = NULL;
     node->body     = NULL;
     return node;
@@ -134,7 +136,7 @@ ForStmtNode* hulk_ast_for_stmt(HulkASTContext *ctx, const char *var_name,
 
 BlockStmtNode* hulk_ast_block_stmt(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, BlockStmtNode, NODE_BLOCK_STMT, line, col);
-    hulk_node_list_init(&node->statements);
+    hulk_node_list_init_in(&node->statements, ctx);
     return node;
 }
 
@@ -180,7 +182,7 @@ BoolLitNode* hulk_ast_bool_lit(HulkASTContext *ctx, int value,
 IdentNode* hulk_ast_ident(HulkASTContext *ctx, const char *name,
                             int line, int col) {
     ALLOC_NODE(ctx, IdentNode, NODE_IDENT, line, col);
-    node->name = hulk_ast_strdup(ctx, name);
+    node->name = hulk_intern(name);
     return node;
 }
 
@@ -188,7 +190,7 @@ CallExprNode* hulk_ast_call_expr(HulkASTContext *ctx, HulkNode *callee,
                                   int line, int col) {
     ALLOC_NODE(ctx, CallExprNode, NODE_CALL_EXPR, line, col);
     node->callee = callee;
-    hulk_node_list_init(&node->args);
+    hulk_node_list_init_in(&node->args, ctx);
     return node;
 }
 
@@ -196,15 +198,15 @@ MemberAccessNode* hulk_ast_member_access(HulkASTContext *ctx, HulkNode *object,
                                           const char *member, int line, int col) {
     ALLOC_NODE(ctx, MemberAccessNode, NODE_MEMBER_ACCESS, line, col);
     node->object = object;
-    node->member = hulk_ast_strdup(ctx, member);
+    node->member = hulk_intern(member);
     return node;
 }
 
 NewExprNode* hulk_ast_new_expr(HulkASTContext *ctx, const char *type_name,
                                 int line, int col) {
     ALLOC_NODE(ctx, NewExprNode, NODE_NEW_EXPR, line, col);
-    node->type_name = hulk_ast_strdup(ctx, type_name);
-    hulk_node_list_init(&node->args);
+    node->type_name = hulk_intern(type_name);
+    hulk_node_list_init_in(&node->args, ctx);
     return node;
 }
 
@@ -228,7 +230,7 @@ AsExprNode* hulk_ast_as_expr(HulkASTContext *ctx, HulkNode *expr,
                               const char *type_name, int line, int col) {
     ALLOC_NODE(ctx, AsExprNode, NODE_AS_EXPR, line, col);
     node->expr      = expr;
-    node->type_name = hulk_ast_strdup(ctx, type_name);
+    node->type_name = hulk_intern(type_name);
     return node;
 }
 
@@ -236,7 +238,7 @@ IsExprNode* hulk_ast_is_expr(HulkASTContext *ctx, HulkNode *expr,
                               const char *type_name, int line, int col) {
     ALLOC_NODE(ctx, IsExprNode, NODE_IS_EXPR, line, col);
     node->expr      = expr;
-    node->type_name = hulk_ast_strdup(ctx, type_name);
+    node->type_name = hulk_intern(type_name);
     return node;
 }
 
@@ -247,13 +249,13 @@ SelfNode* hulk_ast_self(HulkASTContext *ctx, int line, int col) {
 
 BaseCallNode* hulk_ast_base_call(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, BaseCallNode, NODE_BASE_CALL, line, col);
-    hulk_node_list_init(&node->args);
+    hulk_node_list_init_in(&node->args, ctx);
     return node;
 }
 
 DecorBlockNode* hulk_ast_decor_block(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, DecorBlockNode, NODE_DECOR_BLOCK, line, col);
-    hulk_node_list_init(&node->decorators);
+    hulk_node_list_init_in(&node->decorators, ctx);
     node->target = NULL;
     return node;
 }
@@ -261,8 +263,8 @@ DecorBlockNode* hulk_ast_decor_block(HulkASTContext *ctx, int line, int col) {
 DecorItemNode* hulk_ast_decor_item(HulkASTContext *ctx, const char *name,
                                     int line, int col) {
     ALLOC_NODE(ctx, DecorItemNode, NODE_DECOR_ITEM, line, col);
-    node->name = hulk_ast_strdup(ctx, name);
-    hulk_node_list_init(&node->args);
+    node->name = hulk_intern(name);
+    hulk_node_list_init_in(&node->args, ctx);
     return node;
 }
 
@@ -278,7 +280,7 @@ ConcatExprNode* hulk_ast_concat_expr(HulkASTContext *ctx, BinaryOp op,
 
 VectorLitNode* hulk_ast_vector_lit(HulkASTContext *ctx, int line, int col) {
     ALLOC_NODE(ctx, VectorLitNode, NODE_VECTOR_LIT, line, col);
-    hulk_node_list_init(&node->items);
+    hulk_node_list_init_in(&node->items, ctx);
     return node;
 }
 
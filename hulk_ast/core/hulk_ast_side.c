@@ -0,0 +1,62 @@
+/*
+ * hulk_ast_side.c — Tablas laterales indexadas por id de nodo
+ *
+ * Arreglo plano de entradas {dueño, valor}: la entrada i es la del nodo
+ * con id i. Crece al doble (o hasta el id pedido) con las entradas
+ * nuevas en cero, que es "sin dueño".
+ */
+
+#include "hulk_ast_side.h"
+#include "../../error_handler.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const HulkNode *owner;
+} SideHeader;
+
+void hulk_side_init(HulkSideTable *t, size_t elem_size) {
+    memset(t, 0, sizeof(*t));
+    t->elem = elem_size;
+    size_t stride = sizeof(SideHeader) + elem_size;
+    t->stride = (stride + HULK_AST_ALIGN - 1) & ~(HULK_AST_ALIGN - 1);
+}
+
+void hulk_side_free(HulkSideTable *t) {
+    free(t->entries);
+    hulk_side_init(t, t->elem);
+}
+
+static SideHeader* entry(const HulkSideTable *t, unsigned id) {
+    return (SideHeader*)(t->entries + (size_t)id * t->stride);
+}
+
+void* hulk_side_get(const HulkSideTable *t, const HulkNode *n) {
+    if (!n || n->id >= t->cap) return NULL;
+    SideHeader *e = entry(t, n->id);
+    return e->owner == n ? (void*)(e + 1) : NULL;
+}
+
+void* hulk_side_put(HulkSideTable *t, const HulkNode *n) {
+    if (!n) return NULL;
+    if (n->id >= t->cap) {
+        unsigned ncap = t->cap ? t->cap * 2 : 256;
+        while (ncap <= n->id) ncap *= 2;
+        unsigned char *ne = realloc(t->entries, (size_t)ncap * t->stride);
+        if (!ne) {
+            LOG_FATAL_MSG("hulk_ast_side", "sin memoria para la tabla lateral");
+            return NULL;
+        }
+        memset(ne + (size_t)t->cap * t->stride, 0,
+               (size_t)(ncap - t->cap) * t->stride);
+        t->entries = ne;
+        t->cap = ncap;
+    }
+    SideHeader *e = entry(t, n->id);
+    if (e->owner != n) {
+        if (!e->owner) t->count++;
+        e->owner = n;
+        memset(e + 1, 0, t->elem);
+    }
+    return e + 1;
+}
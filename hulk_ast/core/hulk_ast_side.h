@@ -0,0 +1,44 @@
+/*
+ * hulk_ast_side.h — Tablas laterales indexadas por id de nodo
+ *
+ * Cada fase guarda resultados por nodo (tipo resuelto, símbolo, valor
+ * constante, …) en una tabla propia en vez de agregar campos a HulkNode
+ * o recalcularlos: el id denso del nodo (HulkNode.id) es el índice, así
+ * que leer y escribir es O(1) sin hashing. La tabla crece a pedido hasta
+ * el mayor id visto.
+ *
+ * Cada entrada recuerda su nodo: get de un nodo sin valor (o de otro
+ * contexto con el mismo id) es NULL. Una tabla es para los nodos de un
+ * contexto; si se mezclan, el último put gana el lugar — sirve como
+ * caché, nunca devuelve el valor de otro nodo.
+ *
+ * El valor es un bloque de `elem_size` bytes; el caller lo castea al
+ * tipo que guarda.
+ *
+ * Responsabilidad única (SRP): solo almacenamiento; qué se guarda es de
+ * cada fase.
+ */
+
+#ifndef HULK_AST_SIDE_H
+#define HULK_AST_SIDE_H
+
+#include "hulk_ast.h"
+
+typedef struct {
+    unsigned char *entries;   // cap entradas de `stride` bytes
+    size_t         elem;      // bytes del valor
+    size_t         stride;    // dueño + valor, alineado
+    unsigned       cap;
+    unsigned       count;     // entradas con valor
+} HulkSideTable;
+
+void hulk_side_init(HulkSideTable *t, size_t elem_size);
+void hulk_side_free(HulkSideTable *t);
+
+// Valor de `n` o NULL si no tiene.
+void* hulk_side_get(const HulkSideTable *t, const HulkNode *n);
+
+// Lugar del valor de `n`, en cero si no tenía. NULL sin memoria.
+void* hulk_side_put(HulkSideTable *t, const HulkNode *n);
+
+#endif /* HULK_AST_SIDE_H */
@@ -13,6 +13,7 @@
 
 #include "hulk_ast.h"
 #include <stdlib.h>
+#include <string.h>
 
 // ============== VISITOR ==============
 
@@ -35,6 +36,192 @@ void hulk_ast_accept_list(HulkNodeList *list, HulkASTVisitor *visitor, void *dat
     }
 }
 
+// ============== HIJOS GENÉRICOS ==============
+
+#define FIX(x)  (out->fixed[out->nfixed++] = &(x))
+#define LIST(x) (out->lists[out->nlists++] = &(x))
+
+void hulk_ast_slots(HulkNode *node, HulkNodeSlots *out) {
+    out->nfixed = 0;
+    out->nlists = 0;
+    if (!node) return;
+    switch (node->type) {
+        case NODE_PROGRAM:        LIST(((ProgramNode*)node)->declarations); break;
+        case NODE_FUNCTION_DEF: { FunctionDefNode *n = (FunctionDefNode*)node;
+            FIX(n->body); LIST(n->params); break; }
+        case NODE_FUNCTION_EXPR: { FunctionExprNode *n = (FunctionExprNode*)node;
+            FIX(n->body); LIST(n->params); LIST(n->captures); break; }
+        case NODE_TYPE_DEF: { TypeDefNode *n = (TypeDefNode*)node;
+            LIST(n->params); LIST(n->parent_args); LIST(n->members); break; }
+        case NODE_METHOD_DEF: { MethodDefNode *n = (MethodDefNode*)node;
+            FIX(n->body); LIST(n->params); LIST(n->decorators); break; }
+        case NODE_ATTRIBUTE_DEF:  FIX(((AttributeDefNode*)node)->init_expr); break;
+        case NODE_LET_EXPR: { LetExprNode *n = (LetExprNode*)node;
+            FIX(n->body); LIST(n->bindings); break; }
+        case NODE_VAR_BINDING:    FIX(((VarBindingNode*)node)->init_expr); break;
+        case NODE_IF_EXPR: { IfExprNode *n = (IfExprNode*)node;
+            FIX(n->condition); FIX(n->then_body); FIX(n->else_body);
+            LIST(n->elifs); break; }
+        case NODE_ELIF_BRANCH: { ElifBranchNode *n = (ElifBranchNode*)node;
+            FIX(n->condition); FIX(n->body); break; }
+        case NODE_WHILE_STMT: { WhileStmtNode *n = (WhileStmtNode*)node;
+            FIX(n->condition); FIX(n->body); break; }
+        case NODE_FOR_STMT: { ForStmtNode *n = (ForStmtNode*)node;
+            FIX(n->iterable); FIX(n->body); break; }
+        case NODE_BLOCK_STMT:     LIST(((BlockStmtNode*)node)->statements); break;
+        case NODE_BINARY_OP: { BinaryOpNode *n = (BinaryOpNode*)node;
+            FIX(n->left); FIX(n->right); break; }
+        case NODE_UNARY_OP:       FIX(((UnaryOpNode*)node)->operand); break;
+        case NODE_CALL_EXPR: { CallExprNode *n = (CallExprNode*)node;
+            FIX(n->callee); LIST(n->args); break; }
+        case NODE_MEMBER_ACCESS:  FIX(((MemberAccessNode*)node)->object); break;
+        case NODE_NEW_EXPR:       LIST(((NewExprNode*)node)->args); break;
+        case NODE_ASSIGN: { AssignNode *n = (AssignNode*)node;
+            FIX(n->target); FIX(n->value); break; }
+        case NODE_DESTRUCT_ASSIGN: { DestructAssignNode *n = (DestructAssignNode*)node;
+            FIX(n->target); FIX(n->value); break; }
+        case NODE_AS_EXPR:        FIX(((AsExprNode*)node)->expr); break;
+        case NODE_IS_EXPR:        FIX(((IsExprNode*)node)->expr); break;
+        case NODE_BASE_CALL:      LIST(((BaseCallNode*)node)->args); break;
+        case NODE_DECOR_BLOCK: { DecorBlockNode *n = (DecorBlockNode*)node;
+            FIX(n->target); LIST(n->decorators); break; }
+        case NODE_DECOR_ITEM:     LIST(((DecorItemNode*)node)->args); break;
+        case NODE_CONCAT_EXPR: { ConcatExprNode *n = (ConcatExprNode*)node;
+            FIX(n->left); FIX(n->right); break; }
+        case NODE_VECTOR_LIT:     LIST(((VectorLitNode*)node)->items); break;
+        case NODE_INDEX_EXPR: { IndexExprNode *n = (IndexExprNode*)node;
+            FIX(n->object); FIX(n->index); break; }
+        default: break;  // hojas: literales, Ident, Self
+    }
+}
+
+#undef FIX
+#undef LIST
+
+void hulk_ast_payload(HulkNode *n, HulkNodePayload *out) {
+    out->name = out->type_ref = NULL;
+    out->flags = 0;
+    out->literal = 0;
+    if (!n) return;
+    switch (n->type) {
+        case NODE_FUNCTION_DEF: { FunctionDefNode *x = (FunctionDefNode*)n;
+            out->name = x->name; out->type_ref = x->return_type; break; }
+        case NODE_FUNCTION_EXPR: out->type_ref = ((FunctionExprNode*)n)->return_type; break;
+        case NODE_TYPE_DEF: { TypeDefNode *x = (TypeDefNode*)n;
+            out->name = x->name; out->type_ref = x->parent;
+            out->flags = x->is_protocol; break; }
+        case NODE_METHOD_DEF: { MethodDefNode *x = (MethodDefNode*)n;
+            out->name = x->name; out->type_ref = x->return_type; break; }
+        case NODE_ATTRIBUTE_DEF: { AttributeDefNode *x = (AttributeDefNode*)n;
+            out->name = x->name; out->type_ref = x->type_annotation; break; }
+        case NODE_VAR_BINDING: { VarBindingNode *x = (VarBindingNode*)n;
+            out->name = x->name; out->type_ref = x->type_annotation; break; }
+        case NODE_FOR_STMT:      out->name = ((ForStmtNode*)n)->var_name; break;
+        case NODE_BINARY_OP:     out->flags = ((BinaryOpNode*)n)->op; break;
+        case NODE_CONCAT_EXPR:   out->flags = ((ConcatExprNode*)n)->op; break;
+        case NODE_UNARY_OP:      out->flags = ((UnaryOpNode*)n)->is_not; break;
+        case NODE_BOOL_LIT:      out->flags = ((BoolLitNode*)n)->value; break;
+        case NODE_NUMBER_LIT:
+            out->name = ((NumberLitNode*)n)->raw; out->literal = 1; break;
+        case NODE_STRING_LIT:
+            out->name = ((StringLitNode*)n)->value; out->literal = 1; break;
+        case NODE_IDENT:         out->name = ((IdentNode*)n)->name; break;
+        case NODE_MEMBER_ACCESS: out->name = ((MemberAccessNode*)n)->member; break;
+        case NODE_NEW_EXPR:      out->name = ((NewExprNode*)n)->type_name; break;
+        case NODE_AS_EXPR:       out->name = ((AsExprNode*)n)->type_name; break;
+        case NODE_IS_EXPR:       out->name = ((IsExprNode*)n)->type_name; break;
+        case NODE_DECOR_ITEM:    out->name = ((DecorItemNode*)n)->name; break;
+        default: break;
+    }
+}
+
+void hulk_ast_shift_ids(HulkNode *root, unsigned offset) {
+    if (!root) return;
+    root->id += offset;
+    HulkNodeSlots s;
+    hulk_ast_slots(root, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        hulk_ast_shift_ids(*s.fixed[i], offset);
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            hulk_ast_shift_ids(s.lists[l]->items[i], offset);
+}
+
+void hulk_ast_rehome_lists(HulkNode *root, HulkASTContext *from,
+                           HulkASTContext *to) {
+    if (!root) return;
+    HulkNodeSlots s;
+    hulk_ast_slots(root, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        hulk_ast_rehome_lists(*s.fixed[i], from, to);
+    for (int l = 0; l < s.nlists; l++) {
+        if (s.lists[l]->arena == from) s.lists[l]->arena = to;
+        for (int i = 0; i < s.lists[l]->count; i++)
+            hulk_ast_rehome_lists(s.lists[l]->items[i], from, to);
+    }
+}
+
+static const size_t node_sizes[NODE_HULK_COUNT] = {
+    [NODE_PROGRAM] = sizeof(ProgramNode),
+    [NODE_FUNCTION_DEF] = sizeof(FunctionDefNode),
+    [NODE_FUNCTION_EXPR] = sizeof(FunctionExprNode),
+    [NODE_TYPE_DEF] = sizeof(TypeDefNode),
+    [NODE_METHOD_DEF] = sizeof(MethodDefNode),
+    [NODE_ATTRIBUTE_DEF] = sizeof(AttributeDefNode),
+    [NODE_LET_EXPR] = sizeof(LetExprNode),
+    [NODE_VAR_BINDING] = sizeof(VarBindingNode),
+    [NODE_IF_EXPR] = sizeof(IfExprNode),
+    [NODE_ELIF_BRANCH] = sizeof(ElifBranchNode),
+    [NODE_WHILE_STMT] = sizeof(WhileStmtNode),
+    [NODE_FOR_STMT] = sizeof(ForStmtNode),
+    [NODE_BLOCK_STMT] = sizeof(BlockStmtNode),
+    [NODE_BINARY_OP] = sizeof(BinaryOpNode),
+    [NODE_UNARY_OP] = sizeof(UnaryOpNode),
+    [NODE_NUMBER_LIT] = sizeof(NumberLitNode),
+    [NODE_STRING_LIT] = sizeof(StringLitNode),
+    [NODE_BOOL_LIT] = sizeof(BoolLitNode),
+    [NODE_IDENT] = sizeof(IdentNode),
+    [NODE_CALL_EXPR] = sizeof(CallExprNode),
+    [NODE_MEMBER_ACCESS] = sizeof(MemberAccessNode),
+    [NODE_NEW_EXPR] = sizeof(NewExprNode),
+    [NODE_ASSIGN] = sizeof(AssignNode),
+    [NODE_DESTRUCT_ASSIGN] = sizeof(DestructAssignNode),
+    [NODE_AS_EXPR] = sizeof(AsExprNode),
+    [NODE_IS_EXPR] = sizeof(IsExprNode),
+    [NODE_SELF] = sizeof(SelfNode),
+    [NODE_BASE_CALL] = sizeof(BaseCallNode),
+    [NODE_DECOR_BLOCK] = sizeof(DecorBlockNode),
+    [NODE_DECOR_ITEM] = sizeof(DecorItemNode),
+    [NODE_CONCAT_EXPR] = sizeof(ConcatExprNode),
+    [NODE_VECTOR_LIT] = sizeof(VectorLitNode),
+    [NODE_INDEX_EXPR] = sizeof(IndexExprNode),
+};
+
+HulkNode* hulk_ast_clone(HulkASTContext *ctx, HulkNode *node) {
+    if (!node || node->type < 0 || node->type >= NODE_HULK_COUNT) return NULL;
+    HulkNode *copy = hulk_ast_alloc(ctx, node_sizes[node->type]);
+    if (!copy) return NULL;
+    memcpy(copy, node, node_sizes[node->type]);
+    copy->id = ctx->node_count++;
+    copy->static_type = NULL;
+    if (node->type == NODE_IDENT)
+        memset(&((IdentNode*)copy)->binding, 0, sizeof(HulkBinding));
+
+    HulkNodeSlots from, to;
+    hulk_ast_slots(node, &from);
+    hulk_ast_slots(copy, &to);
+    for (int i = 0; i < to.nfixed; i++)
+        *to.fixed[i] = hulk_ast_clone(ctx, *from.fixed[i]);
+    for (int l = 0; l < to.nlists; l++) {
+        HulkNodeList *src = from.lists[l];
+        hulk_node_list_init_in(to.lists[l], ctx);
+        hulk_node_list_reserve(to.lists[l], src->count);
+        for (int i = 0; i < src->count; i++)
+            hulk_node_list_push(to.lists[l], hulk_ast_clone(ctx, src->items[i]));
+    }
+    return copy;
+}
+
 // ============== NOMBRES PARA DEBUGGING ==============
 
 static const char* node_type_names[] = {
@@ -0,0 +1,479 @@
+/*
+ * hulk_callgraph.c — Grafo de llamadas del programa y sus SCC
+ *
+ * Primero crea un nodo por declaración (raíz, funciones, constructores y
+ * métodos) e indexa tipos y métodos por nombre; después recorre el
+ * código de cada nodo con una pila explícita y agrega sus aristas, que
+ * quedan contiguas por origen. Las llamadas a métodos se resuelven con
+ * los intervalos DFS de la jerarquía (hulk_hierarchy): un método de T
+ * es destino de obj.m(...) con obj de tipo S si T es subtipo de S, o si
+ * es el ancestro de S más profundo que define m.
+ *
+ * Las SCC salen de un Tarjan iterativo (las cadenas de llamadas pueden
+ * tener miles de niveles).
+ */
+
+#include "hulk_callgraph.h"
+#include "hulk_hierarchy.h"
+#include "hulk_intern.h"
+#include "hulk_name_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    HulkCallGraph *g;
+    int            ok;
+    /* tipos de usuario (sin protocolos), por posición */
+    TypeDefNode  **tdefs;
+    int            ntypes;
+    int           *parent, *pre, *post;
+    int           *ctor;        // tipo → nodo de su constructor
+    HulkNameIndex  types;       // nombre → tipo
+    /* métodos y funciones */
+    int           *mtype;       // nodo → tipo del método, o -1
+    int           *mnext;       // nodo → siguiente método del mismo nombre
+    HulkNameIndex  methods;     // nombre → primer método con ese nombre
+    HulkNameIndex  fns;         // nombre → función global
+    /* recorrido del nodo actual */
+    int            src;
+    const char    *method;      // nombre del método actual (para base)
+    int            owner;       // tipo del método actual, o -1
+    int           *seen;        // destino → último origen que lo agregó
+    int            edge_cap;
+    HulkNode     **stack;
+    int            top, cap;
+} Build;
+
+static int add_node(Build *b, HulkNode *decl, const char *owner, int type) {
+    HulkCallGraph *g = b->g;
+    int k = g->count++;
+    HulkCallNode *n = &g->nodes[k];
+    memset(n, 0, sizeof(*n));
+    n->decl = decl;
+    n->owner = owner;
+    b->mtype[k] = type;
+    b->mnext[k] = -1;
+    int *slot = hulk_side_put(&g->index, decl);
+    if (slot) *slot = k;
+    else b->ok = 0;
+    return k;
+}
+
+static void add_edge(Build *b, int to) {
+    if (to < 0) return;
+    HulkCallGraph *g = b->g;
+    if (to == b->src) g->nodes[b->src].self_loop = 1;
+    if (b->seen[to] == b->src) return;
+    b->seen[to] = b->src;
+    if (g->edge_count >= b->edge_cap) {
+        int nc = b->edge_cap ? b->edge_cap * 2 : 256;
+        int *ne = realloc(g->edges, sizeof(int) * (size_t)nc);
+        if (!ne) { b->ok = 0; return; }
+        g->edges = ne;
+        b->edge_cap = nc;
+    }
+    g->edges[g->edge_count++] = to;
+    g->nodes[b->src].edge_count++;
+}
+
+static void push(Build *b, HulkNode *n) {
+    if (!n) return;
+    if (b->top >= b->cap) {
+        int nc = b->cap ? b->cap * 2 : 256;
+        HulkNode **ns = realloc(b->stack, sizeof(HulkNode*) * (size_t)nc);
+        if (!ns) { b->ok = 0; return; }
+        b->stack = ns;
+        b->cap = nc;
+    }
+    b->stack[b->top++] = n;
+}
+
+static void push_list(Build *b, HulkNodeList *list) {
+    for (int i = 0; i < list->count; i++) push(b, list->items[i]);
+}
+
+static int find_type(Build *b, const char *name) {
+    return name ? hulk_name_index_find(&b->types, name) : -1;
+}
+
+/* Función global que nombra `id`: la de su binding o, sin semántico,
+ * la primera con ese nombre. -1 si es built-in, local o no existe. */
+static int function_of(Build *b, IdentNode *id) {
+    if (id->binding.kind == HULK_BIND_GLOBAL) {
+        HulkNode *d = id->binding.decl;
+        return d && d->type == NODE_FUNCTION_DEF
+            ? hulk_callgraph_find(b->g, d) : -1;
+    }
+    if (id->binding.kind != HULK_BIND_NONE || !id->name) return -1;
+    return hulk_name_index_find(&b->fns, id->name);
+}
+
+/* Aristas a los métodos `name` que obj.name(...) puede ejecutar con obj
+ * de tipo estático `st`. */
+static void call_method(Build *b, const char *st, const char *name) {
+    int k = name ? hulk_name_index_find(&b->methods, name) : -1;
+    int s = find_type(b, st);
+    if (s < 0 || !b->pre[s]) {
+        for (; k >= 0; k = b->mnext[k]) add_edge(b, k);
+        return;
+    }
+    int best = -1, own = 0;
+    for (; k >= 0; k = b->mnext[k]) {
+        int t = b->mtype[k];
+        if (HULK_HIERARCHY_CONTAINS(b->pre[s], b->post[s], b->pre[t], b->post[t])) {
+            add_edge(b, k);                        /* S o un subtipo */
+            own |= t == s;
+        } else if (HULK_HIERARCHY_CONTAINS(b->pre[t], b->post[t], b->pre[s], b->post[s]) &&
+                 (best < 0 || b->pre[t] > b->pre[b->mtype[best]]))
+            best = k;                              /* ancestro más cercano */
+    }
+    if (!own) add_edge(b, best);
+}
+
+/* Implementación de `name` del ancestro más cercano de `t` (inclusive). */
+static int inherited(Build *b, int t, const char *name) {
+    if (t < 0 || !name) return -1;
+    int best = -1;
+    for (int k = hulk_name_index_find(&b->methods, name); k >= 0; k = b->mnext[k]) {
+        int u = b->mtype[k];
+        if (u == t) return k;
+        if (HULK_HIERARCHY_CONTAINS(b->pre[u], b->post[u], b->pre[t], b->post[t]) &&
+            (best < 0 || b->pre[u] > b->pre[b->mtype[best]]))
+            best = k;
+    }
+    return best;
+}
+
+/* Aristas del nodo `n` mismo; apila los hijos que hay que seguir. */
+static void visit(Build *b, HulkNode *n) {
+    HulkCallNode *src = &b->g->nodes[b->src];
+    switch (n->type) {
+        case NODE_CALL_EXPR: {
+            CallExprNode *call = (CallExprNode*)n;
+            HulkNode *callee = call->callee;
+            push_list(b, &call->args);
+            if (callee && callee->type == NODE_IDENT) {
+                IdentNode *id = (IdentNode*)callee;
+                int f = function_of(b, id);
+                if (f >= 0) add_edge(b, f);
+                else if (id->binding.kind == HULK_BIND_LOCAL ||
+                         id->binding.kind == HULK_BIND_CAPTURE)
+                    src->calls_unknown = 1;        /* closure */
+                return;
+            }
+            if (callee && callee->type == NODE_MEMBER_ACCESS) {
+                MemberAccessNode *ma = (MemberAccessNode*)callee;
+                call_method(b, ma->object ? ma->object->static_type : NULL,
+                            ma->member);
+                push(b, ma->object);
+                return;
+            }
+            src->calls_unknown = 1;                /* f(x)(y), (lambda)(x) */
+            push(b, callee);
+            return;
+        }
+        case NODE_IDENT: {
+            int f = function_of(b, (IdentNode*)n);
+            if (f >= 0) b->g->nodes[f].escapes = 1;
+            return;
+        }
+        case NODE_DESTRUCT_ASSIGN: {
+            DestructAssignNode *da = (DestructAssignNode*)n;
+            push(b, da->value);
+            if (da->target && da->target->type == NODE_IDENT) {
+                int f = function_of(b, (IdentNode*)da->target);
+                if (f >= 0) b->g->nodes[f].wrapped = 1;  /* f := d(f) */
+                return;
+            }
+            push(b, da->target);
+            return;
+        }
+        case NODE_DECOR_ITEM: {
+            DecorItemNode *di = (DecorItemNode*)n;
+            add_edge(b, di->name ? hulk_name_index_find(&b->fns, di->name) : -1);
+            if (di->args.count > 0) src->calls_unknown = 1;  /* fábrica */
+            push_list(b, &di->args);
+            return;
+        }
+        case NODE_BASE_CALL:
+            if (b->owner >= 0)
+                add_edge(b, inherited(b, b->parent[b->owner], b->method));
+            break;
+        case NODE_NEW_EXPR: {
+            int t = find_type(b, ((NewExprNode*)n)->type_name);
+            if (t >= 0) add_edge(b, b->ctor[t]);
+            break;
+        }
+        case NODE_FOR_STMT: {                      /* protocolo de iterable */
+            ForStmtNode *fs = (ForStmtNode*)n;
+            const char *st = fs->iterable ? fs->iterable->static_type : NULL;
+            call_method(b, st, hulk_intern("next"));
+            call_method(b, st, hulk_intern("current"));
+            break;
+        }
+        default: break;
+    }
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++) push(b, *s.fixed[i]);
+    for (int l = 0; l < s.nlists; l++) push_list(b, s.lists[l]);
+}
+
+static void drain(Build *b) {
+    while (b->top > 0 && b->ok) visit(b, b->stack[--b->top]);
+}
+
+/* Recorre el código del nodo `k` y agrega sus aristas. */
+static void walk_node(Build *b, int k, ProgramNode *prog) {
+    HulkCallGraph *g = b->g;
+    HulkNode *decl = g->nodes[k].decl;
+    b->src = k;
+    b->method = NULL;
+    b->owner = -1;
+    g->nodes[k].first_edge = g->edge_count;
+
+    switch (decl->type) {
+        case NODE_PROGRAM:
+            for (int i = 0; i < prog->declarations.count; i++) {
+                HulkNode *d = prog->declarations.items[i];
+                if (d->type == NODE_FUNCTION_DEF || d->type == NODE_TYPE_DEF)
+                    continue;
+                if (d->type == NODE_DECOR_BLOCK)   /* sin desugarizar */
+                    push_list(b, &((DecorBlockNode*)d)->decorators);
+                else
+                    push(b, d);
+            }
+            break;
+        case NODE_FUNCTION_DEF: {
+            FunctionDefNode *fn = (FunctionDefNode*)decl;
+            push_list(b, &fn->params);
+            push(b, fn->body);
+            break;
+        }
+        case NODE_METHOD_DEF: {
+            MethodDefNode *md = (MethodDefNode*)decl;
+            b->method = md->name;
+            b->owner = b->mtype[k];
+            push_list(b, &md->params);
+            push(b, md->body);
+            push_list(b, &md->decorators);
+            break;
+        }
+        case NODE_TYPE_DEF: {
+            TypeDefNode *td = (TypeDefNode*)decl;
+            int t = b->mtype[k];
+            if (b->parent[t] >= 0) add_edge(b, b->ctor[b->parent[t]]);
+            push_list(b, &td->params);
+            push_list(b, &td->parent_args);
+            for (int m = 0; m < td->members.count; m++)
+                if (td->members.items[m]->type == NODE_ATTRIBUTE_DEF)
+                    push(b, td->members.items[m]);
+            break;
+        }
+        default: break;
+    }
+    drain(b);
+}
+
+/* Declaración de función o tipo de `d` (la de un DecorBlock sin
+ * desugarizar es su destino). */
+static HulkNode* declared(HulkNode *d) {
+    if (d->type == NODE_DECOR_BLOCK) d = ((DecorBlockNode*)d)->target;
+    if (!d) return NULL;
+    if (d->type == NODE_TYPE_DEF && ((TypeDefNode*)d)->is_protocol) return NULL;
+    return d->type == NODE_FUNCTION_DEF || d->type == NODE_TYPE_DEF ? d : NULL;
+}
+
+/* Tarjan iterativo; numera las SCC en el orden en que se cierran. */
+static int tarjan(HulkCallGraph *g) {
+    int n = g->count;
+    int *idx  = calloc((size_t)n, sizeof(int));
+    int *low  = malloc(sizeof(int) * (size_t)n);
+    int *stk  = malloc(sizeof(int) * (size_t)n);
+    int *call = malloc(sizeof(int) * (size_t)n);
+    int *pos  = malloc(sizeof(int) * (size_t)n);
+    unsigned char *on = calloc((size_t)n, 1);
+    g->order = malloc(sizeof(int) * (size_t)n);
+    g->scc_start = malloc(sizeof(int) * (size_t)(n + 1));
+    int ok = idx && low && stk && call && pos && on && g->order && g->scc_start;
+
+    int counter = 1, sp = 0, out = 0;
+    for (int r = 0; ok && r < n; r++) {
+        if (idx[r]) continue;
+        int cp = 0;
+        idx[r] = low[r] = counter++;
+        stk[sp++] = r;
+        on[r] = 1;
+        call[cp] = r;
+        pos[cp++] = 0;
+        while (cp > 0) {
+            int v = call[cp - 1];
+            HulkCallNode *nv = &g->nodes[v];
+            if (pos[cp - 1] < nv->edge_count) {
+                int w = g->edges[nv->first_edge + pos[cp - 1]++];
+                if (!idx[w]) {
+                    idx[w] = low[w] = counter++;
+                    stk[sp++] = w;
+                    on[w] = 1;
+                    call[cp] = w;
+                    pos[cp++] = 0;
+                } else if (on[w] && idx[w] < low[v]) {
+                    low[v] = idx[w];
+                }
+                continue;
+            }
+            if (--cp > 0 && low[v] < low[call[cp - 1]])
+                low[call[cp - 1]] = low[v];
+            if (low[v] != idx[v]) continue;
+            g->scc_start[g->scc_count] = out;
+            int w;
+            do {
+                w = stk[--sp];
+                on[w] = 0;
+                g->nodes[w].scc = g->scc_count;
+                g->order[out++] = w;
+            } while (w != v);
+            g->scc_count++;
+        }
+    }
+    if (ok) g->scc_start[g->scc_count] = out;
+    free(idx); free(low); free(stk); free(call); free(pos); free(on);
+    return ok;
+}
+
+int hulk_callgraph_build(HulkCallGraph *g, HulkNode *program) {
+    memset(g, 0, sizeof(*g));
+    hulk_side_init(&g->index, sizeof(int));
+    if (!program || program->type != NODE_PROGRAM) return 1;
+    ProgramNode *prog = (ProgramNode*)program;
+
+    /* Cuántos nodos y tipos hay. */
+    int nodes = 1, ntypes = 0;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *d = declared(prog->declarations.items[i]);
+        if (!d) continue;
+        nodes++;
+        if (d->type == NODE_TYPE_DEF) {
+            ntypes++;
+            nodes += ((TypeDefNode*)d)->members.count;
+        }
+    }
+
+    Build b;
+    memset(&b, 0, sizeof(b));
+    b.g = g;
+    b.ok = 1;
+    g->nodes = malloc(sizeof(HulkCallNode) * (size_t)nodes);
+    b.mtype  = malloc(sizeof(int) * (size_t)nodes);
+    b.mnext  = malloc(sizeof(int) * (size_t)nodes);
+    b.seen   = malloc(sizeof(int) * (size_t)nodes);
+    b.tdefs  = malloc(sizeof(TypeDefNode*) * (size_t)(ntypes + 1));
+    b.parent = malloc(sizeof(int) * (size_t)(ntypes + 1));
+    b.pre    = malloc(sizeof(int) * (size_t)(ntypes + 1));
+    b.post   = malloc(sizeof(int) * (size_t)(ntypes + 1));
+    b.ctor   = malloc(sizeof(int) * (size_t)(ntypes + 1));
+    if (!g->nodes || !b.mtype || !b.mnext || !b.seen || !b.tdefs ||
+        !b.parent || !b.pre || !b.post || !b.ctor)
+        b.ok = 0;
+
+    /* Nodos: raíz, funciones y tipos en orden de declaración. */
+    if (b.ok) add_node(&b, program, NULL, -1);
+    for (int i = 0; b.ok && i < prog->declarations.count; i++) {
+        HulkNode *d = declared(prog->declarations.items[i]);
+        if (!d) continue;
+        if (d->type == NODE_FUNCTION_DEF) {
+            int k = add_node(&b, d, NULL, -1);
+            hulk_name_index_add(&b.fns, ((FunctionDefNode*)d)->name, k);
+            if (d != prog->declarations.items[i]) g->nodes[k].wrapped = 1;
+            continue;
+        }
+        TypeDefNode *td = (TypeDefNode*)d;
+        int t = b.ntypes++;
+        b.tdefs[t] = td;
+        hulk_name_index_add(&b.types, td->name, t);
+        b.ctor[t] = add_node(&b, d, td->name, t);
+        for (int m = 0; m < td->members.count; m++) {
+            HulkNode *member = td->members.items[m];
+            if (member->type != NODE_METHOD_DEF) continue;
+            MethodDefNode *md = (MethodDefNode*)member;
+            int k = add_node(&b, member, td->name, t);
+            if (md->decorators.count > 0) g->nodes[k].wrapped = 1;
+            /* Encadenados por nombre detrás del primero. */
+            int head = hulk_name_index_find(&b.methods, md->name);
+            if (head < 0) {
+                hulk_name_index_add(&b.methods, md->name, k);
+            } else {
+                b.mnext[k] = b.mnext[head];
+                b.mnext[head] = k;
+            }
+        }
+    }
+
+    /* Jerarquía: padres por posición e intervalos DFS. */
+    if (b.ok) {
+        for (int t = 0; t < b.ntypes; t++)
+            b.parent[t] = find_type(&b, b.tdefs[t]->parent);
+        if (!hulk_hierarchy_number(b.ntypes, b.parent, b.pre, b.post)) b.ok = 0;
+    }
+
+    /* Aristas de cada nodo. */
+    if (b.ok) {
+        for (int k = 0; k < g->count; k++) b.seen[k] = -1;
+        for (int k = 0; b.ok && k < g->count; k++) walk_node(&b, k, prog);
+    }
+
+    /* Llamar a una función envuelta ejecuta primero su decorador. */
+    for (int k = 0; b.ok && k < g->count; k++) {
+        HulkCallNode *n = &g->nodes[k];
+        for (int e = 0; e < n->edge_count; e++)
+            if (g->nodes[g->edges[n->first_edge + e]].wrapped)
+                n->calls_unknown = 1;
+    }
+
+    if (b.ok && !tarjan(g)) b.ok = 0;
+
+    hulk_name_index_free(&b.types);
+    hulk_name_index_free(&b.methods);
+    hulk_name_index_free(&b.fns);
+    free(b.tdefs); free(b.parent); free(b.pre); free(b.post); free(b.ctor);
+    free(b.mtype); free(b.mnext); free(b.seen); free(b.stack);
+    if (!b.ok) {
+        hulk_callgraph_free(g);
+        hulk_side_init(&g->index, sizeof(int));
+    }
+    return b.ok;
+}
+
+void hulk_callgraph_free(HulkCallGraph *g) {
+    free(g->nodes);
+    free(g->edges);
+    free(g->order);
+    free(g->scc_start);
+    hulk_side_free(&g->index);
+    memset(g, 0, sizeof(*g));
+}
+
+int hulk_callgraph_find(const HulkCallGraph *g, const HulkNode *decl) {
+    const int *k = decl ? hulk_side_get(&g->index, decl) : NULL;
+    return k ? *k : -1;
+}
+
+int hulk_callgraph_is_recursive(const HulkCallGraph *g, int node) {
+    if (node < 0 || node >= g->count) return 0;
+    int s = g->nodes[node].scc;
+    return g->nodes[node].self_loop ||
+           (g->scc_start && g->scc_start[s + 1] - g->scc_start[s] > 1);
+}
+
+int hulk_callgraph_is_leaf(const HulkCallGraph *g, int node) {
+    if (node < 0 || node >= g->count) return 0;
+    return g->nodes[node].edge_count == 0 && !g->nodes[node].calls_unknown;
+}
+
+int hulk_callgraph_calls(const HulkCallGraph *g, int from, int to) {
+    if (from < 0 || from >= g->count) return 0;
+    const HulkCallNode *n = &g->nodes[from];
+    for (int e = 0; e < n->edge_count; e++)
+        if (g->edges[n->first_edge + e] == to) return 1;
+    return 0;
+}
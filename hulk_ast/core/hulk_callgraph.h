@@ -0,0 +1,95 @@
+/*
+ * hulk_callgraph.h — Grafo de llamadas del programa y sus SCC
+ *
+ * Inlining, análisis de pureza y el reparto del codegen entre hilos
+ * necesitan saber quién llama a quién en todo el programa ("¿f es
+ * recursiva?", "¿g no llama a nada?", "¿en qué orden procesar para ver
+ * siempre antes a los llamados?"). Este módulo recorre el AST anotado
+ * por el semántico UNA vez, arma el grafo y calcula sus componentes
+ * fuertemente conexas (Tarjan iterativo); las consultas son O(1).
+ *
+ * Nodos: cada función global, cada método, el constructor de cada tipo
+ * (argumentos al padre e inicializadores de atributos, con el TypeDef
+ * como declaración) y una raíz con las expresiones globales.
+ *
+ * Aristas, sin repetir, desde el nodo cuyo código contiene la llamada:
+ *   - f(...) con f ligada a una función global (IdentNode.binding);
+ *   - obj.m(...): la implementación de m que hereda el tipo estático de
+ *     obj más toda redefinición de m en sus subtipos (lo que el dispatch
+ *     por vtable puede alcanzar); sin tipo estático de usuario (Object,
+ *     protocolo), todo método llamado m;
+ *   - base(...): la implementación de m del ancestro más cercano;
+ *   - new T(...): el constructor de T, y este el de su padre;
+ *   - for: next y current del tipo estático del iterable;
+ *   - decoradores: la aplicación de cada uno (el `f := d(f)` global del
+ *     desugaring, o los de un método desde el método).
+ * Las lambdas no son nodos: su cuerpo cuenta como código de quien la
+ * contiene. Llamar a un valor función (variable, resultado de otra
+ * llamada) o a una función envuelta por un decorador no tiene destino
+ * conocido: el nodo queda con calls_unknown. Una función global nombrada
+ * como valor queda con escapes (una llamada desconocida puede llegar a
+ * ella). Las built-in no son nodos ni aristas.
+ *
+ * Las SCC se numeran en el orden en que Tarjan las cierra, que es
+ * ascendente en el grafo de componentes: todo llamado está en una SCC
+ * de número menor o igual que la de su llamador. `order` lista los
+ * nodos en ese orden, con cada SCC contigua.
+ *
+ * Las claves son nodos del AST, que no debe modificarse mientras se
+ * consulte el grafo.
+ *
+ * Responsabilidad única (SRP): solo construye y consulta el grafo; qué
+ * optimizar con él es decisión de cada fase.
+ */
+
+#ifndef HULK_CALLGRAPH_H
+#define HULK_CALLGRAPH_H
+
+#include "hulk_ast.h"
+#include "hulk_ast_side.h"
+
+typedef struct {
+    HulkNode     *decl;          // FunctionDef, MethodDef, TypeDef o Program
+    const char   *owner;         // tipo del método o constructor; NULL si no
+    int           first_edge;    // destinos en edges[first_edge ..]
+    int           edge_count;
+    int           scc;           // componente (orden ascendente)
+    unsigned char self_loop;     // se llama directamente a sí mismo
+    unsigned char calls_unknown; // llama a algo sin destino conocido
+    unsigned char escapes;       // se usa como valor
+    unsigned char wrapped;       // un decorador la reemplaza
+} HulkCallNode;
+
+// Cero-inicializado es un grafo vacío válido.
+typedef struct {
+    HulkCallNode *nodes;
+    int           count;
+    int          *edges;         // destinos agrupados por origen
+    int           edge_count;
+    int          *order;         // nodos de abajo hacia arriba
+    int          *scc_start;     // SCC s ocupa order[scc_start[s] .. s+1)
+    int           scc_count;
+    HulkSideTable index;         // declaración → posición en nodes
+} HulkCallGraph;
+
+// El nodo raíz (expresiones globales) es siempre el 0.
+#define HULK_CALLGRAPH_ROOT 0
+
+// Arma el grafo de `program` ya analizado. Devuelve 0 si no hay memoria
+// (el grafo queda vacío).
+int  hulk_callgraph_build(HulkCallGraph *g, HulkNode *program);
+void hulk_callgraph_free(HulkCallGraph *g);
+
+// Posición del nodo de `decl`, o -1.
+int  hulk_callgraph_find(const HulkCallGraph *g, const HulkNode *decl);
+
+// Está en un ciclo de llamadas conocidas (incluida la llamada a sí mismo).
+int  hulk_callgraph_is_recursive(const HulkCallGraph *g, int node);
+
+// No llama a ninguna función ni método del programa, conocido o no.
+int  hulk_callgraph_is_leaf(const HulkCallGraph *g, int node);
+
+// `from` llama directamente a `to`.
+int  hulk_callgraph_calls(const HulkCallGraph *g, int from, int to);
+
+#endif /* HULK_CALLGRAPH_H */
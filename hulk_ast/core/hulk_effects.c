@@ -0,0 +1,309 @@
+/*
+ * hulk_effects.c — Efectos de cada función sobre la memoria
+ *
+ * Dos pasadas sobre el grafo de llamadas:
+ *   1. Por nodo, lo que hace su propio código (pila explícita, como el
+ *      grafo): la peor clase que aparece y si tiene algún bucle.
+ *   2. Por SCC, en el orden del grafo (todo llamado antes que su
+ *      llamador): lo peor de los miembros y de lo que llaman fuera de la
+ *      SCC; una SCC recursiva no termina. Después, si el resultado de
+ *      cada miembro es memoria nueva.
+ *
+ * Lo que el codegen emite de cada nodo del AST decide su clase; ante la
+ * duda, la más alta.
+ */
+
+#include "hulk_effects.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    HulkNode **stack;
+    int        top, cap;
+    int        ok;
+    int        effect;   // peor clase vista en el nodo actual
+    int        loops;    // tiene un bucle
+} Walk;
+
+static void push(Walk *w, HulkNode *n) {
+    if (!n) return;
+    if (w->top >= w->cap) {
+        int nc = w->cap ? w->cap * 2 : 256;
+        HulkNode **ns = realloc(w->stack, sizeof(HulkNode*) * (size_t)nc);
+        if (!ns) { w->ok = 0; return; }
+        w->stack = ns;
+        w->cap = nc;
+    }
+    w->stack[w->top++] = n;
+}
+
+static void push_list(Walk *w, HulkNodeList *list) {
+    for (int i = 0; i < list->count; i++) push(w, list->items[i]);
+}
+
+static void worsen(Walk *w, int effect) {
+    if (effect > w->effect) w->effect = effect;
+}
+
+static int is_string(const HulkNode *n) {
+    return n && n->static_type && strcmp(n->static_type, "String") == 0;
+}
+
+/* Built-in que el codegen emite como llamada a libm (o hulk_log). */
+static int pure_builtin(const char *name) {
+    static const char *const names[] = { "sqrt", "sin", "cos", "exp", "log", "pow" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        if (strcmp(name, names[i]) == 0) return 1;
+    return 0;
+}
+
+static int is_function(const IdentNode *id) {
+    return id->binding.kind == HULK_BIND_GLOBAL && id->binding.decl &&
+           id->binding.decl->type == NODE_FUNCTION_DEF;
+}
+
+/* Llamada f(...) por nombre; los argumentos ya están apilados. */
+static void visit_named_call(Walk *w, IdentNode *id) {
+    const char *name = id->name ? id->name : "";
+    /* Intercepts del codegen, antes de resolver el nombre. */
+    if (strcmp(name, "print") == 0) { worsen(w, HULK_EFFECT_ANY); return; }
+    if (strcmp(name, "repeat") == 0) { w->loops = 1; return; }
+    if (strcmp(name, "__array_new") == 0) { worsen(w, HULK_EFFECT_ALLOC); return; }
+    if (is_function(id)) {
+        worsen(w, HULK_EFFECT_READ);        /* carga la celda del closure */
+        return;
+    }
+    if (id->binding.kind == HULK_BIND_GLOBAL && !id->binding.decl &&
+        pure_builtin(name))
+        return;
+    worsen(w, HULK_EFFECT_ANY);             /* closure, rand, __array_init… */
+}
+
+static void visit(Walk *w, HulkNode *n) {
+    switch (n->type) {
+        case NODE_CALL_EXPR: {
+            CallExprNode *call = (CallExprNode*)n;
+            push_list(w, &call->args);
+            if (call->callee && call->callee->type == NODE_IDENT) {
+                visit_named_call(w, (IdentNode*)call->callee);
+                return;
+            }
+            if (call->callee && call->callee->type == NODE_MEMBER_ACCESS) {
+                worsen(w, HULK_EFFECT_READ);    /* tag y vtable */
+                push(w, ((MemberAccessNode*)call->callee)->object);
+                return;
+            }
+            worsen(w, HULK_EFFECT_ANY);         /* f(x)(y), (lambda)(x) */
+            push(w, call->callee);
+            return;
+        }
+        case NODE_IDENT: {
+            IdentNode *id = (IdentNode*)n;
+            if (is_function(id) || id->binding.kind == HULK_BIND_CAPTURE)
+                worsen(w, HULK_EFFECT_READ);
+            return;
+        }
+        case NODE_ASSIGN:
+        case NODE_DESTRUCT_ASSIGN: {
+            HulkNode *target = n->type == NODE_ASSIGN
+                ? ((AssignNode*)n)->target : ((DestructAssignNode*)n)->target;
+            HulkNode *value = n->type == NODE_ASSIGN
+                ? ((AssignNode*)n)->value : ((DestructAssignNode*)n)->value;
+            push(w, value);
+            if (!target || target->type != NODE_IDENT ||
+                ((IdentNode*)target)->binding.kind != HULK_BIND_LOCAL)
+                worsen(w, HULK_EFFECT_ANY);     /* campo, captura, función */
+            return;
+        }
+        case NODE_BINARY_OP: {
+            BinaryOpNode *bo = (BinaryOpNode*)n;
+            if ((bo->op == OP_EQ || bo->op == OP_NEQ) &&
+                is_string(bo->left) && is_string(bo->right))
+                worsen(w, HULK_EFFECT_READ);    /* strcmp */
+            break;
+        }
+        case NODE_MEMBER_ACCESS:
+        case NODE_INDEX_EXPR:
+        case NODE_IS_EXPR:
+            worsen(w, HULK_EFFECT_READ);
+            break;
+        case NODE_NEW_EXPR:
+        case NODE_CONCAT_EXPR:
+        case NODE_VECTOR_LIT:
+        case NODE_FUNCTION_EXPR:
+            worsen(w, HULK_EFFECT_ALLOC);
+            break;
+        case NODE_WHILE_STMT:
+            w->loops = 1;
+            break;
+        case NODE_FOR_STMT:
+            w->loops = 1;
+            worsen(w, HULK_EFFECT_READ);
+            break;
+        case NODE_DECOR_ITEM:
+            worsen(w, HULK_EFFECT_ANY);
+            break;
+        default: break;
+    }
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++) push(w, *s.fixed[i]);
+    for (int l = 0; l < s.nlists; l++) push_list(w, s.lists[l]);
+}
+
+/* Clase y bucles del código propio de `decl` (las mismas partes que
+ * recorre el grafo de llamadas). */
+static void walk_decl(Walk *w, HulkNode *decl) {
+    w->effect = HULK_EFFECT_NONE;
+    w->loops = 0;
+    switch (decl->type) {
+        case NODE_FUNCTION_DEF: {
+            FunctionDefNode *fn = (FunctionDefNode*)decl;
+            push_list(w, &fn->params);
+            push(w, fn->body);
+            break;
+        }
+        case NODE_METHOD_DEF: {
+            MethodDefNode *md = (MethodDefNode*)decl;
+            push_list(w, &md->params);
+            push(w, md->body);
+            push_list(w, &md->decorators);
+            break;
+        }
+        case NODE_TYPE_DEF: {
+            TypeDefNode *td = (TypeDefNode*)decl;
+            worsen(w, HULK_EFFECT_ALLOC);       /* T_new: malloc y campos */
+            push_list(w, &td->params);
+            push_list(w, &td->parent_args);
+            for (int m = 0; m < td->members.count; m++)
+                if (td->members.items[m]->type == NODE_ATTRIBUTE_DEF)
+                    push(w, td->members.items[m]);
+            break;
+        }
+        default:                               /* raíz: es main */
+            worsen(w, HULK_EFFECT_ANY);
+            w->loops = 1;
+            return;
+    }
+    while (w->top > 0 && w->ok) visit(w, w->stack[--w->top]);
+}
+
+/* ¿El valor de `n` es siempre memoria recién reservada? Las llamadas
+ * solo cuentan hacia SCC ya cerradas (menores que `scc`). */
+static int fresh_value(const HulkEffects *fx, HulkNode *n, int scc) {
+    if (!n) return 0;
+    switch (n->type) {
+        case NODE_NEW_EXPR:
+        case NODE_CONCAT_EXPR:
+        case NODE_VECTOR_LIT:
+            return 1;
+        case NODE_LET_EXPR:
+            return fresh_value(fx, ((LetExprNode*)n)->body, scc);
+        case NODE_BLOCK_STMT: {
+            HulkNodeList *st = &((BlockStmtNode*)n)->statements;
+            return st->count > 0 && fresh_value(fx, st->items[st->count - 1], scc);
+        }
+        case NODE_IF_EXPR: {
+            IfExprNode *iff = (IfExprNode*)n;
+            if (!fresh_value(fx, iff->then_body, scc) ||
+                !fresh_value(fx, iff->else_body, scc))
+                return 0;
+            for (int i = 0; i < iff->elifs.count; i++)
+                if (!fresh_value(fx, ((ElifBranchNode*)iff->elifs.items[i])->body, scc))
+                    return 0;
+            return 1;
+        }
+        case NODE_CALL_EXPR: {
+            HulkNode *callee = ((CallExprNode*)n)->callee;
+            if (!callee || callee->type != NODE_IDENT ||
+                !is_function((IdentNode*)callee))
+                return 0;
+            const HulkEffectInfo *e =
+                hulk_effects_of_call(fx, ((IdentNode*)callee)->binding.decl);
+            int k = hulk_callgraph_find(&fx->graph, ((IdentNode*)callee)->binding.decl);
+            return e && e->fresh && fx->graph.nodes[k].scc < scc;
+        }
+        default:
+            return 0;
+    }
+}
+
+static HulkNode* result_of(HulkNode *decl) {
+    if (decl->type == NODE_FUNCTION_DEF) return ((FunctionDefNode*)decl)->body;
+    if (decl->type == NODE_METHOD_DEF) return ((MethodDefNode*)decl)->body;
+    return NULL;
+}
+
+int hulk_effects_analyze(HulkEffects *fx, HulkNode *program) {
+    memset(fx, 0, sizeof(*fx));
+    if (!hulk_callgraph_build(&fx->graph, program)) return 0;
+    HulkCallGraph *g = &fx->graph;
+    fx->info = calloc((size_t)(g->count > 0 ? g->count : 1), sizeof(HulkEffectInfo));
+    unsigned char *loops = calloc((size_t)(g->count > 0 ? g->count : 1), 1);
+    Walk w;
+    memset(&w, 0, sizeof(w));
+    w.ok = fx->info && loops;
+
+    /* 1. Código propio. */
+    for (int k = 0; w.ok && k < g->count; k++) {
+        walk_decl(&w, g->nodes[k].decl);
+        fx->info[k].effect = (unsigned char)w.effect;
+        loops[k] = (unsigned char)w.loops;
+    }
+
+    /* 2. Por SCC, de abajo hacia arriba. */
+    for (int s = 0; w.ok && s < g->scc_count; s++) {
+        int effect = HULK_EFFECT_NONE;
+        int terminates = 1;
+        for (int i = g->scc_start[s]; i < g->scc_start[s + 1]; i++) {
+            int k = g->order[i];
+            const HulkCallNode *n = &g->nodes[k];
+            if (fx->info[k].effect > effect) effect = fx->info[k].effect;
+            if (loops[k] || n->calls_unknown || hulk_callgraph_is_recursive(g, k))
+                terminates = 0;
+            if (n->calls_unknown) effect = HULK_EFFECT_ANY;
+            for (int e = 0; e < n->edge_count; e++) {
+                int t = g->edges[n->first_edge + e];
+                if (g->nodes[t].scc == s) continue;
+                if (fx->info[t].effect > effect) effect = fx->info[t].effect;
+                if (!fx->info[t].terminates) terminates = 0;
+            }
+        }
+        for (int i = g->scc_start[s]; i < g->scc_start[s + 1]; i++) {
+            HulkEffectInfo *info = &fx->info[g->order[i]];
+            info->effect = (unsigned char)effect;
+            info->terminates = (unsigned char)terminates;
+        }
+        for (int i = g->scc_start[s]; i < g->scc_start[s + 1]; i++) {
+            HulkNode *decl = g->nodes[g->order[i]].decl;
+            fx->info[g->order[i]].fresh = decl->type == NODE_TYPE_DEF ||
+                (unsigned char)fresh_value(fx, result_of(decl), s);
+        }
+    }
+
+    free(loops);
+    free(w.stack);
+    if (!w.ok) {
+        hulk_effects_free(fx);
+        return 0;
+    }
+    return 1;
+}
+
+void hulk_effects_free(HulkEffects *fx) {
+    hulk_callgraph_free(&fx->graph);
+    free(fx->info);
+    memset(fx, 0, sizeof(*fx));
+}
+
+const HulkEffectInfo* hulk_effects_of(const HulkEffects *fx, const HulkNode *decl) {
+    if (!fx->info) return NULL;
+    int k = hulk_callgraph_find(&fx->graph, decl);
+    return k >= 0 ? &fx->info[k] : NULL;
+}
+
+const HulkEffectInfo* hulk_effects_of_call(const HulkEffects *fx, const HulkNode *decl) {
+    if (!fx->info) return NULL;
+    int k = hulk_callgraph_find(&fx->graph, decl);
+    return k >= 0 && !fx->graph.nodes[k].wrapped ? &fx->info[k] : NULL;
+}
@@ -0,0 +1,75 @@
+/*
+ * hulk_effects.h — Efectos de cada función sobre la memoria
+ *
+ * El codegen emite las funciones sin atributos, así que LLVM supone que
+ * toda llamada puede escribir cualquier memoria, no retornar y devolver
+ * un puntero que ya existía: no puede reusar el resultado de una
+ * llamada repetida, sacarla de un bucle ni borrarla si no se usa. Este
+ * análisis recorre el grafo de llamadas (hulk_callgraph) de abajo hacia
+ * arriba y clasifica cada función, método y constructor:
+ *
+ *   NONE   no toca memoria: aritmética, locales y built-in matemáticas;
+ *   READ   además lee: campos, celdas de funciones globales (toda
+ *          llamada a una función global carga su closure), capturas,
+ *          == entre strings;
+ *   ALLOC  además reserva memoria y solo escribe en ella: new, @ y @@,
+ *          vectores, lambdas;
+ *   ANY    escribe memoria que ya existía o hace E/S: print, rand,
+ *          asignar un campo o una captura, llamar a un valor función
+ *          o a algo envuelto por un decorador.
+ *
+ * Cada clase incluye a las anteriores; una función vale lo peor entre
+ * su propio código y el de todo lo que llama (una SCC, lo peor de sus
+ * miembros). Aparte:
+ *
+ *   terminates  siempre retorna: ni bucles (while, for, repeat) ni
+ *               recursión, ni llamadas a algo que no termine o que no
+ *               se conozca;
+ *   fresh       el valor retornado es memoria recién reservada que nada
+ *               más apunta (new, @, vector, o llamada a otra función
+ *               fresh), en todas las ramas.
+ *
+ * La correspondencia con atributos de LLVM es del codegen.
+ *
+ * Responsabilidad única (SRP): solo clasifica; el AST no se modifica y
+ * debe seguir igual mientras se consulte el resultado.
+ */
+
+#ifndef HULK_EFFECTS_H
+#define HULK_EFFECTS_H
+
+#include "hulk_callgraph.h"
+
+typedef enum {
+    HULK_EFFECT_NONE,
+    HULK_EFFECT_READ,
+    HULK_EFFECT_ALLOC,
+    HULK_EFFECT_ANY,
+} HulkEffect;
+
+typedef struct {
+    unsigned char effect;      // HulkEffect
+    unsigned char terminates;
+    unsigned char fresh;
+} HulkEffectInfo;
+
+// Cero-inicializado no clasifica nada.
+typedef struct {
+    HulkCallGraph   graph;
+    HulkEffectInfo *info;      // por nodo del grafo
+} HulkEffects;
+
+// Clasifica las declaraciones de `program` ya analizado. Devuelve 0 si
+// no hay memoria (no queda nada clasificado).
+int  hulk_effects_analyze(HulkEffects *fx, HulkNode *program);
+void hulk_effects_free(HulkEffects *fx);
+
+// Efectos de ejecutar `decl` (FunctionDef, MethodDef o TypeDef para su
+// constructor), o NULL si no se clasificó.
+const HulkEffectInfo* hulk_effects_of(const HulkEffects *fx, const HulkNode *decl);
+
+// Efectos de una llamada por nombre a la función global `decl`: NULL
+// también si un decorador la reemplaza (se ejecuta otra cosa).
+const HulkEffectInfo* hulk_effects_of_call(const HulkEffects *fx, const HulkNode *decl);
+
+#endif /* HULK_EFFECTS_H */
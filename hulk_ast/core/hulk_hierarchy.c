@@ -0,0 +1,56 @@
+/*
+ * hulk_hierarchy.c — Intervalos DFS de una jerarquía de tipos
+ *
+ * Arma las listas de hijos (primer hijo / siguiente hermano, en orden de
+ * posición) y recorre cada raíz con una pila explícita: las cadenas de
+ * herencia pueden tener miles de niveles.
+ */
+
+#include "hulk_hierarchy.h"
+#include <stdlib.h>
+#include <string.h>
+
+int hulk_hierarchy_number(int n, const int *parent, int *pre, int *post) {
+    if (n <= 0) return 1;
+    memset(pre, 0, sizeof(int) * (size_t)n);
+    memset(post, 0, sizeof(int) * (size_t)n);
+
+    int *first = malloc(sizeof(int) * (size_t)n);
+    int *next  = malloc(sizeof(int) * (size_t)n);
+    int *stack = malloc(sizeof(int) * (size_t)n);
+    if (!first || !next || !stack) {
+        free(first); free(next); free(stack);
+        return 0;
+    }
+    for (int i = 0; i < n; i++) first[i] = next[i] = -1;
+    /* De atrás hacia adelante para que los hermanos queden en orden. */
+    for (int i = n - 1; i >= 0; i--) {
+        int p = parent[i];
+        if (p < 0 || p >= n || p == i) continue;
+        next[i] = first[p];
+        first[p] = i;
+    }
+
+    int clock = 0;
+    for (int r = 0; r < n; r++) {
+        if (parent[r] >= 0 && parent[r] < n && parent[r] != r) continue;
+        int top = 0;
+        stack[top++] = r;
+        pre[r] = ++clock;
+        while (top > 0) {
+            int u = stack[top - 1];
+            int ch = first[u];
+            if (ch >= 0) {
+                first[u] = next[ch];   /* consumir el hijo */
+                pre[ch] = ++clock;
+                stack[top++] = ch;
+            } else {
+                post[u] = ++clock;
+                top--;
+            }
+        }
+    }
+
+    free(first); free(next); free(stack);
+    return 1;
+}
@@ -0,0 +1,31 @@
+/*
+ * hulk_hierarchy.h — Intervalos DFS de una jerarquía de tipos
+ *
+ * "¿A es ancestro de B?" recorriendo la cadena de padres cuesta la
+ * profundidad de B, y el join (ancestro común) la profundidad al
+ * cuadrado. Una vez que la herencia es definitiva, un recorrido DFS del
+ * bosque de tipos numera cada uno con su intervalo [pre, post]: A es
+ * ancestro-o-igual de B si y solo si el intervalo de A contiene al de B,
+ * una comparación O(1).
+ *
+ * Los tipos se dan por posición con el índice de su padre (-1 para las
+ * raíces). La numeración empieza en 1: un 0 significa "sin índice" (tipo
+ * creado después, o atrapado en un ciclo sin raíz) y el caller debe
+ * volver a recorrer la cadena.
+ *
+ * Responsabilidad única (SRP): solo la numeración; cada fase guarda los
+ * intervalos en sus propias estructuras de tipo.
+ */
+
+#ifndef HULK_HIERARCHY_H
+#define HULK_HIERARCHY_H
+
+// Ambos intervalos numerados y el de (apre, apost) contiene al de b.
+#define HULK_HIERARCHY_CONTAINS(apre, apost, bpre, bpost) \
+    ((apre) && (bpre) && (apre) <= (bpre) && (bpost) <= (apost))
+
+// Llena pre[i] y post[i] de los n tipos; los no alcanzables desde una
+// raíz quedan en 0. Devuelve 0 si no hay memoria (todo queda en 0).
+int hulk_hierarchy_number(int n, const int *parent, int *pre, int *post);
+
+#endif /* HULK_HIERARCHY_H */
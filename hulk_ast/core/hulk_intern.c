@@ -0,0 +1,181 @@
+/*
+ * hulk_intern.c — Tabla global de strings internados
+ *
+ * INTERN_SHARDS tablas hash de direccionamiento abierto, elegidas por los
+ * bits bajos del hash (FNV-1a), cada una con su lock y su propio almacén
+ * por chunks. Cada string guardado va precedido por su cabecera
+ * {hash, len}, de donde leen hulk_intern_hash/len.
+ */
+
+#include "hulk_intern.h"
+#include "../../error_handler.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERN_SHARDS      64
+#define INTERN_INIT_CAP    256          // slots por shard (potencia de 2)
+#define INTERN_CHUNK_SIZE  (16 * 1024)
+
+typedef struct {
+    unsigned hash;
+    unsigned len;
+} InternHeader;
+
+typedef struct InternChunk {
+    struct InternChunk *next;
+    size_t used, size;
+    InternHeader data[];    // alineación de la cabecera
+} InternChunk;
+
+typedef struct {
+    pthread_mutex_t lock;
+    const char    **slots;  // NULL = vacío
+    unsigned        cap;
+    unsigned        count;
+    InternChunk    *chunks;
+} InternShard;
+
+static InternShard shards[INTERN_SHARDS];
+static pthread_once_t shards_once = PTHREAD_ONCE_INIT;
+
+static void shards_init(void) {
+    for (int i = 0; i < INTERN_SHARDS; i++)
+        pthread_mutex_init(&shards[i].lock, NULL);
+}
+
+static unsigned fnv1a(const char *s, size_t len) {
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static const InternHeader* header_of(const char *interned) {
+    return (const InternHeader*)interned - 1;
+}
+
+unsigned hulk_intern_hash(const char *interned) {
+    return header_of(interned)->hash;
+}
+
+size_t hulk_intern_len(const char *interned) {
+    return header_of(interned)->len;
+}
+
+// Slot de `s` en el shard: el que lo contiene o el vacío donde iría.
+static unsigned probe(const InternShard *sh, const char *s, size_t len,
+                      unsigned hash) {
+    unsigned mask = sh->cap - 1;
+    unsigned i = (hash / INTERN_SHARDS) & mask;
+    for (;;) {
+        const char *e = sh->slots[i];
+        if (!e) return i;
+        const InternHeader *h = header_of(e);
+        if (e == s || (h->hash == hash && h->len == len &&
+                       memcmp(e, s, len) == 0))
+            return i;
+        i = (i + 1) & mask;
+    }
+}
+
+static int shard_grow(InternShard *sh) {
+    unsigned ncap = sh->cap ? sh->cap * 2 : INTERN_INIT_CAP;
+    const char **nslots = calloc(ncap, sizeof(char*));
+    if (!nslots) return 0;
+    const char **old = sh->slots;
+    unsigned ocap = sh->cap;
+    sh->slots = nslots;
+    sh->cap = ncap;
+    for (unsigned i = 0; i < ocap; i++) {
+        if (!old[i]) continue;
+        const InternHeader *h = header_of(old[i]);
+        sh->slots[probe(sh, old[i], h->len, h->hash)] = old[i];
+    }
+    free(old);
+    return 1;
+}
+
+static char* shard_store(InternShard *sh, const char *s, size_t len,
+                         unsigned hash) {
+    size_t need = sizeof(InternHeader) + len + 1;
+    need = (need + sizeof(InternHeader) - 1) & ~(sizeof(InternHeader) - 1);
+    InternChunk *c = sh->chunks;
+    if (!c || c->size - c->used < need) {
+        size_t size = need > INTERN_CHUNK_SIZE ? need : INTERN_CHUNK_SIZE;
+        c = malloc(sizeof(InternChunk) + size);
+        if (!c) return NULL;
+        c->used = 0;
+        c->size = size;
+        if (need > INTERN_CHUNK_SIZE && sh->chunks) {
+            // String enorme: chunk propio, el actual sigue en uso
+            c->next = sh->chunks->next;
+            sh->chunks->next = c;
+        } else {
+            c->next = sh->chunks;
+            sh->chunks = c;
+        }
+    }
+    InternHeader *h = (InternHeader*)((char*)c->data + c->used);
+    c->used += need;
+    h->hash = hash;
+    h->len = (unsigned)len;
+    char *out = (char*)(h + 1);
+    memcpy(out, s, len);
+    out[len] = '\0';
+    return out;
+}
+
+static const char* intern(const char *s, size_t len, int insert) {
+    unsigned hash = fnv1a(s, len);
+    InternShard *sh = &shards[hash % INTERN_SHARDS];
+    pthread_once(&shards_once, shards_init);
+    pthread_mutex_lock(&sh->lock);
+
+    const char *out = NULL;
+    if (sh->cap) {
+        unsigned i = probe(sh, s, len, hash);
+        out = sh->slots[i];
+    }
+    if (!out && insert) {
+        // Factor de carga <= 1/2
+        if ((sh->count + 1) * 2 > sh->cap && !shard_grow(sh)) goto oom;
+        char *copy = shard_store(sh, s, len, hash);
+        if (!copy) goto oom;
+        sh->slots[probe(sh, copy, len, hash)] = copy;
+        sh->count++;
+        out = copy;
+    }
+    pthread_mutex_unlock(&sh->lock);
+    return out;
+
+oom:
+    pthread_mutex_unlock(&sh->lock);
+    LOG_FATAL_MSG("hulk_intern", "sin memoria para internar (%zu bytes)", len);
+    return NULL;
+}
+
+const char* hulk_intern_n(const char *s, size_t len) {
+    return s ? intern(s, len, 1) : NULL;
+}
+
+const char* hulk_intern(const char *s) {
+    return s ? intern(s, strlen(s), 1) : NULL;
+}
+
+const char* hulk_intern_find(const char *s) {
+    return s ? intern(s, strlen(s), 0) : NULL;
+}
+
+long hulk_intern_count(void) {
+    long n = 0;
+    pthread_once(&shards_once, shards_init);
+    for (int i = 0; i < INTERN_SHARDS; i++) {
+        pthread_mutex_lock(&shards[i].lock);
+        n += shards[i].count;
+        pthread_mutex_unlock(&shards[i].lock);
+    }
+    return n;
+}
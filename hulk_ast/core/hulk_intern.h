@@ -0,0 +1,41 @@
+/*
+ * hulk_intern.h — Tabla global de strings internados
+ *
+ * Los nombres (identificadores, tipos, miembros) se internan una sola
+ * vez al construir el AST: cada texto distinto tiene UNA copia canónica
+ * e inmutable, así que dos nombres internados son iguales si y solo si
+ * sus punteros lo son. El hash y el largo quedan guardados junto a la
+ * copia (hulk_intern_hash / hulk_intern_len no recorren el texto).
+ *
+ * La tabla vive hasta el fin del proceso, igual que la gramática del
+ * builder; es segura entre hilos (shards con su propio lock), porque el
+ * parseo paralelo interna desde varios hilos a la vez.
+ *
+ * Responsabilidad única (SRP): solo canonicaliza strings; no sabe de
+ * scopes ni de tipos.
+ */
+
+#ifndef HULK_INTERN_H
+#define HULK_INTERN_H
+
+#include <stddef.h>
+
+// Copia canónica de `s` (la crea si no existe). NULL si s es NULL.
+const char* hulk_intern(const char *s);
+
+// Igual, para los primeros `len` bytes de `s` (no requiere '\0').
+const char* hulk_intern_n(const char *s, size_t len);
+
+// Copia canónica de `s` sin crearla: NULL si nunca se internó. Sirve
+// para buscar con una clave que puede no estar internada sin llenar la
+// tabla con nombres que no existen.
+const char* hulk_intern_find(const char *s);
+
+// Solo para punteros devueltos por hulk_intern*: hash y largo guardados.
+unsigned    hulk_intern_hash(const char *interned);
+size_t      hulk_intern_len(const char *interned);
+
+// Cantidad de strings distintos internados hasta ahora.
+long        hulk_intern_count(void);
+
+#endif /* HULK_INTERN_H */
@@ -0,0 +1,65 @@
+/*
+ * hulk_name_index.c — Índice hash de nombres internados → posición
+ *
+ * Direccionamiento abierto con sondeo lineal sobre una potencia de dos,
+ * a lo sumo medio lleno. Sin borrado: los dueños solo agregan.
+ */
+
+#include "hulk_name_index.h"
+#include "../../error_handler.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+static unsigned ptr_hash(const void *p) {
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (unsigned)x;
+}
+
+void hulk_name_index_free(HulkNameIndex *ix) {
+    free(ix->slots);
+    ix->slots = NULL;
+    ix->cap = ix->count = 0;
+}
+
+static HulkNameSlot* probe(HulkNameSlot *slots, int cap, const char *key) {
+    unsigned mask = (unsigned)cap - 1;
+    unsigned i = ptr_hash(key) & mask;
+    while (slots[i].key && slots[i].key != key)
+        i = (i + 1) & mask;
+    return &slots[i];
+}
+
+int hulk_name_index_find(const HulkNameIndex *ix, const char *key) {
+    if (!ix->cap || !key) return -1;
+    HulkNameSlot *s = probe(ix->slots, ix->cap, key);
+    return s->key ? s->pos : -1;
+}
+
+static int grow(HulkNameIndex *ix) {
+    int nc = ix->cap ? ix->cap * 2 : 4 * HULK_NAME_INDEX_MIN;
+    HulkNameSlot *ns = calloc((size_t)nc, sizeof(HulkNameSlot));
+    if (!ns) {
+        LOG_FATAL_MSG("hulk_name_index", "sin memoria para el índice de nombres");
+        return 0;
+    }
+    for (int i = 0; i < ix->cap; i++)
+        if (ix->slots[i].key)
+            *probe(ns, nc, ix->slots[i].key) = ix->slots[i];
+    free(ix->slots);
+    ix->slots = ns;
+    ix->cap = nc;
+    return 1;
+}
+
+void hulk_name_index_add(HulkNameIndex *ix, const char *key, int pos) {
+    if (!key) return;
+    if (2 * (ix->count + 1) > ix->cap && !grow(ix)) return;
+    HulkNameSlot *s = probe(ix->slots, ix->cap, key);
+    if (s->key) return;  // gana la primera
+    s->key = key;
+    s->pos = pos;
+    ix->count++;
+}
@@ -0,0 +1,46 @@
+/*
+ * hulk_name_index.h — Índice hash de nombres internados → posición
+ *
+ * Scopes, registros de tipos y miembros guardan sus entradas en un
+ * arreglo (el orden de definición importa para recorrerlas) y las buscan
+ * por nombre. Con pocas entradas, recorrer el arreglo comparando
+ * punteros es lo más rápido; con cientos (globales de un programa
+ * grande, tipos anchos) cada búsqueda es O(n). Este índice es una tabla
+ * de direccionamiento abierto, por puntero del nombre, que el dueño del
+ * arreglo mantiene al lado una vez que pasa de HULK_NAME_INDEX_MIN
+ * entradas; mientras tanto queda vacío y no cuesta nada.
+ *
+ * Ante nombres repetidos gana la primera posición agregada, igual que
+ * la búsqueda lineal que reemplaza.
+ *
+ * Responsabilidad única (SRP): solo el índice; el arreglo, su orden y
+ * qué se guarda en él son del dueño.
+ */
+
+#ifndef HULK_NAME_INDEX_H
+#define HULK_NAME_INDEX_H
+
+// Hasta este largo los dueños buscan linealmente y no indexan.
+#define HULK_NAME_INDEX_MIN 8
+
+typedef struct {
+    const char *key;
+    int         pos;
+} HulkNameSlot;
+
+// Cero-inicializado es un índice vacío válido.
+typedef struct {
+    HulkNameSlot *slots;
+    int           cap;     // 0 mientras no se indexa nada
+    int           count;
+} HulkNameIndex;
+
+void hulk_name_index_free(HulkNameIndex *ix);
+
+// Posición de `key` o -1. `key` se compara por puntero.
+int  hulk_name_index_find(const HulkNameIndex *ix, const char *key);
+
+// Registra key → pos; si `key` ya estaba conserva la posición anterior.
+void hulk_name_index_add(HulkNameIndex *ix, const char *key, int pos);
+
+#endif /* HULK_NAME_INDEX_H */
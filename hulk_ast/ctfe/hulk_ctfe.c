@@ -0,0 +1,240 @@
+/*
+ * hulk_ctfe.c — Pase de plegado: sustituye por literales lo evaluable
+ *
+ * Recorre el programa de abajo hacia arriba: primero pliega los hijos
+ * de cada nodo y, si todos sus operandos quedaron literales, intenta
+ * evaluarlo (hulk_ctfe_eval.c). Así `2 * 3 + f(4)` se resuelve por
+ * partes y una llamada solo se intenta con los argumentos ya constantes;
+ * un if con condiciones y ramas literales queda en la rama que toma.
+ *
+ * Un `let` cuyo valor inicial quedó literal y que ninguna asignación
+ * (= o :=) toca es una constante: cada uso de la variable se reemplaza
+ * por una copia del literal, y la expresión que la contenía puede
+ * plegarse a su vez.
+ *
+ * Lo que el pase deja como estaba a propósito:
+ *   - las capturas de una lambda (el codegen lee sus nombres);
+ *   - el callee de una llamada;
+ *   - un argumento de `new T(...)` que se volvería un StringLit: el
+ *     codegen infiere el tipo de los parámetros de T de los StringLit
+ *     que recibe (cg_infer_ctor_param_type), y no debe cambiar.
+ *
+ * El grafo de llamadas dice qué funciones envuelve un decorador (su
+ * llamada no ejecuta el cuerpo declarado). Solo se consultan nodos de
+ * declaración, que el pase nunca reemplaza.
+ *
+ * SRP: solo decide dónde evaluar y reemplaza; la evaluación es del
+ * intérprete.
+ */
+
+#include "hulk_ctfe_internal.h"
+#include <math.h>
+
+typedef struct {
+    HulkASTContext *ctx;
+    CtfeMachine     m;
+    HulkSideTable   assigned;   // VarBinding → char: destino de = o :=
+    HulkSideTable   consts;     // VarBinding → HulkNode*: su literal
+    int             folded;
+} Folder;
+
+static int is_literal(const HulkNode *n) {
+    return n && (n->type == NODE_NUMBER_LIT || n->type == NODE_STRING_LIT ||
+                 n->type == NODE_BOOL_LIT);
+}
+
+/* Variables que alguna asignación modifica: no son constantes. */
+static void collect_assigned(Folder *f, HulkNode *n) {
+    if (!n) return;
+    HulkNode *target = NULL;
+    if (n->type == NODE_ASSIGN) target = ((AssignNode*)n)->target;
+    else if (n->type == NODE_DESTRUCT_ASSIGN) target = ((DestructAssignNode*)n)->target;
+    if (target && target->type == NODE_IDENT &&
+        ((IdentNode*)target)->binding.decl) {
+        char *flag = hulk_side_put(&f->assigned, ((IdentNode*)target)->binding.decl);
+        if (flag) *flag = 1;
+    }
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++) collect_assigned(f, *s.fixed[i]);
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            collect_assigned(f, s.lists[l]->items[i]);
+}
+
+/* Literal con el valor `v` en el lugar de `at`. NULL si no conviene
+ * (string demasiado largo para meterlo en el binario) o si es NaN: el
+ * signo y el payload de un NaN dependen de la instrucción que lo
+ * produce, y el literal imprimiría "-nan" donde el programa da "nan". */
+static HulkNode* make_literal(Folder *f, const CtfeValue *v, const HulkNode *at) {
+    HulkNode *lit = NULL;
+    switch (v->kind) {
+        case CTFE_NUM: {
+            if (isnan(v->num)) return NULL;
+            char raw[32];
+            snprintf(raw, sizeof(raw), "%.17g", v->num);
+            NumberLitNode *nl = hulk_ast_number_lit(f->ctx, raw, at->line, at->col);
+            if (nl) nl->value = v->num;   /* exacto también para inf */
+            lit = (HulkNode*)nl;
+            break;
+        }
+        case CTFE_STR:
+            if (strlen(v->str) > HULK_CTFE_MAX_STRING) return NULL;
+            lit = (HulkNode*)hulk_ast_string_lit(f->ctx, v->str, at->line, at->col);
+            break;
+        case CTFE_BOOL:
+            lit = (HulkNode*)hulk_ast_bool_lit(f->ctx, v->b, at->line, at->col);
+            break;
+    }
+    if (lit) lit->static_type = at->static_type;
+    return lit;
+}
+
+/* ¿Todos los operandos de `n` son literales? Solo estos nodos se
+ * intentan evaluar: lo demás se pliega a través de ellos. */
+static int ready(const HulkNode *n) {
+    switch (n->type) {
+        case NODE_BINARY_OP:
+            return is_literal(((BinaryOpNode*)n)->left) &&
+                   is_literal(((BinaryOpNode*)n)->right);
+        case NODE_CONCAT_EXPR:
+            return is_literal(((ConcatExprNode*)n)->left) &&
+                   is_literal(((ConcatExprNode*)n)->right);
+        case NODE_UNARY_OP:
+            return is_literal(((UnaryOpNode*)n)->operand);
+        case NODE_CALL_EXPR: {
+            const CallExprNode *ce = (const CallExprNode*)n;
+            if (!ce->callee || ce->callee->type != NODE_IDENT ||
+                ((IdentNode*)ce->callee)->binding.kind != HULK_BIND_GLOBAL)
+                return 0;
+            for (int i = 0; i < ce->args.count; i++)
+                if (!is_literal(ce->args.items[i])) return 0;
+            return 1;
+        }
+        case NODE_IF_EXPR: {
+            const IfExprNode *iff = (const IfExprNode*)n;
+            if (!is_literal(iff->condition) || !is_literal(iff->then_body) ||
+                !is_literal(iff->else_body))
+                return 0;
+            for (int i = 0; i < iff->elifs.count; i++) {
+                const ElifBranchNode *e = (const ElifBranchNode*)iff->elifs.items[i];
+                if (!is_literal(e->condition) || !is_literal(e->body)) return 0;
+            }
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+static void replace(Folder *f, HulkNode **slot, const CtfeValue *v) {
+    HulkNode *lit = make_literal(f, v, *slot);
+    if (!lit) return;
+    *slot = lit;
+    f->folded++;
+}
+
+static void try_eval(Folder *f, HulkNode **slot) {
+    CtfeKind want;
+    CtfeValue v;
+    if (f->m.total_left <= 0 || !ctfe_kind_of((*slot)->static_type, &want))
+        return;
+    ctfe_site_reset(&f->m);
+    if (ctfe_eval(&f->m, *slot, &v) && v.kind == want)
+        replace(f, slot, &v);
+}
+
+static void substitute(Folder *f, HulkNode **slot) {
+    IdentNode *id = (IdentNode*)*slot;
+    if (id->binding.kind != HULK_BIND_LOCAL || !id->binding.decl) return;
+    HulkNode **lit = hulk_side_get(&f->consts, id->binding.decl);
+    CtfeKind want;
+    CtfeValue v;
+    if (!lit || !ctfe_kind_of(id->base.static_type, &want)) return;
+    ctfe_site_reset(&f->m);
+    if (ctfe_eval(&f->m, *lit, &v) && v.kind == want)
+        replace(f, slot, &v);
+}
+
+static void fold(Folder *f, HulkNode **slot);
+
+static void fold_list(Folder *f, HulkNodeList *list) {
+    for (int i = 0; i < list->count; i++) fold(f, &list->items[i]);
+}
+
+static void fold(Folder *f, HulkNode **slot) {
+    HulkNode *n = *slot;
+    if (!n) return;
+    switch (n->type) {
+        case NODE_IDENT:
+            substitute(f, slot);
+            return;
+        case NODE_LET_EXPR: {
+            LetExprNode *let = (LetExprNode*)n;
+            for (int i = 0; i < let->bindings.count; i++) {
+                VarBindingNode *vb = (VarBindingNode*)let->bindings.items[i];
+                fold(f, &vb->init_expr);
+                if (is_literal(vb->init_expr) &&
+                    !hulk_side_get(&f->assigned, (HulkNode*)vb)) {
+                    HulkNode **c = hulk_side_put(&f->consts, (HulkNode*)vb);
+                    if (c) *c = vb->init_expr;
+                }
+            }
+            fold(f, &let->body);
+            return;
+        }
+        case NODE_FUNCTION_EXPR:
+            fold_list(f, &((FunctionExprNode*)n)->params);
+            fold(f, &((FunctionExprNode*)n)->body);
+            return;
+        case NODE_NEW_EXPR: {
+            NewExprNode *ne = (NewExprNode*)n;
+            for (int i = 0; i < ne->args.count; i++) {
+                HulkNode *before = ne->args.items[i];
+                fold(f, &ne->args.items[i]);
+                if (ne->args.items[i]->type == NODE_STRING_LIT &&
+                    before->type != NODE_STRING_LIT)
+                    ne->args.items[i] = before;
+            }
+            return;
+        }
+        case NODE_CALL_EXPR: {
+            CallExprNode *ce = (CallExprNode*)n;
+            if (ce->callee && ce->callee->type != NODE_IDENT)
+                fold(f, &ce->callee);
+            fold_list(f, &ce->args);
+            break;
+        }
+        default: {
+            HulkNodeSlots s;
+            hulk_ast_slots(n, &s);
+            for (int i = 0; i < s.nfixed; i++) fold(f, s.fixed[i]);
+            for (int l = 0; l < s.nlists; l++) fold_list(f, s.lists[l]);
+            break;
+        }
+    }
+    if (ready(n)) try_eval(f, slot);
+}
+
+int hulk_ctfe_fold(HulkASTContext *ctx, HulkNode *program) {
+    if (!ctx || !program) return 0;
+    HulkCallGraph graph;
+    memset(&graph, 0, sizeof(graph));
+    if (!hulk_callgraph_build(&graph, program)) return 0;
+
+    Folder f;
+    memset(&f, 0, sizeof(f));
+    f.ctx = ctx;
+    ctfe_machine_init(&f.m, &graph);
+    hulk_side_init(&f.assigned, sizeof(char));
+    hulk_side_init(&f.consts, sizeof(HulkNode*));
+
+    collect_assigned(&f, program);
+    fold(&f, &program);
+
+    hulk_side_free(&f.consts);
+    hulk_side_free(&f.assigned);
+    ctfe_machine_free(&f.m);
+    hulk_callgraph_free(&graph);
+    return f.folded;
+}
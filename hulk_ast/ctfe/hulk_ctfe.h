@@ -0,0 +1,51 @@
+/*
+ * hulk_ctfe.h — Evaluación en tiempo de compilación (CTFE)
+ *
+ * Entre el semántico y el codegen, un intérprete del AST anotado evalúa
+ * lo que no depende de la ejecución y lo reemplaza por literales:
+ *
+ *   - operadores (+ - * / % ^, comparaciones, && ||, !, -, @, @@) cuyos
+ *     operandos ya son literales;
+ *   - llamadas a las built-in puras (sqrt, sin, cos, exp, log) y a
+ *     funciones globales con argumentos literales, si la evaluación de
+ *     su cuerpo no toca nada impuro (print, rand, objetos, lambdas…);
+ *   - los usos de un `let` cuyo valor inicial quedó literal y que nunca
+ *     se reasigna (la ligadura se conserva: una lambda puede capturarla).
+ *
+ *   function fact(n) -> if (n == 0) 1 else n * fact(n - 1);
+ *   print(fact(5));          // el codegen ve print(120)
+ *
+ * La semántica es la del código que emitiría el codegen, no la de la
+ * especificación: números double de C (% es fmod, ^ es pow de libm),
+ * números a string con "%g", == entre strings con strcmp solo si ambos
+ * lados son String estáticos, condiciones Number verdaderas si != 0.
+ * Ante cualquier duda (un tipo de LLVM que no sería el del valor, un
+ * if sin else, == entre punteros) la evaluación se abandona y el nodo
+ * queda como estaba: el resultado del programa no cambia nunca.
+ *
+ * Presupuestos: cada sitio tiene un máximo de pasos (nodos evaluados),
+ * de bytes de strings creados y de llamadas anidadas; el programa
+ * entero, un máximo de pasos. Una función que agota el presupuesto en
+ * HULK_CTFE_MAX_MISSES sitios no se vuelve a intentar.
+ *
+ * Responsabilidad única (SRP): solo evalúa y sustituye; el árbol
+ * resultante es un árbol anotado válido para el codegen.
+ */
+
+#ifndef HULK_CTFE_H
+#define HULK_CTFE_H
+
+#include "../core/hulk_ast.h"
+
+#define HULK_CTFE_MAX_STEPS   100000     // nodos evaluados por sitio
+#define HULK_CTFE_TOTAL_STEPS 4000000    // nodos evaluados por programa
+#define HULK_CTFE_MAX_BYTES   (1 << 20)  // bytes de strings por sitio
+#define HULK_CTFE_MAX_STRING  4096       // string más largo que se sustituye
+#define HULK_CTFE_MAX_DEPTH   200        // llamadas anidadas
+#define HULK_CTFE_MAX_MISSES  3          // sitios agotados por función
+
+// Pliega `program` (ya analizado sin errores) en el lugar. Los literales
+// nuevos salen de `ctx`. Devuelve la cantidad de nodos reemplazados.
+int hulk_ctfe_fold(HulkASTContext *ctx, HulkNode *program);
+
+#endif /* HULK_CTFE_H */
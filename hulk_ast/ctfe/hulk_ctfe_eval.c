@@ -0,0 +1,470 @@
+/*
+ * hulk_ctfe_eval.c — Intérprete del AST anotado para CTFE
+ *
+ * Evalúa un nodo con la semántica del IR que emite el codegen para él
+ * (ver hulk_ctfe.h). Cada caso copia la decisión del emisor
+ * correspondiente: si el emisor convertiría, compararía punteros o
+ * armaría un phi dudoso, aquí la evaluación se abandona con
+ * CTFE_UNSUPPORTED.
+ *
+ * Las variables viven en una pila de ligaduras (declaración → valor):
+ * una llamada apila sus parámetros y solo ve desde su marco. Los
+ * strings creados se registran en la máquina y se liberan al pasar al
+ * sitio siguiente.
+ *
+ * SRP: solo evalúa; qué reemplazar con el resultado es de hulk_ctfe.c.
+ */
+
+#include "hulk_ctfe_internal.h"
+#include <math.h>
+
+/* ============================================================
+ *  Máquina
+ * ============================================================ */
+
+void ctfe_machine_init(CtfeMachine *m, const HulkCallGraph *graph) {
+    memset(m, 0, sizeof(*m));
+    m->graph = graph;
+    m->total_left = HULK_CTFE_TOTAL_STEPS;
+    hulk_side_init(&m->expensive, sizeof(int));
+}
+
+void ctfe_site_reset(CtfeMachine *m) {
+    for (int i = 0; i < m->str_count; i++) free(m->strs[i]);
+    m->str_count = 0;
+    m->env_count = 0;
+    m->frame = 0;
+    m->status = CTFE_OK;
+    m->steps = 0;
+    m->bytes = 0;
+    m->depth = 0;
+}
+
+void ctfe_machine_free(CtfeMachine *m) {
+    ctfe_site_reset(m);
+    free(m->strs);
+    free(m->env);
+    hulk_side_free(&m->expensive);
+    memset(m, 0, sizeof(*m));
+}
+
+static int fail(CtfeMachine *m, CtfeStatus why) {
+    if (m->status == CTFE_OK) m->status = why;
+    return 0;
+}
+
+int ctfe_kind_of(const char *name, CtfeKind *out) {
+    if (!name) return 0;
+    if (strcmp(name, "Number") == 0)  { *out = CTFE_NUM;  return 1; }
+    if (strcmp(name, "String") == 0)  { *out = CTFE_STR;  return 1; }
+    if (strcmp(name, "Boolean") == 0) { *out = CTFE_BOOL; return 1; }
+    return 0;
+}
+
+/* Un valor de otra clase que la del tipo estático del nodo sería, en el
+ * IR, un tipo de LLVM distinto del que esperan sus usos. */
+static int agrees(const HulkNode *n, const CtfeValue *v) {
+    CtfeKind k;
+    return !ctfe_kind_of(n->static_type, &k) || k == v->kind;
+}
+
+static char* new_string(CtfeMachine *m, size_t len) {
+    if (m->bytes + len + 1 > HULK_CTFE_MAX_BYTES) {
+        fail(m, CTFE_BUDGET);
+        return NULL;
+    }
+    if (m->str_count >= m->str_cap) {
+        int nc = m->str_cap ? m->str_cap * 2 : 16;
+        char **ns = realloc(m->strs, sizeof(char*) * (size_t)nc);
+        if (!ns) { fail(m, CTFE_BUDGET); return NULL; }
+        m->strs = ns;
+        m->str_cap = nc;
+    }
+    char *s = malloc(len + 1);
+    if (!s) { fail(m, CTFE_BUDGET); return NULL; }
+    m->strs[m->str_count++] = s;
+    m->bytes += len + 1;
+    return s;
+}
+
+/* ============================================================
+ *  Conversiones del runtime
+ * ============================================================ */
+
+/* hulk_num_to_str / hulk_bool_to_str. Un NaN no se convierte: su signo
+ * depende de cómo se produjo en ejecución (ver make_literal). */
+static const char* to_string(CtfeMachine *m, const CtfeValue *v) {
+    switch (v->kind) {
+        case CTFE_STR:  return v->str;
+        case CTFE_BOOL: return v->b ? "true" : "false";
+        case CTFE_NUM: {
+            if (isnan(v->num)) { fail(m, CTFE_UNSUPPORTED); return NULL; }
+            char *s = new_string(m, 31);
+            if (s) snprintf(s, 32, "%g", v->num);
+            return s;
+        }
+    }
+    return NULL;
+}
+
+/* Condición de if/while/&&/||: i1 tal cual, double con `fcmp one 0.0`
+ * (NaN es falso); un puntero no es una condición válida. */
+static int truthy(CtfeMachine *m, const CtfeValue *v, int *out) {
+    if (v->kind == CTFE_BOOL) { *out = v->b; return 1; }
+    if (v->kind == CTFE_NUM)  { *out = v->num < 0.0 || v->num > 0.0; return 1; }
+    return fail(m, CTFE_UNSUPPORTED);
+}
+
+static void set_num(CtfeValue *out, double x) {
+    out->kind = CTFE_NUM;
+    out->num = x;
+}
+
+static void set_bool(CtfeValue *out, int b) {
+    out->kind = CTFE_BOOL;
+    out->b = b != 0;
+}
+
+/* ============================================================
+ *  Ligaduras
+ * ============================================================ */
+
+static CtfeSlot* lookup(CtfeMachine *m, const HulkNode *decl) {
+    for (int i = m->env_count - 1; i >= m->frame; i--)
+        if (m->env[i].decl == decl) return &m->env[i];
+    return NULL;
+}
+
+static int bind(CtfeMachine *m, HulkNode *decl, const CtfeValue *v) {
+    if (m->env_count >= m->env_cap) {
+        int nc = m->env_cap ? m->env_cap * 2 : 64;
+        CtfeSlot *ne = realloc(m->env, sizeof(CtfeSlot) * (size_t)nc);
+        if (!ne) return fail(m, CTFE_BUDGET);
+        m->env = ne;
+        m->env_cap = nc;
+    }
+    m->env[m->env_count].decl = decl;
+    m->env[m->env_count].value = *v;
+    m->env_count++;
+    return 1;
+}
+
+/* ============================================================
+ *  Expresiones
+ * ============================================================ */
+
+static int eval_ident(CtfeMachine *m, IdentNode *n, CtfeValue *out) {
+    CtfeSlot *s = n->binding.kind == HULK_BIND_LOCAL
+        ? lookup(m, n->binding.decl) : NULL;
+    if (!s) return fail(m, CTFE_UNSUPPORTED);
+    *out = s->value;
+    return 1;
+}
+
+static int is_static_string(const HulkNode *n) {
+    return n->static_type && strcmp(n->static_type, "String") == 0;
+}
+
+/* emit_equality_op: strcmp entre String estáticos, fcmp oeq/une entre
+ * doubles, icmp entre i1; entre clases distintas, la constante. */
+static int eval_equality(CtfeMachine *m, BinaryOpNode *n,
+                         const CtfeValue *l, const CtfeValue *r,
+                         CtfeValue *out) {
+    int is_eq = n->op == OP_EQ;
+    int eq;
+    if (is_static_string(n->left) && is_static_string(n->right)) {
+        if (l->kind != CTFE_STR || r->kind != CTFE_STR)
+            return fail(m, CTFE_UNSUPPORTED);
+        eq = strcmp(l->str, r->str) == 0;
+    } else if (l->kind != r->kind) {
+        eq = 0;
+    } else if (l->kind == CTFE_NUM) {
+        set_bool(out, is_eq ? l->num == r->num : l->num != r->num);
+        return 1;
+    } else if (l->kind == CTFE_BOOL) {
+        eq = l->b == r->b;
+    } else {
+        return fail(m, CTFE_UNSUPPORTED);   /* comparación de punteros */
+    }
+    set_bool(out, is_eq ? eq : !eq);
+    return 1;
+}
+
+static int eval_binary(CtfeMachine *m, BinaryOpNode *n, CtfeValue *out) {
+    CtfeValue l, r;
+    int lb, rb;
+    if (n->op == OP_AND || n->op == OP_OR) {
+        if (!ctfe_eval(m, n->left, &l) || !truthy(m, &l, &lb)) return 0;
+        if (lb == (n->op == OP_OR)) { set_bool(out, lb); return 1; }
+        if (!ctfe_eval(m, n->right, &r) || !truthy(m, &r, &rb)) return 0;
+        set_bool(out, rb);
+        return 1;
+    }
+
+    if (!ctfe_eval(m, n->left, &l) || !ctfe_eval(m, n->right, &r)) return 0;
+    if (n->op == OP_EQ || n->op == OP_NEQ)
+        return eval_equality(m, n, &l, &r, out);
+    if (l.kind != CTFE_NUM || r.kind != CTFE_NUM)
+        return fail(m, CTFE_UNSUPPORTED);
+
+    double a = l.num, b = r.num;
+    switch (n->op) {
+        case OP_ADD: set_num(out, a + b); return 1;
+        case OP_SUB: set_num(out, a - b); return 1;
+        case OP_MUL: set_num(out, a * b); return 1;
+        case OP_DIV: set_num(out, a / b); return 1;
+        case OP_MOD: set_num(out, fmod(a, b)); return 1;   /* frem */
+        case OP_POW: set_num(out, pow(a, b)); return 1;
+        case OP_LT:  set_bool(out, a < b);  return 1;
+        case OP_GT:  set_bool(out, a > b);  return 1;
+        case OP_LE:  set_bool(out, a <= b); return 1;
+        case OP_GE:  set_bool(out, a >= b); return 1;
+        default:     return fail(m, CTFE_UNSUPPORTED);
+    }
+}
+
+static int eval_unary(CtfeMachine *m, UnaryOpNode *n, CtfeValue *out) {
+    CtfeValue v;
+    if (!ctfe_eval(m, n->operand, &v)) return 0;
+    if (n->is_not && v.kind == CTFE_BOOL) { set_bool(out, !v.b); return 1; }
+    if (n->is_not && v.kind == CTFE_NUM)  { set_bool(out, v.num == 0.0); return 1; }
+    if (!n->is_not && v.kind == CTFE_NUM) { set_num(out, -v.num); return 1; }
+    return fail(m, CTFE_UNSUPPORTED);
+}
+
+/* hulk_concat / hulk_concat_ws sobre cg_emit_to_string de cada lado. */
+static int eval_concat(CtfeMachine *m, ConcatExprNode *n, CtfeValue *out) {
+    CtfeValue l, r;
+    if (!ctfe_eval(m, n->left, &l)) return 0;
+    const char *ls = to_string(m, &l);
+    if (!ls || !ctfe_eval(m, n->right, &r)) return 0;
+    const char *rs = to_string(m, &r);
+    if (!rs) return 0;
+
+    size_t ll = strlen(ls), rl = strlen(rs);
+    size_t sep = n->op == OP_CONCAT_WS ? 1 : 0;
+    char *s = new_string(m, ll + sep + rl);
+    if (!s) return 0;
+    memcpy(s, ls, ll);
+    if (sep) s[ll] = ' ';
+    memcpy(s + ll + sep, rs, rl + 1);
+    out->kind = CTFE_STR;
+    out->str = s;
+    return 1;
+}
+
+static int eval_builtin(CtfeMachine *m, CallExprNode *n, const char *name,
+                        CtfeValue *out) {
+    CtfeValue a[2];
+    int argc = n->args.count;
+    if (argc > 2) return fail(m, CTFE_UNSUPPORTED);
+    for (int i = 0; i < argc; i++) {
+        if (!ctfe_eval(m, n->args.items[i], &a[i])) return 0;
+        if (a[i].kind != CTFE_NUM) return fail(m, CTFE_UNSUPPORTED);
+    }
+    if (argc == 1 && strcmp(name, "sqrt") == 0) { set_num(out, sqrt(a[0].num)); return 1; }
+    if (argc == 1 && strcmp(name, "sin") == 0)  { set_num(out, sin(a[0].num));  return 1; }
+    if (argc == 1 && strcmp(name, "cos") == 0)  { set_num(out, cos(a[0].num));  return 1; }
+    if (argc == 1 && strcmp(name, "exp") == 0)  { set_num(out, exp(a[0].num));  return 1; }
+    if (argc == 2 && strcmp(name, "log") == 0) {   /* hulk_log(base, valor) */
+        set_num(out, log(a[1].num) / log(a[0].num));
+        return 1;
+    }
+    return fail(m, CTFE_UNSUPPORTED);   /* print, rand, parse, range… */
+}
+
+/* Clase del valor que devuelve `fd` en el IR: la anotación o, sin ella,
+ * el tipo estático del cuerpo (cg_infer_body_return_type). */
+static int return_kind(FunctionDefNode *fd, CtfeKind *out) {
+    if (fd->return_type) return ctfe_kind_of(fd->return_type, out);
+    return fd->body && ctfe_kind_of(fd->body->static_type, out);
+}
+
+static int eval_user_call(CtfeMachine *m, CallExprNode *n,
+                          FunctionDefNode *fd, CtfeValue *out) {
+    int *misses = hulk_side_get(&m->expensive, (HulkNode*)fd);
+    if (misses && *misses >= HULK_CTFE_MAX_MISSES)
+        return fail(m, CTFE_UNSUPPORTED);
+    int g = m->graph ? hulk_callgraph_find(m->graph, (HulkNode*)fd) : -1;
+    if (g < 0 || m->graph->nodes[g].wrapped) return fail(m, CTFE_UNSUPPORTED);
+    if (n->args.count != fd->params.count) return fail(m, CTFE_UNSUPPORTED);
+    if (m->depth >= HULK_CTFE_MAX_DEPTH) return fail(m, CTFE_BUDGET);
+
+    /* Los argumentos se evalúan en el marco del llamador; recién con
+     * todos evaluados sus ligaduras pasan a ser los parámetros (una
+     * llamada recursiva f(b, a) no debe ver su propio `a`). */
+    int base = m->env_count;
+    for (int i = 0; i < n->args.count; i++) {
+        VarBindingNode *p = (VarBindingNode*)fd->params.items[i];
+        CtfeKind want = CTFE_NUM;   /* parámetro sin anotación: double */
+        CtfeValue v;
+        int ok = (!p->type_annotation || ctfe_kind_of(p->type_annotation, &want))
+              && ctfe_eval(m, n->args.items[i], &v) && v.kind == want
+              && bind(m, NULL, &v);
+        if (!ok) {
+            m->env_count = base;
+            return fail(m, CTFE_UNSUPPORTED);
+        }
+    }
+    for (int i = 0; i < n->args.count; i++)
+        m->env[base + i].decl = fd->params.items[i];
+
+    int saved_frame = m->frame;
+    m->frame = base;
+    m->depth++;
+    int ok = ctfe_eval(m, fd->body, out);
+    m->depth--;
+    m->frame = saved_frame;
+    m->env_count = base;
+
+    if (!ok) {
+        /* Se anota solo la llamada del sitio, no cada marco recursivo. */
+        if (m->status == CTFE_BUDGET && m->depth == 0) {
+            misses = hulk_side_put(&m->expensive, (HulkNode*)fd);
+            if (misses) (*misses)++;
+        }
+        return 0;
+    }
+    CtfeKind ret;
+    if (!return_kind(fd, &ret) || ret != out->kind)
+        return fail(m, CTFE_UNSUPPORTED);
+    return 1;
+}
+
+static int eval_call(CtfeMachine *m, CallExprNode *n, CtfeValue *out) {
+    if (!n->callee || n->callee->type != NODE_IDENT)
+        return fail(m, CTFE_UNSUPPORTED);
+    IdentNode *id = (IdentNode*)n->callee;
+    if (id->binding.kind != HULK_BIND_GLOBAL) return fail(m, CTFE_UNSUPPORTED);
+    if (!id->binding.decl) return eval_builtin(m, n, id->name, out);
+    if (id->binding.decl->type != NODE_FUNCTION_DEF)
+        return fail(m, CTFE_UNSUPPORTED);
+    return eval_user_call(m, n, (FunctionDefNode*)id->binding.decl, out);
+}
+
+/* ============================================================
+ *  Control
+ * ============================================================ */
+
+static int eval_let(CtfeMachine *m, LetExprNode *n, CtfeValue *out) {
+    int base = m->env_count;
+    int ok = 1;
+    for (int i = 0; i < n->bindings.count && ok; i++) {
+        VarBindingNode *vb = (VarBindingNode*)n->bindings.items[i];
+        CtfeValue v;
+        if (vb->init_expr) ok = ctfe_eval(m, vb->init_expr, &v);
+        else set_num(&v, 0.0);
+        if (ok) ok = bind(m, (HulkNode*)vb, &v);
+    }
+    if (ok) ok = ctfe_eval(m, n->body, out);
+    m->env_count = base;
+    return ok;
+}
+
+/* Sin else el codegen arma un phi sin la rama que no entra; con ramas
+ * de tipos distintos, uno que no es el de todas. Solo el caso limpio. */
+static int eval_if(CtfeMachine *m, IfExprNode *n, CtfeValue *out) {
+    CtfeKind k;
+    if (!n->else_body || !ctfe_kind_of(n->base.static_type, &k))
+        return fail(m, CTFE_UNSUPPORTED);
+
+    CtfeValue c;
+    int taken;
+    if (!ctfe_eval(m, n->condition, &c) || !truthy(m, &c, &taken)) return 0;
+    if (taken) return ctfe_eval(m, n->then_body, out);
+    for (int i = 0; i < n->elifs.count; i++) {
+        ElifBranchNode *e = (ElifBranchNode*)n->elifs.items[i];
+        if (!ctfe_eval(m, e->condition, &c) || !truthy(m, &c, &taken)) return 0;
+        if (taken) return ctfe_eval(m, e->body, out);
+    }
+    return ctfe_eval(m, n->else_body, out);
+}
+
+/* cg_emit_while: el valor es el del último cuerpo si es double, si no
+ * (o sin vueltas) 0.0. */
+static int eval_while(CtfeMachine *m, WhileStmtNode *n, CtfeValue *out) {
+    double last = 0.0;
+    for (;;) {
+        CtfeValue c, body;
+        int go;
+        if (!ctfe_eval(m, n->condition, &c) || !truthy(m, &c, &go)) return 0;
+        if (!go) break;
+        if (!ctfe_eval(m, n->body, &body)) return 0;
+        if (body.kind == CTFE_NUM) last = body.num;
+    }
+    set_num(out, last);
+    return 1;
+}
+
+static int eval_block(CtfeMachine *m, BlockStmtNode *n, CtfeValue *out) {
+    set_num(out, 0.0);
+    for (int i = 0; i < n->statements.count; i++)
+        if (!ctfe_eval(m, n->statements.items[i], out)) return 0;
+    return 1;
+}
+
+/* x = v / x := v sobre una variable: el alloca tiene el tipo del valor
+ * inicial, así que el nuevo tiene que ser de la misma clase. */
+static int eval_store(CtfeMachine *m, HulkNode *target, HulkNode *value,
+                      CtfeValue *out) {
+    if (!target || target->type != NODE_IDENT ||
+        ((IdentNode*)target)->binding.kind != HULK_BIND_LOCAL)
+        return fail(m, CTFE_UNSUPPORTED);
+    if (!ctfe_eval(m, value, out)) return 0;
+    CtfeSlot *s = lookup(m, ((IdentNode*)target)->binding.decl);
+    if (!s || s->value.kind != out->kind) return fail(m, CTFE_UNSUPPORTED);
+    s->value = *out;
+    return 1;
+}
+
+/* ============================================================
+ *  Dispatcher
+ * ============================================================ */
+
+int ctfe_eval(CtfeMachine *m, HulkNode *n, CtfeValue *out) {
+    if (!n) return fail(m, CTFE_UNSUPPORTED);
+    if (++m->steps > HULK_CTFE_MAX_STEPS || --m->total_left < 0)
+        return fail(m, CTFE_BUDGET);
+
+    int ok;
+    switch (n->type) {
+        case NODE_NUMBER_LIT:
+            set_num(out, ((NumberLitNode*)n)->value);
+            ok = 1;
+            break;
+        case NODE_STRING_LIT: {
+            const char *s = ((StringLitNode*)n)->value;
+            out->kind = CTFE_STR;
+            out->str = s ? s : "";
+            ok = 1;
+            break;
+        }
+        case NODE_BOOL_LIT:
+            set_bool(out, ((BoolLitNode*)n)->value);
+            ok = 1;
+            break;
+        case NODE_IDENT:       ok = eval_ident(m, (IdentNode*)n, out); break;
+        case NODE_BINARY_OP:   ok = eval_binary(m, (BinaryOpNode*)n, out); break;
+        case NODE_UNARY_OP:    ok = eval_unary(m, (UnaryOpNode*)n, out); break;
+        case NODE_CONCAT_EXPR: ok = eval_concat(m, (ConcatExprNode*)n, out); break;
+        case NODE_CALL_EXPR:   ok = eval_call(m, (CallExprNode*)n, out); break;
+        case NODE_LET_EXPR:    ok = eval_let(m, (LetExprNode*)n, out); break;
+        case NODE_IF_EXPR:     ok = eval_if(m, (IfExprNode*)n, out); break;
+        case NODE_WHILE_STMT:  ok = eval_while(m, (WhileStmtNode*)n, out); break;
+        case NODE_BLOCK_STMT:  ok = eval_block(m, (BlockStmtNode*)n, out); break;
+        case NODE_ASSIGN:
+            ok = eval_store(m, ((AssignNode*)n)->target,
+                            ((AssignNode*)n)->value, out);
+            break;
+        case NODE_DESTRUCT_ASSIGN:
+            ok = eval_store(m, ((DestructAssignNode*)n)->target,
+                            ((DestructAssignNode*)n)->value, out);
+            break;
+        default:
+            /* for, new, miembros, self, base, lambdas, vectores, is/as */
+            ok = fail(m, CTFE_UNSUPPORTED);
+            break;
+    }
+    if (ok && !agrees(n, out)) return fail(m, CTFE_UNSUPPORTED);
+    return ok;
+}
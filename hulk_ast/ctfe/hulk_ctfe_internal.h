@@ -0,0 +1,73 @@
+/*
+ * hulk_ctfe_internal.h — Cabecera interna de CTFE
+ *
+ * El intérprete (hulk_ctfe_eval.c) y el pase que pliega el árbol
+ * (hulk_ctfe.c) comparten la máquina: valores, entorno de ligaduras,
+ * strings creados y contadores de presupuesto.
+ *
+ * Este header es PRIVADO del subsistema ctfe/.
+ */
+
+#ifndef HULK_CTFE_INTERNAL_H
+#define HULK_CTFE_INTERNAL_H
+
+#include "hulk_ctfe.h"
+#include "../core/hulk_ast_side.h"
+#include "../core/hulk_callgraph.h"
+
+// Tipo de LLVM que tendría el valor en el código emitido.
+typedef enum {
+    CTFE_NUM,    // double
+    CTFE_STR,    // i8*
+    CTFE_BOOL,   // i1
+} CtfeKind;
+
+typedef struct {
+    CtfeKind    kind;
+    double      num;
+    const char *str;   // literal del AST o string de la máquina
+    int         b;
+} CtfeValue;
+
+typedef enum {
+    CTFE_OK,
+    CTFE_UNSUPPORTED,  // el sitio no se puede evaluar en compilación
+    CTFE_BUDGET,       // se agotó un presupuesto
+} CtfeStatus;
+
+typedef struct {
+    HulkNode *decl;    // VarBinding que liga el valor
+    CtfeValue value;
+} CtfeSlot;
+
+typedef struct {
+    const HulkCallGraph *graph;    // funciones envueltas por decoradores
+    HulkSideTable        expensive; // FunctionDef → int: sitios que agotó
+
+    // Por sitio (ctfe_site_reset).
+    CtfeStatus  status;
+    long        steps;
+    size_t      bytes;
+    int         depth;
+    CtfeSlot   *env;               // ligaduras; la llamada actual desde frame
+    int         env_count, env_cap, frame;
+    char      **strs;              // strings creados (se liberan al resetear)
+    int         str_count, str_cap;
+
+    long        total_left;        // pasos que le quedan al programa
+} CtfeMachine;
+
+void ctfe_machine_init(CtfeMachine *m, const HulkCallGraph *graph);
+void ctfe_machine_free(CtfeMachine *m);
+
+// Libera lo creado por el sitio anterior y rearma los contadores.
+void ctfe_site_reset(CtfeMachine *m);
+
+// Evalúa `n`. 1 si `out` tiene el valor; 0 si no (m->status dice por qué).
+int  ctfe_eval(CtfeMachine *m, HulkNode *n, CtfeValue *out);
+
+// Clase del tipo estático `name` (Number/String/Boolean); 0 si no es
+// uno de esos.
+int  ctfe_kind_of(const char *name, CtfeKind *out);
+
+#endif /* HULK_CTFE_INTERNAL_H */
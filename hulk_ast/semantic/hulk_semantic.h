@@ -30,4 +30,42 @@
  */
 int hulk_semantic_analyze(HulkASTContext *ast_ctx, HulkNode *program);
 
+// Por debajo de esta cantidad de cuerpos (funciones, miembros de tipos,
+// expresiones globales) la verificación no se reparte: crear hilos cuesta
+// más que verificar.
+#define HULK_SEMANTIC_PARALLEL_MIN_UNITS 2048
+#define HULK_SEMANTIC_MAX_WORKERS 16
+
+/*
+ * Igual que hulk_semantic_analyze, con la verificación de cuerpos
+ * repartida entre `workers` hilos: 1 en serie, <= 0 uno por CPU si el
+ * programa pasa HULK_SEMANTIC_PARALLEL_MIN_UNITS. Diagnósticos (texto y
+ * orden) y resultado son los de la verificación en serie.
+ */
+int hulk_semantic_analyze_workers(HulkASTContext *ast_ctx, HulkNode *program,
+                                  int workers);
+
+/*
+ * Análisis incremental (modo watch). `state` guarda, entre corridas sobre
+ * versiones editadas del mismo programa, los resultados por declaración
+ * top-level; cada corrida recibe el AST nuevo completo y el fuente del
+ * que se construyó, rehace desugaring y recolección, y verifica solo los
+ * cuerpos de las declaraciones que cambiaron y de las que dependen de
+ * ellas. Las demás reusan sus diagnósticos. Diagnósticos (texto y orden)
+ * y resultado son los de hulk_semantic_analyze.
+ *
+ * Los cuerpos que no se verifican quedan sin anotar (bindings, capturas,
+ * static_type): para generar código, hulk_semantic_analyze.
+ */
+typedef struct HulkSemanticState_s HulkSemanticState;
+
+HulkSemanticState* hulk_semantic_state_new(void);
+void hulk_semantic_state_free(HulkSemanticState *state);
+int  hulk_semantic_analyze_incremental(HulkSemanticState *state,
+                                       HulkASTContext *ast_ctx,
+                                       HulkNode *program,
+                                       const char *source);
+// Declaraciones top-level verificadas (no reusadas) en la última corrida.
+int  hulk_semantic_state_checked(const HulkSemanticState *state);
+
 #endif /* HULK_SEMANTIC_H */
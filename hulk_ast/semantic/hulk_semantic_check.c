@@ -7,7 +7,9 @@
  *   Pase 3 — Verificar cuerpos de funciones, métodos y expresiones.
  *
  * También contiene la implementación de hulk_semantic_analyze(),
- * punto de entrada público del análisis semántico.
+ * punto de entrada público del análisis semántico. El pase 3 se
+ * verifica por unidades (sem_check_unit) para poder repartirlo entre
+ * hilos (hulk_semantic_parallel.c).
  *
  * SRP: Solo orquestación y verificación de declaraciones top-level.
  *      La verificación de expresiones está en check_expr.c.
@@ -21,6 +23,8 @@
 static void check_top_level(SemanticContext *c, HulkNode *decl);
 static void check_function_def(SemanticContext *c, FunctionDefNode *fn);
 static void check_type_def(SemanticContext *c, TypeDefNode *td);
+static void check_member(SemanticContext *c, TypeDefNode *td,
+                         HulkType *type, HulkNode *m);
 static HulkType* apply_decorators_to_type(SemanticContext *c, HulkNode *site,
                                           HulkType *base_type,
                                           HulkNodeList *decorators);
@@ -84,7 +88,9 @@ static void check_function_def(SemanticContext *c, FunctionDefNode *fn) {
         } else if (!fn->return_type) {
             /* Inferir tipo de retorno */
             sym->type = body_t;
-            if (sym->callable_type) sym->callable_type->return_type = body_t;
+            if (sym->callable_type)   /* canónico: no se modifica */
+                sym->callable_type = sem_function_type_new(c,
+                    sym->param_types, sym->param_count, body_t);
         }
     }
 
@@ -101,76 +107,96 @@ static void check_type_def(SemanticContext *c, TypeDefNode *td) {
     HulkType *prev_type = c->enclosing_type;
     c->enclosing_type = type;
 
-    for (int i = 0; i < td->members.count; i++) {
-        HulkNode *m = td->members.items[i];
+    for (int i = 0; i < td->members.count; i++)
+        check_member(c, td, type, td->members.items[i]);
 
-        if (m->type == NODE_METHOD_DEF) {
-            MethodDefNode *md = (MethodDefNode*)m;
-            sem_push_scope(c);
+    c->enclosing_type = prev_type;
+}
 
-            /* self + parámetros del constructor + parámetros del método */
-            sem_define(c, "self", SYM_VARIABLE, type, NULL);
-            inject_ctor_params(c, td);
-            for (int j = 0; j < md->params.count; j++) {
-                VarBindingNode *p = (VarBindingNode*)md->params.items[j];
-                HulkType *pt = sem_param_annotation_for(c, p, md->body);
-                sem_define(c, p->name, SYM_VARIABLE, pt, (HulkNode*)p);
-            }
+/* Un miembro, con c->enclosing_type ya puesto en `type`. */
+static void check_member(SemanticContext *c, TypeDefNode *td,
+                         HulkType *type, HulkNode *m) {
+    if (m->type == NODE_METHOD_DEF) {
+        MethodDefNode *md = (MethodDefNode*)m;
+        sem_push_scope(c);
+
+        /* self + parámetros del constructor + parámetros del método */
+        sem_define(c, "self", SYM_VARIABLE, type, NULL);
+        inject_ctor_params(c, td);
+        for (int j = 0; j < md->params.count; j++) {
+            VarBindingNode *p = (VarBindingNode*)md->params.items[j];
+            HulkType *pt = sem_param_annotation_for(c, p, md->body);
+            sem_define(c, p->name, SYM_VARIABLE, pt, (HulkNode*)p);
+        }
 
-            HulkType *body_t = sem_check_expr(c, md->body);
-
-            /* Verificar tipo de retorno del método */
-            if (md->return_type) {
-                HulkType *ret = sem_resolve_annotation(c, md->return_type, m);
-                if (ret && ret != c->t_error &&
-                    !sem_type_conforms(body_t, ret))
-                    sem_error(c, m,
-                        "método '%s': cuerpo retorna %s, se esperaba %s",
-                        md->name, body_t->name, ret->name);
-            } else {
-                Symbol *ms = sem_lookup_member(type, md->name);
-                if (ms) {
-                    ms->type = body_t;
-                    if (ms->callable_type) ms->callable_type->return_type = body_t;
-                }
-            }
+        HulkType *body_t = sem_check_expr(c, md->body);
 
-            if (md->decorators.count > 0) {
-                Symbol *ms = sem_lookup_member(type, md->name);
-                HulkType *method_type = ms && ms->callable_type
-                    ? ms->callable_type
-                    : sem_function_type_new(c, NULL, 0, body_t);
-                HulkType *decorated = apply_decorators_to_type(
-                    c, (HulkNode*)md, method_type, &md->decorators);
-                if (ms && decorated && decorated->kind == HULK_TYPE_FUNCTION)
-                    ms->callable_type = decorated;
+        /* Verificar tipo de retorno del método */
+        if (md->return_type) {
+            HulkType *ret = sem_resolve_annotation(c, md->return_type, m);
+            if (ret && ret != c->t_error &&
+                !sem_type_conforms(body_t, ret))
+                sem_error(c, m,
+                    "método '%s': cuerpo retorna %s, se esperaba %s",
+                    md->name, body_t->name, ret->name);
+        } else {
+            Symbol *ms = sem_lookup_member(type, md->name);
+            if (ms) {
+                ms->type = body_t;
+                if (ms->callable_type)
+                    ms->callable_type = sem_function_type_new(c,
+                        ms->param_types, ms->param_count, body_t);
             }
+        }
 
-            sem_pop_scope(c);
+        if (md->decorators.count > 0) {
+            Symbol *ms = sem_lookup_member(type, md->name);
+            HulkType *method_type = ms && ms->callable_type
+                ? ms->callable_type
+                : sem_function_type_new(c, NULL, 0, body_t);
+            HulkType *decorated = apply_decorators_to_type(
+                c, (HulkNode*)md, method_type, &md->decorators);
+            if (ms && decorated && decorated->kind == HULK_TYPE_FUNCTION)
+                ms->callable_type = decorated;
+        }
 
-        } else if (m->type == NODE_ATTRIBUTE_DEF) {
-            AttributeDefNode *ad = (AttributeDefNode*)m;
-            if (!ad->init_expr) continue;
+        sem_pop_scope(c);
 
-            sem_push_scope(c);
-            sem_define(c, "self", SYM_VARIABLE, type, NULL);
-            inject_ctor_params(c, td);
+    } else if (m->type == NODE_ATTRIBUTE_DEF) {
+        AttributeDefNode *ad = (AttributeDefNode*)m;
+        if (!ad->init_expr) return;
 
-            HulkType *init_t = sem_check_expr(c, ad->init_expr);
+        sem_push_scope(c);
+        sem_define(c, "self", SYM_VARIABLE, type, NULL);
+        inject_ctor_params(c, td);
 
-            if (ad->type_annotation) {
-                HulkType *attr_t = sem_resolve_annotation(c, ad->type_annotation, m);
-                if (attr_t && attr_t != c->t_error &&
-                    !sem_type_conforms(init_t, attr_t))
-                    sem_error(c, m,
-                        "atributo '%s': inicializador es %s, se esperaba %s",
-                        ad->name, init_t->name, attr_t->name);
-            }
+        HulkType *init_t = sem_check_expr(c, ad->init_expr);
 
-            sem_pop_scope(c);
+        if (ad->type_annotation) {
+            HulkType *attr_t = sem_resolve_annotation(c, ad->type_annotation, m);
+            if (attr_t && attr_t != c->t_error &&
+                !sem_type_conforms(init_t, attr_t))
+                sem_error(c, m,
+                    "atributo '%s': inicializador es %s, se esperaba %s",
+                    ad->name, init_t->name, attr_t->name);
         }
+
+        sem_pop_scope(c);
     }
+}
 
+void sem_check_unit(SemanticContext *c, HulkNode *decl, int member) {
+    if (member < 0 || decl->type != NODE_TYPE_DEF) {
+        check_top_level(c, decl);
+        return;
+    }
+    TypeDefNode *td = (TypeDefNode*)decl;
+    HulkType *type = sem_type_resolve(c, td->name);
+    if (!type || td->is_protocol) return;
+
+    HulkType *prev_type = c->enclosing_type;
+    c->enclosing_type = type;
+    check_member(c, td, type, td->members.items[member]);
     c->enclosing_type = prev_type;
 }
 
@@ -186,7 +212,8 @@ static HulkType* apply_decorators_to_type(SemanticContext *c, HulkNode *site,
             continue;
         }
 
-        HulkType *dec_type = sym->callable_type ? sym->callable_type : sym->type;
+        HulkType *dec_type = sem_sym_callable(c, sym);
+        if (!dec_type) dec_type = sem_sym_type(c, sym);
         if (!dec_type || dec_type->kind != HULK_TYPE_FUNCTION) {
             sem_error(c, (HulkNode*)di, "decorador '%s' no es invocable", di->name);
             continue;
@@ -256,13 +283,14 @@ static HulkType* apply_decorators_to_type(SemanticContext *c, HulkNode *site,
  *  Orquestador: sem_check_program
  * ============================================================ */
 
-void sem_check_program(SemanticContext *c, HulkNode *program) {
+void sem_check_program(SemanticContext *c, HulkNode *program, int workers) {
     if (!program || program->type != NODE_PROGRAM) return;
     ProgramNode *prog = (ProgramNode*)program;
 
     sem_collect_pass1_types(c, prog);
     sem_collect_pass2_resolve(c, prog);
 
+    if (workers != 1 && sem_check_parallel(c, prog, workers)) return;
     for (int i = 0; i < prog->declarations.count; i++)
         check_top_level(c, prog->declarations.items[i]);
 }
@@ -272,22 +300,20 @@ void sem_check_program(SemanticContext *c, HulkNode *program) {
  * ============================================================ */
 
 int hulk_semantic_analyze(HulkASTContext *ast_ctx, HulkNode *program) {
-    SemanticContext ctx;
-    memset(&ctx, 0, sizeof(ctx));
-    ctx.ast_ctx = ast_ctx;
-
-    /* Crear scope global */
-    ctx.global  = sem_scope_create(&ctx, NULL);
-    ctx.current = ctx.global;
+    return hulk_semantic_analyze_workers(ast_ctx, program, 0);
+}
 
-    /* Inicializar tipos y funciones built-in */
-    sem_types_init(&ctx);
+int hulk_semantic_analyze_workers(HulkASTContext *ast_ctx, HulkNode *program,
+                                  int workers) {
+    SemanticContext ctx;
+    sem_context_init(&ctx, ast_ctx);
 
-    /* Paso 1: desugaring de decoradores */
+    /* Paso 1: instancias de genéricos y desugaring de decoradores */
+    sem_monomorphize(&ctx, program);
     sem_desugar(&ctx, program);
 
     /* Paso 2: verificación semántica */
-    sem_check_program(&ctx, program);
+    sem_check_program(&ctx, program, workers);
 
     int errors = ctx.error_count;
 
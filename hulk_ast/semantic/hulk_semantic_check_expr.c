@@ -54,7 +54,7 @@ HulkType* sem_check_expr(SemanticContext *c, HulkNode *node) {
             VectorLitNode *vn = (VectorLitNode*)node;
             for (int i = 0; i < vn->items.count; i++)
                 sem_check_expr(c, vn->items.items[i]);
-            t = sem_resolve_annotation(c, "Number[]", node);
+            t = sem_vector_type(c, c->t_number);
             break;
         }
         case NODE_INDEX_EXPR: {
@@ -65,7 +65,9 @@ HulkType* sem_check_expr(SemanticContext *c, HulkNode *node) {
                 sem_error(c, node, "índice de vector debe ser Number (es %s)",
                           idx_t->name);
             t = c->t_number;
-            if (obj_t && obj_t->name) {
+            if (obj_t && obj_t->element) {
+                t = obj_t->element;
+            } else if (obj_t && obj_t->name) {
                 size_t len = strlen(obj_t->name);
                 if (len >= 2 && strcmp(obj_t->name + len - 2, "[]") == 0) {
                     char *elem = malloc(len - 1);
@@ -95,51 +97,17 @@ HulkType* sem_check_expr(SemanticContext *c, HulkNode *node) {
  * ============================================================ */
 
 static HulkType* check_ident(SemanticContext *c, IdentNode *n) {
-    Symbol *sym = NULL;
-    Scope *found_scope = NULL;
-    for (Scope *s = c->current; s; s = s->parent) {
-        sym = sem_lookup_local(s, n->name);
-        if (sym) {
-            found_scope = s;
-            break;
-        }
-    }
+    Symbol *sym = sem_resolve_ident(c, n, 1);
     if (!sym) {
         sem_error(c, (HulkNode*)n, "nombre '%s' no definido", n->name);
         return c->t_error;
     }
 
-    if (c->capture_target && c->capture_scope && found_scope) {
-        Scope *limit = c->capture_scope;
-        int local_to_function = 0;
-        for (Scope *s = c->current; s; s = s->parent) {
-            if (s == found_scope) {
-                local_to_function = 1;
-                break;
-            }
-            if (s == limit) break;
-        }
-
-        if (!local_to_function && sym->kind == SYM_VARIABLE) {
-            int already_captured = 0;
-            for (int i = 0; i < c->capture_target->captures.count; i++) {
-                IdentNode *cap = (IdentNode*)c->capture_target->captures.items[i];
-                if (strcmp(cap->name, n->name) == 0) {
-                    already_captured = 1;
-                    break;
-                }
-            }
-            if (!already_captured) {
-                hulk_node_list_push(&c->capture_target->captures,
-                    (HulkNode*)hulk_ast_ident(c->ast_ctx, n->name,
-                                              n->base.line, n->base.col));
-            }
-        }
-    }
-
-    if ((sym->kind == SYM_FUNCTION || sym->kind == SYM_METHOD) && sym->callable_type)
-        return sym->callable_type;
-    return sym->type ? sym->type : c->t_object;
+    HulkType *callable = sem_sym_callable(c, sym);
+    if ((sym->kind == SYM_FUNCTION || sym->kind == SYM_METHOD) && callable)
+        return callable;
+    HulkType *t = sem_sym_type(c, sym);
+    return t ? t : c->t_object;
 }
 
 static HulkType* check_function_expr(SemanticContext *c, FunctionExprNode *n) {
@@ -294,7 +262,8 @@ static HulkType* verify_call_args(SemanticContext *c, CallExprNode *n,
     for (int i = count; i < n->args.count; i++)
         sem_check_expr(c, n->args.items[i]);
 
-    return sym->type ? sym->type : c->t_object;
+    HulkType *ret = sem_sym_type(c, sym);
+    return ret ? ret : c->t_object;
 }
 
 static HulkType* verify_function_type_call(SemanticContext *c, CallExprNode *n,
@@ -324,7 +293,7 @@ static HulkType* check_call(SemanticContext *c, CallExprNode *n) {
     /* Caso 1: callee es un identificador → llamada a función */
     if (n->callee->type == NODE_IDENT) {
         IdentNode *id = (IdentNode*)n->callee;
-        Symbol *sym = sem_lookup(c->current, id->name);
+        Symbol *sym = sem_resolve_ident(c, id, 0);
         if (!sym) {
             sem_error(c, (HulkNode*)n, "función '%s' no definida", id->name);
             for (int i = 0; i < n->args.count; i++)
@@ -334,14 +303,15 @@ static HulkType* check_call(SemanticContext *c, CallExprNode *n) {
         if (sym->kind == SYM_FUNCTION || sym->kind == SYM_METHOD)
             return verify_call_args(c, n, sym, id->name);
 
-        if (sym->type && sym->type->kind == HULK_TYPE_FUNCTION)
-            return verify_function_type_call(c, n, sym->type, id->name);
+        HulkType *sym_t = sem_sym_type(c, sym);
+        if (sym_t && sym_t->kind == HULK_TYPE_FUNCTION)
+            return verify_function_type_call(c, n, sym_t, id->name);
 
         for (int i = 0; i < n->args.count; i++)
             sem_check_expr(c, n->args.items[i]);
-        if (sym->type && sym->type != c->t_object)
+        if (sym_t && sym_t != c->t_object)
             sem_error(c, (HulkNode*)n,
-                "'%s' no es invocable (es %s)", id->name, sym->type->name);
+                "'%s' no es invocable (es %s)", id->name, sym_t->name);
         return c->t_object;
     }
 
@@ -398,7 +368,8 @@ static HulkType* check_member(SemanticContext *c, MemberAccessNode *n) {
     HulkType *obj_t = sem_check_expr(c, n->object);
     if (obj_t) {
         Symbol *sym = sem_lookup_member(obj_t, n->member);
-        if (sym) return sym->type ? sym->type : c->t_object;
+        HulkType *t = sym ? sem_sym_type(c, sym) : NULL;
+        if (sym) return t ? t : c->t_object;
     }
     if (obj_t && obj_t->kind != HULK_TYPE_ERROR)
         sem_error(c, (HulkNode*)n,
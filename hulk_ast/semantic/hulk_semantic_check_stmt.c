@@ -105,10 +105,12 @@ static HulkType* sem_iterator_current_type(SemanticContext *c, HulkType *type) {
     Symbol *current = sem_lookup_member(type, "current");
     if (!next || !current) return NULL;
     if (next->kind != SYM_METHOD || current->kind != SYM_METHOD) return NULL;
-    if (next->type && !sem_type_conforms(next->type, c->t_boolean))
+    HulkType *next_t = sem_sym_type(c, next);
+    if (next_t && !sem_type_conforms(next_t, c->t_boolean))
         return NULL;
 
-    return current->type ? current->type : c->t_object;
+    HulkType *current_t = sem_sym_type(c, current);
+    return current_t ? current_t : c->t_object;
 }
 
 HulkType* sem_check_for(SemanticContext *c, ForStmtNode *n) {
@@ -200,14 +202,15 @@ HulkType* sem_check_assign(SemanticContext *c, AssignNode *n) {
     HulkType *val_t = sem_check_expr(c, n->value);
     if (n->target->type == NODE_IDENT) {
         IdentNode *id = (IdentNode*)n->target;
-        Symbol *sym = sem_lookup(c->current, id->name);
+        Symbol *sym = sem_resolve_ident(c, id, 0);
+        HulkType *sym_t = sym ? sem_sym_type(c, sym) : NULL;
         if (!sym)
             sem_error(c, (HulkNode*)n,
                 "variable '%s' no definida", id->name);
-        else if (!sem_type_conforms(val_t, sym->type))
+        else if (!sem_type_conforms(val_t, sym_t))
             sem_error(c, (HulkNode*)n,
                 "no se puede asignar %s a '%s' de tipo %s",
-                val_t->name, id->name, sym->type->name);
+                val_t->name, id->name, sym_t->name);
     } else {
         sem_check_expr(c, n->target);
     }
@@ -218,7 +221,7 @@ HulkType* sem_check_destruct(SemanticContext *c, DestructAssignNode *n) {
     HulkType *val_t = sem_check_expr(c, n->value);
     if (n->target->type == NODE_IDENT) {
         IdentNode *id = (IdentNode*)n->target;
-        Symbol *sym = sem_lookup(c->current, id->name);
+        Symbol *sym = sem_resolve_ident(c, id, 0);
         if (!sym)
             sem_error(c, (HulkNode*)n,
                 "variable '%s' no definida", id->name);
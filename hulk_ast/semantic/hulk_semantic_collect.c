@@ -79,6 +79,9 @@ void sem_collect_pass2_resolve(SemanticContext *c, ProgramNode *prog) {
         }
     }
 
+    /* 2a.2: inferir parámetros sin anotación (todos juntos) */
+    sem_unify_params(c, prog);
+
     /* 2b: registrar funciones */
     for (int i = 0; i < prog->declarations.count; i++) {
         HulkNode *decl = prog->declarations.items[i];
@@ -92,6 +95,9 @@ void sem_collect_pass2_resolve(SemanticContext *c, ProgramNode *prog) {
         if (decl->type == NODE_TYPE_DEF)
             collect_type_members(c, (TypeDefNode*)decl);
     }
+
+    /* 2d: herencia y miembros ya son definitivos → indexar la jerarquía */
+    sem_types_index_hierarchy(c);
 }
 
 /* ---------- Registrar una función ---------- */
@@ -102,7 +108,7 @@ static void collect_function(SemanticContext *c, FunctionDefNode *fn) {
      * donde Number es el caso útil para que el chequeo del cuerpo no
      * vea Object en la autollamada. */
     HulkType *ret = c->t_object;
-    if (!fn->return_type && sem_body_calls_name(fn->body, fn->name))
+    if (!fn->return_type && sem_body_calls_name(c, fn->body, fn->name))
         ret = c->t_number;
     if (fn->return_type) {
         ret = sem_resolve_annotation(c, fn->return_type, (HulkNode*)fn);
@@ -120,8 +126,8 @@ static void collect_function(SemanticContext *c, FunctionDefNode *fn) {
 
     sym->param_count = fn->params.count;
     if (sym->param_count > 0) {
-        sym->param_types = calloc(sym->param_count, sizeof(HulkType*));
-        sym->param_names = calloc(sym->param_count, sizeof(const char*));
+        sym->param_types = sem_alloc(c, sym->param_count * sizeof(HulkType*));
+        sym->param_names = sem_alloc(c, sym->param_count * sizeof(const char*));
         for (int i = 0; i < fn->params.count; i++) {
             VarBindingNode *p = (VarBindingNode*)fn->params.items[i];
             HulkType *pt = sem_param_annotation_for(c, p, fn->body);
@@ -146,8 +152,8 @@ static void collect_type_members(SemanticContext *c, TypeDefNode *td) {
     Symbol *tsym = sem_lookup(c->global, td->name);
     if (tsym && td->params.count > 0) {
         tsym->param_count = td->params.count;
-        tsym->param_types = calloc(td->params.count, sizeof(HulkType*));
-        tsym->param_names = calloc(td->params.count, sizeof(const char*));
+        tsym->param_types = sem_alloc(c, td->params.count * sizeof(HulkType*));
+        tsym->param_names = sem_alloc(c, td->params.count * sizeof(const char*));
         for (int i = 0; i < td->params.count; i++) {
             VarBindingNode *p = (VarBindingNode*)td->params.items[i];
             HulkType *pt = NULL;
@@ -181,8 +187,8 @@ static void collect_type_members(SemanticContext *c, TypeDefNode *td) {
             Symbol *ms = sem_define(c, md->name, SYM_METHOD, ret, m);
             if (ms && md->params.count > 0) {
                 ms->param_count = md->params.count;
-                ms->param_types = calloc(ms->param_count, sizeof(HulkType*));
-                ms->param_names = calloc(ms->param_count, sizeof(const char*));
+                ms->param_types = sem_alloc(c, ms->param_count * sizeof(HulkType*));
+                ms->param_names = sem_alloc(c, ms->param_count * sizeof(const char*));
                 for (int j = 0; j < md->params.count; j++) {
                     VarBindingNode *p = (VarBindingNode*)md->params.items[j];
                     HulkType *pt = sem_param_annotation_for(c, p, md->body);
@@ -31,7 +31,7 @@ void sem_desugar(SemanticContext *ctx, HulkNode *program) {
     if (!has_decor) return;
 
     HulkNodeList new_decls;
-    hulk_node_list_init(&new_decls);
+    hulk_node_list_init_in(&new_decls, ctx->ast_ctx);
 
     for (int i = 0; i < prog->declarations.count; i++) {
         HulkNode *decl = prog->declarations.items[i];
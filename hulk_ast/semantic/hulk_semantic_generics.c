@@ -0,0 +1,431 @@
+/*
+ * hulk_semantic_generics.c — Monomorfización de genéricos
+ *
+ * Una declaración genérica lleva sus parámetros de tipo en el nombre
+ * ("max<T>", "Box<T,U>") y un uso lleva los argumentos ("Box<Number>" en
+ * una anotación, un new, un inherits o un extends; "max<Number>" como
+ * callee de una llamada). Antes del desugaring, este pase reemplaza cada
+ * plantilla por una copia por instancia usada, con los parámetros
+ * sustituidos en todos los tipos y el nombre de la instancia:
+ *
+ *   function max<T>(a: T, b: T): T => ...;     max<Number>(1, 2)
+ *   -> function max<Number>(a: Number, b: Number): Number => ...;
+ *
+ * El resto del compilador solo ve declaraciones comunes y emite cada
+ * instancia con sus tipos concretos: un Box<Number> guarda un double, no
+ * un Object, y un max<Number> compara con fcmp sin despachar.
+ *
+ * Las instancias salen de una lista de trabajo: las nombradas fuera de
+ * las plantillas y, por cada copia creada, las nombradas en ella. Van en
+ * el lugar de su plantilla, en el orden en que se pidieron. No hay
+ * deducción (los argumentos se escriben siempre) y, como en C++, el
+ * cuerpo de una plantilla que nadie instancia no se verifica.
+ *
+ * SRP: solo transformación AST → AST de genéricos.
+ */
+
+#include "hulk_semantic_internal.h"
+#include "../core/hulk_intern.h"
+#include <ctype.h>
+
+#define GEN_MAX_PARAMS 16
+
+typedef struct {
+    const char *base;                    // nombre sin parámetros
+    HulkNode   *decl;                    // FunctionDef o TypeDef
+    int         nparams;
+    const char *params[GEN_MAX_PARAMS];
+    int         first, last;             // instancias, -1 si ninguna
+    int         overflow;                // pasó HULK_GENERIC_MAX_DEPTH
+} GenTemplate;
+
+typedef struct {
+    HulkNode *decl;                      // copia ya renombrada
+    int       next;                      // siguiente de la misma plantilla
+    int       depth;                     // 1 si la pide código común
+} GenInstance;
+
+typedef struct {
+    SemanticContext *c;
+    GenTemplate     *tmpls;
+    int              tmpl_count, tmpl_cap;
+    HulkNameIndex    tmpl_index;         // base → tmpls
+    GenInstance     *insts;
+    int              inst_count, inst_cap;
+    HulkNameIndex    inst_index;         // nombre de instancia → insts
+    int              depth;              // de las que se piden ahora
+
+    /* Sustitución en curso */
+    const GenTemplate *t;
+    const char       **args;
+} Mono;
+
+typedef void (*GenFieldFn)(Mono *m, HulkNode *at, const char **field,
+                           int is_type);
+
+/* ============================================================
+ *  Texto de los tipos
+ * ============================================================ */
+
+static int word_start(char ch) { return isalpha((unsigned char)ch) || ch == '_'; }
+
+static const char* word_end(const char *p) {
+    while (isalnum((unsigned char)*p) || *p == '_') p++;
+    return p;
+}
+
+/* `lt` apunta a '<': devuelve lo que sigue al '>' que lo cierra, o NULL.
+ * El '>' de una flecha "->" no cierra nada. */
+static const char* args_end(const char *lt) {
+    int depth = 0;
+    for (const char *p = lt; *p; p++) {
+        if (*p == '<' || *p == '(') depth++;
+        else if ((*p == '>' && p[-1] != '-') || *p == ')') {
+            if (--depth == 0) return p + 1;
+        }
+    }
+    return NULL;
+}
+
+/* Corta [s, end) en las comas de nivel 0 e interna cada parte. Devuelve
+ * cuántas hay (si pasan de `max` solo se cuentan). */
+static int split_args(const char *s, const char *end, const char **out, int max) {
+    int n = 0, depth = 0;
+    const char *from = s;
+    for (const char *p = s; p <= end; p++) {
+        if (p == end || (*p == ',' && depth == 0)) {
+            if (n < max) out[n] = hulk_intern_n(from, (size_t)(p - from));
+            n++;
+            from = p + 1;
+        } else if (*p == '<' || *p == '(') {
+            depth++;
+        } else if ((*p == '>' && p[-1] != '-') || *p == ')') {
+            depth--;
+        }
+    }
+    return n;
+}
+
+static GenTemplate* template_of(Mono *m, const char *w, size_t len) {
+    char buf[256];
+    if (len >= sizeof(buf)) return NULL;
+    memcpy(buf, w, len);
+    buf[len] = '\0';
+    int i = hulk_name_index_find(&m->tmpl_index, hulk_intern_find(buf));
+    return i >= 0 ? &m->tmpls[i] : NULL;
+}
+
+/* ============================================================
+ *  Campos con tipos
+ * ============================================================ */
+
+/* Llama a `fn` con cada campo de `n` y su subárbol que nombra un tipo
+ * (is_type) o una instancia de función (un callee "f<...>"). */
+static void each_field(Mono *m, HulkNode *n, GenFieldFn fn) {
+    if (!n) return;
+    switch (n->type) {
+    case NODE_FUNCTION_DEF:
+        fn(m, n, &((FunctionDefNode*)n)->return_type, 1); break;
+    case NODE_FUNCTION_EXPR:
+        fn(m, n, &((FunctionExprNode*)n)->return_type, 1); break;
+    case NODE_TYPE_DEF:
+        fn(m, n, &((TypeDefNode*)n)->parent, 1); break;
+    case NODE_METHOD_DEF:
+        fn(m, n, &((MethodDefNode*)n)->return_type, 1); break;
+    case NODE_ATTRIBUTE_DEF:
+        fn(m, n, &((AttributeDefNode*)n)->type_annotation, 1); break;
+    case NODE_VAR_BINDING:
+        fn(m, n, &((VarBindingNode*)n)->type_annotation, 1); break;
+    case NODE_NEW_EXPR:
+        fn(m, n, &((NewExprNode*)n)->type_name, 1); break;
+    case NODE_AS_EXPR:
+        fn(m, n, &((AsExprNode*)n)->type_name, 1); break;
+    case NODE_IS_EXPR:
+        fn(m, n, &((IsExprNode*)n)->type_name, 1); break;
+    case NODE_IDENT:
+        if (strchr(((IdentNode*)n)->name, '<'))
+            fn(m, n, &((IdentNode*)n)->name, 0);
+        break;
+    default: break;
+    }
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        each_field(m, *s.fixed[i], fn);
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            each_field(m, s.lists[l]->items[i], fn);
+}
+
+/* ============================================================
+ *  Instancias
+ * ============================================================ */
+
+/* Reemplaza cada parámetro de m->t por su argumento. */
+static void subst_field(Mono *m, HulkNode *at, const char **field, int is_type) {
+    (void)at; (void)is_type;
+    const char *s = *field;
+    if (!s) return;
+    size_t cap = strlen(s) + 64, len = 0;
+    char *buf = malloc(cap);
+    if (!buf) return;
+    int changed = 0;
+    for (const char *p = s; *p; ) {
+        const char *from = p, *piece = p;
+        size_t plen = 1;
+        if (word_start(*p)) {
+            p = word_end(p);
+            plen = (size_t)(p - from);
+            for (int i = 0; i < m->t->nparams; i++) {
+                const char *param = m->t->params[i];
+                if (hulk_intern_len(param) == plen && !memcmp(param, from, plen)) {
+                    piece = m->args[i];
+                    plen = hulk_intern_len(piece);
+                    changed = 1;
+                    break;
+                }
+            }
+        } else {
+            p++;
+        }
+        if (len + plen + 1 > cap) {
+            cap = 2 * (len + plen + 1);
+            char *nb = realloc(buf, cap);
+            if (!nb) { free(buf); return; }
+            buf = nb;
+        }
+        memcpy(buf + len, piece, plen);
+        len += plen;
+    }
+    buf[len] = '\0';
+    if (changed) *field = hulk_intern(buf);
+    free(buf);
+}
+
+static void request(Mono *m, HulkNode *at, const char *w, const char *lt,
+                    const char *end, int is_type);
+
+/* Pide las instancias que nombra el campo y avisa de las plantillas de
+ * tipo usadas sin argumentos. */
+static void scan_field(Mono *m, HulkNode *at, const char **field, int is_type) {
+    const char *s = *field;
+    if (!s) return;
+    if (!is_type) {
+        const char *lt = strchr(s, '<'), *e = args_end(lt);
+        if (!e) return;
+        request(m, at, s, lt, e, 0);
+        s = lt + 1;
+    }
+    for (const char *p = s; *p; ) {
+        if (!word_start(*p)) { p++; continue; }
+        const char *w = p;
+        p = word_end(p);
+        if (*p == '<') {
+            const char *e = args_end(p);
+            if (!e) return;
+            request(m, at, w, p, e, 1);
+            p++;   // los argumentos pueden nombrar más instancias
+        } else {
+            GenTemplate *t = template_of(m, w, (size_t)(p - w));
+            if (t && t->decl->type == NODE_TYPE_DEF)
+                sem_error(m->c, at, "tipo genérico '%s' usado sin argumentos de tipo",
+                          t->base);
+        }
+    }
+}
+
+static void instantiate(Mono *m, GenTemplate *t, const char *name,
+                        const char **args) {
+    HulkNode *copy = hulk_ast_clone(m->c->ast_ctx, t->decl);
+    if (!copy) return;
+    if (copy->type == NODE_FUNCTION_DEF) ((FunctionDefNode*)copy)->name = name;
+    else                                 ((TypeDefNode*)copy)->name = name;
+    m->t = t;
+    m->args = args;
+    each_field(m, copy, subst_field);
+
+    if (m->inst_count == m->inst_cap) {
+        int nc = m->inst_cap ? 2 * m->inst_cap : 16;
+        GenInstance *ni = realloc(m->insts, (size_t)nc * sizeof(GenInstance));
+        if (!ni) return;
+        m->insts = ni;
+        m->inst_cap = nc;
+    }
+    int k = m->inst_count++;
+    m->insts[k].decl = copy;
+    m->insts[k].next = -1;
+    m->insts[k].depth = m->depth;
+    if (t->last >= 0) m->insts[t->last].next = k;
+    else              t->first = k;
+    t->last = k;
+    hulk_name_index_add(&m->inst_index, name, k);
+}
+
+/* Registra la instancia [w, end) (base [w, lt)) si es válida y nueva;
+ * su copia se recorre después desde main (lista de trabajo). */
+static void request(Mono *m, HulkNode *at, const char *w, const char *lt,
+                    const char *end, int is_type) {
+    const char *name = hulk_intern_n(w, (size_t)(end - w));
+    const char *base = hulk_intern_n(w, (size_t)(lt - w));
+    int ti = hulk_name_index_find(&m->tmpl_index, base);
+    GenTemplate *t = ti >= 0 ? &m->tmpls[ti] : NULL;
+    if (!t) {
+        sem_error(m->c, at, "'%s' no es genérico", base);
+        return;
+    }
+    if (is_type != (t->decl->type == NODE_TYPE_DEF)) {
+        sem_error(m->c, at, is_type ? "'%s' no es un tipo genérico"
+                                    : "'%s' no es una función genérica", base);
+        return;
+    }
+    if (hulk_name_index_find(&m->inst_index, name) >= 0) return;
+    const char *args[GEN_MAX_PARAMS];
+    int n = split_args(lt + 1, end - 1, args, GEN_MAX_PARAMS);
+    if (n != t->nparams) {
+        sem_error(m->c, at, "'%s' espera %d argumento(s) de tipo y recibió %d",
+                  base, t->nparams, n);
+        return;
+    }
+    if (m->depth > HULK_GENERIC_MAX_DEPTH) {
+        /* Recursión sin fin: ninguna instancia de la plantilla queda */
+        if (!t->overflow)
+            sem_error(m->c, at, "'%s' se instancia con más de %d niveles "
+                      "de anidamiento", base, HULK_GENERIC_MAX_DEPTH);
+        t->overflow = 1;
+        return;
+    }
+    instantiate(m, t, name, args);
+}
+
+/* ============================================================
+ *  Plantillas
+ * ============================================================ */
+
+static const char* decl_name(HulkNode *decl) {
+    if (decl->type == NODE_FUNCTION_DEF) return ((FunctionDefNode*)decl)->name;
+    if (decl->type == NODE_TYPE_DEF)     return ((TypeDefNode*)decl)->name;
+    return NULL;
+}
+
+static int is_template(HulkNode *decl) {
+    const char *name = decl ? decl_name(decl) : NULL;
+    return name && strchr(name, '<');
+}
+
+/* Una plantilla decorada: se reporta y no se instancia. */
+static int is_decorated_template(HulkNode *decl) {
+    return decl->type == NODE_DECOR_BLOCK &&
+           is_template(((DecorBlockNode*)decl)->target);
+}
+
+/* Plantilla registrada para `decl` (NULL si se rechazó). */
+static GenTemplate* template_of_decl(Mono *m, HulkNode *decl) {
+    const char *name = decl_name(decl);
+    GenTemplate *t = template_of(m, name, (size_t)(strchr(name, '<') - name));
+    return t && t->decl == decl ? t : NULL;
+}
+
+/* Si `decl` es una plantilla la registra y devuelve 1. */
+static int add_template(Mono *m, HulkNode *decl) {
+    const char *name = decl_name(decl);
+    const char *lt = name ? strchr(name, '<') : NULL;
+    if (!lt) return 0;
+
+    GenTemplate t;
+    memset(&t, 0, sizeof(t));
+    t.base = hulk_intern_n(name, (size_t)(lt - name));
+    t.decl = decl;
+    t.first = t.last = -1;
+    t.nparams = split_args(lt + 1, name + strlen(name) - 1, t.params,
+                           GEN_MAX_PARAMS);
+    if (t.nparams > GEN_MAX_PARAMS) {
+        sem_error(m->c, decl, "'%s' tiene más de %d parámetros de tipo",
+                  t.base, GEN_MAX_PARAMS);
+        return 1;
+    }
+    for (int i = 0; i < t.nparams; i++)
+        for (int j = 0; j < i; j++)
+            if (t.params[i] == t.params[j]) {
+                sem_error(m->c, decl, "parámetro de tipo '%s' repetido en '%s'",
+                          t.params[i], t.base);
+                return 1;
+            }
+    if (hulk_name_index_find(&m->tmpl_index, t.base) >= 0) {
+        sem_error(m->c, decl, decl->type == NODE_TYPE_DEF
+                  ? "tipo '%s' ya definido" : "función '%s' ya definida", t.base);
+        return 1;
+    }
+
+    if (m->tmpl_count == m->tmpl_cap) {
+        int nc = m->tmpl_cap ? 2 * m->tmpl_cap : 8;
+        GenTemplate *nt = realloc(m->tmpls, (size_t)nc * sizeof(GenTemplate));
+        if (!nt) return 1;
+        m->tmpls = nt;
+        m->tmpl_cap = nc;
+    }
+    m->tmpls[m->tmpl_count] = t;
+    hulk_name_index_add(&m->tmpl_index, t.base, m->tmpl_count);
+    m->tmpl_count++;
+    return 1;
+}
+
+
+int sem_monomorphize(SemanticContext *ctx, HulkNode *program) {
+    if (!program || program->type != NODE_PROGRAM) return 0;
+    ProgramNode *prog = (ProgramNode*)program;
+
+    int has_generic = 0;
+    for (int i = 0; i < prog->declarations.count && !has_generic; i++)
+        has_generic = is_template(prog->declarations.items[i]);
+    if (!has_generic) return 0;
+
+    Mono m;
+    memset(&m, 0, sizeof(m));
+    m.c = ctx;
+
+    /* 1. Plantillas: salen del programa (y un decorador no las envuelve) */
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (is_decorated_template(decl))
+            sem_error(ctx, decl, "no se puede decorar el genérico '%s'",
+                      decl_name(((DecorBlockNode*)decl)->target));
+        else
+            add_template(&m, decl);
+    }
+
+    /* 2. Instancias nombradas fuera de las plantillas, y luego las que
+     *    nombra cada copia (la lista crece mientras se recorre) */
+    m.depth = 1;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (!is_template(decl) && !is_decorated_template(decl))
+            each_field(&m, decl, scan_field);
+    }
+    for (int k = 0; k < m.inst_count; k++) {
+        m.depth = m.insts[k].depth + 1;
+        each_field(&m, m.insts[k].decl, scan_field);
+    }
+
+    /* 3. Cada plantilla deja en su lugar sus instancias */
+    HulkNodeList decls;
+    hulk_node_list_init_in(&decls, ctx->ast_ctx);
+    hulk_node_list_reserve(&decls, prog->declarations.count + m.inst_count);
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (is_decorated_template(decl)) continue;
+        if (!is_template(decl)) {
+            hulk_node_list_push(&decls, decl);
+            continue;
+        }
+        GenTemplate *t = template_of_decl(&m, decl);
+        for (int k = t && !t->overflow ? t->first : -1; k >= 0; k = m.insts[k].next)
+            hulk_node_list_push(&decls, m.insts[k].decl);
+    }
+    prog->declarations = decls;
+
+    free(m.tmpls);
+    free(m.insts);
+    hulk_name_index_free(&m.tmpl_index);
+    hulk_name_index_free(&m.inst_index);
+    return 1;
+}
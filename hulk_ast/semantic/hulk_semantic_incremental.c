@@ -0,0 +1,880 @@
+/*
+ * hulk_semantic_incremental.c — Análisis semántico incremental (modo watch)
+ *
+ * Entre corridas sobre versiones editadas de un mismo programa se guarda,
+ * por declaración top-level, una huella de su texto, los nombres que
+ * menciona, los diagnósticos de su verificación y los valores que publicó
+ * (retornos inferidos, firmas decoradas). Cada corrida rehace desugaring
+ * y pases 1-2 (globales y baratos) y decide qué cuerpos volver a
+ * verificar con un grafo de dependencias por nombre: una declaración
+ * depende de las que declaran algún nombre que menciona (función, tipo o
+ * miembro).
+ *
+ * La huella sale del fuente, no del AST: el pre-escaneo del parser
+ * paralelo (hulk_top_level_boundaries) corta el texto en tramos de ítems
+ * completos y cada ítem se parsea sin contexto de los demás, así que un
+ * tramo con el mismo texto da los mismos nodos, corridos en líneas. La
+ * huella de una declaración es la de su tramo (texto y columna de
+ * inicio) y su lugar en él; si coincide, el texto del tramo se compara
+ * además con el de la corrida anterior (se guarda una copia del fuente),
+ * así una colisión del hash no hace reusar un cuerpo que cambió. Los
+ * nombres que menciona se buscan en el AST solo si el tramo cambió.
+ *
+ * Un cuerpo se vuelve a verificar si:
+ *   - la declaración es nueva o cambió el texto de su tramo;
+ *   - cambió su firma tras el pase 2, o la de una declaración de la que
+ *     depende, o desapareció una de ellas;
+ *   - cambió cuántas de las que publican un nombre que menciona quedan
+ *     antes que ella (en serie se ve el valor publicado o el previo);
+ *   - una anterior, verificada en esta corrida, publicó para un nombre
+ *     que menciona un valor distinto al de la corrida anterior.
+ * Si cambia cualquier tipo (miembros, herencia, parámetros, orden) se
+ * verifica todo: los valores de un tipo llegan a cuerpos que no lo
+ * nombran.
+ *
+ * El resto reusa sus diagnósticos (re-basados a su línea actual) y
+ * reaplica lo que publicó, así que diagnósticos, orden y resultado son
+ * los del análisis completo. Una declaración cuyo resultado no se puede
+ * guardar fielmente (publica un tipo que no se puede volver a nombrar,
+ * da un diagnóstico fuera de su tramo, comparte nombre con otra) queda
+ * volátil: se verifica en todas las corridas.
+ * Un programa con genéricos se verifica entero: las instancias no tienen
+ * texto propio, dependen de su plantilla y de dónde se las pide.
+ *
+ * SRP: solo decide qué verificar y guarda resultados; la verificación es
+ * la de hulk_semantic_check.c.
+ */
+
+#include "hulk_semantic_internal.h"
+#include "../core/hulk_intern.h"
+#include "../builder/hulk_parallel_builder.h"
+#include <stdint.h>
+
+#define SEM_INC_MAX_PARAMS 64
+#define SEM_INC_TYPE_TEXT  512
+#define SEM_INC_STACK_PUB  8
+#define SEM_INC_BLOOM_BITS 4096
+#define SEM_INC_PUB_BITS   65536
+
+#define HASH_SEED 0xcbf29ce484222325ull
+
+/* Lo que queda de una declaración entre corridas */
+typedef struct {
+    const char  *name;        // FunctionDef / TypeDef; NULL en expresiones
+    int          kind;        // HulkNodeType
+    uint64_t     body, order, env;
+    int          text_at;     // tramo en HulkSemanticState.source
+    int          text_len;
+    int          always;      // volátil
+    const char **names;       // nombres que declara (internados)
+    int          name_count;
+    const char **mentions;    // nombres que menciona, sin repetir
+    int          mention_count;
+    SemDiagList  diags;       // líneas relativas a la de la declaración
+    char       **pub;         // retorno y firma por símbolo publicado
+    int          pub_count;   // (NULL = sin valor)
+} SemDeclRecord;
+
+struct HulkSemanticState_s {
+    SemDeclRecord *decls;
+    int            count;
+    char          *source;    // fuente de la última corrida (textos de tramos)
+    uint64_t       types;     // firma de los tipos tras el pase 2
+    int            ready;     // ya hubo una corrida
+    int            checked;   // cuerpos verificados en la última
+};
+
+/* ---------- Estado de una corrida ---------- */
+
+/* Conjunto chico de nombres con un filtro de bits delante: casi todas
+ * las consultas son de nombres que no están. */
+typedef struct {
+    HulkNameIndex ix;
+    uint64_t      bloom[SEM_INC_BLOOM_BITS / 64];
+} NameSet;
+
+typedef struct {
+    uint64_t hash;
+    int      start, end;
+    int      first_line, last_line;
+} Segment;
+
+typedef struct {
+    HulkNode      *node;
+    const char    *name;
+    int            line, first_line, last_line;
+    uint64_t       body, order, env;
+    int            text_at, text_len;  // tramo en el fuente de esta corrida
+    int            same_text;   // huella y texto iguales a los de `old`
+    const char   **ment;        // del registro anterior o propios
+    int            ment_count;
+    int            ment_owned;
+    SemDeclRecord *old;
+    int            always;
+    int            seed;
+} DeclPlan;
+
+typedef struct {
+    SemanticContext *c;
+    DeclPlan     *decls;
+    int           count;
+    NameSet       touched;      // cambió su firma o dejó de declararse
+    NameSet       changed;      // esta corrida publicó otro valor
+    HulkNameIndex pub_ix;       // nombre → publishers
+    int          *publishers;   // declaraciones recorridas que lo publican
+    int           pub_names, pub_cap;
+    uint64_t     *pub_bloom;    // SEM_INC_PUB_BITS: filtro de pub_ix
+    int           all;          // verificar todo
+    int           ok;
+} IncPlan;
+
+static uint64_t mix(uint64_t h, uint64_t v) {
+    h ^= v;
+    h *= 0x100000001b3ull;
+    return h ^ (h >> 32);
+}
+
+static unsigned bloom_bit(const char *name, unsigned bits) {
+    return hulk_intern_hash(name) & (bits - 1);
+}
+
+static void set_add(NameSet *s, const char *name) {
+    unsigned b = bloom_bit(name, SEM_INC_BLOOM_BITS);
+    s->bloom[b / 64] |= 1ull << (b % 64);
+    hulk_name_index_add(&s->ix, name, 0);
+}
+
+static int set_has(const NameSet *s, const char *name) {
+    unsigned b = bloom_bit(name, SEM_INC_BLOOM_BITS);
+    return (s->bloom[b / 64] >> (b % 64) & 1) &&
+           hulk_name_index_find(&s->ix, name) >= 0;
+}
+
+static int mentions_any(const NameSet *s, const DeclPlan *d) {
+    if (s->ix.count == 0) return 0;
+    for (int k = 0; k < d->ment_count; k++)
+        if (set_has(s, d->ment[k])) return 1;
+    return 0;
+}
+
+/* ============================================================
+ *  Huellas: tramos del fuente, firma tras el pase 2, tipos
+ * ============================================================ */
+
+/* Huella de source[s, e) y líneas que ocupa desde `line`. */
+static void hash_segment(const char *source, int s, int e, int line,
+                         int col, Segment *out) {
+    uint64_t h = mix(HASH_SEED, (uint64_t)(uint32_t)col);
+    const char *p = source + s, *end = source + e;
+    for (; end - p >= 8; p += 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = mix(h, w);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, (size_t)(end - p));
+    out->hash = mix(mix(h, tail), (uint64_t)(e - s));
+    out->start = s;
+    out->end = e;
+    out->first_line = out->last_line = line;
+    for (p = source + s; p < end && (p = memchr(p, '\n', (size_t)(end - p)));
+         p++)
+        out->last_line++;
+}
+
+/* Tramo que contiene la posición (line, col): cuántas fronteras quedan
+ * en ella o antes. */
+static int segment_of(const HulkTopBoundary *b, int nb, int line, int col) {
+    int lo = 0, hi = nb;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (b[mid].line < line || (b[mid].line == line && b[mid].col <= col))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static uint64_t type_hash(HulkType *t, int depth) {
+    if (!t) return 1;
+    uint64_t h = mix(HASH_SEED, t->kind);
+    h = mix(h, (uint64_t)(uintptr_t)t->name);
+    if (t->kind == HULK_TYPE_FUNCTION && depth < 8) {
+        h = mix(h, (uint64_t)t->param_count);
+        for (int i = 0; i < t->param_count; i++)
+            h = mix(h, type_hash(t->param_types ? t->param_types[i] : NULL,
+                                 depth + 1));
+        h = mix(h, type_hash(t->return_type, depth + 1));
+    }
+    return h;
+}
+
+static uint64_t symbol_hash(uint64_t h, Symbol *s) {
+    h = mix(h, (uint64_t)(uintptr_t)s->name);
+    h = mix(h, s->kind);
+    h = mix(h, type_hash(s->type, 0));
+    h = mix(h, type_hash(s->callable_type, 0));
+    h = mix(h, (uint64_t)s->param_count);
+    for (int i = 0; i < s->param_count; i++)
+        h = mix(h, type_hash(s->param_types ? s->param_types[i] : NULL, 0));
+    return h;
+}
+
+/* Firma de una declaración tras el pase 2 (0 si no es una función). Si
+ * el símbolo global no es de ella (nombre repetido) queda volátil. */
+static uint64_t decl_env(SemanticContext *c, DeclPlan *d) {
+    if (d->node->type == NODE_FUNCTION_DEF) {
+        Symbol *s = sem_lookup_local(c->global, d->name);
+        if (!s || s->decl_node != d->node) { d->always = 1; return 0; }
+        return symbol_hash(HASH_SEED, s);
+    }
+    if (d->node->type == NODE_TYPE_DEF) {
+        Symbol *s = sem_lookup_local(c->global, d->name);
+        if (!s || s->decl_node != d->node) d->always = 1;
+    }
+    return 0;
+}
+
+/* Firma de todos los tipos del programa, en orden. */
+static uint64_t types_signature(SemanticContext *c, ProgramNode *prog) {
+    uint64_t h = HASH_SEED;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (decl->type != NODE_TYPE_DEF) continue;
+        TypeDefNode *td = (TypeDefNode*)decl;
+        h = mix(h, (uint64_t)(uintptr_t)td->name);
+        Symbol *ts = sem_lookup_local(c->global, td->name);
+        if (ts) h = symbol_hash(mix(h, ts->decl_node == decl), ts);
+        HulkType *t = sem_type_resolve(c, td->name);
+        if (!t) continue;
+        h = mix(h, (uint64_t)t->is_protocol);
+        h = mix(h, type_hash(t->parent, 0));
+        if (!t->members) continue;
+        h = mix(h, (uint64_t)t->members->sym_count);
+        for (int k = 0; k < t->members->sym_count; k++)
+            h = symbol_hash(h, t->members->symbols[k]);
+    }
+    return h;
+}
+
+/* ============================================================
+ *  Nombres: declarados, mencionados y publicados
+ * ============================================================ */
+
+/* Nombres que declara: la función, o el tipo y sus miembros. */
+static int declared_count(HulkNode *decl) {
+    if (decl->type == NODE_FUNCTION_DEF) return 1;
+    if (decl->type != NODE_TYPE_DEF) return 0;
+    return ((TypeDefNode*)decl)->members.count + 1;
+}
+
+static const char* declared_name(HulkNode *decl, int k) {
+    if (decl->type == NODE_FUNCTION_DEF) return ((FunctionDefNode*)decl)->name;
+    TypeDefNode *td = (TypeDefNode*)decl;
+    if (k == 0) return td->name;
+    HulkNode *mem = td->members.items[k - 1];
+    return mem->type == NODE_METHOD_DEF ? ((MethodDefNode*)mem)->name
+                                        : ((AttributeDefNode*)mem)->name;
+}
+
+static const char** declared_names(HulkNode *decl, int *count) {
+    *count = declared_count(decl);
+    if (*count == 0) return NULL;
+    const char **out = malloc(sizeof(const char*) * (size_t)*count);
+    if (!out) { *count = 0; return NULL; }
+    for (int k = 0; k < *count; k++) out[k] = declared_name(decl, k);
+    return out;
+}
+
+typedef struct {
+    const char **items;
+    int          count, cap;
+    int          ok;
+} NameList;
+
+static void collect_mentions(HulkNode *n, NameList *out) {
+    if (!n || !out->ok) return;
+    if (n->type == NODE_IDENT || n->type == NODE_MEMBER_ACCESS ||
+        n->type == NODE_DECOR_ITEM) {
+        HulkNodePayload pl;
+        hulk_ast_payload(n, &pl);
+        if (pl.name) {
+            if (out->count >= out->cap) {
+                int nc = out->cap ? out->cap * 2 : 16;
+                const char **tmp = realloc(out->items,
+                                           sizeof(const char*) * (size_t)nc);
+                if (!tmp) { out->ok = 0; return; }
+                out->items = tmp;
+                out->cap = nc;
+            }
+            out->items[out->count++] = pl.name;
+        }
+    }
+    HulkNodeSlots sl;
+    hulk_ast_slots(n, &sl);
+    for (int k = 0; k < sl.nfixed; k++) collect_mentions(*sl.fixed[k], out);
+    for (int k = 0; k < sl.nlists; k++)
+        for (int m = 0; m < sl.lists[k]->count; m++)
+            collect_mentions(sl.lists[k]->items[m], out);
+}
+
+static int cmp_name(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)*(const char* const*)a;
+    uintptr_t y = (uintptr_t)*(const char* const*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* Nombres que menciona la declaración, sin repetir (orden de puntero). */
+static void plan_mentions(IncPlan *p, DeclPlan *d) {
+    NameList l = { NULL, 0, 0, 1 };
+    collect_mentions(d->node, &l);
+    if (!l.ok) { free(l.items); p->ok = 0; return; }
+    if (l.count > 1)
+        qsort(l.items, (size_t)l.count, sizeof(const char*), cmp_name);
+    int n = 0;
+    for (int k = 0; k < l.count; k++)
+        if (n == 0 || l.items[n - 1] != l.items[k]) l.items[n++] = l.items[k];
+    d->ment = l.items;
+    d->ment_count = n;
+    d->ment_owned = 1;
+}
+
+static int publishes_member(TypeDefNode *td, HulkNode *m) {
+    if (td->is_protocol || m->type != NODE_METHOD_DEF) return 0;
+    MethodDefNode *md = (MethodDefNode*)m;
+    return !md->return_type || md->decorators.count > 0;
+}
+
+/* Nombres a los que verificar `decl` les fija valor (retorno inferido o
+ * firma decorada), en orden; retorna cuántos. Con `out` NULL solo
+ * cuenta. */
+static int published_names(HulkNode *decl, const char **out) {
+    int n = 0;
+    if (decl->type == NODE_FUNCTION_DEF) {
+        FunctionDefNode *fn = (FunctionDefNode*)decl;
+        if (!fn->return_type) {
+            if (out) out[n] = fn->name;
+            n++;
+        }
+    } else if (decl->type == NODE_TYPE_DEF) {
+        TypeDefNode *td = (TypeDefNode*)decl;
+        for (int m = 0; m < td->members.count; m++)
+            if (publishes_member(td, td->members.items[m])) {
+                if (out) out[n] = ((MethodDefNode*)td->members.items[m])->name;
+                n++;
+            }
+    }
+    return n;
+}
+
+/* Símbolos de published_names, con las mismas búsquedas que
+ * check_function_def y check_member. Retorna cuántos dejó en `out`. */
+static int published_symbols(SemanticContext *c, HulkNode *decl,
+                             Symbol **out, int cap) {
+    int n = 0;
+    if (decl->type == NODE_FUNCTION_DEF) {
+        FunctionDefNode *fn = (FunctionDefNode*)decl;
+        if (!fn->return_type && cap > 0) out[n++] = sem_lookup(c->global, fn->name);
+        return n;
+    }
+    if (decl->type != NODE_TYPE_DEF) return 0;
+    TypeDefNode *td = (TypeDefNode*)decl;
+    HulkType *type = sem_type_resolve(c, td->name);
+    for (int m = 0; m < td->members.count && n < cap; m++)
+        if (publishes_member(td, td->members.items[m]))
+            out[n++] = type ? sem_lookup_member(type,
+                ((MethodDefNode*)td->members.items[m])->name) : NULL;
+    return n;
+}
+
+/* Aplica `fn` a cada nombre que publica `decl`; 0 si no hubo memoria. */
+static int each_published(HulkNode *decl, void (*fn)(void*, const char*),
+                          void *arg) {
+    const char *stack[SEM_INC_STACK_PUB];
+    int n = published_names(decl, NULL);
+    if (n == 0) return 1;
+    const char **names = n <= SEM_INC_STACK_PUB ? stack
+                       : malloc(sizeof(const char*) * (size_t)n);
+    if (!names) return 0;
+    published_names(decl, names);
+    for (int k = 0; k < n; k++) fn(arg, names[k]);
+    if (names != stack) free(names);
+    return 1;
+}
+
+/* Cuenta un publicador más de `name`. */
+static void add_publisher(void *arg, const char *name) {
+    IncPlan *p = arg;
+    unsigned b = bloom_bit(name, SEM_INC_PUB_BITS);
+    p->pub_bloom[b / 64] |= 1ull << (b % 64);
+    int at = hulk_name_index_find(&p->pub_ix, name);
+    if (at >= 0) { p->publishers[at]++; return; }
+    if (p->pub_names >= p->pub_cap) {
+        int nc = p->pub_cap ? p->pub_cap * 2 : 256;
+        int *tmp = realloc(p->publishers, sizeof(int) * (size_t)nc);
+        if (!tmp) { p->ok = 0; return; }
+        p->publishers = tmp;
+        p->pub_cap = nc;
+    }
+    p->publishers[p->pub_names] = 1;
+    hulk_name_index_add(&p->pub_ix, name, p->pub_names++);
+}
+
+static void add_changed(void *arg, const char *name) {
+    set_add(&((IncPlan*)arg)->changed, name);
+}
+
+/* ============================================================
+ *  Valores publicados como texto
+ * ============================================================ */
+
+typedef struct {
+    char buf[SEM_INC_TYPE_TEXT];
+    int  len;
+} TypeText;
+
+static int text_put(TypeText *t, const char *s) {
+    size_t n = strlen(s);
+    if ((size_t)t->len + n + 1 > sizeof(t->buf)) return 0;
+    memcpy(t->buf + t->len, s, n + 1);
+    t->len += (int)n;
+    return 1;
+}
+
+/* Texto que type_read vuelve a convertir en el mismo HulkType:
+ *   "[E"       vector canónico de E
+ *   "(A,B)R"   tipo función canónico
+ *   "Nombre"   tipo registrado con ese nombre
+ * Retorna 0 si no hay forma de nombrarlo. */
+static int type_write(SemanticContext *c, TypeText *t, HulkType *ty) {
+    if (!ty) return 0;
+    if (ty->element && ty->element->vector_of == ty)
+        return text_put(t, "[") && type_write(c, t, ty->element);
+    if (!strpbrk(ty->name, "[](),") && sem_type_resolve(c, ty->name) == ty)
+        return text_put(t, ty->name);
+    if (ty->kind != HULK_TYPE_FUNCTION || !ty->return_type ||
+        ty->param_count > SEM_INC_MAX_PARAMS ||
+        (ty->param_count && !ty->param_types) ||
+        sem_function_type_new(c, ty->param_types, ty->param_count,
+                              ty->return_type) != ty)
+        return 0;
+    if (!text_put(t, "(")) return 0;
+    for (int i = 0; i < ty->param_count; i++)
+        if ((i && !text_put(t, ",")) || !type_write(c, t, ty->param_types[i]))
+            return 0;
+    return text_put(t, ")") && type_write(c, t, ty->return_type);
+}
+
+static HulkType* type_read(SemanticContext *c, const char **s) {
+    if (**s == '[') {
+        (*s)++;
+        HulkType *elem = type_read(c, s);
+        return elem ? sem_vector_type(c, elem) : NULL;
+    }
+    if (**s == '(') {
+        (*s)++;
+        HulkType *params[SEM_INC_MAX_PARAMS];
+        int n = 0;
+        while (**s != ')') {
+            if (n > 0 && *(*s)++ != ',') return NULL;
+            if (n == SEM_INC_MAX_PARAMS) return NULL;
+            if (!(params[n++] = type_read(c, s))) return NULL;
+        }
+        (*s)++;
+        HulkType *ret = type_read(c, s);
+        return ret ? sem_function_type_new(c, params, n, ret) : NULL;
+    }
+    char name[SEM_INC_TYPE_TEXT];
+    size_t len = strcspn(*s, ",)");
+    if (len == 0 || len >= sizeof(name)) return NULL;
+    memcpy(name, *s, len);
+    name[len] = '\0';
+    *s += len;
+    return sem_type_resolve(c, name);
+}
+
+static char* type_text(SemanticContext *c, HulkType *ty, int *ok) {
+    if (!ty) return NULL;
+    TypeText t;
+    t.len = 0;
+    t.buf[0] = '\0';
+    if (!type_write(c, &t, ty)) { *ok = 0; return NULL; }
+    char *out = strdup(t.buf);
+    if (!out) *ok = 0;
+    return out;
+}
+
+/* Guarda lo que publicó la verificación de `decl`; 0 si algún valor no
+ * se puede volver a nombrar. */
+static int record_published(SemanticContext *c, HulkNode *decl,
+                            SemDeclRecord *r) {
+    r->pub = NULL;
+    r->pub_count = 0;
+    int count = published_names(decl, NULL);
+    if (count == 0) return 1;
+    Symbol *stack[SEM_INC_STACK_PUB];
+    Symbol **syms = count <= SEM_INC_STACK_PUB ? stack
+                  : malloc(sizeof(Symbol*) * (size_t)count);
+    r->pub = calloc((size_t)count * 2, sizeof(char*));
+    if (!syms || !r->pub) {
+        if (syms != stack) free(syms);
+        return 0;
+    }
+    int n = published_symbols(c, decl, syms, count);
+    int ok = n == count;
+    r->pub_count = n * 2;
+    for (int i = 0; i < n && ok; i++) {
+        if (!syms[i]) continue;
+        r->pub[2 * i]     = type_text(c, syms[i]->type, &ok);
+        r->pub[2 * i + 1] = type_text(c, syms[i]->callable_type, &ok);
+    }
+    if (syms != stack) free(syms);
+    return ok;
+}
+
+/* Reaplica lo publicado en la corrida anterior; todo o nada. */
+static int apply_published(SemanticContext *c, HulkNode *decl,
+                           const SemDeclRecord *r) {
+    int count = published_names(decl, NULL);
+    if (r->pub_count != count * 2) return 0;
+    if (count == 0) return 1;
+    Symbol *sstack[SEM_INC_STACK_PUB];
+    HulkType *vstack[SEM_INC_STACK_PUB * 2];
+    int small = count <= SEM_INC_STACK_PUB;
+    Symbol **syms = small ? sstack : malloc(sizeof(Symbol*) * (size_t)count);
+    HulkType **vals = small ? vstack
+                    : malloc(sizeof(HulkType*) * (size_t)r->pub_count);
+    int ok = syms && vals &&
+             published_symbols(c, decl, syms, count) == count;
+    for (int i = 0; ok && i < r->pub_count; i++) {
+        const char *s = r->pub[i];
+        vals[i] = NULL;
+        if (!s) continue;
+        vals[i] = type_read(c, &s);
+        if (!vals[i] || *s) ok = 0;
+    }
+    for (int i = 0; ok && i < count; i++) {
+        if (!syms[i]) continue;
+        syms[i]->type = vals[2 * i];
+        syms[i]->callable_type = vals[2 * i + 1];
+    }
+    if (!small) {
+        free(syms);
+        free(vals);
+    }
+    return ok;
+}
+
+static int published_differs(const SemDeclRecord *a, const SemDeclRecord *b) {
+    if (a->pub_count != b->pub_count) return 1;
+    for (int i = 0; i < a->pub_count; i++) {
+        if (!a->pub[i] != !b->pub[i]) return 1;
+        if (a->pub[i] && strcmp(a->pub[i], b->pub[i]) != 0) return 1;
+    }
+    return 0;
+}
+
+/* ============================================================
+ *  Plan: huellas, emparejado con la corrida anterior y semillas
+ * ============================================================ */
+
+/* El tramo de `d` es el mismo que el de su registro anterior: igual
+ * huella e igual texto. */
+static int same_segment(const HulkSemanticState *st, const DeclPlan *d,
+                        const char *source) {
+    const SemDeclRecord *r = d->old;
+    return r && st->source && r->body == d->body &&
+           r->text_len == d->text_len &&
+           memcmp(st->source + r->text_at, source + d->text_at,
+                  (size_t)d->text_len) == 0;
+}
+
+/* Registro anterior de la declaración i: las que tienen nombre, por
+ * nombre (primero el de la misma posición); las expresiones, en orden
+ * entre ellas. */
+static SemDeclRecord* match_old(HulkSemanticState *st, DeclPlan *d, int i,
+                                int *used, HulkNameIndex *old_ix,
+                                int *old_expr) {
+    int j = -1;
+    if (d->name) {
+        if (i < st->count && st->decls[i].name == d->name) {
+            j = i;
+        } else {
+            if (!old_ix->cap)
+                for (int k = 0; k < st->count; k++)
+                    if (st->decls[k].name)
+                        hulk_name_index_add(old_ix, st->decls[k].name, k);
+            j = hulk_name_index_find(old_ix, d->name);
+        }
+    } else {
+        while (*old_expr < st->count && st->decls[*old_expr].name) (*old_expr)++;
+        j = *old_expr < st->count ? (*old_expr)++ : -1;
+    }
+    if (j < 0 || used[j] || st->decls[j].kind != (int)d->node->type) return NULL;
+    used[j] = 1;
+    return &st->decls[j];
+}
+
+static void plan_build(IncPlan *p, HulkSemanticState *st, ProgramNode *prog,
+                       const char *source) {
+    SemanticContext *c = p->c;
+    p->count = prog->declarations.count;
+    p->decls = calloc(p->count ? (size_t)p->count : 1, sizeof(DeclPlan));
+    int *used = calloc(st->count ? (size_t)st->count : 1, sizeof(int));
+    HulkTopBoundary *bounds = NULL;
+    int nb = hulk_top_level_boundaries(source, &bounds);
+    Segment *segs = calloc((size_t)nb + 1, sizeof(Segment));
+    int *seen = calloc((size_t)nb + 1, sizeof(int));
+    p->pub_bloom = calloc(SEM_INC_PUB_BITS / 64, sizeof(uint64_t));
+    if (!p->decls || !used || !bounds || !segs || !seen || !p->pub_bloom) {
+        p->ok = 0;
+        free(used);
+        free(bounds);
+        free(segs);
+        free(seen);
+        return;
+    }
+    int len = (int)strlen(source);
+    for (int k = 0; k <= nb; k++)
+        hash_segment(source, k ? bounds[k - 1].pos : 0,
+                     k < nb ? bounds[k].pos : len,
+                     k ? bounds[k - 1].line : 1,
+                     k ? bounds[k - 1].col : 1, &segs[k]);
+
+    HulkNameIndex old_ix = { 0 };
+    int old_expr = 0;
+    for (int i = 0; i < p->count && p->ok; i++) {
+        DeclPlan *d = &p->decls[i];
+        d->node = prog->declarations.items[i];
+        if (d->node->type == NODE_FUNCTION_DEF)
+            d->name = ((FunctionDefNode*)d->node)->name;
+        else if (d->node->type == NODE_TYPE_DEF)
+            d->name = ((TypeDefNode*)d->node)->name;
+
+        /* huella: la del tramo, el lugar en él y la línea dentro */
+        int seg = segment_of(bounds, nb, d->node->line, d->node->col);
+        d->line = d->node->line;
+        d->first_line = segs[seg].first_line;
+        d->last_line = segs[seg].last_line;
+        uint64_t body = mix(segs[seg].hash, (uint64_t)seen[seg]++);
+        body = mix(body, (uint64_t)(uint32_t)(d->line - d->first_line));
+        d->body = mix(body, d->node->type);
+        d->text_at = segs[seg].start;
+        d->text_len = segs[seg].end - segs[seg].start;
+        d->env = decl_env(c, d);
+        d->old = match_old(st, d, i, used, &old_ix, &old_expr);
+        d->same_text = same_segment(st, d, source);
+        if (d->same_text) {
+            d->ment = d->old->mentions;
+            d->ment_count = d->old->mention_count;
+        } else {
+            plan_mentions(p, d);
+        }
+
+        /* cuántos publicadores de cada nombre mencionado quedan antes */
+        uint64_t order = HASH_SEED;
+        for (int k = 0; k < d->ment_count && p->pub_names; k++) {
+            unsigned b = bloom_bit(d->ment[k], SEM_INC_PUB_BITS);
+            if (!(p->pub_bloom[b / 64] >> (b % 64) & 1)) continue;
+            int at = hulk_name_index_find(&p->pub_ix, d->ment[k]);
+            if (at >= 0)
+                order = mix(mix(order, (uint64_t)(uintptr_t)d->ment[k]),
+                            (uint64_t)p->publishers[at]);
+        }
+        d->order = order;
+        if (!each_published(d->node, add_publisher, p)) p->ok = 0;
+    }
+    hulk_name_index_free(&old_ix);
+
+    if (p->ok) {
+        /* Semillas: lo que cambió y lo que menciona firmas que cambiaron */
+        for (int i = 0; i < p->count; i++) {
+            DeclPlan *d = &p->decls[i];
+            SemDeclRecord *r = d->old;
+            int env_changed = !r || r->always || d->always || r->env != d->env;
+            d->seed = env_changed || !d->same_text || r->order != d->order;
+            if (env_changed)
+                for (int k = 0, n = declared_count(d->node); k < n; k++)
+                    set_add(&p->touched, declared_name(d->node, k));
+        }
+        for (int j = 0; j < st->count; j++)
+            if (!used[j])
+                for (int k = 0; k < st->decls[j].name_count; k++)
+                    set_add(&p->touched, st->decls[j].names[k]);
+        for (int i = 0; i < p->count; i++) {
+            DeclPlan *d = &p->decls[i];
+            if (!d->seed && mentions_any(&p->touched, d)) d->seed = 1;
+        }
+    }
+    free(used);
+    free(bounds);
+    free(segs);
+    free(seen);
+}
+
+static void plan_free(IncPlan *p) {
+    for (int i = 0; p->decls && i < p->count; i++)
+        if (p->decls[i].ment_owned) free((void*)p->decls[i].ment);
+    free(p->decls);
+    free(p->publishers);
+    free(p->pub_bloom);
+    hulk_name_index_free(&p->pub_ix);
+    hulk_name_index_free(&p->touched.ix);
+    hulk_name_index_free(&p->changed.ix);
+}
+
+/* ============================================================
+ *  Pase 3 incremental
+ * ============================================================ */
+
+static void record_free(SemDeclRecord *r) {
+    free(r->names);
+    free((void*)r->mentions);
+    sem_diags_free(&r->diags);
+    for (int i = 0; i < r->pub_count; i++) free(r->pub[i]);
+    free(r->pub);
+}
+
+/* Verifica (o reusa) la declaración i y deja su registro en `r`. */
+static void process_decl(IncPlan *p, HulkSemanticState *st, int i,
+                         SemDeclRecord *r) {
+    SemanticContext *c = p->c;
+    DeclPlan *d = &p->decls[i];
+    SemDeclRecord *old = d->old;
+    r->name = d->name;
+    r->kind = d->node->type;
+    r->body = d->body;
+    r->order = d->order;
+    r->env = d->env;
+    r->text_at = d->text_at;
+    r->text_len = d->text_len;
+
+    /* Los nombres mencionados pasan al registro nuevo */
+    r->mentions = d->ment;
+    r->mention_count = d->ment_count;
+    if (d->ment_owned) d->ment_owned = 0;
+    else if (old) old->mentions = NULL;
+
+    int check = p->all || d->seed || mentions_any(&p->changed, d) ||
+                !apply_published(c, d->node, old);
+    int pub_changed = 0;
+    if (check) {
+        st->checked++;
+        r->names = declared_names(d->node, &r->name_count);
+        c->diags = &r->diags;
+        sem_check_unit(c, d->node, -1);
+        c->diags = NULL;
+        sem_diags_emit(&r->diags, 0);
+        r->always = d->always;
+        for (int k = 0; k < r->diags.count; k++) {
+            SemDiag *g = &r->diags.items[k];
+            if (g->line < d->first_line || g->line > d->last_line)
+                r->always = 1;
+            g->line -= d->line;
+        }
+        if (!record_published(c, d->node, r)) r->always = 1;
+        pub_changed = !old || old->always || r->always ||
+                      published_differs(old, r);
+    } else {
+        /* Lo del registro anterior pasa al nuevo */
+        c->error_count += old->diags.count;
+        sem_diags_emit(&old->diags, d->line);
+        r->diags = old->diags;
+        r->pub = old->pub;
+        r->pub_count = old->pub_count;
+        r->names = old->names;
+        r->name_count = old->name_count;
+        memset(&old->diags, 0, sizeof(old->diags));
+        old->pub = NULL;
+        old->pub_count = 0;
+        old->names = NULL;
+        old->name_count = 0;
+    }
+    if (pub_changed && !each_published(d->node, add_changed, p))
+        p->all = 1;   /* sin memoria para anotarlo: lo que sigue, entero */
+}
+
+/* ============================================================
+ *  API pública
+ * ============================================================ */
+
+HulkSemanticState* hulk_semantic_state_new(void) {
+    return calloc(1, sizeof(HulkSemanticState));
+}
+
+static void state_clear(HulkSemanticState *st) {
+    for (int i = 0; i < st->count; i++) record_free(&st->decls[i]);
+    free(st->decls);
+    free(st->source);
+    st->decls = NULL;
+    st->source = NULL;
+    st->count = 0;
+    st->ready = 0;
+}
+
+void hulk_semantic_state_free(HulkSemanticState *st) {
+    if (!st) return;
+    state_clear(st);
+    free(st);
+}
+
+int hulk_semantic_state_checked(const HulkSemanticState *st) {
+    return st ? st->checked : 0;
+}
+
+int hulk_semantic_analyze_incremental(HulkSemanticState *st,
+                                      HulkASTContext *ast_ctx,
+                                      HulkNode *program,
+                                      const char *source) {
+    SemanticContext ctx;
+    sem_context_init(&ctx, ast_ctx);
+    int generic = sem_monomorphize(&ctx, program);
+    sem_desugar(&ctx, program);
+    st->checked = 0;
+    if (!program || program->type != NODE_PROGRAM) {
+        state_clear(st);
+        int errors = ctx.error_count;
+        sem_context_free(&ctx);
+        return errors;
+    }
+    ProgramNode *prog = (ProgramNode*)program;
+    sem_collect_pass1_types(&ctx, prog);
+    sem_collect_pass2_resolve(&ctx, prog);
+
+    IncPlan plan;
+    memset(&plan, 0, sizeof(plan));
+    plan.c = &ctx;
+    plan.ok = source != NULL && !generic;
+    uint64_t types = types_signature(&ctx, prog);
+    if (plan.ok) plan_build(&plan, st, prog, source);
+    plan.all = !plan.ok || !st->ready || types != st->types;
+
+    SemDeclRecord *next = calloc(plan.count ? (size_t)plan.count : 1,
+                                 sizeof(SemDeclRecord));
+    if (!plan.ok || !next) {
+        /* Sin plan: verificación completa y sin nada que guardar */
+        for (int i = 0; i < prog->declarations.count; i++)
+            sem_check_unit(&ctx, prog->declarations.items[i], -1);
+        st->checked = prog->declarations.count;
+        free(next);
+        plan_free(&plan);
+        state_clear(st);
+    } else {
+        for (int i = 0; i < plan.count; i++)
+            process_decl(&plan, st, i, &next[i]);
+        plan_free(&plan);
+        int checked = st->checked;
+        state_clear(st);
+        st->decls = next;
+        st->count = prog->declarations.count;
+        st->source = strdup(source);  /* NULL: la próxima verifica todo */
+        st->types = types;
+        st->ready = 1;
+        st->checked = checked;
+    }
+
+    int errors = ctx.error_count;
+    sem_context_free(&ctx);
+    return errors;
+}
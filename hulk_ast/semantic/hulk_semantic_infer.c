@@ -4,56 +4,54 @@
  * HULK permite omitir anotaciones de tipo; el chequeador necesita igual
  * un tipo para cada símbolo. Estas heurísticas sintácticas examinan los
  * cuerpos para inferirlo (spec A.9.4):
- *   - sem_infer_param_type: tipo de un parámetro según su uso.
+ *   - sem_infer_param_type: tipo de un parámetro de lambda según su uso
+ *     (los de funciones y métodos los resuelve hulk_semantic_unify.c).
  *   - sem_infer_self_member_type: tipo de un atributo/param de tipo según
  *     el uso de self.x en los métodos.
  *   - sem_body_calls_name: detecta recursión (para el default de retorno).
+ *
+ * Ninguna recorre el cuerpo: consultan los hechos que hulk_ast_facts
+ * junta en una sola pasada por cuerpo (c->facts), así preguntar por cada
+ * parámetro de una función larga no re-escanea la función entera.
  */
 #include "hulk_semantic_internal.h"
 
+static HulkType* tag_to_type(SemanticContext *c, HulkUseTag tag) {
+    switch (tag) {
+        case HULK_USE_NUMBER:  return c->t_number;
+        case HULK_USE_BOOLEAN: return c->t_boolean;
+        case HULK_USE_STRING:  return c->t_string;
+        default:               return NULL;
+    }
+}
+
 /* ============================================================
  *  Inferencia ad-hoc del tipo de un parámetro
  *
- *  Walker sintáctico que escanea el body buscando ocurrencias del
- *  identificador `param_name` en contextos que disambiguan el tipo:
+ *  Según los usos del identificador `param_name` en el body en
+ *  contextos que disambiguan el tipo:
  *    - Operandos de + - * / ^ % < > <= >=      → Number
  *    - Operandos de & | !                       → Boolean
+ *    - Argumento de una función con firma conocida → tipo del parámetro
  *  Si ninguna ocurrencia revela tipo, retorna NULL (caller deja Object).
  * ============================================================ */
 
-typedef enum { INF_NONE = 0, INF_NUMBER, INF_BOOLEAN, INF_STRING } InferTag;
-
-static InferTag join_inf(InferTag a, InferTag b) {
-    if (a == b) return a;
-    if (a == INF_NONE) return b;
-    if (b == INF_NONE) return a;
-    return INF_NUMBER;  /* Number gana en conflicto numérico */
-}
-
-static int is_param_ident(HulkNode *n, const char *name) {
-    return n && n->type == NODE_IDENT &&
-           strcmp(((IdentNode*)n)->name, name) == 0;
-}
-
-static InferTag type_to_inf(HulkType *t) {
-    if (!t) return INF_NONE;
+static HulkUseTag type_to_tag(HulkType *t) {
+    if (!t) return HULK_USE_NONE;
     switch (t->kind) {
-        case HULK_TYPE_NUMBER:  return INF_NUMBER;
-        case HULK_TYPE_BOOLEAN: return INF_BOOLEAN;
-        case HULK_TYPE_STRING:  return INF_STRING;
-        default:                return INF_NONE;
+        case HULK_TYPE_NUMBER:  return HULK_USE_NUMBER;
+        case HULK_TYPE_BOOLEAN: return HULK_USE_BOOLEAN;
+        case HULK_TYPE_STRING:  return HULK_USE_STRING;
+        default:                return HULK_USE_NONE;
     }
 }
 
-static InferTag infer_from_call_signature(SemanticContext *c,
-                                          CallExprNode *ce,
-                                          const char *name) {
-    if (!c || !ce || !ce->callee || ce->callee->type != NODE_IDENT)
-        return INF_NONE;
-
-    IdentNode *id = (IdentNode*)ce->callee;
-    Symbol *sym = sem_lookup(c->current, id->name);
-    if (!sym) return INF_NONE;
+/* Tipo del parámetro `index` de `callee` según su firma en el scope
+ * actual (la firma se resuelve al consultar, no al recolectar). */
+static HulkUseTag tag_from_call_signature(SemanticContext *c,
+                                          const HulkArgUse *use) {
+    Symbol *sym = sem_lookup(c->current, use->callee);
+    if (!sym) return HULK_USE_NONE;
 
     HulkType **param_types = NULL;
     int param_count = 0;
@@ -61,319 +59,61 @@ static InferTag infer_from_call_signature(SemanticContext *c,
         sym->param_types) {
         param_types = sym->param_types;
         param_count = sym->param_count;
-    } else if (sym->type && sym->type->kind == HULK_TYPE_FUNCTION &&
-               sym->type->param_types) {
-        param_types = sym->type->param_types;
-        param_count = sym->type->param_count;
-    } else if (sym->callable_type &&
-               sym->callable_type->kind == HULK_TYPE_FUNCTION &&
-               sym->callable_type->param_types) {
-        param_types = sym->callable_type->param_types;
-        param_count = sym->callable_type->param_count;
-    }
-
-    InferTag a = INF_NONE;
-    int count = ce->args.count < param_count ? ce->args.count : param_count;
-    for (int i = 0; i < count; i++) {
-        if (is_param_ident(ce->args.items[i], name))
-            a = join_inf(a, type_to_inf(param_types[i]));
-    }
-    return a;
-}
-
-static InferTag walk_infer(SemanticContext *c, HulkNode *n, const char *name) {
-    if (!n) return INF_NONE;
-    switch (n->type) {
-        case NODE_BINARY_OP: {
-            BinaryOpNode *b = (BinaryOpNode*)n;
-            InferTag here = INF_NONE;
-            switch (b->op) {
-                case OP_ADD: case OP_SUB: case OP_MUL:
-                case OP_DIV: case OP_MOD: case OP_POW:
-                case OP_LT: case OP_GT: case OP_LE: case OP_GE:
-                    if (is_param_ident(b->left, name) ||
-                        is_param_ident(b->right, name))
-                        here = INF_NUMBER;
-                    break;
-                case OP_AND: case OP_OR:
-                    if (is_param_ident(b->left, name) ||
-                        is_param_ident(b->right, name))
-                        here = INF_BOOLEAN;
-                    break;
-                default: break;
-            }
-            return join_inf(here,
-                join_inf(walk_infer(c, b->left, name),
-                          walk_infer(c, b->right, name)));
-        }
-        case NODE_UNARY_OP: {
-            UnaryOpNode *u = (UnaryOpNode*)n;
-            InferTag here = INF_NONE;
-            if (is_param_ident(u->operand, name)) here = INF_NUMBER;
-            return join_inf(here, walk_infer(c, u->operand, name));
-        }
-        case NODE_IF_EXPR: {
-            IfExprNode *iff = (IfExprNode*)n;
-            InferTag a = walk_infer(c, iff->condition, name);
-            a = join_inf(a, walk_infer(c, iff->then_body, name));
-            for (int i = 0; i < iff->elifs.count; i++) {
-                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                a = join_inf(a, walk_infer(c, e->condition, name));
-                a = join_inf(a, walk_infer(c, e->body, name));
-            }
-            a = join_inf(a, walk_infer(c, iff->else_body, name));
-            return a;
-        }
-        case NODE_WHILE_STMT: {
-            WhileStmtNode *w = (WhileStmtNode*)n;
-            return join_inf(walk_infer(c, w->condition, name),
-                             walk_infer(c, w->body, name));
-        }
-        case NODE_FOR_STMT: {
-            ForStmtNode *f = (ForStmtNode*)n;
-            return join_inf(walk_infer(c, f->iterable, name),
-                             walk_infer(c, f->body, name));
-        }
-        case NODE_BLOCK_STMT: {
-            BlockStmtNode *b = (BlockStmtNode*)n;
-            InferTag a = INF_NONE;
-            for (int i = 0; i < b->statements.count; i++)
-                a = join_inf(a, walk_infer(c, b->statements.items[i], name));
-            return a;
-        }
-        case NODE_LET_EXPR: {
-            LetExprNode *l = (LetExprNode*)n;
-            InferTag a = INF_NONE;
-            for (int i = 0; i < l->bindings.count; i++) {
-                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
-                a = join_inf(a, walk_infer(c, vb->init_expr, name));
-            }
-            a = join_inf(a, walk_infer(c, l->body, name));
-            return a;
-        }
-        case NODE_CALL_EXPR: {
-            CallExprNode *ce = (CallExprNode*)n;
-            InferTag a = infer_from_call_signature(c, ce, name);
-            for (int i = 0; i < ce->args.count; i++)
-                a = join_inf(a, walk_infer(c, ce->args.items[i], name));
-            return a;
-        }
-        case NODE_ASSIGN: {
-            AssignNode *as = (AssignNode*)n;
-            return walk_infer(c, as->value, name);
-        }
-        case NODE_DESTRUCT_ASSIGN: {
-            DestructAssignNode *as = (DestructAssignNode*)n;
-            return walk_infer(c, as->value, name);
-        }
-        case NODE_CONCAT_EXPR: {
-            ConcatExprNode *ce = (ConcatExprNode*)n;
-            return join_inf(walk_infer(c, ce->left, name),
-                             walk_infer(c, ce->right, name));
+    } else {
+        HulkType *t = sem_sym_type(c, sym);
+        HulkType *callable = sem_sym_callable(c, sym);
+        if (t && t->kind == HULK_TYPE_FUNCTION && t->param_types) {
+            param_types = t->param_types;
+            param_count = t->param_count;
+        } else if (callable && callable->kind == HULK_TYPE_FUNCTION &&
+                   callable->param_types) {
+            param_types = callable->param_types;
+            param_count = callable->param_count;
         }
-        default: return INF_NONE;
     }
+
+    if (use->index >= param_count) return HULK_USE_NONE;
+    return type_to_tag(param_types[use->index]);
 }
 
 HulkType* sem_infer_param_type(SemanticContext *c, const char *param_name,
                                 HulkNode *body) {
     if (!param_name || !body) return NULL;
-    switch (walk_infer(c, body, param_name)) {
-        case INF_NUMBER:  return c->t_number;
-        case INF_BOOLEAN: return c->t_boolean;
-        case INF_STRING:  return c->t_string;
-        default:          return NULL;
-    }
+    const HulkNameFacts *f = hulk_facts_name(&c->facts, body, param_name);
+    if (!f) return NULL;
+    HulkUseTag tag = (HulkUseTag)f->operand;
+    const HulkArgUse *args = hulk_facts_args(&c->facts, body);
+    for (int i = f->first_arg; i >= 0; i = args[i].next)
+        tag = hulk_use_join(tag, tag_from_call_signature(c, &args[i]));
+    return tag_to_type(c, tag);
 }
 
 /* ============================================================
  *  Inferencia de attrs/params del tipo a partir del uso de self.X
  *
- *  Walker que recorre los método-bodies del tipo y, si encuentra
- *  `self.X` como operando de + - * / ^ % < > <= >=, retorna Number.
+ *  Junta los usos de `self.X` en los método-bodies del tipo: como
+ *  operando de + - * / ^ % < > <= >= es Number, de & | Boolean y de
+ *  @ / @@ String.
  * ============================================================ */
 
-static int is_self_dot(HulkNode *n, const char *member) {
-    if (!n || n->type != NODE_MEMBER_ACCESS) return 0;
-    MemberAccessNode *ma = (MemberAccessNode*)n;
-    if (!ma->object || ma->object->type != NODE_SELF) return 0;
-    return ma->member && strcmp(ma->member, member) == 0;
-}
-
-static InferTag walk_self_member(HulkNode *n, const char *member) {
-    if (!n) return INF_NONE;
-    switch (n->type) {
-        case NODE_BINARY_OP: {
-            BinaryOpNode *b = (BinaryOpNode*)n;
-            InferTag here = INF_NONE;
-            switch (b->op) {
-                case OP_ADD: case OP_SUB: case OP_MUL:
-                case OP_DIV: case OP_MOD: case OP_POW:
-                case OP_LT: case OP_GT: case OP_LE: case OP_GE:
-                    if (is_self_dot(b->left, member) ||
-                        is_self_dot(b->right, member))
-                        here = INF_NUMBER;
-                    break;
-                case OP_AND: case OP_OR:
-                    if (is_self_dot(b->left, member) ||
-                        is_self_dot(b->right, member))
-                        here = INF_BOOLEAN;
-                    break;
-                default: break;
-            }
-            return join_inf(here,
-                join_inf(walk_self_member(b->left, member),
-                          walk_self_member(b->right, member)));
-        }
-        case NODE_UNARY_OP: {
-            UnaryOpNode *u = (UnaryOpNode*)n;
-            InferTag here = INF_NONE;
-            if (is_self_dot(u->operand, member)) here = INF_NUMBER;
-            return join_inf(here, walk_self_member(u->operand, member));
-        }
-        case NODE_IF_EXPR: {
-            IfExprNode *iff = (IfExprNode*)n;
-            InferTag a = walk_self_member(iff->condition, member);
-            a = join_inf(a, walk_self_member(iff->then_body, member));
-            for (int i = 0; i < iff->elifs.count; i++) {
-                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                a = join_inf(a, walk_self_member(e->condition, member));
-                a = join_inf(a, walk_self_member(e->body, member));
-            }
-            a = join_inf(a, walk_self_member(iff->else_body, member));
-            return a;
-        }
-        case NODE_BLOCK_STMT: {
-            BlockStmtNode *b = (BlockStmtNode*)n;
-            InferTag a = INF_NONE;
-            for (int i = 0; i < b->statements.count; i++)
-                a = join_inf(a, walk_self_member(b->statements.items[i], member));
-            return a;
-        }
-        case NODE_CALL_EXPR: {
-            CallExprNode *ce = (CallExprNode*)n;
-            InferTag a = INF_NONE;
-            for (int i = 0; i < ce->args.count; i++)
-                a = join_inf(a, walk_self_member(ce->args.items[i], member));
-            return a;
-        }
-        case NODE_LET_EXPR: {
-            LetExprNode *l = (LetExprNode*)n;
-            InferTag a = INF_NONE;
-            for (int i = 0; i < l->bindings.count; i++) {
-                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
-                a = join_inf(a, walk_self_member(vb->init_expr, member));
-            }
-            return join_inf(a, walk_self_member(l->body, member));
-        }
-        case NODE_WHILE_STMT: {
-            WhileStmtNode *w = (WhileStmtNode*)n;
-            return join_inf(walk_self_member(w->condition, member),
-                             walk_self_member(w->body, member));
-        }
-        case NODE_DESTRUCT_ASSIGN:
-            return walk_self_member(((DestructAssignNode*)n)->value, member);
-        case NODE_ASSIGN:
-            return walk_self_member(((AssignNode*)n)->value, member);
-        case NODE_CONCAT_EXPR: {
-            ConcatExprNode *ce = (ConcatExprNode*)n;
-            InferTag here = INF_NONE;
-            if (is_self_dot(ce->left, member) ||
-                is_self_dot(ce->right, member))
-                here = INF_STRING;
-            return join_inf(here,
-                join_inf(walk_self_member(ce->left, member),
-                          walk_self_member(ce->right, member)));
-        }
-        default: return INF_NONE;
-    }
-}
-
 HulkType* sem_infer_self_member_type(SemanticContext *c, const char *member,
                                       TypeDefNode *td) {
     if (!member || !td) return NULL;
-    InferTag agg = INF_NONE;
+    HulkUseTag agg = HULK_USE_NONE;
     for (int i = 0; i < td->members.count; i++) {
         HulkNode *m = td->members.items[i];
         if (m->type != NODE_METHOD_DEF) continue;
-        agg = join_inf(agg, walk_self_member(
-            ((MethodDefNode*)m)->body, member));
-    }
-    switch (agg) {
-        case INF_NUMBER:  return c->t_number;
-        case INF_BOOLEAN: return c->t_boolean;
-        case INF_STRING:  return c->t_string;
-        default:          return NULL;
+        const HulkNameFacts *f = hulk_facts_name(
+            &c->facts, ((MethodDefNode*)m)->body, member);
+        if (f) agg = hulk_use_join(agg, (HulkUseTag)f->self_operand);
     }
+    return tag_to_type(c, agg);
 }
 
 /* Detecta si el ident `name` aparece como callee en el body — i.e., si
- * la función es recursiva. Walker sintáctico simple. */
-int sem_body_calls_name(HulkNode *n, const char *name) {
-    if (!n || !name) return 0;
-    switch (n->type) {
-        case NODE_CALL_EXPR: {
-            CallExprNode *ce = (CallExprNode*)n;
-            if (ce->callee && ce->callee->type == NODE_IDENT) {
-                IdentNode *idn = (IdentNode*)ce->callee;
-                if (idn->name && strcmp(idn->name, name) == 0) return 1;
-            }
-            if (sem_body_calls_name(ce->callee, name)) return 1;
-            for (int i = 0; i < ce->args.count; i++)
-                if (sem_body_calls_name(ce->args.items[i], name)) return 1;
-            return 0;
-        }
-        case NODE_BINARY_OP: {
-            BinaryOpNode *b = (BinaryOpNode*)n;
-            return sem_body_calls_name(b->left, name) ||
-                   sem_body_calls_name(b->right, name);
-        }
-        case NODE_UNARY_OP:
-            return sem_body_calls_name(((UnaryOpNode*)n)->operand, name);
-        case NODE_IF_EXPR: {
-            IfExprNode *iff = (IfExprNode*)n;
-            if (sem_body_calls_name(iff->condition, name)) return 1;
-            if (sem_body_calls_name(iff->then_body, name)) return 1;
-            for (int i = 0; i < iff->elifs.count; i++) {
-                ElifBranchNode *e = (ElifBranchNode*)iff->elifs.items[i];
-                if (sem_body_calls_name(e->condition, name)) return 1;
-                if (sem_body_calls_name(e->body, name)) return 1;
-            }
-            return sem_body_calls_name(iff->else_body, name);
-        }
-        case NODE_WHILE_STMT: {
-            WhileStmtNode *w = (WhileStmtNode*)n;
-            return sem_body_calls_name(w->condition, name) ||
-                   sem_body_calls_name(w->body, name);
-        }
-        case NODE_FOR_STMT: {
-            ForStmtNode *f = (ForStmtNode*)n;
-            return sem_body_calls_name(f->iterable, name) ||
-                   sem_body_calls_name(f->body, name);
-        }
-        case NODE_BLOCK_STMT: {
-            BlockStmtNode *b = (BlockStmtNode*)n;
-            for (int i = 0; i < b->statements.count; i++)
-                if (sem_body_calls_name(b->statements.items[i], name)) return 1;
-            return 0;
-        }
-        case NODE_LET_EXPR: {
-            LetExprNode *l = (LetExprNode*)n;
-            for (int i = 0; i < l->bindings.count; i++) {
-                VarBindingNode *vb = (VarBindingNode*)l->bindings.items[i];
-                if (sem_body_calls_name(vb->init_expr, name)) return 1;
-            }
-            return sem_body_calls_name(l->body, name);
-        }
-        case NODE_ASSIGN:
-            return sem_body_calls_name(((AssignNode*)n)->value, name);
-        case NODE_DESTRUCT_ASSIGN:
-            return sem_body_calls_name(((DestructAssignNode*)n)->value, name);
-        case NODE_CONCAT_EXPR: {
-            ConcatExprNode *ce = (ConcatExprNode*)n;
-            return sem_body_calls_name(ce->left, name) ||
-                   sem_body_calls_name(ce->right, name);
-        }
-        default: return 0;
-    }
+ * la función es recursiva. */
+int sem_body_calls_name(SemanticContext *c, HulkNode *body, const char *name) {
+    if (!body || !name) return 0;
+    const HulkNameFacts *f = hulk_facts_name(&c->facts, body, name);
+    return f && f->called;
 }
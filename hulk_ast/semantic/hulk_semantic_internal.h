@@ -12,6 +12,9 @@
 #define HULK_SEMANTIC_INTERNAL_H
 
 #include "../core/hulk_ast.h"
+#include "../core/hulk_ast_facts.h"
+#include "../core/hulk_name_index.h"
+#include "../core/hulk_ast_side.h"
 #include "hulk_semantic.h"
 #include "../../error_handler.h"
 
@@ -47,6 +50,16 @@ struct HulkType_s {
     int          param_count;
     HulkType    *return_type;
     int          is_protocol; // 1 si proviene de `protocol`
+    int          id;          // posición en SemanticContext.types
+    unsigned char array_like; // nombre "T[]"
+    unsigned char iter_like;  // nombre "T*"
+    /* Intervalo DFS en la jerarquía (sem_types_index_hierarchy); 0 si
+     * el tipo se creó después y hay que recorrer la cadena de padres. */
+    int          pre, post;
+    HulkType    *element;     // vectores: tipo de los elementos
+    HulkType    *vector_of;   // vector canónico "T[]" de este tipo, si existe
+    HulkNameIndex conform_memo; // hijo → 0/1 (conformance estructural)
+    HulkNameIndex join_memo;    // otro → id del join
 };
 
 /* ============================================================
@@ -70,6 +83,12 @@ typedef struct {
     HulkType   **param_types;   // para func/method
     const char **param_names;   // para func/method
     int          param_count;
+    /* Pase 3 en paralelo: unidad + 1 que fija el retorno inferido (o la
+     * firma decorada) de este símbolo, 0 si ninguna; las unidades
+     * anteriores ven los valores de antes del pase 3 */
+    int          publish_at;
+    HulkType    *early_type;
+    HulkType    *early_callable;
 } Symbol;
 
 /* ============================================================
@@ -77,16 +96,34 @@ typedef struct {
  * ============================================================ */
 
 struct Scope_s {
-    Scope   *parent;
+    Scope   *parent;     // en la lista de libres: el siguiente libre
     Symbol **symbols;
     int      sym_count;
     int      sym_cap;
+    HulkNameIndex index;  // nombre → posición en symbols (scopes grandes)
+    Scope   *next;       // siguiente creado por el mismo contexto
 };
 
 /* ============================================================
  *  Contexto Semántico
  * ============================================================ */
 
+typedef struct SemParallel_s SemParallel;
+
+/* Diagnóstico guardado en vez de escrito: el pase 3 en paralelo los
+ * emite al final en orden de unidad y el análisis incremental los
+ * conserva entre corridas. */
+typedef struct {
+    int   line, col;
+    char *msg;
+} SemDiag;
+
+typedef struct {
+    SemDiag *items;
+    int      count;
+    int      cap;
+} SemDiagList;
+
 typedef struct {
     HulkASTContext *ast_ctx;     // arena para nodos nuevos (desugaring)
     Scope          *current;    // scope actual
@@ -104,17 +141,42 @@ typedef struct {
     HulkType **types;
     int        type_count;
     int        type_cap;
-
-    /* Registro de scopes (para cleanup) */
-    Scope    **all_scopes;
-    int        scope_count;
-    int        scope_cap;
+    HulkNameIndex type_index;   // nombre → posición en types
+    /* Tipos función canónicos (hash-consing por firma): dos firmas
+     * iguales son el mismo HulkType, así que se comparan por puntero */
+    HulkType **fn_types;        // direccionamiento abierto, NULL = libre
+    int        fn_type_cap;
+    int        fn_type_count;
+
+    /* Arena de la fase: tipos, scopes, símbolos y sus arreglos se
+     * liberan juntos en sem_context_free. Los scopes de bloque cerrados
+     * vuelven a `free_scopes` y el próximo sem_push_scope los reusa. */
+    HulkASTContext arena;
+    Scope     *scopes;          // creados (sus índices se liberan aparte)
+    Scope     *free_scopes;
+    int        scope_count;     // creados, sin contar los reusados
 
     /* Estado durante verificación */
     HulkType  *enclosing_type;  // tipo actual (para self)
     FunctionExprNode *capture_target;
     Scope      *capture_scope;
     int        error_count;
+
+    /* Hechos sintácticos por cuerpo (una pasada por cuerpo, a pedido)
+     * que consultan las heurísticas de hulk_semantic_infer.c */
+    HulkFacts  facts;
+
+    /* Tipos inferidos de los parámetros sin anotación de funciones y
+     * métodos (VarBindingNode → HulkType*), de sem_unify_params */
+    HulkSideTable param_types;
+
+    /* Pase 3 en paralelo (hulk_semantic_parallel.c): estado compartido y
+     * unidad que verifica este contexto de hilo; NULL en serie */
+    SemParallel *par;
+    int          unit;
+
+    /* Si no es NULL, sem_error guarda ahí en vez de escribir stderr */
+    SemDiagList *diags;
 } SemanticContext;
 
 /* ============================================================
@@ -122,6 +184,9 @@ typedef struct {
  * ============================================================ */
 
 Scope*  sem_scope_create(SemanticContext *ctx, Scope *parent);
+/* Libera los índices de los scopes creados por ctx; la memoria de
+ * scopes y símbolos es de la arena. */
+void    sem_scopes_free(SemanticContext *ctx);
 Symbol* sem_define(SemanticContext *ctx, const char *name,
                    SymbolKind kind, HulkType *type, HulkNode *decl);
 Symbol* sem_define_in(SemanticContext *ctx, Scope *scope, const char *name,
@@ -129,6 +194,12 @@ Symbol* sem_define_in(SemanticContext *ctx, Scope *scope, const char *name,
 Symbol* sem_lookup(Scope *scope, const char *name);
 Symbol* sem_lookup_local(Scope *scope, const char *name);
 Symbol* sem_lookup_member(HulkType *type, const char *name);
+/* Busca el nombre de `n` desde el scope actual y anota n->binding.
+ * Dentro de una lambda, una variable externa es captura; si todavía no
+ * está en su lista, se agrega solo con `add_capture` (si no, queda sin
+ * resolver y codegen la busca por nombre). NULL si no está definido. */
+Symbol* sem_resolve_ident(SemanticContext *ctx, IdentNode *n,
+                          int add_capture);
 void    sem_push_scope(SemanticContext *ctx);
 void    sem_pop_scope(SemanticContext *ctx);
 
@@ -137,21 +208,37 @@ void    sem_pop_scope(SemanticContext *ctx);
  * ============================================================ */
 
 void sem_error(SemanticContext *ctx, HulkNode *node, const char *fmt, ...);
+void sem_diags_add(SemDiagList *l, int line, int col, const char *msg);
+/* Escribe los diagnósticos de `l` corriendo cada línea `line_offset`. */
+void sem_diags_emit(const SemDiagList *l, int line_offset);
+void sem_diags_free(SemDiagList *l);
+
+/* Bloque en cero de la arena de la fase; vive hasta sem_context_free. */
+static inline void* sem_alloc(SemanticContext *ctx, size_t size) {
+    return hulk_ast_alloc(&ctx->arena, size);
+}
 
 /* ============================================================
  *  Tipos  (hulk_semantic_types.c)
  * ============================================================ */
 
+/* Contexto vacío con scope global, arena y tipos/funciones built-in. */
+void      sem_context_init(SemanticContext *ctx, HulkASTContext *ast_ctx);
 void      sem_types_init(SemanticContext *ctx);
 void      sem_context_free(SemanticContext *ctx);
 HulkType* sem_type_new(SemanticContext *ctx, HulkTypeKind kind,
                         const char *name, HulkType *parent);
 int       sem_type_conforms(HulkType *child, HulkType *ancestor);
+void      sem_types_index_hierarchy(SemanticContext *ctx);
 HulkType* sem_type_join(SemanticContext *ctx, HulkType *a, HulkType *b);
 HulkType* sem_type_resolve(SemanticContext *ctx, const char *name);
+/* Tipo función canónico para la firma: no crea uno nuevo si ya existe.
+ * Los tipos devueltos son compartidos y no deben modificarse. */
 HulkType* sem_function_type_new(SemanticContext *ctx, HulkType **params,
                                 int param_count, HulkType *ret);
 int       sem_function_type_equals(HulkType *a, HulkType *b);
+// Vector canónico "elem[]".
+HulkType* sem_vector_type(SemanticContext *ctx, HulkType *elem);
 HulkType* sem_resolve_annotation(SemanticContext *c,
                                  const char *annotation,
                                  HulkNode *err_node);
@@ -172,17 +259,26 @@ HulkType* sem_infer_param_type(SemanticContext *c, const char *param_name,
 HulkType* sem_infer_self_member_type(SemanticContext *c, const char *member,
                                       TypeDefNode *td);
 
+/* Infiere juntos los parámetros sin anotación de funciones globales y
+ * métodos, resolviendo restricciones de uso, alias y llamadas con
+ * union-find (hulk_semantic_unify.c). Deja el resultado en
+ * c->param_types. */
+void sem_unify_params(SemanticContext *c, ProgramNode *prog);
+
 /* Detecta si una función es recursiva (su nombre aparece como callee en
  * el body). Usado para el default del tipo de retorno. */
-int sem_body_calls_name(HulkNode *n, const char *name);
+int sem_body_calls_name(SemanticContext *c, HulkNode *body, const char *name);
 
-/* Helper: resuelve type_annotation; si no hay, intenta inferir vía
- * sem_infer_param_type, y si tampoco, defaultea a Object. */
+/* Helper: resuelve type_annotation; si no hay, usa lo que resolvió
+ * sem_unify_params o (lambdas) intenta sem_infer_param_type, y si
+ * tampoco, defaultea a Object. */
 static inline HulkType* sem_param_annotation_for(SemanticContext *c,
                                                   VarBindingNode *p,
                                                   HulkNode *body) {
     if (p->type_annotation)
         return sem_resolve_annotation(c, p->type_annotation, (HulkNode*)p);
+    HulkType **solved = hulk_side_get(&c->param_types, (HulkNode*)p);
+    if (solved && *solved) return *solved;
     if (body) {
         HulkType *inferred = sem_infer_param_type(c, p->name, body);
         if (inferred) return inferred;
@@ -194,7 +290,9 @@ static inline HulkType* sem_param_annotation_for(SemanticContext *c,
  *  Verificación  (hulk_semantic_check.c / check_expr.c)
  * ============================================================ */
 
-void      sem_check_program(SemanticContext *ctx, HulkNode *program);
+/* `workers`: como en hulk_semantic_analyze_workers. */
+void      sem_check_program(SemanticContext *ctx, HulkNode *program,
+                            int workers);
 HulkType* sem_check_expr(SemanticContext *ctx, HulkNode *node);
 
 /* Recolección de símbolos, pases 1-2  (hulk_semantic_collect.c) */
@@ -215,10 +313,56 @@ HulkType* sem_check_is(SemanticContext *c, IsExprNode *n);
 HulkType* sem_check_self(SemanticContext *c, SelfNode *n);
 HulkType* sem_check_base(SemanticContext *c, BaseCallNode *n);
 
+/* Una unidad del pase 3: la declaración `decl` entera o, si es un tipo,
+ * solo su miembro `member` (-1 para funciones y expresiones). */
+void      sem_check_unit(SemanticContext *c, HulkNode *decl, int member);
+
+/* ============================================================
+ *  Pase 3 en paralelo  (hulk_semantic_parallel.c)
+ * ============================================================ */
+
+/* Verifica los cuerpos de `prog` repartidos entre `workers` hilos (<= 0:
+ * uno por CPU, si hay al menos HULK_SEMANTIC_PARALLEL_MIN_UNITS
+ * unidades). Diagnósticos y error_count quedan como en serie. Retorna 0
+ * si no reparte: el caller verifica en serie. */
+int       sem_check_parallel(SemanticContext *c, ProgramNode *prog,
+                             int workers);
+/* Acceso a recursos compartidos entre hilos (no-op en serie). */
+void      sem_parallel_lock(SemanticContext *c);
+void      sem_parallel_unlock(SemanticContext *c);
+/* Contexto dueño del registro de tipos: el propio en serie; en un hilo,
+ * el principal, con el candado tomado hasta sem_parallel_unlock. */
+SemanticContext* sem_parallel_registry(SemanticContext *c);
+HulkType* sem_parallel_symbol(SemanticContext *c, Symbol *s, int callable);
+
+/* Tipo (retorno para func/method) y firma de un símbolo vistos desde la
+ * unidad que se verifica: en paralelo, lo que vería en serie. */
+static inline HulkType* sem_sym_type(SemanticContext *c, Symbol *s) {
+    return s->publish_at && c->par ? sem_parallel_symbol(c, s, 0) : s->type;
+}
+
+static inline HulkType* sem_sym_callable(SemanticContext *c, Symbol *s) {
+    return s->publish_at && c->par ? sem_parallel_symbol(c, s, 1)
+                                   : s->callable_type;
+}
+
 /* ============================================================
  *  Desugaring  (hulk_semantic_desugar.c)
  * ============================================================ */
 
 void sem_desugar(SemanticContext *ctx, HulkNode *program);
 
+/* ============================================================
+ *  Genéricos  (hulk_semantic_generics.c)
+ * ============================================================ */
+
+/* Cadena máxima de instancias pedidas por otras: corta plantillas que
+ * se instancian con tipos cada vez más grandes (List<T> que usa
+ * List<List<T>>). */
+#define HULK_GENERIC_MAX_DEPTH 64
+
+/* Reemplaza cada plantilla por sus instancias usadas. Devuelve 1 si el
+ * programa tenía genéricos. */
+int  sem_monomorphize(SemanticContext *ctx, HulkNode *program);
+
 #endif /* HULK_SEMANTIC_INTERNAL_H */
@@ -0,0 +1,267 @@
+/*
+ * hulk_semantic_parallel.c — Pase 3 repartido entre hilos
+ *
+ * Tras los pases 1-2 el entorno global queda fijo salvo por una cosa: al
+ * verificar una función o un método sin tipo de retorno se le fija el
+ * retorno inferido a su símbolo (y a un método decorado, su firma), y las
+ * verificaciones siguientes ven ese valor. El pase se corta en unidades
+ * en orden de fuente (cada función, cada miembro de un tipo, cada
+ * expresión global) y los hilos las toman en ese orden. Un símbolo que
+ * publica otra unidad se lee como en serie: con el valor previo si esa
+ * unidad viene después, o esperando a que termine si vino antes. Solo se
+ * espera a unidades anteriores, ya tomadas por algún hilo: no hay
+ * interbloqueo.
+ *
+ * Cada hilo verifica con su propio contexto: sus scopes y símbolos (en
+ * una arena propia que se libera al terminar), sus hechos por cuerpo y
+ * su estado de verificación. Los diagnósticos quedan guardados por
+ * unidad y se emiten al final en orden de unidad, el mismo que en serie.
+ * El registro de tipos y la arena del AST son del contexto principal y
+ * se tocan bajo un candado.
+ *
+ * SRP: solo reparto y sincronización; la verificación es la de
+ * hulk_semantic_check.c.
+ */
+
+#include "hulk_semantic_internal.h"
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    HulkNode   *decl;
+    int         member;     // -1: la declaración entera
+    int         done;       // bajo SemParallel.progress
+    SemDiagList diags;      // solo los escribe el hilo de la unidad
+} SemUnit;
+
+struct SemParallel_s {
+    SemanticContext *main;
+    SemUnit         *units;
+    int              unit_count;
+    int              next;       // próxima unidad a tomar
+    pthread_mutex_t  lock;       // registro de tipos y arena del AST
+    pthread_mutex_t  progress;   // next y done
+    pthread_cond_t   finished;   // alguna unidad terminó
+};
+
+typedef struct {
+    SemParallel     *par;
+    SemanticContext  ctx;
+    pthread_t        thread;
+    int              spawned;
+} SemWorker;
+
+/* ============================================================
+ *  Plan: unidades y símbolos que publican
+ * ============================================================ */
+
+static int plan_units(ProgramNode *prog, SemUnit **out) {
+    int n = 0;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *d = prog->declarations.items[i];
+        n += d->type == NODE_TYPE_DEF ? ((TypeDefNode*)d)->members.count : 1;
+    }
+    SemUnit *u = calloc(n ? (size_t)n : 1, sizeof(SemUnit));
+    *out = u;
+    if (!u) return 0;
+    int k = 0;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *d = prog->declarations.items[i];
+        if (d->type != NODE_TYPE_DEF) {
+            u[k].decl = d;
+            u[k++].member = -1;
+            continue;
+        }
+        for (int m = 0; m < ((TypeDefNode*)d)->members.count; m++) {
+            u[k].decl = d;
+            u[k++].member = m;
+        }
+    }
+    return n;
+}
+
+/* El símbolo al que la unidad le fija retorno o firma (las mismas
+ * búsquedas que hace check_function_def / check_member), o NULL. */
+static Symbol* unit_publishes(SemanticContext *c, const SemUnit *u) {
+    if (u->decl->type == NODE_FUNCTION_DEF) {
+        FunctionDefNode *fn = (FunctionDefNode*)u->decl;
+        return fn->return_type ? NULL : sem_lookup(c->global, fn->name);
+    }
+    if (u->member < 0) return NULL;
+    TypeDefNode *td = (TypeDefNode*)u->decl;
+    HulkNode *m = td->members.items[u->member];
+    if (td->is_protocol || m->type != NODE_METHOD_DEF) return NULL;
+    MethodDefNode *md = (MethodDefNode*)m;
+    if (md->return_type && md->decorators.count == 0) return NULL;
+    HulkType *type = sem_type_resolve(c, td->name);
+    return type ? sem_lookup_member(type, md->name) : NULL;
+}
+
+/* Marca los símbolos publicados con su unidad y guarda el valor previo.
+ * Retorna 0 si dos unidades publican el mismo símbolo (declaraciones
+ * repetidas): el orden entre ellas solo lo respeta la serie. */
+static int mark_publishers(SemParallel *par, Symbol ***marked, int *count) {
+    *marked = NULL;
+    *count = 0;
+    int cap = 0;
+    for (int i = 0; i < par->unit_count; i++) {
+        Symbol *s = unit_publishes(par->main, &par->units[i]);
+        if (!s) continue;
+        if (s->publish_at) return 0;
+        if (*count >= cap) {
+            cap = cap ? cap * 2 : 64;
+            Symbol **tmp = realloc(*marked, sizeof(Symbol*) * (size_t)cap);
+            if (!tmp) return 0;
+            *marked = tmp;
+        }
+        (*marked)[(*count)++] = s;
+        s->publish_at = i + 1;
+        s->early_type = s->type;
+        s->early_callable = s->callable_type;
+    }
+    return 1;
+}
+
+static void unmark_publishers(Symbol **marked, int count) {
+    for (int i = 0; i < count; i++) {
+        marked[i]->publish_at = 0;
+        marked[i]->early_type = NULL;
+        marked[i]->early_callable = NULL;
+    }
+    free(marked);
+}
+
+/* ============================================================
+ *  Hilos
+ * ============================================================ */
+
+static void* run_worker(void *arg) {
+    SemWorker *w = arg;
+    SemParallel *par = w->par;
+    for (;;) {
+        pthread_mutex_lock(&par->progress);
+        int u = par->next < par->unit_count ? par->next++ : -1;
+        pthread_mutex_unlock(&par->progress);
+        if (u < 0) break;
+
+        w->ctx.unit = u;
+        w->ctx.diags = &par->units[u].diags;
+        sem_check_unit(&w->ctx, par->units[u].decl, par->units[u].member);
+
+        pthread_mutex_lock(&par->progress);
+        par->units[u].done = 1;
+        pthread_cond_broadcast(&par->finished);
+        pthread_mutex_unlock(&par->progress);
+    }
+    return NULL;
+}
+
+static void worker_init(SemWorker *w, SemParallel *par) {
+    w->par = par;
+    w->ctx = *par->main;             /* global, tipos built-in, param_types */
+    w->ctx.current = w->ctx.global;
+    hulk_ast_context_init(&w->ctx.arena);   /* scopes y símbolos del hilo */
+    w->ctx.scopes = w->ctx.free_scopes = NULL;
+    w->ctx.scope_count = 0;
+    w->ctx.enclosing_type = NULL;
+    w->ctx.capture_target = NULL;
+    w->ctx.capture_scope = NULL;
+    w->ctx.error_count = 0;
+    hulk_facts_init(&w->ctx.facts);
+    w->ctx.par = par;
+    w->ctx.unit = -1;
+}
+
+static void worker_free(SemWorker *w) {
+    sem_scopes_free(&w->ctx);
+    hulk_facts_free(&w->ctx.facts);
+    hulk_ast_context_free(&w->ctx.arena);
+}
+
+int sem_check_parallel(SemanticContext *c, ProgramNode *prog, int workers) {
+    int automatic = workers <= 0;
+    if (automatic) workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers > HULK_SEMANTIC_MAX_WORKERS) workers = HULK_SEMANTIC_MAX_WORKERS;
+    if (workers < 2) return 0;
+
+    SemParallel par;
+    memset(&par, 0, sizeof(par));
+    par.main = c;
+    par.unit_count = plan_units(prog, &par.units);
+    if (!par.units ||
+        (automatic && par.unit_count < HULK_SEMANTIC_PARALLEL_MIN_UNITS)) {
+        free(par.units);
+        return 0;
+    }
+    if (workers > par.unit_count) workers = par.unit_count;
+
+    Symbol **marked = NULL;
+    int marked_count = 0;
+    if (workers < 2 || !mark_publishers(&par, &marked, &marked_count)) {
+        unmark_publishers(marked, marked_count);
+        free(par.units);
+        return 0;
+    }
+
+    pthread_mutex_init(&par.lock, NULL);
+    pthread_mutex_init(&par.progress, NULL);
+    pthread_cond_init(&par.finished, NULL);
+
+    SemWorker pool[HULK_SEMANTIC_MAX_WORKERS];
+    for (int k = 0; k < workers; k++) worker_init(&pool[k], &par);
+    for (int k = 1; k < workers; k++)
+        pool[k].spawned =
+            pthread_create(&pool[k].thread, NULL, run_worker, &pool[k]) == 0;
+    run_worker(&pool[0]);   /* sin hilo: las unidades las toman los demás */
+    for (int k = 1; k < workers; k++)
+        if (pool[k].spawned) pthread_join(pool[k].thread, NULL);
+
+    for (int k = 0; k < workers; k++) {
+        c->error_count += pool[k].ctx.error_count;
+        worker_free(&pool[k]);
+    }
+    unmark_publishers(marked, marked_count);
+
+    /* Diagnósticos en orden de unidad, como los habría emitido la serie */
+    for (int i = 0; i < par.unit_count; i++) {
+        sem_diags_emit(&par.units[i].diags, 0);
+        sem_diags_free(&par.units[i].diags);
+    }
+    free(par.units);
+    pthread_cond_destroy(&par.finished);
+    pthread_mutex_destroy(&par.progress);
+    pthread_mutex_destroy(&par.lock);
+    return 1;
+}
+
+/* ============================================================
+ *  Servicios para la verificación desde un hilo
+ * ============================================================ */
+
+void sem_parallel_lock(SemanticContext *c) {
+    if (c->par) pthread_mutex_lock(&c->par->lock);
+}
+
+void sem_parallel_unlock(SemanticContext *c) {
+    if (c->par) pthread_mutex_unlock(&c->par->lock);
+}
+
+SemanticContext* sem_parallel_registry(SemanticContext *c) {
+    if (!c->par) return c;
+    pthread_mutex_lock(&c->par->lock);
+    return c->par->main;
+}
+
+HulkType* sem_parallel_symbol(SemanticContext *c, Symbol *s, int callable) {
+    int at = s->publish_at - 1;
+    if (c->unit < at)
+        return callable ? s->early_callable : s->early_type;
+    if (c->unit > at) {
+        SemParallel *par = c->par;
+        pthread_mutex_lock(&par->progress);
+        while (!par->units[at].done)
+            pthread_cond_wait(&par->finished, &par->progress);
+        pthread_mutex_unlock(&par->progress);
+    }
+    return callable ? s->callable_type : s->type;
+}
@@ -12,36 +12,74 @@
  * ============================================================ */
 
 Scope* sem_scope_create(SemanticContext *ctx, Scope *parent) {
-    Scope *s = calloc(1, sizeof(Scope));
-    if (!s) return NULL;
-    s->parent = parent;
-
-    /* Registrar para cleanup al final del análisis */
-    if (ctx->scope_count >= ctx->scope_cap) {
-        int nc = ctx->scope_cap == 0 ? 16 : ctx->scope_cap * 2;
-        Scope **tmp = realloc(ctx->all_scopes, sizeof(Scope*) * nc);
-        if (!tmp) { free(s); return NULL; }
-        ctx->all_scopes = tmp;
-        ctx->scope_cap = nc;
+    Scope *s = ctx->free_scopes;
+    if (s) {
+        /* Reusado: conserva su arreglo de símbolos (y su capacidad) */
+        ctx->free_scopes = s->parent;
+        s->sym_count = 0;
+    } else {
+        s = sem_alloc(ctx, sizeof(Scope));
+        if (!s) return NULL;
+        s->next = ctx->scopes;
+        ctx->scopes = s;
+        ctx->scope_count++;
     }
-    ctx->all_scopes[ctx->scope_count++] = s;
+    s->parent = parent;
     return s;
 }
 
+/* Scope de bloque cerrado: nadie guarda punteros a él ni a sus símbolos
+ * más allá del bloque, así que vuelve a la lista de libres. */
+static void scope_recycle(SemanticContext *ctx, Scope *s) {
+    hulk_name_index_free(&s->index);
+    s->parent = ctx->free_scopes;
+    ctx->free_scopes = s;
+}
+
+void sem_scopes_free(SemanticContext *ctx) {
+    for (Scope *s = ctx->scopes; s; s = s->next)
+        hulk_name_index_free(&s->index);
+    ctx->scopes = ctx->free_scopes = NULL;
+    ctx->scope_count = 0;
+}
+
 /* ============================================================
  *  Definición de símbolos
  * ============================================================ */
 
+/* Búsqueda por identidad: los nombres de los símbolos están internados
+ * y `key` también debe estarlo. Los scopes chicos se recorren; los que
+ * pasan de HULK_NAME_INDEX_MIN símbolos (global, tipos anchos) van por
+ * su índice hash. */
+static Symbol* find_local(Scope *scope, const char *key) {
+    if (scope->index.cap) {
+        int i = hulk_name_index_find(&scope->index, key);
+        return i >= 0 ? scope->symbols[i] : NULL;
+    }
+    for (int i = 0; i < scope->sym_count; i++)
+        if (scope->symbols[i]->name == key)
+            return scope->symbols[i];
+    return NULL;
+}
+
+/* Clave de reintento cuando la búsqueda por puntero falló: la forma
+ * internada de `name` si difiere (el caller pasó una copia, p.ej. un
+ * buffer armado con snprintf), o NULL si no hay nada más que probar. */
+static const char* retry_key(const char *name) {
+    const char *key = hulk_intern_find(name);
+    return key != name ? key : NULL;
+}
+
 /* Define un símbolo en un scope específico */
 Symbol* sem_define_in(SemanticContext *ctx, Scope *scope, const char *name,
                       SymbolKind kind, HulkType *type, HulkNode *decl) {
-    (void)ctx; /* reservado para futuras extensiones */
     if (!scope || !name) return NULL;
+    name = hulk_intern(name);
 
     /* Verificar redefinición en el mismo scope */
-    if (sem_lookup_local(scope, name)) return NULL;
+    if (find_local(scope, name)) return NULL;
 
-    Symbol *sym = calloc(1, sizeof(Symbol));
+    Symbol *sym = sem_alloc(ctx, sizeof(Symbol));
     if (!sym) return NULL;
     sym->name      = name;
     sym->kind      = kind;
@@ -49,13 +87,24 @@ Symbol* sem_define_in(SemanticContext *ctx, Scope *scope, const char *name,
     sym->decl_node = decl;
 
     if (scope->sym_count >= scope->sym_cap) {
+        /* El arreglo viejo queda en la arena: crecer al doble acota el
+         * desperdicio al tamaño final */
         int nc = scope->sym_cap == 0 ? 8 : scope->sym_cap * 2;
-        Symbol **tmp = realloc(scope->symbols, sizeof(Symbol*) * nc);
-        if (!tmp) { free(sym); return NULL; }
+        Symbol **tmp = sem_alloc(ctx, sizeof(Symbol*) * nc);
+        if (!tmp) return NULL;
+        if (scope->sym_count > 0)
+            memcpy(tmp, scope->symbols, sizeof(Symbol*) * scope->sym_count);
         scope->symbols = tmp;
         scope->sym_cap = nc;
     }
     scope->symbols[scope->sym_count++] = sym;
+
+    /* Al pasar el umbral se indexa todo lo anterior; después, cada nuevo */
+    if (scope->sym_count > HULK_NAME_INDEX_MIN) {
+        int from = scope->index.cap ? scope->sym_count - 1 : 0;
+        for (int i = from; i < scope->sym_count; i++)
+            hulk_name_index_add(&scope->index, scope->symbols[i]->name, i);
+    }
     return sym;
 }
 
@@ -69,36 +118,114 @@ Symbol* sem_define(SemanticContext *ctx, const char *name,
  *  Búsqueda de símbolos
  * ============================================================ */
 
+/* Los nombres AST ya llegan internados: la primera pasada compara
+ * punteros y casi siempre acierta; solo ante un fallo se busca la forma
+ * internada de la clave (sin hashear en el camino común). */
+
 Symbol* sem_lookup_local(Scope *scope, const char *name) {
     if (!scope || !name) return NULL;
-    for (int i = 0; i < scope->sym_count; i++) {
-        if (scope->symbols[i]->name &&
-            strcmp(scope->symbols[i]->name, name) == 0)
-            return scope->symbols[i];
-    }
-    return NULL;
+    Symbol *sym = find_local(scope, name);
+    if (sym) return sym;
+    const char *key = retry_key(name);
+    return key ? find_local(scope, key) : NULL;
 }
 
-Symbol* sem_lookup(Scope *scope, const char *name) {
+static Symbol* find_chain(Scope *scope, const char *key) {
     for (Scope *s = scope; s; s = s->parent) {
-        Symbol *sym = sem_lookup_local(s, name);
+        Symbol *sym = find_local(s, key);
         if (sym) return sym;
     }
     return NULL;
 }
 
-/* Lookup un miembro caminando la cadena de herencia del tipo */
-Symbol* sem_lookup_member(HulkType *type, const char *name) {
+Symbol* sem_lookup(Scope *scope, const char *name) {
     if (!name) return NULL;
+    Symbol *sym = find_chain(scope, name);
+    if (sym) return sym;
+    const char *key = retry_key(name);
+    return key ? find_chain(scope, key) : NULL;
+}
+
+static Symbol* find_member(HulkType *type, const char *key) {
     for (HulkType *t = type; t; t = t->parent) {
         if (t->members) {
-            Symbol *sym = sem_lookup_local(t->members, name);
+            Symbol *sym = find_local(t->members, key);
             if (sym) return sym;
         }
     }
     return NULL;
 }
 
+/* Lookup un miembro caminando la cadena de herencia del tipo */
+Symbol* sem_lookup_member(HulkType *type, const char *name) {
+    if (!name) return NULL;
+    Symbol *sym = find_member(type, name);
+    if (sym) return sym;
+    const char *key = retry_key(name);
+    return key ? find_member(type, key) : NULL;
+}
+
+/* ============================================================
+ *  Resolución de usos de nombres
+ * ============================================================ */
+
+static int capture_index(FunctionExprNode *fn, const char *name) {
+    for (int i = 0; i < fn->captures.count; i++)
+        if (((IdentNode*)fn->captures.items[i])->name == name)  /* internados */
+            return i;
+    return -1;
+}
+
+Symbol* sem_resolve_ident(SemanticContext *ctx, IdentNode *n,
+                          int add_capture) {
+    Symbol *sym = NULL;
+    Scope *found_scope = NULL;
+    for (Scope *s = ctx->current; s; s = s->parent) {
+        sym = sem_lookup_local(s, n->name);
+        if (sym) {
+            found_scope = s;
+            break;
+        }
+    }
+    memset(&n->binding, 0, sizeof(n->binding));
+    if (!sym) return NULL;
+
+    /* ¿Está fuera de la lambda que se está verificando? */
+    int outside = 0;
+    if (ctx->capture_target && ctx->capture_scope) {
+        outside = 1;
+        for (Scope *s = ctx->current; s; s = s->parent) {
+            if (s == found_scope) { outside = 0; break; }
+            if (s == ctx->capture_scope) break;
+        }
+    }
+
+    if (outside && sym->kind == SYM_VARIABLE) {
+        FunctionExprNode *fn = ctx->capture_target;
+        int slot = capture_index(fn, n->name);
+        if (slot < 0 && add_capture) {
+            sem_parallel_lock(ctx);   /* la arena del AST es compartida */
+            hulk_node_list_push(&fn->captures,
+                (HulkNode*)hulk_ast_ident(ctx->ast_ctx, n->name,
+                                          n->base.line, n->base.col));
+            sem_parallel_unlock(ctx);
+            slot = fn->captures.count - 1;
+        }
+        if (slot >= 0) {
+            n->binding.kind = HULK_BIND_CAPTURE;
+            n->binding.slot = slot;
+            n->binding.decl = sym->decl_node;
+        }
+    } else if (found_scope == ctx->global) {
+        n->binding.kind = HULK_BIND_GLOBAL;
+        n->binding.decl = sym->decl_node;
+    } else if (sym->decl_node) {
+        n->binding.kind = HULK_BIND_LOCAL;
+        n->binding.decl = sym->decl_node;
+    }
+    return sym;
+}
+
 /* ============================================================
  *  Push / Pop de scopes
  * ============================================================ */
@@ -108,8 +235,10 @@ void sem_push_scope(SemanticContext *ctx) {
 }
 
 void sem_pop_scope(SemanticContext *ctx) {
-    if (ctx->current && ctx->current->parent)
-        ctx->current = ctx->current->parent;
+    Scope *s = ctx->current;
+    if (!s || !s->parent) return;
+    ctx->current = s->parent;
+    scope_recycle(ctx, s);
 }
 
 /* ============================================================
@@ -126,5 +255,36 @@ void sem_error(SemanticContext *ctx, HulkNode *node, const char *fmt, ...) {
 
     int line = node ? node->line : 0;
     int col  = node ? node->col  : 0;
-    LOG_ERROR_MSG("semantic", "[%d:%d] %s", line, col, buf);
+    if (ctx->diags)
+        sem_diags_add(ctx->diags, line, col, buf);
+    else
+        LOG_ERROR_MSG("semantic", "[%d:%d] %s", line, col, buf);
+}
+
+void sem_diags_add(SemDiagList *l, int line, int col, const char *msg) {
+    if (l->count >= l->cap) {
+        int nc = l->cap ? l->cap * 2 : 4;
+        SemDiag *tmp = realloc(l->items, sizeof(SemDiag) * (size_t)nc);
+        if (!tmp) return;
+        l->items = tmp;
+        l->cap = nc;
+    }
+    SemDiag *d = &l->items[l->count++];
+    d->line = line;
+    d->col = col;
+    d->msg = strdup(msg);
+}
+
+void sem_diags_emit(const SemDiagList *l, int line_offset) {
+    for (int i = 0; i < l->count; i++)
+        LOG_ERROR_MSG("semantic", "[%d:%d] %s",
+                      l->items[i].line + line_offset, l->items[i].col,
+                      l->items[i].msg ? l->items[i].msg : "");
+}
+
+void sem_diags_free(SemDiagList *l) {
+    for (int i = 0; i < l->count; i++) free(l->items[i].msg);
+    free(l->items);
+    l->items = NULL;
+    l->count = l->cap = 0;
 }
@@ -8,27 +8,56 @@
  */
 
 #include "hulk_semantic_internal.h"
+#include "../core/hulk_hierarchy.h"
+#include <pthread.h>
+#include <stdint.h>
+
+/* En el pase 3 paralelo el registro de tipos (tipos nuevos, canónicos,
+ * join memoizado) es del contexto principal: cada función pública lo
+ * toma con sem_parallel_registry y lo suelta con sem_parallel_unlock;
+ * las llamadas internas usan ese contexto, que no vuelve a bloquear.
+ * Los memos de conformance no tienen contexto a mano y van con un
+ * candado propio. */
+static pthread_mutex_t memo_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /* ============================================================
  *  Creación de tipos
  * ============================================================ */
 
-HulkType* sem_type_new(SemanticContext *ctx, HulkTypeKind kind,
-                        const char *name, HulkType *parent) {
-    HulkType *t = calloc(1, sizeof(HulkType));
-    if (!t) return NULL;
-    t->kind   = kind;
-    t->name   = name;
-    t->parent = parent;
-
+static HulkType* type_register(SemanticContext *ctx, HulkType *t) {
     if (ctx->type_count >= ctx->type_cap) {
         int nc = ctx->type_cap == 0 ? 16 : ctx->type_cap * 2;
         HulkType **tmp = realloc(ctx->types, sizeof(HulkType*) * nc);
-        if (!tmp) { free(t); return NULL; }
+        if (!tmp) return NULL;
         ctx->types = tmp;
         ctx->type_cap = nc;
     }
+    t->id = ctx->type_count;
     ctx->types[ctx->type_count++] = t;
+
+    if (ctx->type_count > HULK_NAME_INDEX_MIN) {
+        int from = ctx->type_index.cap ? ctx->type_count - 1 : 0;
+        for (int i = from; i < ctx->type_count; i++)
+            hulk_name_index_add(&ctx->type_index, ctx->types[i]->name, i);
+    }
+    return t;
+}
+
+/* Los tipos viven en la arena del contexto dueño del registro. */
+HulkType* sem_type_new(SemanticContext *ctx, HulkTypeKind kind,
+                        const char *name, HulkType *parent) {
+    SemanticContext *reg = sem_parallel_registry(ctx);
+    HulkType *t = sem_alloc(reg, sizeof(HulkType));
+    if (t) {
+        t->kind   = kind;
+        t->name   = hulk_intern(name);
+        t->parent = parent;
+        size_t len = strlen(t->name);
+        t->array_like = len >= 2 && strcmp(t->name + len - 2, "[]") == 0;
+        t->iter_like  = len >= 1 && t->name[len - 1] == '*';
+        t = type_register(reg, t);
+    }
+    sem_parallel_unlock(ctx);
     return t;
 }
 
@@ -44,8 +73,8 @@ static void reg_builtin(SemanticContext *ctx, const char *name,
     Symbol *sym = sem_define(ctx, name, SYM_FUNCTION, ret, NULL);
     if (sym && np > 0) {
         sym->param_count = np;
-        sym->param_types = calloc(np, sizeof(HulkType*));
-        sym->param_names = calloc(np, sizeof(const char*));
+        sym->param_types = sem_alloc(ctx, np * sizeof(HulkType*));
+        sym->param_names = sem_alloc(ctx, np * sizeof(const char*));
 
         va_list ap;
         va_start(ap, np);
@@ -66,6 +95,18 @@ static void reg_builtin(SemanticContext *ctx, const char *name,
  *  Inicialización: tipos + funciones built-in
  * ============================================================ */
 
+void sem_context_init(SemanticContext *ctx, HulkASTContext *ast_ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->ast_ctx = ast_ctx;
+    hulk_ast_context_init(&ctx->arena);
+    hulk_side_init(&ctx->param_types, sizeof(HulkType*));
+
+    /* Scope global y tipos/funciones built-in */
+    ctx->global  = sem_scope_create(ctx, NULL);
+    ctx->current = ctx->global;
+    sem_types_init(ctx);
+}
+
 void sem_types_init(SemanticContext *ctx) {
     /* Tipos built-in */
     ctx->t_object  = sem_type_new(ctx, HULK_TYPE_OBJECT,  "Object",  NULL);
@@ -109,6 +150,87 @@ void sem_types_init(SemanticContext *ctx) {
                 "size", ctx->t_number, "initializer", ctx->t_object);
 }
 
+/* ============================================================
+ *  Índice de la jerarquía
+ * ============================================================ */
+
+/* Con la herencia y los miembros ya definitivos (fin del pase 2), numera
+ * los tipos con sus intervalos DFS. Los tipos creados después (arreglos,
+ * iterables, firmas de función) quedan sin índice y recorren la cadena
+ * hasta el primer ancestro indexado. */
+void sem_types_index_hierarchy(SemanticContext *ctx) {
+    int n = ctx->type_count;
+    int *parent = malloc(sizeof(int) * (size_t)(n ? n : 1));
+    int *pre    = malloc(sizeof(int) * (size_t)(n ? n : 1));
+    int *post   = malloc(sizeof(int) * (size_t)(n ? n : 1));
+    if (parent && pre && post) {
+        for (int i = 0; i < n; i++) {
+            HulkType *p = ctx->types[i]->parent;
+            parent[i] = p ? p->id : -1;
+        }
+        if (hulk_hierarchy_number(n, parent, pre, post)) {
+            for (int i = 0; i < n; i++) {
+                ctx->types[i]->pre  = pre[i];
+                ctx->types[i]->post = post[i];
+            }
+        }
+    }
+    free(parent); free(pre); free(post);
+}
+
+/* ¿`ancestor` está en la cadena de padres de `child` (sin contarlo)? */
+static int is_proper_ancestor(HulkType *child, HulkType *ancestor) {
+    for (HulkType *t = child->parent; t; t = t->parent) {
+        if (t == ancestor) return 1;
+        if (t->pre && ancestor->pre)
+            return HULK_HIERARCHY_CONTAINS(ancestor->pre, ancestor->post,
+                                           t->pre, t->post);
+    }
+    return 0;
+}
+
+/* Conformance estructural contra un iterable "T*" o un protocolo. */
+static int structural_check(HulkType *child, HulkType *ancestor) {
+    if (ancestor->iter_like) {
+        if (!child->members) return 0;
+        int has_next = 0, has_current = 0;
+        for (int i = 0; i < child->members->sym_count; i++) {
+            Symbol *s = child->members->symbols[i];
+            if (!s || s->kind != SYM_METHOD || !s->name) continue;
+            if (strcmp(s->name, "next") == 0) has_next = 1;
+            if (strcmp(s->name, "current") == 0) has_current = 1;
+        }
+        return has_next && has_current;
+    }
+    /* Protocolo: child conforma si tiene todos los métodos del protocolo
+     * (por nombre, sin chequear variance estricta en este momento). */
+    if (!ancestor->members || !child->members) return 0;
+    for (int i = 0; i < ancestor->members->sym_count; i++) {
+        Symbol *psym = ancestor->members->symbols[i];
+        if (!psym || psym->kind != SYM_METHOD) continue;
+        Symbol *csym = sem_lookup_local(child->members, psym->name);
+        if (!csym || csym->kind != SYM_METHOD) return 0;
+    }
+    return 1;
+}
+
+/* Con ambos tipos indexados los miembros ya no cambian: la respuesta se
+ * memoiza en el ancestro, por puntero del hijo. */
+static int conforms_structural(HulkType *child, HulkType *ancestor) {
+    if (!child->pre || !ancestor->pre)
+        return structural_check(child, ancestor);
+    const char *key = (const char*)child;   /* el índice compara punteros */
+    pthread_mutex_lock(&memo_lock);
+    int r = hulk_name_index_find(&ancestor->conform_memo, key);
+    pthread_mutex_unlock(&memo_lock);
+    if (r >= 0) return r;
+    r = structural_check(child, ancestor);
+    pthread_mutex_lock(&memo_lock);
+    hulk_name_index_add(&ancestor->conform_memo, key, r);
+    pthread_mutex_unlock(&memo_lock);
+    return r;
+}
+
 /* ============================================================
  *  Conformidad de tipos (child ≤ ancestor)
  * ============================================================ */
@@ -122,52 +244,18 @@ int sem_type_conforms(HulkType *child, HulkType *ancestor) {
     if (child->kind == HULK_TYPE_FUNCTION &&
         ancestor->kind == HULK_TYPE_FUNCTION)
         return sem_function_type_equals(child, ancestor);
-    if (ancestor->name) {
-        size_t alen = strlen(ancestor->name);
-        if (alen >= 2 && strcmp(ancestor->name + alen - 2, "[]") == 0 &&
-            child->kind == HULK_TYPE_OBJECT)
-            return 1;
-        if (alen >= 1 && ancestor->name[alen - 1] == '*') {
-            if (child->kind == HULK_TYPE_OBJECT) return 1;
-            if (child->members) {
-                int has_next = 0, has_current = 0;
-                for (int i = 0; i < child->members->sym_count; i++) {
-                    Symbol *s = child->members->symbols[i];
-                    if (!s || s->kind != SYM_METHOD || !s->name) continue;
-                    if (strcmp(s->name, "next") == 0) has_next = 1;
-                    if (strcmp(s->name, "current") == 0) has_current = 1;
-                }
-                if (has_next && has_current) return 1;
-            }
-        }
+    if (ancestor->array_like && child->kind == HULK_TYPE_OBJECT)
+        return 1;
+    if (ancestor->iter_like) {
+        if (child->kind == HULK_TYPE_OBJECT) return 1;
+        if (conforms_structural(child, ancestor)) return 1;
     }
     /* Todo conforma con Object */
     if (ancestor->kind == HULK_TYPE_OBJECT) return 1;
-    /* Recorrer cadena de herencia */
-    for (HulkType *t = child->parent; t; t = t->parent) {
-        if (t == ancestor) return 1;
-    }
-    /* Conformance estructural: si ancestor es protocolo, child conforma
-     * si tiene todos los métodos del protocolo (por nombre, sin chequear
-     * variance estricta en este momento). */
-    if (ancestor->is_protocol && ancestor->members &&
-        child->members) {
-        for (int i = 0; i < ancestor->members->sym_count; i++) {
-            Symbol *psym = ancestor->members->symbols[i];
-            if (!psym || psym->kind != SYM_METHOD) continue;
-            int found = 0;
-            for (int j = 0; j < child->members->sym_count; j++) {
-                Symbol *csym = child->members->symbols[j];
-                if (csym && csym->kind == SYM_METHOD && csym->name &&
-                    psym->name && strcmp(csym->name, psym->name) == 0) {
-                    found = 1;
-                    break;
-                }
-            }
-            if (!found) return 0;
-        }
-        return 1;
-    }
+    /* Herencia: contención de intervalos o, sin índice, la cadena */
+    if (is_proper_ancestor(child, ancestor)) return 1;
+    if (ancestor->is_protocol)
+        return conforms_structural(child, ancestor);
     return 0;
 }
 
@@ -175,10 +263,7 @@ int sem_type_conforms(HulkType *child, HulkType *ancestor) {
  *  Join: ancestro común más específico
  * ============================================================ */
 
-HulkType* sem_type_join(SemanticContext *ctx, HulkType *a, HulkType *b) {
-    if (!a || a->kind == HULK_TYPE_ERROR) return b ? b : ctx->t_object;
-    if (!b || b->kind == HULK_TYPE_ERROR) return a;
-    if (a == b) return a;
+static HulkType* join_walk(SemanticContext *ctx, HulkType *a, HulkType *b) {
     if (sem_type_conforms(a, b)) return b;
     if (sem_type_conforms(b, a)) return a;
     /* Subir por la jerarquía de a buscando un ancestro que cubra b */
@@ -188,17 +273,49 @@ HulkType* sem_type_join(SemanticContext *ctx, HulkType *a, HulkType *b) {
     return ctx->t_object;
 }
 
+HulkType* sem_type_join(SemanticContext *ctx, HulkType *a, HulkType *b) {
+    if (!a || a->kind == HULK_TYPE_ERROR) return b ? b : ctx->t_object;
+    if (!b || b->kind == HULK_TYPE_ERROR) return a;
+    if (a == b) return a;
+    if (!a->pre || !b->pre) return join_walk(ctx, a, b);
+    /* Ambos indexados: el join es fijo, se memoiza en a por puntero de b */
+    SemanticContext *reg = sem_parallel_registry(ctx);
+    const char *key = (const char*)b;
+    int id = hulk_name_index_find(&a->join_memo, key);
+    HulkType *j = id >= 0 ? reg->types[id] : join_walk(reg, a, b);
+    if (id < 0) hulk_name_index_add(&a->join_memo, key, j->id);
+    sem_parallel_unlock(ctx);
+    return j;
+}
+
 /* ============================================================
  *  Resolución de tipo por nombre
  * ============================================================ */
 
+/* Los nombres de tipo están internados: se compara por puntero y, si
+ * falla, se reintenta con la forma internada de `name` (anotaciones
+ * recortadas con sem_slice llegan como copias). */
+static HulkType* find_type(SemanticContext *ctx, const char *key) {
+    if (ctx->type_index.cap) {
+        int i = hulk_name_index_find(&ctx->type_index, key);
+        return i >= 0 ? ctx->types[i] : NULL;
+    }
+    for (int i = 0; i < ctx->type_count; i++)
+        if (ctx->types[i]->name == key)
+            return ctx->types[i];
+    return NULL;
+}
+
 HulkType* sem_type_resolve(SemanticContext *ctx, const char *name) {
     if (!name) return NULL;
-    for (int i = 0; i < ctx->type_count; i++) {
-        if (ctx->types[i]->name && strcmp(ctx->types[i]->name, name) == 0)
-            return ctx->types[i];
+    SemanticContext *reg = sem_parallel_registry(ctx);
+    HulkType *t = find_type(reg, name);
+    if (!t) {
+        const char *key = hulk_intern_find(name);
+        if (key && key != name) t = find_type(reg, key);
     }
-    return NULL;
+    sem_parallel_unlock(ctx);
+    return t;
 }
 
 static char* sem_slice(const char *s, int start, int end) {
@@ -230,13 +347,20 @@ static HulkType* resolve_annotation_range(SemanticContext *c,
                                           int end,
                                           HulkNode *err_node);
 
+/* Cuánto cambia el anidamiento en s[i]: paréntesis y argumentos de tipo
+ * ("Pair<A,B>"); el '>' de una flecha "->" no cierra nada. */
+static int nest_delta(const char *s, int i) {
+    if (s[i] == '(' || s[i] == '<') return 1;
+    if (s[i] == ')' || (s[i] == '>' && s[i - 1] != '-')) return -1;
+    return 0;
+}
+
 static int count_function_params(const char *s, int start, int end) {
     if (start >= end) return 0;
     int depth = 0, count = 1;
     for (int i = start; i < end; i++) {
-        if (s[i] == '(') depth++;
-        else if (s[i] == ')') depth--;
-        else if (s[i] == ',' && depth == 0) count++;
+        depth += nest_delta(s, i);
+        if (s[i] == ',' && depth == 0) count++;
     }
     return count;
 }
@@ -247,10 +371,7 @@ static void fill_function_params(SemanticContext *c, const char *s,
     int depth = 0, seg_start = start, out = 0;
     for (int i = start; i <= end; i++) {
         int at_end = (i == end);
-        if (!at_end) {
-            if (s[i] == '(') depth++;
-            else if (s[i] == ')') depth--;
-        }
+        if (!at_end) depth += nest_delta(s, i);
         if (at_end || (s[i] == ',' && depth == 0)) {
             params[out++] = resolve_annotation_range(c, s, seg_start, i, err_node);
             seg_start = i + 1;
@@ -305,11 +426,14 @@ static HulkType* resolve_annotation_range(SemanticContext *c,
         size_t len = strlen(name);
         int is_array = len >= 2 && strcmp(name + len - 2, "[]") == 0;
         int is_iter = len >= 1 && name[len - 1] == '*';
-        if (is_array || is_iter) {
-            char *stable = strdup(name);
-            if (stable)
-                t = sem_type_new(c, HULK_TYPE_USER, stable, c->t_object);
+        if (is_array) {
+            name[len - 2] = '\0';
+            HulkType *elem = sem_type_resolve(c, name);
+            name[len - 2] = '[';
+            if (elem) t = sem_vector_type(c, elem);
         }
+        if (!t && (is_array || is_iter))
+            t = sem_type_new(c, HULK_TYPE_USER, name, c->t_object);
     }
     if (!t) {
         sem_error(c, err_node, "tipo '%s' no definido", name ? name : "?");
@@ -324,34 +448,139 @@ HulkType* sem_resolve_annotation(SemanticContext *c,
                                  const char *annotation,
                                  HulkNode *err_node) {
     if (!annotation) return c->t_object;
+    if (annotation[0] && annotation[0] != '(') {
+        /* caso común: un nombre ya registrado, sin copiar el trozo */
+        HulkType *t = sem_type_resolve(c, annotation);
+        if (t) return t;
+    }
     return resolve_annotation_range(c, annotation, 0, (int)strlen(annotation),
                                     err_node);
 }
 
-HulkType* sem_function_type_new(SemanticContext *ctx, HulkType **params,
-                                int param_count, HulkType *ret) {
+/* ============================================================
+ *  Tipos compuestos canónicos
+ * ============================================================ */
+
+static unsigned mix_ptr(unsigned h, const void *p) {
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (h ^ (unsigned)x) * 16777619u;
+}
+
+static unsigned fn_hash(HulkType **params, int n, HulkType *ret) {
+    unsigned h = mix_ptr(2166136261u ^ (unsigned)n, ret);
+    for (int i = 0; i < n; i++) h = mix_ptr(h, params[i]);
+    return h;
+}
+
+static int fn_matches(HulkType *t, HulkType **params, int n, HulkType *ret) {
+    if (t->param_count != n || t->return_type != ret) return 0;
+    for (int i = 0; i < n; i++)
+        if (t->param_types[i] != params[i]) return 0;
+    return 1;
+}
+
+static int fn_table_grow(SemanticContext *ctx) {
+    int ncap = ctx->fn_type_cap ? ctx->fn_type_cap * 2 : 64;
+    HulkType **nt = calloc((size_t)ncap, sizeof(HulkType*));
+    if (!nt) return 0;
+    for (int i = 0; i < ctx->fn_type_cap; i++) {
+        HulkType *t = ctx->fn_types[i];
+        if (!t) continue;
+        unsigned j = fn_hash(t->param_types, t->param_count, t->return_type)
+                     & (unsigned)(ncap - 1);
+        while (nt[j]) j = (j + 1) & (unsigned)(ncap - 1);
+        nt[j] = t;
+    }
+    free(ctx->fn_types);
+    ctx->fn_types = nt;
+    ctx->fn_type_cap = ncap;
+    return 1;
+}
+
+static HulkType* function_type_intern(SemanticContext *ctx, HulkType **params,
+                                      int param_count, HulkType *ret) {
+    HulkType *local[8];
+    HulkType **ps = param_count <= 8 ? local
+                  : malloc(sizeof(HulkType*) * (size_t)param_count);
+    if (!ps) return NULL;
+    for (int i = 0; i < param_count; i++)
+        ps[i] = params && params[i] ? params[i] : ctx->t_object;
+
+    if ((ctx->fn_type_count + 1) * 2 > ctx->fn_type_cap &&
+        !fn_table_grow(ctx)) {
+        if (ps != local) free(ps);
+        return NULL;
+    }
+    unsigned mask = (unsigned)(ctx->fn_type_cap - 1);
+    unsigned j = fn_hash(ps, param_count, ret) & mask;
+    for (HulkType *t; (t = ctx->fn_types[j]); j = (j + 1) & mask) {
+        if (fn_matches(t, ps, param_count, ret)) {
+            if (ps != local) free(ps);
+            return t;
+        }
+    }
+
     HulkType *t = sem_type_new(ctx, HULK_TYPE_FUNCTION, "<function>", ctx->t_object);
-    if (!t) return NULL;
-    t->param_count = param_count;
-    t->return_type = ret ? ret : ctx->t_object;
-    if (param_count > 0) {
-        t->param_types = calloc(param_count, sizeof(HulkType*));
-        if (!t->param_types) return t;
-        for (int i = 0; i < param_count; i++)
-            t->param_types[i] = params ? params[i] : ctx->t_object;
+    if (t) {
+        t->param_count = param_count;
+        t->return_type = ret;
+        if (param_count > 0) {
+            t->param_types = sem_alloc(ctx, sizeof(HulkType*) * (size_t)param_count);
+            if (t->param_types)
+                memcpy(t->param_types, ps, sizeof(HulkType*) * (size_t)param_count);
+            else
+                t->param_count = 0;
+        }
+        ctx->fn_types[j] = t;
+        ctx->fn_type_count++;
     }
+    if (ps != local) free(ps);
+    return t;
+}
+
+HulkType* sem_function_type_new(SemanticContext *ctx, HulkType **params,
+                                int param_count, HulkType *ret) {
+    if (!ret) ret = ctx->t_object;
+    HulkType *t = function_type_intern(sem_parallel_registry(ctx),
+                                       params, param_count, ret);
+    sem_parallel_unlock(ctx);
     return t;
 }
 
+/* Canónicos: misma firma ⇔ mismo objeto. */
 int sem_function_type_equals(HulkType *a, HulkType *b) {
     if (!a || !b) return 0;
     if (a->kind != HULK_TYPE_FUNCTION || b->kind != HULK_TYPE_FUNCTION)
         return 0;
-    if (a->param_count != b->param_count) return 0;
-    for (int i = 0; i < a->param_count; i++) {
-        if (a->param_types[i] != b->param_types[i]) return 0;
-    }
-    return a->return_type == b->return_type;
+    return a == b;
+}
+
+static HulkType* vector_type_intern(SemanticContext *ctx, HulkType *elem) {
+    if (elem->vector_of) return elem->vector_of;
+    size_t len = strlen(elem->name);
+    char *name = malloc(len + 3);
+    if (!name) return NULL;
+    memcpy(name, elem->name, len);
+    memcpy(name + len, "[]", 3);
+    /* Puede existir ya por nombre (p. ej. creado antes de conocer el
+     * tipo de sus elementos) */
+    HulkType *t = sem_type_resolve(ctx, name);
+    if (!t) t = sem_type_new(ctx, HULK_TYPE_USER, name, ctx->t_object);
+    free(name);
+    if (!t) return NULL;
+    if (!t->element) t->element = elem;
+    elem->vector_of = t;
+    return t;
+}
+
+HulkType* sem_vector_type(SemanticContext *ctx, HulkType *elem) {
+    if (!elem) return NULL;
+    HulkType *t = vector_type_intern(sem_parallel_registry(ctx), elem);
+    sem_parallel_unlock(ctx);
+    return t;
 }
 
 /* ============================================================
@@ -359,22 +588,16 @@ int sem_function_type_equals(HulkType *a, HulkType *b) {
  * ============================================================ */
 
 void sem_context_free(SemanticContext *ctx) {
-    /* Liberar scopes y sus símbolos */
-    for (int i = 0; i < ctx->scope_count; i++) {
-        Scope *s = ctx->all_scopes[i];
-        for (int j = 0; j < s->sym_count; j++) {
-            free(s->symbols[j]->param_types);
-            free((void*)s->symbols[j]->param_names);
-            free(s->symbols[j]);
-        }
-        free(s->symbols);
-        free(s);
-    }
-    free(ctx->all_scopes);
-    /* Liberar tipos */
+    sem_scopes_free(ctx);
+    /* Los tipos son de la arena; solo sus memos van aparte */
     for (int i = 0; i < ctx->type_count; i++) {
-        free(ctx->types[i]->param_types);
-        free(ctx->types[i]);
+        hulk_name_index_free(&ctx->types[i]->conform_memo);
+        hulk_name_index_free(&ctx->types[i]->join_memo);
     }
     free(ctx->types);
+    free(ctx->fn_types);
+    hulk_side_free(&ctx->param_types);
+    hulk_name_index_free(&ctx->type_index);
+    hulk_facts_free(&ctx->facts);
+    hulk_ast_context_free(&ctx->arena);
 }
@@ -0,0 +1,316 @@
+/*
+ * hulk_semantic_unify.c — Inferencia de parámetros por restricciones
+ *
+ * Los parámetros sin anotación de funciones globales y métodos se
+ * infieren juntos, antes de registrar las firmas (pase 2, paso 2a.2):
+ *
+ *   1. Una variable de tipo por nombre relevante de cada cuerpo: los
+ *      parámetros sin anotación y los alias `let y = x` que salen de
+ *      ellos. Cada una arranca con la cota que dan sus usos como
+ *      operando (hechos del cuerpo, una pasada por cuerpo).
+ *   2. Igualdad: un alias es el mismo tipo que su origen → union-find.
+ *   3. Subtipado: pasar x como argumento i-ésimo de f exige x ≤ tipo del
+ *      parámetro i de f. Si está anotado (o es un built-in) es una cota
+ *      constante; si es otra variable, una arista x ← param.
+ *   4. Las cotas se propagan por las aristas con una lista de trabajo
+ *      hasta el punto fijo. La red es Number/Boolean/String con el mismo
+ *      join que la heurística por cuerpo (conflicto → Number), así que
+ *      cada clase cambia a lo sumo dos veces.
+ *
+ * A diferencia de consultar la firma del callee al registrar la función,
+ * la respuesta no depende del orden de declaración y sigue cadenas de
+ * llamadas y alias de cualquier largo. Lo que no se resuelve queda en
+ * Object como antes. Las lambdas siguen con sem_infer_param_type.
+ *
+ * SRP: solo arma y resuelve las restricciones; el resultado queda en
+ * c->param_types para sem_param_annotation_for.
+ */
+#include "hulk_semantic_internal.h"
+#include <stdint.h>
+
+typedef struct {
+    HulkNode     *body;
+    const char   *name;
+    int           parent;       // union-find
+    unsigned char tag;          // HulkUseTag de la clase (válido en la raíz)
+    unsigned char collected;    // sus usos ya se recorrieron
+} UVar;
+
+typedef struct {
+    int from, to;               // from ≤ to
+} UEdge;
+
+typedef struct {
+    SemanticContext *c;
+    UVar          *vars;
+    int            nvars, var_cap;
+    int           *slots;       // hash (body, name) → var, -1 libre
+    int            slot_cap;
+    UEdge         *edges;
+    int            nedges, edge_cap;
+    HulkNameIndex  fns;         // nombre → posición en prog->declarations
+    ProgramNode   *prog;
+} Unifier;
+
+static HulkUseTag type_tag(HulkType *t) {
+    if (!t) return HULK_USE_NONE;
+    switch (t->kind) {
+        case HULK_TYPE_NUMBER:  return HULK_USE_NUMBER;
+        case HULK_TYPE_BOOLEAN: return HULK_USE_BOOLEAN;
+        case HULK_TYPE_STRING:  return HULK_USE_STRING;
+        default:                return HULK_USE_NONE;
+    }
+}
+
+static HulkType* tag_type(SemanticContext *c, HulkUseTag tag) {
+    switch (tag) {
+        case HULK_USE_NUMBER:  return c->t_number;
+        case HULK_USE_BOOLEAN: return c->t_boolean;
+        case HULK_USE_STRING:  return c->t_string;
+        default:               return c->t_object;
+    }
+}
+
+/* ---------- Variables ---------- */
+
+static unsigned var_hash(HulkNode *body, const char *name) {
+    uintptr_t x = (uintptr_t)body * 31u ^ (uintptr_t)name;
+    x ^= x >> 17;
+    x *= 0x9e3779b1u;
+    return (unsigned)(x ^ (x >> 15));
+}
+
+static int slots_grow(Unifier *u) {
+    int ncap = u->slot_cap ? u->slot_cap * 2 : 64;
+    int *ns = malloc(sizeof(int) * (size_t)ncap);
+    if (!ns) return 0;
+    for (int i = 0; i < ncap; i++) ns[i] = -1;
+    for (int v = 0; v < u->nvars; v++) {
+        unsigned j = var_hash(u->vars[v].body, u->vars[v].name)
+                     & (unsigned)(ncap - 1);
+        while (ns[j] >= 0) j = (j + 1) & (unsigned)(ncap - 1);
+        ns[j] = v;
+    }
+    free(u->slots);
+    u->slots = ns;
+    u->slot_cap = ncap;
+    return 1;
+}
+
+/* Variable de (body, name), creándola si hace falta. -1 sin memoria. */
+static int var_get(Unifier *u, HulkNode *body, const char *name) {
+    if ((u->nvars + 1) * 2 > u->slot_cap && !slots_grow(u)) return -1;
+    unsigned mask = (unsigned)(u->slot_cap - 1);
+    unsigned j = var_hash(body, name) & mask;
+    for (; u->slots[j] >= 0; j = (j + 1) & mask) {
+        UVar *v = &u->vars[u->slots[j]];
+        if (v->body == body && v->name == name) return u->slots[j];
+    }
+    if (u->nvars >= u->var_cap) {
+        int nc = u->var_cap ? u->var_cap * 2 : 64;
+        UVar *nv = realloc(u->vars, sizeof(UVar) * (size_t)nc);
+        if (!nv) return -1;
+        u->vars = nv;
+        u->var_cap = nc;
+    }
+    int id = u->nvars++;
+    u->vars[id] = (UVar){ body, name, id, HULK_USE_NONE, 0 };
+    u->slots[j] = id;
+    return id;
+}
+
+static int find(Unifier *u, int v) {
+    while (u->vars[v].parent != v) {
+        u->vars[v].parent = u->vars[u->vars[v].parent].parent;
+        v = u->vars[v].parent;
+    }
+    return v;
+}
+
+static void bound(Unifier *u, int v, HulkUseTag tag) {
+    int r = find(u, v);
+    u->vars[r].tag = hulk_use_join(u->vars[r].tag, tag);
+}
+
+static void unite(Unifier *u, int a, int b) {
+    int ra = find(u, a), rb = find(u, b);
+    if (ra == rb) return;
+    u->vars[rb].parent = ra;
+    u->vars[ra].tag = hulk_use_join(u->vars[ra].tag, u->vars[rb].tag);
+}
+
+static void edge(Unifier *u, int from, int to) {
+    if (u->nedges >= u->edge_cap) {
+        int nc = u->edge_cap ? u->edge_cap * 2 : 64;
+        UEdge *ne = realloc(u->edges, sizeof(UEdge) * (size_t)nc);
+        if (!ne) return;
+        u->edges = ne;
+        u->edge_cap = nc;
+    }
+    u->edges[u->nedges++] = (UEdge){ from, to };
+}
+
+/* ---------- Restricciones ---------- */
+
+static FunctionDefNode* user_function(Unifier *u, const char *name) {
+    int i = hulk_name_index_find(&u->fns, name);
+    return i >= 0 ? (FunctionDefNode*)u->prog->declarations.items[i] : NULL;
+}
+
+/* Cota de `x` pasado como argumento `index` de `callee`. */
+static void constrain_arg(Unifier *u, int v, const HulkArgUse *use) {
+    FunctionDefNode *fn = user_function(u, use->callee);
+    if (fn) {
+        if (use->index >= fn->params.count) return;
+        VarBindingNode *q = (VarBindingNode*)fn->params.items[use->index];
+        if (q->type_annotation) {
+            bound(u, v, type_tag(sem_type_resolve(u->c, q->type_annotation)));
+        } else {
+            int w = var_get(u, fn->body, q->name);
+            if (w >= 0) edge(u, v, w);
+        }
+        return;
+    }
+    /* Built-in: su firma ya está registrada en el scope global */
+    Symbol *sym = sem_lookup(u->c->global, use->callee);
+    if (sym && sym->kind == SYM_FUNCTION && use->index < sym->param_count)
+        bound(u, v, type_tag(sym->param_types[use->index]));
+}
+
+/* Usos de la variable v (nombre en su cuerpo) como cotas, y sus alias.
+ * Una vez por variable. */
+static void collect_uses(Unifier *u, int v) {
+    if (u->vars[v].collected) return;
+    u->vars[v].collected = 1;
+    SemanticContext *c = u->c;
+    HulkNode *body = u->vars[v].body;
+    const char *name = u->vars[v].name;
+    const HulkNameFacts *f = hulk_facts_name(&c->facts, body, name);
+    if (f) {
+        bound(u, v, (HulkUseTag)f->operand);
+        const HulkArgUse *args = hulk_facts_args(&c->facts, body);
+        for (int i = f->first_arg; i >= 0; i = args[i].next)
+            constrain_arg(u, v, &args[i]);
+    }
+    int na;
+    const HulkAlias *al = hulk_facts_aliases(&c->facts, body, &na);
+    for (int i = 0; i < na; i++) {
+        if (al[i].of != name) continue;
+        int w = var_get(u, body, al[i].name);
+        if (w < 0) continue;
+        unite(u, v, w);
+        collect_uses(u, w);
+    }
+}
+
+static void collect_params(Unifier *u, HulkNodeList *params, HulkNode *body) {
+    if (!body) return;
+    for (int i = 0; i < params->count; i++) {
+        VarBindingNode *p = (VarBindingNode*)params->items[i];
+        if (p->type_annotation || !p->name) continue;
+        int v = var_get(u, body, p->name);
+        if (v >= 0) collect_uses(u, v);
+    }
+}
+
+/* ---------- Resolución ---------- */
+
+/* Punto fijo de from ≤ to: la cota de to se suma a la de from. Las
+ * aristas se agrupan por la raíz de `to` para revisitar solo las que
+ * dependen de una clase que cambió. */
+static void propagate(Unifier *u) {
+    int n = u->nvars;
+    int *start = calloc((size_t)n + 1, sizeof(int));
+    int *order = malloc(sizeof(int) * (size_t)(u->nedges ? u->nedges : 1));
+    int *work  = malloc(sizeof(int) * (size_t)(n ? n : 1));
+    char *queued = calloc((size_t)(n ? n : 1), 1);
+    if (!start || !order || !work || !queued) {
+        free(start); free(order); free(work); free(queued);
+        return;
+    }
+    for (int e = 0; e < u->nedges; e++) start[find(u, u->edges[e].to) + 1]++;
+    for (int i = 0; i < n; i++) start[i + 1] += start[i];
+    int *fill = malloc(sizeof(int) * (size_t)(n ? n : 1));
+    if (!fill) {
+        free(start); free(order); free(work); free(queued);
+        return;
+    }
+    memcpy(fill, start, sizeof(int) * (size_t)n);
+    for (int e = 0; e < u->nedges; e++)
+        order[fill[find(u, u->edges[e].to)]++] = e;
+    free(fill);
+
+    int top = 0;
+    for (int i = 0; i < n; i++)
+        if (find(u, i) == i && u->vars[i].tag != HULK_USE_NONE) {
+            work[top++] = i;
+            queued[i] = 1;
+        }
+    while (top > 0) {
+        int r = work[--top];
+        queued[r] = 0;
+        for (int k = start[r]; k < start[r + 1]; k++) {
+            int from = find(u, u->edges[order[k]].from);
+            HulkUseTag t = hulk_use_join(u->vars[from].tag, u->vars[r].tag);
+            if (t == u->vars[from].tag) continue;
+            u->vars[from].tag = (unsigned char)t;
+            if (!queued[from]) { work[top++] = from; queued[from] = 1; }
+        }
+    }
+    free(start); free(order); free(work); free(queued);
+}
+
+static void store_params(Unifier *u, HulkNodeList *params, HulkNode *body) {
+    if (!body) return;
+    for (int i = 0; i < params->count; i++) {
+        VarBindingNode *p = (VarBindingNode*)params->items[i];
+        if (p->type_annotation || !p->name) continue;
+        int v = var_get(u, body, p->name);
+        if (v < 0) continue;
+        HulkType **slot = hulk_side_put(&u->c->param_types, (HulkNode*)p);
+        if (slot) *slot = tag_type(u->c, (HulkUseTag)u->vars[find(u, v)].tag);
+    }
+}
+
+/* Recorre funciones globales y métodos; `store` elige la fase. */
+static void each_body(Unifier *u, int store) {
+    ProgramNode *prog = u->prog;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (decl->type == NODE_FUNCTION_DEF) {
+            FunctionDefNode *fn = (FunctionDefNode*)decl;
+            if (store) store_params(u, &fn->params, fn->body);
+            else       collect_params(u, &fn->params, fn->body);
+        } else if (decl->type == NODE_TYPE_DEF) {
+            TypeDefNode *td = (TypeDefNode*)decl;
+            for (int j = 0; j < td->members.count; j++) {
+                HulkNode *m = td->members.items[j];
+                if (m->type != NODE_METHOD_DEF) continue;
+                MethodDefNode *md = (MethodDefNode*)m;
+                if (store) store_params(u, &md->params, md->body);
+                else       collect_params(u, &md->params, md->body);
+            }
+        }
+    }
+}
+
+void sem_unify_params(SemanticContext *c, ProgramNode *prog) {
+    Unifier u;
+    memset(&u, 0, sizeof(u));
+    u.c = c;
+    u.prog = prog;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *decl = prog->declarations.items[i];
+        if (decl->type == NODE_FUNCTION_DEF)
+            hulk_name_index_add(&u.fns, ((FunctionDefNode*)decl)->name, i);
+    }
+
+    each_body(&u, 0);
+    propagate(&u);
+    each_body(&u, 1);
+
+    hulk_name_index_free(&u.fns);
+    free(u.vars);
+    free(u.slots);
+    free(u.edges);
+}
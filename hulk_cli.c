@@ -3,8 +3,9 @@
  * contrato de interfaz de la facultad (matcom/compilers).
  *
  * Uso:
- *   ./hulk <archivo.hulk>
+ *   ./hulk [-O0|-O1|-O2|-O3|-Os] [-march=native] <archivo.hulk>
  *
+ * Por defecto -O0 con CPU genérico (hulk_codegen.h).
  * En éxito (exit 0): produce ./output (binario nativo).
  * En error:
  *   1 = LEXICAL
@@ -25,8 +26,10 @@
 #include "hulk_compiler.h"
 #include "error_handler.h"
 #include "hulk_ast/core/hulk_ast.h"
+#include "hulk_ast/core/hulk_ast_cache.h"
 #include "hulk_ast/builder/hulk_ast_builder.h"
 #include "hulk_ast/semantic/hulk_semantic.h"
+#include "hulk_ast/ctfe/hulk_ctfe.h"
 #include "hulk_ast/codegen/hulk_codegen.h"
 
 /* ============================================================
@@ -143,20 +146,62 @@ static void setup_io(void) {
     freopen("/dev/null", "w", stderr);
 }
 
+/* ============================================================
+ *  Caché del AST
+ *
+ *  Opcional: con HULK_AST_CACHE=1 el AST de cada fuente sin errores
+ *  léxicos ni sintácticos se guarda en .build/ y las corridas
+ *  siguientes sobre el mismo contenido lo cargan sin construir el DFA
+ *  ni parsear. HULK_AST_CACHE=<dir> usa otro directorio (debe existir).
+ *  Sin la variable (o con 0 o vacía) no se lee ni se escribe nada: cada
+ *  entrada es una copia del fuente y no hay desalojo.
+ * ============================================================ */
+
+static const char* ast_cache_dir(void) {
+    const char *env = getenv("HULK_AST_CACHE");
+    if (!env || env[0] == '\0' || strcmp(env, "0") == 0) return NULL;
+    if (strcmp(env, "1") == 0) return ".build";
+    return env;
+}
+
+/* ============================================================
+ *  Evaluación en tiempo de compilación
+ *
+ *  Entre la semántica y el codegen se pliegan las expresiones y
+ *  llamadas puras con argumentos constantes (hulk_ctfe.h).
+ *  HULK_CTFE=0 (o vacío) lo desactiva.
+ * ============================================================ */
+
+static int ctfe_enabled(void) {
+    const char *env = getenv("HULK_CTFE");
+    return !env || (env[0] != '\0' && strcmp(env, "0") != 0);
+}
+
 /* ============================================================
  *  main
  * ============================================================ */
 
 int main(int argc, char **argv) {
-    if (argc < 2) {
-        fprintf(stderr, "uso: %s <archivo.hulk>\n", argv[0]);
+    /* Opciones antes o después del archivo */
+    HulkCodegenOptions opts = { HULK_OPT_DEFAULT, 0, 0 };
+    const char *path = NULL;
+    int bad_option = 0;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-')
+            bad_option |= !hulk_codegen_parse_option(&opts, argv[i]);
+        else if (!path)
+            path = argv[i];
+    }
+    if (!path || bad_option) {
+        fprintf(stderr, "uso: %s [-O0|-O1|-O2|-O3|-Os] [-march=native] "
+                        "<archivo.hulk>\n", argv[0]);
         return 1;
     }
 
     /* Lee el archivo antes de redirección, así el error aparece bien */
-    char *src = slurp(argv[1]);
+    char *src = slurp(path);
     if (!src) {
-        fprintf(stderr, "(0,0) LEXICAL: cannot read file '%s'\n", argv[1]);
+        fprintf(stderr, "(0,0) LEXICAL: cannot read file '%s'\n", path);
         return 1;
     }
 
@@ -167,25 +212,31 @@ int main(int argc, char **argv) {
     setup_io();
     error_handler_set(hulk_diag_handler);
 
-    /* ---- Fase 1: lexer + parser → AST ---- */
-    HulkCompiler hc;
-    if (!hulk_compiler_init(&hc)) {
-        emit_diag(0, 0, "SEMANTIC", "compiler init failed");
-        free(src);
-        return 3;
-    }
-
+    /* ---- Fase 1: lexer + parser → AST (o la caché, sin DFA) ---- */
+    HulkCompiler hc = { NULL };
     HulkASTContext ctx;
     hulk_ast_context_init(&ctx);
-    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+    const char *cache_dir = ast_cache_dir();
+    HulkNode *ast = cache_dir ? hulk_ast_cache_load(&ctx, cache_dir, src) : NULL;
 
-    if (!ast || n_lex > 0 || n_syn > 0) {
-        int ec = compute_exit_code();
-        if (ec == 0) ec = 2;  /* AST sin diagnóstico explícito → SYNTACTIC */
-        hulk_ast_context_free(&ctx);
-        hulk_compiler_free(&hc);
-        free(src);
-        return ec;
+    if (!ast) {
+        if (!hulk_compiler_init(&hc)) {
+            emit_diag(0, 0, "SEMANTIC", "compiler init failed");
+            free(src);
+            return 3;
+        }
+        ast = hulk_build_ast(&ctx, hc.dfa, src);
+
+        if (!ast || n_lex > 0 || n_syn > 0) {
+            int ec = compute_exit_code();
+            if (ec == 0) ec = 2;  /* AST sin diagnóstico explícito → SYNTACTIC */
+            hulk_ast_context_free(&ctx);
+            hulk_compiler_free(&hc);
+            free(src);
+            return ec;
+        }
+        /* Antes de la semántica: el desugar modifica el árbol */
+        if (cache_dir) hulk_ast_cache_store(cache_dir, src, ast);
     }
 
     /* ---- Fase 2: análisis semántico ---- */
@@ -199,8 +250,10 @@ int main(int argc, char **argv) {
         return ec;
     }
 
+    if (ctfe_enabled()) hulk_ctfe_fold(&ctx, ast);
+
     /* ---- Fase 3: codegen + link → ./output ---- */
-    int cg_rc = hulk_codegen_to_executable(ast, "./output");
+    int cg_rc = hulk_codegen_to_executable_opts(ast, "./output", &opts);
 
     hulk_ast_context_free(&ctx);
     hulk_compiler_free(&hc);
@@ -0,0 +1,84 @@
+/*
+ * bench_ast_arena.c — Costo de asignación del AST
+ *
+ * Genera un programa con N funciones (50 000 por defecto), lo parsea con
+ * hulk_rd_build_ast_mode en línea y reporta, mejor de N corridas:
+ *   - tiempo de parseo y de hulk_ast_context_free;
+ *   - pedidos a la arena (nodos, strings, listas) contra chunks pedidos
+ *     al sistema: antes de la arena por regiones cada pedido era un
+ *     calloc y cada lista un realloc aparte.
+ *
+ * Uso: make bench-ast-arena [BENCH_FUNCS=50000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ll1_builder.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+static const char *UNIT =
+    "function f%d(a: Number, b: Number): Number => "
+    "let t = a * %d + b in if (t > 100) t - 1 else f%d(t, b + 1);\n";
+
+static char* make_source(int funcs) {
+    size_t cap = (size_t)funcs * 128 + 64, len = 0;
+    char *src = malloc(cap);
+    for (int i = 0; i < funcs; i++) {
+        if (cap - len < 256) src = realloc(src, cap *= 2);
+        len += (size_t)snprintf(src + len, cap - len, UNIT, i, i, i);
+    }
+    snprintf(src + len, cap - len, "print(f0(1, 2));\n");
+    return src;
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_FUNCS", 50000, 1);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    /* Calentamiento: construye la gramática (y sus avisos) fuera de la medición */
+    HulkASTContext warm;
+    hulk_ast_context_init(&warm);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");
+    hulk_rd_build_ast(&warm, hc.dfa, "1;");
+    fclose(stderr);
+    stderr = saved_err;
+    hulk_ast_context_free(&warm);
+
+    char *src = make_source(funcs);
+    double best_parse = 1e9, best_free = 1e9;
+    HulkASTContext last;
+    int parsed = 1;
+    for (int r = 0; r < RUNS; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        double t0 = bench_now();
+        HulkNode *ast = hulk_rd_build_ast_mode(&ctx, hc.dfa, src, TOKEN_STREAM_INLINE);
+        double t1 = bench_now();
+        if (!ast) parsed = 0;
+        last = ctx;
+        hulk_ast_context_free(&ctx);
+        double t2 = bench_now();
+        if (t1 - t0 < best_parse) best_parse = t1 - t0;
+        if (t2 - t1 < best_free) best_free = t2 - t1;
+    }
+
+    printf("entrada: %d funciones, %.1f MB\n", funcs, strlen(src) / (1024.0 * 1024.0));
+    printf("  parseo      %8.3f s\n", best_parse);
+    printf("  liberación  %8.3f s\n", best_free);
+    printf("  pedidos     %8ld  (%.1f MB)\n", last.alloc_count,
+           last.alloc_bytes / (1024.0 * 1024.0));
+    printf("  chunks      %8d  (%d KiB c/u; 1 malloc por chunk)\n",
+           last.chunk_count, HULK_AST_CHUNK_SIZE / 1024);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (!parsed) { fprintf(stderr, "el programa generado no parseó\n"); return 1; }
+    return 0;
+}
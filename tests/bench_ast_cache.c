@@ -0,0 +1,110 @@
+/*
+ * bench_ast_cache.c — Frente del compilador en frío vs. caché del AST
+ *
+ * Para cada archivo dado simula dos corridas de ./hulk:
+ *   frío  — construir el DFA + lexear/parsear + guardar en la caché;
+ *   tibio — cargar el AST de la caché (mmap + reconstrucción).
+ * Verifica que ambos ASTs se impriman igual y reporta totales y
+ * promedio por archivo. La caché va a un directorio temporal.
+ *
+ * Uso: make bench-ast-cache   (corpus de tests/hulk_programs)
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/core/hulk_ast_cache.h"
+#include "../hulk_ast/printer/hulk_ast_printer.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static char* print_ast(HulkNode *n) {
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *out = open_memstream(&buf, &len);
+    hulk_ast_print(n, out);
+    fclose(out);
+    return buf;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <archivo.hulk>...\n", argv[0]);
+        return 1;
+    }
+    char dir[] = "/tmp/hulk_ast_cacheXXXXXX";
+    if (!mkdtemp(dir)) { perror("mkdtemp"); return 1; }
+
+    double t_init = 0, t_parse = 0, t_store = 0, t_load = 0;
+    int files = 0, mismatches = 0;
+    for (int i = 1; i < argc; i++) {
+        char *src = bench_slurp(argv[i]);
+        if (!src) continue;
+
+        // Frío: lo que paga un proceso nuevo sin caché
+        HulkCompiler hc;
+        FILE *saved_out = stdout, *saved_err = stderr;
+        stdout = fopen("/dev/null", "w");
+        stderr = fopen("/dev/null", "w");
+        double t0 = bench_now();
+        int ok = hulk_compiler_init(&hc);
+        double t1 = bench_now();
+        HulkASTContext cold;
+        hulk_ast_context_init(&cold);
+        HulkNode *ast = ok ? hulk_build_ast(&cold, hc.dfa, src) : NULL;
+        double t2 = bench_now();
+        int stored = ast && hulk_ast_cache_store(dir, src, ast);
+        double t3 = bench_now();
+        fclose(stdout);
+        fclose(stderr);
+        stdout = saved_out;
+        stderr = saved_err;
+        if (ok) hulk_compiler_free(&hc);
+        if (!stored) {
+            hulk_ast_context_free(&cold);
+            free(src);
+            continue;
+        }
+
+        // Tibio: solo la caché
+        HulkASTContext warm;
+        hulk_ast_context_init(&warm);
+        double t4 = bench_now();
+        HulkNode *cached = hulk_ast_cache_load(&warm, dir, src);
+        double t5 = bench_now();
+
+        char *p1 = print_ast(ast), *p2 = cached ? print_ast(cached) : NULL;
+        if (!p2 || strcmp(p1, p2) != 0) {
+            fprintf(stderr, "AST distinto desde la caché: %s\n", argv[i]);
+            mismatches++;
+        }
+        free(p1);
+        free(p2);
+
+        t_init += t1 - t0;
+        t_parse += t2 - t1;
+        t_store += t3 - t2;
+        t_load += t5 - t4;
+        files++;
+
+        char path[4096];
+        hulk_ast_cache_path(path, sizeof(path), dir, src);
+        remove(path);
+        hulk_ast_context_free(&cold);
+        hulk_ast_context_free(&warm);
+        free(src);
+    }
+    rmdir(dir);
+    if (files == 0) { fprintf(stderr, "ningún archivo parseó\n"); return 1; }
+
+    double cold = t_init + t_parse + t_store;
+    printf("corpus: %d archivos\n", files);
+    printf("  frío   %8.2f ms  (DFA %.2f + parseo %.2f + guardar %.2f)\n",
+           cold * 1e3, t_init * 1e3, t_parse * 1e3, t_store * 1e3);
+    printf("  tibio  %8.2f ms  (x%.0f)\n", t_load * 1e3, cold / t_load);
+    printf("  por archivo: %.3f ms frío, %.3f ms tibio\n",
+           cold * 1e3 / files, t_load * 1e3 / files);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * bench_ast_flat.c — AST de punteros vs. AST plano (struct-of-arrays)
+ *
+ * Parsea un programa generado, lo aplana con hulk_flat_build y reporta:
+ *   - bytes por nodo de cada representación (arena del AST de punteros:
+ *     nodos + listas + literales; plano: arreglos usados);
+ *   - tiempo de un recorrido completo (mejor de N), que cuenta
+ *     identificadores y suma sus líneas:
+ *       punteros  — recursión con hulk_ast_slots (persigue punteros);
+ *       plano rec — recursión por rangos de hijos;
+ *       plano lin — barrido lineal 0..count-1 (los ids están en preorden).
+ *
+ * Uso: make bench-ast-flat [BENCH_FUNCS=50000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ll1_builder.h"
+#include "../hulk_ast/core/hulk_ast_flat.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 10
+
+static const char *UNIT =
+    "function f%d(a: Number, b: Number): Number => "
+    "let t = a * %d + b in if (t > 100) t - 1 else f%d(t, b + 1);\n";
+
+static char* make_source(int funcs) {
+    size_t cap = (size_t)funcs * 128 + 64, len = 0;
+    char *src = malloc(cap);
+    for (int i = 0; i < funcs; i++) {
+        if (cap - len < 256) src = realloc(src, cap *= 2);
+        len += (size_t)snprintf(src + len, cap - len, UNIT, i, i, i);
+    }
+    snprintf(src + len, cap - len, "print(f0(1, 2));\n");
+    return src;
+}
+
+typedef struct { long nodes, idents, lines; } Tally;
+
+static void walk_ptr(HulkNode *n, Tally *t) {
+    if (!n) return;
+    t->nodes++;
+    if (n->type == NODE_IDENT) { t->idents++; t->lines += n->line; }
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++) walk_ptr(*s.fixed[i], t);
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            walk_ptr(s.lists[l]->items[i], t);
+}
+
+static void walk_flat(const HulkFlatAST *f, HulkFlatId id, Tally *t) {
+    t->nodes++;
+    if (f->kind[id] == NODE_IDENT) { t->idents++; t->lines += f->line[id]; }
+    int nlists_header = f->kind[id] == NODE_TYPE_DEF ? 2
+                      : (f->kind[id] == NODE_METHOD_DEF ||
+                         f->kind[id] == NODE_FUNCTION_EXPR) ? 1 : 0;
+    uint32_t at = f->first[id] + (uint32_t)nlists_header;
+    uint32_t end = f->first[id] + f->nchildren[id];
+    for (; at < end; at++)
+        if (f->children[at] != HULK_FLAT_NONE) walk_flat(f, f->children[at], t);
+}
+
+static void scan_flat(const HulkFlatAST *f, Tally *t) {
+    for (int id = 0; id < f->count; id++) {
+        t->nodes++;
+        if (f->kind[id] == NODE_IDENT) { t->idents++; t->lines += f->line[id]; }
+    }
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_FUNCS", 50000, 1);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(funcs);
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+    HulkNode *ast = hulk_rd_build_ast_mode(&ctx, hc.dfa, src, TOKEN_STREAM_INLINE);
+    fclose(stderr);
+    stderr = saved_err;
+    if (!ast) { fprintf(stderr, "el programa generado no parseó\n"); return 1; }
+
+    HulkFlatAST flat;
+    hulk_flat_init(&flat);
+    double t0 = bench_now();
+    hulk_flat_build(&flat, ast);
+    double t_build = bench_now() - t0;
+
+    double best_ptr = 1e9, best_rec = 1e9, best_lin = 1e9;
+    Tally a = {0, 0, 0}, b = {0, 0, 0}, c = {0, 0, 0};
+    for (int r = 0; r < RUNS; r++) {
+        double t;
+        memset(&a, 0, sizeof(a)); t = bench_now(); walk_ptr(ast, &a);
+        if ((t = bench_now() - t) < best_ptr) best_ptr = t;
+        memset(&b, 0, sizeof(b)); t = bench_now(); walk_flat(&flat, 0, &b);
+        if ((t = bench_now() - t) < best_rec) best_rec = t;
+        memset(&c, 0, sizeof(c)); t = bench_now(); scan_flat(&flat, &c);
+        if ((t = bench_now() - t) < best_lin) best_lin = t;
+    }
+
+    printf("entrada: %d funciones, %ld nodos\n", funcs, a.nodes);
+    printf("  memoria   punteros %6.1f B/nodo   plano %6.1f B/nodo\n",
+           (double)ctx.alloc_bytes / a.nodes,
+           (double)hulk_flat_bytes(&flat) / flat.count);
+    printf("  aplanado  %8.4f s\n", t_build);
+    printf("  punteros  %8.4f s\n", best_ptr);
+    printf("  plano rec %8.4f s  (x%.2f)\n", best_rec, best_ptr / best_rec);
+    printf("  plano lin %8.4f s  (x%.2f)\n", best_lin, best_ptr / best_lin);
+
+    int same = a.nodes == flat.count && a.nodes == b.nodes && a.nodes == c.nodes &&
+               a.lines == b.lines && a.lines == c.lines;
+    hulk_flat_free(&flat);
+    hulk_ast_context_free(&ctx);
+    free(src);
+    hulk_compiler_free(&hc);
+    if (!same) { fprintf(stderr, "los recorridos no coinciden\n"); return 1; }
+    return 0;
+}
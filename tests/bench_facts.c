@@ -0,0 +1,94 @@
+/*
+ * bench_facts.c — Costo de las heurísticas de inferencia en cuerpos grandes
+ *
+ * Genera una función con P parámetros sin anotar y un cuerpo de S
+ * sentencias que los usan, y un tipo con P atributos y P/4 métodos que
+ * usan self.x. Inferir cada parámetro o atributo pregunta por un nombre
+ * en el mismo cuerpo: si cada pregunta re-recorre el cuerpo, el costo es
+ * P × S. Mide, mejor de N corridas, semántico y codegen por separado.
+ *
+ * Uso: make bench-facts [BENCH_PARAMS=120] [BENCH_STMTS=1200]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+static char* make_source(int params, int stmts) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    bench_put(&b, "type Big(");
+    for (int i = 0; i < params; i++) bench_put(&b, i ? ", q%d" : "q%d", i);
+    bench_put(&b, ") {\n");
+    for (int i = 0; i < params; i++) bench_put(&b, "  f%d = q%d;\n", i, i);
+    for (int m = 0; m < params / 4; m++) {
+        bench_put(&b, "  m%d(): String => ", m);
+        for (int i = 0; i < params; i++)
+            bench_put(&b, i % 4 == 0 ? "self.f%d @ " : "(self.f%d + %d) @ ", i, m);
+        bench_put(&b, "\"\";\n");
+    }
+    bench_put(&b, "}\n");
+
+    bench_put(&b, "function big(");
+    for (int i = 0; i < params; i++) bench_put(&b, i ? ", p%d" : "p%d", i);
+    bench_put(&b, ") {\n");
+    for (int s = 0; s < stmts; s++)
+        bench_put(&b, "  p%d * p%d;\n", s % params, (s * 7 + 1) % params);
+    bench_put(&b, "  p0;\n}\n");
+
+    bench_put(&b, "print(big(");
+    for (int i = 0; i < params; i++) bench_put(&b, i ? ", %d" : "%d", i);
+    bench_put(&b, "));\nprint(new Big(");
+    for (int i = 0; i < params; i++) bench_put(&b, i ? ", %d" : "%d", i);
+    bench_put(&b, ").m0());\n");
+    return b.s;
+}
+
+int main(void) {
+    int params = bench_env_int("BENCH_PARAMS", 120, 1);
+    int stmts = bench_env_int("BENCH_STMTS", 1200, 1);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(params, stmts);
+    double best_sem = 1e9, best_cg = 1e9;
+    int errors = 0;
+    for (int r = 0; r < RUNS && !errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { errors = 1; hulk_ast_context_free(&ctx); break; }
+
+        double t0 = bench_now();
+        errors = hulk_semantic_analyze(&ctx, ast);
+        double t1 = bench_now();
+        if (!errors) errors = hulk_codegen(ast, "/dev/null");
+        double t2 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best_sem) best_sem = t1 - t0;
+        if (t2 - t1 < best_cg) best_cg = t2 - t1;
+    }
+
+    printf("entrada: %d parámetros, %d sentencias, %d métodos\n",
+           params, stmts, params / 4);
+    printf("  semántico  %8.3f s\n", best_sem);
+    printf("  codegen    %8.3f s\n", best_cg);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (errors) { fprintf(stderr, "el programa generado no compiló\n"); return 1; }
+    return 0;
+}
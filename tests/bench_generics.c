@@ -0,0 +1,114 @@
+/*
+ * bench_generics.c — Contenedor y algoritmo genéricos contra Object
+ *
+ * Compila a ejecutable dos versiones del mismo programa: una con
+ * genéricos (Cell<Number>, max<Number>), que se monomorfizan con campos
+ * double y comparaciones directas, y otra escrita como hasta ahora, con
+ * Object: cada número va en un objeto Boxed y se recupera con `as`. Mide
+ * el mejor de N ejecuciones de cada binario y verifica que impriman lo
+ * mismo.
+ *
+ * Uso: make bench-generics [BENCH_GENERIC_ITERS=3000000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 5
+
+static const char *generic_src =
+    "type Cell<T>(v: T) {\n"
+    "    v: T = v;\n"
+    "    get(): T => self.v;\n"
+    "    set(x: T): T => self.v := x;\n"
+    "}\n"
+    "function max<T>(a: T, b: T): T => if (a > b) a else b;\n"
+    "function run(n: Number): Number {\n"
+    "    let acc = new Cell<Number>(0), top = new Cell<Number>(0), i = 0 in {\n"
+    "        while (i < n) {\n"
+    "            acc.set(acc.get() + i %% 7);\n"
+    "            top.set(max<Number>(top.get(), (i * 31) %% 1000));\n"
+    "            i := i + 1;\n"
+    "        };\n"
+    "        acc.get() + top.get();\n"
+    "    };\n"
+    "}\n"
+    "print(run(%d));\n";
+
+static const char *object_src =
+    "type Boxed(v: Number) { v: Number = v; get(): Number => self.v; }\n"
+    "type Cell(v: Object) {\n"
+    "    v: Object = v;\n"
+    "    get(): Object => self.v;\n"
+    "    set(x: Object): Object => self.v := x;\n"
+    "}\n"
+    "function max(a: Object, b: Object): Object =>\n"
+    "    if ((a as Boxed).get() > (b as Boxed).get()) a else b;\n"
+    "function run(n: Number): Number {\n"
+    "    let acc = new Cell(new Boxed(0)), top = new Cell(new Boxed(0)), i = 0 in {\n"
+    "        while (i < n) {\n"
+    "            acc.set(new Boxed((acc.get() as Boxed).get() + i %% 7));\n"
+    "            top.set(max(top.get(), new Boxed((i * 31) %% 1000)));\n"
+    "            i := i + 1;\n"
+    "        };\n"
+    "        (acc.get() as Boxed).get() + (top.get() as Boxed).get();\n"
+    "    };\n"
+    "}\n"
+    "print(run(%d));\n";
+
+static HulkCompiler hc;
+
+/* Compila `fmt` con `iters` a `exe`. 0 si compiló. */
+static int build(const char *fmt, int iters, const char *exe) {
+    char src[4096];
+    snprintf(src, sizeof(src), fmt, iters);
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+    fclose(stderr);
+    stderr = saved_err;
+    int errors = !ast || hulk_semantic_analyze(&ctx, ast);
+    if (!errors) errors = hulk_codegen_to_executable(ast, exe);
+    hulk_ast_context_free(&ctx);
+    return errors;
+}
+
+int main(void) {
+    int iters = bench_env_int("BENCH_GENERIC_ITERS", 3000000, 1);
+
+    if (!bench_compiler_init(&hc)) return 1;
+
+    const char *gen_exe = "/tmp/bench_generics_gen", *obj_exe = "/tmp/bench_generics_obj";
+    int errors = build(generic_src, iters, gen_exe) || build(object_src, iters, obj_exe);
+    char gen_out[256] = "", obj_out[256] = "";
+    double g = -1, o = -1;
+    if (!errors) {
+        g = bench_run_exe(gen_exe, RUNS, gen_out, sizeof(gen_out));
+        o = bench_run_exe(obj_exe, RUNS, obj_out, sizeof(obj_out));
+    }
+    remove(gen_exe);
+    remove(obj_exe);
+    hulk_compiler_free(&hc);
+    if (errors || g < 0 || o < 0) {
+        fprintf(stderr, "los programas generados no compilaron o fallaron\n");
+        return 1;
+    }
+
+    printf("iteraciones: %d (mejor de %d ejecuciones)\n", iters, RUNS);
+    printf("  Cell<Number>, max<Number>   %8.3f s\n", g);
+    printf("  Cell de Object, as Boxed    %8.3f s\n", o);
+    printf("  aceleración                 %8.2fx\n", o / g);
+    if (strcmp(gen_out, obj_out) != 0) {
+        fprintf(stderr, "las salidas difieren: %s vs %s\n", gen_out, obj_out);
+        return 1;
+    }
+    return 0;
+}
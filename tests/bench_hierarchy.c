@@ -0,0 +1,89 @@
+/*
+ * bench_hierarchy.c — Costo de subtipado y join en jerarquías profundas
+ *
+ * Genera una cadena de D tipos (T0 ← T1 ← … ← T(D-1)), una hoja A al
+ * fondo y una hoja B colgada de T0, ambas conformes a un protocolo P,
+ * y S sentencias que piden conformance hoja → T0 (pasar A a una función
+ * que espera T0), protocolo (let p: P = a) y join (if entre A y B).
+ * Recorriendo la cadena de padres cada consulta cuesta O(D) y el join
+ * O(D) consultas; con la jerarquía indexada son O(1) memoizadas. Mide,
+ * mejor de N corridas, semántico y codegen por separado.
+ *
+ * Uso: make bench-hierarchy [BENCH_DEPTH=1000] [BENCH_STMTS=1200]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+static char* make_source(int depth, int stmts) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    bench_put(&b, "protocol P { h(): Number; }\n");
+    bench_put(&b, "type T0 { h(): Number => 0; }\n");
+    for (int i = 1; i < depth; i++)
+        bench_put(&b, "type T%d inherits T%d { }\n", i, i - 1);
+    bench_put(&b, "type A inherits T%d { h(): Number => 1; }\n", depth - 1);
+    bench_put(&b, "type B inherits T0 { h(): Number => 2; }\n");
+    bench_put(&b, "function g(x: T0): Number => x.h();\n");
+
+    bench_put(&b, "let a = new A(), b = new B() in {\n");
+    for (int i = 0; i < stmts; i++) {
+        switch (i % 3) {
+            case 0: bench_put(&b, "  print(g(a) + %d);\n", i); break;
+            case 1: bench_put(&b, "  let p: P = a in print(p.h() + %d);\n", i); break;
+            default:
+                bench_put(&b, "  print((if (a.h() > %d) a else b).h());\n", i);
+        }
+    }
+    bench_put(&b, "};\n");
+    return b.s;
+}
+
+int main(void) {
+    int depth = bench_env_int("BENCH_DEPTH", 1000, 1);
+    int stmts = bench_env_int("BENCH_STMTS", 1200, 1);
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(depth, stmts);
+    double best_sem = 1e9, best_cg = 1e9;
+    int errors = 0;
+    for (int r = 0; r < RUNS && !errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { errors = 1; hulk_ast_context_free(&ctx); break; }
+
+        double t0 = bench_now();
+        errors = hulk_semantic_analyze(&ctx, ast);
+        double t1 = bench_now();
+        if (!errors) errors = hulk_codegen(ast, "/dev/null");
+        double t2 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best_sem) best_sem = t1 - t0;
+        if (t2 - t1 < best_cg) best_cg = t2 - t1;
+    }
+
+    printf("entrada: jerarquía de %d niveles, %d sentencias\n",
+           depth, stmts);
+    printf("  semántico  %8.3f s\n", best_sem);
+    printf("  codegen    %8.3f s\n", best_cg);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (errors) { fprintf(stderr, "el programa generado no compiló\n"); return 1; }
+    return 0;
+}
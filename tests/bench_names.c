@@ -0,0 +1,78 @@
+/*
+ * bench_names.c — Costo de resolver nombres en semántico y codegen
+ *
+ * Genera un programa con muchos nombres globales (N tipos con atributo y
+ * método, N funciones que los instancian y se llaman entre sí) y mide,
+ * mejor de N corridas, el análisis semántico y la generación de IR por
+ * separado. Con scopes lineales cada búsqueda recorre cientos de
+ * símbolos, así que el costo de comparar nombres domina.
+ *
+ * Uso: make bench-names [BENCH_DECLS=1000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+static const char *UNIT =
+    "type Point%d(a: Number) { coord%d = a; scaled%d(k: Number): Number => self.coord%d * k; }\n"
+    "function walk%d(n: Number): Number => "
+    "if (n < 1) 0 else walk%d(n - 1) + new Point%d(n).scaled%d(%d);\n";
+
+static char* make_source(int decls) {
+    size_t cap = (size_t)decls * 256 + 64, len = 0;
+    char *src = malloc(cap);
+    for (int i = 0; i < decls; i++) {
+        int prev = i > 0 ? i - 1 : 0;
+        len += (size_t)snprintf(src + len, cap - len, UNIT,
+                                i, i, i, i, i, prev, i, i, i);
+    }
+    snprintf(src + len, cap - len, "print(walk%d(3));\n", decls - 1);
+    return src;
+}
+
+int main(void) {
+    int decls = bench_env_int("BENCH_DECLS", 1000, 1);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(decls);
+    double best_sem = 1e9, best_cg = 1e9;
+    int errors = 0;
+    for (int r = 0; r < RUNS && !errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { errors = 1; hulk_ast_context_free(&ctx); break; }
+
+        double t0 = bench_now();
+        errors = hulk_semantic_analyze(&ctx, ast);
+        double t1 = bench_now();
+        if (!errors) errors = hulk_codegen(ast, "/dev/null");
+        double t2 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best_sem) best_sem = t1 - t0;
+        if (t2 - t1 < best_cg) best_cg = t2 - t1;
+    }
+
+    printf("entrada: %d tipos + %d funciones\n", decls, decls);
+    printf("  semántico  %8.3f s\n", best_sem);
+    printf("  codegen    %8.3f s\n", best_cg);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (errors) { fprintf(stderr, "el programa generado no compiló\n"); return 1; }
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * bench_opt_levels.c — Tiempo de ejecución según el nivel de optimización
+ *
+ * Compila a ejecutable cada programa en -O0, -O1, -O2, -O3, -Os y
+ * -O3 -march=native, y en -O2/-O3 sin los atributos que salen del
+ * análisis de efectos (columnas "-atr", para ver su aporte); verifica
+ * que todos impriman lo mismo (lo del .expected junto al programa, si
+ * existe) y muestra una tabla con el mejor de N ejecuciones de cada
+ * binario. La primera fila es un bucle
+ * con llamadas y objetos de BENCH_OPT_ITERS iteraciones; la segunda llama
+ * en cada vuelta a una función pura con argumento invariante, que solo se
+ * saca del bucle si tiene los atributos. Los programas del corpus son
+ * chicos y miden sobre todo el arranque del proceso.
+ *
+ * Uso: make bench-opt-levels [BENCH_OPT_ITERS=2000000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/ctfe/hulk_ctfe.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 5
+#define N_LEVELS (sizeof(levels) / sizeof(levels[0]))
+
+static const struct { const char *name; HulkCodegenOptions opts; } levels[] = {
+    { "-O0",      { HULK_OPT_O0, 0, 0 } },
+    { "-O1",      { HULK_OPT_O1, 0, 0 } },
+    { "-O2",      { HULK_OPT_O2, 0, 0 } },
+    { "-O3",      { HULK_OPT_O3, 0, 0 } },
+    { "-Os",      { HULK_OPT_OS, 0, 0 } },
+    { "-O3 nat",  { HULK_OPT_O3, 1, 0 } },
+    { "-O2 -atr", { HULK_OPT_O2, 0, 1 } },
+    { "-O3 -atr", { HULK_OPT_O3, 0, 1 } },
+};
+
+static const char *kernel_src =
+    "type Point(x: Number, y: Number) {\n"
+    "    x: Number = x;\n"
+    "    y: Number = y;\n"
+    "    norm2(): Number => self.x * self.x + self.y * self.y;\n"
+    "}\n"
+    "function step(v: Number, i: Number): Number => (v * 31 + i) %% 1009;\n"
+    "function run(n: Number): Number {\n"
+    "    let acc = 0, v = 1, i = 0 in {\n"
+    "        while (i < n) {\n"
+    "            v := step(v, i);\n"
+    "            acc := acc + new Point(v, i %% 13).norm2() %% 97;\n"
+    "            i := i + 1;\n"
+    "        };\n"
+    "        acc;\n"
+    "    };\n"
+    "}\n"
+    "print(run(%d));\n";
+
+static const char *pure_src =
+    "function f(x: Number): Number => sin(x) * cos(x) + sqrt(x) + exp(x / 7);\n"
+    "function run(n: Number, k: Number): Boolean {\n"
+    "    let acc = 0, i = 0 in {\n"
+    "        while (i < n) {\n"
+    "            acc := acc + f(k) + i;\n"
+    "            i := i + 1;\n"
+    "        };\n"
+    "        acc > 0;\n"
+    "    };\n"
+    "}\n"
+    "print(run(%d, 3));\n";
+
+static HulkCompiler hc;
+
+/* Compila `src` a `exe` con `opts`, como ./hulk. 0 si compiló. */
+static int build(const char *src, const char *exe, const HulkCodegenOptions *opts) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+    int errors = !ast || hulk_semantic_analyze(&ctx, ast);
+    if (!errors) {
+        hulk_ctfe_fold(&ctx, ast);
+        errors = hulk_codegen_to_executable_opts(ast, exe, opts);
+    }
+    fclose(stderr);
+    stderr = saved_err;
+    hulk_ast_context_free(&ctx);
+    return errors;
+}
+
+/* Una fila de la tabla; `expected` NULL compara contra la salida de -O0.
+ * 0 si todos los niveles compilaron e imprimieron lo esperado. */
+static int bench_row(const char *name, const char *src, const char *expected) {
+    const char *exe = "/tmp/bench_opt_levels_exe";
+    static char out[1 << 16], first[1 << 16];
+    int bad = 0;
+    printf("  %-26s", name);
+    for (size_t l = 0; l < N_LEVELS; l++) {
+        double t = build(src, exe, &levels[l].opts) ? -1
+                 : bench_run_exe(exe, RUNS, out, sizeof(out));
+        remove(exe);
+        if (l == 0) strcpy(first, out);
+        if (t < 0 || strcmp(out, expected ? expected : first) != 0) {
+            printf(" %8s", "FALLA");
+            bad = 1;
+        } else {
+            printf(" %8.4f", t);
+        }
+        fflush(stdout);
+    }
+    printf("\n");
+    return bad;
+}
+
+int main(int argc, char **argv) {
+    int iters = bench_env_int("BENCH_OPT_ITERS", 2000000, 1);
+
+    if (!bench_compiler_init(&hc)) return 1;
+
+    printf("segundos, mejor de %d ejecuciones\n", RUNS);
+    printf("  %-26s", "programa");
+    for (size_t l = 0; l < N_LEVELS; l++) printf(" %8s", levels[l].name);
+    printf("\n");
+
+    char src[4096];
+    snprintf(src, sizeof(src), kernel_src, iters);
+    char name[64];
+    snprintf(name, sizeof(name), "núcleo (%d it.)", iters);
+    int failures = bench_row(name, src, NULL);
+    snprintf(src, sizeof(src), pure_src, iters);
+    snprintf(name, sizeof(name), "llamada pura (%d it.)", iters);
+    failures += bench_row(name, src, NULL);
+
+    for (int i = 1; i < argc; i++) {
+        char *prog = bench_slurp(argv[i]);
+        char expected_path[512];
+        snprintf(expected_path, sizeof(expected_path), "%.*s.expected",
+                 (int)(strlen(argv[i]) - 5), argv[i]);
+        char *expected = bench_slurp(expected_path);
+        const char *base = strrchr(argv[i], '/');
+        failures += prog ? bench_row(base ? base + 1 : argv[i], prog, expected) : 1;
+        free(prog);
+        free(expected);
+    }
+    hulk_compiler_free(&hc);
+    if (failures) {
+        fprintf(stderr, "%d programas no compilaron o imprimieron otra cosa\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * bench_parse_pipeline.c — Lexer y parser en serie vs. en tubería
+ *
+ * Genera un programa HULK de varios MB y mide, mejor de N corridas:
+ *   - lex:      solo el lexer (drena el flujo en línea);
+ *   - inline:   hulk_rd_build_ast_mode con TOKEN_STREAM_INLINE;
+ *   - threaded: el mismo parser con el lexer en un hilo productor;
+ *   - parallel: ítems de nivel superior repartidos entre hilos
+ *               (hulk_parallel_build_ast, un hilo por CPU).
+ * Con dos núcleos libres `threaded` debería acercarse a max(lex, parse)
+ * en vez de a su suma, y `parallel` escalar con los núcleos. Verifica
+ * además que todos los modos consuman los mismos tokens.
+ *
+ * Uso: make bench-parse-pipeline [BENCH_MB=8]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ll1_builder.h"
+#include "../hulk_ast/builder/hulk_parallel_builder.h"
+#include "../generador_analizadores_lexicos/token_stream.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define RUNS 3
+
+static const char *UNIT =
+    "function f%d(x: Number): Number => let y = x * 2 + 1 in "
+    "if (y > 10) y else f%d(y + 1);\n"
+    "type P%d(a, b) { a = a; b = b; sum() => self.a + self.b; }\n"
+    "let g = (a: Number) -> a @ \"s\" in print(g(%d) @ [1, 2, 3]);\n";
+
+static char* make_source(size_t min_bytes) {
+    size_t cap = min_bytes + 1024, len = 0;
+    char *src = malloc(cap);
+    for (int i = 0; len < min_bytes; i++) {
+        if (cap - len < 512) src = realloc(src, cap *= 2);
+        len += (size_t)snprintf(src + len, cap - len, UNIT, i, i, i, i);
+    }
+    return src;
+}
+
+static double time_lex(DFA *dfa, const char *src, long *tokens) {
+    double t0 = bench_now();
+    TokenStream ts;
+    token_stream_open(&ts, dfa, src, TOKEN_STREAM_INLINE);
+    long n = 0;
+    for (;;) {
+        Token t = token_stream_next(&ts);
+        free(t.lexeme);
+        if (t.type == TOKEN_EOF) break;
+        n++;
+    }
+    token_stream_close(&ts);
+    *tokens = n;
+    return bench_now() - t0;
+}
+
+/* mode < 0: parseo paralelo por ítems */
+static double time_parse(DFA *dfa, const char *src, int mode, long *tokens) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    double t0 = bench_now();
+    HulkNode *ast = mode < 0
+        ? hulk_parallel_build_ast(&ctx, dfa, src, 0)
+        : hulk_rd_build_ast_mode(&ctx, dfa, src, (TokenStreamMode)mode);
+    double dt = bench_now() - t0;
+    HulkLL1Stats st;
+    hulk_ll1_last_stats(&st);
+    *tokens = ast ? st.tokens : -1;
+    hulk_ast_context_free(&ctx);
+    return dt;
+}
+
+int main(void) {
+    size_t mb = (size_t)bench_env_int("BENCH_MB", 8, 1);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    /* Calentamiento: construye la gramática (y sus avisos) fuera de la medición */
+    HulkASTContext warm;
+    hulk_ast_context_init(&warm);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");
+    hulk_rd_build_ast(&warm, hc.dfa, "1;");
+    fclose(stderr);
+    stderr = saved_err;
+    hulk_ast_context_free(&warm);
+
+    char *src = make_source(mb << 20);
+    double best_lex = 1e9, best_inline = 1e9, best_threaded = 1e9, best_parallel = 1e9;
+    long lex_tokens = 0, inline_tokens = 0, threaded_tokens = 0, parallel_tokens = 0;
+    for (int r = 0; r < RUNS; r++) {
+        double t;
+        if ((t = time_lex(hc.dfa, src, &lex_tokens)) < best_lex) best_lex = t;
+        if ((t = time_parse(hc.dfa, src, TOKEN_STREAM_INLINE, &inline_tokens)) < best_inline)
+            best_inline = t;
+        if ((t = time_parse(hc.dfa, src, TOKEN_STREAM_THREADED, &threaded_tokens)) < best_threaded)
+            best_threaded = t;
+        if ((t = time_parse(hc.dfa, src, -1, &parallel_tokens)) < best_parallel)
+            best_parallel = t;
+    }
+
+    double size_mb = strlen(src) / (1024.0 * 1024.0);
+    printf("entrada: %.1f MB, %ld tokens, %ld CPU(s)\n",
+           size_mb, lex_tokens, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  %-9s %8.3f s  %7.1f MB/s\n", "lex", best_lex, size_mb / best_lex);
+    printf("  %-9s %8.3f s  %7.1f MB/s\n", "inline", best_inline, size_mb / best_inline);
+    printf("  %-9s %8.3f s  %7.1f MB/s  (x%.2f)\n", "threaded", best_threaded,
+           size_mb / best_threaded, best_inline / best_threaded);
+    printf("  %-9s %8.3f s  %7.1f MB/s  (x%.2f)\n", "parallel", best_parallel,
+           size_mb / best_parallel, best_inline / best_parallel);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (inline_tokens < 0 || inline_tokens != threaded_tokens ||
+        inline_tokens != parallel_tokens) {
+        fprintf(stderr, "los modos no coinciden (%ld / %ld / %ld tokens)\n",
+                inline_tokens, threaded_tokens, parallel_tokens);
+        return 1;
+    }
+    return 0;
+}
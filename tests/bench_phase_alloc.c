@@ -0,0 +1,114 @@
+/*
+ * bench_phase_alloc.c — Pedidos al allocator del semántico y el codegen
+ *
+ * Genera F funciones con cuerpos de bloques, let anidados, while y for
+ * (un scope por bloque en cada fase) y F/8 tipos con métodos. Se linkea
+ * con -Wl,--wrap para contar los malloc/calloc/realloc/free que hacen
+ * los objetos del compilador (no los de LLVM) durante cada fase, y mide,
+ * mejor de N corridas, el tiempo de hulk_semantic_analyze y de
+ * hulk_codegen.
+ *
+ * Uso: make bench-phase-alloc [BENCH_SCOPE_FUNCS=10000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+/* ---------- Conteo de pedidos (-Wl,--wrap=...) ---------- */
+
+static long n_malloc, n_calloc, n_realloc, n_free;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void *p, size_t size);
+void  __real_free(void *p);
+
+void* __wrap_malloc(size_t size) { n_malloc++; return __real_malloc(size); }
+void* __wrap_calloc(size_t n, size_t size) { n_calloc++; return __real_calloc(n, size); }
+void* __wrap_realloc(void *p, size_t size) { n_realloc++; return __real_realloc(p, size); }
+void  __wrap_free(void *p) { if (p) n_free++; __real_free(p); }
+
+static long requests(void) { return n_malloc + n_calloc + n_realloc; }
+
+/* ---------- Entrada ---------- */
+
+static char* make_source(int funcs) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    for (int i = 0; i < funcs; i++) {
+        bench_put(&b, "function f%d(x: Number): Number {\n"
+                      "  let acc = 0, i = 0 in {\n"
+                      "    while (i < x) {\n"
+                      "      let a = i * %d, b = a + 1 in {\n"
+                      "        if (a > b) { acc := acc + a; } else { acc := acc + b; };\n"
+                      "      };\n"
+                      "      i := i + 1;\n"
+                      "    };\n", i, i % 7 + 1);
+        bench_put(&b, "    for (k in range(0, 3)) { let t = k + acc in acc := t; };\n"
+                      "    acc + %d;\n"
+                      "  };\n"
+                      "}\n", i);
+        if (i % 8 == 7)
+            bench_put(&b, "type T%d(v: Number) {\n"
+                          "  w: Number = v + 1;\n"
+                          "  get(): Number => let q = self.w in { q + f%d(q); };\n"
+                          "}\n", i, i);
+    }
+    bench_put(&b, "print(f%d(2));\n", funcs - 1);
+    return b.s;
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_SCOPE_FUNCS", 10000, 8);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(funcs);
+    double best_sem = 1e9, best_cg = 1e9;
+    long sem_req = 0, sem_free = 0, cg_req = 0, cg_free = 0;
+    int errors = 0;
+    for (int r = 0; r < RUNS && !errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { errors = 1; hulk_ast_context_free(&ctx); break; }
+
+        long r0 = requests(), f0 = n_free;
+        double t0 = bench_now();
+        errors = hulk_semantic_analyze_workers(&ctx, ast, 1);
+        double t1 = bench_now();
+        long r1 = requests(), f1 = n_free;
+        if (!errors) errors = hulk_codegen(ast, "/dev/null");
+        double t2 = bench_now();
+        sem_req = r1 - r0; sem_free = f1 - f0;
+        cg_req = requests() - r1; cg_free = n_free - f1;
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best_sem) best_sem = t1 - t0;
+        if (t2 - t1 < best_cg) best_cg = t2 - t1;
+    }
+
+    printf("entrada: %d funciones, %d tipos\n", funcs, funcs / 8);
+    printf("  semántico  %8.3f s  %9ld pedidos  %9ld free\n",
+           best_sem, sem_req, sem_free);
+    printf("  codegen    %8.3f s  %9ld pedidos  %9ld free\n",
+           best_cg, cg_req, cg_free);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (errors) { fprintf(stderr, "el programa generado no compiló\n"); return 1; }
+    return 0;
+}
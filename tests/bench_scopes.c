@@ -0,0 +1,98 @@
+/*
+ * bench_scopes.c — Costo de buscar símbolos en scopes grandes
+ *
+ * Genera un programa con F funciones globales que se llaman entre sí y
+ * una cadena de 4 tipos que heredan uno del otro, cada uno con M
+ * miembros (atributos y métodos que los leen vía self, propios y
+ * heredados). Cada identificador de una función se busca en el scope
+ * global y cada self.x / llamada a método en los miembros de los tipos:
+ * con búsqueda lineal el costo crece como F² y M². Mide, mejor de N
+ * corridas, semántico y codegen por separado.
+ *
+ * Uso: make bench-scopes [BENCH_SCOPE_FUNCS=10000] [BENCH_MEMBERS=500]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS  3
+#define TYPES 4
+
+static char* make_source(int funcs, int members) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    int attrs = members / 2, methods = members - attrs;
+    for (int t = 0; t < TYPES; t++) {
+        if (t) bench_put(&b, "type W%d inherits W%d {\n", t, t - 1);
+        else   bench_put(&b, "type W0 {\n");
+        for (int i = 0; i < attrs; i++)
+            bench_put(&b, "  a%d_%d = %d;\n", t, i, i);
+        // Cada método lee un atributo propio y uno del tipo raíz
+        for (int i = 0; i < methods; i++) {
+            bench_put(&b, "  m%d_%d(): Number => ", t, i);
+            bench_put(&b, "self.a%d_%d + self.a0_%d;\n", t, i % attrs, (i * 7) % attrs);
+        }
+        bench_put(&b, "}\n");
+    }
+
+    for (int i = 0; i < funcs; i++) {
+        int callee = i ? (int)((i * 7919L) % i) : 0;
+        if (i) bench_put(&b, "function f%d(x: Number): Number => "
+                             "if (x < 1) %d else f%d(x - 1) + 1;\n", i, i, callee);
+        else   bench_put(&b, "function f0(x: Number): Number => x;\n");
+    }
+
+    bench_put(&b, "let w = new W%d() in {\n", TYPES - 1);
+    for (int t = 0; t < TYPES; t++)
+        bench_put(&b, "  print(w.m%d_%d());\n", t, (methods - 1) * t / TYPES);
+    bench_put(&b, "  print(f%d(3));\n};\n", funcs - 1);
+    return b.s;
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_SCOPE_FUNCS", 10000, 1);
+    int members = bench_env_int("BENCH_MEMBERS", 500, 2);
+
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(funcs, members);
+    double best_sem = 1e9, best_cg = 1e9;
+    int errors = 0;
+    for (int r = 0; r < RUNS && !errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { errors = 1; hulk_ast_context_free(&ctx); break; }
+
+        double t0 = bench_now();
+        errors = hulk_semantic_analyze(&ctx, ast);
+        double t1 = bench_now();
+        if (!errors) errors = hulk_codegen(ast, "/dev/null");
+        double t2 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best_sem) best_sem = t1 - t0;
+        if (t2 - t1 < best_cg) best_cg = t2 - t1;
+    }
+
+    printf("entrada: %d funciones, %d tipos de %d miembros\n",
+           funcs, TYPES, members);
+    printf("  semántico  %8.3f s\n", best_sem);
+    printf("  codegen    %8.3f s\n", best_cg);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (errors) { fprintf(stderr, "el programa generado no compiló\n"); return 1; }
+    return 0;
+}
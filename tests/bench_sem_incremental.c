@@ -0,0 +1,140 @@
+/*
+ * bench_sem_incremental.c — Latencia edición → diagnósticos en modo watch
+ *
+ * Genera D declaraciones: funciones que se llaman entre sí (una de cada
+ * cuatro sin anotar el retorno, las demás con un let, un while y un if),
+ * un tipo cada dieciséis y una expresión final. Simula dos ediciones de
+ * la función del medio: cambiar una constante de su cuerpo y cambiarle el
+ * tipo de retorno (sus llamadores dependen de él). Para cada una mide, mejor de N corridas, el parseo del
+ * texto editado y el análisis semántico completo contra el incremental
+ * (con el estado de la versión sin editar), y comprueba que ambos den los
+ * mismos errores.
+ *
+ * Uso: make bench-sem-incremental [BENCH_INC_DECLS=20000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../error_handler.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#define RUNS 5
+
+/* edit: 0 sin editar, 1 constante en el cuerpo, 2 tipo de retorno */
+static char* make_source(int decls, int edit) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    int funcs = decls - decls / 16 - 1;
+    int mid = funcs / 2 | 1;
+    for (int i = 0; i < funcs; i++) {
+        int callee = ((i * 7 + 3) % (funcs / 2)) * 2 + 1;
+        if (i % 4 == 0)
+            bench_put(&b, "function f%d(x: Number) => x * %d + 1;\n", i, i % 13);
+        if (i % 4 != 0) {
+            bench_put(&b, "function f%d(x: Number): ", i);
+            bench_put(&b, i == mid && edit == 2 ? "Object {\n" : "Number {\n");
+            bench_put(&b, "  let a = x + %d, s = \"v\" @ x in {\n"
+                          "    while (a > 100) {\n"
+                          "      a := a - %d;\n"
+                          "    };\n", i == mid && edit == 1 ? 99 : i % 5, i % 7 + 1);
+            bench_put(&b, "    print(s);\n"
+                          "    if (a > 10) f%d(a - 10) else a * 2;\n"
+                          "  };\n"
+                          "}\n", callee);
+        }
+        if (i % 16 == 15)
+            bench_put(&b, "type T%d(v: Number) {\n"
+                          "  w: Number = v + 1;\n"
+                          "  get(): Number => self.w + f%d(self.w);\n"
+                          "}\n", i, callee);
+    }
+    bench_put(&b, "print(f0(1) + f%d(2));\n", mid);
+    return b.s;
+}
+
+static void quiet(LogLevel level, const char *module, const char *fmt,
+                  va_list args) {
+    (void)level; (void)module; (void)fmt; (void)args;
+}
+
+static HulkCompiler hc;
+
+/* Parsea `src` y lo analiza entero (state NULL) o incremental; deja los
+ * tiempos de cada fase y retorna los errores. */
+static int analyze(HulkSemanticState *state, const char *src,
+                   double *parse, double *sem) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    double t0 = bench_now();
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+    double t1 = bench_now();
+    int errors = -1;
+    if (ast)
+        errors = state ? hulk_semantic_analyze_incremental(state, &ctx, ast, src)
+                       : hulk_semantic_analyze_workers(&ctx, ast, 1);
+    double t2 = bench_now();
+    hulk_ast_context_free(&ctx);
+    *parse = t1 - t0;
+    *sem = t2 - t1;
+    return errors;
+}
+
+static int measure(const char *name, const char *base, const char *edited) {
+    double parse = 1e9, full = 1e9, inc = 1e9, p, s;
+    int full_errors = 0, inc_errors = 0, checked = 0;
+    for (int r = 0; r < RUNS; r++) {
+        full_errors = analyze(NULL, edited, &p, &s);
+        if (p < parse) parse = p;
+        if (s < full) full = s;
+    }
+    for (int r = 0; r < RUNS; r++) {
+        HulkSemanticState *state = hulk_semantic_state_new();
+        analyze(state, base, &p, &s);
+        inc_errors = analyze(state, edited, &p, &s);
+        checked = hulk_semantic_state_checked(state);
+        hulk_semantic_state_free(state);
+        if (s < inc) inc = s;
+    }
+    printf("  %s\n", name);
+    printf("    parseo                  %8.3f s\n", parse);
+    printf("    semántico completo      %8.3f s   (%d errores)\n",
+           full, full_errors);
+    printf("    semántico incremental   %8.3f s   (%d declaraciones "
+           "verificadas)\n", inc, checked);
+    if (full_errors != inc_errors) {
+        fprintf(stderr, "el incremental dio %d errores, el completo %d\n",
+                inc_errors, full_errors);
+        return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    int decls = bench_env_int("BENCH_INC_DECLS", 20000, 64);
+
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *base = make_source(decls, 0);
+    char *body = make_source(decls, 1);
+    char *sig  = make_source(decls, 2);
+    ErrorHandlerFn prev = error_handler_get();
+    error_handler_set(quiet);   /* avisos de la gramática, errores de la edición */
+
+    int funcs = decls - decls / 16 - 1;
+    printf("entrada: %d funciones, %d tipos\n", funcs, funcs / 16);
+    int ok = measure("edición del cuerpo", base, body) &&
+             measure("edición del tipo de retorno", base, sig);
+
+    error_handler_set(prev);
+    free(base);
+    free(body);
+    free(sig);
+    hulk_compiler_free(&hc);
+    return ok ? 0 : 1;
+}
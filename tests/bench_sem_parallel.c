@@ -0,0 +1,99 @@
+/*
+ * bench_sem_parallel.c — Verificación de cuerpos en serie y repartida
+ *
+ * Genera F funciones y F/4 tipos con cuerpos de varias sentencias; una de
+ * cada cuatro funciones no anota el retorno (lo publica al verificarse y
+ * la llaman las tres siguientes) y las demás se llaman entre sí hacia
+ * adelante y hacia atrás. Mide, mejor de N
+ * corridas, el análisis semántico con 1 hilo y con W, y comprueba que
+ * ambos den la misma cantidad de errores.
+ *
+ * Uso: make bench-sem-parallel [BENCH_FUNCS=50000] [BENCH_WORKERS=4]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+static char* make_source(int funcs) {
+    BenchBuf b;
+    bench_buf_init(&b);
+
+    for (int i = 0; i < funcs; i++) {
+        /* anotada (impar, antes o después) y sin anotar anterior */
+        int callee = ((i * 7 + 3) % (funcs / 2)) * 2 + 1;
+        int inferred = i / 4 * 4;
+        if (i % 4 == 0)
+            bench_put(&b, "function f%d(x: Number) => x * %d + 1;\n", i, i % 13);
+        else
+            bench_put(&b, "function f%d(x: Number): Number {\n"
+                          "  let a = x + 1, b = a * 2 in\n"
+                          "    if (a > b) f%d(a) else b - a;\n", i, callee);
+        if (i % 4 != 0)
+            bench_put(&b, "  let s = \"v\" @ x in print(s);\n"
+                          "  f%d(x) + %d;\n"
+                          "}\n", inferred, i);
+        if (i % 4 == 3)
+            bench_put(&b, "type T%d(v: Number) {\n"
+                          "  w: Number = v + 1;\n"
+                          "  get(): Number => self.w + f%d(self.w);\n"
+                          "  twice() => self.get() * 2;\n"
+                          "}\n", i, callee);
+    }
+    bench_put(&b, "print(f0(1) + new T3(2).twice());\n");
+    return b.s;
+}
+
+/* Mejor tiempo del análisis con `workers` hilos; deja los errores. */
+static double time_analyze(HulkCompiler *hc, const char *src, int workers,
+                           int *errors) {
+    double best = 1e9;
+    for (int r = 0; r < RUNS; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc->dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        if (!ast) { *errors = -1; hulk_ast_context_free(&ctx); return 0; }
+
+        double t0 = bench_now();
+        *errors = hulk_semantic_analyze_workers(&ctx, ast, workers);
+        double t1 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_FUNCS", 50000, 4);
+    int workers = bench_env_int("BENCH_WORKERS", 4, 2);
+    HulkCompiler hc;
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *src = make_source(funcs);
+    int serial_errors = 0, parallel_errors = 0;
+    double serial = time_analyze(&hc, src, 1, &serial_errors);
+    double parallel = time_analyze(&hc, src, workers, &parallel_errors);
+
+    printf("entrada: %d funciones, %d tipos\n", funcs, funcs / 4);
+    printf("  semántico, 1 hilo    %8.3f s\n", serial);
+    printf("  semántico, %2d hilos  %8.3f s\n", workers, parallel);
+
+    free(src);
+    hulk_compiler_free(&hc);
+    if (serial_errors || parallel_errors) {
+        fprintf(stderr, "el programa generado no compiló (%d / %d errores)\n",
+                serial_errors, parallel_errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * bench_tree_shake.c — Biblioteca grande antepuesta a un programa chico
+ *
+ * Genera una biblioteca de F funciones que se llaman entre sí y F/8
+ * tipos con métodos (algunos heredan), y un programa de tres líneas que
+ * usa dos funciones y un tipo. Compara el programa con solo lo que usa
+ * contra el mismo programa con la biblioteca entera delante: mejor de N
+ * corridas del codegen a IR y del codegen a ejecutable (objeto + link),
+ * el tamaño del IR y el del binario. Con tree shaking ambas columnas
+ * deberían quedar cerca.
+ *
+ * Uso: make bench-tree-shake [BENCH_SHAKE_FUNCS=5000]
+ */
+
+#include "../hulk_compiler.h"
+#include "../hulk_ast/builder/hulk_ast_builder.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/codegen/hulk_codegen.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define RUNS 3
+
+static const char *program =
+    "let s = new Shape0(2) in {\n"
+    "    print(lib0(3) + lib1(4));\n"
+    "    print(s.area());\n"
+    "};\n";
+
+static char* make_source(int funcs) {
+    BenchBuf b;
+    bench_buf_init(&b);
+    for (int i = 0; i < funcs; i++) {
+        bench_put(&b, "function lib%d(x: Number): Number {\n"
+                      "  let a = x * %d in if (a > 100) a - lib%d(a / 2) else a + 1;\n"
+                      "}\n", i, i % 7 + 2, i / 2);
+        if (i % 8 == 0) {
+            int t = i / 8;
+            if (t % 4 == 0)
+                bench_put(&b, "type Shape%d(k: Number) {\n", t);
+            else
+                bench_put(&b, "type Shape%d(k: Number) inherits Shape%d(k) {\n",
+                          t, t - t % 4);
+            bench_put(&b, "  w: Number = k + %d;\n"
+                          "  area(): Number => self.w * lib%d(self.w);\n"
+                          "  scale(f: Number): Number => self.w * f;\n"
+                          "}\n", t, i);
+        }
+    }
+    bench_put(&b, "%s", program);
+    return b.s;
+}
+
+static long file_size(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+typedef struct { double ir, exe; long ir_bytes, exe_bytes; int errors; } Result;
+
+static HulkCompiler hc;
+
+static Result measure(const char *src) {
+    Result res = { 1e9, 1e9, 0, 0, 0 };
+    for (int r = 0; r < RUNS && !res.errors; r++) {
+        HulkASTContext ctx;
+        hulk_ast_context_init(&ctx);
+        FILE *saved_err = stderr;
+        stderr = fopen("/dev/null", "w");  /* avisos de la gramática */
+        HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+        fclose(stderr);
+        stderr = saved_err;
+        res.errors = !ast || hulk_semantic_analyze(&ctx, ast);
+        if (res.errors) { hulk_ast_context_free(&ctx); break; }
+
+        double t0 = bench_now();
+        res.errors = hulk_codegen(ast, "/tmp/bench_tree_shake.ll");
+        double t1 = bench_now();
+        if (!res.errors)
+            res.errors = hulk_codegen_to_executable(ast, "/tmp/bench_tree_shake");
+        double t2 = bench_now();
+        hulk_ast_context_free(&ctx);
+        if (t1 - t0 < res.ir) res.ir = t1 - t0;
+        if (t2 - t1 < res.exe) res.exe = t2 - t1;
+    }
+    res.ir_bytes = file_size("/tmp/bench_tree_shake.ll");
+    res.exe_bytes = file_size("/tmp/bench_tree_shake");
+    remove("/tmp/bench_tree_shake.ll");
+    remove("/tmp/bench_tree_shake");
+    return res;
+}
+
+int main(void) {
+    int funcs = bench_env_int("BENCH_SHAKE_FUNCS", 5000, 8);
+
+    if (!bench_compiler_init(&hc)) return 1;
+
+    char *small = make_source(2);     /* justo lo que usa el programa */
+    char *big = make_source(funcs);
+    Result a = measure(small);
+    Result b = measure(big);
+
+    printf("biblioteca: %d funciones, %d tipos\n", funcs, (funcs + 7) / 8);
+    printf("                        programa solo   con biblioteca\n");
+    printf("  codegen a IR          %10.3f s    %10.3f s\n", a.ir, b.ir);
+    printf("  codegen a ejecutable  %10.3f s    %10.3f s\n", a.exe, b.exe);
+    printf("  IR                    %10ld B    %10ld B\n", a.ir_bytes, b.ir_bytes);
+    printf("  binario               %10ld B    %10ld B\n", a.exe_bytes, b.exe_bytes);
+
+    free(small);
+    free(big);
+    hulk_compiler_free(&hc);
+    if (a.errors || b.errors) {
+        fprintf(stderr, "el programa generado no compiló\n");
+        return 1;
+    }
+    return 0;
+}
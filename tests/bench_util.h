@@ -0,0 +1,101 @@
+/*
+ * bench_util.h — Utilidades comunes de los benchmarks
+ *
+ *   bench_now            reloj monotónico en segundos
+ *   bench_env_int        parámetro entero por variable de entorno
+ *   bench_compiler_init  hulk_compiler_init sin el ruido por stdout
+ *   bench_slurp          archivo entero en memoria
+ *   bench_run_exe        mejor tiempo de N ejecuciones de un binario
+ *   BenchBuf, bench_put  buffer que crece para generar fuentes con printf
+ *
+ * Solo para los bench_*.c: todo es static, sin objeto propio.
+ */
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include "../hulk_compiler.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Valor entero de la variable `name`; `fallback` si falta o es menor
+ * que `min`. */
+static inline int bench_env_int(const char *name, int fallback, int min) {
+    const char *env = getenv(name);
+    int v = env ? atoi(env) : fallback;
+    return v < min ? fallback : v;
+}
+
+/* El compilador imprime el progreso del DFA por stdout. 1 si inicializó. */
+static inline int bench_compiler_init(HulkCompiler *hc) {
+    FILE *saved = stdout;
+    stdout = fopen("/dev/null", "w");
+    int ok = hulk_compiler_init(hc);
+    fclose(stdout);
+    stdout = saved;
+    if (!ok) fprintf(stderr, "no se pudo inicializar el compilador\n");
+    return ok;
+}
+
+/* NULL si no se puede leer. */
+static inline char* bench_slurp(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    rewind(f);
+    char *buf = malloc((size_t)len + 1);
+    size_t got = fread(buf, 1, (size_t)len, f);
+    buf[got] = '\0';
+    fclose(f);
+    return buf;
+}
+
+/* Mejor tiempo de `runs` ejecuciones de `exe`; deja en `out` lo que
+ * imprimió. -1 si no se pudo correr o terminó con error. */
+static inline double bench_run_exe(const char *exe, int runs, char *out, size_t cap) {
+    double best = 1e9;
+    for (int r = 0; r < runs; r++) {
+        double t0 = bench_now();
+        FILE *p = popen(exe, "r");
+        if (!p) return -1;
+        size_t n = fread(out, 1, cap - 1, p);
+        out[n] = '\0';
+        if (pclose(p) != 0) return -1;
+        double t = bench_now() - t0;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+typedef struct { char *s; size_t len, cap; } BenchBuf;
+
+static inline void bench_buf_init(BenchBuf *b) {
+    b->cap = 1 << 16;
+    b->len = 0;
+    b->s = malloc(b->cap);
+    b->s[0] = '\0';
+}
+
+__attribute__((format(printf, 2, 3)))
+static inline void bench_put(BenchBuf *b, const char *fmt, ...) {
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(b->s + b->len, b->cap - b->len, fmt, args);
+        va_end(args);
+        if ((size_t)n < b->cap - b->len) { b->len += (size_t)n; return; }
+        b->cap *= 2;
+        b->s = realloc(b->s, b->cap);
+    }
+}
+
+#endif /* BENCH_UTIL_H */
@@ -11,6 +11,10 @@
  *   - Tipos de usuario con atributos y métodos
  *   - Concatenación de strings
  *   - Decoradores (composición de funciones)
+ *   - Tree shaking: solo se emite lo alcanzable desde el programa
+ *   - CTFE: plegado en compilación, con la misma salida que sin él
+ *   - Atributos de LLVM según los efectos de cada función
+ *   - Niveles de optimización: mismas salidas en -O1..-Os
  *   - Verificación de módulo LLVM (sin crashear)
  *   - Escritura del IR a archivo
  */
@@ -20,11 +24,14 @@
 #include "../hulk_ast/core/hulk_ast.h"
 #include "../hulk_ast/builder/hulk_ast_builder.h"
 #include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../hulk_ast/ctfe/hulk_ctfe.h"
 #include "../hulk_ast/codegen/hulk_codegen.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <dirent.h>
 
 /* ============================================================
  *  Fixture: compilador compartido
@@ -43,9 +50,12 @@ static void ensure_compiler(void) {
     }
 }
 
-/* Helper: build AST + semantic + codegen → .ll file.
+/* Helper: build AST + semantic (+ CTFE si folded != NULL, que recibe
+ * los nodos plegados) + codegen → .ll file, o ejecutable si exe.
  * Returns 0 on success, >0 on error. */
-static int codegen_to_file(const char *src, const char *out_file) {
+static int codegen_build_opts(const char *src, const char *out_file,
+                              int *folded, int exe,
+                              const HulkCodegenOptions *opts) {
     ensure_compiler();
     HulkASTContext ctx;
     hulk_ast_context_init(&ctx);
@@ -58,7 +68,9 @@ static int codegen_to_file(const char *src, const char *out_file) {
     if (ast) {
         int sem_err = hulk_semantic_analyze(&ctx, ast);
         if (sem_err == 0) {
-            result = hulk_codegen(ast, out_file);
+            if (folded) *folded = hulk_ctfe_fold(&ctx, ast);
+            result = exe ? hulk_codegen_to_executable_opts(ast, out_file, opts)
+                         : hulk_codegen_opts(ast, out_file, opts);
         } else {
             result = sem_err;
         }
@@ -71,10 +83,21 @@ static int codegen_to_file(const char *src, const char *out_file) {
     return result;
 }
 
-/* Helper: codegen and check that .ll file was created and contains pattern */
-static int codegen_contains(const char *src, const char *pattern) {
+static int codegen_build(const char *src, const char *out_file,
+                         int *folded, int exe) {
+    return codegen_build_opts(src, out_file, folded, exe, NULL);
+}
+
+static int codegen_to_file(const char *src, const char *out_file) {
+    return codegen_build(src, out_file, NULL, 0);
+}
+
+/* Helper: codegen (con CTFE si folded != NULL) and check that .ll file
+ * was created and contains pattern */
+static int codegen_contains_ctfe(const char *src, const char *pattern,
+                                 int *folded) {
     const char *tmp = "/tmp/hulk_test.ll";
-    int ret = codegen_to_file(src, tmp);
+    int ret = codegen_build(src, tmp, folded, 0);
     if (ret != 0) return 0;
 
     FILE *f = fopen(tmp, "r");
@@ -93,6 +116,31 @@ static int codegen_contains(const char *src, const char *pattern) {
     return found;
 }
 
+static int codegen_contains(const char *src, const char *pattern) {
+    return codegen_contains_ctfe(src, pattern, NULL);
+}
+
+/* Helper: compila a ejecutable, lo corre y deja su salida en out.
+ * Returns 0 on success. */
+static int run_program_opts(const char *src, int ctfe, char *out, size_t size,
+                            const HulkCodegenOptions *opts) {
+    const char *exe = "/tmp/hulk_test_run";
+    int folded;
+    out[0] = '\0';
+    if (codegen_build_opts(src, exe, ctfe ? &folded : NULL, 1, opts) != 0) return 1;
+    FILE *p = popen(exe, "r");
+    if (!p) return 1;
+    size_t n = fread(out, 1, size - 1, p);
+    out[n] = '\0';
+    int rc = pclose(p);
+    unlink(exe);
+    return rc;
+}
+
+static int run_program(const char *src, int ctfe, char *out, size_t size) {
+    return run_program_opts(src, ctfe, out, size, NULL);
+}
+
 /* Helper: just check codegen succeeds (returns 0) */
 static int codegen_ok(const char *src) {
     const char *tmp = "/tmp/hulk_test_ok.ll";
@@ -254,6 +302,312 @@ TEST(cg_type_ir_has_struct) {
         "Counter"));
 }
 
+/* ============================================================
+ *  SUITE: Tree shaking
+ * ============================================================ */
+
+TEST(cg_shake_unused_function) {
+    const char *src =
+        "function used(x: Number): Number -> x + 1;"
+        "function unused(x: Number): Number -> used(x) * 2;"
+        "print(used(1));";
+    ASSERT(codegen_contains(src, "define double @used("));
+    ASSERT(!codegen_contains(src, "@unused("));
+    ASSERT(!codegen_contains(src, "unused__closure_cell"));
+}
+
+TEST(cg_shake_keeps_vtable_slots) {
+    /* speak se despacha por vtable: viven las dos implementaciones; bark
+     * no se llama nunca y Cat no se nombra */
+    const char *src =
+        "type Animal() { speak(): String -> \"...\"; bark(): String -> \"!\"; }"
+        "type Dog() inherits Animal() { speak(): String -> \"guau\"; }"
+        "type Cat() { speak(): String -> \"miau\"; }"
+        "let a: Animal = new Dog() in print(a.speak());";
+    ASSERT(codegen_contains(src, "define ptr @Animal_speak("));
+    ASSERT(codegen_contains(src, "define ptr @Dog_speak("));
+    ASSERT(!codegen_contains(src, "Animal_bark"));
+    ASSERT(!codegen_contains(src, "Cat_"));
+}
+
+TEST(cg_shake_iterator_protocol) {
+    /* el for llama next/current sin nombrarlos */
+    ASSERT(codegen_contains(
+        "type Count(n: Number) {"
+        "  i: Number = 0;"
+        "  last: Number = n;"
+        "  next(): Boolean { self.i := self.i + 1; self.i <= self.last; }"
+        "  current(): Number -> self.i;"
+        "}"
+        "for (x in new Count(3)) print(x);",
+        "define i1 @Count_next("));
+}
+
+/* ============================================================
+ *  SUITE: CTFE
+ * ============================================================ */
+
+TEST(ctfe_folds_pure_recursion) {
+    /* fact(5) se vuelve 120 y fact deja de estar viva */
+    const char *src =
+        "function fact(n) -> if (n == 0) 1 else n * fact(n - 1);"
+        "print(fact(5));";
+    int folded = 0;
+    ASSERT(codegen_contains_ctfe(src, "double 1.200000e+02", &folded));
+    ASSERT_EQ(1, folded);
+    ASSERT(!codegen_contains_ctfe(src, "@fact(", &folded));
+    ASSERT(codegen_contains(src, "@fact("));
+}
+
+TEST(ctfe_constant_let_and_strings) {
+    /* los usos de k se reemplazan y el @ / @@ se arma con "%g" */
+    int folded = 0;
+    ASSERT(codegen_contains_ctfe(
+        "let k = 0.1, s = \"a\" in print(s @ k + 0.2 @@ (k < 1));",
+        "a0.3 true", &folded));
+    ASSERT(folded >= 5);
+}
+
+TEST(ctfe_leaves_impure_and_unbounded) {
+    /* print en el cuerpo, variable reasignada, bucle que no termina */
+    const char *src =
+        "function noisy(x) { print(x); x; }"
+        "function spin(x) => let i = 0 in while (true) { i := i + 1; };"
+        "let v = 2 in {"
+        "  print(noisy(3));"
+        "  v := v + 1;"
+        "  print(v);"
+        "  if (v > 100) print(spin(1)) else print(0);"
+        "};";
+    int folded = -1;
+    ASSERT(codegen_contains_ctfe(src, "@noisy(", &folded));
+    ASSERT(codegen_contains_ctfe(src, "@spin(", &folded));
+    ASSERT_EQ(0, folded);
+}
+
+TEST(ctfe_matches_runtime) {
+    const char *src =
+        "function pw(x) => x ^ 0.5 + 7 % 3 - (-x);"
+        "function swap(a, b) => if (a > 0) swap(b, a - 1) else b;"
+        "function same(a: String, b: String): Boolean => a == b;"
+        "function count(n) => let i = 0 in while (i < n) { i := i + 1; };"
+        "{"
+        "  print(pw(4));"
+        "  print(swap(3, 4));"
+        "  print(same(\"x\" @ 1, \"x1\"));"
+        "  print(count(10));"
+        "  print(1 / 0 @ (0 / 0 == 0 / 0));"
+        "  print(!(1 == 1) || 3 > 2);"
+        "  print(sin(1) @@ log(2, 8) @@ 1000000 * 1000000 * 1000000 @@ 1 / 3);"
+        "};";
+    char with[1024], without[1024];
+    ASSERT_EQ(0, run_program(src, 1, with, sizeof(with)));
+    ASSERT_EQ(0, run_program(src, 0, without, sizeof(without)));
+    ASSERT(with[0] != '\0');
+    ASSERT_STR_EQ(without, with);
+}
+
+TEST(ctfe_keeps_nan_at_runtime) {
+    /* un NaN no se pliega: su signo es el de la instrucción que lo da */
+    const char *srcs[] = {
+        "print(0/0);",
+        "function s(x: Number): String -> \"v=\" @ x; print(s(0/0));",
+        "function s(x: Number): String -> \"v=\" @ x;"
+        "let k = 0 in print(s(k / k));",
+    };
+    const char *expected[] = { "nan\n", "v=nan\n", "v=nan\n" };
+    for (size_t i = 0; i < sizeof(srcs) / sizeof(srcs[0]); i++) {
+        char with[64], without[64];
+        ASSERT_EQ(0, run_program(srcs[i], 1, with, sizeof(with)));
+        ASSERT_EQ(0, run_program(srcs[i], 0, without, sizeof(without)));
+        ASSERT_STR_EQ(expected[i], without);
+        ASSERT_STR_EQ(without, with);
+    }
+}
+
+/* ============================================================
+ *  SUITE: Atributos de efectos
+ * ============================================================ */
+
+TEST(cg_attrs_fresh_return) {
+    /* mk devuelve un objeto nuevo: noalias en la definición y en la
+     * llamada por la celda */
+    const char *src =
+        "type P(x: Number) { x: Number = x; }"
+        "function mk(v: Number): P => new P(v);"
+        "print(mk(3).x);";
+    ASSERT(codegen_contains(src, "define noalias ptr @mk("));
+    ASSERT(codegen_contains(src, "call noalias ptr"));
+    ASSERT(!codegen_contains("function id(p: Object): Object => p; print(id(1));",
+                             "define noalias ptr @id("));
+}
+
+TEST(cg_attrs_pure_and_readonly) {
+    /* readnone/readonly hasta LLVM 15, memory(...) desde el 16 */
+    const char *pure =
+        "function sq(x: Number): Number => x * x;"
+        "print(sq(3));";
+    ASSERT(codegen_contains(pure, "willreturn"));
+    ASSERT(codegen_contains(pure, "readnone") ||
+           codegen_contains(pure, "memory(none)"));
+    const char *reads =
+        "type P(x: Number) { x: Number = x; getx(): Number => self.x; }"
+        "print(new P(2).getx());";
+    ASSERT(codegen_contains(reads, "readonly") ||
+           codegen_contains(reads, "memory(read)"));
+}
+
+TEST(cg_attrs_keep_output) {
+    /* con atributos el optimizador de LLVM puede borrar llamadas: la
+     * salida no cambia */
+    char out[256];
+    ASSERT_EQ(0, run_program(
+        "function sq(x: Number): Number => x * x;"
+        "function say(x: Number): Number { print(x); x; }"
+        "function loop(n: Number): Number => let i = 0 in while (i < n) { i := i + 1; };"
+        "{ sq(2); say(5); loop(3); print(sq(4)); };", 0, out, sizeof(out)));
+    ASSERT_STR_EQ("5\n16\n", out);
+}
+
+/* ============================================================
+ *  SUITE: Genéricos
+ * ============================================================ */
+
+TEST(cg_generic_field_is_unboxed) {
+    /* Box<Number> guarda un double, no un Object */
+    const char *src =
+        "type Box<T>(v: T) { v: T = v; get(): T => self.v; }"
+        "print(new Box<Number>(3).get());";
+    ASSERT(codegen_contains(src, "%\"Box<Number>\" = type { i32, double, double }"));
+    ASSERT(codegen_contains(src, "define double @\"Box<Number>_get\"("));
+}
+
+TEST(cg_generic_instances_run) {
+    char out[256];
+    ASSERT_EQ(0, run_program(
+        "function max<T>(a: T, b: T): T => if (a > b) a else b;"
+        "function twice<T>(f: (T) -> T, x: T): T => f(f(x));"
+        "type Pair<A, B>(a: A, b: B) {"
+        "  a: A = a; b: B = b;"
+        "  first(): A => self.a;"
+        "  swap(): Pair<B, A> => new Pair<B, A>(self.b, self.a);"
+        "}"
+        "{"
+        "  print(max<Number>(3, 7));"
+        "  print(twice<String>(function (s: String): String => s @ \"!\", \"hi\"));"
+        "  print(new Pair<Number, String>(1, \"uno\").swap().first());"
+        "};", 0, out, sizeof(out)));
+    ASSERT_STR_EQ("7\nhi!!\nuno\n", out);
+}
+
+TEST(cg_less_than_before_paren_is_comparison) {
+    /* `both` no es genérica: `a < b, c > (d)` son dos comparaciones */
+    char out[64];
+    ASSERT_EQ(0, run_program(
+        "function both(x: Boolean, y: Boolean): Boolean -> x && y;"
+        "let a = 1, b = 2, c = 3, d = 1 in print(both(a < b, c > (d)));",
+        0, out, sizeof(out)));
+    ASSERT_STR_EQ("true\n", out);
+}
+
+/* ============================================================
+ *  SUITE: Niveles de optimización
+ * ============================================================ */
+
+TEST(cg_opt_parse_option) {
+    HulkCodegenOptions o = { HULK_OPT_DEFAULT, 0, 0 };
+    ASSERT(hulk_codegen_parse_option(&o, "-O0"));
+    ASSERT_EQ(HULK_OPT_O0, o.level);
+    ASSERT(hulk_codegen_parse_option(&o, "-O3"));
+    ASSERT_EQ(HULK_OPT_O3, o.level);
+    ASSERT(hulk_codegen_parse_option(&o, "-Os"));
+    ASSERT_EQ(HULK_OPT_OS, o.level);
+    ASSERT(hulk_codegen_parse_option(&o, "-march=native"));
+    ASSERT_EQ(1, o.native);
+    ASSERT(!hulk_codegen_parse_option(&o, "-O4"));
+    ASSERT(!hulk_codegen_parse_option(&o, "-march=x"));
+    ASSERT_EQ(HULK_OPT_OS, o.level);
+}
+
+/* Lee `path` entero en memoria (NULL si no existe). */
+static char* slurp(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    rewind(f);
+    char *buf = malloc((size_t)len + 1);
+    size_t got = fread(buf, 1, (size_t)len, f);
+    buf[got] = '\0';
+    fclose(f);
+    return buf;
+}
+
+TEST(cg_opt_promotes_locals) {
+    /* Desde -O1 los locales dejan de vivir en allocas y el módulo lleva
+     * el triple del destino; -O0 deja el IR como antes */
+    const char *src =
+        "function sum(n: Number): Number {"
+        "  let s = 0, i = 0 in { while (i < n) { s := s + i; i := i + 1; }; s; };"
+        "}"
+        "print(sum(10));";
+    const char *tmp = "/tmp/hulk_test_opt.ll";
+    HulkCodegenOptions o2 = { HULK_OPT_O2, 0, 0 };
+    ASSERT_EQ(0, codegen_build_opts(src, tmp, NULL, 0, &o2));
+    char *ir = slurp(tmp);
+    ASSERT(ir != NULL);
+    ASSERT(strstr(ir, "alloca") == NULL);
+    ASSERT(strstr(ir, "target triple") != NULL);
+    free(ir);
+    ASSERT_EQ(0, codegen_build_opts(src, tmp, NULL, 0, NULL));
+    ir = slurp(tmp);
+    ASSERT(ir != NULL);
+    ASSERT(strstr(ir, "alloca") != NULL);
+    ASSERT(strstr(ir, "target triple") == NULL);
+    free(ir);
+    unlink(tmp);
+}
+
+TEST(cg_opt_programs_match_expected) {
+    /* Cada programa de tests/hulk_programs imprime lo mismo en todo nivel */
+    static const HulkCodegenOptions levels[] = {
+        { HULK_OPT_O1, 0, 0 }, { HULK_OPT_O2, 0, 0 },
+        { HULK_OPT_O3, 1, 0 }, { HULK_OPT_OS, 0, 0 },
+    };
+    DIR *dir = opendir("tests/hulk_programs");
+    ASSERT(dir != NULL);
+    int programs = 0, mismatches = 0;
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL) {
+        size_t n = strlen(e->d_name);
+        if (n < 5 || strcmp(e->d_name + n - 5, ".hulk") != 0) continue;
+        char path[512];
+        snprintf(path, sizeof(path), "tests/hulk_programs/%.*s", (int)(n - 5), e->d_name);
+        size_t base = strlen(path);
+        strcpy(path + base, ".hulk");
+        char *src = slurp(path);
+        strcpy(path + base, ".expected");
+        char *expected = slurp(path);
+        if (src && expected) {
+            programs++;
+            for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+                char out[8192];
+                if (run_program_opts(src, 1, out, sizeof(out), &levels[l]) != 0 ||
+                    strcmp(out, expected) != 0) {
+                    fprintf(stderr, "  %s difiere en el nivel %d\n",
+                            e->d_name, (int)levels[l].level);
+                    mismatches++;
+                }
+            }
+        }
+        free(src);
+        free(expected);
+    }
+    closedir(dir);
+    ASSERT(programs > 0);
+    ASSERT_EQ(0, mismatches);
+}
+
 /* ============================================================
  *  SUITE: Bloques
  * ============================================================ */
@@ -388,6 +742,33 @@ int main(void) {
     RUN_TEST(cg_type_simple);
     RUN_TEST(cg_type_ir_has_struct);
 
+    TEST_SUITE("Tree shaking");
+    RUN_TEST(cg_shake_unused_function);
+    RUN_TEST(cg_shake_keeps_vtable_slots);
+    RUN_TEST(cg_shake_iterator_protocol);
+
+    TEST_SUITE("CTFE");
+    RUN_TEST(ctfe_folds_pure_recursion);
+    RUN_TEST(ctfe_constant_let_and_strings);
+    RUN_TEST(ctfe_leaves_impure_and_unbounded);
+    RUN_TEST(ctfe_matches_runtime);
+    RUN_TEST(ctfe_keeps_nan_at_runtime);
+
+    TEST_SUITE("Atributos de efectos");
+    RUN_TEST(cg_attrs_fresh_return);
+    RUN_TEST(cg_attrs_pure_and_readonly);
+    RUN_TEST(cg_attrs_keep_output);
+
+    TEST_SUITE("Genéricos");
+    RUN_TEST(cg_generic_field_is_unboxed);
+    RUN_TEST(cg_generic_instances_run);
+    RUN_TEST(cg_less_than_before_paren_is_comparison);
+
+    TEST_SUITE("Niveles de optimización");
+    RUN_TEST(cg_opt_parse_option);
+    RUN_TEST(cg_opt_promotes_locals);
+    RUN_TEST(cg_opt_programs_match_expected);
+
     TEST_SUITE("Bloques");
     RUN_TEST(cg_block);
 
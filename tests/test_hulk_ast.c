@@ -2,9 +2,12 @@
  * test_hulk_ast.c — Tests unitarios para el AST de HULK
  *
  * Cubre:
- *   - Arena (HulkASTContext): asignación y liberación
+ *   - Arena (HulkASTContext): asignación por chunks, alineación, adopción
  *   - Creación de cada tipo de nodo
  *   - HulkNodeList: init, push, free
+ *   - Interning de nombres (hulk_intern)
+ *   - AST plano (hulk_ast_flat): rangos de hijos, listas, payloads
+ *   - Caché en disco (hulk_ast_cache): ida y vuelta, archivos dañados
  *   - Visitor dispatch y traversal
  *   - AST printer (verificación de salida)
  *   - Nombres de debugging
@@ -13,6 +16,14 @@
 #include "test_framework.h"
 #include "../hulk_ast/core/hulk_ast.h"
 #include "../hulk_ast/printer/hulk_ast_printer.h"
+#include "../hulk_ast/core/hulk_ast_flat.h"
+#include "../hulk_ast/core/hulk_ast_cache.h"
+#include "../hulk_ast/core/hulk_ast_facts.h"
+#include "../hulk_ast/core/hulk_ast_side.h"
+#include "../hulk_ast/core/hulk_name_index.h"
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
 
 // ============================================
 //  Suite 1: Arena / Object Pool
@@ -21,10 +32,10 @@
 TEST(arena_init_and_free) {
     HulkASTContext ctx;
     hulk_ast_context_init(&ctx);
-    ASSERT_EQ(0, ctx.block_count);
-    ASSERT_EQ(0, ctx.block_capacity);
+    ASSERT_EQ(0, ctx.alloc_count);
+    ASSERT_EQ(0, ctx.chunk_count);
     hulk_ast_context_free(&ctx);
-    ASSERT_EQ(0, ctx.block_count);
+    ASSERT_EQ(0, ctx.alloc_count);
 }
 
 TEST(arena_alloc_registers_blocks) {
@@ -34,7 +45,7 @@ TEST(arena_alloc_registers_blocks) {
     void *p2 = hulk_ast_alloc(&ctx, 128);
     ASSERT_NOT_NULL(p1);
     ASSERT_NOT_NULL(p2);
-    ASSERT_EQ(2, ctx.block_count);
+    ASSERT_EQ(2, ctx.alloc_count);
     hulk_ast_context_free(&ctx);
 }
 
@@ -44,7 +55,7 @@ TEST(arena_strdup_copies_string) {
     char *s = hulk_ast_strdup(&ctx, "hello");
     ASSERT_NOT_NULL(s);
     ASSERT_STR_EQ("hello", s);
-    ASSERT_EQ(1, ctx.block_count);
+    ASSERT_EQ(1, ctx.alloc_count);
     hulk_ast_context_free(&ctx);
 }
 
@@ -53,7 +64,7 @@ TEST(arena_strdup_null_returns_null) {
     hulk_ast_context_init(&ctx);
     char *s = hulk_ast_strdup(&ctx, NULL);
     ASSERT_NULL(s);
-    ASSERT_EQ(0, ctx.block_count);
+    ASSERT_EQ(0, ctx.alloc_count);
     hulk_ast_context_free(&ctx);
 }
 
@@ -64,9 +75,73 @@ TEST(arena_many_allocs) {
         void *p = hulk_ast_alloc(&ctx, 32);
         ASSERT_NOT_NULL(p);
     }
-    ASSERT_EQ(500, ctx.block_count);
+    ASSERT_EQ(500, ctx.alloc_count);
+    ASSERT_EQ(1, ctx.chunk_count);
     hulk_ast_context_free(&ctx);
-    ASSERT_EQ(0, ctx.block_count);
+    ASSERT_EQ(0, ctx.alloc_count);
+}
+
+TEST(arena_blocks_aligned_and_zeroed) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    for (int i = 1; i < 200; i++) {
+        unsigned char *p = hulk_ast_alloc(&ctx, (size_t)i);
+        ASSERT_NOT_NULL(p);
+        ASSERT_EQ(0, (int)((size_t)p % HULK_AST_ALIGN));
+        for (int j = 0; j < i; j++) ASSERT_EQ(0, p[j]);
+        memset(p, 0xAB, (size_t)i);
+    }
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(arena_large_alloc_keeps_current_chunk) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    char *a = hulk_ast_alloc(&ctx, 16);
+    char *big = hulk_ast_alloc(&ctx, HULK_AST_CHUNK_SIZE * 2);
+    char *b = hulk_ast_alloc(&ctx, 16);
+    ASSERT_NOT_NULL(big);
+    ASSERT_EQ(2, ctx.chunk_count);
+    ASSERT(b == a + 16);  // siguió repartiendo del mismo chunk
+    big[HULK_AST_CHUNK_SIZE * 2 - 1] = 1;
+    hulk_ast_context_free(&ctx);
+    ASSERT_EQ(0, ctx.chunk_count);
+}
+
+TEST(arena_adopt_moves_chunks) {
+    HulkASTContext dst, src;
+    hulk_ast_context_init(&dst);
+    hulk_ast_context_init(&src);
+    char *d = hulk_ast_strdup(&dst, "dst");
+    char *s = hulk_ast_strdup(&src, "src");
+    ASSERT_EQ(1, hulk_ast_context_adopt(&dst, &src, NULL));
+    ASSERT_EQ(0, src.chunk_count);
+    ASSERT_EQ(0, src.alloc_count);
+    ASSERT_EQ(2, dst.chunk_count);
+    ASSERT_EQ(2, dst.alloc_count);
+    ASSERT_STR_EQ("src", s);
+    char *d2 = hulk_ast_alloc(&dst, 8);
+    ASSERT(d2 == d + 8);  // dst sigue en su chunk actual
+    hulk_ast_context_free(&src);
+    hulk_ast_context_free(&dst);
+}
+
+TEST(arena_adopt_rehomes_lists) {
+    // Las listas del árbol adoptado crecen en dst: src puede desaparecer
+    HulkASTContext dst, *src = malloc(sizeof(HulkASTContext));
+    hulk_ast_context_init(&dst);
+    hulk_ast_context_init(src);
+    BlockStmtNode *outer = hulk_ast_block_stmt(src, 1, 1);
+    BlockStmtNode *inner = hulk_ast_block_stmt(src, 1, 1);
+    hulk_node_list_push(&outer->statements, (HulkNode*)inner);
+    ASSERT_EQ(1, hulk_ast_context_adopt(&dst, src, (HulkNode*)outer));
+    free(src);
+    ASSERT(outer->statements.arena == &dst);
+    ASSERT(inner->statements.arena == &dst);
+    for (int i = 0; i < 8; i++)
+        hulk_node_list_push(&inner->statements, (HulkNode*)hulk_ast_block_stmt(&dst, 1, 1));
+    ASSERT_EQ(8, inner->statements.count);
+    hulk_ast_context_free(&dst);
 }
 
 // ============================================
@@ -118,6 +193,98 @@ TEST(node_list_grows_capacity) {
     hulk_ast_context_free(&ctx);
 }
 
+TEST(node_list_of_node_lives_in_arena) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    BlockStmtNode *b = hulk_ast_block_stmt(&ctx, 1, 1);
+    ASSERT(b->statements.arena == &ctx);
+    for (int i = 0; i < 100; i++)
+        hulk_node_list_push(&b->statements, (HulkNode*)hulk_ast_ident(&ctx, "x", 1, i));
+    ASSERT_EQ(100, b->statements.count);
+    ASSERT_EQ(99, ((HulkNode*)b->statements.items[99])->col);
+    ASSERT_EQ(1, ctx.chunk_count);  // nodos, nombres y lista en un chunk
+    hulk_ast_context_free(&ctx);     // sin free por lista
+}
+
+TEST(node_list_reserve_allocates_once) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNodeList list;
+    hulk_node_list_init_in(&list, &ctx);
+    hulk_node_list_reserve(&list, 50);
+    long before = ctx.alloc_count;
+    for (int i = 0; i < 50; i++) hulk_node_list_push(&list, NULL);
+    ASSERT_EQ(before, ctx.alloc_count);
+    ASSERT_EQ(50, list.capacity);
+    hulk_ast_context_free(&ctx);
+}
+
+// ============================================
+//  Suite 2b: Interning
+// ============================================
+
+TEST(intern_same_text_same_pointer) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s", "counter");
+    const char *a = hulk_intern("counter");
+    const char *b = hulk_intern(buf);
+    ASSERT(a == b);
+    ASSERT(a != buf);
+    ASSERT_STR_EQ("counter", a);
+    ASSERT(hulk_intern("counter2") != a);
+    ASSERT_NULL(hulk_intern(NULL));
+}
+
+TEST(intern_n_and_stored_hash_len) {
+    const char *a = hulk_intern_n("Point[]", 5);
+    ASSERT(a == hulk_intern("Point"));
+    ASSERT_EQ(5, (int)hulk_intern_len(a));
+    ASSERT(hulk_intern_hash(a) == hulk_intern_hash(hulk_intern("Point")));
+}
+
+TEST(intern_find_does_not_insert) {
+    long before = hulk_intern_count();
+    ASSERT_NULL(hulk_intern_find("__never_interned_name__"));
+    ASSERT_EQ(before, hulk_intern_count());
+    const char *a = hulk_intern("__now_interned_name__");
+    ASSERT(hulk_intern_find("__now_interned_name__") == a);
+}
+
+TEST(intern_names_shared_across_contexts) {
+    HulkASTContext c1, c2;
+    hulk_ast_context_init(&c1);
+    hulk_ast_context_init(&c2);
+    IdentNode *x1 = hulk_ast_ident(&c1, "shared_x", 1, 1);
+    MemberAccessNode *m = hulk_ast_member_access(&c2, NULL, "shared_x", 1, 1);
+    StringLitNode *s1 = hulk_ast_string_lit(&c1, "lit", 1, 1);
+    StringLitNode *s2 = hulk_ast_string_lit(&c2, "lit", 1, 1);
+    ASSERT(x1->name == m->member);
+    ASSERT(s1->value != s2->value);  // los literales no se internan
+    hulk_ast_context_free(&c1);
+    ASSERT_STR_EQ("shared_x", m->member);  // el nombre sobrevive a su arena
+    hulk_ast_context_free(&c2);
+}
+
+static void* intern_worker(void *arg) {
+    const char **out = arg;
+    char buf[32];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(buf, sizeof(buf), "thread_name_%d", i);
+        out[i] = hulk_intern(buf);
+    }
+    return NULL;
+}
+
+TEST(intern_is_thread_safe) {
+    static const char *r1[2000], *r2[2000];
+    pthread_t t1, t2;
+    pthread_create(&t1, NULL, intern_worker, r1);
+    pthread_create(&t2, NULL, intern_worker, r2);
+    pthread_join(t1, NULL);
+    pthread_join(t2, NULL);
+    for (int i = 0; i < 2000; i++) ASSERT(r1[i] == r2[i]);
+}
+
 // ============================================
 //  Suite 3: Creación de nodos
 // ============================================
@@ -723,6 +890,532 @@ TEST(composite_tree_type_with_methods) {
     hulk_ast_context_free(&ctx);
 }
 
+// ============================================
+//  Suite 8: AST plano
+// ============================================
+
+// Cuenta nodos del AST de punteros con hulk_ast_slots.
+static int count_nodes(HulkNode *n) {
+    if (!n) return 0;
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    int total = 1;
+    for (int i = 0; i < s.nfixed; i++) total += count_nodes(*s.fixed[i]);
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            total += count_nodes(s.lists[l]->items[i]);
+    return total;
+}
+
+TEST(flat_preorder_ids_and_payloads) {
+    // let x: Number = 1 in x + 2;
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    ProgramNode *p = hulk_ast_program(&ctx, 1, 1);
+    LetExprNode *let = hulk_ast_let_expr(&ctx, 1, 1);
+    VarBindingNode *vb = hulk_ast_var_binding(&ctx, "x", "Number", 1, 5);
+    vb->init_expr = (HulkNode*)hulk_ast_number_lit(&ctx, "1", 1, 17);
+    hulk_node_list_push(&let->bindings, (HulkNode*)vb);
+    let->body = (HulkNode*)hulk_ast_binary_op(&ctx, OP_ADD,
+        (HulkNode*)hulk_ast_ident(&ctx, "x", 1, 22),
+        (HulkNode*)hulk_ast_number_lit(&ctx, "2", 1, 26), 1, 24);
+    hulk_node_list_push(&p->declarations, (HulkNode*)let);
+
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    ASSERT_EQ(0, (int)hulk_flat_build(&f, (HulkNode*)p));
+    hulk_ast_context_free(&ctx);  // el árbol plano no depende de la arena
+
+    ASSERT_EQ(7, f.count);
+    int kinds[] = { NODE_PROGRAM, NODE_LET_EXPR, NODE_BINARY_OP, NODE_IDENT,
+                    NODE_NUMBER_LIT, NODE_VAR_BINDING, NODE_NUMBER_LIT };
+    for (int i = 0; i < 7; i++) ASSERT_EQ(kinds[i], f.kind[i]);
+
+    HulkFlatId let_id = 1;
+    ASSERT_EQ(2, (int)hulk_flat_child(&f, let_id, 0));  // body primero
+    const HulkFlatId *items;
+    ASSERT_EQ(1, hulk_flat_list(&f, let_id, 0, &items));
+    ASSERT_EQ(5, (int)items[0]);
+    ASSERT(f.name[5] == hulk_intern("x"));
+    ASSERT(f.type_ref[5] == hulk_intern("Number"));
+    ASSERT_EQ(OP_ADD, f.flags[2]);
+    ASSERT_STR_EQ("2", f.name[4]);
+    ASSERT_EQ(24, f.col[2]);
+    hulk_flat_free(&f);
+}
+
+TEST(flat_splits_multiple_lists_and_missing_children) {
+    // type P(a) inherits Q(a) { m() => 0; }   +   if (c) 1 else <ausente>
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    ProgramNode *p = hulk_ast_program(&ctx, 1, 1);
+    TypeDefNode *t = hulk_ast_type_def(&ctx, "P", "Q", 1, 1);
+    hulk_node_list_push(&t->params, (HulkNode*)hulk_ast_var_binding(&ctx, "a", NULL, 1, 8));
+    hulk_node_list_push(&t->parent_args, (HulkNode*)hulk_ast_ident(&ctx, "a", 1, 22));
+    MethodDefNode *m = hulk_ast_method_def(&ctx, "m", NULL, 1, 27);
+    m->body = (HulkNode*)hulk_ast_number_lit(&ctx, "0", 1, 34);
+    hulk_node_list_push(&t->members, (HulkNode*)m);
+    hulk_node_list_push(&t->members, (HulkNode*)hulk_ast_attribute_def(&ctx, "k", NULL, 1, 40));
+    hulk_node_list_push(&p->declarations, (HulkNode*)t);
+    IfExprNode *iff = hulk_ast_if_expr(&ctx, 2, 1);
+    iff->condition = (HulkNode*)hulk_ast_ident(&ctx, "c", 2, 5);
+    iff->then_body = (HulkNode*)hulk_ast_number_lit(&ctx, "1", 2, 8);
+    hulk_node_list_push(&p->declarations, (HulkNode*)iff);
+
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    ASSERT_EQ(0, (int)hulk_flat_build(&f, (HulkNode*)p));
+    ASSERT_EQ(count_nodes((HulkNode*)p), f.count);
+
+    const HulkFlatId *items;
+    HulkFlatId tid = 1;
+    ASSERT_EQ(1, hulk_flat_list(&f, tid, 0, &items));
+    ASSERT_EQ(NODE_VAR_BINDING, f.kind[items[0]]);
+    ASSERT_EQ(1, hulk_flat_list(&f, tid, 1, &items));
+    ASSERT_EQ(NODE_IDENT, f.kind[items[0]]);
+    ASSERT_EQ(2, hulk_flat_list(&f, tid, 2, &items));
+    ASSERT_EQ(NODE_METHOD_DEF, f.kind[items[0]]);
+    ASSERT_EQ(NODE_ATTRIBUTE_DEF, f.kind[items[1]]);
+    ASSERT(f.type_ref[tid] == hulk_intern("Q"));
+    ASSERT_EQ(0, hulk_flat_list(&f, tid, 3, &items));
+
+    ASSERT_EQ(2, hulk_flat_list(&f, 0, 0, &items));
+    HulkFlatId if_id = items[1];
+    ASSERT_EQ(NODE_IF_EXPR, f.kind[if_id]);
+    ASSERT(hulk_flat_child(&f, if_id, 2) == HULK_FLAT_NONE);  // sin else
+    ASSERT_EQ(0, hulk_flat_list(&f, if_id, 0, &items));        // sin elifs
+    hulk_flat_free(&f);
+    hulk_ast_context_free(&ctx);
+}
+
+static void flat_count_idents(const HulkFlatAST *f, HulkFlatId id,
+                              HulkFlatVisitor *v, void *data) {
+    if (f->kind[id] == NODE_IDENT) (*(int*)data)++;
+    hulk_flat_accept_children(f, id, v, data);
+}
+
+TEST(flat_visitor_reaches_every_node) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    BlockStmtNode *b = hulk_ast_block_stmt(&ctx, 1, 1);
+    for (int i = 0; i < 5; i++) {
+        CallExprNode *c = hulk_ast_call_expr(&ctx,
+            (HulkNode*)hulk_ast_ident(&ctx, "f", 1, i), 1, i);
+        hulk_node_list_push(&c->args, (HulkNode*)hulk_ast_ident(&ctx, "y", 1, i));
+        hulk_node_list_push(&b->statements, (HulkNode*)c);
+    }
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    hulk_flat_build(&f, (HulkNode*)b);
+
+    HulkFlatVisitor v;
+    hulk_flat_visitor_init(&v);
+    for (int k = 0; k < NODE_HULK_COUNT; k++) v.visit[k] = flat_count_idents;
+    int idents = 0;
+    hulk_flat_accept(&f, 0, &v, &idents);
+    ASSERT_EQ(10, idents);
+    ASSERT_EQ(16, f.count);
+    hulk_flat_free(&f);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(flat_static_type_only_when_annotated) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *sum = (HulkNode*)hulk_ast_binary_op(&ctx, OP_ADD,
+        (HulkNode*)hulk_ast_ident(&ctx, "x", 1, 1),
+        (HulkNode*)hulk_ast_number_lit(&ctx, "1", 1, 5), 1, 3);
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    hulk_flat_build(&f, sum);
+    ASSERT(f.static_type == NULL);  // recién parseado: no se paga
+    size_t bare = hulk_flat_bytes(&f);
+    hulk_flat_free(&f);
+
+    ((BinaryOpNode*)sum)->right->static_type = "Number";
+    hulk_flat_init(&f);
+    hulk_flat_build(&f, sum);
+    ASSERT(f.static_type != NULL);
+    ASSERT(f.static_type[0] == NULL);
+    ASSERT_STR_EQ("Number", f.static_type[2]);
+    ASSERT(hulk_flat_bytes(&f) > bare);
+
+    HulkNode *back = hulk_flat_to_ast(&ctx, &f, 0);
+    ASSERT_STR_EQ("Number", ((BinaryOpNode*)back)->right->static_type);
+    ASSERT(((BinaryOpNode*)back)->left->static_type == NULL);
+    hulk_flat_free(&f);
+    hulk_ast_context_free(&ctx);
+}
+
+// ============================================
+//  Suite 9: Caché del AST
+// ============================================
+
+// Programa con todos los payloads: nombres, anotaciones, literales y flags.
+static HulkNode* cache_sample(HulkASTContext *ctx) {
+    ProgramNode *p = hulk_ast_program(ctx, 1, 1);
+    TypeDefNode *proto = hulk_ast_type_def(ctx, "Printable", NULL, 1, 1);
+    proto->is_protocol = 1;
+    hulk_node_list_push(&proto->members,
+        (HulkNode*)hulk_ast_method_def(ctx, "show", "String", 1, 24));
+    hulk_node_list_push(&p->declarations, (HulkNode*)proto);
+
+    FunctionDefNode *fn = hulk_ast_function_def(ctx, "f", "Number", 2, 1);
+    hulk_node_list_push(&fn->params, (HulkNode*)hulk_ast_var_binding(ctx, "n", "Number", 2, 12));
+    UnaryOpNode *neg = hulk_ast_unary_op(ctx, (HulkNode*)hulk_ast_bool_lit(ctx, 1, 2, 30), 2, 29);
+    neg->is_not = 1;
+    IfExprNode *iff = hulk_ast_if_expr(ctx, 2, 25);
+    iff->condition = (HulkNode*)neg;
+    iff->then_body = (HulkNode*)hulk_ast_number_lit(ctx, "2.5", 2, 36);
+    iff->else_body = (HulkNode*)hulk_ast_binary_op(ctx, OP_POW,
+        (HulkNode*)hulk_ast_ident(ctx, "n", 2, 45),
+        (HulkNode*)hulk_ast_number_lit(ctx, "3", 2, 47), 2, 46);
+    fn->body = (HulkNode*)iff;
+    hulk_node_list_push(&p->declarations, (HulkNode*)fn);
+
+    CallExprNode *call = hulk_ast_call_expr(ctx, (HulkNode*)hulk_ast_ident(ctx, "print", 3, 1), 3, 1);
+    hulk_node_list_push(&call->args, (HulkNode*)hulk_ast_concat_expr(ctx, OP_CONCAT_WS,
+        (HulkNode*)hulk_ast_string_lit(ctx, "n =", 3, 7),
+        (HulkNode*)hulk_ast_call_expr(ctx, (HulkNode*)hulk_ast_ident(ctx, "f", 3, 16), 3, 16),
+        3, 13));
+    hulk_node_list_push(&p->declarations, (HulkNode*)call);
+    return (HulkNode*)p;
+}
+
+static char* print_ast(HulkNode *n) {
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *out = open_memstream(&buf, &len);
+    hulk_ast_print(n, out);
+    fclose(out);
+    return buf;
+}
+
+TEST(flat_to_ast_rebuilds_same_tree) {
+    HulkASTContext a, b;
+    hulk_ast_context_init(&a);
+    hulk_ast_context_init(&b);
+    HulkNode *orig = cache_sample(&a);
+    HulkFlatAST f;
+    hulk_flat_init(&f);
+    hulk_flat_build(&f, orig);
+    ASSERT(hulk_flat_validate(&f));
+
+    HulkNode *copy = hulk_flat_to_ast(&b, &f, 0);
+    char *p1 = print_ast(orig), *p2 = print_ast(copy);
+    ASSERT_STR_EQ(p1, p2);
+    TypeDefNode *proto = (TypeDefNode*)((ProgramNode*)copy)->declarations.items[0];
+    ASSERT_EQ(1, proto->is_protocol);
+    ASSERT(proto->name == hulk_intern("Printable"));
+    free(p1);
+    free(p2);
+    hulk_flat_free(&f);
+    hulk_ast_context_free(&a);
+    hulk_ast_context_free(&b);
+}
+
+TEST(cache_store_then_load_roundtrip) {
+    char dir[] = "/tmp/hulk_ast_cacheXXXXXX";
+    ASSERT_NOT_NULL(mkdtemp(dir));
+    const char *src = "protocol Printable { show(): String; } ...";
+    HulkASTContext a, b;
+    hulk_ast_context_init(&a);
+    hulk_ast_context_init(&b);
+    HulkNode *orig = cache_sample(&a);
+
+    ASSERT_NULL(hulk_ast_cache_load(&b, dir, src));  // vacía
+    ASSERT(hulk_ast_cache_store(dir, src, orig));
+    HulkNode *loaded = hulk_ast_cache_load(&b, dir, src);
+    ASSERT_NOT_NULL(loaded);
+    char *p1 = print_ast(orig), *p2 = print_ast(loaded);
+    ASSERT_STR_EQ(p1, p2);
+    NumberLitNode *num = (NumberLitNode*)((IfExprNode*)
+        ((FunctionDefNode*)((ProgramNode*)loaded)->declarations.items[1])->body)->then_body;
+    ASSERT(num->value == 2.5);
+
+    char path[512];
+    hulk_ast_cache_path(path, sizeof(path), dir, src);
+    remove(path);
+    rmdir(dir);
+    free(p1);
+    free(p2);
+    hulk_ast_context_free(&a);
+    hulk_ast_context_free(&b);
+}
+
+TEST(cache_rejects_other_source_and_damaged_files) {
+    char dir[] = "/tmp/hulk_ast_cacheXXXXXX";
+    ASSERT_NOT_NULL(mkdtemp(dir));
+    const char *src = "print(f());";
+    HulkASTContext a, b;
+    hulk_ast_context_init(&a);
+    hulk_ast_context_init(&b);
+    ASSERT(hulk_ast_cache_store(dir, src, cache_sample(&a)));
+    ASSERT_NULL(hulk_ast_cache_load(&b, dir, "print(g());"));
+
+    char path[512];
+    hulk_ast_cache_path(path, sizeof(path), dir, src);
+    FILE *fp = fopen(path, "rb");
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    rewind(fp);
+    unsigned char *bytes = malloc((size_t)size);
+    ASSERT_EQ(size, (long)fread(bytes, 1, (size_t)size, fp));
+    fclose(fp);
+
+    // Otro fuente del mismo largo bajo el mismo nombre (como si el hash
+    // colisionara): el fuente guardado, al final del archivo, no coincide
+    bytes[size - 3] ^= 1;
+    fp = fopen(path, "wb");
+    fwrite(bytes, 1, (size_t)size, fp);
+    fclose(fp);
+    ASSERT_NULL(hulk_ast_cache_load(&b, dir, src));
+    bytes[size - 3] ^= 1;
+
+    // Truncado: el tamaño no coincide con la cabecera
+    ASSERT_EQ(0, truncate(path, size - 1));
+    ASSERT_NULL(hulk_ast_cache_load(&b, dir, src));
+
+    // Kind inválido en la raíz (la sección kind sigue a la cabecera de
+    // 56 bytes): la validación lo rechaza.
+    bytes[56] = 0xFF;
+    fp = fopen(path, "wb");
+    fwrite(bytes, 1, (size_t)size, fp);
+    fclose(fp);
+    ASSERT_NULL(hulk_ast_cache_load(&b, dir, src));
+
+    remove(path);
+    rmdir(dir);
+    free(bytes);
+    hulk_ast_context_free(&a);
+    hulk_ast_context_free(&b);
+}
+
+// ============================================
+//  Hechos por cuerpo
+// ============================================
+
+static HulkNode* id_(HulkASTContext *ctx, const char *name) {
+    return (HulkNode*)hulk_ast_ident(ctx, name, 1, 1);
+}
+
+static HulkNode* self_dot(HulkASTContext *ctx, const char *member) {
+    return (HulkNode*)hulk_ast_member_access(ctx,
+        (HulkNode*)hulk_ast_self(ctx, 1, 1), member, 1, 1);
+}
+
+static HulkNode* num_(HulkASTContext *ctx) {
+    return (HulkNode*)hulk_ast_number_lit(ctx, "1", 1, 1);
+}
+
+TEST(facts_record_uses_by_name_in_one_walk) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    BlockStmtNode *body = hulk_ast_block_stmt(&ctx, 1, 1);
+    HulkNodeList *st = &body->statements;
+    hulk_node_list_push(st, (HulkNode*)hulk_ast_binary_op(&ctx, OP_ADD, id_(&ctx, "a"), num_(&ctx), 1, 1));
+    hulk_node_list_push(st, (HulkNode*)hulk_ast_binary_op(&ctx, OP_AND, id_(&ctx, "b"), id_(&ctx, "c"), 1, 1));
+    hulk_node_list_push(st, (HulkNode*)hulk_ast_concat_expr(&ctx, OP_CONCAT, self_dot(&ctx, "x"),
+        (HulkNode*)hulk_ast_string_lit(&ctx, "s", 1, 1), 1, 1));
+    hulk_node_list_push(st, (HulkNode*)hulk_ast_unary_op(&ctx, id_(&ctx, "d"), 1, 1));
+    CallExprNode *call = hulk_ast_call_expr(&ctx, id_(&ctx, "g"), 1, 1);
+    hulk_node_list_push(&call->args, id_(&ctx, "a"));
+    hulk_node_list_push(&call->args, id_(&ctx, "e"));
+    hulk_node_list_push(st, (HulkNode*)call);
+    WhileStmtNode *wh = hulk_ast_while_stmt(&ctx, 1, 1);
+    wh->condition = (HulkNode*)hulk_ast_bool_lit(&ctx, 1, 1, 1);
+    wh->body = (HulkNode*)hulk_ast_binary_op(&ctx, OP_MUL, self_dot(&ctx, "y"), num_(&ctx), 1, 1);
+    hulk_node_list_push(st, (HulkNode*)wh);
+    // self.z dentro de un for: la heurística de self.x no entra en for
+    ForStmtNode *fr = hulk_ast_for_stmt(&ctx, "i", 1, 1);
+    fr->iterable = id_(&ctx, "v");
+    fr->body = (HulkNode*)hulk_ast_binary_op(&ctx, OP_SUB, self_dot(&ctx, "z"), id_(&ctx, "i"), 1, 1);
+    hulk_node_list_push(st, (HulkNode*)fr);
+
+    HulkFacts t;
+    hulk_facts_init(&t);
+    HulkNode *b = (HulkNode*)body;
+    const HulkNameFacts *a = hulk_facts_name(&t, b, hulk_intern("a"));
+    ASSERT_NOT_NULL(a);
+    ASSERT_EQ(HULK_USE_NUMBER, a->operand);
+    const HulkArgUse *args = hulk_facts_args(&t, b);
+    ASSERT(a->first_arg >= 0);
+    ASSERT(args[a->first_arg].callee == hulk_intern("g"));
+    ASSERT_EQ(0, args[a->first_arg].index);
+    ASSERT_EQ(-1, args[a->first_arg].next);
+    ASSERT_EQ(1, args[hulk_facts_name(&t, b, hulk_intern("e"))->first_arg].index);
+    ASSERT_EQ(HULK_USE_BOOLEAN, hulk_facts_name(&t, b, hulk_intern("c"))->operand);
+    ASSERT_EQ(HULK_USE_NUMBER, hulk_facts_name(&t, b, hulk_intern("d"))->operand);
+    ASSERT_EQ(1, hulk_facts_name(&t, b, hulk_intern("g"))->called);
+
+    const HulkNameFacts *x = hulk_facts_name(&t, b, hulk_intern("x"));
+    ASSERT_EQ(HULK_USE_STRING, x->self_operand);
+    ASSERT_EQ(1, x->self_concat);
+    const HulkNameFacts *y = hulk_facts_name(&t, b, hulk_intern("y"));
+    ASSERT_EQ(HULK_USE_NUMBER, y->self_operand);
+    ASSERT_EQ(0, y->self_concat);
+    ASSERT_NULL(hulk_facts_name(&t, b, hulk_intern("z")));
+    ASSERT_EQ(HULK_USE_NUMBER, hulk_facts_name(&t, b, hulk_intern("i"))->operand);
+
+    ASSERT_EQ(1, t.walks);
+    hulk_facts_free(&t);
+    hulk_ast_context_free(&ctx);
+}
+
+// function(x) => let y = x + k in { function(z) => y + z + m + x; o.f; new T(q) }
+static FunctionExprNode* facts_lambdas(HulkASTContext *ctx, FunctionExprNode **inner) {
+    FunctionExprNode *in = hulk_ast_function_expr(ctx, NULL, 1, 1);
+    hulk_node_list_push(&in->params, (HulkNode*)hulk_ast_var_binding(ctx, "z", NULL, 1, 1));
+    in->body = (HulkNode*)hulk_ast_binary_op(ctx, OP_ADD,
+        (HulkNode*)hulk_ast_binary_op(ctx, OP_ADD,
+            (HulkNode*)hulk_ast_binary_op(ctx, OP_ADD, id_(ctx, "y"), id_(ctx, "z"), 1, 1),
+            id_(ctx, "m"), 1, 1),
+        id_(ctx, "x"), 1, 1);
+
+    BlockStmtNode *blk = hulk_ast_block_stmt(ctx, 1, 1);
+    hulk_node_list_push(&blk->statements, (HulkNode*)in);
+    hulk_node_list_push(&blk->statements, (HulkNode*)hulk_ast_member_access(ctx, id_(ctx, "o"), "f", 1, 1));
+    NewExprNode *ne = hulk_ast_new_expr(ctx, "T", 1, 1);
+    hulk_node_list_push(&ne->args, id_(ctx, "q"));
+    hulk_node_list_push(&blk->statements, (HulkNode*)ne);
+
+    LetExprNode *let = hulk_ast_let_expr(ctx, 1, 1);
+    VarBindingNode *vb = hulk_ast_var_binding(ctx, "y", NULL, 1, 1);
+    vb->init_expr = (HulkNode*)hulk_ast_binary_op(ctx, OP_ADD, id_(ctx, "x"), id_(ctx, "k"), 1, 1);
+    hulk_node_list_push(&let->bindings, (HulkNode*)vb);
+    let->body = (HulkNode*)blk;
+
+    FunctionExprNode *out = hulk_ast_function_expr(ctx, NULL, 1, 1);
+    hulk_node_list_push(&out->params, (HulkNode*)hulk_ast_var_binding(ctx, "x", NULL, 1, 1));
+    out->body = (HulkNode*)let;
+    *inner = in;
+    return out;
+}
+
+static int free_vars_are(HulkFacts *t, FunctionExprNode *fn, const char **want, int n) {
+    int count;
+    const char *const *names = hulk_facts_free_vars(t, fn, &count);
+    if (count != n) return 0;
+    for (int i = 0; i < n; i++)
+        if (names[i] != hulk_intern(want[i])) return 0;
+    return 1;
+}
+
+TEST(facts_lambda_free_vars_in_order_and_nested) {
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    FunctionExprNode *inner, *outer = facts_lambdas(&ctx, &inner);
+    const char *want_outer[] = { "k", "m", "o" };
+    const char *want_inner[] = { "y", "m", "x" };
+
+    // La lambda anidada se anota en la misma pasada que la exterior
+    HulkFacts t;
+    hulk_facts_init(&t);
+    ASSERT(free_vars_are(&t, outer, want_outer, 3));
+    ASSERT(free_vars_are(&t, inner, want_inner, 3));
+    ASSERT_EQ(1, t.walks);
+    hulk_facts_free(&t);
+
+    // Pedirla primero da lo mismo
+    hulk_facts_init(&t);
+    ASSERT(free_vars_are(&t, inner, want_inner, 3));
+    ASSERT(free_vars_are(&t, outer, want_outer, 3));
+    ASSERT(free_vars_are(&t, inner, want_inner, 3));
+    ASSERT_EQ(2, t.walks);
+    hulk_facts_free(&t);
+    hulk_ast_context_free(&ctx);
+}
+
+// ============================================
+//  Ids y tablas laterales
+// ============================================
+
+TEST(node_ids_are_dense_per_context) {
+    HulkASTContext a, b;
+    hulk_ast_context_init(&a);
+    hulk_ast_context_init(&b);
+    HulkNode *x = id_(&a, "x");
+    HulkNode *one = num_(&a);
+    BinaryOpNode *add = hulk_ast_binary_op(&a, OP_ADD, x, one, 1, 1);
+    ASSERT_EQ(0, x->id);
+    ASSERT_EQ(1, one->id);
+    ASSERT_EQ(2, add->base.id);
+    ASSERT_EQ(3, a.node_count);
+    ASSERT_EQ(0, id_(&b, "y")->id);  // cada contexto numera desde 0
+
+    // Juntar contextos: se corren los ids del que se adopta
+    hulk_ast_shift_ids((HulkNode*)add, b.node_count);
+    ASSERT_EQ(1, x->id);
+    ASSERT_EQ(3, add->base.id);
+    ASSERT(hulk_ast_context_adopt(&b, &a, (HulkNode*)add));
+    ASSERT_EQ(4, b.node_count);
+    ASSERT_EQ(4, id_(&b, "z")->id);
+    hulk_ast_context_free(&a);
+    hulk_ast_context_free(&b);
+}
+
+TEST(side_table_maps_node_to_value) {
+    HulkASTContext a, b;
+    hulk_ast_context_init(&a);
+    hulk_ast_context_init(&b);
+    HulkSideTable t;
+    hulk_side_init(&t, sizeof(double));
+
+    HulkNode *nodes[1000];
+    for (int i = 0; i < 1000; i++) nodes[i] = num_(&a);
+    ASSERT_NULL(hulk_side_get(&t, nodes[5]));
+    for (int i = 999; i >= 0; i -= 3)
+        *(double*)hulk_side_put(&t, nodes[i]) = i * 0.5;
+    ASSERT_EQ(334, t.count);
+    ASSERT(*(double*)hulk_side_get(&t, nodes[999]) == 499.5);
+    ASSERT(*(double*)hulk_side_get(&t, nodes[0]) == 0.0);
+    ASSERT_NULL(hulk_side_get(&t, nodes[1]));
+
+    // Mismo id, otro contexto: no ve el valor ajeno; put lo reemplaza
+    HulkNode *other = num_(&b);
+    ASSERT_EQ(nodes[0]->id, other->id);
+    ASSERT_NULL(hulk_side_get(&t, other));
+    ASSERT(*(double*)hulk_side_put(&t, other) == 0.0);
+    ASSERT_NULL(hulk_side_get(&t, nodes[0]));
+
+    hulk_side_free(&t);
+    hulk_ast_context_free(&a);
+    hulk_ast_context_free(&b);
+}
+
+// ============================================
+//  Índice de nombres
+// ============================================
+
+TEST(name_index_finds_by_pointer_first_wins) {
+    HulkNameIndex ix = {0};
+    ASSERT_EQ(-1, hulk_name_index_find(&ix, hulk_intern("a")));
+
+    const char *names[600];
+    char buf[32];
+    for (int i = 0; i < 600; i++) {
+        snprintf(buf, sizeof(buf), "idx_name_%d", i);
+        names[i] = hulk_intern(buf);
+        hulk_name_index_add(&ix, names[i], i);
+    }
+    ASSERT_EQ(600, ix.count);
+    ASSERT_EQ(0, hulk_name_index_find(&ix, names[0]));
+    ASSERT_EQ(417, hulk_name_index_find(&ix, names[417]));
+    ASSERT_EQ(599, hulk_name_index_find(&ix, names[599]));
+
+    // Repetido: conserva la primera posición, como la búsqueda lineal
+    hulk_name_index_add(&ix, names[10], 9999);
+    ASSERT_EQ(10, hulk_name_index_find(&ix, names[10]));
+    ASSERT_EQ(600, ix.count);
+
+    // Por puntero: una copia del texto no es la clave
+    ASSERT_EQ(-1, hulk_name_index_find(&ix, buf));
+    ASSERT_EQ(-1, hulk_name_index_find(&ix, hulk_intern("idx_name_600")));
+
+    hulk_name_index_free(&ix);
+    ASSERT_EQ(-1, hulk_name_index_find(&ix, names[0]));
+}
+
 // ============================================
 //  main
 // ============================================
@@ -739,11 +1432,24 @@ int main(void) {
     RUN_TEST(arena_strdup_copies_string);
     RUN_TEST(arena_strdup_null_returns_null);
     RUN_TEST(arena_many_allocs);
+    RUN_TEST(arena_blocks_aligned_and_zeroed);
+    RUN_TEST(arena_large_alloc_keeps_current_chunk);
+    RUN_TEST(arena_adopt_moves_chunks);
+    RUN_TEST(arena_adopt_rehomes_lists);
 
     TEST_SUITE("HulkNodeList");
     RUN_TEST(node_list_init_empty);
     RUN_TEST(node_list_push_and_count);
     RUN_TEST(node_list_grows_capacity);
+    RUN_TEST(node_list_of_node_lives_in_arena);
+    RUN_TEST(node_list_reserve_allocates_once);
+
+    TEST_SUITE("Interning");
+    RUN_TEST(intern_same_text_same_pointer);
+    RUN_TEST(intern_n_and_stored_hash_len);
+    RUN_TEST(intern_find_does_not_insert);
+    RUN_TEST(intern_names_shared_across_contexts);
+    RUN_TEST(intern_is_thread_safe);
 
     TEST_SUITE("Creación de nodos");
     RUN_TEST(create_program_node);
@@ -799,6 +1505,28 @@ int main(void) {
     RUN_TEST(composite_tree_let_with_binary);
     RUN_TEST(composite_tree_type_with_methods);
 
+    TEST_SUITE("AST plano");
+    RUN_TEST(flat_preorder_ids_and_payloads);
+    RUN_TEST(flat_splits_multiple_lists_and_missing_children);
+    RUN_TEST(flat_visitor_reaches_every_node);
+    RUN_TEST(flat_static_type_only_when_annotated);
+
+    TEST_SUITE("Caché del AST");
+    RUN_TEST(flat_to_ast_rebuilds_same_tree);
+    RUN_TEST(cache_store_then_load_roundtrip);
+    RUN_TEST(cache_rejects_other_source_and_damaged_files);
+
+    TEST_SUITE("Hechos por cuerpo");
+    RUN_TEST(facts_record_uses_by_name_in_one_walk);
+    RUN_TEST(facts_lambda_free_vars_in_order_and_nested);
+
+    TEST_SUITE("Ids y tablas laterales");
+    RUN_TEST(node_ids_are_dense_per_context);
+    RUN_TEST(side_table_maps_node_to_value);
+
+    TEST_SUITE("Índice de nombres");
+    RUN_TEST(name_index_finds_by_pointer_first_wins);
+
     TEST_REPORT();
     return TEST_EXIT_CODE();
 }
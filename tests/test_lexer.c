@@ -7,14 +7,17 @@
  *  - Posiciones line/col correctas
  *  - Errores léxicos
  *  - EOF correcto
+ *  - Flujo de tokens con hilo productor (token_stream) equivalente al lexer
  */
 
 #include "test_framework.h"
 #include "../hulk_tokens.h"
 #include "../hulk_compiler.h"
 #include "../generador_analizadores_lexicos/lexer.h"
+#include "../generador_analizadores_lexicos/token_stream.h"
 #include "../error_handler.h"
 #include <stdlib.h>
+#include <string.h>
 
 // ============== HELPER ==============
 // Compilador compartido entre todos los tests (se inicializa una vez)
@@ -342,6 +345,85 @@ TEST(empty_input) {
 
 // ============== MAIN ==============
 
+// ============== TESTS: TOKEN STREAM ==============
+
+// Programa de muchos más tokens que TOKEN_RING_CAP, para que el productor
+// dé varias vueltas al anillo.
+static char* repeated_source(int reps) {
+    const char *unit = "let x = 12.5 in { print(\"a\\tb\" @ x); } // c\n";
+    size_t len = strlen(unit);
+    char *src = malloc(len * reps + 1);
+    for (int i = 0; i < reps; i++) memcpy(src + i * len, unit, len);
+    src[len * reps] = '\0';
+    return src;
+}
+
+TEST(threaded_stream_matches_lexer) {
+    char *src = repeated_source(2000);
+    int n;
+    Token *ref = tokenize(src, &n);
+    TokenStream ts;
+    ASSERT(token_stream_open(&ts, hc.dfa, src, TOKEN_STREAM_THREADED));
+    int i = 0, same = 1;
+    for (;; i++) {
+        Token t = token_stream_next(&ts);
+        if (i >= n || t.type != ref[i].type || t.line != ref[i].line ||
+            t.col != ref[i].col ||
+            (t.lexeme && strcmp(t.lexeme, ref[i].lexeme) != 0))
+            same = 0;
+        free(t.lexeme);
+        if (t.type == TOKEN_EOF || !same) break;
+    }
+    token_stream_close(&ts);
+    ASSERT(same);
+    ASSERT_EQ(n - 1, i);
+    free_tokens(ref, n);
+    free(src);
+}
+
+TEST(threaded_cursor_reads_past_ring_window) {
+    char *src = repeated_source(2000);
+    int n;
+    Token *ref = tokenize(src, &n);
+    TokenStream ts;
+    ASSERT(token_stream_open(&ts, hc.dfa, src, TOKEN_STREAM_THREADED));
+    Token first = token_stream_next(&ts);
+    TokenCursor c;
+    token_cursor_init(&c, &ts);
+    int same = 1;
+    for (int i = 1; i < n; i++)
+        if (token_cursor_next(&c) != (int)ref[i].type) same = 0;
+    ASSERT(same);
+    ASSERT(c.rescanning);  // salió de la ventana y siguió re-escaneando
+    Token second = token_stream_next(&ts);  // el cursor no consumió nada
+    ASSERT_EQ(ref[1].type, second.type);
+    ASSERT_EQ(ref[1].col, second.col);
+    free(first.lexeme);
+    free(second.lexeme);
+    token_stream_close(&ts);  // descarta lo que quedó en el anillo
+    free_tokens(ref, n);
+    free(src);
+}
+
+TEST(threaded_stream_stops_before_lexical_error) {
+    ensure_compiler();
+    error_handler_set(ignore_expected_log);
+    TokenStream ts;
+    token_stream_open(&ts, hc.dfa, "let x = 1 $ 2", TOKEN_STREAM_THREADED);
+    int types[8], k = 0;
+    for (;;) {
+        Token t = token_stream_next(&ts);
+        types[k++] = t.type;
+        free(t.lexeme);
+        if (t.type == TOKEN_EOF || k == 8) break;
+    }
+    token_stream_close(&ts);
+    error_handler_set(NULL);
+    ASSERT_EQ(7, k);
+    ASSERT_EQ(TOKEN_ERROR, types[4]);  // re-lexeado en línea por el consumidor
+    ASSERT_EQ(TOKEN_NUMBER, types[5]);
+}
+
 int main(void) {
     printf("\n🧪 HULK Compiler — Lexer Unit Tests\n");
 
@@ -394,6 +476,11 @@ int main(void) {
     RUN_TEST(function_declaration);
     RUN_TEST(empty_input);
 
+    TEST_SUITE("Token Stream");
+    RUN_TEST(threaded_stream_matches_lexer);
+    RUN_TEST(threaded_cursor_reads_past_ring_window);
+    RUN_TEST(threaded_stream_stops_before_lexical_error);
+
     TEST_REPORT();
 
     // Cleanup
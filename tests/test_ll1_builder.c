@@ -1,16 +1,26 @@
 /*
  * test_ll1_builder.c — Tests del parser LL(1) paralelo.
  *
- * Este binario valida hulk_ll1_build_ast directamente; no cambia el parser
- * de producción hulk_build_ast.
+ * Este binario valida hulk_ll1_build_ast (motor de tabla) directamente,
+ * que el descendente recursivo generado (hulk_rd_build_ast, el parser de
+ * hulk_build_ast) produzca exactamente el mismo AST, y que ni el modo con
+ * el lexer en un hilo productor ni el parseo paralelo por ítems de nivel
+ * superior cambien el AST o los diagnósticos.
  */
 
 #include "test_framework.h"
 #include "../hulk_compiler.h"
 #include "../hulk_ast/core/hulk_ast.h"
 #include "../hulk_ast/builder/hulk_ll1_builder.h"
+#include "../hulk_ast/builder/hulk_parallel_builder.h"
+#include "../hulk_ast/printer/hulk_ast_printer.h"
+#include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../error_handler.h"
+#include <dirent.h>
+#include <string.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 
 static HulkCompiler hc;
 static int hc_ready = 0;
@@ -204,6 +214,597 @@ TEST(ll1_parses_base_identifier_and_type_suffixes) {
     hulk_ast_context_free(&ctx);
 }
 
+TEST(ll1_parses_generic_definitions_and_uses) {
+    HulkASTContext ctx;
+    HulkNode *ast = build_ll1(
+        "type Pair<A, B>(a: A, b: B) inherits Base<A>(a) { b: B = b; }"
+        "function max<T>(a: T, b: T): T => if (a > b) a else b;"
+        "let p: Pair<Number, (Box<Number>) -> Number[]> = new Pair<Number, String>(1, \"s\")"
+        " in max<Number>(1, 2) + (a < b) + f(x < y, z > (w));",
+        &ctx);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(3, AS_PROG(ast)->declarations.count);
+    ASSERT_STR_EQ("Pair<A,B>", AS_TYPE(PROG_DECL(ast, 0))->name);
+    ASSERT_STR_EQ("Base<A>", AS_TYPE(PROG_DECL(ast, 0))->parent);
+    ASSERT_STR_EQ("max<T>", AS_FUNC(PROG_DECL(ast, 1))->name);
+    ASSERT_STR_EQ("T", AS_FUNC(PROG_DECL(ast, 1))->return_type);
+
+    HulkNode *root = PROG_DECL(ast, 2);
+    VarBindingNode *p = AS_BIND(AS_LET(root)->bindings.items[0]);
+    ASSERT_STR_EQ("Pair<Number,(Box<Number>)->Number[]>", p->type_annotation);
+    ASSERT_STR_EQ("Pair<Number,String>", ((NewExprNode*)p->init_expr)->type_name);
+
+    /* `<` tras una función genérica declarada, seguido de tipos, `>` y
+     * `(`, es una llamada a una instancia; tras cualquier otro nombre es
+     * el operador, también en `x < y, z > (w)` */
+    HulkNode *sum = AS_LET(root)->body;
+    HulkNode *call = AS_BINARY(AS_BINARY(sum)->left)->left;
+    ASSERT_STR_EQ("max<Number>", AS_IDENT(AS_CALL(call)->callee)->name);
+    ASSERT_EQ(NODE_BINARY_OP, AS_BINARY(AS_BINARY(sum)->left)->right->type);
+    CallExprNode *f = AS_CALL(AS_BINARY(sum)->right);
+    ASSERT_EQ(2, f->args.count);
+    ASSERT_EQ(NODE_BINARY_OP, f->args.items[0]->type);
+    ASSERT_EQ(NODE_BINARY_OP, f->args.items[1]->type);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(ll1_precedence_climbing_matches_grammar_ladder) {
+    HulkASTContext ctx;
+    HulkNode *ast = build_ll1(
+        "a - b - c;"
+        "2 ** 3 ** 4;"
+        "x || y && z == w + v * u;"
+        "a + b is Number;",
+        &ctx);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(4, AS_PROG(ast)->declarations.count);
+
+    /* izquierda: (a - b) - c */
+    BinaryOpNode *sub = AS_BINARY(PROG_DECL(ast, 0));
+    ASSERT_EQ(OP_SUB, sub->op);
+    ASSERT_EQ(NODE_BINARY_OP, sub->left->type);
+    ASSERT_EQ(NODE_IDENT, sub->right->type);
+
+    /* derecha: 2 ** (3 ** 4) */
+    BinaryOpNode *pw = AS_BINARY(PROG_DECL(ast, 1));
+    ASSERT_EQ(OP_POW, pw->op);
+    ASSERT_EQ(NODE_NUMBER_LIT, pw->left->type);
+    ASSERT_EQ(NODE_BINARY_OP, pw->right->type);
+
+    /* x || (y && (z == (w + (v * u)))) */
+    BinaryOpNode *or = AS_BINARY(PROG_DECL(ast, 2));
+    ASSERT_EQ(OP_OR, or->op);
+    BinaryOpNode *and = AS_BINARY(or->right);
+    ASSERT_EQ(OP_AND, and->op);
+    BinaryOpNode *eq = AS_BINARY(and->right);
+    ASSERT_EQ(OP_EQ, eq->op);
+    ASSERT_EQ(OP_ADD, AS_BINARY(eq->right)->op);
+    ASSERT_EQ(OP_MUL, AS_BINARY(AS_BINARY(eq->right)->right)->op);
+
+    /* `is` vive en el nivel de comparación: (a + b) is Number */
+    ASSERT_EQ(NODE_IS_EXPR, PROG_DECL(ast, 3)->type);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(ll1_operator_chain_cost_is_linear_per_token) {
+    HulkASTContext ctx;
+    HulkNode *ast = build_ll1(
+        "a || b || c || d || e || f || g || h || i || j || k || l;", &ctx);
+    ASSERT_NOT_NULL(ast);
+    HulkLL1Stats st;
+    hulk_ll1_last_stats(&st);
+    ASSERT_EQ(24, (int)st.tokens);
+    /* La escalera Or→…→Factor costaba ~11 símbolos por token aquí. */
+    ASSERT(st.symbols <= 6 * st.tokens);
+    hulk_ast_context_free(&ctx);
+}
+
+/* 100k paréntesis anidados: desbordaba las pilas fijas (4096) y el
+ * lookahead de lambda re-escaneaba O(n) tokens por nivel. */
+TEST(ll1_deep_nesting_grows_stacks_linearly) {
+    const int depth = 100000;
+    char *src = malloc((size_t)depth * 2 + 8);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    for (int i = 0; i < depth; i++) src[n++] = '(';
+    src[n++] = '1';
+    for (int i = 0; i < depth; i++) src[n++] = ')';
+    src[n++] = ';';
+    src[n] = '\0';
+
+    HulkASTContext ctx;
+    HulkNode *ast = build_ll1(src, &ctx);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(1, AS_PROG(ast)->declarations.count);
+    ASSERT_EQ(NODE_NUMBER_LIT, PROG_DECL(ast, 0)->type);
+
+    HulkLL1Stats st;
+    hulk_ll1_last_stats(&st);
+    ASSERT_EQ(2 * depth + 2, (int)st.tokens);
+    ASSERT(st.symbols <= 8 * st.tokens);
+    ASSERT(st.lookahead_tokens <= 4 * st.tokens);
+    hulk_ast_context_free(&ctx);
+    free(src);
+}
+
+TEST(ll1_million_element_vector_literal) {
+    const int count = 1000000;
+    char *src = malloc((size_t)count * 2 + 8);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    src[n++] = '[';
+    for (int i = 0; i < count; i++) {
+        if (i) src[n++] = ',';
+        src[n++] = (char)('0' + i % 10);
+    }
+    src[n++] = ']';
+    src[n++] = ';';
+    src[n] = '\0';
+
+    HulkASTContext ctx;
+    HulkNode *ast = build_ll1(src, &ctx);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(1, AS_PROG(ast)->declarations.count);
+    HulkNode *vec = PROG_DECL(ast, 0);
+    ASSERT_EQ(NODE_VECTOR_LIT, vec->type);
+    ASSERT_EQ(count, AS_VECTOR(vec)->items.count);
+
+    HulkLL1Stats st;
+    hulk_ll1_last_stats(&st);
+    ASSERT_EQ(2 * count + 2, (int)st.tokens);
+    ASSERT(st.symbols <= 8 * st.tokens);
+    hulk_ast_context_free(&ctx);
+    free(src);
+}
+
+/* ---- Parser descendente recursivo generado ---- */
+
+/* Dump del printer con cada motor; NULL se representa como "NULL". */
+static char* dump_with(HulkNode *(*build)(HulkASTContext*, DFA*, const char*),
+                       const char *src) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = build(&ctx, hc.dfa, src);
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *out = open_memstream(&buf, &len);
+    if (ast) hulk_ast_print(ast, out); else fputs("NULL", out);
+    fclose(out);
+    hulk_ast_context_free(&ctx);
+    return buf;
+}
+
+static int same_ast_with(HulkNode *(*a)(HulkASTContext*, DFA*, const char*),
+                         HulkNode *(*b)(HulkASTContext*, DFA*, const char*),
+                         const char *src) {
+    FILE *saved = stderr;
+    stderr = fopen("/dev/null", "w");
+    char *da = dump_with(a, src);
+    char *db = dump_with(b, src);
+    fclose(stderr);
+    stderr = saved;
+    int same = strcmp(da, db) == 0;
+    free(da);
+    free(db);
+    return same;
+}
+
+static int same_ast(const char *src) {
+    return same_ast_with(hulk_ll1_build_ast, hulk_rd_build_ast, src);
+}
+
+static HulkNode* rd_threaded(HulkASTContext *ctx, DFA *dfa, const char *src) {
+    return hulk_rd_build_ast_mode(ctx, dfa, src, TOKEN_STREAM_THREADED);
+}
+
+static HulkNode* ll1_threaded(HulkASTContext *ctx, DFA *dfa, const char *src) {
+    return hulk_ll1_build_ast_mode(ctx, dfa, src, TOKEN_STREAM_THREADED);
+}
+
+static int same_ast_threaded(const char *src) {
+    return same_ast_with(hulk_rd_build_ast, rd_threaded, src) &&
+           same_ast_with(hulk_ll1_build_ast, ll1_threaded, src);
+}
+
+/* Aplica `check` a cada programa de tests/hulk_programs; retorna cuántos
+ * programas lo cumplen, o -1 si alguno falla. */
+static int for_each_program(int (*check)(const char *src)) {
+    DIR *dir = opendir("tests/hulk_programs");
+    if (!dir) return -1;
+    int files = 0;
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL && files >= 0) {
+        size_t n = strlen(e->d_name);
+        if (n < 5 || strcmp(e->d_name + n - 5, ".hulk") != 0) continue;
+        char path[512];
+        snprintf(path, sizeof(path), "tests/hulk_programs/%s", e->d_name);
+        FILE *f = fopen(path, "rb");
+        if (!f) continue;
+        fseek(f, 0, SEEK_END);
+        long len = ftell(f);
+        rewind(f);
+        char *src = malloc((size_t)len + 1);
+        size_t got = fread(src, 1, (size_t)len, f);
+        src[got] = '\0';
+        fclose(f);
+        files = check(src) ? files + 1 : -1;
+        free(src);
+    }
+    closedir(dir);
+    return files;
+}
+
+TEST(rd_parser_matches_table_parser_on_snippets) {
+    static const char *cases[] = {
+        "function f(x: Number): Number -> x + 1; f(2);",
+        "let f = (x) -> x * 2, g = function (y: Number): Number -> y in f(g(3));",
+        "type P(x: Number) inherits Q(x) { x = x; get(): Number => self.x; }"
+        "protocol H extends I { h(a: Number): String; }",
+        "decor memo, log(1) function fib(n) => if (n < 2) n else fib(n - 1) + fib(n - 2);"
+        "type Box(v: Number) { decor log get(): Number -> v; }",
+        "define inc(x) -> x + 1;",
+        "let a = new Number[3] { i -> i * 2 } in a[1] := 5;",
+        "function consume(it: Number*): Number[] -> base.f(it);"
+        "let base = 1 in base + if (true) 2 else 3;",
+        "a - b - c; 2 ** 3 ** 4; x || y && z == w + v * u; a + b is Number;",
+        "for (i in range(0, 10)) { print(i @@ \"x\"); while (i > 0) i := i - 1; };",
+        "{ 1; (2); ((x) -> x)(3); }",
+        "if (a) 1 elif (b) 2 else 3",
+        "function id<T>(x: T): T => x; type Box<T>(v: T) inherits Base<T>(v) {}"
+        "protocol Src<T> extends Base<T> { next(): T; }"
+        "let b: Box<Box<Number>> = new Box<Number>(id<Number>(1)) in b < c;",
+        "let x = ;",   /* error: ambos motores retornan NULL */
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        ASSERT(same_ast(cases[i]));
+}
+
+TEST(rd_parser_matches_table_parser_on_programs) {
+    ASSERT(for_each_program(same_ast) > 0);
+}
+
+/* Más allá de HULK_RD_MAX_DEPTH el descendente recursivo cede al motor
+ * de tabla en vez de desbordar la pila de C. */
+TEST(rd_parser_falls_back_on_deep_nesting) {
+    const int depth = 100000;
+    char *src = malloc((size_t)depth * 2 + 8);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    for (int i = 0; i < depth; i++) src[n++] = '(';
+    src[n++] = '1';
+    for (int i = 0; i < depth; i++) src[n++] = ')';
+    src[n++] = ';';
+    src[n] = '\0';
+
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_rd_build_ast(&ctx, hc.dfa, src);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(NODE_NUMBER_LIT, PROG_DECL(ast, 0)->type);
+    hulk_ast_context_free(&ctx);
+    free(src);
+}
+
+/* hulk_rd_parser.c está versionado: debe coincidir con lo que emite el
+ * generador para la gramática actual (si falla: `make regen-rd`). */
+TEST(rd_generated_parser_is_up_to_date) {
+    char *emitted = NULL;
+    size_t emitted_len = 0;
+    FILE *out = open_memstream(&emitted, &emitted_len);
+    ASSERT(hulk_rd_emit(out));
+    fclose(out);
+
+    FILE *f = fopen("hulk_ast/builder/hulk_rd_parser.c", "rb");
+    ASSERT_NOT_NULL(f);
+    char *committed = malloc(emitted_len + 2);
+    size_t got = fread(committed, 1, emitted_len + 1, f);
+    fclose(f);
+    ASSERT_EQ((int)emitted_len, (int)got);
+    ASSERT(memcmp(emitted, committed, emitted_len) == 0);
+    free(committed);
+    free(emitted);
+}
+
+TEST(threaded_lexer_matches_inline_on_programs) {
+    ASSERT(for_each_program(same_ast_threaded) > 0);
+}
+
+/* El lookahead de lambda recorre hasta el `)` que balancea: con más
+ * tokens que TOKEN_RING_CAP sale de la ventana del anillo y re-escanea. */
+TEST(threaded_lexer_lookahead_past_ring_window) {
+    const int params = TOKEN_RING_CAP;
+    char *src = malloc((size_t)params * 16 + 64);
+    ASSERT_NOT_NULL(src);
+    int n = sprintf(src, "let f = (p0");
+    for (int i = 1; i < params; i++) n += sprintf(src + n, ", p%d", i);
+    n += sprintf(src + n, ") -> p0 in (1");
+    for (int i = 1; i < params; i++) n += sprintf(src + n, " + %d", i);
+    sprintf(src + n, ");");
+    ASSERT(same_ast_threaded(src));
+
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = rd_threaded(&ctx, hc.dfa, src);
+    ASSERT_NOT_NULL(ast);
+    HulkNode *binding = AS_LET(PROG_DECL(ast, 0))->bindings.items[0];
+    ASSERT_EQ(NODE_FUNCTION_EXPR, AS_BIND(binding)->init_expr->type);
+    hulk_ast_context_free(&ctx);
+    free(src);
+}
+
+static char log_buf[4096];
+static size_t log_len;
+
+static void capture_log(LogLevel level, const char *module,
+                        const char *fmt, va_list args) {
+    (void)level;
+    if (log_len >= sizeof(log_buf)) return;
+    log_len += snprintf(log_buf + log_len, sizeof(log_buf) - log_len, "%s: ", module);
+    if (log_len >= sizeof(log_buf)) return;
+    log_len += vsnprintf(log_buf + log_len, sizeof(log_buf) - log_len, fmt, args);
+}
+
+static char* diagnostics_of(HulkNode *(*build)(HulkASTContext*, DFA*, const char*),
+                            const char *src) {
+    ensure_compiler();
+    log_len = 0;
+    log_buf[0] = '\0';
+    error_handler_set(capture_log);
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    build(&ctx, hc.dfa, src);
+    hulk_ast_context_free(&ctx);
+    error_handler_set(NULL);
+    return strdup(log_buf);
+}
+
+/* El productor lexea en silencio y se detiene antes del primer token
+ * erróneo: un error léxico posterior a un error de sintaxis no se
+ * reporta, igual que sin hilo. */
+TEST(threaded_lexer_reports_same_diagnostics) {
+    const char *cases[] = {
+        "let x = 1 in x $ 2;",
+        "let x = ; print(\"a\\q\") $;",
+        "function f(x) => x; $",
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        char *inline_log = diagnostics_of(hulk_rd_build_ast, cases[i]);
+        char *threaded_log = diagnostics_of(rd_threaded, cases[i]);
+        ASSERT(inline_log[0] != '\0');
+        ASSERT_STR_EQ(inline_log, threaded_log);
+        free(inline_log);
+        free(threaded_log);
+    }
+}
+
+static int count_of(const char *s, const char *what) {
+    int n = 0;
+    for (const char *p = strstr(s, what); p; p = strstr(p + 1, what)) n++;
+    return n;
+}
+
+/* Los cursores de lookahead re-lexean en silencio: el error léxico sale
+ * una vez, cuando el flujo llega al token. */
+TEST(lookahead_does_not_repeat_lexical_errors) {
+    const char *cases[] = {
+        "print(a < c $ b);",
+        "f(x, (y) $ 1);",
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        char *inline_log = diagnostics_of(hulk_rd_build_ast, cases[i]);
+        char *table_log = diagnostics_of(hulk_ll1_build_ast, cases[i]);
+        ASSERT_EQ(1, count_of(inline_log, "lexer: "));
+        ASSERT_EQ(1, count_of(table_log, "lexer: "));
+        free(inline_log);
+        free(table_log);
+    }
+}
+
+/* El motor de tabla re-lexea la entrada desde el inicio: los errores
+ * léxicos que el descendente ya reportó antes de ceder no se repiten.
+ * Cada `(` anida cinco no-terminales; en alguna de estas profundidades
+ * el límite salta justo con `$` ya lexeado como token actual. */
+TEST(rd_fallback_does_not_repeat_lexical_errors) {
+    const int lo = 3990, hi = 4005;
+    char *src = malloc((size_t)hi * 2 + 32);
+    ASSERT_NOT_NULL(src);
+    for (int depth = lo; depth <= hi; depth++) {
+        int n = sprintf(src, "print(");
+        for (int i = 0; i < depth; i++) src[n++] = '(';
+        n += sprintf(src + n, "--$");
+        for (int i = 0; i < depth; i++) src[n++] = ')';
+        strcpy(src + n, ");");
+
+        char *log = diagnostics_of(hulk_rd_build_ast, src);
+        ASSERT_EQ(1, count_of(log, "lexer: "));
+        free(log);
+    }
+    free(src);
+}
+
+TEST(top_level_boundaries_only_at_item_ends) {
+    const char *src =
+        "function f(x) => { x };\n"                /* `}` de cuerpo `=>`: no corta */
+        "let s = \"; type X {}\" in print(s);\n"  /* dentro de string */
+        "// ; function g() {}\n"
+        "function g() { function h() {} }\n"       /* anidada: profundidad 1 */
+        "type A { m() => 1; }\n"
+        "{ 1; } protocol P { n(): Number; }\n"     /* tras bloque global: no corta */
+        "let k = function (y) -> y in k(1);\n"     /* lambda, no declaración */
+        "decor d function q() => 2;";
+    HulkTopBoundary *b;
+    int n = hulk_top_level_boundaries(src, &b);
+    ASSERT_EQ(3, n);
+    ASSERT_EQ(4, b[0].line);   /* function g */
+    ASSERT_EQ(1, b[0].col);
+    ASSERT_EQ(5, b[1].line);   /* type A */
+    ASSERT_EQ(8, b[2].line);   /* decor */
+    ASSERT(strncmp(src + b[2].pos, "decor", 5) == 0);
+    free(b);
+}
+
+static HulkNode* parallel4(HulkASTContext *ctx, DFA *dfa, const char *src) {
+    return hulk_parallel_build_ast(ctx, dfa, src, 4);
+}
+
+static int same_ast_parallel(const char *src) {
+    return same_ast_with(hulk_rd_build_ast, parallel4, src);
+}
+
+TEST(parallel_parse_matches_sequential_on_programs) {
+    ASSERT(for_each_program(same_ast_parallel) > 0);
+}
+
+/* Marca el id de cada nodo del subárbol; 0 si alguno se repite o no
+ * entra en el rango del contexto. */
+static int ids_unique(HulkNode *n, unsigned char *seen, unsigned count) {
+    if (!n) return 1;
+    if (n->id >= count || seen[n->id]) return 0;
+    seen[n->id] = 1;
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        if (!ids_unique(*s.fixed[i], seen, count)) return 0;
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++)
+            if (!ids_unique(s.lists[l]->items[i], seen, count)) return 0;
+    return 1;
+}
+
+/* Muchas declaraciones pequeñas: se reparten en 4 tramos y el AST
+ * empalmado (orden y posiciones) es el del parseo en serie; los ids de
+ * los tramos se corren para no repetirse. */
+TEST(parallel_parse_of_many_functions) {
+    const int funcs = 20000;
+    char *src = malloc((size_t)funcs * 96 + 64);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    for (int i = 0; i < funcs; i++) {
+        if (i % 3 == 0)
+            n += sprintf(src + n, "function f%d(x) => x + %d;\n", i, i);
+        else if (i % 3 == 1)
+            n += sprintf(src + n, "function f%d(x) {\n  let y = x in y * %d;\n}\n", i, i);
+        else
+            n += sprintf(src + n, "type T%d(a) { a = a; get() => self.a; }\n", i);
+    }
+    sprintf(src + n, "print(f0(1));");
+
+    HulkTopBoundary *b;
+    ASSERT_EQ(funcs - 1, hulk_top_level_boundaries(src, &b));
+    free(b);
+    ASSERT(same_ast_parallel(src));
+
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = parallel4(&ctx, hc.dfa, src);
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(funcs + 1, AS_PROG(ast)->declarations.count);
+    unsigned char *seen = calloc(ctx.node_count, 1);
+    ASSERT(ids_unique(ast, seen, ctx.node_count));
+    free(seen);
+    HulkLL1Stats par;
+    hulk_ll1_last_stats(&par);
+    hulk_ast_context_free(&ctx);
+
+    hulk_ast_context_init(&ctx);
+    ASSERT_NOT_NULL(hulk_rd_build_ast(&ctx, hc.dfa, src));
+    HulkLL1Stats seq;
+    hulk_ll1_last_stats(&seq);
+    hulk_ast_context_free(&ctx);
+    ASSERT_EQ(seq.tokens, par.tokens);
+    free(src);
+}
+
+/* 1 si toda lista del subárbol crece en `ctx` (o en el heap); cuenta
+ * en `lambdas` las lambdas con `captures` capturas. */
+static int lists_in(HulkNode *n, HulkASTContext *ctx, int captures, int *lambdas) {
+    if (!n) return 1;
+    if (n->type == NODE_FUNCTION_EXPR &&
+        ((FunctionExprNode*)n)->captures.count == captures)
+        (*lambdas)++;
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++)
+        if (!lists_in(*s.fixed[i], ctx, captures, lambdas)) return 0;
+    for (int l = 0; l < s.nlists; l++) {
+        if (s.lists[l]->arena && s.lists[l]->arena != ctx) return 0;
+        for (int i = 0; i < s.lists[l]->count; i++)
+            if (!lists_in(s.lists[l]->items[i], ctx, captures, lambdas)) return 0;
+    }
+    return 1;
+}
+
+/* Los contextos de los tramos viven en la pila del builder: tras
+ * empalmar, las listas deben crecer en el contexto destino, como las
+ * capturas que agrega la semántica. */
+TEST(parallel_parse_then_semantic_with_captures) {
+    const int funcs = 2000;
+    char *src = malloc((size_t)funcs * 96 + 64);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    for (int i = 0; i < funcs; i++)
+        n += sprintf(src + n,
+                     "function f%d(x: Number): Number => let k = %d in ((y) -> y + k + x)(1);\n",
+                     i, i);
+    sprintf(src + n, "print(f0(1));");
+
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = parallel4(&ctx, hc.dfa, src);
+    ASSERT_NOT_NULL(ast);
+    int lambdas = 0;
+    ASSERT(lists_in(ast, &ctx, 0, &lambdas));
+    ASSERT_EQ(funcs, lambdas);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+    lambdas = 0;
+    ASSERT(lists_in(ast, &ctx, 2, &lambdas));
+    ASSERT_EQ(funcs, lambdas);
+    hulk_ast_context_free(&ctx);
+    free(src);
+}
+
+/* La semántica sobre el AST empalmado da los mismos errores que sobre
+ * el del parseo en serie, y nada queda asignando en los tramos. */
+static int same_semantic_parallel(const char *src) {
+    ensure_compiler();
+    HulkASTContext seq_ctx, par_ctx;
+    hulk_ast_context_init(&seq_ctx);
+    hulk_ast_context_init(&par_ctx);
+    HulkNode *seq = hulk_rd_build_ast(&seq_ctx, hc.dfa, src);
+    HulkNode *par = parallel4(&par_ctx, hc.dfa, src);
+    int lambdas = 0, same = seq && par &&
+        hulk_semantic_analyze(&seq_ctx, seq) == hulk_semantic_analyze(&par_ctx, par) &&
+        lists_in(par, &par_ctx, -1, &lambdas);
+    hulk_ast_context_free(&seq_ctx);
+    hulk_ast_context_free(&par_ctx);
+    return same;
+}
+
+TEST(parallel_parse_then_semantic_on_programs) {
+    ASSERT(for_each_program(same_semantic_parallel) > 0);
+}
+
+/* Un tramo con error hace re-parsear en serie: mismos diagnósticos. */
+TEST(parallel_parse_falls_back_with_same_diagnostics) {
+    const char *src =
+        "function a() => 1;\n"
+        "function b() => 2;\n"
+        "function c() => ;\n"
+        "function d() => 4 $;\n"
+        "print(a());";
+    char *seq_log = diagnostics_of(hulk_rd_build_ast, src);
+    char *par_log = diagnostics_of(parallel4, src);
+    ASSERT(seq_log[0] != '\0');
+    ASSERT_STR_EQ(seq_log, par_log);
+    free(seq_log);
+    free(par_log);
+}
+
 int main(void) {
     TEST_SUITE("LL(1) AST Builder");
     RUN_TEST(ll1_parses_function_definitions);
@@ -214,6 +815,26 @@ int main(void) {
     RUN_TEST(ll1_parses_define_and_arrow_alias);
     RUN_TEST(ll1_parses_arrays_and_c_initializer);
     RUN_TEST(ll1_parses_base_identifier_and_type_suffixes);
+    RUN_TEST(ll1_parses_generic_definitions_and_uses);
+    RUN_TEST(ll1_precedence_climbing_matches_grammar_ladder);
+    RUN_TEST(ll1_operator_chain_cost_is_linear_per_token);
+    RUN_TEST(ll1_deep_nesting_grows_stacks_linearly);
+    RUN_TEST(ll1_million_element_vector_literal);
+    RUN_TEST(rd_parser_matches_table_parser_on_snippets);
+    RUN_TEST(rd_parser_matches_table_parser_on_programs);
+    RUN_TEST(rd_parser_falls_back_on_deep_nesting);
+    RUN_TEST(rd_generated_parser_is_up_to_date);
+    RUN_TEST(threaded_lexer_matches_inline_on_programs);
+    RUN_TEST(threaded_lexer_lookahead_past_ring_window);
+    RUN_TEST(threaded_lexer_reports_same_diagnostics);
+    RUN_TEST(lookahead_does_not_repeat_lexical_errors);
+    RUN_TEST(rd_fallback_does_not_repeat_lexical_errors);
+    RUN_TEST(top_level_boundaries_only_at_item_ends);
+    RUN_TEST(parallel_parse_matches_sequential_on_programs);
+    RUN_TEST(parallel_parse_of_many_functions);
+    RUN_TEST(parallel_parse_then_semantic_with_captures);
+    RUN_TEST(parallel_parse_then_semantic_on_programs);
+    RUN_TEST(parallel_parse_falls_back_with_same_diagnostics);
     TEST_REPORT();
     if (hc_ready) hulk_compiler_free(&hc);
     return TEST_EXIT_CODE();
@@ -130,6 +130,22 @@ TEST(parse_string_concat) {
     ASSERT(parse_ok("\"hello\" @@ \"world\";"));
 }
 
+TEST(parse_deep_nesting_beyond_inline_stack) {
+    // Cada nivel deja sus colas (Term', Expr', …) en la pila: con el
+    // antiguo STACK_MAX=2048 esto abortaba con desbordamiento.
+    const int depth = 20000;
+    char *src = malloc((size_t)depth * 2 + 4);
+    ASSERT_NOT_NULL(src);
+    int n = 0;
+    for (int i = 0; i < depth; i++) src[n++] = '(';
+    src[n++] = '1';
+    for (int i = 0; i < depth; i++) src[n++] = ')';
+    src[n++] = ';';
+    src[n] = '\0';
+    ASSERT(parse_ok(src));
+    free(src);
+}
+
 // ============== TESTS: DECORATORS ==============
 
 TEST(decor_single_function) {
@@ -237,6 +253,7 @@ int main(void) {
     RUN_TEST(parse_method_call);
     RUN_TEST(parse_nested_let);
     RUN_TEST(parse_string_concat);
+    RUN_TEST(parse_deep_nesting_beyond_inline_stack);
 
     TEST_SUITE("Decorators (decor keyword)");
     RUN_TEST(decor_single_function);
@@ -6,21 +6,31 @@
  *   - Verificación de tipos: aritmética, booleanos, comparaciones
  *   - Let bindings con y sin anotación de tipo
  *   - Funciones: parámetros, retorno, inferencia
- *   - Tipos: herencia, constructor, self, base, métodos, atributos
+ *   - Tipos: herencia, constructor, self, base, métodos, atributos,
+ *     conformance (herencia y protocolos) y join
  *   - Operadores: concat, as, is, unary
  *   - Control de flujo: if/elif/else, while, for, block
+ *   - Resolución anotada en los usos de nombres (IdentNode.binding)
  *   - Desugaring de decoradores
  *   - Programas completos válidos (0 errores)
+ *   - Verificación de cuerpos entre hilos: mismos diagnósticos que en serie
+ *   - Análisis incremental: se verifica lo editado y lo que depende de ello
+ *   - Grafo de llamadas: aristas por tipo estático, decoradores, SCC
  *   - Detección de errores semánticos (>0 errores)
  */
 
 #include "test_framework.h"
 #include "../hulk_compiler.h"
 #include "../hulk_ast/core/hulk_ast.h"
+#include "../hulk_ast/core/hulk_callgraph.h"
+#include "../hulk_ast/core/hulk_effects.h"
 #include "../hulk_ast/builder/hulk_ast_builder.h"
 #include "../hulk_ast/semantic/hulk_semantic.h"
+#include "../error_handler.h"
 
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* ============================================================
@@ -135,6 +145,18 @@ TEST(variable_out_of_scope) {
     ASSERT_GT(analyze("let x = 5 in x; x;"), 0);
 }
 
+TEST(block_scope_reused_after_close) {
+    /* El scope del primer let (indexado: más de 8 nombres) se reusa para
+     * el segundo: sus nombres no sobreviven y los nuevos se encuentran */
+    const char *wide = "let a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, "
+                       "a6 = 6, a7 = 7, a8 = 8, a9 = 9 in a9";
+    char src[256];
+    snprintf(src, sizeof(src), "{ %s; let b = 1, a3 = 2 in b + a3; };", wide);
+    ASSERT_EQ(0, analyze(src));
+    snprintf(src, sizeof(src), "{ %s; let b = 1 in b + a3; };", wide);
+    ASSERT_EQ(1, analyze(src));
+}
+
 /* ============================================================
  *  SUITE: Verificación de tipos — errores
  * ============================================================ */
@@ -184,6 +206,38 @@ TEST(function_infers_params_from_call_signature) {
         "clamp(10, 0, 5);"));
 }
 
+TEST(function_infers_params_through_aliases_and_later_calls) {
+    /* x llega a un operando solo vía el alias b; k pasa x a g, que se
+     * declara después y a su vez la usa vía un alias */
+    ASSERT_EQ(0, analyze(
+        "function f(x) -> let b = x in b * 2;\n"
+        "function k(x) -> print(g(x));\n"
+        "function g(y) -> let z = y in z + 1;\n"
+        "print(f(2) + g(3));\n"
+        "k(4);"));
+}
+
+TEST(function_params_survive_many_signatures) {
+    /* Muchas firmas distintas antes de g: el tipo resuelto de y (Number,
+     * solo visible vía el alias z) no se pierde al crecer la tabla de
+     * tipos función */
+    char *src;
+    size_t size;
+    FILE *out = open_memstream(&src, &size);
+    for (int i = 0; i < 40; i++) {
+        fprintf(out, "function f%d(x: Number", i);
+        for (int j = 0; j < i; j++)
+            fprintf(out, ", s%d: String", j);
+        fprintf(out, "): Number -> x;\n");
+    }
+    fprintf(out, "function g(y) -> let z = y in z + 1;\n"
+                 "g(\"a\");");
+    fclose(out);
+    int errors = analyze(src);
+    free(src);
+    ASSERT_EQ(1, errors);
+}
+
 TEST(function_expr_closure_capture) {
     ASSERT_EQ(0, analyze(
         "let n: Number = 5, add = function (x: Number): Number -> x + n in add(3);"));
@@ -194,6 +248,19 @@ TEST(function_type_annotation) {
         "let f: (Number)->Number = function (x: Number): Number -> x + 1 in f(2);"));
 }
 
+TEST(function_type_identity) {
+    /* Firmas iguales son el mismo tipo, también tras inferir el retorno */
+    ASSERT_EQ(0, analyze(
+        "function inc(x: Number) -> x + 1;\n"
+        "let f: (Number)->Number = inc,\n"
+        "    g: (Number)->Number = function (y: Number): Number -> y * 2\n"
+        "in f(g(1));"));
+    ASSERT_GT(analyze(
+        "let f: (Number)->Number = function (x: String): Number -> 1 in 0;"), 0);
+    ASSERT_GT(analyze(
+        "let f: (Number)->String = function (x: Number): Number -> x in 0;"), 0);
+}
+
 TEST(function_expr_returns_function) {
     ASSERT_EQ(0, analyze(
         "let makeAdder = function (n: Number) -> function (x: Number): Number -> x + n in "
@@ -268,6 +335,30 @@ TEST(type_inheritance) {
         "new Dog(\"Rex\");"));
 }
 
+TEST(type_hierarchy_conformance) {
+    /* Hijo declarado antes que el padre: la jerarquía se indexa recién
+     * con la herencia resuelta. Join de hermanos → padre común. */
+    const char *types =
+        "protocol P { h(): Number; }\n"
+        "type C inherits B { h(): Number -> 3; }\n"
+        "type B inherits A {}\n"
+        "type A { h(): Number -> 1; }\n"
+        "type D inherits A {}\n"
+        "function f(x: A): Number -> x.h();\n";
+    char src[512];
+    snprintf(src, sizeof(src), "%s%s", types,
+        "let c = new C(), d = new D() in {\n"
+        "  let p: P = c in print(f(c) + p.h());\n"
+        "  let j: A = if (f(c) > 0) c else d in print(f(j));\n"
+        "};");
+    ASSERT_EQ(0, analyze(src));
+    /* Hermano no conforma; D no declara h() propio → no es P */
+    snprintf(src, sizeof(src), "%s%s", types, "let b: B = new D() in 0;");
+    ASSERT_GT(analyze(src), 0);
+    snprintf(src, sizeof(src), "%s%s", types, "let p: P = new D() in 0;");
+    ASSERT_GT(analyze(src), 0);
+}
+
 TEST(type_self_valid) {
     /* Constructor params son accesibles como variables locales,
      * self.xxx requiere que xxx sea atributo explícito */
@@ -374,6 +465,68 @@ TEST(assign_undefined) {
     ASSERT_GT(analyze("x := 10;"), 0);
 }
 
+/* ============================================================
+ *  SUITE: Resolución anotada en los usos de nombres
+ * ============================================================ */
+
+/* Primer IdentNode `name` en preorden que el semántico resolvió. */
+static IdentNode* find_bound_ident(HulkNode *n, const char *name) {
+    if (!n) return NULL;
+    if (n->type == NODE_IDENT && strcmp(((IdentNode*)n)->name, name) == 0 &&
+        ((IdentNode*)n)->binding.kind != HULK_BIND_NONE)
+        return (IdentNode*)n;
+    HulkNodeSlots s;
+    hulk_ast_slots(n, &s);
+    for (int i = 0; i < s.nfixed; i++) {
+        IdentNode *r = find_bound_ident(*s.fixed[i], name);
+        if (r) return r;
+    }
+    for (int l = 0; l < s.nlists; l++)
+        for (int i = 0; i < s.lists[l]->count; i++) {
+            IdentNode *r = find_bound_ident(s.lists[l]->items[i], name);
+            if (r) return r;
+        }
+    return NULL;
+}
+
+TEST(binding_local_capture_and_global) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function twice(v: Number): Number => v * 2;\n"
+        "let n: Number = 5, add = function (x: Number): Number -> x + n in "
+        "print(twice(add(3)));");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    IdentNode *v = find_bound_ident(ast, "v");
+    ASSERT_NOT_NULL(v);
+    ASSERT_EQ(HULK_BIND_LOCAL, v->binding.kind);
+    ASSERT_EQ(NODE_VAR_BINDING, v->binding.decl->type);
+
+    // n se usa dentro de la lambda: es su primera captura
+    IdentNode *n = find_bound_ident(ast, "n");
+    ASSERT_NOT_NULL(n);
+    ASSERT_EQ(HULK_BIND_CAPTURE, n->binding.kind);
+    ASSERT_EQ(0, n->binding.slot);
+    ASSERT_STR_EQ("n", ((VarBindingNode*)n->binding.decl)->name);
+
+    IdentNode *x = find_bound_ident(ast, "x");
+    ASSERT_EQ(HULK_BIND_LOCAL, x->binding.kind);
+
+    // Funciones globales: la del programa con su FunctionDef, las
+    // built-in sin declaración
+    IdentNode *twice = find_bound_ident(ast, "twice");
+    ASSERT_EQ(HULK_BIND_GLOBAL, twice->binding.kind);
+    ASSERT_EQ(NODE_FUNCTION_DEF, twice->binding.decl->type);
+    IdentNode *print = find_bound_ident(ast, "print");
+    ASSERT_EQ(HULK_BIND_GLOBAL, print->binding.kind);
+    ASSERT_NULL(print->binding.decl);
+
+    hulk_ast_context_free(&ctx);
+}
+
 /* ============================================================
  *  SUITE: Desugaring de decoradores
  * ============================================================ */
@@ -458,6 +611,489 @@ TEST(program_let_chain) {
         "z;"));
 }
 
+/* ============================================================
+ *  SUITE: Verificación en paralelo
+ * ============================================================ */
+
+static char diag_text[4096];
+static size_t diag_len;
+
+static void capture_diag(LogLevel level, const char *module,
+                         const char *fmt, va_list args) {
+    (void)level; (void)module;
+    if (diag_len >= sizeof(diag_text) - 1) return;
+    int n = vsnprintf(diag_text + diag_len, sizeof(diag_text) - diag_len,
+                      fmt, args);
+    if (n > 0) diag_len += (size_t)n;
+    if (diag_len > sizeof(diag_text) - 2) diag_len = sizeof(diag_text) - 2;
+    diag_text[diag_len++] = '\n';
+    diag_text[diag_len] = '\0';
+}
+
+/* Analiza con `workers` hilos, o incremental si hay `state`, y deja los
+ * diagnósticos en diag_text. */
+static int analyze_with(const char *src, int workers,
+                        HulkSemanticState *state) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    FILE *saved_err = stderr;
+    stderr = fopen("/dev/null", "w");
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa, src);
+    fclose(stderr);
+    stderr = saved_err;
+
+    diag_len = 0;
+    diag_text[0] = '\0';
+    ErrorHandlerFn saved = error_handler_get();
+    error_handler_set(capture_diag);
+    int errors = -1;
+    if (ast)
+        errors = state ? hulk_semantic_analyze_incremental(state, &ctx, ast, src)
+                       : hulk_semantic_analyze_workers(&ctx, ast, workers);
+    error_handler_set(saved);
+    hulk_ast_context_free(&ctx);
+    return errors;
+}
+
+static int analyze_workers(const char *src, int workers) {
+    return analyze_with(src, workers, NULL);
+}
+
+TEST(parallel_check_matches_serial) {
+    /* a ve el retorno de b sin inferir (b viene después) y c ya inferido;
+     * n usa el retorno inferido de m; los errores salen de varios cuerpos */
+    const char *src =
+        "function a(x) -> b(x) + 1;\n"
+        "function b(x) -> x * 2;\n"
+        "function c(x) -> b(x) + 1;\n"
+        "type P(v: Number) {\n"
+        "    m() -> self.v + 1;\n"
+        "    n(): Boolean -> self.m() + 1;\n"
+        "    o(): String -> undefined;\n"
+        "}\n"
+        "function d(): Number -> new P(1).n();\n"
+        "print(c(\"q\") + a(1));";
+    int serial = analyze_workers(src, 1);
+    char serial_text[sizeof(diag_text)];
+    memcpy(serial_text, diag_text, sizeof(diag_text));
+    ASSERT_GT(serial, 3);
+    for (int run = 0; run < 4; run++) {
+        ASSERT_EQ(serial, analyze_workers(src, 4));
+        ASSERT_STR_EQ(serial_text, diag_text);
+    }
+}
+
+/* ============================================================
+ *  SUITE: Análisis incremental
+ * ============================================================ */
+
+static const char *inc_base =
+    "function a(x: Number): Number -> x + 1;\n"
+    "function b(x: Number): Number -> a(x) * 2;\n"
+    "function c(s: String): String -> s @ \"!\";\n"
+    "type P(v: Number) {\n"
+    "    w: Number = v;\n"
+    "    get(): Number -> b(self.w);\n"
+    "}\n"
+    "print(c(\"x\") @ new P(1).get());";
+
+TEST(incremental_body_edit_checks_one_decl) {
+    HulkSemanticState *st = hulk_semantic_state_new();
+    ASSERT_EQ(0, analyze_with(inc_base, 1, st));
+    ASSERT_EQ(5, hulk_semantic_state_checked(st));
+
+    /* Solo cambia el cuerpo de c: nadie más depende de eso */
+    const char *edited =
+        "function a(x: Number): Number -> x + 1;\n"
+        "function b(x: Number): Number -> a(x) * 2;\n"
+        "function c(s: String): String -> s @ 3 - true;\n"
+        "type P(v: Number) {\n"
+        "    w: Number = v;\n"
+    "    get(): Number -> b(self.w);\n"
+        "}\n"
+        "print(c(\"x\") @ new P(1).get());";
+    int full = analyze_workers(edited, 1);
+    char full_text[sizeof(diag_text)];
+    memcpy(full_text, diag_text, sizeof(diag_text));
+    ASSERT_GT(full, 0);
+    ASSERT_EQ(full, analyze_with(edited, 1, st));
+    ASSERT_STR_EQ(full_text, diag_text);
+    ASSERT_EQ(1, hulk_semantic_state_checked(st));
+
+    /* Sin cambios: nada que verificar, los errores se reusan */
+    ASSERT_EQ(full, analyze_with(edited, 1, st));
+    ASSERT_STR_EQ(full_text, diag_text);
+    ASSERT_EQ(0, hulk_semantic_state_checked(st));
+    hulk_semantic_state_free(st);
+}
+
+TEST(incremental_signature_edit_rechecks_callers) {
+    HulkSemanticState *st = hulk_semantic_state_new();
+    ASSERT_EQ(0, analyze_with(inc_base, 1, st));
+
+    /* a pasa a retornar String: b (y solo b) se vuelve a verificar */
+    const char *edited =
+        "function a(x: Number): String -> \"n\" @ x;\n"
+        "function b(x: Number): Number -> a(x) * 2;\n"
+        "function c(s: String): String -> s @ \"!\";\n"
+        "type P(v: Number) {\n"
+        "    w: Number = v;\n"
+    "    get(): Number -> b(self.w);\n"
+        "}\n"
+        "print(c(\"x\") @ new P(1).get());";
+    int full = analyze_workers(edited, 1);
+    char full_text[sizeof(diag_text)];
+    memcpy(full_text, diag_text, sizeof(diag_text));
+    ASSERT_GT(full, 0);
+    ASSERT_EQ(full, analyze_with(edited, 1, st));
+    ASSERT_STR_EQ(full_text, diag_text);
+    ASSERT_EQ(2, hulk_semantic_state_checked(st));
+
+    /* Deshacer la edición vuelve a 0 errores */
+    ASSERT_EQ(0, analyze_with(inc_base, 1, st));
+    hulk_semantic_state_free(st);
+}
+
+/* ============================================================
+ *  SUITE: Grafo de llamadas
+ * ============================================================ */
+
+/* Nodo de la función `name`, o del método `name` de `type`. */
+static int cg_node(HulkCallGraph *g, HulkNode *ast, const char *type,
+                   const char *name) {
+    ProgramNode *prog = (ProgramNode*)ast;
+    for (int i = 0; i < prog->declarations.count; i++) {
+        HulkNode *d = prog->declarations.items[i];
+        if (!type && d->type == NODE_FUNCTION_DEF &&
+            strcmp(((FunctionDefNode*)d)->name, name) == 0)
+            return hulk_callgraph_find(g, d);
+        if (!type || d->type != NODE_TYPE_DEF ||
+            strcmp(((TypeDefNode*)d)->name, type) != 0)
+            continue;
+        TypeDefNode *td = (TypeDefNode*)d;
+        if (!name) return hulk_callgraph_find(g, d);   /* constructor */
+        for (int m = 0; m < td->members.count; m++)
+            if (td->members.items[m]->type == NODE_METHOD_DEF &&
+                strcmp(((MethodDefNode*)td->members.items[m])->name, name) == 0)
+                return hulk_callgraph_find(g, td->members.items[m]);
+    }
+    return -1;
+}
+
+TEST(callgraph_recursion_leaves_and_order) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function sq(x: Number): Number => x * x;\n"
+        "function fact(n: Number): Number => if (n < 2) 1 else n * fact(n - 1);\n"
+        "function even(n: Number): Boolean => if (n == 0) true else odd(n - 1);\n"
+        "function odd(n: Number): Boolean => if (n == 0) false else even(n - 1);\n"
+        "function apply(f: (Number) -> Number, x: Number): Number => f(x);\n"
+        "print(apply(sq, fact(3)));\n");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    HulkCallGraph g;
+    ASSERT(hulk_callgraph_build(&g, ast));
+    int sq = cg_node(&g, ast, NULL, "sq"), fact = cg_node(&g, ast, NULL, "fact");
+    int even = cg_node(&g, ast, NULL, "even"), odd = cg_node(&g, ast, NULL, "odd");
+    int apply = cg_node(&g, ast, NULL, "apply");
+
+    ASSERT(hulk_callgraph_is_leaf(&g, sq));
+    ASSERT(!hulk_callgraph_is_recursive(&g, sq));
+    ASSERT(g.nodes[sq].escapes);                 /* pasada como valor */
+    ASSERT(hulk_callgraph_is_recursive(&g, fact));
+    ASSERT(g.nodes[fact].self_loop);
+    ASSERT(hulk_callgraph_is_recursive(&g, even));
+    ASSERT_EQ(g.nodes[even].scc, g.nodes[odd].scc);
+    ASSERT(!g.nodes[even].self_loop);
+
+    /* f(x) llama a un valor función: sin destino conocido */
+    ASSERT(g.nodes[apply].calls_unknown);
+    ASSERT(!hulk_callgraph_is_leaf(&g, apply));
+    ASSERT(hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, apply));
+    ASSERT(!hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, sq));
+
+    /* De abajo hacia arriba: cada llamado antes que su llamador */
+    for (int k = 0; k < g.count; k++)
+        for (int e = 0; e < g.nodes[k].edge_count; e++)
+            ASSERT(g.nodes[g.edges[g.nodes[k].first_edge + e]].scc <=
+                   g.nodes[k].scc);
+    ASSERT(g.nodes[fact].scc < g.nodes[HULK_CALLGRAPH_ROOT].scc);
+
+    hulk_callgraph_free(&g);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(callgraph_methods_by_static_type) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "type A {\n"
+        "    m(): Number => 1;\n"
+        "    n(): Number => self.m();\n"
+        "}\n"
+        "type B inherits A {\n"
+        "    m(): Number { base(); 2; }\n"
+        "}\n"
+        "type C inherits A { }\n"
+        "type D {\n"
+        "    m(): Number => 4;\n"
+        "}\n"
+        "let a: A = new B(), c = new C() in print(a.n() + c.m());\n");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    HulkCallGraph g;
+    ASSERT(hulk_callgraph_build(&g, ast));
+    int am = cg_node(&g, ast, "A", "m"), an = cg_node(&g, ast, "A", "n");
+    int bm = cg_node(&g, ast, "B", "m"), dm = cg_node(&g, ast, "D", "m");
+
+    /* self.m() en A: la de A y la redefinición de B, no la de D */
+    ASSERT(hulk_callgraph_calls(&g, an, am));
+    ASSERT(hulk_callgraph_calls(&g, an, bm));
+    ASSERT(!hulk_callgraph_calls(&g, an, dm));
+    /* base() en B.m es A.m */
+    ASSERT(hulk_callgraph_calls(&g, bm, am));
+    ASSERT(hulk_callgraph_is_leaf(&g, am));
+    /* c.m() con c: C hereda la de A */
+    ASSERT(hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, am));
+    ASSERT(!hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, bm));
+    /* new B() llama al constructor de B, y este al de A */
+    int ctor_a = cg_node(&g, ast, "A", NULL), ctor_b = cg_node(&g, ast, "B", NULL);
+    ASSERT(hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, ctor_b));
+    ASSERT(hulk_callgraph_calls(&g, ctor_b, ctor_a));
+    ASSERT(!hulk_callgraph_is_recursive(&g, an));
+
+    hulk_callgraph_free(&g);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(callgraph_decorators) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function logger(f) -> f;\n"
+        "decor logger function g(x: Number): Number -> x + 1;\n"
+        "function h(x: Number): Number -> g(x);\n"
+        "type Box(v: Number) {\n"
+        "    w: Number = v;\n"
+        "    decor logger get(): Number -> self.w;\n"
+        "}\n"
+        "print(h(1) + new Box(3).get());\n");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    HulkCallGraph g;
+    ASSERT(hulk_callgraph_build(&g, ast));
+    int logger = cg_node(&g, ast, NULL, "logger");
+    int gf = cg_node(&g, ast, NULL, "g"), h = cg_node(&g, ast, NULL, "h");
+    int get = cg_node(&g, ast, "Box", "get");
+
+    /* g := logger(g) en las expresiones globales */
+    ASSERT(hulk_callgraph_calls(&g, HULK_CALLGRAPH_ROOT, logger));
+    ASSERT(g.nodes[gf].wrapped);
+    /* Llamar a g ejecuta lo que haya devuelto logger */
+    ASSERT(hulk_callgraph_calls(&g, h, gf));
+    ASSERT(g.nodes[h].calls_unknown);
+    /* El decorador del método se aplica desde el método */
+    ASSERT(g.nodes[get].wrapped);
+    ASSERT(hulk_callgraph_calls(&g, get, logger));
+    ASSERT(g.nodes[HULK_CALLGRAPH_ROOT].calls_unknown);
+
+    hulk_callgraph_free(&g);
+    hulk_ast_context_free(&ctx);
+}
+
+/* ============================================================
+ *  SUITE: Genéricos
+ * ============================================================ */
+
+TEST(generics_one_instance_per_use) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function max<T>(a: T, b: T): T => if (a > b) a else b;\n"
+        "type Box<T>(v: T) {\n"
+        "    v: T = v;\n"
+        "    get(): T => self.v;\n"
+        "    map(f: (T) -> T): Box<T> => new Box<T>(f(self.v));\n"
+        "}\n"
+        "type Unused<T> { bad(): T => undefined + 1; }\n"
+        "print(max<Number>(1, 2) + max<Number>(3, 4));\n"
+        "print(new Box<String>(\"a\").get() @ new Box<Number>(1).get());\n");
+    ASSERT_NOT_NULL(ast);
+    /* el cuerpo de Unused no se verifica: nadie lo instancia */
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    ProgramNode *prog = (ProgramNode*)ast;
+    ASSERT_EQ(5, prog->declarations.count);
+    ASSERT_STR_EQ("max<Number>", ((FunctionDefNode*)prog->declarations.items[0])->name);
+    ASSERT_STR_EQ("Number", ((FunctionDefNode*)prog->declarations.items[0])->return_type);
+    /* en el lugar de Box<T>, en el orden en que se pidieron */
+    TypeDefNode *bs = (TypeDefNode*)prog->declarations.items[1];
+    TypeDefNode *bn = (TypeDefNode*)prog->declarations.items[2];
+    ASSERT_STR_EQ("Box<String>", bs->name);
+    ASSERT_STR_EQ("Box<Number>", bn->name);
+    ASSERT_STR_EQ("Number", ((AttributeDefNode*)bn->members.items[0])->type_annotation);
+    MethodDefNode *map = (MethodDefNode*)bn->members.items[2];
+    ASSERT_STR_EQ("Box<Number>", map->return_type);
+    ASSERT_STR_EQ("(Number)->Number",
+                  ((VarBindingNode*)map->params.items[0])->type_annotation);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(generics_nested_and_inherited_instances) {
+    ASSERT_EQ(0, analyze(
+        "type Pair<A, B>(a: A, b: B) {\n"
+        "    a: A = a;\n"
+        "    b: B = b;\n"
+        "    swap(): Pair<B, A> => new Pair<B, A>(self.b, self.a);\n"
+        "}\n"
+        "type Named(n: String) inherits Pair<String, Number>(n, 0) {}\n"
+        "protocol Source<T> { next(): T; }\n"
+        "function pull<T>(s: Source<T>): T => s.next();\n"
+        "type Counter { n: Number = 0; next(): Number => self.n := self.n + 1; }\n"
+        "let p: Pair<Pair<Number, Boolean>, String> =\n"
+        "        new Pair<Pair<Number, Boolean>, String>(new Pair<Number, Boolean>(1, true), \"x\"),\n"
+        "    f: (Pair<Number, String>) -> Number = function (q: Pair<Number, String>): Number => q.a\n"
+        "in print(f(new Named(\"n\").swap()) + pull<Number>(new Counter()));"));
+}
+
+TEST(generics_errors) {
+    ASSERT_GT(analyze_workers(
+        "function id<T>(x: T): T => x;\n"
+        "type Box<T>(v: T) { v: T = v; }\n"
+        "type List<T>(x: T) { next(): List<List<T>> => new List<List<T>>(x); }\n"
+        "decor log function wrapped<T>(x: T): T => x;\n"
+        "let a: Box = new Box<Number, String>(1), b: Foo<Number> = 3 in {\n"
+        "    print(id<Number>(1) + Box<Number>(1));\n"
+        "    print(new id<Number>(2));\n"
+        "    print(new List<Number>(1));\n"
+        "};", 1), 0);
+    ASSERT(strstr(diag_text, "no se puede decorar el genérico 'wrapped<T>'"));
+    ASSERT(strstr(diag_text, "tipo genérico 'Box' usado sin argumentos de tipo"));
+    ASSERT(strstr(diag_text, "'Box' espera 1 argumento(s) de tipo y recibió 2"));
+    ASSERT(strstr(diag_text, "'Foo' no es genérico"));
+    ASSERT(strstr(diag_text, "'Box' no es una función genérica"));
+    ASSERT(strstr(diag_text, "'id' no es un tipo genérico"));
+    ASSERT(strstr(diag_text, "'List' se instancia con más de 64 niveles"));
+    /* List no deja instancias: no hay un error por cada nivel */
+    ASSERT(!strstr(diag_text, "List<List<List<Number>>>"));
+}
+
+TEST(generics_incremental_checks_everything) {
+    const char *src =
+        "function max<T>(a: T, b: T): T => if (a > b) a else b;\n"
+        "function f(x: Number): Number => x + 1;\n"
+        "print(max<Number>(f(1), 2));";
+    HulkSemanticState *st = hulk_semantic_state_new();
+    ASSERT_EQ(0, analyze_with(src, 1, st));
+    ASSERT_EQ(0, analyze_with(src, 1, st));
+    ASSERT_EQ(3, hulk_semantic_state_checked(st));
+    hulk_semantic_state_free(st);
+}
+
+/* ============================================================
+ *  SUITE: Efectos
+ * ============================================================ */
+
+TEST(effects_classes_and_termination) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function sq(x: Number): Number => sqrt(x) * x;\n"
+        "function fib(n: Number): Number => if (n < 2) n else fib(n - 1) + fib(n - 2);\n"
+        "function same(a: String, b: String): Boolean => a == b;\n"
+        "function greet(s: String): String => \"hola \" @ s;\n"
+        "function twice(s: String): String => greet(greet(s));\n"
+        "function count(n: Number): Number => let i = 0 in while (i < n) { i := i + 1; };\n"
+        "function say(x: Number): Number { print(x); x; }\n"
+        "type P(x: Number) {\n"
+        "    x: Number = x;\n"
+        "    getx(): Number => self.x;\n"
+        "    setx(v: Number): Number => self.x := v;\n"
+        "}\n"
+        "print(sq(fib(5)) + count(3) + say(1) + new P(2).setx(4));\n"
+        "print(same(twice(\"a\"), \"b\"));\n");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    HulkEffects fx;
+    ASSERT(hulk_effects_analyze(&fx, ast));
+    const HulkEffectInfo *sq = &fx.info[cg_node(&fx.graph, ast, NULL, "sq")];
+    const HulkEffectInfo *fib = &fx.info[cg_node(&fx.graph, ast, NULL, "fib")];
+    const HulkEffectInfo *same = &fx.info[cg_node(&fx.graph, ast, NULL, "same")];
+    const HulkEffectInfo *twice = &fx.info[cg_node(&fx.graph, ast, NULL, "twice")];
+    const HulkEffectInfo *count = &fx.info[cg_node(&fx.graph, ast, NULL, "count")];
+    const HulkEffectInfo *say = &fx.info[cg_node(&fx.graph, ast, NULL, "say")];
+
+    ASSERT_EQ(HULK_EFFECT_NONE, sq->effect);
+    ASSERT(sq->terminates);
+    /* cada llamada a fib carga su celda; la recursión puede no terminar */
+    ASSERT_EQ(HULK_EFFECT_READ, fib->effect);
+    ASSERT(!fib->terminates);
+    ASSERT_EQ(HULK_EFFECT_READ, same->effect);
+    /* @ reserva, y greet devuelve ese buffer: twice también */
+    ASSERT_EQ(HULK_EFFECT_ALLOC, twice->effect);
+    ASSERT(twice->fresh);
+    ASSERT(twice->terminates);
+    ASSERT(!same->fresh);
+    /* i es local: asignarla no escribe memoria, pero el while no termina */
+    ASSERT_EQ(HULK_EFFECT_NONE, count->effect);
+    ASSERT(!count->terminates);
+    ASSERT_EQ(HULK_EFFECT_ANY, say->effect);
+
+    const HulkEffectInfo *getx = &fx.info[cg_node(&fx.graph, ast, "P", "getx")];
+    const HulkEffectInfo *setx = &fx.info[cg_node(&fx.graph, ast, "P", "setx")];
+    const HulkEffectInfo *ctor = &fx.info[cg_node(&fx.graph, ast, "P", NULL)];
+    ASSERT_EQ(HULK_EFFECT_READ, getx->effect);
+    ASSERT_EQ(HULK_EFFECT_ANY, setx->effect);
+    ASSERT_EQ(HULK_EFFECT_ALLOC, ctor->effect);
+    ASSERT(ctor->fresh);
+    ASSERT_EQ(HULK_EFFECT_ANY, fx.info[HULK_CALLGRAPH_ROOT].effect);
+
+    hulk_effects_free(&fx);
+    hulk_ast_context_free(&ctx);
+}
+
+TEST(effects_unknown_callees) {
+    ensure_compiler();
+    HulkASTContext ctx;
+    hulk_ast_context_init(&ctx);
+    HulkNode *ast = hulk_build_ast(&ctx, hc.dfa,
+        "function logger(f) -> f;\n"
+        "decor logger function g(x: Number): Number -> x + 1;\n"
+        "function h(x: Number): Number -> g(x);\n"
+        "function apply(f: (Number) -> Number, x: Number): Number => f(x);\n"
+        "print(h(1) + apply(h, 2));\n");
+    ASSERT_NOT_NULL(ast);
+    ASSERT_EQ(0, hulk_semantic_analyze(&ctx, ast));
+
+    HulkEffects fx;
+    ASSERT(hulk_effects_analyze(&fx, ast));
+    int gf = cg_node(&fx.graph, ast, NULL, "g"), h = cg_node(&fx.graph, ast, NULL, "h");
+    int apply = cg_node(&fx.graph, ast, NULL, "apply");
+
+    /* el cuerpo de g es puro, pero llamarla ejecuta lo que devolvió logger */
+    ASSERT_EQ(HULK_EFFECT_NONE, fx.info[gf].effect);
+    ASSERT_NOT_NULL(hulk_effects_of(&fx, fx.graph.nodes[gf].decl));
+    ASSERT_NULL(hulk_effects_of_call(&fx, fx.graph.nodes[gf].decl));
+    ASSERT_EQ(HULK_EFFECT_ANY, fx.info[h].effect);
+    ASSERT(!fx.info[h].terminates);
+    ASSERT_EQ(HULK_EFFECT_ANY, fx.info[apply].effect);
+    ASSERT_NOT_NULL(hulk_effects_of_call(&fx, fx.graph.nodes[apply].decl));
+
+    hulk_effects_free(&fx);
+    hulk_ast_context_free(&ctx);
+}
+
 /* ============================================================
  *  main
  * ============================================================ */
@@ -483,6 +1119,7 @@ int main(void) {
     RUN_TEST(undefined_variable);
     RUN_TEST(undefined_in_let_body);
     RUN_TEST(variable_out_of_scope);
+    RUN_TEST(block_scope_reused_after_close);
 
     TEST_SUITE("Verificación de tipos — errores");
     RUN_TEST(arithmetic_with_string);
@@ -496,8 +1133,11 @@ int main(void) {
     RUN_TEST(function_basic);
     RUN_TEST(function_no_annotation);
     RUN_TEST(function_infers_params_from_call_signature);
+    RUN_TEST(function_infers_params_through_aliases_and_later_calls);
+    RUN_TEST(function_params_survive_many_signatures);
     RUN_TEST(function_expr_closure_capture);
     RUN_TEST(function_type_annotation);
+    RUN_TEST(function_type_identity);
     RUN_TEST(function_expr_returns_function);
     RUN_TEST(function_expr_undefined_capture);
     RUN_TEST(function_wrong_arg_count);
@@ -513,6 +1153,7 @@ int main(void) {
     RUN_TEST(type_with_method);
     RUN_TEST(type_with_attribute);
     RUN_TEST(type_inheritance);
+    RUN_TEST(type_hierarchy_conformance);
     RUN_TEST(type_self_valid);
     RUN_TEST(self_outside_type);
     RUN_TEST(base_outside_type);
@@ -540,6 +1181,9 @@ int main(void) {
     RUN_TEST(assign_valid);
     RUN_TEST(assign_undefined);
 
+    TEST_SUITE("Resolución anotada");
+    RUN_TEST(binding_local_capture_and_global);
+
     TEST_SUITE("Desugaring de decoradores");
     RUN_TEST(decorator_basic);
     RUN_TEST(decorator_multiple);
@@ -553,6 +1197,28 @@ int main(void) {
     RUN_TEST(program_type_hierarchy);
     RUN_TEST(program_let_chain);
 
+    TEST_SUITE("Verificación en paralelo");
+    RUN_TEST(parallel_check_matches_serial);
+
+    TEST_SUITE("Análisis incremental");
+    RUN_TEST(incremental_body_edit_checks_one_decl);
+    RUN_TEST(incremental_signature_edit_rechecks_callers);
+
+    TEST_SUITE("Grafo de llamadas");
+    RUN_TEST(callgraph_recursion_leaves_and_order);
+    RUN_TEST(callgraph_methods_by_static_type);
+    RUN_TEST(callgraph_decorators);
+
+    TEST_SUITE("Genéricos");
+    RUN_TEST(generics_one_instance_per_use);
+    RUN_TEST(generics_nested_and_inherited_instances);
+    RUN_TEST(generics_errors);
+    RUN_TEST(generics_incremental_checks_everything);
+
+    TEST_SUITE("Efectos");
+    RUN_TEST(effects_classes_and_termination);
+    RUN_TEST(effects_unknown_callees);
+
     TEST_REPORT();
     return TEST_EXIT_CODE();
 }